@@ -121,6 +121,22 @@
 #define OVR_MATH_UNUSED(a) (a)
 #endif
 
+//-------------------------------------------------------------------------------------
+// ***** OVR_MATH_SIMD
+//
+// When the target has NEON, the float versions of the hottest Matrix4 and Quat operations are
+// replaced by explicit specializations further down. They do the same arithmetic in the same
+// order as the generic templates, so the results are identical bit for bit. Define
+// OVR_MATH_NO_SIMD to compile the generic templates for every type, e.g. to compare the two.
+// There is no SSE version: compilers already vectorize the generic templates about as well on
+// x86, and a hand-written quaternion product was slower.
+
+#if !defined(OVR_MATH_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define OVR_MATH_SIMD 1
+#define OVR_MATH_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace OVR {
 
 template <class T>
@@ -2263,8 +2279,18 @@ class Quat {
 
     // Rotate transforms vector in a manner that matches Matrix rotations (counter-clockwise,
     // assuming negative direction of the axis). Standard formula: q(t) * V * q(t)^-1.
+    // Expands (*this * v * Inverted()).Imag() into (w^2 - u.u) v + 2 (u.v) u + 2 w (u x v),
+    // u = (x, y, z), which needs about half the multiplies of the two quaternion products.
     Vector3<T> Rotate(const Vector3<T>& v) const {
-        return ((*this * Quat<T>(v.x, v.y, v.z, T(0))) * Inverted()).Imag();
+        const T uu = x * x + y * y + z * z;
+        const T uv = x * v.x + y * v.y + z * v.z;
+        const T s = w * w - uu;
+        const T uv2 = uv + uv;
+        const T w2 = w + w;
+        return Vector3<T>(
+            v.x * s + x * uv2 + (y * v.z - z * v.y) * w2,
+            v.y * s + y * uv2 + (z * v.x - x * v.z) * w2,
+            v.z * s + z * uv2 + (x * v.y - y * v.x) * w2);
     }
 
     // Rotation by inverse of *this
@@ -2508,6 +2534,27 @@ Vector3<T> operator*(const Vector3<T>& v, const Quat<T>& q) {
 typedef Quat<float> Quatf;
 typedef Quat<double> Quatd;
 
+#if defined(OVR_MATH_SIMD)
+// Same products, summed in the same order as the generic version, so the result is identical.
+template <>
+inline Quat<float> Quat<float>::operator*(const Quat<float>& b) const {
+    Quat<float> result;
+    static const float signXmXm[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+    static const float signYYmm[4] = {1.0f, 1.0f, -1.0f, -1.0f};
+    static const float signmZZm[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+    const float32x4_t bv = vld1q_f32(&b.x); // bx by bz bw
+    const float32x4_t bYXWZ = vrev64q_f32(bv);
+    const float32x4_t bWZYX = vcombine_f32(vget_high_f32(bYXWZ), vget_low_f32(bYXWZ));
+    const float32x4_t bZWXY = vcombine_f32(vget_high_f32(bv), vget_low_f32(bv));
+    float32x4_t r = vmulq_n_f32(bv, w);
+    r = vaddq_f32(r, vmulq_f32(vmulq_n_f32(vld1q_f32(signXmXm), x), bWZYX));
+    r = vaddq_f32(r, vmulq_f32(vmulq_n_f32(vld1q_f32(signYYmm), y), bZWXY));
+    r = vaddq_f32(r, vmulq_f32(vmulq_n_f32(vld1q_f32(signmZZm), z), bYXWZ));
+    vst1q_f32(&result.x, r);
+    return result;
+}
+#endif // OVR_MATH_SIMD
+
 static_assert(std::is_trivially_copyable_v<Quatf>);
 static_assert(std::is_standard_layout_v<Quatf>);
 static_assert(std::is_trivially_copyable_v<Quatd>);
@@ -3139,10 +3186,45 @@ class Matrix4 {
             Cofactor(3, 3));
     }
 
+    // Same as Adjugated() * (1 / Determinant()), but builds the adjugate from 2x2 minors of the
+    // top and bottom row pairs, each shared by several cofactors, instead of a 3x3 determinant per
+    // cofactor. About a third of the multiplies.
     Matrix4 Inverted() const {
-        T det = Determinant();
+        const T s0 = M[0][0] * M[1][1] - M[1][0] * M[0][1];
+        const T s1 = M[0][0] * M[1][2] - M[1][0] * M[0][2];
+        const T s2 = M[0][0] * M[1][3] - M[1][0] * M[0][3];
+        const T s3 = M[0][1] * M[1][2] - M[1][1] * M[0][2];
+        const T s4 = M[0][1] * M[1][3] - M[1][1] * M[0][3];
+        const T s5 = M[0][2] * M[1][3] - M[1][2] * M[0][3];
+
+        const T c5 = M[2][2] * M[3][3] - M[3][2] * M[2][3];
+        const T c4 = M[2][1] * M[3][3] - M[3][1] * M[2][3];
+        const T c3 = M[2][1] * M[3][2] - M[3][1] * M[2][2];
+        const T c2 = M[2][0] * M[3][3] - M[3][0] * M[2][3];
+        const T c1 = M[2][0] * M[3][2] - M[3][0] * M[2][2];
+        const T c0 = M[2][0] * M[3][1] - M[3][0] * M[2][1];
+
+        const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
         OVR_MATH_ASSERT(fabs(det) >= Math<T>::SmallestNonDenormal());
-        return Adjugated() * (T(1) / det);
+        const T rcpDet = T(1) / det;
+
+        return Matrix4(
+            (M[1][1] * c5 - M[1][2] * c4 + M[1][3] * c3) * rcpDet,
+            (-M[0][1] * c5 + M[0][2] * c4 - M[0][3] * c3) * rcpDet,
+            (M[3][1] * s5 - M[3][2] * s4 + M[3][3] * s3) * rcpDet,
+            (-M[2][1] * s5 + M[2][2] * s4 - M[2][3] * s3) * rcpDet,
+            (-M[1][0] * c5 + M[1][2] * c2 - M[1][3] * c1) * rcpDet,
+            (M[0][0] * c5 - M[0][2] * c2 + M[0][3] * c1) * rcpDet,
+            (-M[3][0] * s5 + M[3][2] * s2 - M[3][3] * s1) * rcpDet,
+            (M[2][0] * s5 - M[2][2] * s2 + M[2][3] * s1) * rcpDet,
+            (M[1][0] * c4 - M[1][1] * c2 + M[1][3] * c0) * rcpDet,
+            (-M[0][0] * c4 + M[0][1] * c2 - M[0][3] * c0) * rcpDet,
+            (M[3][0] * s4 - M[3][1] * s2 + M[3][3] * s0) * rcpDet,
+            (-M[2][0] * s4 + M[2][1] * s2 - M[2][3] * s0) * rcpDet,
+            (-M[1][0] * c3 + M[1][1] * c1 - M[1][2] * c0) * rcpDet,
+            (M[0][0] * c3 - M[0][1] * c1 + M[0][2] * c0) * rcpDet,
+            (-M[3][0] * s3 + M[3][1] * s1 - M[3][2] * s0) * rcpDet,
+            (M[2][0] * s3 - M[2][1] * s1 + M[2][2] * s0) * rcpDet);
     }
 
     void Invert() {
@@ -3659,6 +3741,51 @@ const Matrix4<T> Matrix4<T>::IdentityValue;
 typedef Matrix4<float> Matrix4f;
 typedef Matrix4<double> Matrix4d;
 
+#if defined(OVR_MATH_SIMD)
+// Row i of the result is the rows of b weighted by row i of a, summed in the same order as the
+// generic version, so the result is identical.
+template <>
+inline Matrix4<float>&
+Matrix4<float>::Multiply(Matrix4<float>* d, const Matrix4<float>& a, const Matrix4<float>& b) {
+    OVR_MATH_ASSERT((d != &a) && (d != &b));
+    const float32x4_t b0 = vld1q_f32(b.M[0]);
+    const float32x4_t b1 = vld1q_f32(b.M[1]);
+    const float32x4_t b2 = vld1q_f32(b.M[2]);
+    const float32x4_t b3 = vld1q_f32(b.M[3]);
+    for (int i = 0; i < 4; i++) {
+        const float32x4_t ai = vld1q_f32(a.M[i]);
+        float32x4_t r = vmulq_lane_f32(b0, vget_low_f32(ai), 0);
+        r = vaddq_f32(r, vmulq_lane_f32(b1, vget_low_f32(ai), 1));
+        r = vaddq_f32(r, vmulq_lane_f32(b2, vget_high_f32(ai), 0));
+        r = vaddq_f32(r, vmulq_lane_f32(b3, vget_high_f32(ai), 1));
+        vst1q_f32(d->M[i], r);
+    }
+    return *d;
+}
+
+// Sums the columns weighted by v, in the same order as the generic version. vld4q loads the
+// columns of the row-major matrix directly.
+template <>
+inline Vector4<float> Matrix4<float>::Transform(const Vector4<float>& v) const {
+    float r[4];
+    const float32x4x4_t c = vld4q_f32(&M[0][0]);
+    float32x4_t sum = vmulq_n_f32(c.val[0], v.x);
+    sum = vaddq_f32(sum, vmulq_n_f32(c.val[1], v.y));
+    sum = vaddq_f32(sum, vmulq_n_f32(c.val[2], v.z));
+    sum = vaddq_f32(sum, vmulq_n_f32(c.val[3], v.w));
+    vst1q_f32(r, sum);
+    return Vector4<float>(r[0], r[1], r[2], r[3]);
+}
+
+template <>
+inline Vector3<float> Matrix4<float>::Transform(const Vector3<float>& v) const {
+    const Vector4<float> h = Transform(Vector4<float>(v.x, v.y, v.z, 1.0f));
+    OVR_MATH_ASSERT(fabs(h.w) >= Math<float>::SmallestNonDenormal());
+    const float rcpW = 1.0f / h.w;
+    return Vector3<float>(h.x * rcpW, h.y * rcpW, h.z * rcpW);
+}
+#endif // OVR_MATH_SIMD
+
 //-------------------------------------------------------------------------------------
 // ***** Matrix3
 //
@@ -40,6 +40,7 @@ Authors     :   Jonathan E. Wright
 #include "OVR_JSON.h"
 
 #include "Reflection.h"
+#include "MenuHitIndex.h"
 
 using OVR::Bounds3f;
 using OVR::Matrix4f;
@@ -169,6 +170,11 @@ class OvrGuiSysLocal : public OvrGuiSys {
 
     virtual HitTestResult TestRayIntersection(const Vector3f& start, const Vector3f& dir)
         const override;
+    virtual void TestRayIntersections(
+        Vector3f const* starts,
+        Vector3f const* dirs,
+        int const numRays,
+        HitTestResult* results) const override;
 
     virtual void AddMenu(VRMenu* menu) override;
     virtual VRMenu* GetMenu(char const* menuName) const override;
@@ -255,6 +261,14 @@ class OvrGuiSysLocal : public OvrGuiSys {
 
     bool IsInitialized;
 
+    // Spatial index over the active menus, brought up to date lazily on the first ray test. It is
+    // rebuilt after the active menus or the menu hierarchy changed, otherwise only the objects the
+    // menu manager reports as changed are refit.
+    mutable ovrMenuHitIndex HitIndex;
+    mutable bool HitIndexDirty;
+    mutable std::uint32_t HitIndexHierarchyVersion; // menu manager hierarchy version of the index
+    mutable std::vector<VRMenuObject*> HitIndexChanges;
+
     static bool SkipFrame;
     static bool SkipRender;
     static bool SkipSubmit;
@@ -328,7 +342,9 @@ OvrGuiSysLocal::OvrGuiSysLocal(const void* context)
       TextureManager(nullptr),
       LastVrFrameNumber(0),
       RecenterCount(0),
-      IsInitialized(false) {}
+      IsInitialized(false),
+      HitIndexDirty(true),
+      HitIndexHierarchyVersion(0) {}
 
 //==============================
 // OvrGuiSysLocal::
@@ -427,6 +443,7 @@ void OvrGuiSysLocal::Shutdown() {
         ActiveMenus[i] = nullptr;
     }
     ActiveMenus.clear();
+    HitIndexDirty = true;
 
     // We need to make sure we delete any child menus here -- it's not enough to just delete them
     // in the destructor of the parent, because they'll be left in the menu list since the
@@ -605,6 +622,7 @@ void OvrGuiSysLocal::MakeActive(VRMenu* menu) {
     int idx = FindActiveMenuIndex(menu);
     if (idx < 0) {
         ActiveMenus.push_back(menu);
+        HitIndexDirty = true;
     }
 }
 
@@ -619,6 +637,7 @@ void OvrGuiSysLocal::MakeInactive(VRMenu* menu) {
     int idx = FindActiveMenuIndex(menu);
     if (idx >= 0) {
         ActiveMenus.erase(ActiveMenus.cbegin() + idx);
+        HitIndexDirty = true;
     }
 }
 
@@ -900,27 +919,27 @@ void OvrGuiSys::ovrDummySoundEffectPlayer::LoadSoundAsset(const char* name) {
 HitTestResult OvrGuiSysLocal::TestRayIntersection(const Vector3f& start, const Vector3f& dir)
     const {
     HitTestResult result;
-
-    for (int i = static_cast<int>(ActiveMenus.size()) - 1; i >= 0; --i) {
-        VRMenu* curMenu = ActiveMenus[i];
-        if (curMenu == nullptr) {
-            continue;
-        }
-        VRMenuObject* root = GetVRMenuMgr().ToObject(curMenu->GetRootHandle());
-        if (root == nullptr) {
-            continue;
-        }
-
-        HitTestResult r;
-        menuHandle_t hitHandle = root->HitTest(
-            *this, curMenu->GetMenuPose(), start, dir, ContentFlags_t(CONTENT_SOLID), r);
-        if (hitHandle.IsValid() && r.t < result.t) {
-            result = r;
-            result.RayStart = start;
-            result.RayDir = dir;
-        }
-    }
+    TestRayIntersections(&start, &dir, 1, &result);
     return result;
 }
 
+//==============================
+// OvrGuiSysLocal::TestRayIntersections
+void OvrGuiSysLocal::TestRayIntersections(
+    Vector3f const* starts,
+    Vector3f const* dirs,
+    int const numRays,
+    HitTestResult* results) const {
+    std::uint32_t const hierarchyVersion = MenuMgr->GetHierarchyVersion();
+    MenuMgr->TakeHitBoundsChanges(HitIndexChanges);
+    if (HitIndexDirty || hierarchyVersion != HitIndexHierarchyVersion ||
+        !HitIndex.Refit(*this, HitIndexChanges)) {
+        HitIndex.Update(*this, ActiveMenus);
+        HitIndexDirty = false;
+        HitIndexHierarchyVersion = hierarchyVersion;
+    }
+
+    HitIndex.TestRays(*this, starts, dirs, numRays, ContentFlags_t(CONTENT_SOLID), results);
+}
+
 } // namespace OVRFW
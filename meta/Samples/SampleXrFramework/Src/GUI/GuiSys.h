@@ -114,6 +114,14 @@ class OvrGuiSys {
     virtual HitTestResult TestRayIntersection(const OVR::Vector3f& start, const OVR::Vector3f& dir)
         const = 0;
 
+    // Tests several rays at once against all active menus, writing one result per ray. Each result
+    // is the same as calling TestRayIntersection for that ray.
+    virtual void TestRayIntersections(
+        OVR::Vector3f const* starts,
+        OVR::Vector3f const* dirs,
+        int const numRays,
+        HitTestResult* results) const = 0;
+
     //-------------------------------------------------------------
     // Menu management
 
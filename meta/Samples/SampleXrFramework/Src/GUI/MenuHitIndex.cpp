@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuHitIndex.cpp
+Content     :   World-space bounding volume hierarchy for menu ray hit testing.
+Created     :   October 2026
+
+*************************************************************************************/
+
+#include "MenuHitIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "GuiSys.h"
+#include "VRMenu.h"
+#include "VRMenuMgr.h"
+
+using OVR::Bounds3f;
+using OVR::Posef;
+using OVR::Vector3f;
+
+namespace OVRFW {
+
+// IntersectRayBounds reports a hit whenever the ray starts within this distance of the bounds.
+static float const HIT_BOUNDS_EXPAND = 0.1f;
+
+//==============================
+// SortedBounds
+// Scaling by a negative parent scale can swap mins and maxs on an axis, which the slab test in
+// IntersectRayBounds still treats as a valid interval.
+static Bounds3f SortedBounds(Bounds3f const& b) {
+    return Bounds3f(
+        std::min(b.b[0].x, b.b[1].x),
+        std::min(b.b[0].y, b.b[1].y),
+        std::min(b.b[0].z, b.b[1].z),
+        std::max(b.b[0].x, b.b[1].x),
+        std::max(b.b[0].y, b.b[1].y),
+        std::max(b.b[0].z, b.b[1].z));
+}
+
+//==============================
+// RayHitsBounds
+// Conservative slab test for a ray segment starting at rayStart and extending forward.
+static bool RayHitsBounds(Vector3f const& rayStart, Vector3f const& rcpDir, Bounds3f const& b) {
+    float const sX = (b.b[0].x - rayStart.x) * rcpDir.x;
+    float const sY = (b.b[0].y - rayStart.y) * rcpDir.y;
+    float const sZ = (b.b[0].z - rayStart.z) * rcpDir.z;
+    float const tX = (b.b[1].x - rayStart.x) * rcpDir.x;
+    float const tY = (b.b[1].y - rayStart.y) * rcpDir.y;
+    float const tZ = (b.b[1].z - rayStart.z) * rcpDir.z;
+
+    float const t0 = std::max(std::min(sX, tX), std::max(std::min(sY, tY), std::min(sZ, tZ)));
+    float const t1 = std::min(std::max(sX, tX), std::min(std::max(sY, tY), std::max(sZ, tZ)));
+    // NaN from 0 * inf on an axis the ray runs parallel to makes both compares false, so
+    // treat that as a hit to stay conservative.
+    return !(t0 > t1) && !(t1 < 0.0f);
+}
+
+//==============================
+// ovrMenuHitIndex::FlattenObject
+void ovrMenuHitIndex::FlattenObject(
+    OvrGuiSys const& guiSys,
+    VRMenuObject const* obj,
+    Posef const& parentPose,
+    Vector3f const& parentScale,
+    int const parentEntry,
+    int const firstEntry,
+    std::vector<ovrHitEntry>& entries) {
+    // same early outs as VRMenuObject::HitTest_r -- these prune the whole subtree
+    if (obj->GetFlags() & VRMENUOBJECT_DONT_RENDER) {
+        return;
+    }
+    if (obj->GetFlags() & VRMENUOBJECT_DONT_HIT_ALL) {
+        return;
+    }
+
+    // must match TransformByParentPose() in VRMenuObject.cpp exactly
+    Posef const& localPose = obj->GetLocalPose();
+    ovrHitEntry entry;
+    entry.Object = obj;
+    entry.ModelPose.Translation = parentPose.Translation +
+        (parentPose.Rotation * parentScale.EntrywiseMultiply(localPose.Translation));
+    entry.ModelPose.Rotation = parentPose.Rotation * localPose.Rotation;
+    entry.ParentScale = parentScale;
+    entry.Parent = parentEntry;
+    Vector3f const scale = parentScale.EntrywiseMultiply(obj->GetLocalScale());
+
+    // everything HitTestSelf can hit lies within the local bounds or the text bounds
+    BitmapFont const& font = guiSys.GetDefaultFont();
+    Bounds3f localBounds = SortedBounds(obj->GetLocalBounds(font) * parentScale);
+    if (!obj->GetText().empty()) {
+        localBounds = Bounds3f::Union(
+            localBounds, SortedBounds(obj->GetTextLocalBounds(font) * parentScale));
+    }
+    localBounds = Bounds3f::Expand(
+        localBounds, Vector3f(-HIT_BOUNDS_EXPAND), Vector3f(HIT_BOUNDS_EXPAND));
+    entry.WorldBounds = Bounds3f::Transform(entry.ModelPose, localBounds);
+
+    int const local = static_cast<int>(entries.size());
+    int const entryIndex = firstEntry + local;
+    entries.push_back(entry);
+
+    for (int i = 0; i < obj->NumChildren(); ++i) {
+        menuHandle_t const childHandle = obj->GetChildHandleForIndex(i);
+        VRMenuObject const* child = guiSys.GetVRMenuMgr().ToObject(childHandle);
+        if (child != nullptr) {
+            FlattenObject(guiSys, child, entry.ModelPose, scale, entryIndex, firstEntry, entries);
+        }
+    }
+    entries[local].SubtreeEnd = firstEntry + static_cast<int>(entries.size());
+}
+
+//==============================
+// ovrMenuHitIndex::BuildNode
+// Fills Nodes[nodeIndex] with the subtree for LeafEntries[first, first + count).
+void ovrMenuHitIndex::BuildNode(
+    int const nodeIndex,
+    int const parentNode,
+    int const first,
+    int const count) {
+    Bounds3f bounds(Bounds3f::Init);
+    Bounds3f centers(Bounds3f::Init);
+    for (int i = first; i < first + count; ++i) {
+        Bounds3f const& b = Entries[LeafEntries[i]].WorldBounds;
+        bounds = Bounds3f::Union(bounds, b);
+        centers.AddPoint(b.GetCenter());
+    }
+    Nodes[nodeIndex].Bounds = bounds;
+    Nodes[nodeIndex].Parent = parentNode;
+
+    if (count <= MAX_LEAF_ENTRIES) {
+        Nodes[nodeIndex].First = first;
+        Nodes[nodeIndex].Count = count;
+        for (int i = first; i < first + count; ++i) {
+            LeafOf[LeafEntries[i]] = nodeIndex;
+        }
+        return;
+    }
+
+    // median split along the axis with the largest spread of centers
+    Vector3f const spread = centers.GetSize();
+    int axis = 0;
+    if (spread.y > spread[axis]) {
+        axis = 1;
+    }
+    if (spread.z > spread[axis]) {
+        axis = 2;
+    }
+    int const half = count / 2;
+    std::nth_element(
+        LeafEntries.begin() + first,
+        LeafEntries.begin() + first + half,
+        LeafEntries.begin() + first + count,
+        [this, axis](int const a, int const b) {
+            return Entries[a].WorldBounds.GetCenter()[axis] <
+                Entries[b].WorldBounds.GetCenter()[axis];
+        });
+
+    // children are allocated as an adjacent pair after their parent
+    int const left = static_cast<int>(Nodes.size());
+    Nodes.resize(Nodes.size() + 2);
+    Nodes[nodeIndex].First = left;
+    Nodes[nodeIndex].Count = 0;
+    BuildNode(left, nodeIndex, first, half);
+    BuildNode(left + 1, nodeIndex, first + half, count - half);
+}
+
+//==============================
+// ovrMenuHitIndex::Update
+void ovrMenuHitIndex::Update(OvrGuiSys const& guiSys, std::vector<VRMenu*> const& activeMenus) {
+    Entries.clear();
+    Roots.clear();
+    // visit menus in the same order as OvrGuiSysLocal::TestRayIntersection
+    for (int i = static_cast<int>(activeMenus.size()) - 1; i >= 0; --i) {
+        VRMenu const* menu = activeMenus[i];
+        if (menu == nullptr) {
+            continue;
+        }
+        VRMenuObject const* root = guiSys.GetVRMenuMgr().ToObject(menu->GetRootHandle());
+        if (root == nullptr) {
+            continue;
+        }
+        int const first = static_cast<int>(Entries.size());
+        FlattenObject(guiSys, root, menu->GetMenuPose(), Vector3f(1.0f), -1, 0, Entries);
+        ovrHitRoot hitRoot;
+        hitRoot.Menu = menu;
+        hitRoot.Object = root;
+        hitRoot.MenuPose = menu->GetMenuPose();
+        hitRoot.Entry = static_cast<int>(Entries.size()) > first ? first : -1;
+        Roots.push_back(hitRoot);
+    }
+
+    EntryOf.clear();
+    LeafEntries.clear();
+    for (int i = 0; i < static_cast<int>(Entries.size()); ++i) {
+        EntryOf[Entries[i].Object] = i;
+        LeafEntries.push_back(i);
+    }
+    LeafOf.assign(Entries.size(), -1);
+    Nodes.clear();
+    if (!LeafEntries.empty()) {
+        Nodes.resize(1);
+        BuildNode(0, -1, 0, static_cast<int>(LeafEntries.size()));
+    }
+    NodeChanged.assign(Nodes.size(), false);
+
+    GateStamps.assign(Entries.size(), 0);
+    GatePassed.assign(Entries.size(), false);
+    QueryStamp = 0;
+}
+
+//==============================
+// ovrMenuHitIndex::ReflattenSubtree
+bool ovrMenuHitIndex::ReflattenSubtree(
+    OvrGuiSys const& guiSys,
+    int const entryIndex,
+    Posef const& parentPose) {
+    ovrHitEntry const& entry = Entries[entryIndex];
+    SubtreeEntries.clear();
+    FlattenObject(
+        guiSys,
+        entry.Object,
+        parentPose,
+        entry.ParentScale,
+        entry.Parent,
+        entryIndex,
+        SubtreeEntries);
+
+    // the topology stays valid only if the subtree still flattens to the same objects
+    int const count = entry.SubtreeEnd - entryIndex;
+    if (static_cast<int>(SubtreeEntries.size()) != count) {
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (SubtreeEntries[i].Object != Entries[entryIndex + i].Object) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        Entries[entryIndex + i] = SubtreeEntries[i];
+        // flag the path from the entry's leaf up to the root, stopping at a flagged node
+        for (int n = LeafOf[entryIndex + i]; n >= 0 && !NodeChanged[n]; n = Nodes[n].Parent) {
+            NodeChanged[n] = true;
+            ChangedNodes.push_back(n);
+        }
+    }
+    return true;
+}
+
+//==============================
+// ovrMenuHitIndex::RefitChangedNodes
+// Recomputes the bounds of the flagged nodes bottom-up. Children are always stored after their
+// parent, so visiting nodes in decreasing index order visits children first.
+void ovrMenuHitIndex::RefitChangedNodes() {
+    std::sort(ChangedNodes.begin(), ChangedNodes.end(), std::greater<int>());
+    for (int const n : ChangedNodes) {
+        ovrHitNode& node = Nodes[n];
+        Bounds3f bounds(Bounds3f::Init);
+        if (node.Count > 0) {
+            for (int i = node.First; i < node.First + node.Count; ++i) {
+                bounds = Bounds3f::Union(bounds, Entries[LeafEntries[i]].WorldBounds);
+            }
+        } else {
+            bounds = Bounds3f::Union(Nodes[node.First].Bounds, Nodes[node.First + 1].Bounds);
+        }
+        node.Bounds = bounds;
+        NodeChanged[n] = false;
+    }
+    ChangedNodes.clear();
+}
+
+//==============================
+// ovrMenuHitIndex::Refit
+bool ovrMenuHitIndex::Refit(
+    OvrGuiSys const& guiSys,
+    std::vector<VRMenuObject*> const& changedObjects) {
+    ChangedNodes.clear();
+    bool refit = true;
+
+    // a menu that moved re-flattens everything below its root
+    for (ovrHitRoot& root : Roots) {
+        Posef const& menuPose = root.Menu->GetMenuPose();
+        if (menuPose.Translation == root.MenuPose.Translation &&
+            menuPose.Rotation == root.MenuPose.Rotation) {
+            continue;
+        }
+        root.MenuPose = menuPose;
+        if (root.Entry >= 0 && !ReflattenSubtree(guiSys, root.Entry, menuPose)) {
+            refit = false;
+            break;
+        }
+    }
+
+    for (int i = 0; refit && i < static_cast<int>(changedObjects.size()); ++i) {
+        VRMenuObject const* obj = changedObjects[i];
+        auto const it = EntryOf.find(obj);
+        if (it == EntryOf.end()) {
+            // An object that is not indexed only matters if it has just become hit testable,
+            // which is the case if its parent is indexed or it is a menu root.
+            if ((obj->GetFlags() & VRMENUOBJECT_DONT_RENDER) ||
+                (obj->GetFlags() & VRMENUOBJECT_DONT_HIT_ALL)) {
+                continue;
+            }
+            VRMenuObject const* parent = guiSys.GetVRMenuMgr().ToObject(obj->GetParentHandle());
+            bool reachable = parent != nullptr && EntryOf.find(parent) != EntryOf.end();
+            for (ovrHitRoot const& root : Roots) {
+                reachable = reachable || root.Object == obj;
+            }
+            refit = !reachable;
+            continue;
+        }
+
+        int const entryIndex = it->second;
+        int const parentEntry = Entries[entryIndex].Parent;
+        Posef parentPose;
+        if (parentEntry >= 0) {
+            parentPose = Entries[parentEntry].ModelPose;
+        } else {
+            for (ovrHitRoot const& root : Roots) {
+                if (root.Entry == entryIndex) {
+                    parentPose = root.MenuPose;
+                }
+            }
+        }
+        refit = ReflattenSubtree(guiSys, entryIndex, parentPose);
+    }
+
+    if (!refit) {
+        for (int const n : ChangedNodes) {
+            NodeChanged[n] = false;
+        }
+        ChangedNodes.clear();
+        return false;
+    }
+    RefitChangedNodes();
+    return true;
+}
+
+//==============================
+// ovrMenuHitIndex::PassesCullBounds
+// True if the ray passes the cull bounds test of the entry and every one of its ancestors, i.e.
+// if HitTest_r would have reached this object at all.
+bool ovrMenuHitIndex::PassesCullBounds(
+    int const entryIndex,
+    Vector3f const& rayStart,
+    Vector3f const& rayDir) const {
+    if (entryIndex < 0) {
+        return true;
+    }
+    if (GateStamps[entryIndex] == QueryStamp) {
+        return GatePassed[entryIndex];
+    }
+
+    ovrHitEntry const& entry = Entries[entryIndex];
+    bool passed = PassesCullBounds(entry.Parent, rayStart, rayDir);
+    if (passed) {
+        Posef const& modelPose = entry.ModelPose;
+        Vector3f const localStart =
+            modelPose.Rotation.Inverted().Rotate(rayStart - modelPose.Translation);
+        Vector3f const localDir = modelPose.Rotation.Inverted().Rotate(rayDir).Normalized();
+        passed = entry.Object->HitTestCullBounds(localStart, localDir);
+    }
+
+    GateStamps[entryIndex] = QueryStamp;
+    GatePassed[entryIndex] = passed;
+    return passed;
+}
+
+//==============================
+// ovrMenuHitIndex::TestRays
+void ovrMenuHitIndex::TestRays(
+    OvrGuiSys const& guiSys,
+    Vector3f const* rayStarts,
+    Vector3f const* rayDirs,
+    int const numRays,
+    ContentFlags_t const testContents,
+    HitTestResult* results) const {
+    for (int r = 0; r < numRays; ++r) {
+        Vector3f const& rayStart = rayStarts[r];
+        Vector3f const& rayDir = rayDirs[r];
+        results[r] = HitTestResult();
+        if (Nodes.empty()) {
+            continue;
+        }
+
+        if (++QueryStamp == 0) {
+            // wrapped, so stale stamps could alias the new one
+            std::fill(GateStamps.begin(), GateStamps.end(), 0);
+            QueryStamp = 1;
+        }
+
+        Vector3f const rcpDir(
+            rayDir.x != 0.0f ? 1.0f / rayDir.x : INFINITY,
+            rayDir.y != 0.0f ? 1.0f / rayDir.y : INFINITY,
+            rayDir.z != 0.0f ? 1.0f / rayDir.z : INFINITY);
+
+        HitTestResult& best = results[r];
+        int bestEntry = -1;
+
+        NodeStack.clear();
+        NodeStack.push_back(0);
+        while (!NodeStack.empty()) {
+            ovrHitNode const& node = Nodes[NodeStack.back()];
+            NodeStack.pop_back();
+            if (!RayHitsBounds(rayStart, rcpDir, node.Bounds)) {
+                continue;
+            }
+            if (node.Count == 0) {
+                NodeStack.push_back(node.First);
+                NodeStack.push_back(node.First + 1);
+                continue;
+            }
+
+            for (int i = node.First; i < node.First + node.Count; ++i) {
+                int const entryIndex = LeafEntries[i];
+                ovrHitEntry const& entry = Entries[entryIndex];
+                if (!(entry.Object->GetContents() & testContents)) {
+                    continue;
+                }
+                if (!RayHitsBounds(rayStart, rcpDir, entry.WorldBounds)) {
+                    continue;
+                }
+                if (!PassesCullBounds(entryIndex, rayStart, rayDir)) {
+                    continue;
+                }
+
+                Posef const& modelPose = entry.ModelPose;
+                Vector3f const localStart =
+                    modelPose.Rotation.Inverted().Rotate(rayStart - modelPose.Translation);
+                Vector3f const localDir =
+                    modelPose.Rotation.Inverted().Rotate(rayDir).Normalized();
+
+                HitTestResult hit;
+                entry.Object->HitTestSelf(
+                    guiSys, entry.ParentScale, localStart, localDir, testContents, hit);
+                if (!hit.HitHandle.IsValid()) {
+                    continue;
+                }
+                // the recursive walk keeps the first hit in traversal order on ties
+                if (hit.t < best.t || (hit.t == best.t && entryIndex < bestEntry)) {
+                    best = hit;
+                    bestEntry = entryIndex;
+                }
+            }
+        }
+
+        if (bestEntry >= 0) {
+            best.RayStart = rayStart;
+            best.RayDir = rayDir;
+        }
+    }
+}
+
+} // namespace OVRFW
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuHitIndex.h
+Content     :   World-space bounding volume hierarchy for menu ray hit testing.
+Created     :   October 2026
+
+*************************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "OVR_Math.h"
+
+#include "VRMenuObject.h"
+
+namespace OVRFW {
+
+class VRMenu;
+class OvrGuiSys;
+
+//==============================================================
+// ovrMenuHitIndex
+//
+// Flattens the object trees of all active menus into world-space bounds and builds a BVH over
+// them so that a ray only runs the per-object tests in VRMenuObject::HitTestSelf for objects whose
+// bounds it actually crosses. Results are identical to calling VRMenuObject::HitTest on each
+// active menu root: ancestor cull bounds are still honored and ties are broken in the same
+// traversal order.
+//
+// The index holds raw object pointers, so it must be rebuilt with Update whenever objects are
+// created or freed, children are added or removed, or the set of active menus changes. Objects
+// that only moved or changed shape are handled by Refit, which re-flattens just their subtrees
+// and refits the nodes above them.
+class ovrMenuHitIndex {
+   public:
+    ovrMenuHitIndex() : QueryStamp(0) {}
+
+    // Re-flattens the active menus, then refits or rebuilds the hierarchy.
+    void Update(OvrGuiSys const& guiSys, std::vector<VRMenu*> const& activeMenus);
+
+    // Brings the index up to date after changedObjects changed and the menus may have moved.
+    // Returns false, leaving the index stale, if a change added or removed entries, in which
+    // case the caller must call Update instead.
+    bool Refit(OvrGuiSys const& guiSys, std::vector<VRMenuObject*> const& changedObjects);
+
+    // Tests numRays rays and writes one result per ray. The results match
+    // OvrGuiSys::TestRayIntersection for the same ray.
+    void TestRays(
+        OvrGuiSys const& guiSys,
+        OVR::Vector3f const* rayStarts,
+        OVR::Vector3f const* rayDirs,
+        int const numRays,
+        ContentFlags_t const testContents,
+        HitTestResult* results) const;
+
+    int GetNumObjects() const {
+        return static_cast<int>(Entries.size());
+    }
+
+   private:
+    struct ovrHitEntry {
+        VRMenuObject const* Object;
+        OVR::Posef ModelPose; // world pose of the object, without hilight pose
+        OVR::Vector3f ParentScale; // accumulated scale of the object's parent
+        OVR::Bounds3f WorldBounds; // conservative world bounds of everything HitTestSelf can hit
+        int Parent; // index of the parent entry or -1 for a menu root
+        int SubtreeEnd; // one past the last entry of this object's subtree
+    };
+
+    struct ovrHitNode {
+        OVR::Bounds3f Bounds;
+        int First; // first child node if Count == 0, otherwise first index into LeafEntries
+        int Count; // number of entries if this is a leaf
+        int Parent; // parent node or -1 for the root
+    };
+
+    struct ovrHitRoot {
+        VRMenu const* Menu;
+        VRMenuObject const* Object; // root object of the menu
+        OVR::Posef MenuPose; // menu pose the entries were flattened with
+        int Entry; // entry of the root object, or -1 if it is not hit testable
+    };
+
+    static int const MAX_LEAF_ENTRIES = 4;
+
+    // Appends obj's subtree to entries, numbering the first appended entry firstEntry.
+    static void FlattenObject(
+        OvrGuiSys const& guiSys,
+        VRMenuObject const* obj,
+        OVR::Posef const& parentPose,
+        OVR::Vector3f const& parentScale,
+        int const parentEntry,
+        int const firstEntry,
+        std::vector<ovrHitEntry>& entries);
+    void BuildNode(int const nodeIndex, int const parentNode, int const first, int const count);
+    // Re-flattens the subtree of Entries[entryIndex] in place. Returns false if it no longer
+    // flattens to the same objects.
+    bool ReflattenSubtree(
+        OvrGuiSys const& guiSys,
+        int const entryIndex,
+        OVR::Posef const& parentPose);
+    void RefitChangedNodes();
+    bool PassesCullBounds(
+        int const entryIndex,
+        OVR::Vector3f const& rayStart,
+        OVR::Vector3f const& rayDir) const;
+
+    // Entries are stored in the same pre-order that HitTest_r visits objects, so an entry index
+    // doubles as the tie-break order between hits at equal distances.
+    std::vector<ovrHitEntry> Entries;
+    std::vector<ovrHitRoot> Roots; // one per active menu, in flattening order
+    std::unordered_map<VRMenuObject const*, int> EntryOf; // entry index of each indexed object
+    std::vector<int> LeafEntries; // entry indices, grouped by leaf node
+    std::vector<int> LeafOf; // leaf node holding each entry
+    std::vector<ovrHitNode> Nodes; // Nodes[0] is the root; children are always stored in pairs
+
+    // scratch for Refit
+    std::vector<ovrHitEntry> SubtreeEntries;
+    std::vector<int> ChangedNodes;
+    std::vector<bool> NodeChanged;
+
+    // per-ray cache of ancestor cull tests, GatePassed[i] is valid if GateStamps[i] == QueryStamp
+    mutable std::vector<std::uint32_t> GateStamps;
+    mutable std::vector<bool> GatePassed;
+    mutable std::uint32_t QueryStamp;
+    mutable std::vector<int> NodeStack;
+};
+
+} // namespace OVRFW
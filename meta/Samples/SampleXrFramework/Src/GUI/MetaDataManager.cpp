@@ -32,7 +32,16 @@ Authors     :   Jonathan E. Wright, Warsam Osman, Madhu Kalva
 #include "Misc/Log.h"
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <locale>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <sys/stat.h>
 
 #if !defined(OVR_OS_WIN32)
 #include <dirent.h>
@@ -206,56 +215,341 @@ const char* const TAGS = "tags";
 const char* const CATEGORY = "category";
 const char* const URL_INNER = "url";
 
+const char* const INDEX_KEY = "key";
+const char* const INDEX_DIRECTORIES = "directories";
+const char* const INDEX_PATH = "path";
+const char* const INDEX_MODIFIED = "modified";
+const char* const INDEX_FILES = "files";
+const char* const INDEX_URLS = "urls";
+const char* const INDEX_SUBDIRS = "subdirs";
+
+// Returns the modification time of a directory in nanoseconds, or -1 if it does not exist.
+static int64_t DirectoryModifiedTime(const std::string& path) {
+#if defined(OVR_OS_WIN32)
+    struct _stat64 st;
+    if (_stat64(path.c_str(), &st) != 0) {
+        return -1;
+    }
+    return static_cast<int64_t>(st.st_mtime) * 1000000000LL;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return -1;
+    }
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+}
+
+// Returns the time now, in the same nanoseconds as DirectoryModifiedTime.
+static int64_t CurrentTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+// File systems keep times at a coarse granularity, 2 seconds on FAT, so a directory changed this
+// recently could change again without its time changing.
+static const int64_t RECENT_CHANGE_NS = 2000000000LL;
+
+// Written to the index instead of the times of recently changed directories, so they are listed
+// again on the next scan.
+static const int64_t RECENTLY_MODIFIED = -2;
+
+static void ReadJsonStrings(const JsonReader& array, std::vector<std::string>& out) {
+    if (array.IsArray()) {
+        while (!array.IsEndOfArray()) {
+            out.push_back(array.GetNextArrayString());
+        }
+    }
+}
+
+static std::shared_ptr<JSON> WriteJsonStrings(const std::vector<std::string>& strings) {
+    std::shared_ptr<JSON> array = JSON::CreateArray();
+    for (const std::string& s : strings) {
+        array->AddArrayString(s.c_str());
+    }
+    return array;
+}
+
+//==============================
+// ovrDirectoryScanner
+// Lists a directory tree on a pool of worker threads. Each directory is a batch holding its sorted
+// wanted files, with their full paths resolved, and its sub-directories. The calling thread
+// merges batches in depth-first order while the workers carry on with the rest of the tree.
+//
+// Batches can be persisted as an index. A directory whose modification time in every search path
+// matches the index reuses the indexed batch instead of being listed and having each of its files
+// looked up again. A directory's time only changes when entries are added to, removed from or
+// renamed in that directory itself, so every directory is still checked, but unchanged ones only
+// cost a stat per search path. Directories that changed just before they were listed are not
+// reused, since a further change might not move their time.
+class ovrDirectoryScanner {
+   public:
+    struct ovrDirectory {
+        ovrDirectory() : Done(false), Reused(false), Recent(false) {}
+
+        std::string RelativePath;
+        std::vector<int64_t> ModifiedTimes; // per search path, -1 where the directory is missing
+        std::vector<std::string> Files; // sorted relative paths of the files to add
+        std::vector<std::string> Urls; // full path for each file, empty if it was not found
+        std::vector<std::string> SubDirs; // sorted relative paths, with a trailing slash
+        std::vector<int> SubDirBatches; // batch index of each sub-directory
+        bool Done; // set once a worker has filled in the batch
+        bool Reused; // true if the batch came from the index
+        bool Recent; // true if the directory changed too recently to be reused from the index
+    };
+
+    ovrDirectoryScanner(
+        const std::vector<std::string>& searchPaths,
+        std::function<bool(const char*)> shouldAddFile)
+        : SearchPaths(searchPaths), ShouldAddFile(shouldAddFile), Pending(0) {}
+
+    ~ovrDirectoryScanner() {
+        for (std::thread& worker : Workers) {
+            worker.join();
+        }
+    }
+
+    // Loads batches persisted by SaveIndex. The key identifies the search paths and file
+    // extensions the index was built for, and the whole index is ignored if it differs.
+    void LoadIndex(const char* path, const std::string& key) {
+        std::shared_ptr<JSON> index = JSON::Load(path);
+        if (index == nullptr) {
+            return;
+        }
+        const JsonReader root(index);
+        if (!root.IsObject() || root.GetChildStringByName(INDEX_KEY) != key) {
+            ALOG("OvrMetaData ignoring out of date scan index %s", path);
+            return;
+        }
+        const JsonReader directories(root.GetChildByName(INDEX_DIRECTORIES));
+        if (!directories.IsArray()) {
+            return;
+        }
+        while (!directories.IsEndOfArray()) {
+            const JsonReader entry(directories.GetNextArrayElement());
+            if (!entry.IsObject()) {
+                continue;
+            }
+            ovrDirectory dir;
+            dir.RelativePath = entry.GetChildStringByName(INDEX_PATH);
+            std::vector<std::string> modified;
+            ReadJsonStrings(entry.GetChildByName(INDEX_MODIFIED), modified);
+            for (const std::string& m : modified) {
+                dir.ModifiedTimes.push_back(strtoll(m.c_str(), nullptr, 10));
+            }
+            ReadJsonStrings(entry.GetChildByName(INDEX_FILES), dir.Files);
+            ReadJsonStrings(entry.GetChildByName(INDEX_URLS), dir.Urls);
+            ReadJsonStrings(entry.GetChildByName(INDEX_SUBDIRS), dir.SubDirs);
+            if (dir.Files.size() == dir.Urls.size()) {
+                std::string relativePath = dir.RelativePath;
+                Index.emplace(std::move(relativePath), std::move(dir));
+            }
+        }
+    }
+
+    // Saves every batch once the scan has finished. Returns true without writing anything if
+    // the index was already up to date.
+    bool SaveIndex(const char* path, const std::string& key) const {
+        bool changed = Batches.size() != Index.size();
+        for (const std::unique_ptr<ovrDirectory>& dir : Batches) {
+            changed |= !dir->Reused;
+        }
+        if (!changed) {
+            return true;
+        }
+
+        std::shared_ptr<JSON> index = JSON::CreateObject();
+        index->AddStringItem(INDEX_KEY, key.c_str());
+        std::shared_ptr<JSON> directories = JSON::CreateArray();
+        for (const std::unique_ptr<ovrDirectory>& dir : Batches) {
+            std::shared_ptr<JSON> entry = JSON::CreateObject();
+            entry->AddStringItem(INDEX_PATH, dir->RelativePath.c_str());
+            std::vector<std::string> modified;
+            for (const int64_t m : dir->ModifiedTimes) {
+                modified.push_back(std::to_string(dir->Recent ? RECENTLY_MODIFIED : m));
+            }
+            entry->AddItem(INDEX_MODIFIED, WriteJsonStrings(modified));
+            entry->AddItem(INDEX_FILES, WriteJsonStrings(dir->Files));
+            entry->AddItem(INDEX_URLS, WriteJsonStrings(dir->Urls));
+            entry->AddItem(INDEX_SUBDIRS, WriteJsonStrings(dir->SubDirs));
+            directories->AddArrayElement(entry);
+        }
+        index->AddItem(INDEX_DIRECTORIES, directories);
+        return index->Save(path);
+    }
+
+    // Starts scanning from relativePath, which becomes batch 0.
+    void Start(const char* relativePath) {
+        Batches.emplace_back(new ovrDirectory);
+        Batches[0]->RelativePath = relativePath;
+        Queue.push_back(0);
+        Pending = 1;
+
+        // listing is bound by file system latency rather than CPU, but there is little to gain
+        // from more than a few requests in flight
+        const int numWorkers =
+            std::max(1, std::min(4, static_cast<int>(std::thread::hardware_concurrency())));
+        for (int i = 0; i < numWorkers; ++i) {
+            Workers.emplace_back(&ovrDirectoryScanner::WorkerThread, this);
+        }
+    }
+
+    // Waits until a worker has filled in a batch.
+    const ovrDirectory& Wait(const int batchIndex) {
+        std::unique_lock<std::mutex> lock(Mutex);
+        BatchDone.wait(lock, [&]() { return Batches[batchIndex]->Done; });
+        return *Batches[batchIndex];
+    }
+
+   private:
+    void WorkerThread() {
+        for (;;) {
+            int batchIndex;
+            std::string relativePath;
+            {
+                std::unique_lock<std::mutex> lock(Mutex);
+                WorkQueued.wait(lock, [&]() { return !Queue.empty() || Pending == 0; });
+                if (Queue.empty()) {
+                    return;
+                }
+                batchIndex = Queue.front();
+                Queue.pop_front();
+                relativePath = Batches[batchIndex]->RelativePath;
+            }
+
+            ovrDirectory dir;
+            dir.RelativePath = relativePath;
+            ScanDirectory(dir);
+
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                for (const std::string& subDir : dir.SubDirs) {
+                    const int subDirIndex = static_cast<int>(Batches.size());
+                    Batches.emplace_back(new ovrDirectory);
+                    Batches.back()->RelativePath = subDir;
+                    dir.SubDirBatches.push_back(subDirIndex);
+                    Queue.push_back(subDirIndex);
+                    Pending++;
+                }
+                dir.Done = true;
+                *Batches[batchIndex] = std::move(dir);
+                Pending--;
+            }
+            WorkQueued.notify_all();
+            BatchDone.notify_all();
+        }
+    }
+
+    void ScanDirectory(ovrDirectory& dir) const {
+        // times are taken before listing so that changes made while listing cause a rescan
+        const int64_t recentAfter = CurrentTime() - RECENT_CHANGE_NS;
+        for (const std::string& searchPath : SearchPaths) {
+            dir.ModifiedTimes.push_back(DirectoryModifiedTime(searchPath + dir.RelativePath));
+            dir.Recent |= dir.ModifiedTimes.back() >= recentAfter;
+        }
+
+        auto cached = Index.find(dir.RelativePath);
+        if (cached != Index.end() && cached->second.ModifiedTimes == dir.ModifiedTimes) {
+            dir.Files = cached->second.Files;
+            dir.Urls = cached->second.Urls;
+            dir.SubDirs = cached->second.SubDirs;
+            dir.Reused = true;
+            return;
+        }
+
+        std::unordered_map<std::string, std::string> uniqueFileList =
+            RelativeDirectoryFileList(SearchPaths, dir.RelativePath.c_str());
+        std::vector<std::string> fileList;
+        fileList.reserve(uniqueFileList.size());
+        for (auto iter = uniqueFileList.begin(); iter != uniqueFileList.end(); ++iter) {
+            fileList.push_back(iter->second);
+        }
+        SortStringArray(fileList);
+
+        for (const std::string& s : fileList) {
+            if (MatchesExtension(s.c_str(), "/")) {
+                dir.SubDirs.push_back(s);
+            } else if (ShouldAddFile(s.c_str())) {
+                std::string url;
+                if (!GetFullPath(SearchPaths, s.c_str(), url)) {
+                    url.clear();
+                }
+                dir.Files.push_back(s);
+                dir.Urls.push_back(url);
+            }
+        }
+    }
+
+    const std::vector<std::string>& SearchPaths;
+    std::function<bool(const char*)> ShouldAddFile;
+    std::unordered_map<std::string, ovrDirectory> Index; // read-only once scanning starts
+
+    std::mutex Mutex; // guards everything below
+    std::condition_variable WorkQueued;
+    std::condition_variable BatchDone;
+    std::deque<std::unique_ptr<ovrDirectory>> Batches;
+    std::deque<int> Queue; // batches waiting for a worker
+    int Pending; // batches queued or being scanned
+    std::vector<std::thread> Workers;
+};
+
 void OvrMetaData::InitFromDirectory(
     const char* relativePath,
     const std::vector<std::string>& searchPaths,
     const OvrMetaDataFileExtensions& fileExtensions) {
-    ALOG("OvrMetaData::InitFromDirectory( %s )", relativePath);
+    // the index is only valid for the same search paths and extensions
+    std::string indexKey;
+    for (const std::string& searchPath : searchPaths) {
+        indexKey += searchPath + "\n";
+    }
+    for (const std::string& ext : fileExtensions.GoodExtensions) {
+        indexKey += "+" + ext;
+    }
+    for (const std::string& ext : fileExtensions.BadExtensions) {
+        indexKey += "-" + ext;
+    }
 
-    // Find all the files - checks all search paths
-    std::unordered_map<std::string, std::string> uniqueFileList =
-        RelativeDirectoryFileList(searchPaths, relativePath);
-    std::vector<std::string> fileList;
-    for (auto iter = uniqueFileList.begin(); iter != uniqueFileList.end(); ++iter) {
-#if defined(OVR_BUILD_DEBUG)
-        /// We map the lowercase variant (for searching) as a key to the real MixedCase actual file
-        /// name make sure we use the real MixedCase name hence forth ( aka ->second )
-        ALOG("OvrMetaData  fileList[ '%s' ] = '%s'", iter->first.c_str(), iter->second.c_str());
-#endif
-        fileList.push_back(iter->second);
+    ovrDirectoryScanner scanner(searchPaths, [&](const char* fileName) {
+        return ShouldAddFile(fileName, fileExtensions);
+    });
+    if (!ScanIndexPath.empty()) {
+        scanner.LoadIndex(ScanIndexPath.c_str(), indexKey);
     }
-    SortStringArray(fileList);
+    scanner.Start(relativePath);
+
+    AddScannedDirectory(scanner, 0);
+
+    if (!ScanIndexPath.empty() && !scanner.SaveIndex(ScanIndexPath.c_str(), indexKey)) {
+        ALOGW("OvrMetaData failed to write scan index %s", ScanIndexPath.c_str());
+    }
+}
+
+void OvrMetaData::AddScannedDirectory(ovrDirectoryScanner& scanner, const int batchIndex) {
+    const ovrDirectoryScanner::ovrDirectory& dir = scanner.Wait(batchIndex);
+    ALOG("OvrMetaData::InitFromDirectory( %s )", dir.RelativePath.c_str());
+
     Category currentCategory;
-    currentCategory.CategoryTag = ExtractFileBase(relativePath);
+    currentCategory.CategoryTag = ExtractFileBase(dir.RelativePath);
     // The label is the same as the tag by default.
     // Will be replaced if definition found in loaded metadata
     currentCategory.LocaleKey = currentCategory.CategoryTag;
 
     ALOG("OvrMetaData start category: %s", currentCategory.CategoryTag.c_str());
-    std::vector<std::string> subDirs;
-    // Grab the categories and loose files
-    for (const std::string& s : fileList) {
+    // Grab the loose files
+    for (int i = 0; i < static_cast<int>(dir.Files.size()); ++i) {
+        const std::string& s = dir.Files[i];
         ALOG("OvrMetaData category: %s file: %s", currentCategory.CategoryTag.c_str(), s.c_str());
 
-        const std::string fileBase = ExtractFileBase(s);
-        // subdirectory - add category
-        if (MatchesExtension(s.c_str(), "/")) {
-            subDirs.push_back(s);
-            continue;
-        }
-
-        // See if we want this loose-file
-        if (!ShouldAddFile(s.c_str(), fileExtensions)) {
-            continue;
-        }
-
         // Add loose file
+        const std::string fileBase = ExtractFileBase(s);
         const int dataIndex = static_cast<int>(MetaData.size());
         OvrMetaDatum* datum = CreateMetaDatum(fileBase.c_str());
         if (datum) {
             datum->Id = dataIndex;
             datum->Tags.push_back(currentCategory.CategoryTag);
-            if (GetFullPath(searchPaths, s.c_str(), datum->Url)) {
+            if (!dir.Urls[i].empty()) {
+                datum->Url = dir.Urls[i];
                 // always use the lowercase version of the URL to search the map
                 std::string lowerCaseUrl = datum->Url;
                 const auto& loc = std::use_facet<std::ctype<char>>(std::locale());
@@ -289,8 +583,8 @@ void OvrMetaData::InitFromDirectory(
     }
 
     // Recurse into subdirs
-    for (const std::string& subDir : subDirs) {
-        InitFromDirectory(subDir.c_str(), searchPaths, fileExtensions);
+    for (const int subDirBatch : dir.SubDirBatches) {
+        AddScannedDirectory(scanner, subDirBatch);
     }
 }
 
@@ -459,6 +753,9 @@ void OvrMetaData::InitFromDirectoryMergeMeta(
     appFileStoragePath += "/files/";
 
     FilePath = appFileStoragePath + metaFile;
+    if (ScanIndexPath.empty()) {
+        ScanIndexPath = FilePath + ".scanindex";
+    }
 
     assert(HasPermission(FilePath.c_str(), permissionFlags_t(PERMISSION_READ)));
 
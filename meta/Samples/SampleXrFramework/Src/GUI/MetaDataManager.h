@@ -35,6 +35,8 @@ Authors     :   Jonathan E. Wright, Warsam Osman, Madhu Kalva
 
 namespace OVRFW {
 
+class ovrDirectoryScanner;
+
 //==============================================================
 // OvrMetaData
 struct OvrMetaDatum {
@@ -69,7 +71,14 @@ class OvrMetaData {
 
     virtual ~OvrMetaData() {}
 
-    // Init meta data from contents on disk
+    // Persists directory listings to path so that InitFromDirectory only lists directories that
+    // changed since the last scan. InitFromDirectoryMergeMeta uses a file next to the meta file
+    // unless a path is set.
+    void SetScanIndexFile(const char* path) {
+        ScanIndexPath = path;
+    }
+
+    // Init meta data from contents on disk. Directories are listed on worker threads.
     void InitFromDirectory(
         const char* relativePath,
         const std::vector<std::string>& searchPaths,
@@ -201,7 +210,10 @@ class OvrMetaData {
     void Serialize();
 
    private:
+    void AddScannedDirectory(ovrDirectoryScanner& scanner, const int batchIndex);
+
     std::string FilePath;
+    std::string ScanIndexPath;
     std::vector<Category> Categories;
     std::vector<OvrMetaDatum*> MetaData;
     std::unordered_map<std::string, int> UrlToIndex;
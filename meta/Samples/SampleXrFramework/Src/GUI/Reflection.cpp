@@ -27,6 +27,7 @@ Authors     :   Jonathan E. Wright
 
 #include "Reflection.h"
 #include "ReflectionData.h"
+#include "ReflectionBinary.h"
 
 #include "Misc/Log.h"
 #include "Locale/OVR_Locale.h"
@@ -48,13 +49,18 @@ namespace OVRFW {
 //==============================================================================================
 
 template <typename Type>
-bool EnumForName(ovrEnumInfo const* enumInfos, char const* const name, Type& out) {
+bool EnumForName(
+    ovrReflection const& refl,
+    ovrEnumInfo const* enumInfos,
+    char const* const name,
+    Type& out) {
+    ovrEnumInfo const* enumInfo = refl.FindEnumInfo(enumInfos, name);
+    if (enumInfo != nullptr) {
+        out = static_cast<Type>(enumInfo->Value);
+        return true;
+    }
     int enumMax = INT_MIN;
     for (int i = 0; enumInfos[i].Name != nullptr; ++i) {
-        if (OVR::OVR_strcmp(enumInfos[i].Name, name) == 0) {
-            out = static_cast<Type>(enumInfos[i].Value);
-            return true;
-        }
         if (enumInfos[i].Value > enumMax) {
             enumMax = enumInfos[i].Value;
         }
@@ -162,7 +168,7 @@ ovrParseResult ParseDouble(
 }
 
 ovrParseResult ParseEnum(
-    ovrReflection& /*refl*/,
+    ovrReflection& refl,
     ovrLocale const& /*locale*/,
     const char* name,
     ovrLexer& lex,
@@ -178,7 +184,7 @@ ovrParseResult ParseEnum(
         return ovrParseResult(res, "Error parsing '%s': expected enum, got '%s'", name, token);
     }
 
-    if (!EnumForName(atomicInfo->EnumInfos, token, out)) {
+    if (!EnumForName(refl, atomicInfo->EnumInfos, token, out)) {
         return ovrParseResult(
             ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN,
             "Error parsing '%s': expected enum, got '%s'",
@@ -240,7 +246,7 @@ ovrParseResult ParseTypesafeNumber_long_long(
 }
 
 ovrParseResult ParseBitFlags(
-    ovrReflection& /*refl*/,
+    ovrReflection& refl,
     ovrLocale const& /*locale*/,
     const char* name,
     ovrLexer& lex,
@@ -261,7 +267,7 @@ ovrParseResult ParseBitFlags(
         }
 
         int e;
-        bool ok = EnumForName(atomicInfo->EnumInfos, token, e);
+        bool ok = EnumForName(refl, atomicInfo->EnumInfos, token, e);
         if (!ok) {
             return ovrParseResult(
                 ovrLexer::LEX_RESULT_UNEXPECTED_TOKEN,
@@ -288,7 +294,7 @@ ovrParseResult ParseBitFlags(
 }
 
 ovrParseResult ParseString(
-    ovrReflection& /*refl*/,
+    ovrReflection& refl,
     ovrLocale const& locale,
     const char* name,
     ovrLexer& lex,
@@ -304,20 +310,27 @@ ovrParseResult ParseString(
         return ovrParseResult(res, "Error parsing '%s': expected string, got '%s'", name, token);
     }
 
+    AssignString(locale, token, out);
+
+    // the unlocalized text is recorded so compiled data stays valid for any locale
+    if (refl.GetBinaryWriter() != nullptr) {
+        refl.GetBinaryWriter()->WriteString(token);
+    }
+    return ovrParseResult();
+}
+
+void AssignString(ovrLocale const& locale, char const* text, std::string& out) {
     // we find the start of the string because it may be preceeded by a format specifier (~~w0,
     // ~~RRGGBBAA, etc.)
-    char const* keyPtr = strstr(token, "@string/");
+    char const* keyPtr = strstr(text, "@string/");
     if (keyPtr != nullptr) {
-        intptr_t const keyIndex = keyPtr - token;
         std::string temp;
         locale.GetLocalizedString(keyPtr, keyPtr, temp);
-        token[keyIndex] = '\0';
-        out += token;
+        out.append(text, keyPtr - text);
         out += temp;
     } else {
-        out = token;
+        out = text;
     }
-    return ovrParseResult();
 }
 
 ovrParseResult ParseIntVector(
@@ -487,6 +500,12 @@ ovrParseResult ParseArray(
         }
     }
 
+    ovrReflectionBinaryWriter* writer = refl.GetBinaryWriter();
+    ovrReflectionBinaryScope writerScope(writer);
+    if (writer != nullptr) {
+        writer->WriteArrayBegin(OVR::OVR_strcmp(token, "{") ? count : 0);
+    }
+
     // in an array, each entry is a type name
     for (int index = 0;; ++index) {
         ovrLexer::ovrResult res = lex.NextToken(token, MAX_TOKEN);
@@ -519,6 +538,9 @@ ovrParseResult ParseArray(
                 name,
                 token);
         }
+        if (writer != nullptr) {
+            writer->WriteArrayElement(elementTypeInfo);
+        }
 
         if (arrayTypeInfo->ArrayType == ovrArrayType::C_OBJECT ||
             arrayTypeInfo->ArrayType == ovrArrayType::C_POINTER) {
@@ -577,6 +599,9 @@ ovrParseResult ParseArray(
             if (!parseRes) {
                 return parseRes;
             }
+            if (writer != nullptr) {
+                writer->WriteValue(elementTypeInfo, elementPtr);
+            }
 
             parseRes = ExpectPunctuation(name, lex, ";");
             if (!parseRes) {
@@ -589,7 +614,7 @@ ovrParseResult ParseArray(
     }
 }
 
-void BuildScope(ovrReflection& refl, ovrTypeInfo const* typeInfo, std::string& scope) {
+static void BuildScope(ovrReflection& refl, ovrTypeInfo const* typeInfo, std::string& scope) {
     ovrTypeInfo const* parentTypeInfo = refl.FindTypeInfo(typeInfo->ParentTypeName);
     if (parentTypeInfo != nullptr) {
         BuildScope(refl, parentTypeInfo, scope);
@@ -609,14 +634,10 @@ ovrReflectionOverload const* ovrReflection::FindOverload(char const* scope) cons
     return nullptr;
 }
 
-ovrParseResult ParseObject(
-    ovrReflection& refl,
-    ovrLocale const& locale,
-    const char* name,
-    ovrLexer& lex,
-    ovrTypeInfo const* objectTypeInfo,
-    void* objPtr,
-    const size_t /*arraySize*/) {
+void ApplyOverloads(ovrReflection& refl, ovrTypeInfo const* objectTypeInfo, void* objPtr) {
+    if (!refl.HasOverloads()) {
+        return;
+    }
     std::string scope;
     BuildScope(refl, objectTypeInfo, scope);
     ovrReflectionOverload const* o = refl.FindOverload(scope.c_str());
@@ -636,6 +657,17 @@ ovrParseResult ParseObject(
             }
         }
     }
+}
+
+ovrParseResult ParseObject(
+    ovrReflection& refl,
+    ovrLocale const& locale,
+    const char* name,
+    ovrLexer& lex,
+    ovrTypeInfo const* objectTypeInfo,
+    void* objPtr,
+    const size_t /*arraySize*/) {
+    ApplyOverloads(refl, objectTypeInfo, objPtr);
 
     const int MAX_TOKEN = 1024;
     char token[MAX_TOKEN];
@@ -645,6 +677,9 @@ ovrParseResult ParseObject(
         return ovrParseResult(result, "Error parsing '%s': Expected '{', got '%s'", name, token);
     }
 
+    ovrReflectionBinaryWriter* writer = refl.GetBinaryWriter();
+    ovrReflectionBinaryScope writerScope(writer);
+
     // in an object, each entry is a member variable name
     for (;;) {
         ovrLexer::ovrResult res = lex.NextToken(token, MAX_TOKEN);
@@ -674,6 +709,9 @@ ovrParseResult ParseObject(
             return ovrParseResult(
                 res, "Error parsing '%s': Unknown type '%s'", name, memberInfo->TypeName);
         }
+        if (writer != nullptr) {
+            writer->WriteMember(memberInfo, memberTypeInfo);
+        }
 
         if (memberTypeInfo->ParseFn != nullptr) // if we have a special-case parse function, use it
         {
@@ -691,6 +729,9 @@ ovrParseResult ParseObject(
             if (!parseRes) {
                 return parseRes;
             }
+            if (writer != nullptr) {
+                writer->WriteValue(memberTypeInfo, memberPtr);
+            }
 
             if (memberInfo->Operator != ovrTypeOperator::ARRAY) {
                 parseRes = ExpectPunctuation(name, lex, ";");
@@ -745,18 +786,95 @@ void ovrReflection::Shutdown() {
     Overloads.clear();
 }
 
+static uint32_t HashSignature(uint32_t h, void const* data, size_t const size) {
+    for (size_t i = 0; i < size; ++i) {
+        h = (h ^ static_cast<uint8_t const*>(data)[i]) * 0x01000193;
+    }
+    return h;
+}
+
+static uint32_t HashSignature(uint32_t h, char const* s) {
+    // include the terminator so that adjacent names can't run together
+    return s != nullptr ? HashSignature(h, s, OVR::OVR_strlen(s) + 1) : HashSignature(h, "", 1);
+}
+
 void ovrReflection::AddTypeInfoList(ovrTypeInfo const* list) {
     TypeInfoLists.push_back(list);
+
+    uint32_t h = Signature != 0 ? Signature : 0x811c9dc5;
+    for (int i = 0; list[i].TypeName != nullptr; ++i) {
+        ovrTypeInfo const& ti = list[i];
+        TypeIndex.emplace(ti.TypeName, &ti);
+
+        TypeIds.emplace(&ti, static_cast<uint32_t>(Types.size()));
+        Types.push_back(&ti);
+        uint64_t const size = ti.Size;
+        h = HashSignature(h, ti.TypeName);
+        h = HashSignature(h, ti.ParentTypeName);
+        h = HashSignature(h, &size, sizeof(size));
+        h = HashSignature(h, &ti.ArrayType, sizeof(ti.ArrayType));
+        if (ti.MemberInfo != nullptr && MemberIds.find(ti.MemberInfo) == MemberIds.end()) {
+            for (int j = 0; ti.MemberInfo[j].MemberName != nullptr; ++j) {
+                ovrMemberInfo const& mi = ti.MemberInfo[j];
+                MemberIds.emplace(&mi, static_cast<uint32_t>(Members.size()));
+                Members.push_back(&mi);
+                int64_t const layout[3] = {
+                    mi.Offset,
+                    static_cast<int64_t>(mi.ArraySize),
+                    static_cast<int64_t>(mi.Operator)};
+                h = HashSignature(h, mi.MemberName);
+                h = HashSignature(h, mi.TypeName);
+                h = HashSignature(h, layout, sizeof(layout));
+            }
+        }
+
+        // several types can share a member or enum array, emplace skips arrays already indexed
+        if (ti.MemberInfo != nullptr) {
+            for (int j = 0; ti.MemberInfo[j].MemberName != nullptr; ++j) {
+                MemberIndex.emplace(
+                    ovrScopedName{ti.MemberInfo, ti.MemberInfo[j].MemberName}, &ti.MemberInfo[j]);
+            }
+        }
+        if (ti.EnumInfos != nullptr) {
+            for (int j = 0; ti.EnumInfos[j].Name != nullptr; ++j) {
+                EnumIndex.emplace(
+                    ovrScopedName{ti.EnumInfos, ti.EnumInfos[j].Name}, &ti.EnumInfos[j]);
+                // compiled data stores enum values, so renumbering an enum invalidates it
+                h = HashSignature(h, ti.EnumInfos[j].Name);
+                h = HashSignature(h, &ti.EnumInfos[j].Value, sizeof(ti.EnumInfos[j].Value));
+            }
+        }
+    }
+    Signature = h;
+}
+
+uint32_t ovrReflection::GetTypeId(ovrTypeInfo const* typeInfo) const {
+    auto it = TypeIds.find(typeInfo);
+    assert(it != TypeIds.end());
+    return it != TypeIds.end() ? it->second : UINT32_MAX;
+}
+
+ovrTypeInfo const* ovrReflection::GetTypeById(uint32_t const id) const {
+    return id < Types.size() ? Types[id] : nullptr;
+}
+
+uint32_t ovrReflection::GetMemberId(ovrMemberInfo const* memberInfo) const {
+    auto it = MemberIds.find(memberInfo);
+    assert(it != MemberIds.end());
+    return it != MemberIds.end() ? it->second : UINT32_MAX;
+}
+
+ovrMemberInfo const* ovrReflection::GetMemberById(uint32_t const id) const {
+    return id < Members.size() ? Members[id] : nullptr;
 }
 
 ovrMemberInfo const* ovrReflection::FindMemberReflectionInfoRecursive(
     ovrTypeInfo const* objectTypeInfo,
     const char* memberName) {
-    ovrMemberInfo const* arrayOfMemberType = objectTypeInfo->MemberInfo;
-    for (int i = 0; arrayOfMemberType[i].MemberName != nullptr; ++i) {
-        if (!OVR::OVR_strcmp(arrayOfMemberType[i].MemberName, memberName)) {
-            return &arrayOfMemberType[i];
-        }
+    ovrMemberInfo const* memberInfo =
+        FindMemberReflectionInfo(objectTypeInfo->MemberInfo, memberName);
+    if (memberInfo != nullptr) {
+        return memberInfo;
     }
 
     if (objectTypeInfo->ParentTypeName == nullptr) {
@@ -773,12 +891,14 @@ ovrMemberInfo const* ovrReflection::FindMemberReflectionInfoRecursive(
 ovrMemberInfo const* ovrReflection::FindMemberReflectionInfo(
     ovrMemberInfo const* arrayOfMemberType,
     const char* memberName) {
-    for (int i = 0; arrayOfMemberType[i].MemberName != nullptr; ++i) {
-        if (!OVR::OVR_strcmp(arrayOfMemberType[i].MemberName, memberName)) {
-            return &arrayOfMemberType[i];
-        }
-    }
-    return nullptr;
+    auto it = MemberIndex.find(ovrScopedName{arrayOfMemberType, memberName});
+    return it != MemberIndex.end() ? it->second : nullptr;
+}
+
+ovrEnumInfo const* ovrReflection::FindEnumInfo(ovrEnumInfo const* enumInfos, const char* enumName)
+    const {
+    auto it = EnumIndex.find(ovrScopedName{enumInfos, enumName});
+    return it != EnumIndex.end() ? it->second : nullptr;
 }
 
 ovrTypeInfo const* ovrReflection::FindTypeInfo(char const* typeName) {
@@ -787,31 +907,13 @@ ovrTypeInfo const* ovrReflection::FindTypeInfo(char const* typeName) {
         return nullptr;
     }
 
-    for (int i = 0; i < static_cast<int>(TypeInfoLists.size()); ++i) {
-        // ALOG( "FindTypeInfo searching for %s ...", typeName );
-        ovrTypeInfo const* ti = StaticFindTypeInfo(TypeInfoLists[i], typeName);
-        if (ti != nullptr) {
-            return ti;
-        }
+    auto it = TypeIndex.find(typeName);
+    if (it != TypeIndex.end()) {
+        return it->second;
     }
     ALOG("FindTypeInfo for '%s' could not be found! ERROR", typeName);
     assert(false);
     return nullptr;
 }
 
-ovrTypeInfo const* ovrReflection::StaticFindTypeInfo(
-    ovrTypeInfo const* list,
-    char const* typeName) {
-    if (typeName == nullptr || typeName[0] == '\0') {
-        return nullptr;
-    }
-
-    for (int i = 0; list[i].TypeName != nullptr; ++i) {
-        if (!OVR::OVR_strcmp(list[i].TypeName, typeName)) {
-            return &list[i];
-        }
-    }
-    return nullptr;
-}
-
 } // namespace OVRFW
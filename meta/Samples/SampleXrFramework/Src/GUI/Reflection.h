@@ -29,6 +29,8 @@ Authors     :   Jonathan E. Wright
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include "OVR_Types.h"
 #include "OVR_Lexer2.h"
 
@@ -38,6 +40,7 @@ struct ovrTypeInfo;
 struct ovrMemberInfo;
 class ovrLocale;
 class ovrReflection;
+class ovrReflectionBinaryWriter;
 
 //==============================================================================================
 // Parsing
@@ -169,6 +172,10 @@ ovrParseResult ParseObject(
     void* objPtr,
     size_t const arraySize);
 
+// Shared by the text parser and ovrReflectionBinaryReader so both produce the same objects.
+void ApplyOverloads(ovrReflection& refl, ovrTypeInfo const* objectTypeInfo, void* objPtr);
+void AssignString(ovrLocale const& locale, char const* text, std::string& out);
+
 //==============================================================================================
 // Reflection data types
 //==============================================================================================
@@ -280,9 +287,14 @@ class ovrReflection {
 
     void Init();
     void Shutdown();
-    // Add an additional list of types. The list must be terminated by a a
+    // Add an additional list of types. The list must be terminated by an entry with a null
+    // TypeName.
+    // The types, their members and their enums are indexed here so that lookups while parsing
+    // are hashed rather than linear. Names earlier in the list, or in earlier lists, take
+    // precedence, as they did with the linear search.
     void AddTypeInfoList(ovrTypeInfo const* list);
 
+    // The member and enum arrays passed to the Find functions must belong to a registered type.
     ovrMemberInfo const* FindMemberReflectionInfoRecursive(
         ovrTypeInfo const* objectTypeInfo,
         const char* memberName);
@@ -290,21 +302,72 @@ class ovrReflection {
         ovrMemberInfo const* arrayOfMemberType,
         const char* memberName);
     ovrTypeInfo const* FindTypeInfo(char const* typeName);
+    ovrEnumInfo const* FindEnumInfo(ovrEnumInfo const* enumInfos, const char* enumName) const;
 
     void AddOverload(ovrReflectionOverload* o) {
         Overloads.push_back(o);
     }
     ovrReflectionOverload const* FindOverload(char const* scope) const;
+    bool HasOverloads() const {
+        return !Overloads.empty();
+    }
 
-   protected:
-    static ovrTypeInfo const* StaticFindTypeInfo(ovrTypeInfo const* list, char const* typeName);
+    // Registered types and members are numbered in registration order so that compiled
+    // reflection data can refer to them without names.
+    uint32_t GetTypeId(ovrTypeInfo const* typeInfo) const;
+    ovrTypeInfo const* GetTypeById(uint32_t const id) const;
+    uint32_t GetMemberId(ovrMemberInfo const* memberInfo) const;
+    ovrMemberInfo const* GetMemberById(uint32_t const id) const;
+    // Hash of the names and layout of every registered type. Compiled reflection data is only
+    // valid for the signature it was compiled with.
+    uint32_t GetSignature() const {
+        return Signature;
+    }
+
+    // While a writer is set, the parse functions record everything they parse into it.
+    void SetBinaryWriter(ovrReflectionBinaryWriter* writer) {
+        BinaryWriter = writer;
+    }
+    ovrReflectionBinaryWriter* GetBinaryWriter() const {
+        return BinaryWriter;
+    }
 
    private:
+    // A name qualified by the member or enum array that contains it. The names point into the
+    // static reflection tables, so they don't need to be copied.
+    struct ovrScopedName {
+        void const* Scope;
+        std::string_view Name;
+
+        bool operator==(ovrScopedName const& other) const {
+            return Scope == other.Scope && Name == other.Name;
+        }
+    };
+
+    struct ovrScopedNameHash {
+        size_t operator()(ovrScopedName const& n) const {
+            return std::hash<std::string_view>()(n.Name) * 31 +
+                std::hash<void const*>()(n.Scope);
+        }
+    };
+
     std::vector<ovrTypeInfo const*> TypeInfoLists;
     std::vector<ovrReflectionOverload*> Overloads;
 
+    std::unordered_map<std::string_view, ovrTypeInfo const*> TypeIndex;
+    std::unordered_map<ovrScopedName, ovrMemberInfo const*, ovrScopedNameHash> MemberIndex;
+    std::unordered_map<ovrScopedName, ovrEnumInfo const*, ovrScopedNameHash> EnumIndex;
+
+    std::vector<ovrTypeInfo const*> Types;
+    std::vector<ovrMemberInfo const*> Members;
+    std::unordered_map<ovrTypeInfo const*, uint32_t> TypeIds;
+    std::unordered_map<ovrMemberInfo const*, uint32_t> MemberIds;
+    uint32_t Signature;
+
+    ovrReflectionBinaryWriter* BinaryWriter;
+
     // can only be allocated and deleted by ovrReflection::Create and ovrReflection::Destroy
-    ovrReflection(){};
+    ovrReflection() : Signature(0), BinaryWriter(nullptr){};
     virtual ~ovrReflection() {}
 };
 
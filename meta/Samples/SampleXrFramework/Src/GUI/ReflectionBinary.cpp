@@ -0,0 +1,587 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   ReflectionBinary.cpp
+Content     :   Compiled form of reflection text, loaded without tokenizing.
+Created     :   October 18, 2026
+Authors     :
+
+*************************************************************************************/
+
+#include "ReflectionBinary.h"
+
+#include <string.h>
+#include <string_view>
+
+#if !defined(WIN32)
+#include <alloca.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <malloc.h>
+#endif // !defined(WIN32)
+
+#include "Misc/Log.h"
+#include "OVR_FileSys.h"
+
+namespace OVRFW {
+
+// Compiled data is replayed by the same rules the text parser uses to pick how a value is
+// parsed, so these decide which values are recorded as plain bytes.
+static bool IsPlainValue(ovrTypeInfo const* typeInfo) {
+    return typeInfo->ParseFn != ParseArray && typeInfo->ParseFn != ParseObject &&
+        typeInfo->ParseFn != ParseString;
+}
+
+static uint32_t WordCount(size_t const size) {
+    return static_cast<uint32_t>((size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+}
+
+// The name of the type the text parser expects for elements of an array type, as it appears in
+// ovrTypeInfo::TypeName: "T" for "T[]", "std::vector< T >" and "std::vector< T* >".
+static std::string_view ArrayElementTypeName(char const* arrayTypeName) {
+    std::string_view name(arrayTypeName);
+    std::string_view const vectorBegin = "std::vector< ";
+    std::string_view const vectorEnd = " >";
+    if (name.size() > 2 && name.substr(name.size() - 2) == "[]") {
+        name.remove_suffix(2);
+    } else if (
+        name.size() > vectorBegin.size() + vectorEnd.size() &&
+        name.substr(0, vectorBegin.size()) == vectorBegin &&
+        name.substr(name.size() - vectorEnd.size()) == vectorEnd) {
+        name.remove_prefix(vectorBegin.size());
+        name.remove_suffix(vectorEnd.size());
+    }
+    if (!name.empty() && name.back() == '*') {
+        name.remove_suffix(1);
+    }
+    return name;
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteOverload
+void ovrReflectionBinaryWriter::WriteOverload(ovrReflectionOverload const& overload) {
+    switch (overload.GetType()) {
+        case ovrReflectionOverload::OVERLOAD_FLOAT_DEFAULT_VALUE: {
+            Records.push_back(RECORD_OVERLOAD);
+            Records.push_back(overload.GetType());
+            WriteString(overload.GetScope());
+            WriteString(overload.GetName());
+            float const value =
+                static_cast<ovrReflectionOverload_FloatDefaultValue const&>(overload).GetValue();
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            Records.push_back(bits);
+            break;
+        }
+        default:
+            assert(false); // unhandled overload type
+            break;
+    }
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteValueBegin
+void ovrReflectionBinaryWriter::WriteValueBegin(ovrTypeInfo const* typeInfo) {
+    Records.push_back(RECORD_VALUE);
+    Records.push_back(Refl.GetTypeId(typeInfo));
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteArrayBegin
+void ovrReflectionBinaryWriter::WriteArrayBegin(int const explicitCount) {
+    Records.push_back(static_cast<uint32_t>(explicitCount));
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteArrayElement
+void ovrReflectionBinaryWriter::WriteArrayElement(ovrTypeInfo const* elementTypeInfo) {
+    Records.push_back(Refl.GetTypeId(elementTypeInfo));
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteMember
+void ovrReflectionBinaryWriter::WriteMember(
+    ovrMemberInfo const* memberInfo,
+    ovrTypeInfo const* memberTypeInfo) {
+    Records.push_back(Refl.GetMemberId(memberInfo));
+    Records.push_back(Refl.GetTypeId(memberTypeInfo));
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteEnd
+void ovrReflectionBinaryWriter::WriteEnd() {
+    Records.push_back(RECORD_END);
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteString
+void ovrReflectionBinaryWriter::WriteString(char const* text) {
+    auto it = StringOffsets.find(text);
+    if (it == StringOffsets.end()) {
+        it = StringOffsets.emplace(text, static_cast<uint32_t>(Strings.size())).first;
+        Strings.insert(Strings.end(), text, text + OVR::OVR_strlen(text) + 1);
+    }
+    Records.push_back(it->second);
+}
+
+//==============================
+// ovrReflectionBinaryWriter::WriteValue
+void ovrReflectionBinaryWriter::WriteValue(ovrTypeInfo const* typeInfo, void const* valuePtr) {
+    if (!IsPlainValue(typeInfo)) {
+        return;
+    }
+    size_t const offset = Records.size();
+    Records.resize(offset + WordCount(typeInfo->Size), 0);
+    memcpy(&Records[offset], valuePtr, typeInfo->Size);
+}
+
+//==============================
+// ovrReflectionBinaryWriter::Finish
+void ovrReflectionBinaryWriter::Finish(
+    std::vector<uint8_t> const& source,
+    std::vector<uint8_t>& out) const {
+    ovrReflectionBinaryHeader header = {};
+    header.Magic = MAGIC;
+    header.Version = VERSION;
+    header.Signature = Refl.GetSignature();
+    header.SourceSize = static_cast<uint32_t>(source.size());
+    header.SourceHash = HashSource(source.data(), source.size());
+    header.RecordCount = static_cast<uint32_t>(Records.size());
+    header.StringsSize = static_cast<uint32_t>(Strings.size());
+
+    size_t const recordsSize = Records.size() * sizeof(uint32_t);
+    out.resize(sizeof(header) + recordsSize + Strings.size());
+    memcpy(out.data(), &header, sizeof(header));
+    memcpy(out.data() + sizeof(header), Records.data(), recordsSize);
+    memcpy(out.data() + sizeof(header) + recordsSize, Strings.data(), Strings.size());
+}
+
+//==============================
+// ovrReflectionBinaryWriter::HashSource
+// FNV-1a over 64-bit words rather than bytes, since every load hashes the whole text.
+uint64_t ovrReflectionBinaryWriter::HashSource(uint8_t const* source, size_t const size) {
+    uint64_t const prime = 0x100000001b3ull;
+    uint64_t h = 0xcbf29ce484222325ull;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, source + i, sizeof(word));
+        h = (h ^ word) * prime;
+    }
+    for (; i < size; ++i) {
+        h = (h ^ source[i]) * prime;
+    }
+    return h ^ (h >> 32);
+}
+
+//==============================
+// ovrReflectionBinaryReader::ovrReflectionBinaryReader
+ovrReflectionBinaryReader::ovrReflectionBinaryReader(
+    ovrReflection& refl,
+    ovrLocale const& locale)
+    : Refl(refl),
+      Locale(locale),
+      Records(nullptr),
+      RecordCount(0),
+      Cursor(0),
+      Strings(nullptr),
+      StringsSize(0),
+      MappedData(nullptr),
+      MappedSize(0) {}
+
+//==============================
+// ovrReflectionBinaryReader::~ovrReflectionBinaryReader
+ovrReflectionBinaryReader::~ovrReflectionBinaryReader() {
+    Unload();
+}
+
+//==============================
+// ovrReflectionBinaryReader::Load
+bool ovrReflectionBinaryReader::Load(
+    ovrFileSys& fileSys,
+    char const* uri,
+    std::vector<uint8_t> const& source) {
+    Unload();
+
+#if !defined(WIN32)
+    // files outside of the apk can be mapped instead of read
+    std::string path;
+    if (fileSys.GetLocalPathForURI(uri, path)) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    MappedData = data;
+                    MappedSize = st.st_size;
+                }
+            }
+            close(fd);
+        }
+        if (MappedData != nullptr) {
+            if (Validate(uri, static_cast<uint8_t const*>(MappedData), MappedSize, source)) {
+                return true;
+            }
+            Unload();
+            return false;
+        }
+    }
+#endif
+
+    if (!fileSys.ReadFile(uri, Buffer)) {
+        return false;
+    }
+    if (!Validate(uri, Buffer.data(), Buffer.size(), source)) {
+        Unload();
+        return false;
+    }
+    return true;
+}
+
+//==============================
+// ovrReflectionBinaryReader::LoadFromBuffer
+bool ovrReflectionBinaryReader::LoadFromBuffer(
+    char const* name,
+    uint8_t const* buffer,
+    size_t const size,
+    std::vector<uint8_t> const& source) {
+    Unload();
+    if (!Validate(name, buffer, size, source)) {
+        Unload();
+        return false;
+    }
+    return true;
+}
+
+//==============================
+// ovrReflectionBinaryReader::Validate
+bool ovrReflectionBinaryReader::Validate(
+    char const* name,
+    uint8_t const* data,
+    size_t const size,
+    std::vector<uint8_t> const& source) {
+    Name = name;
+    if (size < sizeof(ovrReflectionBinaryHeader) || (reinterpret_cast<uintptr_t>(data) & 3) != 0) {
+        ALOG("ERROR: compiled reflection data '%s' is truncated!", name);
+        return false;
+    }
+    ovrReflectionBinaryHeader const* header =
+        reinterpret_cast<ovrReflectionBinaryHeader const*>(data);
+    if (header->Magic != ovrReflectionBinaryWriter::MAGIC ||
+        header->Version != ovrReflectionBinaryWriter::VERSION) {
+        ALOG(
+            "ERROR: '%s' is not version %u compiled reflection data!",
+            name,
+            ovrReflectionBinaryWriter::VERSION);
+        return false;
+    }
+    if (header->Signature != Refl.GetSignature()) {
+        ALOGW("'%s' was compiled for different reflection data and must be recompiled.", name);
+        return false;
+    }
+    if (header->SourceSize != source.size() ||
+        header->SourceHash !=
+            ovrReflectionBinaryWriter::HashSource(source.data(), source.size())) {
+        ALOGW("'%s' was compiled from a different source file and must be recompiled.", name);
+        return false;
+    }
+    uint64_t const recordsSize = uint64_t(header->RecordCount) * sizeof(uint32_t);
+    if (sizeof(ovrReflectionBinaryHeader) + recordsSize + header->StringsSize > size ||
+        (header->StringsSize > 0 &&
+         data[sizeof(ovrReflectionBinaryHeader) + recordsSize + header->StringsSize - 1] != '\0')) {
+        ALOG("ERROR: compiled reflection data '%s' is truncated!", name);
+        return false;
+    }
+
+    Records = reinterpret_cast<uint32_t const*>(data + sizeof(ovrReflectionBinaryHeader));
+    RecordCount = header->RecordCount;
+    Cursor = 0;
+    Strings = reinterpret_cast<char const*>(data + sizeof(ovrReflectionBinaryHeader) + recordsSize);
+    StringsSize = header->StringsSize;
+    return true;
+}
+
+//==============================
+// ovrReflectionBinaryReader::Unload
+void ovrReflectionBinaryReader::Unload() {
+#if !defined(WIN32)
+    if (MappedData != nullptr) {
+        munmap(MappedData, MappedSize);
+    }
+#endif
+    MappedData = nullptr;
+    MappedSize = 0;
+    Buffer.clear();
+    Records = nullptr;
+    RecordCount = 0;
+    Cursor = 0;
+    Strings = nullptr;
+    StringsSize = 0;
+}
+
+//==============================
+// ovrReflectionBinaryReader::IsElementType
+// ParseArray looks elements up by name, so any type is accepted there and fails later if it is
+// not the array's element type or derived from it. Compiled data is checked up front instead.
+bool ovrReflectionBinaryReader::IsElementType(
+    ovrTypeInfo const* arrayTypeInfo,
+    ovrTypeInfo const* elementTypeInfo) {
+    std::string_view const elementTypeName = ArrayElementTypeName(arrayTypeInfo->TypeName);
+    for (ovrTypeInfo const* typeInfo = elementTypeInfo; typeInfo != nullptr;) {
+        if (elementTypeName == typeInfo->TypeName) {
+            return true;
+        }
+        if (typeInfo->ParentTypeName == nullptr) {
+            break;
+        }
+        typeInfo = Refl.FindTypeInfo(typeInfo->ParentTypeName);
+    }
+    return false;
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadWord
+bool ovrReflectionBinaryReader::ReadWord(uint32_t& out) {
+    if (Cursor >= RecordCount) {
+        return false;
+    }
+    out = Records[Cursor++];
+    return true;
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadString
+ovrParseResult ovrReflectionBinaryReader::ReadString(char const*& text) {
+    uint32_t offset;
+    if (!ReadWord(offset) || offset >= StringsSize) {
+        return ovrParseResult(
+            ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': bad string offset", Name.c_str());
+    }
+    text = Strings + offset;
+    return ovrParseResult();
+}
+
+//==============================
+// ovrReflectionBinaryReader::NextValue
+ovrParseResult ovrReflectionBinaryReader::NextValue(ovrTypeInfo const*& typeInfo) {
+    typeInfo = nullptr;
+    uint32_t record;
+    while (ReadWord(record)) {
+        if (record == ovrReflectionBinaryWriter::RECORD_VALUE) {
+            uint32_t typeId = 0;
+            ReadWord(typeId);
+            typeInfo = Refl.GetTypeById(typeId);
+            if (typeInfo == nullptr) {
+                return ovrParseResult(
+                    ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': bad type id", Name.c_str());
+            }
+            return ovrParseResult();
+        }
+
+        uint32_t overloadType = 0;
+        uint32_t bits = 0;
+        char const* scope = nullptr;
+        char const* name = nullptr;
+        if (record != ovrReflectionBinaryWriter::RECORD_OVERLOAD || !ReadWord(overloadType) ||
+            overloadType != ovrReflectionOverload::OVERLOAD_FLOAT_DEFAULT_VALUE ||
+            !ReadString(scope) || !ReadString(name) || !ReadWord(bits)) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': bad record", Name.c_str());
+        }
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        Refl.AddOverload(new ovrReflectionOverload_FloatDefaultValue(scope, name, value));
+    }
+    return ovrParseResult();
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadValue
+ovrParseResult ovrReflectionBinaryReader::ReadValue(ovrTypeInfo const* typeInfo, void* outPtr) {
+    if (typeInfo->ParseFn == nullptr) {
+        return ReadObject(typeInfo, outPtr);
+    }
+    return ReadAtomic(typeInfo, outPtr, 0);
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadAtomic
+// Matches calling typeInfo->ParseFn.
+ovrParseResult ovrReflectionBinaryReader::ReadAtomic(
+    ovrTypeInfo const* typeInfo,
+    void* outPtr,
+    size_t const arraySize) {
+    if (typeInfo->ParseFn == ParseArray) {
+        return ReadArray(typeInfo, outPtr, arraySize);
+    }
+    if (typeInfo->ParseFn == ParseObject) {
+        return ReadObject(typeInfo, outPtr);
+    }
+    if (typeInfo->ParseFn == ParseString) {
+        char const* text = nullptr;
+        ovrParseResult res = ReadString(text);
+        if (res) {
+            AssignString(Locale, text, *static_cast<std::string*>(outPtr));
+        }
+        return res;
+    }
+
+    uint32_t const words = WordCount(typeInfo->Size);
+    if (words > RecordCount - Cursor) {
+        return ovrParseResult(
+            ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': truncated value", Name.c_str());
+    }
+    memcpy(outPtr, Records + Cursor, typeInfo->Size);
+    Cursor += words;
+    return ovrParseResult();
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadArray
+// Matches ParseArray.
+ovrParseResult ovrReflectionBinaryReader::ReadArray(
+    ovrTypeInfo const* arrayTypeInfo,
+    void* arrayPtr,
+    size_t arraySize) {
+    bool const dynamic = arrayTypeInfo->ArrayType == ovrArrayType::OVR_POINTER ||
+        arrayTypeInfo->ArrayType == ovrArrayType::OVR_OBJECT;
+
+    uint32_t explicitCount;
+    if (!ReadWord(explicitCount) || (explicitCount > 0 && !dynamic)) {
+        return ovrParseResult(
+            ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': bad array", Name.c_str());
+    }
+    int count;
+    if (explicitCount > 0) {
+        count = static_cast<int>(explicitCount);
+        arrayTypeInfo->ResizeArrayFn(arrayPtr, count);
+    } else {
+        count = dynamic ? 0 : static_cast<int>(arraySize);
+    }
+
+    for (int index = 0;; ++index) {
+        uint32_t typeId;
+        if (!ReadWord(typeId)) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': truncated array", Name.c_str());
+        }
+        if (typeId == ovrReflectionBinaryWriter::RECORD_END) {
+            return ovrParseResult();
+        }
+
+        if (index >= count) {
+            if (count != 0) {
+                return ovrParseResult(
+                    ovrLexer::LEX_RESULT_ERROR,
+                    "Error reading '%s': too many array elements",
+                    Name.c_str());
+            }
+            arrayTypeInfo->ResizeArrayFn(arrayPtr, index + 1);
+        }
+
+        ovrTypeInfo const* elementTypeInfo = Refl.GetTypeById(typeId);
+        if (elementTypeInfo == nullptr || !IsElementType(arrayTypeInfo, elementTypeInfo)) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR,
+                "Error reading '%s': bad element type for '%s'",
+                Name.c_str(),
+                arrayTypeInfo->TypeName);
+        }
+
+        void* placementBuffer = nullptr;
+        if (arrayTypeInfo->ArrayType != ovrArrayType::OVR_POINTER &&
+            arrayTypeInfo->ArrayType != ovrArrayType::C_POINTER) {
+            placementBuffer = alloca(elementTypeInfo->Size);
+        }
+        void* elementPtr = elementTypeInfo->CreateFn(placementBuffer);
+
+        ovrParseResult res = elementTypeInfo->MemberInfo != nullptr
+            ? ReadObject(elementTypeInfo, elementPtr)
+            : ReadAtomic(elementTypeInfo, elementPtr, 0);
+        if (!res) {
+            return res;
+        }
+
+        arrayTypeInfo->SetArrayElementFn(arrayPtr, index, elementPtr);
+    }
+}
+
+//==============================
+// ovrReflectionBinaryReader::ReadObject
+// Matches ParseObject.
+ovrParseResult ovrReflectionBinaryReader::ReadObject(
+    ovrTypeInfo const* objectTypeInfo,
+    void* objPtr) {
+    ApplyOverloads(Refl, objectTypeInfo, objPtr);
+
+    for (;;) {
+        uint32_t memberId;
+        uint32_t typeId = 0;
+        if (!ReadWord(memberId) ||
+            (memberId != ovrReflectionBinaryWriter::RECORD_END && !ReadWord(typeId))) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': truncated object", Name.c_str());
+        }
+        if (memberId == ovrReflectionBinaryWriter::RECORD_END) {
+            return ovrParseResult();
+        }
+
+        ovrMemberInfo const* memberInfo = Refl.GetMemberById(memberId);
+        ovrTypeInfo const* memberTypeInfo = Refl.GetTypeById(typeId);
+        if (memberInfo == nullptr || memberTypeInfo == nullptr) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR, "Error reading '%s': bad member id", Name.c_str());
+        }
+        // ParseObject only finds members of the object's type and its parents, and parses each
+        // as its declared type
+        if (Refl.FindMemberReflectionInfoRecursive(objectTypeInfo, memberInfo->MemberName) !=
+            memberInfo) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR,
+                "Error reading '%s': '%s' is not a member of '%s'",
+                Name.c_str(),
+                memberInfo->MemberName,
+                objectTypeInfo->TypeName);
+        }
+        if (Refl.FindTypeInfo(memberInfo->TypeName) != memberTypeInfo) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR,
+                "Error reading '%s': member '%s' is a '%s', not a '%s'",
+                Name.c_str(),
+                memberInfo->MemberName,
+                memberInfo->TypeName,
+                memberTypeInfo->TypeName);
+        }
+
+        void* memberPtr = static_cast<char*>(objPtr) + memberInfo->Offset;
+        ovrParseResult res = memberTypeInfo->ParseFn != nullptr
+            ? ReadAtomic(memberTypeInfo, memberPtr, memberInfo->ArraySize)
+            : ReadObject(memberTypeInfo, memberPtr);
+        if (!res) {
+            return res;
+        }
+    }
+}
+
+} // namespace OVRFW
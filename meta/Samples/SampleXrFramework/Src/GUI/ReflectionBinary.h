@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   ReflectionBinary.h
+Content     :   Compiled form of reflection text, loaded without tokenizing.
+Created     :   October 18, 2026
+Authors     :
+
+*************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Reflection.h"
+
+namespace OVRFW {
+
+class ovrFileSys;
+
+//==============================================================================================
+// Compiled reflection data
+//
+// Records what the text parser did: which types it created, which members it assigned and the
+// values it assigned them, with types and members referred to by their ovrReflection ids. The
+// reader replays the same create, resize and assign calls without tokenizing, looking up names
+// or converting numbers. The text stays the source of truth; compiled data is only accepted if
+// it was compiled from the same text with the same ovrReflection signature, and each member and
+// array element must have the type the text parser would have given it.
+//
+// Layout, little-endian:
+//   ovrReflectionBinaryHeader
+//   uint32_t Records[RecordCount]
+//   char     Strings[StringsSize]   null-terminated strings, each stored once
+//
+// Records are 32-bit words:
+//   file    := ( OVERLOAD type scope name value | VALUE typeId value )*
+//   array   := explicitCount ( elementTypeId element )* END
+//   object  := ( memberId memberTypeId member )* END
+//   string  := offset of the unlocalized text, so the data is valid for every locale
+//   plain   := the bytes the type's ParseFn wrote, padded to whole words
+// Array elements and members are arrays, objects, strings or plain values, chosen by the same
+// rules ParseArray and ParseObject use.
+//==============================================================================================
+
+struct ovrReflectionBinaryHeader {
+    uint32_t Magic;
+    uint32_t Version;
+    uint32_t Signature;
+    uint32_t SourceSize;
+    uint64_t SourceHash;
+    uint32_t RecordCount;
+    uint32_t StringsSize;
+};
+
+//==============================================================
+// ovrReflectionBinaryWriter
+// Set on ovrReflection with SetBinaryWriter while text is parsed.
+class ovrReflectionBinaryWriter {
+   public:
+    static const uint32_t MAGIC = 0x424d564f; // "OVMB"
+    static const uint32_t VERSION = 2;
+
+    enum ovrRecord : uint32_t { RECORD_VALUE, RECORD_OVERLOAD, RECORD_END = 0xffffffff };
+
+    explicit ovrReflectionBinaryWriter(ovrReflection const& refl) : Refl(refl) {}
+
+    void WriteOverload(ovrReflectionOverload const& overload);
+    void WriteValueBegin(ovrTypeInfo const* typeInfo);
+    void WriteArrayBegin(int const explicitCount);
+    void WriteArrayElement(ovrTypeInfo const* elementTypeInfo);
+    void WriteMember(ovrMemberInfo const* memberInfo, ovrTypeInfo const* memberTypeInfo);
+    void WriteEnd();
+    void WriteString(char const* text);
+    // Records a value after typeInfo's ParseFn has parsed it. Arrays and strings are recorded
+    // while they are parsed, so this does nothing for them.
+    void WriteValue(ovrTypeInfo const* typeInfo, void const* valuePtr);
+
+    // source is the text that was parsed, so the reader can tell when it has changed since.
+    void Finish(std::vector<uint8_t> const& source, std::vector<uint8_t>& out) const;
+
+    static uint64_t HashSource(uint8_t const* source, size_t const size);
+
+   private:
+    ovrReflection const& Refl;
+    std::vector<uint32_t> Records;
+    std::vector<char> Strings;
+    std::unordered_map<std::string, uint32_t> StringOffsets;
+};
+
+//==============================================================
+// ovrReflectionBinaryScope
+// Ends an array or object record however the parse function returns.
+class ovrReflectionBinaryScope {
+   public:
+    explicit ovrReflectionBinaryScope(ovrReflectionBinaryWriter* writer) : Writer(writer) {}
+    ~ovrReflectionBinaryScope() {
+        if (Writer != nullptr) {
+            Writer->WriteEnd();
+        }
+    }
+
+   private:
+    ovrReflectionBinaryWriter* Writer;
+};
+
+//==============================================================
+// ovrReflectionBinaryReader
+class ovrReflectionBinaryReader {
+   public:
+    ovrReflectionBinaryReader(ovrReflection& refl, ovrLocale const& locale);
+    ~ovrReflectionBinaryReader();
+
+    ovrReflectionBinaryReader(const ovrReflectionBinaryReader&) = delete;
+    ovrReflectionBinaryReader& operator=(const ovrReflectionBinaryReader&) = delete;
+
+    // Maps the file if the file system gives it a local path, otherwise reads it into memory.
+    // Fails if the file is not compiled reflection data for the current signature, or was
+    // compiled from text other than source.
+    bool Load(ovrFileSys& fileSys, char const* uri, std::vector<uint8_t> const& source);
+    // The buffer is not copied and must stay valid while values are read.
+    bool LoadFromBuffer(
+        char const* name,
+        uint8_t const* buffer,
+        size_t const size,
+        std::vector<uint8_t> const& source);
+
+    // Registers overloads up to the next value and returns its type, or nullptr once every
+    // value has been read.
+    ovrParseResult NextValue(ovrTypeInfo const*& typeInfo);
+    // Reads the value returned by NextValue into outPtr.
+    ovrParseResult ReadValue(ovrTypeInfo const* typeInfo, void* outPtr);
+
+   private:
+    bool Validate(
+        char const* name,
+        uint8_t const* data,
+        size_t const size,
+        std::vector<uint8_t> const& source);
+    bool IsElementType(ovrTypeInfo const* arrayTypeInfo, ovrTypeInfo const* elementTypeInfo);
+    void Unload();
+
+    bool ReadWord(uint32_t& out);
+    ovrParseResult ReadString(char const*& text);
+    ovrParseResult ReadArray(ovrTypeInfo const* arrayTypeInfo, void* arrayPtr, size_t arraySize);
+    ovrParseResult ReadObject(ovrTypeInfo const* objectTypeInfo, void* objPtr);
+    ovrParseResult ReadAtomic(ovrTypeInfo const* typeInfo, void* outPtr, size_t const arraySize);
+
+    ovrReflection& Refl;
+    ovrLocale const& Locale;
+    std::string Name;
+
+    uint32_t const* Records;
+    uint32_t RecordCount;
+    uint32_t Cursor;
+    char const* Strings;
+    uint32_t StringsSize;
+
+    std::vector<uint8_t> Buffer; // owns the data when it was read rather than mapped
+    void* MappedData;
+    size_t MappedSize;
+};
+
+} // namespace OVRFW
@@ -57,32 +57,39 @@ using OVR::Vector4f;
 
 namespace OVRFW {
 
+// Enum info arrays end with an empty entry, like the member and type arrays.
+#define OVR_VERIFY_ENUM_INFO_SIZE(array_, num_enums_) \
+    OVR_VERIFY_ARRAY_SIZE(array_, (num_enums_) + 1)
+
 ovrEnumInfo HorizontalJustification_Enums[] = {
     {.Name = "HORIZONTAL_LEFT", .Value = 0},
     {.Name = "HORIZONTAL_CENTER", .Value = 1},
-    {.Name = "HORIZONTAL_RIGHT", .Value = 2}};
-OVR_VERIFY_ARRAY_SIZE(HorizontalJustification_Enums, 3);
+    {.Name = "HORIZONTAL_RIGHT", .Value = 2},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(HorizontalJustification_Enums, 3);
 
 ovrEnumInfo VerticalJustification_Enums[] = {
     {.Name = "VERTICAL_BASELINE", .Value = 0},
     {.Name = "VERTICAL_CENTER", .Value = 1},
     {.Name = "VERTICAL_CENTER_FIXEDHEIGHT", .Value = 2},
-    {.Name = "VERTICAL_TOP", .Value = 3}};
-OVR_VERIFY_ARRAY_SIZE(VerticalJustification_Enums, 4);
+    {.Name = "VERTICAL_TOP", .Value = 3},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(VerticalJustification_Enums, 4);
 
 ovrEnumInfo eContentFlags_Enums[] = {
     {.Name = "CONTENT_NONE", .Value = 0},
     {.Name = "CONTENT_SOLID", .Value = 1},
     {.Name = "CONTENT_ALL", .Value = 0x7fffffff},
-};
-OVR_VERIFY_ARRAY_SIZE(eContentFlags_Enums, 3);
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(eContentFlags_Enums, 3);
 
 ovrEnumInfo VRMenuObjectType_Enums[] = {
     {.Name = "VRMENU_CONTAINER", .Value = 0},
     {.Name = "VRMENU_STATIC", .Value = 1},
     {.Name = "VRMENU_BUTTON", .Value = 2},
-    {.Name = "VRMENU_MAX", .Value = 3}};
-OVR_VERIFY_ARRAY_SIZE(VRMenuObjectType_Enums, VRMENU_MAX + 1);
+    {.Name = "VRMENU_MAX", .Value = 3},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(VRMenuObjectType_Enums, VRMENU_MAX + 1);
 
 ovrEnumInfo VRMenuObjectFlag_Enums[] = {
     {.Name = "VRMENUOBJECT_FLAG_NO_FOCUS_GAINED", .Value = 0},
@@ -100,13 +107,15 @@ ovrEnumInfo VRMenuObjectFlag_Enums[] = {
     {.Name = "VRMENUOBJECT_RENDER_HIERARCHY_ORDER", .Value = 12},
     {.Name = "VRMENUOBJECT_FLAG_BILLBOARD", .Value = 13},
     {.Name = "VRMENUOBJECT_DONT_MOD_PARENT_COLOR", .Value = 14},
-    {.Name = "VRMENUOBJECT_INSTANCE_TEXT", .Value = 15}};
-OVR_VERIFY_ARRAY_SIZE(VRMenuObjectFlag_Enums, VRMENUOBJECT_MAX);
+    {.Name = "VRMENUOBJECT_INSTANCE_TEXT", .Value = 15},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(VRMenuObjectFlag_Enums, VRMENUOBJECT_MAX);
 
 ovrEnumInfo VRMenuObjectInitFlag_Enums[] = {
     {.Name = "VRMENUOBJECT_INIT_ALIGN_TO_VIEW", .Value = 0},
-    {.Name = "VRMENUOBJECT_INIT_FORCE_POSITION", .Value = 1}};
-OVR_VERIFY_ARRAY_SIZE(VRMenuObjectInitFlag_Enums, 2);
+    {.Name = "VRMENUOBJECT_INIT_FORCE_POSITION", .Value = 1},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(VRMenuObjectInitFlag_Enums, 2);
 
 ovrEnumInfo SurfaceTextureType_Enums[] = {
     {.Name = "SURFACE_TEXTURE_DIFFUSE", .Value = 0},
@@ -115,10 +124,11 @@ ovrEnumInfo SurfaceTextureType_Enums[] = {
     {.Name = "SURFACE_TEXTURE_COLOR_RAMP", .Value = 3},
     {.Name = "SURFACE_TEXTURE_COLOR_RAMP_TARGET", .Value = 4},
     {.Name = "SURFACE_TEXTURE_ALPHA_MASK", .Value = 5},
-    {.Name = "SURFACE_TEXTURE_MAX", .Value = 6}};
-OVR_VERIFY_ARRAY_SIZE(SurfaceTextureType_Enums, SURFACE_TEXTURE_MAX + 1);
+    {.Name = "SURFACE_TEXTURE_MAX", .Value = 6},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(SurfaceTextureType_Enums, SURFACE_TEXTURE_MAX + 1);
 
-ovrEnumInfo VRMenuId_Enums[] = {{.Name = "INVALID_MENU_ID", .Value = INT_MIN}};
+ovrEnumInfo VRMenuId_Enums[] = {{.Name = "INVALID_MENU_ID", .Value = INT_MIN}, {}};
 
 ovrEnumInfo VRMenuEventType_Enums[] = {
     {.Name = "VRMENU_EVENT_FOCUS_GAINED", .Value = 0},
@@ -144,19 +154,22 @@ ovrEnumInfo VRMenuEventType_Enums[] = {
     {.Name = "VRMENU_EVENT_UPDATE_OBJECT", .Value = 20},
     {.Name = "VRMENU_EVENT_SWIPE_COMPLETE", .Value = 21},
     {.Name = "VRMENU_EVENT_ITEM_ACTION_COMPLETE", .Value = 22},
-    {.Name = "VRMENU_EVENT_MAX", .Value = 23}};
-OVR_VERIFY_ARRAY_SIZE(VRMenuEventType_Enums, VRMENU_EVENT_MAX + 1);
+    {.Name = "VRMENU_EVENT_MAX", .Value = 23},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(VRMenuEventType_Enums, VRMENU_EVENT_MAX + 1);
 
 ovrEnumInfo AnimState_Enums[] = {
     {.Name = "ANIMSTATE_PAUSED", .Value = 0},
-    {.Name = "ANIMSTATE_PLAYING", .Value = 1}};
-OVR_VERIFY_ARRAY_SIZE(AnimState_Enums, OvrAnimComponent::ANIMSTATE_MAX);
+    {.Name = "ANIMSTATE_PLAYING", .Value = 1},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(AnimState_Enums, OvrAnimComponent::ANIMSTATE_MAX);
 
 ovrEnumInfo EventDispatchType_Enums[] = {
     {.Name = "EVENT_DISPATCH_TARGET", .Value = 0},
     {.Name = "EVENT_DISPATCH_FOCUS", .Value = 1},
-    {.Name = "EVENT_DISPATCH_BROADCAST", .Value = 2}};
-OVR_VERIFY_ARRAY_SIZE(EventDispatchType_Enums, EVENT_DISPATCH_MAX);
+    {.Name = "EVENT_DISPATCH_BROADCAST", .Value = 2},
+    {}};
+OVR_VERIFY_ENUM_INFO_SIZE(EventDispatchType_Enums, EVENT_DISPATCH_MAX);
 
 template <typename T>
 T* CreateObject(void* placementBuffer) {
@@ -35,8 +35,10 @@ Authors     :   Jonathan E. Wright
 #include "VRMenuEventHandler.h"
 #include "GuiSys.h"
 #include "Reflection.h"
+#include "ReflectionBinary.h"
 
 #include "OVR_FileSys.h"
+#include "OVR_Stream.h"
 #include "Misc/Log.h"
 
 using OVR::Bounds3f;
@@ -320,13 +322,11 @@ void VRMenu::Frame(
     Matrix4f const& traceMat) {
     // OVR_PERF_TIMER( VRMenu_Frame );
 
-    std::vector<VRMenuEvent> events;
-    events.reserve(1024);
-    // copy any pending events
-    for (const auto& pendingEvent : PendingEvents) {
-        events.push_back(pendingEvent);
-    }
-    PendingEvents.resize(0);
+    // take any pending events -- both vectors keep their capacity, so once they have grown no
+    // frame allocates event storage
+    std::vector<VRMenuEvent>& events = FrameEvents;
+    events.clear();
+    events.swap(PendingEvents);
 
     if (!ComponentsInitialized) {
         EventHandler->InitComponents(events);
@@ -498,34 +498,30 @@ void VRMenu::Close(OvrGuiSys& guiSys, bool const instant) {
 //==============================
 // VRMenu::HandleForId
 menuHandle_t VRMenu::HandleForId(OvrVRMenuMgr const& menuMgr, VRMenuId_t const id) const {
-    VRMenuObject* root = menuMgr.ToObject(RootHandle);
-    assert(root != nullptr);
-    return root->ChildHandleForId(menuMgr, id);
+    assert(menuMgr.IsValid(RootHandle));
+    return menuMgr.FindDescendantById(RootHandle, id);
 }
 
 //==============================
 // VRMenu::ObjectForId
 VRMenuObject* VRMenu::ObjectForId(OvrGuiSys const& guiSys, VRMenuId_t const id) const {
-    VRMenuObject* root = guiSys.GetVRMenuMgr().ToObject(RootHandle);
-    assert(root != nullptr);
-    menuHandle_t handle = root->ChildHandleForId(guiSys.GetVRMenuMgr(), id);
+    assert(guiSys.GetVRMenuMgr().IsValid(RootHandle));
+    menuHandle_t handle = guiSys.GetVRMenuMgr().FindDescendantById(RootHandle, id);
     return guiSys.GetVRMenuMgr().ToObject(handle);
 }
 
 //==============================
 // VRMenu::HandleForName
 menuHandle_t VRMenu::HandleForName(OvrVRMenuMgr const& menuMgr, char const* name) const {
-    VRMenuObject* root = menuMgr.ToObject(RootHandle);
-    assert(root != nullptr);
-    return root->ChildHandleForName(menuMgr, name);
+    assert(menuMgr.IsValid(RootHandle));
+    return menuMgr.FindDescendantByName(RootHandle, name);
 }
 
 //==============================
 // VRMenu::ObjectForName
 VRMenuObject* VRMenu::ObjectForName(OvrGuiSys const& guiSys, char const* name) const {
-    VRMenuObject* root = guiSys.GetVRMenuMgr().ToObject(RootHandle);
-    assert(root != nullptr);
-    menuHandle_t handle = root->ChildHandleForName(guiSys.GetVRMenuMgr(), name);
+    assert(guiSys.GetVRMenuMgr().IsValid(RootHandle));
+    menuHandle_t handle = guiSys.GetVRMenuMgr().FindDescendantByName(RootHandle, name);
     return guiSys.GetVRMenuMgr().ToObject(handle);
 }
 
@@ -709,6 +705,23 @@ bool VRMenu::InitFromReflectionData(
         // Add a null terminator
         parmBuffer.push_back('\0');
 
+        // prefer data compiled with CompileReflectionData, which loads without tokenizing, as
+        // long as it was compiled from this text
+        std::string const binaryName = std::string(fileNames[i]) + ".bin";
+        if (fileSys.FileExists(binaryName.c_str())) {
+            ovrReflectionBinaryReader reader(refl, locale);
+            if (reader.Load(fileSys, binaryName.c_str(), parmBuffer)) {
+                ovrParseResult parseResult = VRMenuObject::ParseItemParms(refl, reader, itemParms);
+                if (!parseResult) {
+                    DeletePointerArray(itemParms);
+                    ALOG("%s", parseResult.GetErrorText());
+                    return false;
+                }
+                continue;
+            }
+            ALOG("Falling back to reflection file '%s'.", fileNames[i]);
+        }
+
 #if defined(OVR_BUILD_DEBUG)
 ///  ALOG( "Loaded reflection file:\n==============\n%s\n=================\n", &parmBuffer[0] );
 #endif
@@ -726,4 +739,40 @@ bool VRMenu::InitFromReflectionData(
     return true;
 }
 
+//==============================
+// VRMenu::CompileReflectionData
+bool VRMenu::CompileReflectionData(
+    ovrFileSys& fileSys,
+    ovrReflection& refl,
+    ovrLocale const& locale,
+    char const* fileName,
+    char const* outUri) {
+    std::vector<uint8_t> parmBuffer;
+    if (!fileSys.ReadFile(fileName, parmBuffer)) {
+        ALOG("Failed to load reflection file '%s'.", fileName);
+        return false;
+    }
+    parmBuffer.push_back('\0');
+
+    std::vector<uint8_t> compiled;
+    ovrParseResult parseResult =
+        VRMenuObject::CompileItemParms(refl, locale, fileName, parmBuffer, compiled);
+    if (!parseResult) {
+        ALOG("%s", parseResult.GetErrorText());
+        return false;
+    }
+
+    ovrStream* stream = fileSys.OpenStream(outUri, OVR_STREAM_MODE_WRITE);
+    if (stream == nullptr) {
+        ALOG("Failed to open '%s' for writing.", outUri);
+        return false;
+    }
+    bool const written = stream->Write(compiled.data(), compiled.size());
+    fileSys.CloseStream(stream);
+    if (!written) {
+        ALOG("Failed to write '%s'.", outUri);
+    }
+    return written;
+}
+
 } // namespace OVRFW
@@ -100,6 +100,16 @@ class VRMenu {
         float const menuDistance,
         VRMenuFlags_t const& flags);
 
+    // Compiles a reflection file so InitFromReflectionData can load <fileName>.bin instead.
+    // Compiled data is ignored once the reflection data or the file changes, until it is
+    // compiled again.
+    static bool CompileReflectionData(
+        ovrFileSys& fileSys,
+        ovrReflection& refl,
+        ovrLocale const& locale,
+        char const* fileName,
+        char const* outUri);
+
     void Init(
         OvrGuiSys& guiSys,
         float const menuDistance,
@@ -244,6 +254,7 @@ class VRMenu {
 
     VRMenuEventHandler* EventHandler;
     std::vector<VRMenuEvent> PendingEvents; // events pending since the last frame
+    std::vector<VRMenuEvent> FrameEvents; // events handled on the current frame
 
     std::string Name; // name of the menu
 
@@ -47,7 +47,7 @@ namespace OVRFW {
 
 //==============================
 // VRMenuEventHandler::VRMenuEventHandler
-VRMenuEventHandler::VRMenuEventHandler() {}
+VRMenuEventHandler::VRMenuEventHandler() : BroadcastVersion(0) {}
 
 //==============================
 // VRMenuEventHandler::~VRMenuEventHandler
@@ -277,35 +277,34 @@ void VRMenuEventHandler::HandleEvents(
     OvrGuiSys& guiSys,
     ovrApplFrameIn const& vrFrame,
     menuHandle_t const rootHandle,
-    std::vector<VRMenuEvent> const& events) const {
+    std::vector<VRMenuEvent> const& events) {
     VRMenuObject* root = guiSys.GetVRMenuMgr().ToObject(rootHandle);
     if (root == nullptr) {
         return;
     }
 
     // find the list of all objects that are in the focused path
-    std::vector<menuHandle_t> focusPath;
-    focusPath.reserve(256);
-    FindTargetPath(guiSys, rootHandle, FocusedHandle, focusPath);
+    FocusPath.clear();
+    FindTargetPath(guiSys, rootHandle, FocusedHandle, FocusPath);
 
-    std::vector<menuHandle_t> targetPath;
+    TargetPath.clear();
 
     for (VRMenuEvent const& event : events) {
         switch (event.DispatchType) {
             case EVENT_DISPATCH_BROADCAST: {
                 // broadcast to everything
-                BroadcastEvent(guiSys, vrFrame, event, root);
+                BroadcastEvent(guiSys, vrFrame, event, rootHandle);
             } break;
             case EVENT_DISPATCH_FOCUS:
                 // send to the focus path only -- this list should be parent -> child order
-                DispatchToPath(guiSys, vrFrame, event, focusPath, false);
+                DispatchToPath(guiSys, vrFrame, event, FocusPath, false);
                 break;
             case EVENT_DISPATCH_TARGET:
-                if (targetPath.empty() || event.TargetHandle != targetPath.back()) {
-                    targetPath.clear();
-                    FindTargetPath(guiSys, rootHandle, event.TargetHandle, targetPath);
+                if (TargetPath.empty() || event.TargetHandle != TargetPath.back()) {
+                    TargetPath.clear();
+                    FindTargetPath(guiSys, rootHandle, event.TargetHandle, TargetPath);
                 }
-                DispatchToPath(guiSys, vrFrame, event, targetPath, false);
+                DispatchToPath(guiSys, vrFrame, event, TargetPath, false);
                 break;
             default:
                 assert(!(bool)"unknown dispatch type");
@@ -378,27 +377,93 @@ bool VRMenuEventHandler::DispatchToPath(
     return false;
 }
 
+//==============================
+// AppendBroadcastEntries
+template <typename Entry>
+static void AppendBroadcastEntries(
+    OvrVRMenuMgr& menuMgr,
+    VRMenuObject* obj,
+    std::vector<Entry>& list) {
+    for (VRMenuComponent* component : obj->GetComponentList()) {
+        list.push_back({obj, component});
+    }
+    int const numChildren = obj->NumChildren();
+    for (int i = 0; i < numChildren; ++i) {
+        VRMenuObject* child = menuMgr.ToObject(obj->GetChildHandleForIndex(i));
+        if (child != nullptr) {
+            AppendBroadcastEntries(menuMgr, child, list);
+        }
+    }
+}
+
+//==============================
+// VRMenuEventHandler::BuildBroadcastList
+void VRMenuEventHandler::BuildBroadcastList(OvrVRMenuMgr& menuMgr, menuHandle_t const rootHandle) {
+    BroadcastList.clear();
+    BroadcastRoot = rootHandle;
+    BroadcastVersion = menuMgr.GetHierarchyVersion();
+    VRMenuObject* root = menuMgr.ToObject(rootHandle);
+    if (root != nullptr) {
+        AppendBroadcastEntries(menuMgr, root, BroadcastList);
+    }
+}
+
+//==============================
+// VRMenuEventHandler::ResumeBroadcastList
+// Rebuilds the list after a component changed the hierarchy while handling the entry at index,
+// and returns the index in the new list that the broadcast continues after. Components are only
+// freed between frames, so the handler that made the change is normally still in the list; if its
+// object was freed, the broadcast continues with the next entry that still exists.
+int VRMenuEventHandler::ResumeBroadcastList(
+    OvrVRMenuMgr& menuMgr,
+    menuHandle_t const rootHandle,
+    int const index) {
+    PrevBroadcastList.swap(BroadcastList);
+    BuildBroadcastList(menuMgr, rootHandle);
+    for (int i = index; i < static_cast<int>(PrevBroadcastList.size()); ++i) {
+        for (int j = 0; j < static_cast<int>(BroadcastList.size()); ++j) {
+            if (BroadcastList[j].Component == PrevBroadcastList[i].Component) {
+                PrevBroadcastList.clear();
+                // the entry that was handled is done, entries that replace later ones are not
+                return i == index ? j : j - 1;
+            }
+        }
+    }
+    PrevBroadcastList.clear();
+    return static_cast<int>(BroadcastList.size());
+}
+
 //==============================
 // VRMenuEventHandler::BroadcastEvent
+// Components are reached in the same order as a depth-first walk of the tree, with an object's
+// components before its children's, and the first one to consume the event ends the broadcast.
 bool VRMenuEventHandler::BroadcastEvent(
     OvrGuiSys& guiSys,
     ovrApplFrameIn const& vrFrame,
     VRMenuEvent const& event,
-    VRMenuObject* receiver) const {
-    /// assert_WITH_TAG( receiver != NULL, "VrMenu" );
-
-    // allow parent components to handle first
-    if (DispatchToComponents(guiSys, vrFrame, event, receiver)) {
-        return true;
+    menuHandle_t const rootHandle) {
+    OvrVRMenuMgr& menuMgr = guiSys.GetVRMenuMgr();
+    if (BroadcastRoot != rootHandle || BroadcastVersion != menuMgr.GetHierarchyVersion()) {
+        BuildBroadcastList(menuMgr, rootHandle);
     }
 
-    // if the parent did not consume, dispatch to children
-    int numChildren = receiver->NumChildren();
-    for (int i = 0; i < numChildren; ++i) {
-        menuHandle_t childHandle = receiver->GetChildHandleForIndex(i);
-        VRMenuObject* child = guiSys.GetVRMenuMgr().ToObject(childHandle);
-        if (child != nullptr && BroadcastEvent(guiSys, vrFrame, event, child)) {
-            return true; // consumed by child
+    VRMenuEventFlags_t const eventFlags(event.EventType);
+    for (int i = 0; i < static_cast<int>(BroadcastList.size()); ++i) {
+        ovrBroadcastEntry const entry = BroadcastList[i];
+        if (!entry.Component->HandlesEvent(eventFlags)) {
+            continue;
+        }
+        LogEventType(event, "DispatchEvent: to '%s'", entry.Object->GetText().c_str());
+        if (entry.Component->OnEvent(guiSys, vrFrame, entry.Object, event) ==
+            MSG_STATUS_CONSUMED) {
+            LogEventType(
+                event,
+                "DispatchEvent: receiver '%s' consumed event.",
+                entry.Object->GetText().c_str());
+            return true;
+        }
+        if (BroadcastVersion != menuMgr.GetHierarchyVersion()) {
+            i = ResumeBroadcastList(menuMgr, rootHandle, i);
         }
     }
     return false;
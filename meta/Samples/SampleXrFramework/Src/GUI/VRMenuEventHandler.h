@@ -54,7 +54,7 @@ class VRMenuEventHandler {
         OvrGuiSys& guiSys,
         const ovrApplFrameIn& vrFrame,
         menuHandle_t const rootHandle,
-        std::vector<VRMenuEvent> const& events) const;
+        std::vector<VRMenuEvent> const& events);
 
     void InitComponents(std::vector<VRMenuEvent>& events);
     void Opening(std::vector<VRMenuEvent>& events);
@@ -67,8 +67,26 @@ class VRMenuEventHandler {
     }
 
    private:
+    // a component below the root, listed in the order a broadcast reaches it
+    struct ovrBroadcastEntry {
+        VRMenuObject* Object;
+        VRMenuComponent* Component;
+    };
+
     menuHandle_t FocusedHandle;
 
+    // Broadcasts walk this list instead of recursing through the tree. It holds every object's
+    // own components followed by those of its children's subtrees, and is rebuilt whenever the
+    // menu manager's hierarchy version changes.
+    std::vector<ovrBroadcastEntry> BroadcastList;
+    std::vector<ovrBroadcastEntry> PrevBroadcastList; // used to resume after a change mid-broadcast
+    menuHandle_t BroadcastRoot;
+    std::uint32_t BroadcastVersion;
+
+    // reused every frame so that dispatching does not allocate
+    std::vector<menuHandle_t> FocusPath;
+    std::vector<menuHandle_t> TargetPath;
+
     ovrSoundLimiter GazeOverSoundLimiter;
     ovrSoundLimiter DownSoundLimiter;
     ovrSoundLimiter UpSoundLimiter;
@@ -89,7 +107,9 @@ class VRMenuEventHandler {
         OvrGuiSys& guiSys,
         ovrApplFrameIn const& vrFrame,
         VRMenuEvent const& event,
-        VRMenuObject* receiver) const;
+        menuHandle_t const rootHandle);
+    void BuildBroadcastList(OvrVRMenuMgr& menuMgr, menuHandle_t const rootHandle);
+    int ResumeBroadcastList(OvrVRMenuMgr& menuMgr, menuHandle_t const rootHandle, int const index);
 };
 
 } // namespace OVRFW
@@ -28,6 +28,12 @@ Authors     :   Jonathan E. Wright
 #include "VRMenuMgr.h"
 
 #include <algorithm>
+#include <ctype.h>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #include "Render/DebugLines.h"
 #include "Render/BitmapFont.h"
@@ -326,6 +332,14 @@ class VRMenuMgrLocal : public OvrVRMenuMgr {
     // Return the object for a menu handle or NULL if the object does not exist or the
     // handle is invalid;
     virtual VRMenuObject* ToObject(menuHandle_t const handle) const;
+    virtual std::uint32_t GetHierarchyVersion() const {
+        return HierarchyVersion;
+    }
+    virtual void TakeHitBoundsChanges(std::vector<VRMenuObject*>& objects);
+    virtual menuHandle_t FindDescendantById(menuHandle_t const rootHandle, VRMenuId_t const id)
+        const;
+    virtual menuHandle_t FindDescendantByName(menuHandle_t const rootHandle, char const* name)
+        const;
 
     // Submits the specified menu object to be renderered
     virtual void SubmitForRendering(
@@ -338,6 +352,11 @@ class VRMenuMgrLocal : public OvrVRMenuMgr {
     // Call once per frame before rendering to sort surfaces.
     virtual void Finish(Matrix4f const& viewMatrix);
 
+    virtual void GetSubmitStats(int& outEvaluated, int& outReused) const {
+        outEvaluated = StatsEvaluated;
+        outReused = StatsReused;
+    }
+
     virtual void AppendSurfaceList(
         Matrix4f const& centerViewMatrix,
         std::vector<ovrDrawSurface>& surfaceList);
@@ -358,14 +377,33 @@ class VRMenuMgrLocal : public OvrVRMenuMgr {
     VRMenuMgrLocal& operator=(const VRMenuMgrLocal&);
 
     void AddComponentToDeletionList(menuHandle_t const ownerHandle, VRMenuComponent* component);
+    void HierarchyChanged() {
+        HierarchyVersion++;
+    }
+    void HitBoundsChanged(VRMenuObject& obj);
     void ExecutePendingComponentDeletions();
 
-    void CondenseList();
-    void SubmitForRenderingRecursive(
+    // Returns the live object in a pool slot, or nullptr if the slot is empty or the id is stale.
+    VRMenuObject* SlotObject(int const index, std::uint32_t const id) const;
+    // Destroys the object in a slot in-place and returns the slot to the free list. Does nothing
+    // if the slot no longer holds the object with the given id.
+    void ReleaseSlot(int const index, std::uint32_t const id);
+    // returns the handle of the only candidate slot below rootHandle, or needsWalk if there are
+    // several so the caller can fall back to a depth-first search to pick the first one
+    template <typename Iterator>
+    menuHandle_t SingleDescendant(
+        menuHandle_t const rootHandle,
+        Iterator const begin,
+        Iterator const end,
+        bool& needsWalk) const;
+    // Returns false if nothing was submitted for obj because it is hidden or the submission list
+    // is full, in which case cullBounds is not written. prevIndex and prevTextDraw locate the
+    // subtree's entries from the previous frame, or are -1 if they are not known.
+    bool SubmitForRenderingRecursive(
         OvrGuiSys& guiSys,
         Matrix4f const& centerViewMatrix,
         VRMenuRenderFlags_t const& flags,
-        VRMenuObject const* obj,
+        VRMenuObject* obj,
         Posef const& parentModelPose,
         Vector4f const& parentColor,
         Vector3f const& parentScale,
@@ -373,27 +411,125 @@ class VRMenuMgrLocal : public OvrVRMenuMgr {
         SubmittedMenuObject* submitted,
         int const maxIndices,
         int& curIndex,
+        int const distanceIndex,
+        int const prevIndex,
+        int const prevTextDraw);
+    // Returns true if the entries obj submitted last frame can be copied instead of re-evaluated.
+    bool CanReuseSubmitted(
+        VRMenuObject const* obj,
+        VRMenuRenderFlags_t const& flags,
+        Posef const& parentModelPose,
+        Vector4f const& parentColor,
+        Vector3f const& parentScale,
         int const distanceIndex) const;
+    // Copies obj's subtree entries and text draws from the previous frame.
+    void ReuseSubmitted(
+        OvrGuiSys& guiSys,
+        VRMenuObject const* obj,
+        SubmittedMenuObject* submitted,
+        int& curIndex,
+        int const distanceIndex,
+        int const prevIndex,
+        int const prevTextDraw);
+    // Debug drawing happens during evaluation, so nothing is reused while any of it is enabled.
+    static bool CanRetainSubmissions() {
+        return !ShowCollision && !ShowDebugBounds && !ShowDebugHierarchy && !ShowPoses &&
+            !ShowWrapWidths;
+    }
 
     //--------------------------------------------------------------
     // private members
     //--------------------------------------------------------------
     OvrGuiSys& GuiSys; // reference to the GUI sys that owns this menu manager
     std::uint32_t CurrentId; // ever-incrementing object ID (well... up to 4 billion or so :)
-    std::vector<VRMenuObject*> ObjectList; // list of all menu objects
-    std::vector<int> FreeList; // list of free slots in the array
+    std::uint32_t HierarchyVersion; // incremented whenever children or components change
+
+    // Menu objects are constructed in-place in fixed-size chunks so that traversals touch
+    // contiguous memory and chunks never move, which keeps object pointers stable. A slot's index
+    // is the index part of the menuHandle_t and SlotIds holds the id of the object currently living
+    // in each slot (INVALID_MENU_OBJECT_ID when the slot is free), so stale handles are rejected
+    // without touching the destroyed object.
+    static int const OBJECTS_PER_CHUNK = 64;
+    struct ovrObjectChunk {
+        alignas(VRMenuObject) unsigned char Storage[OBJECTS_PER_CHUNK * sizeof(VRMenuObject)];
+    };
+    std::vector<std::unique_ptr<ovrObjectChunk>> ObjectChunks; // storage for all menu objects
+    std::vector<std::uint32_t> SlotIds; // id of the object in each slot
+    std::vector<int> FreeList; // list of free slots in the pool
+    // reused work list of slots, with the ids they hold, when freeing a subtree
+    std::vector<std::pair<int, std::uint32_t>> FreeScratch;
+    // slots and ids of objects whose hit bounds changed since the last TakeHitBoundsChanges,
+    // each object is queued at most once
+    std::vector<std::pair<int, std::uint32_t>> HitChanges;
+
+    // Object ids and names never change after construction, so every live object is indexed by
+    // them from creation until its slot is released. Which menu an object belongs to is checked
+    // by walking its parent handles at lookup time, so reparenting needs no index update.
+    struct ovrNameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view const s) const {
+            size_t h = 2166136261u;
+            for (char const c : s) {
+                h = (h ^ static_cast<size_t>(tolower(static_cast<unsigned char>(c)))) * 16777619u;
+            }
+            return h;
+        }
+    };
+    struct ovrNameEqual {
+        using is_transparent = void;
+        bool operator()(std::string_view const a, std::string_view const b) const {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (tolower(static_cast<unsigned char>(a[i])) !=
+                    tolower(static_cast<unsigned char>(b[i]))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+    std::unordered_multimap<long long, int> IdIndex; // slots by VRMenuId_t
+    std::unordered_multimap<std::string, int, ovrNameHash, ovrNameEqual> NameIndex; // slots by name
 
     std::vector<ovrComponentList>
         PendingDeletions; // list of components (and owning objects) that are pending deletion
 
     bool Initialized; // true if Init has been called
 
-    SubmittedMenuObject Submitted[MAX_SUBMITTED]; // all objects that have been submitted for
-                                                  // rendering on the current frame
+    // non-instanced text is drawn into the font surface every frame, so it is recorded to be
+    // replayed along with the submitted entries of a reused subtree
+    struct ovrMenuTextDraw {
+        menuHandle_t Handle; // object whose text is drawn
+        fontParms_t FontParms;
+        Vector3f Position;
+        Vector3f Normal;
+        Vector3f Up;
+        float Scale;
+        Vector4f Color;
+    };
+
+    // Submissions are double-buffered: while the current frame is built in Submitted[CurBuffer],
+    // the other buffer still holds the previous frame so unchanged subtrees can be copied from it.
+    SubmittedMenuObject Submitted[2][MAX_SUBMITTED]; // all objects that have been submitted for
+                                                     // rendering on the current frame
+    std::vector<ovrMenuTextDraw> TextDraws[2]; // text drawn on the current and previous frame
+    std::vector<menuHandle_t> SubmittedRoots[2]; // root objects submitted, in submission order
+    int CurBuffer; // buffer being built for the current frame
+    int RenderBuffer; // buffer that was sorted by the last Finish()
+    std::uint32_t FrameCount; // incremented by every Finish()
+    std::uint32_t LayoutCounter; // source of VRMenuObject::ovrSubmitCache::LayoutId
     std::vector<SurfSort>
         SortKeys; // sort key consisting of distance from view and submission index
+    Vector3f SortViewPos; // view position SortKeys were generated for
     int NumSubmitted; // number of currently submitted menu objects
     mutable int NumToRender; // number of submitted objects to render
+    int NumEvaluated; // objects re-evaluated on the current frame
+    int NumReused; // objects whose entries were copied from the previous frame
+    int StatsEvaluated; // NumEvaluated of the last finished frame
+    int StatsReused; // NumReused of the last finished frame
+    bool StatsSortSkipped; // true if the last Finish() kept the previous sort order
 
     GlProgram GUIProgramDiffuseOnly; // has a diffuse only
     GlProgram GUIProgramDiffuseAlphaDiscard; // diffuse, but discard fragments with 0 alpha
@@ -483,11 +619,104 @@ void VRMenuMgrLocal::DebugWordWrap(void* appPtr, const char* parms) {
 //==================================
 // VRMenuMgrLocal::VRMenuMgrLocal
 VRMenuMgrLocal::VRMenuMgrLocal(OvrGuiSys& guiSys)
-    : GuiSys(guiSys), CurrentId(0), Initialized(false), NumSubmitted(0), NumToRender(0) {}
+    : GuiSys(guiSys),
+      CurrentId(0),
+      HierarchyVersion(0),
+      Initialized(false),
+      CurBuffer(0),
+      RenderBuffer(0),
+      FrameCount(1),
+      LayoutCounter(0),
+      SortViewPos(0.0f),
+      NumSubmitted(0),
+      NumToRender(0),
+      NumEvaluated(0),
+      NumReused(0),
+      StatsEvaluated(0),
+      StatsReused(0),
+      StatsSortSkipped(false) {}
 
 //==================================
 // VRMenuMgrLocal::~VRMenuMgrLocal
-VRMenuMgrLocal::~VRMenuMgrLocal() {}
+VRMenuMgrLocal::~VRMenuMgrLocal() {
+    // the chunks only own raw storage, so any objects still alive must be destructed here
+    for (int i = 0; i < static_cast<int>(SlotIds.size()); ++i) {
+        if (SlotIds[i] != INVALID_MENU_OBJECT_ID) {
+            ReleaseSlot(i, SlotIds[i]);
+        }
+    }
+}
+
+//==================================
+// VRMenuMgrLocal::SlotObject
+VRMenuObject* VRMenuMgrLocal::SlotObject(int const index, std::uint32_t const id) const {
+    if (index < 0 || index >= static_cast<int>(SlotIds.size()) || SlotIds[index] != id ||
+        id == INVALID_MENU_OBJECT_ID) {
+        return nullptr;
+    }
+    ovrObjectChunk* chunk = ObjectChunks[index / OBJECTS_PER_CHUNK].get();
+    return reinterpret_cast<VRMenuObject*>(
+        chunk->Storage + (index % OBJECTS_PER_CHUNK) * sizeof(VRMenuObject));
+}
+
+//==================================
+// VRMenuMgrLocal::HitBoundsChanged
+void VRMenuMgrLocal::HitBoundsChanged(VRMenuObject& obj) {
+    if (obj.HitChangePending) {
+        return;
+    }
+    int index;
+    std::uint32_t id;
+    DecomposeHandle(obj.GetHandle(), index, id);
+    obj.HitChangePending = true;
+    HitChanges.emplace_back(index, id);
+}
+
+//==================================
+// VRMenuMgrLocal::TakeHitBoundsChanges
+void VRMenuMgrLocal::TakeHitBoundsChanges(std::vector<VRMenuObject*>& objects) {
+    objects.clear();
+    for (auto const& change : HitChanges) {
+        VRMenuObject* obj = SlotObject(change.first, change.second);
+        if (obj != nullptr) {
+            obj->HitChangePending = false;
+            objects.push_back(obj);
+        }
+    }
+    HitChanges.clear();
+}
+
+//==================================
+// VRMenuMgrLocal::ReleaseSlot
+void VRMenuMgrLocal::ReleaseSlot(int const index, std::uint32_t const id) {
+    VRMenuObject* obj = SlotObject(index, id);
+    if (obj == nullptr) {
+        // already released, possibly by a component destructor freeing part of the same subtree
+        return;
+    }
+    if (obj->GetId() != VRMenuId_t()) {
+        auto range = IdIndex.equal_range(obj->GetId().Get());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == index) {
+                IdIndex.erase(it);
+                break;
+            }
+        }
+    }
+    if (!obj->GetName().empty()) {
+        auto range = NameIndex.equal_range(obj->GetName());
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == index) {
+                NameIndex.erase(it);
+                break;
+            }
+        }
+    }
+    obj->~VRMenuObject();
+    SlotIds[index] = INVALID_MENU_OBJECT_ID;
+    HierarchyVersion++;
+    FreeList.push_back(index);
+}
 
 //==================================
 // VRMenuMgrLocal::Init
@@ -680,31 +909,31 @@ menuHandle_t VRMenuMgrLocal::CreateObject(VRMenuObjectParms const& parms) {
         index = FreeList.back();
         FreeList.pop_back();
     } else {
-        index = static_cast<int>(ObjectList.size());
+        index = static_cast<int>(SlotIds.size());
+        if (index % OBJECTS_PER_CHUNK == 0) {
+            // we have to grow the pool -- existing chunks never move
+            ObjectChunks.emplace_back(new ovrObjectChunk);
+        }
+        SlotIds.push_back(INVALID_MENU_OBJECT_ID);
     }
 
     std::uint32_t id = ++CurrentId;
     menuHandle_t handle = ComposeHandle(index, id);
     // ALOG( "VRMenuMgrLocal::CreateObject - handle is %llu", handle.Get() );
 
-    VRMenuObject* obj = new VRMenuObject(parms, handle);
-    if (obj == nullptr) {
-        ALOGW("VRMenuMgrLocal::CreateObject - failed to allocate menu object!");
-        assert(
-            obj !=
-            nullptr); // this would be bad -- but we're likely just going to explode elsewhere
-        return menuHandle_t();
-    }
+    assert(SlotIds[index] == INVALID_MENU_OBJECT_ID);
+    SlotIds[index] = id;
+    HierarchyVersion++;
+    VRMenuObject* obj = new (SlotObject(index, id)) VRMenuObject(parms, handle);
+    obj->MenuMgr = this;
 
     obj->Init(GuiSys, parms);
 
-    if (index == static_cast<int>(ObjectList.size())) {
-        // we have to grow the array
-        ObjectList.push_back(obj);
-    } else {
-        // insert in existing slot
-        assert(ObjectList[index] == nullptr);
-        ObjectList[index] = obj;
+    if (obj->GetId() != VRMenuId_t()) {
+        IdIndex.emplace(obj->GetId().Get(), index);
+    }
+    if (!obj->GetName().empty()) {
+        NameIndex.emplace(obj->GetName(), index);
     }
 
     return handle;
@@ -721,12 +950,12 @@ void VRMenuMgrLocal::FreeObject(menuHandle_t const handle) {
     if (!HandleComponentsAreValid(index, id)) {
         return;
     }
-    if (ObjectList[index] == nullptr) {
+    VRMenuObject* obj = SlotObject(index, id);
+    if (obj == nullptr) {
         // already freed
         return;
     }
 
-    VRMenuObject* obj = ObjectList[index];
     // remove this object from its parent's child list
     if (obj->GetParentHandle().IsValid()) {
         VRMenuObject* parentObj = ToObject(obj->GetParentHandle());
@@ -735,43 +964,99 @@ void VRMenuMgrLocal::FreeObject(menuHandle_t const handle) {
         }
     }
 
-    // free all of this object's children
-    obj->FreeChildren(*this);
-
-    delete obj;
-
-    // empty the slot
-    ObjectList[index] = nullptr;
-    // add the index to the free list
-    FreeList.push_back(index);
+    // Gather the whole subtree breadth-first and then destroy it in place. Every object in the
+    // subtree goes away together, so there is no need to unlink each child from its parent first.
+    // The work list is swapped out while in use in case a component destructor frees an object.
+    // Slots are kept together with the id they held when gathered, so a slot that a destructor
+    // already released, and maybe reused for a new object, is skipped.
+    std::vector<std::pair<int, std::uint32_t>> subtree;
+    subtree.swap(FreeScratch);
+    subtree.clear();
+    subtree.emplace_back(index, id);
+    for (int i = 0; i < static_cast<int>(subtree.size()); ++i) {
+        VRMenuObject const* cur = SlotObject(subtree[i].first, subtree[i].second);
+        for (int c = 0; c < static_cast<int>(cur->Children.size()); ++c) {
+            int childIndex;
+            std::uint32_t childId;
+            DecomposeHandle(cur->Children[c], childIndex, childId);
+            if (SlotObject(childIndex, childId) != nullptr) {
+                subtree.emplace_back(childIndex, childId);
+            }
+        }
+    }
 
-    CondenseList();
+    for (int i = 0; i < static_cast<int>(subtree.size()); ++i) {
+        ReleaseSlot(subtree[i].first, subtree[i].second);
+    }
+    subtree.clear();
+    FreeScratch.swap(subtree);
 }
 
 //==================================
-// VRMenuMgrLocal::CondenseList
-// keeps the free list from growing too large when items are removed
-void VRMenuMgrLocal::CondenseList() {
-    // we can only condense the array if we have a significant number of items at the end of the
-    // array buffer that are empty (because we cannot move an existing object around without
-    // changing its handle, too, which would invalidate any existing references to it). This is the
-    // difference between the current size and the array capacity.
-    int const MIN_FREE = 64; // very arbitray number
-    if (ObjectList.capacity() - ObjectList.size() < MIN_FREE) {
-        return;
+// VRMenuMgrLocal::SingleDescendant
+template <typename Iterator>
+menuHandle_t VRMenuMgrLocal::SingleDescendant(
+    menuHandle_t const rootHandle,
+    Iterator const begin,
+    Iterator const end,
+    bool& needsWalk) const {
+    needsWalk = false;
+    menuHandle_t found;
+    for (Iterator it = begin; it != end; ++it) {
+        int const index = it->second;
+        menuHandle_t const handle = ComposeHandle(index, SlotIds[index]);
+        // walk up to see if the candidate is below the root
+        for (VRMenuObject const* cur = SlotObject(index, SlotIds[index]); cur != nullptr;) {
+            menuHandle_t const parentHandle = cur->GetParentHandle();
+            if (parentHandle == rootHandle) {
+                if (found.IsValid()) {
+                    needsWalk = true;
+                    return menuHandle_t();
+                }
+                found = handle;
+                break;
+            }
+            int parentIndex;
+            std::uint32_t parentId;
+            DecomposeHandle(parentHandle, parentIndex, parentId);
+            cur = SlotObject(parentIndex, parentId);
+        }
     }
+    return found;
+}
 
-    // shrink to current size
-    ObjectList.resize(ObjectList.size());
+//==================================
+// VRMenuMgrLocal::FindDescendantById
+menuHandle_t VRMenuMgrLocal::FindDescendantById(
+    menuHandle_t const rootHandle,
+    VRMenuId_t const id) const {
+    VRMenuObject const* root = ToObject(rootHandle);
+    if (root == nullptr) {
+        return menuHandle_t();
+    }
+    if (id == VRMenuId_t()) {
+        // objects without an id are not indexed
+        return root->ChildHandleForId(*this, id);
+    }
+    auto range = IdIndex.equal_range(id.Get());
+    bool needsWalk;
+    menuHandle_t const handle = SingleDescendant(rootHandle, range.first, range.second, needsWalk);
+    return needsWalk ? root->ChildHandleForId(*this, id) : handle;
+}
 
-    // create a new free list of just indices < the new size
-    std::vector<int> newFreeList;
-    for (int i = 0; i < static_cast<int>(FreeList.size()); ++i) {
-        if (FreeList[i] <= static_cast<int>(ObjectList.size())) {
-            newFreeList.push_back(FreeList[i]);
-        }
+//==================================
+// VRMenuMgrLocal::FindDescendantByName
+menuHandle_t VRMenuMgrLocal::FindDescendantByName(
+    menuHandle_t const rootHandle,
+    char const* name) const {
+    VRMenuObject const* root = ToObject(rootHandle);
+    if (root == nullptr || name == nullptr || name[0] == '\0') {
+        return menuHandle_t();
     }
-    FreeList = newFreeList;
+    auto range = NameIndex.equal_range(std::string_view(name));
+    bool needsWalk;
+    menuHandle_t const handle = SingleDescendant(rootHandle, range.first, range.second, needsWalk);
+    return needsWalk ? root->ChildHandleForName(*this, name) : handle;
 }
 
 //==================================
@@ -797,23 +1082,22 @@ VRMenuObject* VRMenuMgrLocal::ToObject(menuHandle_t const handle) const {
         ALOGW("VRMenuMgrLocal::ToObject - invalid handle.");
         return nullptr;
     }
-    if (index >= static_cast<int>(ObjectList.size())) {
+    if (index >= static_cast<int>(SlotIds.size())) {
         ALOGW("VRMenuMgrLocal::ToObject - index out of range.");
         return nullptr;
     }
-    VRMenuObject* object = ObjectList[index];
-    if (object == nullptr) {
+    if (SlotIds[index] == INVALID_MENU_OBJECT_ID) {
         ALOGW("VRMenuMgrLocal::ToObject - slot empty.");
         return nullptr; // this can happen if someone is holding onto the handle of an object that's
                         // been freed
     }
-    if (object->GetHandle() != handle) {
-        // if the handle of the object in the slot does not match, then the object the handle refers
+    if (SlotIds[index] != id) {
+        // if the id of the object in the slot does not match, then the object the handle refers
         // to was deleted and a new object is in the slot
         ALOGW("VRMenuMgrLocal::ToObject - slot mismatch.");
         return nullptr;
     }
-    return object;
+    return SlotObject(index, id);
 }
 
 /*
@@ -829,13 +1113,75 @@ static void LogBounds( const char * name, char const * prefix, Bounds3f const &
 /// OVR_PERF_ACCUMULATOR( SubmitForRenderingRecursive_DrawText3D );
 /// OVR_PERF_ACCUMULATOR( SubmitForRenderingRecursive_submit );
 
+//==============================
+// VRMenuMgrLocal::CanReuseSubmitted
+bool VRMenuMgrLocal::CanReuseSubmitted(
+    VRMenuObject const* obj,
+    VRMenuRenderFlags_t const& flags,
+    Posef const& parentModelPose,
+    Vector4f const& parentColor,
+    Vector3f const& parentScale,
+    int const distanceIndex) const {
+    VRMenuObject::ovrSubmitCache const& cache = obj->SubmitCache;
+    return cache.Reusable && obj->DirtyFlags == 0 &&
+        cache.RenderFlags.GetValue() == flags.GetValue() &&
+        cache.InheritedDistance == (distanceIndex >= 0) &&
+        cache.ParentPose.Translation == parentModelPose.Translation &&
+        cache.ParentPose.Rotation == parentModelPose.Rotation &&
+        cache.ParentScale == parentScale && cache.ParentColor == parentColor;
+}
+
+//==============================
+// VRMenuMgrLocal::ReuseSubmitted
+void VRMenuMgrLocal::ReuseSubmitted(
+    OvrGuiSys& guiSys,
+    VRMenuObject const* obj,
+    SubmittedMenuObject* submitted,
+    int& curIndex,
+    int const distanceIndex,
+    int const prevIndex,
+    int const prevTextDraw) {
+    VRMenuObject::ovrSubmitCache const& cache = obj->SubmitCache;
+    SubmittedMenuObject const* prevSubmitted = Submitted[CurBuffer ^ 1];
+    // Either every entry in the subtree sorts by the same inherited distance, or every
+    // DistanceIndex points inside the subtree and only needs to move with it.
+    int const shift = curIndex - prevIndex;
+    for (int i = 0; i < cache.NumSubmitted; ++i) {
+        SubmittedMenuObject& sub = submitted[curIndex + i];
+        sub = prevSubmitted[prevIndex + i];
+        sub.DistanceIndex = cache.InheritedDistance ? distanceIndex : sub.DistanceIndex + shift;
+    }
+    curIndex += cache.NumSubmitted;
+
+    std::vector<ovrMenuTextDraw> const& prevTextDraws = TextDraws[CurBuffer ^ 1];
+    std::vector<ovrMenuTextDraw>& textDraws = TextDraws[CurBuffer];
+    for (int i = 0; i < cache.NumTextDraws; ++i) {
+        ovrMenuTextDraw const& td = prevTextDraws[prevTextDraw + i];
+        textDraws.push_back(td);
+        // the object is clean, so its text is the text that was drawn last frame
+        VRMenuObject const* textObj = ToObject(td.Handle);
+        if (textObj != nullptr) {
+            guiSys.GetDefaultFontSurface().DrawText3D(
+                guiSys.GetDefaultFont(),
+                td.FontParms,
+                td.Position,
+                td.Normal,
+                td.Up,
+                td.Scale,
+                td.Color,
+                textObj->GetText().c_str());
+        }
+    }
+    NumReused += cache.NumObjects;
+}
+
 //==============================
 // VRMenuMgrLocal::SubmitForRenderingRecursive
-void VRMenuMgrLocal::SubmitForRenderingRecursive(
+bool VRMenuMgrLocal::SubmitForRenderingRecursive(
     OvrGuiSys& guiSys,
     Matrix4f const& centerViewMatrix,
     VRMenuRenderFlags_t const& flags,
-    VRMenuObject const* obj,
+    VRMenuObject* obj,
     Posef const& parentModelPose,
     Vector4f const& parentColor,
     Vector3f const& parentScale,
@@ -843,19 +1189,55 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
     SubmittedMenuObject* submitted,
     int const maxIndices,
     int& curIndex,
-    int const distanceIndex) const {
+    int const distanceIndex,
+    int const prevIndex,
+    int const prevTextDraw) {
+    VRMenuObject::ovrSubmitCache& cache = obj->SubmitCache;
     if (curIndex >= maxIndices) {
         // If this happens we're probably not correctly clearing the submitted surfaces each frame
         // OR we've got a LOT of surfaces.
         ALOG("maxIndices = %i, curIndex = %i", maxIndices, curIndex);
         /// assert_WITH_TAG( curIndex < maxIndices, "VrMenu" );
-        return;
+        cache.Reusable = false;
+        cache.NumSubmitted = 0;
+        cache.NumTextDraws = 0;
+        cache.NumObjects = 1;
+        return false;
+    }
+
+    // if nothing in this subtree changed, copy what it submitted last frame
+    if (prevIndex >= 0 &&
+        CanReuseSubmitted(obj, flags, parentModelPose, parentColor, parentScale, distanceIndex) &&
+        curIndex + cache.NumSubmitted <= maxIndices) {
+        ReuseSubmitted(guiSys, obj, submitted, curIndex, distanceIndex, prevIndex, prevTextDraw);
+        if (cache.Rendered) {
+            cullBounds = obj->GetCullBounds();
+        }
+        return cache.Rendered;
     }
 
+    NumEvaluated++;
+    std::uint32_t const prevLayoutId = cache.LayoutId;
+    cache.LayoutId = ++LayoutCounter;
+    cache.ParentPose = parentModelPose;
+    cache.ParentScale = parentScale;
+    cache.ParentColor = parentColor;
+    cache.RenderFlags = flags;
+    cache.InheritedDistance = distanceIndex >= 0;
+    cache.Reusable = CanRetainSubmissions();
+    cache.Rendered = false;
+    cache.NumSubmitted = 0;
+    cache.NumTextDraws = 0;
+    cache.NumObjects = 1;
+    obj->DirtyFlags = 0;
+
+    int const firstIndex = curIndex;
+    int const firstTextDraw = static_cast<int>(TextDraws[CurBuffer].size());
+
     // check if this object is hidden
     VRMenuObjectFlags_t const oFlags = obj->GetFlags();
     if (oFlags & VRMENUOBJECT_DONT_RENDER) {
-        return;
+        return false;
     }
 
     Posef const& localPose = obj->GetLocalPose();
@@ -909,6 +1291,8 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
         if (oFlags & VRMENUOBJECT_FLAG_BILLBOARD) {
             Matrix4f invViewMatrix = centerViewMatrix.Transposed();
             itemPose.Rotation = Quatf(invViewMatrix);
+            // depends on the view, so it has to be evaluated every frame
+            cache.Reusable = false;
         }
 
         if (ShowPoses) {
@@ -1011,9 +1395,10 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
                 // if we didn't submit anything but we have an instanced text surface, submit an
                 // invalid surface so that the text surface will be added to the surface list in
                 // BuildDrawSurface
-                if (curIndex - submissionIndex == 0) {
+                if (curIndex - submissionIndex == 0 && curIndex < maxIndices) {
                     SubmittedMenuObject& sub = submitted[curIndex];
                     sub.SurfaceIndex = -1;
+                    sub.DistanceIndex = distanceIndex >= 0 ? distanceIndex : curIndex;
                     sub.Pose = itemPose;
                     sub.Scale = scale;
                     sub.Flags = rFlags;
@@ -1024,6 +1409,15 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
                 }
             } else {
                 /// OVR_PERF_ACCUMULATE( SubmitForRenderingRecursive_DrawText3D );
+                ovrMenuTextDraw td;
+                td.Handle = obj->GetHandle();
+                td.FontParms = fontParms;
+                td.Position = position;
+                td.Normal = textNormal;
+                td.Up = textUp;
+                td.Scale = textScale.x * fp.Scale;
+                td.Color = textColor;
+                TextDraws[CurBuffer].push_back(td);
                 guiSys.GetDefaultFontSurface().DrawText3D(
                     guiSys.GetDefaultFont(),
                     fontParms,
@@ -1082,13 +1476,25 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
 
         for (int i = 0; i < static_cast<int>(obj->Children.size()); ++i) {
             menuHandle_t childHandle = obj->Children[i];
-            VRMenuObject const* child = static_cast<VRMenuObject const*>(ToObject(childHandle));
+            VRMenuObject* child = ToObject(childHandle);
             if (child == nullptr) {
                 continue;
             }
 
+            // the child's entries from last frame can only be located if it was placed in the
+            // layout this object produced last frame
+            VRMenuObject::ovrSubmitCache& childCache = child->SubmitCache;
+            int childPrevIndex = -1;
+            int childPrevTextDraw = -1;
+            if (prevIndex >= 0 && childCache.ParentLayoutId == prevLayoutId) {
+                childPrevIndex = prevIndex + childCache.SubmittedOffset;
+                childPrevTextDraw = prevTextDraw + childCache.TextDrawOffset;
+            }
+            int const childFirstIndex = curIndex;
+            int const childFirstTextDraw = static_cast<int>(TextDraws[CurBuffer].size());
+
             Bounds3f childCullBounds;
-            SubmitForRenderingRecursive(
+            bool const childRendered = SubmitForRenderingRecursive(
                 guiSys,
                 centerViewMatrix,
                 flags,
@@ -1100,7 +1506,18 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
                 submitted,
                 maxIndices,
                 curIndex,
-                di);
+                di,
+                childPrevIndex,
+                childPrevTextDraw);
+
+            childCache.ParentLayoutId = cache.LayoutId;
+            childCache.SubmittedOffset = childFirstIndex - firstIndex;
+            childCache.TextDrawOffset = childFirstTextDraw - firstTextDraw;
+            cache.Reusable = cache.Reusable && childCache.Reusable;
+            cache.NumObjects += childCache.NumObjects;
+            if (!childRendered) {
+                continue;
+            }
 
             Posef pose = child->GetLocalPose();
             pose.Translation = pose.Translation * scale;
@@ -1111,6 +1528,14 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
 
     obj->SetCullBounds(cullBounds);
 
+    cache.Rendered = true;
+    cache.NumSubmitted = curIndex - firstIndex;
+    cache.NumTextDraws = static_cast<int>(TextDraws[CurBuffer].size()) - firstTextDraw;
+    if (curIndex >= maxIndices) {
+        // some of the subtree may have been dropped
+        cache.Reusable = false;
+    }
+
     // VRMenuId_t debugId( 297 );
     if (ShowCollision) {
         OvrCollisionPrimitive const* cp = obj->GetCollisionPrimitive();
@@ -1182,6 +1607,7 @@ void VRMenuMgrLocal::SubmitForRenderingRecursive(
                 obj->GetSurfaces()[0].GetName().c_str());
         }
     }
+    return true;
 }
 
 //==============================
@@ -1203,6 +1629,19 @@ void VRMenuMgrLocal::SubmitForRendering(
         return;
     }
 
+    // a root's entries from last frame are only known if it was also submitted as a root then
+    VRMenuObject::ovrSubmitCache& cache = obj->SubmitCache;
+    int prevIndex = -1;
+    int prevTextDraw = -1;
+    if (cache.RootFrame != 0 && cache.RootFrame + 1 == FrameCount) {
+        prevIndex = cache.RootSubmitted;
+        prevTextDraw = cache.RootTextDraw;
+    }
+    cache.RootFrame = FrameCount;
+    cache.RootSubmitted = NumSubmitted;
+    cache.RootTextDraw = static_cast<int>(TextDraws[CurBuffer].size());
+    SubmittedRoots[CurBuffer].push_back(handle);
+
     Bounds3f cullBounds;
     SubmitForRenderingRecursive(
         guiSys,
@@ -1213,10 +1652,12 @@ void VRMenuMgrLocal::SubmitForRendering(
         Vector4f(1.0f),
         Vector3f(1.0f),
         cullBounds,
-        Submitted,
+        Submitted[CurBuffer],
         MAX_SUBMITTED,
         NumSubmitted,
-        -1);
+        -1,
+        prevIndex,
+        prevTextDraw);
 
     /// OVR_PERF_REPORT( SubmitForRenderingRecursive_submit );
     /// OVR_PERF_REPORT( SubmitForRenderingRecursive_DrawText3D );
@@ -1228,8 +1669,22 @@ void VRMenuMgrLocal::Finish(Matrix4f const& viewMatrix) {
     // free any deleted component objects
     ExecutePendingComponentDeletions();
 
+    // this frame's buffer becomes the one to render and the previous frame's is rebuilt next
+    int const prevBuffer = CurBuffer ^ 1;
+    RenderBuffer = CurBuffer;
+    CurBuffer = prevBuffer;
+    FrameCount++;
+    StatsEvaluated = NumEvaluated;
+    StatsReused = NumReused;
+    StatsSortSkipped = false;
+    NumEvaluated = 0;
+    NumReused = 0;
+
     if (NumSubmitted == 0) {
         NumToRender = 0;
+        SortKeys.clear();
+        TextDraws[CurBuffer].clear();
+        SubmittedRoots[CurBuffer].clear();
         return;
     }
 
@@ -1237,7 +1692,24 @@ void VRMenuMgrLocal::Finish(Matrix4f const& viewMatrix) {
                                                     // could use Transposed() here instead
     Vector3f viewPos = invViewMatrix.GetTranslation();
 
+    // If every object was copied from the previous frame, the same roots were submitted in the
+    // same order and the view did not move, then every entry is where it was last frame and the
+    // previous sort order still holds.
+    if (StatsEvaluated == 0 && NumSubmitted == NumToRender &&
+        static_cast<int>(SortKeys.size()) == NumSubmitted && viewPos == SortViewPos &&
+        SubmittedRoots[RenderBuffer] == SubmittedRoots[prevBuffer]) {
+        StatsSortSkipped = true;
+        TextDraws[CurBuffer].clear();
+        SubmittedRoots[CurBuffer].clear();
+        NumSubmitted = 0;
+        return;
+    }
+    TextDraws[CurBuffer].clear();
+    SubmittedRoots[CurBuffer].clear();
+    SortViewPos = viewPos;
+
     // sort surfaces
+    SubmittedMenuObject const* submitted = Submitted[RenderBuffer];
     SortKeys.resize(NumSubmitted);
     for (int i = 0; i < NumSubmitted; ++i) {
         // The sort key is a combination of the distance squared, reinterpreted as an integer, and
@@ -1248,7 +1720,7 @@ void VRMenuMgrLocal::Finish(Matrix4f const& viewMatrix) {
         // DistanceIndex will then be sorted against each other based only on their submission
         // index.
         float const distSq =
-            (Submitted[Submitted[i].DistanceIndex].Pose.Translation - viewPos).LengthSq();
+            (submitted[submitted[i].DistanceIndex].Pose.Translation - viewPos).LengthSq();
         int64_t sortKey = *reinterpret_cast<unsigned const*>(&distSq);
         SortKeys[i].Key = (sortKey << 32ULL) |
             (NumSubmitted -
@@ -1272,7 +1744,7 @@ void VRMenuMgrLocal::AppendSurfaceList(
 
     for (int i = 0; i < NumToRender; ++i) {
         int idx = abs(static_cast<int>(SortKeys[i].Key & 0xFFFFFFFF) - NumToRender);
-        SubmittedMenuObject const& cur = Submitted[idx];
+        SubmittedMenuObject const& cur = Submitted[RenderBuffer][idx];
 
         VRMenuObject* obj = static_cast<VRMenuObject*>(ToObject(cur.Handle));
         if (obj != nullptr) {
@@ -1330,7 +1802,12 @@ void VRMenuMgrLocal::AppendSurfaceList(
     // glDisable(GL_POLYGON_OFFSET_FILL);
 
     if (ShowStats) {
-        ALOG("VRMenuMgr: submitted %i surfaces", NumToRender);
+        ALOG(
+            "VRMenuMgr: submitted %i surfaces, %i objects re-evaluated, %i reused%s",
+            NumToRender,
+            StatsEvaluated,
+            StatsReused,
+            StatsSortSkipped ? ", sort skipped" : "");
     }
 }
 
@@ -1392,6 +1869,9 @@ void VRMenuMgrLocal::ExecutePendingComponentDeletions() {
             object->FreeComponents(list);
         }
     }
+    if (!PendingDeletions.empty()) {
+        HierarchyVersion++;
+    }
     PendingDeletions.clear();
 }
 
@@ -62,6 +62,23 @@ class OvrVRMenuMgr {
     // Return the object for a menu handle or NULL if the object does not exist or the
     // handle is invalid;
     virtual VRMenuObject* ToObject(menuHandle_t const handle) const = 0;
+    // Returns a counter that changes whenever objects are created or freed, children are added or
+    // removed, or components are added or freed, so that flattened views of a menu can tell when
+    // they must be rebuilt.
+    virtual std::uint32_t GetHierarchyVersion() const = 0;
+    // Replaces the contents of objects with every object whose pose, flags, text or surfaces
+    // changed since the last call, so that spatial indices of the objects can be updated
+    // incrementally. Objects freed in the meantime are left out.
+    virtual void TakeHitBoundsChanges(std::vector<VRMenuObject*>& objects) = 0;
+    // Return the first descendant of rootHandle, in depth-first order, with the specified id or
+    // (case-insensitive) name, or an invalid handle if there is none. These use an index of all
+    // objects. Ids and names need not be unique, so if several descendants match they fall back
+    // to walking the tree like VRMenuObject::ChildHandleForId and ChildHandleForName, and cost
+    // as much. Objects without an id are not indexed, so looking up the invalid id walks too.
+    virtual menuHandle_t FindDescendantById(menuHandle_t const rootHandle, VRMenuId_t const id)
+        const = 0;
+    virtual menuHandle_t FindDescendantByName(menuHandle_t const rootHandle, char const* name)
+        const = 0;
 
     // Submits the specified menu object and its children
     virtual void SubmitForRendering(
@@ -74,6 +91,10 @@ class OvrVRMenuMgr {
     // Call once per frame before rendering to sort surfaces.
     virtual void Finish(OVR::Matrix4f const& viewMatrix) = 0;
 
+    // Number of objects the last finished frame re-evaluated, and the number whose submissions
+    // were copied from the frame before because nothing in their subtree changed.
+    virtual void GetSubmitStats(int& outEvaluated, int& outReused) const = 0;
+
     virtual void AppendSurfaceList(
         OVR::Matrix4f const& centerViewMatrix,
         std::vector<ovrDrawSurface>& surfaceList) = 0;
@@ -85,6 +106,8 @@ class OvrVRMenuMgr {
     virtual void AddComponentToDeletionList(
         menuHandle_t const ownerHandle,
         VRMenuComponent* component) = 0;
+    virtual void HierarchyChanged() = 0;
+    virtual void HitBoundsChanged(VRMenuObject& obj) = 0;
 };
 
 } // namespace OVRFW
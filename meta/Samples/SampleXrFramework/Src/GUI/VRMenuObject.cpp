@@ -45,6 +45,7 @@ Authors     :   Jonathan E. Wright
 #include "VRMenuComponent.h"
 #include "ui_default.h" // embedded default UI texture (loaded as a placeholder when something doesn't load)
 #include "Reflection.h"
+#include "ReflectionBinary.h"
 
 using OVR::Bounds3f;
 using OVR::Matrix4f;
@@ -210,7 +211,8 @@ static void PrintBounds( const char * name, char const * prefix, Bounds3f const
 //==============================
 // VRMenuSurface::VRMenuSurface
 VRMenuSurface::VRMenuSurface()
-    : Color(1.0f)
+    : Color(1.0f),
+      DrawColor(1.0f)
       //, TextureDims( 0, 0 )
       //, Dims( 0.0f, 0.0f )
       //, Anchors( 0.0f, 0.0f, 1.0f
@@ -449,7 +451,9 @@ void VRMenuSurface::BuildDrawSurface(
     gc.Program = *program;
 
     /// Update local parameters
-    Color = color;
+    // Color stays the surface's own color; writing the modulated color back into it would
+    // modulate it again on every frame the surface is re-evaluated.
+    DrawColor = color;
     FadeDirection = fadeDirection;
     ClipUVs = clipUVs;
     OffsetUVs = offsetUVs;
@@ -466,7 +470,7 @@ void VRMenuSurface::BuildDrawSurface(
     switch (pt) {
         case PROGRAM_DIFFUSE_ONLY:
             gc.Textures[0] = Textures[diffuseIndex].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &OffsetUVs;
             gc.UniformData[3].Data = &gc.Textures[0];
@@ -475,7 +479,7 @@ void VRMenuSurface::BuildDrawSurface(
 
         case PROGRAM_ADDITIVE_ONLY:
             gc.Textures[0] = Textures[additiveIndex].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &OffsetUVs;
             gc.UniformData[3].Data = &gc.Textures[0];
@@ -483,7 +487,7 @@ void VRMenuSurface::BuildDrawSurface(
 
         case PROGRAM_DIFFUSE_ALPHA_DISCARD:
             gc.Textures[0] = Textures[diffuseADIndex].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &OffsetUVs;
             gc.UniformData[3].Data = &gc.Textures[0];
@@ -493,7 +497,7 @@ void VRMenuSurface::BuildDrawSurface(
         case PROGRAM_DIFFUSE_PLUS_ADDITIVE:
             gc.Textures[0] = Textures[diffuseIndex].GetTexture();
             gc.Textures[1] = Textures[additiveIndex].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &gc.Textures[0];
             gc.UniformData[3].Data = &gc.Textures[1];
@@ -502,7 +506,7 @@ void VRMenuSurface::BuildDrawSurface(
         case PROGRAM_DIFFUSE_COMPOSITE:
             gc.Textures[0] = Textures[diffuseIndex].GetTexture();
             gc.Textures[1] = Textures[diffuse2Index].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &gc.Textures[0];
             gc.UniformData[3].Data = &gc.Textures[1];
@@ -512,7 +516,7 @@ void VRMenuSurface::BuildDrawSurface(
             gc.Textures[0] = Textures[diffuseIndex].GetTexture();
             gc.Textures[1] = Textures[targetIndex].GetTexture();
             gc.Textures[2] = Textures[rampIndex].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &OffsetUVs;
             gc.UniformData[3].Data = &gc.Textures[0];
@@ -525,7 +529,7 @@ void VRMenuSurface::BuildDrawSurface(
             gc.Textures[0] = Textures[diffuseIndex].GetTexture();
             gc.Textures[1] = Textures[targetIndex].GetTexture();
             gc.Textures[2] = Textures[rampIndex].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &gc.Textures[0];
             gc.UniformData[3].Data = &gc.Textures[1];
@@ -536,7 +540,7 @@ void VRMenuSurface::BuildDrawSurface(
         case PROGRAM_ALPHA_DIFFUSE:
             gc.Textures[0] = Textures[alphaIndex].GetTexture();
             gc.Textures[1] = Textures[diffuseIndex].GetTexture();
-            gc.UniformData[0].Data = &Color;
+            gc.UniformData[0].Data = &DrawColor;
             gc.UniformData[1].Data = &FadeDirection;
             gc.UniformData[2].Data = &gc.Textures[0];
             gc.UniformData[3].Data = &gc.Textures[1];
@@ -942,7 +946,10 @@ VRMenuObject::VRMenuObject(VRMenuObjectParms const& parms, menuHandle_t const ha
       MinsBoundsExpand(0.0f),
       MaxsBoundsExpand(0.0f),
       TextMetrics(),
-      TextSurface(nullptr) {
+      TextSurface(nullptr),
+      MenuMgr(nullptr),
+      DirtyFlags(DIRTY_ALL),
+      HitChangePending(false) {
     CullBounds.Clear();
 }
 
@@ -969,6 +976,25 @@ VRMenuObject::~VRMenuObject() {
     Type = VRMENU_MAX;
 }
 
+//==================================
+// VRMenuObject::MarkDirty
+void VRMenuObject::MarkDirty(std::uint32_t const flags) {
+    DirtyFlags |= flags;
+    if (MenuMgr == nullptr) {
+        return;
+    }
+    // everything but color can move what a ray hits
+    if (flags & ~DIRTY_COLOR) {
+        MenuMgr->HitBoundsChanged(*this);
+    }
+    // Walk all the way up rather than stopping at an ancestor that is already flagged, because
+    // the manager only clears the flags of the objects it actually visits.
+    for (VRMenuObject* parent = MenuMgr->ToObject(ParentHandle); parent != nullptr;
+         parent = MenuMgr->ToObject(parent->ParentHandle)) {
+        parent->DirtyFlags |= DIRTY_SUBTREE;
+    }
+}
+
 /// OVR_PERF_ACCUMULATOR( VRMenuObjectInit );
 
 //==================================
@@ -977,7 +1003,7 @@ void VRMenuObject::Init(OvrGuiSys& guiSys, VRMenuObjectParms const& parms) {
     /// OVR_PERF_TIMER( VRMenuObjectInit );
     for (int i = 0; i < static_cast<int>(parms.SurfaceParms.size()); ++i) {
         int idx = AllocSurface();
-        Surfaces[idx].CreateFromSurfaceParms(guiSys, parms.SurfaceParms[i]);
+        CreateFromSurfaceParms(guiSys, idx, parms.SurfaceParms[i]);
     }
 
     // bounds are nothing submitted for rendering
@@ -1010,10 +1036,14 @@ void VRMenuObject::Init(OvrGuiSys& guiSys, VRMenuObjectParms const& parms) {
 //==================================
 // VRMenuObject::FreeChildren
 void VRMenuObject::FreeChildren(OvrVRMenuMgr& menuMgr) {
-    for (int i = 0; i < static_cast<int>(Children.size()); ++i) {
-        menuMgr.FreeObject(Children[i]);
+    // detach the list first so that FreeObject() does not erase from it while we iterate
+    std::vector<menuHandle_t> children;
+    children.swap(Children);
+    menuMgr.HierarchyChanged();
+    MarkDirty(DIRTY_VISIBILITY);
+    for (int i = 0; i < static_cast<int>(children.size()); ++i) {
+        menuMgr.FreeObject(children[i]);
     }
-    Children.resize(0);
     // NOTE! bounds will be incorrect now until submitted for rendering
 }
 
@@ -1043,18 +1073,24 @@ bool VRMenuObject::IsDescendant(OvrVRMenuMgr& menuMgr, menuHandle_t const handle
 // VRMenuObject::AddChild
 void VRMenuObject::AddChild(OvrVRMenuMgr& menuMgr, menuHandle_t const handle) {
     Children.push_back(handle);
+    menuMgr.HierarchyChanged();
 
     VRMenuObject* child = menuMgr.ToObject(handle);
     if (child != nullptr) {
         child->SetParentHandle(this->Handle);
     }
+    MarkDirty(DIRTY_VISIBILITY);
     // NOTE: bounds will be incorrect until submitted for rendering
 }
 void VRMenuObject::AddChild(VRMenuObject* child) {
     Children.push_back(child->GetHandle());
+    if (MenuMgr != nullptr) {
+        MenuMgr->HierarchyChanged();
+    }
     if (child != nullptr) {
         child->SetParentHandle(this->Handle);
     }
+    MarkDirty(DIRTY_VISIBILITY);
 }
 
 //==============================
@@ -1063,6 +1099,13 @@ void VRMenuObject::RemoveChild(OvrVRMenuMgr& menuMgr, menuHandle_t const handle)
     for (int i = 0; i < static_cast<int>(Children.size()); ++i) {
         if (Children[i] == handle) {
             Children.erase(Children.cbegin() + i);
+            menuMgr.HierarchyChanged();
+            // a detached child must not keep propagating dirty flags to its old parent
+            VRMenuObject* child = menuMgr.ToObject(handle);
+            if (child != nullptr && child->ParentHandle == Handle) {
+                child->ParentHandle.Release();
+            }
+            MarkDirty(DIRTY_VISIBILITY);
             return;
         }
     }
@@ -1075,6 +1118,8 @@ void VRMenuObject::FreeChild(OvrVRMenuMgr& menuMgr, menuHandle_t const handle) {
         menuHandle_t childHandle = Children[i];
         if (childHandle == handle) {
             Children.erase(Children.cbegin() + i);
+            menuMgr.HierarchyChanged();
+            MarkDirty(DIRTY_VISIBILITY);
             menuMgr.FreeObject(childHandle);
             return;
         }
@@ -1187,37 +1232,8 @@ static void TransformByParentPose(
 }
 
 //==============================
-// VRMenuObject::HitTest_r
-bool VRMenuObject::HitTest_r(
-    OvrGuiSys const& guiSys,
-    Posef const& parentPose,
-    Vector3f const& parentScale,
-    Vector3f const& rayStart,
-    Vector3f const& rayDir,
-    ContentFlags_t const testContents,
-    HitTestResult& result) const {
-    if (Flags & VRMENUOBJECT_DONT_RENDER) {
-        return false;
-    }
-
-    if (Flags & VRMENUOBJECT_DONT_HIT_ALL) {
-        return false;
-    }
-
-    // transform ray into local space
-    Vector3f scale;
-    Posef modelPose;
-    TransformByParentPose(parentPose, parentScale, LocalPose, GetLocalScale(), modelPose, scale);
-
-    Vector3f localStart = modelPose.Rotation.Inverted().Rotate(rayStart - modelPose.Translation);
-    Vector3f localDir = modelPose.Rotation.Inverted().Rotate(rayDir).Normalized();
-    /*
-        LOG_WITH_TAG( "Spam", "Hit test vs '%s', start: (%.2f, %.2f, %.2f ) cull bounds( %.2f, %.2f,
-       %.2f ) -> ( %.2f, %.2f, %.2f )", GetText().c_str(), localStart.x, localStart.y, localStart.z,
-                CullBounds.b[0].x, CullBounds.b[0].y, CullBounds.b[0].z,
-                CullBounds.b[1].x, CullBounds.b[1].y, CullBounds.b[1].z );
-    */
-    // test against cull bounds if we have children  ... otherwise cullBounds == localBounds
+// VRMenuObject::HitTestCullBounds
+bool VRMenuObject::HitTestCullBounds(Vector3f const& localStart, Vector3f const& localDir) const {
     if (!Children.empty()) {
         if (CullBounds.IsInverted()) {
             ALOG("CullBounds are inverted!!");
@@ -1243,8 +1259,18 @@ bool VRMenuObject::HitTest_r(
             return false;
         }
     }
+    return true;
+}
 
-    // test against self first, if not a container
+//==============================
+// VRMenuObject::HitTestSelf
+void VRMenuObject::HitTestSelf(
+    OvrGuiSys const& guiSys,
+    Vector3f const& parentScale,
+    Vector3f const& localStart,
+    Vector3f const& localDir,
+    ContentFlags_t const testContents,
+    HitTestResult& result) const {
     if (GetContents() & testContents) {
         if (Flags & VRMENUOBJECT_BOUND_ALL) {
             // local bounds are the union of surface bounds and text bounds
@@ -1308,6 +1334,46 @@ bool VRMenuObject::HitTest_r(
             }
         }
     }
+}
+
+//==============================
+// VRMenuObject::HitTest_r
+bool VRMenuObject::HitTest_r(
+    OvrGuiSys const& guiSys,
+    Posef const& parentPose,
+    Vector3f const& parentScale,
+    Vector3f const& rayStart,
+    Vector3f const& rayDir,
+    ContentFlags_t const testContents,
+    HitTestResult& result) const {
+    if (Flags & VRMENUOBJECT_DONT_RENDER) {
+        return false;
+    }
+
+    if (Flags & VRMENUOBJECT_DONT_HIT_ALL) {
+        return false;
+    }
+
+    // transform ray into local space
+    Vector3f scale;
+    Posef modelPose;
+    TransformByParentPose(parentPose, parentScale, LocalPose, GetLocalScale(), modelPose, scale);
+
+    Vector3f localStart = modelPose.Rotation.Inverted().Rotate(rayStart - modelPose.Translation);
+    Vector3f localDir = modelPose.Rotation.Inverted().Rotate(rayDir).Normalized();
+    /*
+        LOG_WITH_TAG( "Spam", "Hit test vs '%s', start: (%.2f, %.2f, %.2f ) cull bounds( %.2f, %.2f,
+       %.2f ) -> ( %.2f, %.2f, %.2f )", GetText().c_str(), localStart.x, localStart.y, localStart.z,
+                CullBounds.b[0].x, CullBounds.b[0].y, CullBounds.b[0].z,
+                CullBounds.b[1].x, CullBounds.b[1].y, CullBounds.b[1].z );
+    */
+    // test against cull bounds if we have children  ... otherwise cullBounds == localBounds
+    if (!HitTestCullBounds(localStart, localDir)) {
+        return false;
+    }
+
+    // test against self first, if not a container
+    HitTestSelf(guiSys, parentScale, localStart, localDir, testContents, result);
 
     // test against children
     for (int i = 0; i < static_cast<int>(Children.size()); ++i) {
@@ -1621,6 +1687,9 @@ void VRMenuObject::AddComponent(VRMenuComponent* component) {
         return;
     }
     Components.push_back(component);
+    if (MenuMgr != nullptr) {
+        MenuMgr->HierarchyChanged();
+    }
 }
 
 //==============================
@@ -1713,6 +1782,7 @@ Vector2f const& VRMenuObject::GetColorTableOffset() const {
 // VRMenuObject::SetColorTableOffset
 void VRMenuObject::SetColorTableOffset(Vector2f const& ofs) {
     ColorTableOffset = ofs;
+    MarkDirty(DIRTY_COLOR);
 }
 
 //==============================
@@ -1725,6 +1795,7 @@ Vector4f const& VRMenuObject::GetColor() const {
 // VRMenuObject::SetColor
 void VRMenuObject::SetColor(Vector4f const& c) {
     Color = c;
+    MarkDirty(DIRTY_COLOR);
 }
 
 void VRMenuObject::SetVisible(bool visible) {
@@ -1733,6 +1804,7 @@ void VRMenuObject::SetVisible(bool visible) {
     } else {
         Flags |= VRMenuObjectFlags_t(VRMENUOBJECT_DONT_RENDER);
     }
+    MarkDirty(DIRTY_VISIBILITY);
 }
 
 //==============================
@@ -1858,6 +1930,7 @@ void VRMenuObject::SetSurfaceTexture(
         return;
     }
     Surfaces[surfaceIndex].LoadTexture(guiSys, textureIndex, type, imageName);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1875,6 +1948,7 @@ void VRMenuObject::SetSurfaceTexture(
         return;
     }
     Surfaces[surfaceIndex].LoadTexture(textureIndex, type, texId, width, height);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1891,6 +1965,7 @@ void VRMenuObject::SetSurfaceTexture(
     }
     Surfaces[surfaceIndex].LoadTexture(
         textureIndex, type, texture.texture, texture.Width, texture.Height);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1909,6 +1984,7 @@ void VRMenuObject::SetSurfaceTextureTakeOwnership(
     }
     Surfaces[surfaceIndex].LoadTexture(textureIndex, type, texId, width, height);
     Surfaces[surfaceIndex].SetOwnership(textureIndex, true);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1926,6 +2002,7 @@ void VRMenuObject::SetSurfaceTextureTakeOwnership(
     Surfaces[surfaceIndex].LoadTexture(
         textureIndex, type, texture.texture, texture.Width, texture.Height);
     Surfaces[surfaceIndex].SetOwnership(textureIndex, true);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1944,6 +2021,7 @@ void VRMenuObject::RegenerateSurfaceGeometry(
     }
 
     Surfaces[surfaceIndex].RegenerateSurfaceGeometry();
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1968,6 +2046,7 @@ void VRMenuObject::SetSurfaceDims(int const surfaceIndex, Vector2f const& dims)
     }
 
     Surfaces[surfaceIndex].SetDims(dims);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1992,6 +2071,7 @@ void VRMenuObject::SetSurfaceBorder(int const surfaceIndex, Vector4f const& bord
     }
 
     Surfaces[surfaceIndex].SetBorder(border);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -1999,6 +2079,7 @@ void VRMenuObject::SetSurfaceBorder(int const surfaceIndex, Vector4f const& bord
 void VRMenuObject::SetLocalBoundsExpand(Vector3f const mins, Vector3f const& maxs) {
     MinsBoundsExpand = mins;
     MaxsBoundsExpand = maxs;
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -2008,6 +2089,7 @@ void VRMenuObject::SetCollisionPrimitive(OvrCollisionPrimitive* c) {
         delete CollisionPrimitive;
     }
     CollisionPrimitive = c;
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -2055,6 +2137,7 @@ int VRMenuObject::FindSurfaceWithTextureType(
 void VRMenuObject::SetSurfaceColor(int const surfaceIndex, Vector4f const& color) {
     VRMenuSurface& surf = Surfaces[surfaceIndex];
     surf.SetColor(color);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -2069,6 +2152,7 @@ Vector4f const& VRMenuObject::GetSurfaceColor(int const surfaceIndex) const {
 void VRMenuObject::SetSurfaceVisible(int const surfaceIndex, bool const v) {
     VRMenuSurface& surf = Surfaces[surfaceIndex];
     surf.SetVisible(v);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -2089,6 +2173,7 @@ int VRMenuObject::NumSurfaces() const {
 int VRMenuObject::AllocSurface() {
     int newIndex = static_cast<int>(Surfaces.size());
     Surfaces.emplace_back(VRMenuSurface());
+    MarkDirty(DIRTY_SURFACES);
     return newIndex;
 }
 
@@ -2100,6 +2185,7 @@ void VRMenuObject::CreateFromSurfaceParms(
     VRMenuSurfaceParms const& parms) {
     VRMenuSurface& surf = Surfaces[surfaceIndex];
     surf.CreateFromSurfaceParms(guiSys, parms);
+    MarkDirty(DIRTY_SURFACES);
 }
 
 //==============================
@@ -2107,6 +2193,7 @@ void VRMenuObject::CreateFromSurfaceParms(
 void VRMenuObject::SetText(char const* text) {
     Text = text;
     TextDirty = true;
+    MarkDirty(DIRTY_TEXT);
 }
 
 //==============================
@@ -2118,6 +2205,7 @@ void VRMenuObject::SetTextWordWrapped(
     FontParms.WrapWidth = widthInMeters;
     SetText(text);
     font.WordWrapText(Text, widthInMeters, FontParms.Scale);
+    MarkDirty(DIRTY_TEXT);
 }
 
 //==============================
@@ -2302,8 +2390,12 @@ ovrParseResult VRMenuObject::ParseItemParms(
                         return ovrParseResult(res, "Expected ')'.");
                     }
 
-                    refl.AddOverload(new ovrReflectionOverload_FloatDefaultValue(
-                        scope.c_str(), name.c_str(), value));
+                    ovrReflectionOverload* overload = new ovrReflectionOverload_FloatDefaultValue(
+                        scope.c_str(), name.c_str(), value);
+                    refl.AddOverload(overload);
+                    if (refl.GetBinaryWriter() != nullptr) {
+                        refl.GetBinaryWriter()->WriteOverload(*overload);
+                    }
                 }
             } else {
                 // unknown pragmas are errors for now
@@ -2313,6 +2405,9 @@ ovrParseResult VRMenuObject::ParseItemParms(
             std::vector<VRMenuObjectParms const*> parms;
             ovrTypeInfo const* typeInfo = refl.FindTypeInfo("std::vector< VRMenuObjectParms* >");
             if (typeInfo != nullptr) {
+                if (refl.GetBinaryWriter() != nullptr) {
+                    refl.GetBinaryWriter()->WriteValueBegin(typeInfo);
+                }
                 ovrParseResult parseRes =
                     ParseArray(refl, locale, fileName, lex, typeInfo, &parms, 0);
                 if (!parseRes) {
@@ -2339,4 +2434,63 @@ ovrParseResult VRMenuObject::ParseItemParms(
     return ovrParseResult();
 }
 
+//==============================
+// VRMenuObject::ParseItemParms
+ovrParseResult VRMenuObject::ParseItemParms(
+    ovrReflection& refl,
+    ovrReflectionBinaryReader& reader,
+    std::vector<VRMenuObjectParms const*>& itemParms) {
+    ovrTypeInfo const* parmsTypeInfo = refl.FindTypeInfo("std::vector< VRMenuObjectParms* >");
+    for (;;) {
+        ovrTypeInfo const* typeInfo = nullptr;
+        ovrParseResult res = reader.NextValue(typeInfo);
+        if (!res) {
+            return res;
+        }
+        if (typeInfo == nullptr) {
+            break;
+        }
+        if (typeInfo != parmsTypeInfo) {
+            return ovrParseResult(
+                ovrLexer::LEX_RESULT_ERROR,
+                "Unexpected compiled value of type '%s'",
+                typeInfo->TypeName);
+        }
+
+        std::vector<VRMenuObjectParms const*> parms;
+        res = reader.ReadValue(typeInfo, &parms);
+        if (!res) {
+            DeletePointerArray(parms);
+            return res;
+        }
+
+        itemParms.insert(itemParms.cend(), parms.cbegin(), parms.cend());
+        parms.resize(0);
+    }
+
+    return ovrParseResult();
+}
+
+//==============================
+// VRMenuObject::CompileItemParms
+ovrParseResult VRMenuObject::CompileItemParms(
+    ovrReflection& refl,
+    ovrLocale const& locale,
+    char const* fileName,
+    std::vector<uint8_t> const& buffer,
+    std::vector<uint8_t>& compiled) {
+    ovrReflectionBinaryWriter writer(refl);
+    refl.SetBinaryWriter(&writer);
+
+    std::vector<VRMenuObjectParms const*> itemParms;
+    ovrParseResult res = ParseItemParms(refl, locale, fileName, buffer, itemParms);
+    DeletePointerArray(itemParms);
+
+    refl.SetBinaryWriter(nullptr);
+    if (res) {
+        writer.Finish(buffer, compiled);
+    }
+    return res;
+}
+
 } // namespace OVRFW
@@ -27,6 +27,7 @@ Authors     :   Jonathan E. Wright
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -48,6 +49,7 @@ class OvrGuiSys;
 class ovrReflection;
 class ovrLocale;
 class ovrParseResult;
+class ovrReflectionBinaryReader;
 
 //==============================
 // DeletePointerArray
@@ -874,6 +876,7 @@ class VRMenuSurface {
     // GlGeometry						Geo;				// VBO for this surface
     OvrTriCollisionPrimitive Tris; // per-poly collision object
     OVR::Vector4f Color; // Color, modulated with object color
+    OVR::Vector4f DrawColor; // Color modulated with object color, as last built for drawing
     OVR::Vector2i TextureDims; // texture width and height
     OVR::Vector2f Dims; // width and height
     OVR::Vector2f Anchors; // anchors
@@ -906,6 +909,8 @@ class VRMenuSurface {
     bool HasTexturesOfType(eSurfaceTextureType const t, int const requiredCount) const;
     // Returns the index in Textures[] of the n-th occurence of type t.
     int IndexForTextureType(eSurfaceTextureType const t, int const occurenceCount) const;
+    // Changes the sampler state of the surface textures. A surface cannot reach its owner, so
+    // whatever calls this must mark the owning object's surfaces dirty afterwards.
     void SetTextureSampling(eGUIProgramType const pt);
 };
 
@@ -947,6 +952,7 @@ class VRMenuObject {
    public:
     friend class VRMenuMgr;
     friend class VRMenuMgrLocal;
+    friend class ovrMenuHitIndex;
 
     class ovrRecursionFunctor {
        public:
@@ -1056,12 +1062,15 @@ class VRMenuObject {
     }
     void SetFlags(VRMenuObjectFlags_t const& flags) {
         Flags = flags;
+        MarkDirty(DIRTY_VISIBILITY);
     }
     void AddFlags(VRMenuObjectFlags_t const& flags) {
         Flags |= flags;
+        MarkDirty(DIRTY_VISIBILITY);
     }
     void RemoveFlags(VRMenuObjectFlags_t const& flags) {
         Flags &= ~flags;
+        MarkDirty(DIRTY_VISIBILITY);
     }
 
     void ModifyFlags(bool const add, VRMenuObjectFlags_t const& flags) {
@@ -1089,6 +1098,7 @@ class VRMenuObject {
 
         Text = std::string(buf.data());
         TextDirty = true;
+        MarkDirty(DIRTY_TEXT);
     }
 
     void
@@ -1099,6 +1109,7 @@ class VRMenuObject {
     }
     void SetHilighted(bool const b) {
         Hilighted = b;
+        MarkDirty(DIRTY_POSE);
     }
     bool IsSelected() const {
         return Selected;
@@ -1120,22 +1131,26 @@ class VRMenuObject {
     }
     void SetLocalPose(OVR::Posef const& pose) {
         LocalPose = pose;
+        MarkDirty(DIRTY_POSE);
     }
     OVR::Vector3f const& GetLocalPosition() const {
         return LocalPose.Translation;
     }
     void SetLocalPosition(OVR::Vector3f const& pos) {
         LocalPose.Translation = pos;
+        MarkDirty(DIRTY_POSE);
     }
     OVR::Quatf const& GetLocalRotation() const {
         return LocalPose.Rotation;
     }
     void SetLocalRotation(OVR::Quatf const& rot) {
         LocalPose.Rotation = rot;
+        MarkDirty(DIRTY_POSE);
     }
     OVR::Vector3f GetLocalScale() const;
     void SetLocalScale(OVR::Vector3f const& scale) {
         LocalScale = scale;
+        MarkDirty(DIRTY_POSE);
     }
 
     OVR::Posef const& GetHilightPose() const {
@@ -1143,28 +1158,33 @@ class VRMenuObject {
     }
     void SetHilightPose(OVR::Posef const& pose) {
         HilightPose = pose;
+        MarkDirty(DIRTY_POSE);
     }
     float GetHilightScale() const {
         return HilightScale;
     }
     void SetHilightScale(float const s) {
         HilightScale = s;
+        MarkDirty(DIRTY_POSE);
     }
 
     void SetTextLocalPose(OVR::Posef const& pose) {
         TextLocalPose = pose;
+        MarkDirty(DIRTY_TEXT);
     }
     OVR::Posef const& GetTextLocalPose() const {
         return TextLocalPose;
     }
     void SetTextLocalPosition(OVR::Vector3f const& pos) {
         TextLocalPose.Translation = pos;
+        MarkDirty(DIRTY_TEXT);
     }
     OVR::Vector3f const& GetTextLocalPosition() const {
         return TextLocalPose.Translation;
     }
     void SetTextLocalRotation(OVR::Quatf const& rot) {
         TextLocalPose.Rotation = rot;
+        MarkDirty(DIRTY_TEXT);
     }
     OVR::Quatf const& GetTextLocalRotation() const {
         return TextLocalPose.Rotation;
@@ -1175,6 +1195,7 @@ class VRMenuObject {
     }
     void SetTextLocalScale(OVR::Vector3f const& scale) {
         TextLocalScale = scale;
+        MarkDirty(DIRTY_TEXT);
     }
 
     void SetLocalBoundsExpand(OVR::Vector3f const mins, OVR::Vector3f const& maxs);
@@ -1201,6 +1222,7 @@ class VRMenuObject {
     }
     void SetTextColor(OVR::Vector4f const& c) {
         TextColor = c;
+        MarkDirty(DIRTY_COLOR);
     }
 
     std::string const& GetName() const {
@@ -1219,6 +1241,7 @@ class VRMenuObject {
 
     void SetFontParms(VRMenuFontParms const& fontParms) {
         FontParms = fontParms;
+        MarkDirty(DIRTY_TEXT);
     }
     VRMenuFontParms const& GetFontParms() const {
         return FontParms;
@@ -1229,6 +1252,7 @@ class VRMenuObject {
     }
     void SetFadeDirection(OVR::Vector3f const& dir) {
         FadeDirection = dir;
+        MarkDirty(DIRTY_COLOR);
     }
 
     void SetVisible(bool visible);
@@ -1317,7 +1341,15 @@ class VRMenuObject {
     VRMenuSurface const& GetSurface(int const s) const {
         return Surfaces[s];
     }
+    // Same as the const GetSurface, for reading through a non-const object without marking it
+    // dirty.
+    VRMenuSurface const& GetSurfaceConst(int const s) const {
+        return Surfaces[s];
+    }
+    // The caller may modify the returned surface, so this always marks the surfaces dirty and the
+    // object is re-evaluated when it is next submitted. Use GetSurfaceConst to only read.
     VRMenuSurface& GetSurface(int const s) {
+        MarkDirty(DIRTY_SURFACES);
         return Surfaces[s];
     }
     std::vector<VRMenuSurface> const& GetSurfaces() const {
@@ -1373,6 +1405,19 @@ class VRMenuObject {
         char const* fileName,
         std::vector<uint8_t> const& buffer,
         std::vector<VRMenuObjectParms const*>& itemParms);
+    // Reads item parms from data written by CompileItemParms.
+    static ovrParseResult ParseItemParms(
+        ovrReflection& refl,
+        ovrReflectionBinaryReader& reader,
+        std::vector<VRMenuObjectParms const*>& itemParms);
+    // Parses the text in buffer and records the result as compiled data that ParseItemParms
+    // can load without tokenizing.
+    static ovrParseResult CompileItemParms(
+        ovrReflection& refl,
+        ovrLocale const& locale,
+        char const* fileName,
+        std::vector<uint8_t> const& buffer,
+        std::vector<uint8_t>& compiled);
 
    private:
     eVRMenuObjectType Type; // type of this object
@@ -1424,11 +1469,70 @@ class VRMenuObject {
 
     mutable ovrTextSurface* TextSurface;
 
+    // Render inputs that changed since VRMenuMgr last evaluated this object. Every change also
+    // sets DIRTY_SUBTREE on all ancestors so the manager knows which branches it must descend.
+    enum eDirtyFlags : std::uint32_t {
+        DIRTY_POSE = 1u << 0,
+        DIRTY_COLOR = 1u << 1,
+        DIRTY_VISIBILITY = 1u << 2,
+        DIRTY_TEXT = 1u << 3,
+        DIRTY_SURFACES = 1u << 4,
+        DIRTY_SUBTREE = 1u << 5,
+        DIRTY_ALL = 0x3Fu
+    };
+
+    // What VRMenuMgrLocal submitted for this object's subtree the last time it was evaluated, so
+    // an unchanged subtree can be copied from the previous frame instead of being re-evaluated.
+    struct ovrSubmitCache {
+        ovrSubmitCache()
+            : ParentScale(1.0f),
+              ParentColor(1.0f),
+              InheritedDistance(false),
+              Reusable(false),
+              Rendered(false),
+              LayoutId(0),
+              ParentLayoutId(0),
+              SubmittedOffset(0),
+              NumSubmitted(0),
+              TextDrawOffset(0),
+              NumTextDraws(0),
+              NumObjects(0),
+              RootFrame(0),
+              RootSubmitted(0),
+              RootTextDraw(0) {}
+
+        OVR::Posef ParentPose; // parent inputs the cached entries were generated from
+        OVR::Vector3f ParentScale;
+        OVR::Vector4f ParentColor;
+        VRMenuRenderFlags_t RenderFlags;
+        bool InheritedDistance; // true if every entry sorts by an ancestor's distance
+        bool Reusable; // false if the entries depend on the view or were truncated
+        bool Rendered; // false if the object was hidden, CullBounds are only valid if true
+        std::uint32_t LayoutId; // changes every time this object is re-evaluated
+        std::uint32_t ParentLayoutId; // parent's LayoutId when this subtree was placed in it
+        int SubmittedOffset; // first entry of this subtree relative to the parent's first entry
+        int NumSubmitted; // number of submitted entries for the whole subtree
+        int TextDrawOffset; // first text draw relative to the parent's first text draw
+        int NumTextDraws; // number of non-instanced text draws for the whole subtree
+        int NumObjects; // number of objects in the subtree
+        std::uint32_t RootFrame; // manager frame this object was last submitted on as a root
+        int RootSubmitted; // first entry of the subtree on RootFrame
+        int RootTextDraw; // first text draw of the subtree on RootFrame
+    };
+
+    OvrVRMenuMgr* MenuMgr; // manager that owns this object, used to propagate dirty flags
+    std::uint32_t DirtyFlags; // eDirtyFlags
+    bool HitChangePending; // true while queued in the manager's list of hit bounds changes
+    ovrSubmitCache SubmitCache;
+
    private:
     // only VRMenuMgrLocal static methods can construct and destruct a menu object.
     VRMenuObject(VRMenuObjectParms const& parms, menuHandle_t const handle);
     ~VRMenuObject();
 
+    // Records a change to this object's render inputs and flags all ancestors.
+    void MarkDirty(std::uint32_t const flags);
+
     bool IntersectRayBounds(
         OVR::Vector3f const& start,
         OVR::Vector3f const& dir,
@@ -1438,6 +1542,21 @@ class VRMenuObject {
         float& t0,
         float& t1) const;
 
+    // Returns false if this object has children and the ray misses their combined cull bounds, in
+    // which case neither this object nor any descendant can be hit. The ray is in the local space
+    // of this object.
+    bool HitTestCullBounds(OVR::Vector3f const& localStart, OVR::Vector3f const& localDir) const;
+
+    // Tests the ray against this object only and writes the hit into result. The ray is in the
+    // local space of this object.
+    void HitTestSelf(
+        OvrGuiSys const& guiSys,
+        OVR::Vector3f const& parentScale,
+        OVR::Vector3f const& localStart,
+        OVR::Vector3f const& localDir,
+        ContentFlags_t const testContents,
+        HitTestResult& result) const;
+
     // Test the ray against this object and all child objects, returning the first object that was
     // hit by the ray. The ray should be in parent-local space - for the current root menu this is
     // always world space.
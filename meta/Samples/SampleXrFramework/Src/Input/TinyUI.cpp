@@ -170,7 +170,7 @@ bool TinyUI::Init(
     DebugLines->Init();
 
     /// Needed for FONTS
-    Locale = ovrLocale::Create(*java->Env, java->ActivityObject, "default");
+    Locale = ovrLocale::Create(*java->Env, java->ActivityObject, "default", FileSys);
     if (nullptr == Locale) {
         ALOGE("Couldn't create Locale");
         return false;
@@ -234,15 +234,26 @@ void TinyUI::Update(const OVRFW::ovrApplFrameIn& in) {
         }
     }
 
-    /// hit test
+    /// hit test all devices in one batch
+    RayStarts.resize(Devices.size());
+    RayDirs.resize(Devices.size());
+    RayHits.resize(Devices.size());
+    for (size_t i = 0; i < Devices.size(); ++i) {
+        RayStarts[i] = Devices[i].pointerStart;
+        RayDirs[i] = (Devices[i].pointerEnd - Devices[i].pointerStart).Normalized();
+    }
+    GuiSys->TestRayIntersections(
+        RayStarts.data(), RayDirs.data(), static_cast<int>(Devices.size()), RayHits.data());
+
     bool hitHandled = false;
-    for (auto& device : Devices) {
+    for (size_t i = 0; i < Devices.size(); ++i) {
+        auto& device = Devices[i];
         Vector3f pointerStart = device.pointerStart;
         Vector3f pointerEnd = device.pointerEnd;
-        Vector3f pointerDir = (pointerEnd - pointerStart).Normalized();
+        Vector3f pointerDir = RayDirs[i];
         Vector3f targetEnd = pointerStart + pointerDir * 10.0f;
 
-        HitTestResult hit = GuiSys->TestRayIntersection(pointerStart, pointerDir);
+        HitTestResult const& hit = RayHits[i];
         if (hit.HitHandle.IsValid()) {
             device.pointerEnd = pointerStart + hit.RayDir * hit.t - pointerDir * 0.025f;
             device.hitObject = GuiSys->GetVRMenuMgr().ToObject(hit.HitHandle);
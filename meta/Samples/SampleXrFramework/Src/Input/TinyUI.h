@@ -139,6 +139,10 @@ class TinyUI {
     std::unordered_map<VRMenuObject*, std::function<void(void)>> ButtonHandlers;
     std::vector<OVRFW::TinyUI::HitTestDevice> Devices;
     std::vector<OVRFW::TinyUI::HitTestDevice> PreviousFrameDevices;
+    // per-device rays and results, kept around so the batched hit test does not allocate
+    std::vector<OVR::Vector3f> RayStarts;
+    std::vector<OVR::Vector3f> RayDirs;
+    std::vector<HitTestResult> RayHits;
     bool UpdateColors;
     std::function<void(void)> UnhandledClickHandler;
 };
@@ -42,7 +42,7 @@ Authors     :   Jonathan E. Wright
 #include "Misc/Log.h"
 
 #include "tinyxml2.h"
-#include "OVR_JSON.h"
+#include "OVR_LocaleStringTable.h"
 #include "OVR_FileSys.h"
 #include "OVR_UTF8Util.h"
 
@@ -81,9 +81,13 @@ class ovrLocaleInternal : public ovrLocale {
     virtual bool
     AddStringsFromAndroidFormatXMLBuffer(char const* name, char const* buffer, size_t const size);
 
+    virtual bool LoadStringsFromBinaryTable(ovrFileSys& fileSys, char const* fileName);
+
     virtual bool GetLocalizedString(char const* key, char const* defaultStr, std::string& out)
         const;
 
+    virtual char const* FindLocalizedString(std::string_view const key) const;
+
     virtual void ReplaceLocalizedText(char const* inText, char* out, size_t const outSize) const;
 
    private:
@@ -94,8 +98,17 @@ class ovrLocaleInternal : public ovrLocale {
 
     std::string Name; // user-specified locale name
     std::string LanguageCode; // system-specific locale name
+    // lets StringHash be searched with a std::string_view without building a std::string
+    struct StringViewHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view const s) const {
+            return std::hash<std::string_view>()(s);
+        }
+    };
+
     std::vector<std::string> Strings;
-    std::unordered_map<std::string, int> StringHash;
+    std::unordered_map<std::string, int, StringViewHash, std::equal_to<>> StringHash;
+    std::vector<ovrLocaleStringTable> StringTables; // searched after the XML strings
 
    private:
     bool GetStringJNI(char const* key, char const* defaultOut, std::string& out) const;
@@ -197,7 +210,7 @@ bool ovrLocaleInternal::AddStringsFromAndroidFormatXMLBuffer(
                     if (nextChar != '<' && nextChar != '>' && nextChar != '"' && nextChar != '\'' &&
                         nextChar != '&') {
                         ALOG("Unknown escape sequence '\\%x'", nextChar);
-                        decodedValue += std::uint8_t(curChar);
+                        decodedValue += '\\';
                     }
                     curChar = nextChar;
                 }
@@ -212,7 +225,11 @@ bool ovrLocaleInternal::AddStringsFromAndroidFormatXMLBuffer(
                 }
             }
 
-            decodedValue += std::uint8_t(curChar);
+            // append the whole code point, not just its low byte
+            char encoded[8];
+            intptr_t encodedSize = 0;
+            UTF8Util::EncodeChar(encoded, &encodedSize, curChar);
+            decodedValue.append(encoded, encodedSize);
             curChar = UTF8Util::DecodeNextChar(&in);
         }
         // ALOG( "Name: '%s' = '%s'\n", key.c_str(), value.c_str() );
@@ -243,6 +260,17 @@ bool ovrLocaleInternal::LoadStringsFromAndroidFormatXMLFile(
         buffer.size());
 }
 
+//==============================
+// ovrLocaleInternal::LoadStringsFromBinaryTable
+bool ovrLocaleInternal::LoadStringsFromBinaryTable(ovrFileSys& fileSys, char const* fileName) {
+    ovrLocaleStringTable table;
+    if (!table.Load(fileSys, fileName)) {
+        return false;
+    }
+    StringTables.push_back(std::move(table));
+    return true;
+}
+
 //==============================
 // ovrLocale::GetStringJNI
 // Get's a localized UTF-8-encoded string from the Android application's string table.
@@ -421,15 +449,10 @@ bool ovrLocaleInternal::GetLocalizedString(
         return false;
     }
 
-    if (strstr(key, LOCALIZED_KEY_PREFIX) == key) {
-        if (!Strings.empty()) {
-            std::string realKey(key + LOCALIZED_KEY_PREFIX_LEN);
-            auto it = StringHash.find(realKey);
-            if (it != StringHash.end()) {
-                out = Strings[it->second];
-                return true;
-            }
-        }
+    char const* localized = FindLocalizedString(key);
+    if (localized != nullptr) {
+        out = localized;
+        return true;
     }
     // try instead to find the string via Android's resources. Ideally, we'd have combined these all
     // into our own hash, but enumerating application resources from library code on is problematic
@@ -441,6 +464,27 @@ bool ovrLocaleInternal::GetLocalizedString(
     return false;
 }
 
+//==============================
+// ovrLocaleInternal::FindLocalizedString
+char const* ovrLocaleInternal::FindLocalizedString(std::string_view const key) const {
+    if (key.substr(0, LOCALIZED_KEY_PREFIX_LEN) != LOCALIZED_KEY_PREFIX) {
+        return nullptr;
+    }
+    std::string_view const realKey = key.substr(LOCALIZED_KEY_PREFIX_LEN);
+
+    auto it = StringHash.find(realKey);
+    if (it != StringHash.end()) {
+        return Strings[it->second].c_str();
+    }
+    for (const ovrLocaleStringTable& table : StringTables) {
+        char const* value = table.Find(realKey);
+        if (value != nullptr) {
+            return value;
+        }
+    }
+    return nullptr;
+}
+
 //==============================
 // ovrLocaleInternal::ReplaceLocalizedText
 void ovrLocaleInternal::ReplaceLocalizedText(char const* inText, char* out, size_t const outSize)
@@ -490,13 +534,16 @@ void ovrLocaleInternal::ReplaceLocalizedText(char const* inText, char* out, size
         cur += ofs;
         last = cur;
 
-        // get the localized text
+        // get the localized text, only building a string for the Android resources fallback
         std::string localized;
-        GetLocalizedString(atString, atString, localized);
+        char const* localizedText = FindLocalizedString(atString);
+        if (localizedText == nullptr) {
+            GetLocalizedString(atString, atString, localized);
+            localizedText = localized.c_str();
+        }
 
         // copy localized text into the output buffer
-        if (!CopyChars(
-                out, outSize, outOfs, localized.c_str(), OVR::OVR_strlen(localized.c_str()))) {
+        if (!CopyChars(out, outSize, outOfs, localizedText, OVR::OVR_strlen(localizedText))) {
             return;
         }
 
@@ -517,6 +564,22 @@ void ovrLocaleInternal::ReplaceLocalizedText(char const* inText, char* out, size
 // static functions for managing the global instance to a ovrLocaleInternal object
 //==============================================================================================
 
+//==============================
+// LoadCompiledStringTables
+// The build compiles res/values*/strings.xml into assets/strings/. The language's own table is
+// loaded first so that its strings are found before the default ones.
+static void
+LoadCompiledStringTables(ovrLocale& locale, ovrFileSys& fileSys, char const* languageCode) {
+    std::string const languageTable = std::string("apk:///assets/strings/") + languageCode + ".bin";
+    char const* const defaultTable = "apk:///assets/strings/default.bin";
+    if (fileSys.FileExists(languageTable.c_str())) {
+        locale.LoadStringsFromBinaryTable(fileSys, languageTable.c_str());
+    }
+    if (fileSys.FileExists(defaultTable)) {
+        locale.LoadStringsFromBinaryTable(fileSys, defaultTable);
+    }
+}
+
 //==============================
 // ovrLocale::Create
 ovrLocale*
@@ -573,6 +636,10 @@ ovrLocale::Create(JNIEnv& jni_, jobject activity_, char const* name, ovrFileSys*
     localePtr = new ovrLocaleInternal(name, languageCode.c_str());
 #endif // defined(OVR_OS_ANDROID)
 
+    if (fileSys != nullptr) {
+        LoadCompiledStringTables(*localePtr, *fileSys, languageCode.c_str());
+    }
+
     ALOG("ovrLocale::Create - exited");
     return localePtr;
 }
@@ -38,6 +38,7 @@ Authors     :   Jonathan E. Wright
 
 #include <stdint.h>
 #include <string>
+#include <string_view>
 
 #include "OVR_FileSys.h"
 #include "JniUtils.h"
@@ -54,7 +55,8 @@ class ovrLocale {
     //----------------------------------------------------------
     // static methods
     //----------------------------------------------------------
-    // creates a locale object for the system's current locale.
+    // creates a locale object for the system's current locale. With a fileSys, the string tables
+    // the build compiles from res/values*/strings.xml are loaded from the apk's assets/strings/.
     static ovrLocale*
     Create(JNIEnv& jni, jobject activity, char const* name, ovrFileSys* fileSys = nullptr);
 
@@ -103,11 +105,20 @@ class ovrLocale {
         char const* buffer,
         size_t const size) = 0;
 
+    // Adds a string table compiled from strings.xml by bin/scripts/compile_locale_strings.py.
+    // This avoids parsing XML at startup; the table is mapped when the file system allows it.
+    virtual bool LoadStringsFromBinaryTable(ovrFileSys& fileSys, char const* fileName) = 0;
+
     // returns the localized string associated with the passed key. Returns false if the
     // key was not found. If the key was not found, out will be set to the defaultStr.
     virtual bool GetLocalizedString(char const* key, char const* defaultStr, std::string& out)
         const = 0;
 
+    // Returns the null-terminated UTF-8 string for a "@string/" key loaded from XML or a binary
+    // table, or nullptr if there is none. Unlike GetLocalizedString this never allocates and does
+    // not fall back to the Android resources. The pointer stays valid until strings are added.
+    virtual char const* FindLocalizedString(std::string_view const key) const = 0;
+
     // Takes a string with potentially multiple "@string/*" keys and outputs the string to the out
     // buffer with the keys replaced by the localized text.
     virtual void ReplaceLocalizedText(char const* inText, char* out, size_t const outSize)
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   OVR_LocaleStringTable.cpp
+Content     :   Read-only binary string table compiled offline from Android strings.xml.
+Created     :   October 18, 2026
+Authors     :
+
+************************************************************************************/
+
+#include "OVR_LocaleStringTable.h"
+
+#include <string.h>
+#include <utility>
+
+#if !defined(OVR_OS_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Misc/Log.h"
+
+#include "OVR_FileSys.h"
+
+namespace OVRFW {
+
+//==============================
+// ovrLocaleStringTable::ovrLocaleStringTable
+ovrLocaleStringTable::ovrLocaleStringTable()
+    : Header(nullptr),
+      Seeds(nullptr),
+      Entries(nullptr),
+      Blob(nullptr),
+      MappedData(nullptr),
+      MappedSize(0) {}
+
+//==============================
+// ovrLocaleStringTable::~ovrLocaleStringTable
+ovrLocaleStringTable::~ovrLocaleStringTable() {
+    Unload();
+}
+
+ovrLocaleStringTable::ovrLocaleStringTable(ovrLocaleStringTable&& other) noexcept
+    : ovrLocaleStringTable() {
+    *this = std::move(other);
+}
+
+ovrLocaleStringTable& ovrLocaleStringTable::operator=(ovrLocaleStringTable&& other) noexcept {
+    if (this != &other) {
+        Unload();
+        // moving the vector keeps its data pointer, so the table pointers stay valid
+        Header = other.Header;
+        Seeds = other.Seeds;
+        Entries = other.Entries;
+        Blob = other.Blob;
+        Buffer = std::move(other.Buffer);
+        MappedData = other.MappedData;
+        MappedSize = other.MappedSize;
+
+        other.Header = nullptr;
+        other.Seeds = nullptr;
+        other.Entries = nullptr;
+        other.Blob = nullptr;
+        other.Buffer.clear();
+        other.MappedData = nullptr;
+        other.MappedSize = 0;
+    }
+    return *this;
+}
+
+//==============================
+// ovrLocaleStringTable::Hash
+// FNV-style multiply and xor, seeded so the minimal perfect hash can re-hash colliding buckets.
+uint32_t ovrLocaleStringTable::Hash(uint32_t seed, std::string_view const key) {
+    uint32_t h = (seed == 0) ? 0x01000193 : seed;
+    for (char const c : key) {
+        h = (h * 0x01000193) ^ static_cast<uint8_t>(c);
+    }
+    return h;
+}
+
+//==============================
+// ovrLocaleStringTable::Load
+bool ovrLocaleStringTable::Load(ovrFileSys& fileSys, char const* uri) {
+    Unload();
+
+#if !defined(OVR_OS_WIN32)
+    // files outside of the apk can be mapped instead of read
+    std::string path;
+    if (fileSys.GetLocalPathForURI(uri, path)) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            struct stat st;
+            if (fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    MappedData = data;
+                    MappedSize = st.st_size;
+                }
+            }
+            close(fd);
+        }
+        if (MappedData != nullptr) {
+            if (Validate(uri, static_cast<uint8_t const*>(MappedData), MappedSize)) {
+                return true;
+            }
+            Unload();
+            return false;
+        }
+    }
+#endif
+
+    if (!fileSys.ReadFile(uri, Buffer)) {
+        ALOG("ERROR: failed to read string table '%s'!", uri);
+        return false;
+    }
+    if (!Validate(uri, Buffer.data(), Buffer.size())) {
+        Unload();
+        return false;
+    }
+    return true;
+}
+
+//==============================
+// ovrLocaleStringTable::LoadFromBuffer
+bool ovrLocaleStringTable::LoadFromBuffer(
+    char const* name,
+    uint8_t const* buffer,
+    size_t const size) {
+    Unload();
+    Buffer.assign(buffer, buffer + size);
+    if (!Validate(name, Buffer.data(), Buffer.size())) {
+        Unload();
+        return false;
+    }
+    return true;
+}
+
+//==============================
+// ovrLocaleStringTable::Validate
+// Checks every offset once at load time so Find can trust the table.
+bool ovrLocaleStringTable::Validate(char const* name, uint8_t const* data, size_t const size) {
+    if (size < sizeof(ovrLocaleStringTableHeader) || (reinterpret_cast<uintptr_t>(data) & 3) != 0) {
+        ALOG("ERROR: string table '%s' is truncated!", name);
+        return false;
+    }
+    ovrLocaleStringTableHeader const* header =
+        reinterpret_cast<ovrLocaleStringTableHeader const*>(data);
+    if (header->Magic != MAGIC || header->Version != VERSION) {
+        ALOG("ERROR: '%s' is not a version %u string table!", name, VERSION);
+        return false;
+    }
+
+    const uint64_t slotCount = header->SlotCount;
+    const uint64_t seedsEnd = uint64_t(header->SeedsOffset) + slotCount * sizeof(int32_t);
+    const uint64_t entriesEnd =
+        uint64_t(header->EntriesOffset) + slotCount * sizeof(ovrLocaleStringTableEntry);
+    const uint64_t blobEnd = uint64_t(header->BlobOffset) + header->BlobSize;
+    if ((header->SeedsOffset & 3) != 0 || (header->EntriesOffset & 3) != 0 || seedsEnd > size ||
+        entriesEnd > size || blobEnd > size) {
+        ALOG("ERROR: string table '%s' has out of range sections!", name);
+        return false;
+    }
+
+    int32_t const* seeds = reinterpret_cast<int32_t const*>(data + header->SeedsOffset);
+    ovrLocaleStringTableEntry const* entries =
+        reinterpret_cast<ovrLocaleStringTableEntry const*>(data + header->EntriesOffset);
+    char const* blob = reinterpret_cast<char const*>(data + header->BlobOffset);
+
+    auto validString = [&](uint32_t offset, uint32_t length) {
+        return uint64_t(offset) + length < header->BlobSize && blob[offset + length] == '\0';
+    };
+    for (uint32_t i = 0; i < header->SlotCount; ++i) {
+        if (seeds[i] < 0 && uint32_t(-(int64_t(seeds[i]) + 1)) >= header->SlotCount) {
+            ALOG("ERROR: string table '%s' has a bad hash seed!", name);
+            return false;
+        }
+        if (!validString(entries[i].KeyOffset, entries[i].KeyLength) ||
+            !validString(entries[i].ValueOffset, entries[i].ValueLength)) {
+            ALOG("ERROR: string table '%s' has a bad string entry!", name);
+            return false;
+        }
+    }
+
+    Header = header;
+    Seeds = seeds;
+    Entries = entries;
+    Blob = blob;
+
+    ALOG("Loaded %u strings from '%s'", header->SlotCount, name);
+    return true;
+}
+
+//==============================
+// ovrLocaleStringTable::Unload
+void ovrLocaleStringTable::Unload() {
+#if !defined(OVR_OS_WIN32)
+    if (MappedData != nullptr) {
+        munmap(MappedData, MappedSize);
+    }
+#endif
+    MappedData = nullptr;
+    MappedSize = 0;
+    Buffer.clear();
+    Buffer.shrink_to_fit();
+
+    Header = nullptr;
+    Seeds = nullptr;
+    Entries = nullptr;
+    Blob = nullptr;
+}
+
+//==============================
+// ovrLocaleStringTable::Find
+char const* ovrLocaleStringTable::Find(std::string_view const key) const {
+    if (Header == nullptr || Header->SlotCount == 0) {
+        return nullptr;
+    }
+
+    const uint32_t slotCount = Header->SlotCount;
+    const int32_t seed = Seeds[Hash(0, key) % slotCount];
+    const uint32_t slot = (seed < 0) ? uint32_t(-(int64_t(seed) + 1))
+                                     : Hash(static_cast<uint32_t>(seed), key) % slotCount;
+
+    ovrLocaleStringTableEntry const& entry = Entries[slot];
+    if (entry.KeyLength != key.size() || memcmp(Blob + entry.KeyOffset, key.data(), key.size())) {
+        return nullptr;
+    }
+    return Blob + entry.ValueOffset;
+}
+
+} // namespace OVRFW
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   OVR_LocaleStringTable.h
+Content     :   Read-only binary string table compiled offline from Android strings.xml.
+Created     :   October 18, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OVRFW {
+
+class ovrFileSys;
+
+//==============================================================
+// ovrLocaleStringTable
+//
+// Binary layout, little-endian, produced by bin/scripts/compile_locale_strings.py:
+//   ovrLocaleStringTableHeader
+//   int32_t  Seeds[SlotCount]       minimal perfect hash displacement per bucket
+//   ovrLocaleStringTableEntry Entries[SlotCount]  one per string, indexed by hash slot
+//   char     Blob[BlobSize]         null-terminated UTF-8 keys and values; equal strings
+//                                   are stored once
+//
+// A key hashes (with seed 0) to a bucket. A non-negative seed re-hashes the key with that seed
+// to find its slot, a negative seed s places the bucket's only key in slot -s - 1. The entry in
+// the slot is then compared against the key, since keys that are not in the table land in
+// arbitrary slots.
+class ovrLocaleStringTable {
+   public:
+    static const uint32_t MAGIC = 0x534c564f; // "OVLS"
+    static const uint32_t VERSION = 1;
+
+    struct ovrLocaleStringTableHeader {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t SlotCount;
+        uint32_t SeedsOffset;
+        uint32_t EntriesOffset;
+        uint32_t BlobOffset;
+        uint32_t BlobSize;
+        uint32_t Pad;
+    };
+
+    struct ovrLocaleStringTableEntry {
+        uint32_t KeyOffset;
+        uint32_t KeyLength;
+        uint32_t ValueOffset;
+        uint32_t ValueLength;
+    };
+
+    ovrLocaleStringTable();
+    ~ovrLocaleStringTable();
+
+    ovrLocaleStringTable(ovrLocaleStringTable&& other) noexcept;
+    ovrLocaleStringTable& operator=(ovrLocaleStringTable&& other) noexcept;
+    ovrLocaleStringTable(const ovrLocaleStringTable&) = delete;
+    ovrLocaleStringTable& operator=(const ovrLocaleStringTable&) = delete;
+
+    // Maps the file if the file system gives it a local path, otherwise reads it into memory.
+    // The name is only used for error reporting.
+    bool Load(ovrFileSys& fileSys, char const* uri);
+    // Uses a buffer that has already been loaded. The buffer is copied.
+    bool LoadFromBuffer(char const* name, uint8_t const* buffer, size_t const size);
+
+    // Returns the null-terminated UTF-8 value for key (without the "@string/" prefix), or
+    // nullptr if the key is not in the table. Never allocates.
+    char const* Find(std::string_view const key) const;
+
+    int GetCount() const {
+        return Header != nullptr ? static_cast<int>(Header->SlotCount) : 0;
+    }
+
+    // The hash used by the table and by the offline compiler.
+    static uint32_t Hash(uint32_t seed, std::string_view const key);
+
+   private:
+    bool Validate(char const* name, uint8_t const* data, size_t const size);
+    void Unload();
+
+    ovrLocaleStringTableHeader const* Header;
+    int32_t const* Seeds;
+    ovrLocaleStringTableEntry const* Entries;
+    char const* Blob;
+
+    std::vector<uint8_t> Buffer; // owns the data when it was read rather than mapped
+    void* MappedData;
+    size_t MappedSize;
+};
+
+} // namespace OVRFW
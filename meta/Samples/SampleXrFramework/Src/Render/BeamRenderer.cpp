@@ -28,6 +28,8 @@ Authors     :   Jonathan E. Wright
 #include "BeamRenderer.h"
 #include "TextureAtlas.h"
 
+#include <algorithm>
+
 using OVR::Matrix4f;
 using OVR::Posef;
 using OVR::Quatf;
@@ -41,19 +43,43 @@ inline Vector3f GetViewMatrixPosition(Matrix4f const& m) {
 
 namespace OVRFW {
 
+static_assert(ovrBeamRenderer::BEAMS_PER_BATCH == 256, "BEAMS_PER_BATCH != 256");
+
+// Each instance is one beam. Position.xy selects the quad corner: x picks the side of the beam
+// and y picks the start or end point.
 static const char* BeamVertexSrc = R"glsl(
+struct Beam
+{
+	highp vec4 StartWidth;
+	highp vec4 End;
+	highp vec4 Color;
+	highp vec4 TexCoords;
+};
+
+layout(std140) uniform BeamRecords
+{
+	Beam Beams[256];
+} br;
+
+uniform highp vec3 ViewPosition;
+
 attribute highp vec4 Position;
-attribute lowp vec4 VertexColor;
-attribute highp vec2 TexCoord;
 
 varying lowp vec4 outColor;
 varying highp vec2 oTexCoord;
 
 void main()
 {
-	gl_Position = TransformVertex( Position );
-	oTexCoord = TexCoord;
-   	outColor = VertexColor;
+	Beam beam = br.Beams[ gl_InstanceID ];
+	highp vec3 beamVector = beam.End.xyz - beam.StartWidth.xyz;
+	highp vec3 beamCenter = beam.StartWidth.xyz + beamVector * 0.5;
+	// Offset the sides so the flat side of the beam faces the viewer. Classic billboarding.
+	highp vec3 side = normalize( cross( normalize( beamVector ), beamCenter - ViewPosition ) );
+	side *= beam.StartWidth.w * 0.5 * ( 1.0 - 2.0 * Position.x );
+	highp vec3 pos = mix( beam.StartWidth.xyz, beam.End.xyz, Position.y ) + side;
+	gl_Position = TransformVertex( vec4( pos, 1.0 ) );
+	oTexCoord = mix( beam.TexCoords.xy, beam.TexCoords.zw, Position.xy );
+	outColor = beam.Color;
 }
 )glsl";
 
@@ -112,6 +138,8 @@ void ovrBeamRenderer::Init(const int maxBeams, const bool depthTest) {
     if (TextureProgram.VertexShader == 0 || TextureProgram.FragmentShader == 0) {
         OVRFW::ovrProgramParm uniformParms[] = {
             /// Vertex
+            {.Name = "BeamRecords", .Type = OVRFW::ovrProgramParmType::BUFFER_UNIFORM},
+            {.Name = "ViewPosition", .Type = OVRFW::ovrProgramParmType::FLOAT_VECTOR3},
             /// Fragment
             {.Name = "Texture0", .Type = OVRFW::ovrProgramParmType::TEXTURE_SAMPLED},
         };
@@ -120,49 +148,67 @@ void ovrBeamRenderer::Init(const int maxBeams, const bool depthTest) {
             OVRFW::GlProgram::Build(BeamVertexSrc, TextureFragmentSrc, uniformParms, uniformCount);
     }
     if (ParametricProgram.VertexShader == 0 || ParametricProgram.FragmentShader == 0) {
-        ParametricProgram =
-            OVRFW::GlProgram::Build(BeamVertexSrc, ParametricFragmentSrc, nullptr, 0);
+        OVRFW::ovrProgramParm uniformParms[] = {
+            /// Vertex
+            {.Name = "BeamRecords", .Type = OVRFW::ovrProgramParmType::BUFFER_UNIFORM},
+            {.Name = "ViewPosition", .Type = OVRFW::ovrProgramParmType::FLOAT_VECTOR3},
+        };
+        const int uniformCount = sizeof(uniformParms) / sizeof(OVRFW::ovrProgramParm);
+        ParametricProgram = OVRFW::GlProgram::Build(
+            BeamVertexSrc, ParametricFragmentSrc, uniformParms, uniformCount);
     }
 
-    const int numVerts = maxBeams * 4;
+    Records.reserve(MaxBeams);
+    ViewPos = Vector3f(0.0f);
 
-    VertexAttribs attr;
-    attr.position.resize(numVerts);
-    attr.uv0.resize(numVerts);
-    attr.color.resize(numVerts);
-
-    // the indices will never change once we've set them up; we just won't necessarily
-    // use all of the index buffer to render.
-    std::vector<TriangleIndex> indices;
-    indices.resize(MaxBeams * 6);
-
-    for (int i = 0; i < MaxBeams; i++) {
-        indices[i * 6 + 0] = static_cast<TriangleIndex>(i * 4 + 0);
-        indices[i * 6 + 1] = static_cast<TriangleIndex>(i * 4 + 1);
-        indices[i * 6 + 2] = static_cast<TriangleIndex>(i * 4 + 3);
-        indices[i * 6 + 3] = static_cast<TriangleIndex>(i * 4 + 0);
-        indices[i * 6 + 4] = static_cast<TriangleIndex>(i * 4 + 3);
-        indices[i * 6 + 5] = static_cast<TriangleIndex>(i * 4 + 2);
+    // Batches are never resized after this, so the uniform data pointers stay valid.
+    Batches.resize((MaxBeams + BEAMS_PER_BATCH - 1) / BEAMS_PER_BATCH);
+    if (Batches.empty()) {
+        return;
     }
 
-    Surf.surfaceName = "beams";
-    Surf.geo.Create(attr, indices);
-    Surf.geo.primitiveType = GlGeometry::kPrimitiveTypeTriangles;
-    Surf.geo.indexCount = 0;
-
-    ovrGraphicsCommand& gc = Surf.graphicsCommand;
-    gc.GpuState.depthEnable = gc.GpuState.depthMaskEnable = depthTest;
-    gc.GpuState.blendEnable = ovrGpuState::BLEND_ENABLE;
-    gc.GpuState.blendSrc = ovrGpuState::kGL_SRC_ALPHA;
-    gc.GpuState.blendDst = ovrGpuState::kGL_ONE;
-    gc.Program = TextureProgram;
-    gc.GpuState.lineWidth = 1.0f;
+    // A single quad shared by every batch; the corners are expanded per beam in the shader.
+    VertexAttribs attr;
+    attr.position = {
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}};
+    const std::vector<TriangleIndex> indices = {0, 1, 3, 0, 3, 2};
+    GlGeometry quad(attr, indices);
+    quad.primitiveType = GlGeometry::kPrimitiveTypeTriangles;
+
+    for (ovrBeamBatch& batch : Batches) {
+        batch.RecordBuffer.Create(
+            GLBUFFER_TYPE_UNIFORM, BEAMS_PER_BATCH * sizeof(ovrBeamRecord), nullptr);
+
+        ovrSurfaceDef& surf = batch.Surf;
+        surf.surfaceName = "beams";
+        surf.geo = quad;
+        surf.numInstances = 0;
+
+        ovrGraphicsCommand& gc = surf.graphicsCommand;
+        gc.GpuState.depthEnable = gc.GpuState.depthMaskEnable = depthTest;
+        gc.GpuState.blendEnable = ovrGpuState::BLEND_ENABLE;
+        gc.GpuState.blendSrc = ovrGpuState::kGL_SRC_ALPHA;
+        gc.GpuState.blendDst = ovrGpuState::kGL_ONE;
+        gc.GpuState.cullEnable = false;
+        gc.GpuState.lineWidth = 1.0f;
+        gc.Program = TextureProgram;
+        gc.UniformData[0].Data = &batch.RecordBuffer;
+        gc.UniformData[1].Data = &ViewPos;
+    }
 }
 
 //==============================
 // ovrBeamRenderer::Shutdown
 void ovrBeamRenderer::Shutdown() {
-    Surf.geo.Free();
+    // The quad geometry is shared by all of the batches.
+    if (!Batches.empty()) {
+        Batches[0].Surf.geo.Free();
+    }
+    for (ovrBeamBatch& batch : Batches) {
+        batch.RecordBuffer.Destroy();
+    }
+    Batches.resize(0);
+    Records.resize(0);
     OVRFW::GlProgram::Free(TextureProgram);
     OVRFW::GlProgram::Free(ParametricProgram);
 
@@ -341,24 +387,11 @@ void ovrBeamRenderer::FrameInternal(
     const OVRFW::ovrApplFrameIn& frame,
     const OVR::Matrix4f& centerViewMatrix,
     const class ovrTextureAtlas* atlas) {
-    /// we
-    if (atlas) {
-        Surf.geo.indexCount = 0;
-        Surf.graphicsCommand.Textures[0] = atlas->GetTexture();
-        Surf.graphicsCommand.BindUniformTextures();
-        Surf.graphicsCommand.Program = TextureProgram;
-    } else {
-        Surf.graphicsCommand.Program = ParametricProgram;
-    }
+    const GlProgram& program = atlas ? TextureProgram : ParametricProgram;
 
-    VertexAttribs attr;
-    attr.position.resize(ActiveBeams.size() * 4);
-    attr.color.resize(ActiveBeams.size() * 4);
-    attr.uv0.resize(ActiveBeams.size() * 4);
-
-    const Vector3f viewPos = GetViewMatrixPosition(centerViewMatrix);
+    Records.resize(0);
+    ViewPos = GetViewMatrixPosition(centerViewMatrix);
 
-    int quadIndex = 0;
     for (int i = 0; i < static_cast<int>(ActiveBeams.size()); ++i) {
         const handle_t beamHandle = ActiveBeams[i];
         if (!beamHandle.IsValid()) {
@@ -376,42 +409,36 @@ void ovrBeamRenderer::FrameInternal(
             continue;
         }
 
-        // Vector describing length and direction of beam (but not position)
-        const Vector3f beamVector = cur.EndPos - cur.StartPos;
-        // Center of the beam in "world space". Start + half-way along the beam
-        const Vector3f beamCenter = cur.StartPos + beamVector * 0.5f;
-        const Vector3f beamDir = beamVector.Normalized();
-        // Vector from centerView to the center of the beam
-        const Vector3f viewToCenter = beamCenter - viewPos;
-        // Cross product gives us an offset direction for the beam such that the flat side is facing
-        // the viewer. Classic billboarding.
-        const Vector3f cross = beamDir.Cross(viewToCenter).Normalized() * cur.Width * 0.5f;
-
         const float t = static_cast<float>(frame.PredictedDisplayTime - cur.StartTime);
 
-        const Vector4f color = EaseFunctions[cur.EaseFunc](cur.InitialColor, t / cur.LifeTime);
-        const Vector2f uvOfs(0.0f);
-
-        attr.position[quadIndex * 4 + 0] = cur.StartPos + cross;
-        attr.position[quadIndex * 4 + 1] = cur.StartPos - cross;
-        attr.position[quadIndex * 4 + 2] = cur.EndPos + cross;
-        attr.position[quadIndex * 4 + 3] = cur.EndPos - cross;
-        attr.color[quadIndex * 4 + 0] = color;
-        attr.color[quadIndex * 4 + 1] = color;
-        attr.color[quadIndex * 4 + 2] = color;
-        attr.color[quadIndex * 4 + 3] = color;
-        attr.uv0[quadIndex * 4 + 0] = Vector2f(cur.TexCoords[0].x, cur.TexCoords[0].y) + uvOfs;
-        attr.uv0[quadIndex * 4 + 1] = Vector2f(cur.TexCoords[1].x, cur.TexCoords[0].y) + uvOfs;
-        attr.uv0[quadIndex * 4 + 2] = Vector2f(cur.TexCoords[0].x, cur.TexCoords[1].y) + uvOfs;
-        attr.uv0[quadIndex * 4 + 3] = Vector2f(cur.TexCoords[1].x, cur.TexCoords[1].y) + uvOfs;
-
-        quadIndex++;
+        ovrBeamRecord record;
+        record.StartWidth = Vector4f(cur.StartPos, cur.Width);
+        record.End = Vector4f(cur.EndPos, 1.0f);
+        record.Color = EaseFunctions[cur.EaseFunc](cur.InitialColor, t / cur.LifeTime);
+        record.TexCoords = Vector4f(
+            cur.TexCoords[0].x, cur.TexCoords[0].y, cur.TexCoords[1].x, cur.TexCoords[1].y);
+        Records.push_back(record);
     }
 
-    // Surf.graphicsCommand.GpuState.polygonMode = GL_LINE;
-    Surf.graphicsCommand.GpuState.cullEnable = false;
-    Surf.geo.indexCount = quadIndex * 6;
-    Surf.geo.Update(attr);
+    // Only the records of the active beams are uploaded; the quads are built by the shader.
+    const int numRecords = static_cast<int>(Records.size());
+    for (int b = 0; b < static_cast<int>(Batches.size()); ++b) {
+        ovrBeamBatch& batch = Batches[b];
+        const int first = b * BEAMS_PER_BATCH;
+        const int count = std::max(0, std::min(BEAMS_PER_BATCH, numRecords - first));
+        batch.Surf.numInstances = count;
+        if (count == 0) {
+            continue;
+        }
+
+        ovrGraphicsCommand& gc = batch.Surf.graphicsCommand;
+        gc.Program = program;
+        if (atlas) {
+            gc.Textures[0] = atlas->GetTexture();
+            gc.BindUniformTextures();
+        }
+        batch.RecordBuffer.Update(count * sizeof(ovrBeamRecord), &Records[first]);
+    }
 }
 
 //==============================
@@ -420,14 +447,14 @@ void ovrBeamRenderer::RenderEyeView(
     const Matrix4f& /*viewMatrix*/,
     const Matrix4f& /*projMatrix*/,
     std::vector<ovrDrawSurface>& surfaceList) {
-    if (Surf.geo.indexCount > 0) {
-        surfaceList.push_back(ovrDrawSurface(ModelMatrix, &Surf));
-    }
+    Render(surfaceList);
 }
 
 void ovrBeamRenderer::Render(std::vector<ovrDrawSurface>& surfaceList) {
-    if (Surf.geo.indexCount > 0) {
-        surfaceList.push_back(ovrDrawSurface(ModelMatrix, &Surf));
+    for (const ovrBeamBatch& batch : Batches) {
+        if (batch.Surf.numInstances > 0) {
+            surfaceList.push_back(ovrDrawSurface(ModelMatrix, &batch.Surf));
+        }
     }
 }
 
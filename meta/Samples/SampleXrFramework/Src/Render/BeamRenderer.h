@@ -35,6 +35,7 @@ Authors     :   Jonathan E. Wright
 #include "FrameParams.h"
 #include "Render/SurfaceRender.h"
 #include "Render/GlProgram.h"
+#include "Render/GlBuffer.h"
 
 #include "TextureAtlas.h"
 #include "EaseFunctions.h"
@@ -51,6 +52,11 @@ class ovrBeamRenderer {
 
     static float LIFETIME_INFINITE;
 
+    // Beams are drawn as instances of a single quad, reading their records from a uniform
+    // buffer. 256 records of 64 bytes fill the 16KB minimum GL_MAX_UNIFORM_BLOCK_SIZE, so
+    // larger beam counts are split across several draws.
+    static const int BEAMS_PER_BATCH = 256;
+
     ovrBeamRenderer();
     ~ovrBeamRenderer();
 
@@ -154,7 +160,23 @@ class ovrBeamRenderer {
         ovrEaseFunc EaseFunc;
     };
 
-    ovrSurfaceDef Surf;
+    // Per-beam data expanded into a camera-facing quad by the vertex shader. Must match the
+    // Beam struct in BeamVertexSrc.
+    struct ovrBeamRecord {
+        OVR::Vector4f StartWidth; // xyz = start position, w = width
+        OVR::Vector4f End; // xyz = end position
+        OVR::Vector4f Color;
+        OVR::Vector4f TexCoords; // xy = min tex coords, zw = max tex coords
+    };
+
+    struct ovrBeamBatch {
+        ovrSurfaceDef Surf;
+        GlBuffer RecordBuffer;
+    };
+
+    std::vector<ovrBeamBatch> Batches;
+    std::vector<ovrBeamRecord> Records;
+    OVR::Vector3f ViewPos;
 
     std::vector<ovrBeamInfo> BeamInfos;
     std::vector<handle_t> ActiveBeams;
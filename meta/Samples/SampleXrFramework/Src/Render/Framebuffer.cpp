@@ -30,6 +30,7 @@ Copyright 	: 	Copyright 2015 Oculus VR, LLC. All Rights reserved.
  *************************************************************************************/
 
 #include "Framebuffer.h"
+#include "GlState.h"
 #include "Misc/Log.h"
 #include <vector>
 
@@ -151,12 +152,12 @@ bool ovrFramebuffer_Create(
         const GLuint colorTexture = frameBuffer->ColorSwapChainImage[i].image;
 
         GLenum colorTextureTarget = GL_TEXTURE_2D;
-        GL(glBindTexture(colorTextureTarget, colorTexture));
+        GL(OVRFW::GetGlState().BindTexture(colorTextureTarget, colorTexture));
         GL(glTexParameteri(colorTextureTarget, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
         GL(glTexParameteri(colorTextureTarget, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
         GL(glTexParameteri(colorTextureTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
         GL(glTexParameteri(colorTextureTarget, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-        GL(glBindTexture(colorTextureTarget, 0));
+        GL(OVRFW::GetGlState().BindTexture(colorTextureTarget, 0));
 
         if (multisamples > 1 && glRenderbufferStorageMultisampleEXT != nullptr &&
             glFramebufferTexture2DMultisampleEXT != nullptr) {
@@ -30,6 +30,7 @@ Authors     :   John Carmack
 #include "CompilerUtils.h"
 
 #include "Egl.h"
+#include "GlState.h"
 
 namespace OVRFW {
 
@@ -51,6 +52,7 @@ bool GlBuffer::Create(const GlBufferType_t type, const size_t dataSize, const vo
 
 void GlBuffer::Destroy() {
     if (buffer != 0) {
+        GetGlState().BufferDeleted(buffer);
         glDeleteBuffers(1, &buffer);
         buffer = 0;
     }
@@ -26,9 +26,15 @@ Authors     :   John Carmack, J.M.P. van Waveren
 *************************************************************************************/
 
 #include "GlGeometry.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include "GlProgram.h"
 #include "Misc/Log.h"
 #include "Egl.h"
+#include "GlState.h"
 
 using OVR::Bounds3f;
 using OVR::Vector2f;
@@ -44,6 +50,28 @@ namespace OVRFW {
 
 unsigned GlGeometry::IndexType = (sizeof(TriangleIndex) == 2) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 
+// The streaming ring of a dynamic vertex buffer. GlGeometry is passed around by value, so the ring
+// is kept by vertex buffer rather than in the geometry, where each copy would have its own cursor
+// and fences for the same storage.
+struct DynamicVertexRing {
+    uint32_t RegionSize = 0; // bytes per region
+    int32_t Region = -1; // region written last, -1 if none
+    GLsync Fences[GlGeometry::DYNAMIC_REGIONS] = {}; // fencing the draws that read each region
+};
+
+// Geometry may be freed on a different thread than the one streaming it.
+static std::mutex DynamicVertexRingsMutex;
+static std::unordered_map<uint32_t, DynamicVertexRing> DynamicVertexRings;
+
+static void DeleteFences(DynamicVertexRing& ring) {
+    for (GLsync& fence : ring.Fences) {
+        if (fence != nullptr) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+}
+
 template <typename _attrib_type_>
 void PackVertexAttribute(
     std::vector<uint8_t>& packed,
@@ -66,6 +94,46 @@ void PackVertexAttribute(
     }
 }
 
+template <typename _attrib_type_>
+size_t VertexAttributeSize(const std::vector<_attrib_type_>& attrib) {
+    return attrib.size() * sizeof(attrib[0]);
+}
+
+// Destination of StreamVertexAttribute: mapped buffer storage that starts at bufferOffset in
+// the vertex buffer, with offset bytes already written.
+struct VertexStream {
+    uint8_t* mapped;
+    size_t bufferOffset;
+    size_t offset;
+};
+
+// Like PackVertexAttribute, but writes straight into mapped buffer storage.
+template <typename _attrib_type_>
+void StreamVertexAttribute(
+    VertexStream& stream,
+    const std::vector<_attrib_type_>& attrib,
+    const int glLocation,
+    const int glType,
+    const int glComponents) {
+    if (attrib.size() > 0) {
+        const size_t size = attrib.size() * sizeof(attrib[0]);
+
+        memcpy(stream.mapped + stream.offset, attrib.data(), size);
+
+        glEnableVertexAttribArray(glLocation);
+        glVertexAttribPointer(
+            glLocation,
+            glComponents,
+            glType,
+            false,
+            sizeof(attrib[0]),
+            (void*)(stream.bufferOffset + stream.offset));
+        stream.offset += size;
+    } else {
+        glDisableVertexAttribArray(glLocation);
+    }
+}
+
 void GlGeometry::Create(const VertexAttribs& attribs, const std::vector<TriangleIndex>& indices) {
     vertexCount = attribs.position.size();
     indexCount = indices.size();
@@ -104,7 +172,7 @@ void GlGeometry::Create(const VertexAttribs& attribs, const std::vector<Triangle
     glGenBuffers(1, &vertexBuffer);
     glGenBuffers(1, &indexBuffer);
     glGenVertexArrays(1, &vertexArrayObject);
-    glBindVertexArray(vertexArrayObject);
+    GetGlState().BindVertexArray(vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
 
     std::vector<uint8_t> packed;
@@ -134,7 +202,7 @@ void GlGeometry::Create(const VertexAttribs& attribs, const std::vector<Triangle
         indices.data(),
         GL_STATIC_DRAW);
 
-    glBindVertexArray(0);
+    GetGlState().BindVertexArray(0);
 
     glDisableVertexAttribArray(VERTEX_ATTRIBUTE_LOCATION_POSITION);
     glDisableVertexAttribArray(VERTEX_ATTRIBUTE_LOCATION_NORMAL);
@@ -155,24 +223,42 @@ void GlGeometry::Create(const VertexAttribs& attribs, const std::vector<Triangle
 void GlGeometry::Update(const VertexAttribs& attribs, const bool updateBounds) {
     vertexCount = attribs.position.size();
 
-    glBindVertexArray(vertexArrayObject);
+    GetGlState().BindVertexArray(vertexArrayObject);
 
     glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
 
-    std::vector<uint8_t> packed;
-    PackVertexAttribute(packed, attribs.position, VERTEX_ATTRIBUTE_LOCATION_POSITION, GL_FLOAT, 3);
-    PackVertexAttribute(packed, attribs.normal, VERTEX_ATTRIBUTE_LOCATION_NORMAL, GL_FLOAT, 3);
-    PackVertexAttribute(packed, attribs.tangent, VERTEX_ATTRIBUTE_LOCATION_TANGENT, GL_FLOAT, 3);
-    PackVertexAttribute(packed, attribs.binormal, VERTEX_ATTRIBUTE_LOCATION_BINORMAL, GL_FLOAT, 3);
-    PackVertexAttribute(packed, attribs.color, VERTEX_ATTRIBUTE_LOCATION_COLOR, GL_FLOAT, 4);
-    PackVertexAttribute(packed, attribs.uv0, VERTEX_ATTRIBUTE_LOCATION_UV0, GL_FLOAT, 2);
-    PackVertexAttribute(packed, attribs.uv1, VERTEX_ATTRIBUTE_LOCATION_UV1, GL_FLOAT, 2);
-    PackVertexAttribute(
-        packed, attribs.jointIndices, VERTEX_ATTRIBUTE_LOCATION_JOINT_INDICES, GL_INT, 4);
-    PackVertexAttribute(
-        packed, attribs.jointWeights, VERTEX_ATTRIBUTE_LOCATION_JOINT_WEIGHTS, GL_FLOAT, 4);
+    const size_t size = VertexAttributeSize(attribs.position) +
+        VertexAttributeSize(attribs.normal) + VertexAttributeSize(attribs.tangent) +
+        VertexAttributeSize(attribs.binormal) + VertexAttributeSize(attribs.color) +
+        VertexAttributeSize(attribs.uv0) + VertexAttributeSize(attribs.uv1) +
+        VertexAttributeSize(attribs.jointIndices) + VertexAttributeSize(attribs.jointWeights);
+
+    VertexStream stream = {nullptr, 0, 0};
+    if (size > 0) {
+        stream.mapped = static_cast<uint8_t*>(MapDynamicVertices(size, stream.bufferOffset));
+        if (stream.mapped == nullptr) {
+            ALOGW("GlGeometry::Update: failed to map %zu bytes of vertex data", size);
+            return;
+        }
+    }
 
-    glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(packed[0]), packed.data(), GL_STATIC_DRAW);
+    StreamVertexAttribute(
+        stream, attribs.position, VERTEX_ATTRIBUTE_LOCATION_POSITION, GL_FLOAT, 3);
+    StreamVertexAttribute(stream, attribs.normal, VERTEX_ATTRIBUTE_LOCATION_NORMAL, GL_FLOAT, 3);
+    StreamVertexAttribute(stream, attribs.tangent, VERTEX_ATTRIBUTE_LOCATION_TANGENT, GL_FLOAT, 3);
+    StreamVertexAttribute(
+        stream, attribs.binormal, VERTEX_ATTRIBUTE_LOCATION_BINORMAL, GL_FLOAT, 3);
+    StreamVertexAttribute(stream, attribs.color, VERTEX_ATTRIBUTE_LOCATION_COLOR, GL_FLOAT, 4);
+    StreamVertexAttribute(stream, attribs.uv0, VERTEX_ATTRIBUTE_LOCATION_UV0, GL_FLOAT, 2);
+    StreamVertexAttribute(stream, attribs.uv1, VERTEX_ATTRIBUTE_LOCATION_UV1, GL_FLOAT, 2);
+    StreamVertexAttribute(
+        stream, attribs.jointIndices, VERTEX_ATTRIBUTE_LOCATION_JOINT_INDICES, GL_INT, 4);
+    StreamVertexAttribute(
+        stream, attribs.jointWeights, VERTEX_ATTRIBUTE_LOCATION_JOINT_WEIGHTS, GL_FLOAT, 4);
+
+    if (stream.mapped != nullptr) {
+        UnmapDynamicVertices();
+    }
 
     if (updateBounds) {
         localBounds.Clear();
@@ -182,7 +268,66 @@ void GlGeometry::Update(const VertexAttribs& attribs, const bool updateBounds) {
     }
 }
 
+void* GlGeometry::MapDynamicVertices(const size_t size, size_t& offset) {
+    std::lock_guard<std::mutex> lock(DynamicVertexRingsMutex);
+    DynamicVertexRing& ring = DynamicVertexRings[vertexBuffer];
+
+    // Everything that reads the region written last has been issued since it was written, so a
+    // fence issued now tells when that region may be written again.
+    if (ring.Region >= 0) {
+        if (ring.Fences[ring.Region] != nullptr) {
+            glDeleteSync(ring.Fences[ring.Region]);
+        }
+        ring.Fences[ring.Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    if (size > ring.RegionSize) {
+        // Grow the ring. The old storage is orphaned rather than waited on, so none of the
+        // fences apply to the new storage.
+        DeleteFences(ring);
+        const size_t regionSize = std::max<size_t>(size, ring.RegionSize * 2);
+        ring.RegionSize = static_cast<uint32_t>((regionSize + 255) & ~size_t(255));
+        glBufferData(
+            GL_ARRAY_BUFFER, ring.RegionSize * DYNAMIC_REGIONS, nullptr, GL_DYNAMIC_DRAW);
+        ring.Region = -1;
+    }
+
+    ring.Region = (ring.Region + 1) % DYNAMIC_REGIONS;
+    if (ring.Fences[ring.Region] != nullptr) {
+        // Normally signalled long ago; this only waits when the GPU is frames behind.
+        GLsync fence = ring.Fences[ring.Region];
+        if (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+            ALOGW("GlGeometry::MapDynamicVertices: timed out waiting for the GPU");
+        }
+        glDeleteSync(fence);
+        ring.Fences[ring.Region] = nullptr;
+    }
+
+    offset = static_cast<size_t>(ring.Region) * ring.RegionSize;
+    return glMapBufferRange(
+        GL_ARRAY_BUFFER,
+        offset,
+        size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void GlGeometry::UnmapDynamicVertices() {
+    if (!glUnmapBuffer(GL_ARRAY_BUFFER)) {
+        ALOGW("GlGeometry::UnmapDynamicVertices: vertex data was corrupted");
+    }
+}
+
 void GlGeometry::Free() {
+    {
+        std::lock_guard<std::mutex> lock(DynamicVertexRingsMutex);
+        auto ring = DynamicVertexRings.find(vertexBuffer);
+        if (ring != DynamicVertexRings.end()) {
+            DeleteFences(ring->second);
+            DynamicVertexRings.erase(ring);
+        }
+    }
+
+    GetGlState().VertexArrayDeleted(vertexArrayObject);
     glDeleteVertexArrays(1, &vertexArrayObject);
     glDeleteBuffers(1, &indexBuffer);
     glDeleteBuffers(1, &vertexBuffer);
@@ -196,29 +341,17 @@ void GlGeometry::Free() {
     localBounds.Clear();
 }
 
-// Sets up VB and VAO for font drawing
-GlGeometry FontGeometryCreate(fontVertex_t* verts, int numVerts, OVR::Bounds3f& localBounds) {
-    GlGeometry Geo;
-
-    const int maxQuads = numVerts / 4;
-    Geo.indexCount = maxQuads * 6;
-    Geo.vertexCount = maxQuads * 4;
-
-    Geo.localBounds = localBounds;
-
-    // font VAO
-    glGenVertexArrays(1, &Geo.vertexArrayObject);
-    glBindVertexArray(Geo.vertexArrayObject);
-
-    // vertex buffer
-    const int vertexByteCount = Geo.vertexCount * sizeof(fontVertex_t);
-    glGenBuffers(1, &Geo.vertexBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, Geo.vertexBuffer);
-    glBufferData(GL_ARRAY_BUFFER, vertexByteCount, nullptr, GL_DYNAMIC_DRAW);
-
+// Points the font attributes of the bound VAO at vertices starting at bufferOffset in the bound
+// vertex buffer.
+static void SetFontVertexAttributes(const size_t bufferOffset) {
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOCATION_POSITION); // x, y and z
     glVertexAttribPointer(
-        VERTEX_ATTRIBUTE_LOCATION_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(fontVertex_t), nullptr);
+        VERTEX_ATTRIBUTE_LOCATION_POSITION,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(fontVertex_t),
+        (void*)(bufferOffset));
 
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOCATION_UV0); // s and t
     glVertexAttribPointer(
@@ -227,7 +360,7 @@ GlGeometry FontGeometryCreate(fontVertex_t* verts, int numVerts, OVR::Bounds3f&
         GL_FLOAT,
         GL_FALSE,
         sizeof(fontVertex_t),
-        (void*)offsetof(fontVertex_t, s));
+        (void*)(bufferOffset + offsetof(fontVertex_t, s)));
 
     glEnableVertexAttribArray(VERTEX_ATTRIBUTE_LOCATION_COLOR); // color
     glVertexAttribPointer(
@@ -236,7 +369,7 @@ GlGeometry FontGeometryCreate(fontVertex_t* verts, int numVerts, OVR::Bounds3f&
         GL_UNSIGNED_BYTE,
         GL_TRUE,
         sizeof(fontVertex_t),
-        (void*)offsetof(fontVertex_t, rgba));
+        (void*)(bufferOffset + offsetof(fontVertex_t, rgba)));
 
     glDisableVertexAttribArray(VERTEX_ATTRIBUTE_LOCATION_UV1);
 
@@ -247,7 +380,30 @@ GlGeometry FontGeometryCreate(fontVertex_t* verts, int numVerts, OVR::Bounds3f&
         GL_UNSIGNED_BYTE,
         GL_TRUE,
         sizeof(fontVertex_t),
-        (void*)offsetof(fontVertex_t, fontParms));
+        (void*)(bufferOffset + offsetof(fontVertex_t, fontParms)));
+}
+
+// Sets up VB and VAO for font drawing
+GlGeometry FontGeometryCreate(fontVertex_t* verts, int numVerts, OVR::Bounds3f& localBounds) {
+    GlGeometry Geo;
+
+    const int maxQuads = numVerts / 4;
+    Geo.indexCount = maxQuads * 6;
+    Geo.vertexCount = maxQuads * 4;
+
+    Geo.localBounds = localBounds;
+
+    // font VAO
+    glGenVertexArrays(1, &Geo.vertexArrayObject);
+    GetGlState().BindVertexArray(Geo.vertexArrayObject);
+
+    // vertex buffer
+    const int vertexByteCount = Geo.vertexCount * sizeof(fontVertex_t);
+    glGenBuffers(1, &Geo.vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, Geo.vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, vertexByteCount, nullptr, GL_DYNAMIC_DRAW);
+
+    SetFontVertexAttributes(0);
 
     fontIndex_t* indices = new fontIndex_t[Geo.indexCount];
     const int indexByteCount = Geo.indexCount * sizeof(fontIndex_t);
@@ -268,24 +424,33 @@ GlGeometry FontGeometryCreate(fontVertex_t* verts, int numVerts, OVR::Bounds3f&
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Geo.indexBuffer);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexByteCount, (void*)indices, GL_STATIC_DRAW);
 
-    glBindVertexArray(0);
+    GetGlState().BindVertexArray(0);
 
     delete[] indices;
 
-    glBindVertexArray(Geo.vertexArrayObject);
+    GetGlState().BindVertexArray(Geo.vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, Geo.vertexBuffer);
     glBufferSubData(GL_ARRAY_BUFFER, 0, numVerts * sizeof(fontVertex_t), (void*)verts);
-    glBindVertexArray(0);
+    GetGlState().BindVertexArray(0);
 
     return Geo;
 }
 
 void FontGeometryUpdate(GlGeometry& geo, fontVertex_t* verts, int numVerts, int numIndices) {
-    // Update the font VB/IB
-    glBindVertexArray(geo.vertexArrayObject);
+    // Stream the font VB instead of overwriting the storage the previous frames draw from
+    GetGlState().BindVertexArray(geo.vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, geo.vertexBuffer);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, numVerts * sizeof(fontVertex_t), (void*)verts);
-    glBindVertexArray(0);
+    const size_t size = numVerts * sizeof(fontVertex_t);
+    size_t bufferOffset = 0;
+    void* mapped = (size > 0) ? geo.MapDynamicVertices(size, bufferOffset) : nullptr;
+    if (mapped != nullptr) {
+        memcpy(mapped, verts, size);
+        geo.UnmapDynamicVertices();
+        SetFontVertexAttributes(bufferOffset);
+    } else if (size > 0) {
+        ALOGW("FontGeometryUpdate: failed to map %zu bytes of vertex data", size);
+    }
+    GetGlState().BindVertexArray(0);
     geo.indexCount = numIndices;
 }
 
@@ -90,8 +90,19 @@ class GlGeometry {
 
     // Create the VAO and vertex and index buffers from arrays of data.
     void Create(const VertexAttribs& attribs, const std::vector<TriangleIndex>& indices);
+    // Stream new vertex data for the existing indices. The first Update turns the vertex buffer
+    // into a ring of DYNAMIC_REGIONS regions that later updates write into in turn, so once the
+    // regions are big enough an update neither reallocates buffer storage nor waits on the GPU.
+    // The ring belongs to the vertex buffer, so a geometry and its copies write into the same
+    // regions, whichever of them is updated.
     void Update(const VertexAttribs& attribs, const bool updateBounds = true);
 
+    // Returns a write-only pointer to size bytes in the next streaming region of vertexBuffer,
+    // and in offset the byte offset that attribute pointers into that region must start from.
+    // vertexBuffer must be bound to GL_ARRAY_BUFFER until the matching UnmapDynamicVertices.
+    void* MapDynamicVertices(const size_t size, size_t& offset);
+    void UnmapDynamicVertices();
+
     // Free the buffers and VAO, assuming that they are strictly for this geometry.
     // We could save some overhead by packing an entire model into a single buffer, but
     // it would add more coupling to the structures.
@@ -101,6 +112,8 @@ class GlGeometry {
    public:
     static constexpr int32_t MAX_GEOMETRY_VERTICES = 1 << (sizeof(TriangleIndex) * 8);
     static constexpr int32_t MAX_GEOMETRY_INDICES = 1024 * 1024 * 3;
+    // Enough regions for the frames the GPU may still be reading plus the one being written.
+    static constexpr int32_t DYNAMIC_REGIONS = 3;
 
     static constexpr inline int32_t GetMaxGeometryVertices() {
         return MAX_GEOMETRY_VERTICES;
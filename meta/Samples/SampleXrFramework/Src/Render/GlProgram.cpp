@@ -33,6 +33,7 @@ Authors     :   John Carmack
 
 #include "OVR_Std.h"
 #include "Egl.h"
+#include "GlState.h"
 
 #include <string>
 
@@ -317,7 +318,7 @@ GlProgram GlProgram::Build(
         p.ModelMatrix.Binding = p.ModelMatrix.Location;
     }
 
-    glUseProgram(p.Program);
+    GetGlState().UseProgram(p.Program);
 
     for (int i = 0; i < numParms; ++i) {
         OVR_ASSERT(parms[i].Type != ovrProgramParmType::MAX);
@@ -363,14 +364,15 @@ GlProgram GlProgram::Build(
         }
     }
 
-    glUseProgram(0);
+    GetGlState().UseProgram(0);
 
     return p;
 }
 
 void GlProgram::Free(GlProgram& prog) {
-    glUseProgram(0);
+    GetGlState().UseProgram(0);
     if (prog.Program != 0) {
+        GetGlState().ProgramDeleted(prog.Program);
         glDeleteProgram(prog.Program);
     }
     if (prog.VertexShader != 0) {
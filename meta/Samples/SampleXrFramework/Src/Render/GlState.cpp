@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   GlState.cpp
+Content     :   Shadow of the GL state changed by the framework.
+Created     :   October 18, 2026
+Authors     :
+
+*************************************************************************************/
+
+#include "GlState.h"
+
+#include "Misc/Log.h"
+
+namespace OVRFW {
+
+bool ValidateGlState = false; // Do not check in set to true!
+
+// Returns true if anything was changed.
+static bool
+ChangeGpuState(const ovrGpuState& oldState, const ovrGpuState& newState, bool force = false) {
+    bool changed = false;
+    if (force || newState.blendEnable != oldState.blendEnable) {
+        if (newState.blendEnable) {
+            GL(glEnable(GL_BLEND));
+        } else {
+            GL(glDisable(GL_BLEND));
+        }
+        changed = true;
+    }
+    if (force || newState.blendEnable != oldState.blendEnable ||
+        newState.blendSrc != oldState.blendSrc || newState.blendDst != oldState.blendDst ||
+        newState.blendSrcAlpha != oldState.blendSrcAlpha ||
+        newState.blendDstAlpha != oldState.blendDstAlpha ||
+        newState.blendMode != oldState.blendMode ||
+        newState.blendModeAlpha != oldState.blendModeAlpha) {
+        if (newState.blendEnable == ovrGpuState::BLEND_ENABLE_SEPARATE) {
+            GL(glBlendFuncSeparate(
+                newState.blendSrc,
+                newState.blendDst,
+                newState.blendSrcAlpha,
+                newState.blendDstAlpha));
+            GL(glBlendEquationSeparate(newState.blendMode, newState.blendModeAlpha));
+        } else {
+            GL(glBlendFunc(newState.blendSrc, newState.blendDst));
+            GL(glBlendEquation(newState.blendMode));
+        }
+        changed = true;
+    }
+
+    if (force || newState.depthFunc != oldState.depthFunc) {
+        GL(glDepthFunc(newState.depthFunc));
+        changed = true;
+    }
+    if (force || newState.frontFace != oldState.frontFace) {
+        GL(glFrontFace(newState.frontFace));
+        changed = true;
+    }
+    if (force || newState.depthEnable != oldState.depthEnable) {
+        if (newState.depthEnable) {
+            GL(glEnable(GL_DEPTH_TEST));
+        } else {
+            GL(glDisable(GL_DEPTH_TEST));
+        }
+        changed = true;
+    }
+    if (force || newState.depthMaskEnable != oldState.depthMaskEnable) {
+        if (newState.depthMaskEnable) {
+            GL(glDepthMask(GL_TRUE));
+        } else {
+            GL(glDepthMask(GL_FALSE));
+        }
+        changed = true;
+    }
+    if (force || newState.colorMaskEnable[0] != oldState.colorMaskEnable[0] ||
+        newState.colorMaskEnable[1] != oldState.colorMaskEnable[1] ||
+        newState.colorMaskEnable[2] != oldState.colorMaskEnable[2] ||
+        newState.colorMaskEnable[3] != oldState.colorMaskEnable[3]) {
+        GL(glColorMask(
+            newState.colorMaskEnable[0] ? GL_TRUE : GL_FALSE,
+            newState.colorMaskEnable[1] ? GL_TRUE : GL_FALSE,
+            newState.colorMaskEnable[2] ? GL_TRUE : GL_FALSE,
+            newState.colorMaskEnable[3] ? GL_TRUE : GL_FALSE));
+        changed = true;
+    }
+    if (force || newState.polygonOffsetEnable != oldState.polygonOffsetEnable) {
+        if (newState.polygonOffsetEnable) {
+            GL(glEnable(GL_POLYGON_OFFSET_FILL));
+            GL(glPolygonOffset(1.0f, 1.0f));
+        } else {
+            GL(glDisable(GL_POLYGON_OFFSET_FILL));
+        }
+        changed = true;
+    }
+    if (force || newState.cullEnable != oldState.cullEnable) {
+        if (newState.cullEnable) {
+            GL(glEnable(GL_CULL_FACE));
+        } else {
+            GL(glDisable(GL_CULL_FACE));
+        }
+        changed = true;
+    }
+    if (force || newState.lineWidth != oldState.lineWidth) {
+        GL(glLineWidth(newState.lineWidth));
+        changed = true;
+    }
+    if (force || (newState.depthRange[0] != oldState.depthRange[0]) ||
+        (newState.depthRange[1] != oldState.depthRange[1])) {
+        GL(glDepthRangef(newState.depthRange[0], newState.depthRange[1]));
+        changed = true;
+    }
+#if !defined(GL_ES_VERSION_2_0) || GL_ES_VERSION_2_0 == 0
+    if (force || newState.polygonMode != oldState.polygonMode) {
+        GL(glPolygonMode(GL_FRONT_AND_BACK, newState.polygonMode));
+        changed = true;
+    }
+#endif
+    // extend as needed
+    return changed;
+}
+
+static int TextureTargetIndex(const GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D:
+            return 0;
+        case GL_TEXTURE_2D_ARRAY:
+            return 1;
+        case GL_TEXTURE_CUBE_MAP:
+            return 2;
+        case GL_TEXTURE_3D:
+            return 3;
+        case GL_TEXTURE_EXTERNAL_OES:
+            return 4;
+        default:
+            return -1;
+    }
+}
+
+ovrGlState::ovrGlState() {
+    Invalidate();
+}
+
+void ovrGlState::Invalidate() {
+    Program = UNKNOWN;
+    VertexArray = UNKNOWN;
+    ActiveUnit = -1;
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        for (int j = 0; j < NUM_TEXTURE_TARGETS; j++) {
+            Textures[i][j] = UNKNOWN;
+        }
+    }
+    for (int i = 0; i < MAX_UNIFORM_BUFFER_BINDINGS; i++) {
+        UniformBuffers[i] = UNKNOWN;
+    }
+    GpuStateValid = false;
+}
+
+bool ovrGlState::UseProgram(const GLuint program) {
+    if (Program == program) {
+        return false;
+    }
+    Program = program;
+    GL(glUseProgram(program));
+    return true;
+}
+
+bool ovrGlState::BindVertexArray(const GLuint vertexArray) {
+    if (VertexArray == vertexArray) {
+        return false;
+    }
+    VertexArray = vertexArray;
+    GL(glBindVertexArray(vertexArray));
+    return true;
+}
+
+bool ovrGlState::ActiveTexture(const int unit) {
+    if (ActiveUnit == unit) {
+        return false;
+    }
+    ActiveUnit = unit;
+    GL(glActiveTexture(GL_TEXTURE0 + unit));
+    return true;
+}
+
+GLuint* ovrGlState::TextureBinding(const int unit, const GLenum target) {
+    const int targetIndex = TextureTargetIndex(target);
+    if (unit < 0 || unit >= MAX_TEXTURE_UNITS || targetIndex < 0) {
+        return nullptr;
+    }
+    return &Textures[unit][targetIndex];
+}
+
+bool ovrGlState::BindTexture(const GLenum target, const GLuint texture) {
+    GLuint* binding = (ActiveUnit >= 0) ? TextureBinding(ActiveUnit, target) : nullptr;
+    if (binding != nullptr && *binding == texture) {
+        return false;
+    }
+    if (binding != nullptr) {
+        *binding = texture;
+    } else if (ActiveUnit < 0) {
+        // the texture goes to whichever unit is active, so the target is unknown on all of them
+        const int targetIndex = TextureTargetIndex(target);
+        for (int i = 0; i < MAX_TEXTURE_UNITS && targetIndex >= 0; i++) {
+            Textures[i][targetIndex] = UNKNOWN;
+        }
+    }
+    GL(glBindTexture(target, texture));
+    return true;
+}
+
+bool ovrGlState::BindTexture(const int unit, const GLenum target, const GLuint texture) {
+    GLuint* binding = TextureBinding(unit, target);
+    if (binding != nullptr && *binding == texture) {
+        return false;
+    }
+    ActiveTexture(unit);
+    if (binding != nullptr) {
+        *binding = texture;
+    }
+    GL(glBindTexture(target, texture));
+    return true;
+}
+
+bool ovrGlState::BindUniformBuffer(const int binding, const GLuint buffer) {
+    const bool tracked = binding >= 0 && binding < MAX_UNIFORM_BUFFER_BINDINGS;
+    if (tracked && UniformBuffers[binding] == buffer) {
+        return false;
+    }
+    if (tracked) {
+        UniformBuffers[binding] = buffer;
+    }
+    GL(glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer));
+    return true;
+}
+
+bool ovrGlState::SetGpuState(const ovrGpuState& state) {
+    const bool changed = ChangeGpuState(GpuState, state, !GpuStateValid);
+    GpuState = state;
+    GpuStateValid = true;
+    return changed;
+}
+
+void ovrGlState::ProgramDeleted(const GLuint program) {
+    if (Program == program) {
+        Program = UNKNOWN;
+    }
+}
+
+void ovrGlState::VertexArrayDeleted(const GLuint vertexArray) {
+    if (VertexArray == vertexArray) {
+        VertexArray = UNKNOWN;
+    }
+}
+
+void ovrGlState::TextureDeleted(const GLuint texture) {
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        for (int j = 0; j < NUM_TEXTURE_TARGETS; j++) {
+            if (Textures[i][j] == texture) {
+                Textures[i][j] = UNKNOWN;
+            }
+        }
+    }
+}
+
+void ovrGlState::BufferDeleted(const GLuint buffer) {
+    for (int i = 0; i < MAX_UNIFORM_BUFFER_BINDINGS; i++) {
+        if (UniformBuffers[i] == buffer) {
+            UniformBuffers[i] = UNKNOWN;
+        }
+    }
+}
+
+bool ovrGlState::Validate() const {
+    bool valid = true;
+    auto check = [&valid](const char* name, const GLint shadow, const GLint actual) {
+        if (shadow != actual) {
+            ALOGW("ovrGlState: %s is %d, the shadow has %d", name, actual, shadow);
+            valid = false;
+        }
+    };
+
+    GLint value = 0;
+    if (Program != UNKNOWN) {
+        glGetIntegerv(GL_CURRENT_PROGRAM, &value);
+        check("GL_CURRENT_PROGRAM", Program, value);
+    }
+    if (VertexArray != UNKNOWN) {
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &value);
+        check("GL_VERTEX_ARRAY_BINDING", VertexArray, value);
+    }
+
+    GLint activeTexture = GL_TEXTURE0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+    if (ActiveUnit >= 0) {
+        check("GL_ACTIVE_TEXTURE", GL_TEXTURE0 + ActiveUnit, activeTexture);
+    }
+    // the external target is left out since querying it needs the extension
+    static const GLenum bindingQueries[NUM_TEXTURE_TARGETS - 1] = {
+        GL_TEXTURE_BINDING_2D,
+        GL_TEXTURE_BINDING_2D_ARRAY,
+        GL_TEXTURE_BINDING_CUBE_MAP,
+        GL_TEXTURE_BINDING_3D};
+    for (int i = 0; i < MAX_TEXTURE_UNITS; i++) {
+        glActiveTexture(GL_TEXTURE0 + i);
+        for (int j = 0; j < NUM_TEXTURE_TARGETS - 1; j++) {
+            if (Textures[i][j] != UNKNOWN) {
+                glGetIntegerv(bindingQueries[j], &value);
+                check("texture binding", Textures[i][j], value);
+            }
+        }
+    }
+    glActiveTexture(activeTexture);
+
+#if !defined(WIN32)
+    for (int i = 0; i < MAX_UNIFORM_BUFFER_BINDINGS; i++) {
+        if (UniformBuffers[i] != UNKNOWN) {
+            glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, i, &value);
+            check("GL_UNIFORM_BUFFER_BINDING", UniformBuffers[i], value);
+        }
+    }
+#endif
+
+    if (GpuStateValid) {
+        check(
+            "GL_BLEND", GpuState.blendEnable != ovrGpuState::BLEND_DISABLE, glIsEnabled(GL_BLEND));
+        glGetIntegerv(GL_BLEND_SRC_RGB, &value);
+        check("GL_BLEND_SRC_RGB", GpuState.blendSrc, value);
+        glGetIntegerv(GL_BLEND_DST_RGB, &value);
+        check("GL_BLEND_DST_RGB", GpuState.blendDst, value);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, &value);
+        check("GL_BLEND_EQUATION_RGB", GpuState.blendMode, value);
+        if (GpuState.blendEnable == ovrGpuState::BLEND_ENABLE_SEPARATE) {
+            glGetIntegerv(GL_BLEND_SRC_ALPHA, &value);
+            check("GL_BLEND_SRC_ALPHA", GpuState.blendSrcAlpha, value);
+            glGetIntegerv(GL_BLEND_DST_ALPHA, &value);
+            check("GL_BLEND_DST_ALPHA", GpuState.blendDstAlpha, value);
+            glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &value);
+            check("GL_BLEND_EQUATION_ALPHA", GpuState.blendModeAlpha, value);
+        }
+        check("GL_DEPTH_TEST", GpuState.depthEnable, glIsEnabled(GL_DEPTH_TEST));
+        glGetIntegerv(GL_DEPTH_FUNC, &value);
+        check("GL_DEPTH_FUNC", GpuState.depthFunc, value);
+        GLboolean mask[4];
+        glGetBooleanv(GL_DEPTH_WRITEMASK, mask);
+        check("GL_DEPTH_WRITEMASK", GpuState.depthMaskEnable, mask[0]);
+        glGetBooleanv(GL_COLOR_WRITEMASK, mask);
+        for (int i = 0; i < 4; i++) {
+            check("GL_COLOR_WRITEMASK", GpuState.colorMaskEnable[i], mask[i]);
+        }
+        check("GL_CULL_FACE", GpuState.cullEnable, glIsEnabled(GL_CULL_FACE));
+        glGetIntegerv(GL_FRONT_FACE, &value);
+        check("GL_FRONT_FACE", GpuState.frontFace, value);
+        check(
+            "GL_POLYGON_OFFSET_FILL",
+            GpuState.polygonOffsetEnable,
+            glIsEnabled(GL_POLYGON_OFFSET_FILL));
+    }
+    return valid;
+}
+
+ovrGlState& GetGlState() {
+    // a GL context is only current on one thread at a time
+    static thread_local ovrGlState state;
+    return state;
+}
+
+} // namespace OVRFW
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   GlState.h
+Content     :   Shadow of the GL state changed by the framework.
+Created     :   October 18, 2026
+Authors     :
+
+*************************************************************************************/
+
+#pragma once
+
+#include "Egl.h"
+#include "GpuState.h"
+
+namespace OVRFW {
+
+//==============================================================
+// ovrGlState
+//
+// Remembers the program, vertex array, texture, uniform buffer and ovrGpuState bindings of a GL
+// context, so that calls which would not change anything never reach the driver. The framework
+// makes all of these calls through the shadow, which lets state carry over from one surface list
+// to the next instead of being reset around each one.
+//
+// Code that changes any of this state with GL directly must call Invalidate afterwards. Until
+// something sets it through the shadow, state is unknown and always reaches GL. XrApp invalidates
+// it at the start of each frame.
+class ovrGlState {
+   public:
+    static const int MAX_TEXTURE_UNITS = 16;
+    static const int MAX_UNIFORM_BUFFER_BINDINGS = 16;
+
+    ovrGlState();
+
+    // Forgets all state.
+    void Invalidate();
+
+    // Each returns true if it called GL, or false if GL already had the state.
+    bool UseProgram(const GLuint program);
+    bool BindVertexArray(const GLuint vertexArray);
+    bool ActiveTexture(const int unit);
+    // Binds to the active texture unit.
+    bool BindTexture(const GLenum target, const GLuint texture);
+    bool BindTexture(const int unit, const GLenum target, const GLuint texture);
+    bool BindUniformBuffer(const int binding, const GLuint buffer);
+    bool SetGpuState(const ovrGpuState& state);
+
+    // GL unbinds deleted objects and may hand their names out again, so whatever refers to them
+    // is forgotten.
+    void ProgramDeleted(const GLuint program);
+    void VertexArrayDeleted(const GLuint vertexArray);
+    void TextureDeleted(const GLuint texture);
+    void BufferDeleted(const GLuint buffer);
+
+    // Reads the state back from GL and logs whatever does not match the shadow. This stalls the
+    // pipeline, so it is only meant for debugging and tests.
+    bool Validate() const;
+
+   private:
+    static const GLuint UNKNOWN = 0xffffffff;
+    static const int NUM_TEXTURE_TARGETS = 5;
+
+    GLuint* TextureBinding(const int unit, const GLenum target);
+
+    GLuint Program;
+    GLuint VertexArray;
+    int ActiveUnit; // -1 if unknown
+    GLuint Textures[MAX_TEXTURE_UNITS][NUM_TEXTURE_TARGETS];
+    GLuint UniformBuffers[MAX_UNIFORM_BUFFER_BINDINGS];
+    ovrGpuState GpuState;
+    bool GpuStateValid;
+};
+
+// The state of the GL context current on the calling thread.
+ovrGlState& GetGlState();
+
+// Set this true to have RenderSurfaceList validate the shadow after every surface list.
+extern bool ValidateGlState;
+
+} // namespace OVRFW
@@ -28,6 +28,7 @@ Authors     :   John Carmack
 #include "GlTexture.h"
 
 #include "Egl.h"
+#include "GlState.h"
 #include "GL/gl_format.h"
 #include "Misc/Log.h"
 #include "CompilerUtils.h"
@@ -715,7 +716,7 @@ static GlTexture CreateGlTexture(
 
     GLuint texId;
     glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
+    GetGlState().BindTexture(GL_TEXTURE_2D, texId);
 
     const unsigned char* level = (const unsigned char*)data;
     const unsigned char* endOfBuffer = level + dataSize;
@@ -730,7 +731,7 @@ static GlTexture CreateGlTexture(
             level += 4;
             if (level > endOfBuffer) {
                 ALOG("%s: Image data exceeds buffer size", fileName);
-                glBindTexture(GL_TEXTURE_2D, 0);
+                GetGlState().BindTexture(GL_TEXTURE_2D, 0);
                 return GlTexture(texId, GL_TEXTURE_2D, width, height);
             }
         }
@@ -742,7 +743,7 @@ static GlTexture CreateGlTexture(
                 i,
                 mipSize,
                 ptrdiff_t(endOfBuffer - level));
-            glBindTexture(GL_TEXTURE_2D, 0);
+            GetGlState().BindTexture(GL_TEXTURE_2D, 0);
             return GlTexture(texId, GL_TEXTURE_2D, width, height);
         }
 
@@ -761,7 +762,7 @@ static GlTexture CreateGlTexture(
             level += 3 - ((mipSize + 3) % 4);
             if (level > endOfBuffer) {
                 ALOG("%s: Image data exceeds buffer size", fileName);
-                glBindTexture(GL_TEXTURE_2D, 0);
+                GetGlState().BindTexture(GL_TEXTURE_2D, 0);
                 return GlTexture(texId, GL_TEXTURE_2D, width, height);
             }
         }
@@ -788,7 +789,7 @@ static GlTexture CreateGlTexture(
 
     GLCheckErrorsWithTitle("Texture load");
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GetGlState().BindTexture(GL_TEXTURE_2D, 0);
 
     return GlTexture(texId, GL_TEXTURE_2D, width, height);
 }
@@ -831,7 +832,7 @@ static GlTexture CreateGlCubeTexture(
 
     GLuint texId;
     glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texId);
+    GetGlState().BindTexture(GL_TEXTURE_CUBE_MAP, texId);
 
     const unsigned char* level = (const unsigned char*)data;
     const unsigned char* endOfBuffer = level + dataSize;
@@ -844,7 +845,7 @@ static GlTexture CreateGlCubeTexture(
             level += 4;
             if (level > endOfBuffer) {
                 ALOG("%s: Image data exceeds buffer size: %p > %p", fileName, level, endOfBuffer);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+                GetGlState().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
                 return GlTexture(texId, GL_TEXTURE_CUBE_MAP, width, height);
             }
         }
@@ -857,7 +858,7 @@ static GlTexture CreateGlCubeTexture(
                     i,
                     mipSize,
                     ptrdiff_t(endOfBuffer - level));
-                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+                GetGlState().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
                 return GlTexture(texId, GL_TEXTURE_CUBE_MAP, width, height);
             }
 
@@ -889,7 +890,7 @@ static GlTexture CreateGlCubeTexture(
                 level += 3 - ((mipSize + 3) % 4);
                 if (level > endOfBuffer) {
                     ALOG("%s: Image data exceeds buffer size", fileName);
-                    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+                    GetGlState().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
                     return GlTexture(texId, GL_TEXTURE_CUBE_MAP, width, height);
                 }
             }
@@ -906,7 +907,7 @@ static GlTexture CreateGlCubeTexture(
 
     GLCheckErrorsWithTitle("Cube Texture load");
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    GetGlState().BindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
     return GlTexture(texId, GL_TEXTURE_CUBE_MAP, width, height);
 }
@@ -1627,7 +1628,7 @@ GlTexture LoadTextureFromBuffer(
                 false);
             free(image);
             if (!(flags & TEXTUREFLAG_NO_MIPMAPS)) {
-                glBindTexture(texId.target, texId.texture);
+                GetGlState().BindTexture(texId.target, texId.texture);
                 glGenerateMipmap(texId.target);
                 glTexParameteri(texId.target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
             }
@@ -1747,12 +1748,14 @@ GlTexture LoadTextureFromUri(
 
 void FreeTexture(GlTexture texId) {
     if (texId.texture) {
+        GetGlState().TextureDeleted(texId.texture);
         glDeleteTextures(1, &texId.texture);
     }
 }
 
 void DeleteTexture(GlTexture& texture) {
     if (texture.texture != 0) {
+        GetGlState().TextureDeleted(texture.texture);
         glDeleteTextures(1, &texture.texture);
         texture.texture = 0;
         texture.target = 0;
@@ -1762,63 +1765,63 @@ void DeleteTexture(GlTexture& texture) {
 }
 
 void MakeTextureClamped(GlTexture texId) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glTexParameteri(texId.target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(texId.target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 void MakeTextureRepeat(GlTexture texid) {
-    glBindTexture(texid.target, texid.texture);
+    GetGlState().BindTexture(texid.target, texid.texture);
     glTexParameteri(texid.target, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(texid.target, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glBindTexture(texid.target, 0);
+    GetGlState().BindTexture(texid.target, 0);
 }
 
 void MakeTextureLodClamped(GlTexture texId, int maxLod) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glTexParameteri(texId.target, GL_TEXTURE_MAX_LEVEL, maxLod);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 void MakeTextureTrilinear(GlTexture texId) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glTexParameteri(texId.target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(texId.target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 void MakeTextureLinearNearest(GlTexture texId) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glTexParameteri(texId.target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
     glTexParameteri(texId.target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 void MakeTextureLinear(GlTexture texId) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glTexParameteri(texId.target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(texId.target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 void MakeTextureNearest(GlTexture texId) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glTexParameteri(texId.target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(texId.target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 void MakeTextureAniso(GlTexture texId, float maxAniso) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glTexParameterf(texId.target, GL_TEXTURE_MAX_ANISOTROPY_EXT, maxAniso);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 void BuildTextureMipmaps(GlTexture texId) {
-    glBindTexture(texId.target, texId.texture);
+    GetGlState().BindTexture(texId.target, texId.texture);
     glGenerateMipmap(texId.target);
-    glBindTexture(texId.target, 0);
+    GetGlState().BindTexture(texId.target, 0);
 }
 
 } // namespace OVRFW
@@ -44,17 +44,36 @@ inline Vector3f GetViewMatrixForward(Matrix4f const& m) {
 
 namespace OVRFW {
 
+static_assert(ovrRibbon::POINTS_PER_BATCH == 512, "POINTS_PER_BATCH != 512");
+
+// Each instance is one quad between two consecutive points. Position.x selects the start or end
+// edge of the quad and Position.y the side of that edge.
 static const char* ribbonVertexShader = R"glsl(
+	struct RibbonPoint
+	{
+		highp vec4 PointAlpha;
+		highp vec4 EdgeScale;
+	};
+	layout(std140) uniform RibbonPoints
+	{
+		RibbonPoint Points[512];
+	} rp;
+	uniform highp vec3 EyeForward;
+	uniform highp float HalfWidth;
+	uniform lowp vec4 RibbonColor;
 	attribute vec4 Position;
-	attribute vec4 VertexColor;
-	attribute vec2 TexCoord;
 	varying lowp vec4 outColor;
 	varying highp vec2 oTexCoord;
 	void main()
 	{
-		gl_Position = TransformVertex( Position );
-		oTexCoord = TexCoord;
-		outColor = VertexColor;
+		RibbonPoint point = rp.Points[ gl_InstanceID + int( Position.x ) ];
+		highp vec3 dir = point.EdgeScale.xyz;
+		highp vec3 proj = normalize( dir - EyeForward * dot( dir, EyeForward ) );
+		highp vec3 edgeDir = cross( proj, EyeForward );
+		highp float halfWidth = HalfWidth * point.EdgeScale.w * ( 1.0 - 2.0 * Position.y );
+		gl_Position = TransformVertex( vec4( point.PointAlpha.xyz + edgeDir * halfWidth, 1.0 ) );
+		oTexCoord = Position.xy;
+		outColor = vec4( RibbonColor.rgb, point.PointAlpha.w );
 	}
 )glsl";
 
@@ -90,76 +109,74 @@ static GlTexture CreateRibbonTexture() {
 }
 
 ovrRibbon::ovrRibbon(const ovrPointList& pointList, const float width, const Vector4f& color)
-    : HalfWidth(width), Color(color) {
-    // initialize the surface geometry
-    const int maxPoints = pointList.GetMaxPoints();
-    const int maxQuads = (maxPoints - 1);
-    const int numVerts = maxQuads * 4;
-
-    VertexAttribs attr;
-    attr.position.resize(numVerts);
-    attr.color.resize(numVerts);
-    attr.uv0.resize(numVerts);
-
-    // the indices will never change
-    const int numIndices = maxQuads * 6;
-    std::vector<TriangleIndex> indices;
-    indices.resize(numIndices);
-    // so we can just set them up at initialization time
-    TriangleIndex v = 0;
-    for (int i = 0; i < maxQuads; ++i) {
-        indices[i * 6 + 0] = v + 0;
-        indices[i * 6 + 1] = v + 1;
-        indices[i * 6 + 2] = v + 2;
-        indices[i * 6 + 3] = v + 2;
-        indices[i * 6 + 4] = v + 1;
-        indices[i * 6 + 5] = v + 3;
-        v += 4;
-    }
-
-    Surface.geo.Create(attr, indices);
-    Surface.geo.primitiveType = GlGeometry::kPrimitiveTypeTriangles;
-    Surface.geo.indexCount = 0;
-
-    // initialize the rest of the surface
-    Surface.surfaceName = "ribbon";
-    Surface.numInstances = 1;
-
-    ovrGraphicsCommand& gc = Surface.graphicsCommand;
-
+    : HalfWidth(width), Color(color), EyeForward(0.0f, 0.0f, -1.0f) {
     Texture = CreateRibbonTexture();
-#if 1
-    gc.UniformData[0].Data = &Texture;
 
     constexpr auto parms = std::to_array<ovrProgramParm>({
         {.Name = "Texture0", .Type = ovrProgramParmType::TEXTURE_SAMPLED},
+        {.Name = "RibbonPoints", .Type = ovrProgramParmType::BUFFER_UNIFORM},
+        {.Name = "EyeForward", .Type = ovrProgramParmType::FLOAT_VECTOR3},
+        {.Name = "HalfWidth", .Type = ovrProgramParmType::FLOAT},
+        {.Name = "RibbonColor", .Type = ovrProgramParmType::FLOAT_VECTOR4},
     });
 
-    gc.Program =
+    Program =
         GlProgram::Build(ribbonVertexShader, ribbonFragmentShader, parms.data(), parms.size());
-#else
-    gc.Program = GlProgram::Build(ribbonVertexShader, ribbonFragmentShader, nullptr, 0);
-#endif
-
-    if (!Surface.graphicsCommand.Program.IsValid()) {
+    if (!Program.IsValid()) {
         ALOG("Error building ribbon gpu program");
     }
 
-    ovrGpuState& gpu = gc.GpuState;
-    gpu.depthEnable = true;
-    gpu.depthMaskEnable = false;
-    gpu.blendEnable = ovrGpuState::BLEND_ENABLE;
-    gpu.blendSrc = ovrGpuState::kGL_SRC_ALPHA;
-    gpu.blendDst = ovrGpuState::kGL_ONE_MINUS_SRC_ALPHA;
-    gpu.blendSrcAlpha = ovrGpuState::kGL_SRC_ALPHA;
-    gpu.blendDstAlpha = ovrGpuState::kGL_ONE_MINUS_SRC_ALPHA;
-    gpu.cullEnable = true;
+    // A single quad shared by every batch; its corners are expanded per point in the shader.
+    VertexAttribs attr;
+    attr.position = {
+        {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}};
+    const std::vector<TriangleIndex> indices = {0, 1, 2, 2, 1, 3};
+    GlGeometry quad(attr, indices);
+    quad.primitiveType = GlGeometry::kPrimitiveTypeTriangles;
+
+    const int maxPoints = pointList.GetMaxPoints();
+    const int maxQuads = std::max(maxPoints - 1, 1);
+    Points.reserve(maxPoints);
+
+    // Batches are never resized after this, so the uniform data pointers stay valid.
+    Batches.resize((maxQuads + POINTS_PER_BATCH - 2) / (POINTS_PER_BATCH - 1));
+    for (ovrRibbonBatch& batch : Batches) {
+        batch.PointBuffer.Create(
+            GLBUFFER_TYPE_UNIFORM, POINTS_PER_BATCH * sizeof(ovrRibbonPoint), nullptr);
+
+        ovrSurfaceDef& surf = batch.Surface;
+        surf.surfaceName = "ribbon";
+        surf.geo = quad;
+        surf.numInstances = 0;
+
+        ovrGraphicsCommand& gc = surf.graphicsCommand;
+        gc.Program = Program;
+        gc.UniformData[0].Data = &Texture;
+        gc.UniformData[1].Data = &batch.PointBuffer;
+        gc.UniformData[2].Data = &EyeForward;
+        gc.UniformData[3].Data = &HalfWidth;
+        gc.UniformData[4].Data = &Color;
+
+        ovrGpuState& gpu = gc.GpuState;
+        gpu.depthEnable = true;
+        gpu.depthMaskEnable = false;
+        gpu.blendEnable = ovrGpuState::BLEND_ENABLE;
+        gpu.blendSrc = ovrGpuState::kGL_SRC_ALPHA;
+        gpu.blendDst = ovrGpuState::kGL_ONE_MINUS_SRC_ALPHA;
+        gpu.blendSrcAlpha = ovrGpuState::kGL_SRC_ALPHA;
+        gpu.blendDstAlpha = ovrGpuState::kGL_ONE_MINUS_SRC_ALPHA;
+        gpu.cullEnable = true;
+    }
 }
 
 ovrRibbon::~ovrRibbon() {
     DeleteTexture(Texture);
-    GlProgram::Free(Surface.graphicsCommand.Program);
-    Surface.geo.Free();
+    GlProgram::Free(Program);
+    // The quad geometry is shared by all of the batches.
+    Batches[0].Surface.geo.Free();
+    for (ovrRibbonBatch& batch : Batches) {
+        batch.PointBuffer.Destroy();
+    }
 }
 
 void ovrRibbon::AddPoint(ovrPointList& pointList, const OVR::Vector3f& point) {
@@ -194,25 +211,8 @@ void ovrRibbon::Update(
         return;
     }
 
-    VertexAttribs attr;
     const int curPoints = pointList.GetCurPoints();
-    const int numVerts = (curPoints - 1) * 4;
-    attr.position.resize(numVerts);
-    attr.color.resize(numVerts);
-    attr.uv0.resize(numVerts);
-
-    Vector3f eyeFwd(GetViewMatrixForward(centerViewMatrix));
-    int numQuads = 0;
-    int curEdge = 1;
-    int curIdx = pointList.GetFirst();
-    int nextIdx = pointList.GetNext(curIdx);
-
-    auto getEdgeDir2 = [](const Vector3f& eyeFwd, const Vector3f& cur, const Vector3f& next) {
-        Vector3f dir = next - cur;
-        Vector3f proj = (dir - (eyeFwd * dir.Dot(eyeFwd))).Normalized();
-        Vector3f cross = proj.Cross(eyeFwd);
-        return cross;
-    };
+    EyeForward = GetViewMatrixForward(centerViewMatrix);
 
     auto calcAlpha = [](const int curEdge, const int curPoints, const bool invertAlpha) {
         if (invertAlpha) {
@@ -222,72 +222,55 @@ void ovrRibbon::Update(
         }
     };
 
-    const Vector3f* curPoint = &pointList.Get(curIdx);
-    const Vector3f* nextPoint = &pointList.Get(nextIdx);
-
-    Vector3f edgeDir = getEdgeDir2(eyeFwd, *curPoint, *nextPoint);
-    float alpha = calcAlpha(curEdge, pointList.GetCurPoints(), invertAlpha);
-
-    // cur edge
-    attr.position[(numQuads * 4) + 0] = *curPoint + (edgeDir * HalfWidth);
-    attr.color[(numQuads * 4) + 0] = Vector4f(Color.x, Color.y, Color.z, alpha);
-    attr.position[(numQuads * 4) + 1] = *curPoint - (edgeDir * HalfWidth);
-    attr.color[(numQuads * 4) + 1] = Vector4f(Color.x, Color.y, Color.z, alpha);
-    attr.uv0[(numQuads * 4) + 0] = OVR::Vector2f(0.0f, 0.0f);
-    attr.uv0[(numQuads * 4) + 1] = OVR::Vector2f(0.0f, 1.0f);
-
-    for (;;) {
-        curPoint = &pointList.Get(curIdx);
-        nextPoint = &pointList.Get(nextIdx);
+    // The first edge follows the first segment at full width; every later edge follows the
+    // segment leading into it and is narrowed by its alpha.
+    Points.resize(0);
+    const Vector3f* prevPoint = nullptr;
+    int curEdge = 1;
+    for (int curIdx = pointList.GetFirst(); curIdx >= 0; curIdx = pointList.GetNext(curIdx)) {
+        const Vector3f& curPoint = pointList.Get(curIdx);
+        const float alpha = calcAlpha(curEdge, curPoints, invertAlpha);
+
+        ovrRibbonPoint point;
+        point.PointAlpha = Vector4f(curPoint, alpha);
+        if (prevPoint == nullptr) {
+            const Vector3f& nextPoint = pointList.Get(pointList.GetNext(curIdx));
+            point.EdgeScale = Vector4f(nextPoint - curPoint, 1.0f);
+        } else {
+            point.EdgeScale = Vector4f(curPoint - *prevPoint, alpha);
+        }
+        Points.push_back(point);
 
-        edgeDir = getEdgeDir2(eyeFwd, *curPoint, *nextPoint);
+        prevPoint = &curPoint;
         curEdge++;
-        alpha = calcAlpha(curEdge, pointList.GetCurPoints(), invertAlpha);
-
-        // current quad next edge
-        attr.position[(numQuads * 4) + 2] = *nextPoint + (edgeDir * HalfWidth * alpha);
-        attr.color[(numQuads * 4) + 2] = Vector4f(Color.x, Color.y, Color.z, alpha);
-        attr.position[(numQuads * 4) + 3] = *nextPoint - (edgeDir * HalfWidth * alpha);
-        attr.color[(numQuads * 4) + 3] = Vector4f(Color.x, Color.y, Color.z, alpha);
-
-        attr.uv0[(numQuads * 4) + 2] = OVR::Vector2f(1.0f, 0.0f);
-        attr.uv0[(numQuads * 4) + 3] = OVR::Vector2f(1.0f, 1.0f);
+    }
 
-        curIdx = nextIdx;
-        nextIdx = pointList.GetNext(nextIdx);
-        if (nextIdx < 0) {
-            break;
+    // The segment ending at the newest point is not drawn, as with the CPU-built quads.
+    const int numQuads = static_cast<int>(Points.size()) - 2;
+    for (int b = 0; b < static_cast<int>(Batches.size()); ++b) {
+        ovrRibbonBatch& batch = Batches[b];
+        const int firstQuad = b * (POINTS_PER_BATCH - 1);
+        const int count = std::max(0, std::min(POINTS_PER_BATCH - 1, numQuads - firstQuad));
+        batch.Surface.numInstances = count;
+        if (count > 0) {
+            // Consecutive batches share the point between them.
+            batch.PointBuffer.Update((count + 1) * sizeof(ovrRibbonPoint), &Points[firstQuad]);
         }
-
-        numQuads++;
-
-        alpha = calcAlpha(curEdge, pointList.GetCurPoints(), invertAlpha);
-
-        // next quad first edge
-        attr.position[(numQuads * 4) + 0] = *nextPoint + (edgeDir * HalfWidth * alpha);
-        attr.color[(numQuads * 4) + 0] = Vector4f(Color.x, Color.y, Color.z, alpha);
-        attr.position[(numQuads * 4) + 1] = *nextPoint - (edgeDir * HalfWidth * alpha);
-        attr.color[(numQuads * 4) + 1] = Vector4f(Color.x, Color.y, Color.z, alpha);
-        attr.uv0[(numQuads * 4) + 0] = OVR::Vector2f(0.0f, 0.0f);
-        attr.uv0[(numQuads * 4) + 1] = OVR::Vector2f(0.0f, 1.0f);
     }
-
-    // ALOG( "Ribbon: %i points, %i edges, %i quads", pointList.GetCurPoints(), curEdge, numQuads );
-    // update the vertices
-    Surface.geo.Update(attr, false);
-    Surface.geo.indexCount = numQuads * 6;
 }
 
 void ovrRibbon::GenerateSurfaceList(std::vector<ovrDrawSurface>& surfaceList) const {
-    if (Surface.geo.indexCount == 0) {
-        return;
-    }
+    for (const ovrRibbonBatch& batch : Batches) {
+        if (batch.Surface.numInstances == 0) {
+            continue;
+        }
 
-    ovrDrawSurface drawSurf;
-    drawSurf.modelMatrix = Matrix4f::Identity();
-    drawSurf.surface = &Surface;
+        ovrDrawSurface drawSurf;
+        drawSurf.modelMatrix = Matrix4f::Identity();
+        drawSurf.surface = &batch.Surface;
 
-    surfaceList.push_back(drawSurf);
+        surfaceList.push_back(drawSurf);
+    }
 }
 
 } // namespace OVRFW
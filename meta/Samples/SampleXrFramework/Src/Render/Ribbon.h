@@ -32,6 +32,7 @@ Authors     :   Jonathan E. Wright
 #include "OVR_Math.h"
 #include "PointList.h"
 #include "SurfaceRender.h"
+#include "GlBuffer.h"
 
 namespace OVRFW {
 
@@ -51,11 +52,31 @@ class ovrRibbon {
     void SetWidth(const float width);
     void GenerateSurfaceList(std::vector<ovrDrawSurface>& surfaceList) const;
 
+    // Each quad is an instance reading its two edge points from a uniform buffer. 512 records
+    // of 32 bytes fill the 16KB minimum GL_MAX_UNIFORM_BLOCK_SIZE, so longer ribbons are split
+    // across several draws that share their boundary point.
+    static const int POINTS_PER_BATCH = 512;
+
    private:
+    // Per-point data expanded into a camera-facing edge by the vertex shader. Must match the
+    // RibbonPoint struct in ribbonVertexShader.
+    struct ovrRibbonPoint {
+        OVR::Vector4f PointAlpha; // xyz = point, w = alpha
+        OVR::Vector4f EdgeScale; // xyz = segment direction, w = width scale
+    };
+
+    struct ovrRibbonBatch {
+        ovrSurfaceDef Surface;
+        GlBuffer PointBuffer;
+    };
+
     float HalfWidth;
     OVR::Vector4f Color;
-    ovrSurfaceDef Surface;
+    OVR::Vector3f EyeForward;
+    std::vector<ovrRibbonBatch> Batches;
+    std::vector<ovrRibbonPoint> Points;
     GlTexture Texture;
+    GlProgram Program;
 };
 
 } // namespace OVRFW
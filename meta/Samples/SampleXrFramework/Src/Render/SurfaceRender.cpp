@@ -32,6 +32,7 @@ Authors     :   John Carmack
 #include "Misc/Log.h"
 
 #include "Egl.h"
+#include "GlState.h"
 #include "GlTexture.h"
 #include "GlProgram.h"
 #include "GlBuffer.h"
@@ -48,99 +49,14 @@ namespace OVRFW {
 
 bool LogRenderSurfaces = false; // Do not check in set to true!
 
-static void
-ChangeGpuState(const ovrGpuState oldState, const ovrGpuState newState, bool force = false) {
-    if (force || newState.blendEnable != oldState.blendEnable) {
-        if (newState.blendEnable) {
-            GL(glEnable(GL_BLEND));
-        } else {
-            GL(glDisable(GL_BLEND));
-        }
-    }
-    if (force || newState.blendEnable != oldState.blendEnable ||
-        newState.blendSrc != oldState.blendSrc || newState.blendDst != oldState.blendDst ||
-        newState.blendSrcAlpha != oldState.blendSrcAlpha ||
-        newState.blendDstAlpha != oldState.blendDstAlpha ||
-        newState.blendMode != oldState.blendMode ||
-        newState.blendModeAlpha != oldState.blendModeAlpha) {
-        if (newState.blendEnable == ovrGpuState::BLEND_ENABLE_SEPARATE) {
-            GL(glBlendFuncSeparate(
-                newState.blendSrc,
-                newState.blendDst,
-                newState.blendSrcAlpha,
-                newState.blendDstAlpha));
-            GL(glBlendEquationSeparate(newState.blendMode, newState.blendModeAlpha));
-        } else {
-            GL(glBlendFunc(newState.blendSrc, newState.blendDst));
-            GL(glBlendEquation(newState.blendMode));
-        }
-    }
-
-    if (force || newState.depthFunc != oldState.depthFunc) {
-        GL(glDepthFunc(newState.depthFunc));
-    }
-    if (force || newState.frontFace != oldState.frontFace) {
-        GL(glFrontFace(newState.frontFace));
-    }
-    if (force || newState.depthEnable != oldState.depthEnable) {
-        if (newState.depthEnable) {
-            GL(glEnable(GL_DEPTH_TEST));
-        } else {
-            GL(glDisable(GL_DEPTH_TEST));
-        }
-    }
-    if (force || newState.depthMaskEnable != oldState.depthMaskEnable) {
-        if (newState.depthMaskEnable) {
-            GL(glDepthMask(GL_TRUE));
-        } else {
-            GL(glDepthMask(GL_FALSE));
-        }
-    }
-    if (force || newState.colorMaskEnable[0] != oldState.colorMaskEnable[0] ||
-        newState.colorMaskEnable[1] != oldState.colorMaskEnable[1] ||
-        newState.colorMaskEnable[2] != oldState.colorMaskEnable[2] ||
-        newState.colorMaskEnable[3] != oldState.colorMaskEnable[3]) {
-        GL(glColorMask(
-            newState.colorMaskEnable[0] ? GL_TRUE : GL_FALSE,
-            newState.colorMaskEnable[1] ? GL_TRUE : GL_FALSE,
-            newState.colorMaskEnable[2] ? GL_TRUE : GL_FALSE,
-            newState.colorMaskEnable[3] ? GL_TRUE : GL_FALSE));
-    }
-    if (force || newState.polygonOffsetEnable != oldState.polygonOffsetEnable) {
-        if (newState.polygonOffsetEnable) {
-            GL(glEnable(GL_POLYGON_OFFSET_FILL));
-            GL(glPolygonOffset(1.0f, 1.0f));
-        } else {
-            GL(glDisable(GL_POLYGON_OFFSET_FILL));
-        }
-    }
-    if (force || newState.cullEnable != oldState.cullEnable) {
-        if (newState.cullEnable) {
-            GL(glEnable(GL_CULL_FACE));
-        } else {
-            GL(glDisable(GL_CULL_FACE));
-        }
-    }
-    if (force || newState.lineWidth != oldState.lineWidth) {
-        GL(glLineWidth(newState.lineWidth));
-    }
-    if (force || (newState.depthRange[0] != oldState.depthRange[0]) ||
-        (newState.depthRange[1] != oldState.depthRange[1])) {
-        GL(glDepthRangef(newState.depthRange[0], newState.depthRange[1]));
-    }
-#if !defined(GL_ES_VERSION_2_0) || GL_ES_VERSION_2_0 == 0
-    if (force || newState.polygonMode != oldState.polygonMode) {
-        GL(glPolygonMode(GL_FRONT_AND_BACK, newState.polygonMode));
-    }
-#endif
-    // extend as needed
-}
-
 ovrSurfaceRender::ovrSurfaceRender() : CurrentSceneMatricesIdx(0) {}
 
 ovrSurfaceRender::~ovrSurfaceRender() {}
 
 void ovrSurfaceRender::Init() {
+    // nothing is known about a new context
+    GetGlState().Invalidate();
+
     for (int i = 0; i < MAX_SCENEMATRICES_UBOS; i++) {
         SceneMatrices[i].Create(GLBUFFER_TYPE_UNIFORM, GlProgram::SCENE_MATRICES_UBO_SIZE, nullptr);
     }
@@ -221,14 +137,9 @@ ovrDrawCounters ovrSurfaceRender::RenderSurfaceList(
     const int eye) {
     assert(eye >= 0 && eye < GlProgram::MAX_VIEWS);
 
-    // Force the GPU state to a known value, then only set on changes
-    ovrGpuState currentGpuState;
-    ChangeGpuState(currentGpuState, currentGpuState, true /* force */);
-
-    // TODO: These should be range checked containers.
-    GLuint currentBuffers[ovrUniform::MAX_UNIFORMS] = {};
-    GLuint currentTextures[ovrUniform::MAX_UNIFORMS] = {};
-    GLuint currentProgramObject = 0;
+    // Only state that differs from what GL already has is set, including state left by the
+    // previous surface list.
+    ovrGlState& glState = GetGlState();
 
     const int sceneMatricesIdx =
         UpdateSceneMatrices(&viewMatrix, &projectionMatrix, GlProgram::MAX_VIEWS /* num eyes */);
@@ -242,16 +153,18 @@ ovrDrawCounters ovrSurfaceRender::RenderSurfaceList(
         const ovrGraphicsCommand& cmd = surfaceDef.graphicsCommand;
 
         if (cmd.Program.IsValid()) {
-            ChangeGpuState(currentGpuState, cmd.GpuState);
-            currentGpuState = cmd.GpuState;
+            if (glState.SetGpuState(cmd.GpuState)) {
+                counters.numStateChanges++;
+            } else {
+                counters.numRedundantStateChanges++;
+            }
             GLCheckErrorsWithTitle(surfaceDef.surfaceName.c_str());
 
             // update the program object
-            if (cmd.Program.Program != currentProgramObject) {
+            if (glState.UseProgram(cmd.Program.Program)) {
                 counters.numProgramBinds++;
-
-                currentProgramObject = cmd.Program.Program;
-                GL(glUseProgram(cmd.Program.Program));
+            } else {
+                counters.numRedundantBinds++;
             }
 
             // Update globally defined system level uniforms.
@@ -264,10 +177,13 @@ ovrDrawCounters ovrSurfaceRender::RenderSurfaceList(
                     cmd.Program.ModelMatrix.Location, 1, GL_TRUE, drawSurface.modelMatrix.M[0]));
 
                 if (cmd.Program.SceneMatrices.Location >= 0) {
-                    GL(glBindBufferBase(
-                        GL_UNIFORM_BUFFER,
-                        cmd.Program.SceneMatrices.Binding,
-                        SceneMatrices[sceneMatricesIdx].GetBuffer()));
+                    if (glState.BindUniformBuffer(
+                            cmd.Program.SceneMatrices.Binding,
+                            SceneMatrices[sceneMatricesIdx].GetBuffer())) {
+                        counters.numBufferBinds++;
+                    } else {
+                        counters.numRedundantBinds++;
+                    }
                 }
             }
 
@@ -375,13 +291,13 @@ ovrDrawCounters ovrSurfaceRender::RenderSurfaceList(
                             if (parmBinding >= 0 && cmd.UniformData[i].Data != nullptr) {
                                 const GlTexture& texture =
                                     *static_cast<GlTexture*>(cmd.UniformData[i].Data);
-                                if (currentTextures[parmBinding] != texture.texture) {
-                                    counters.numTextureBinds++;
-                                    currentTextures[parmBinding] = texture.texture;
-                                    GL(glActiveTexture(GL_TEXTURE0 + parmBinding));
-                                    GL(glBindTexture(
+                                if (glState.BindTexture(
+                                        parmBinding,
                                         texture.target ? texture.target : GL_TEXTURE_2D,
-                                        texture.texture));
+                                        texture.texture)) {
+                                    counters.numTextureBinds++;
+                                } else {
+                                    counters.numRedundantBinds++;
                                 }
                             }
                         } break;
@@ -390,11 +306,10 @@ ovrDrawCounters ovrSurfaceRender::RenderSurfaceList(
                             if (parmBinding >= 0 && cmd.UniformData[i].Data != nullptr) {
                                 const GlBuffer& buffer =
                                     *static_cast<GlBuffer*>(cmd.UniformData[i].Data);
-                                if (currentBuffers[parmBinding] != buffer.GetBuffer()) {
+                                if (glState.BindUniformBuffer(parmBinding, buffer.GetBuffer())) {
                                     counters.numBufferBinds++;
-                                    currentBuffers[parmBinding] = buffer.GetBuffer();
-                                    GL(glBindBufferBase(
-                                        GL_UNIFORM_BUFFER, parmBinding, buffer.GetBuffer()));
+                                } else {
+                                    counters.numRedundantBinds++;
                                 }
                             }
                         } break;
@@ -425,7 +340,11 @@ ovrDrawCounters ovrSurfaceRender::RenderSurfaceList(
 
         // Bind all the vertex and element arrays
         {
-            GL(glBindVertexArray(surfaceDef.geo.vertexArrayObject));
+            if (glState.BindVertexArray(surfaceDef.geo.vertexArrayObject)) {
+                counters.numVertexArrayBinds++;
+            } else {
+                counters.numRedundantBinds++;
+            }
 
             if (surfaceDef.numInstances > 1) {
                 GL(glDrawElementsInstanced(
@@ -446,12 +365,11 @@ ovrDrawCounters ovrSurfaceRender::RenderSurfaceList(
         GLCheckErrorsWithTitle(surfaceDef.surfaceName.c_str());
     }
 
-    // set the gpu state back to the default
-    ChangeGpuState(currentGpuState, ovrGpuState());
-    GL(glActiveTexture(GL_TEXTURE0));
-    GL(glBindTexture(GL_TEXTURE_2D, 0));
-    GL(glUseProgram(0));
-    GL(glBindVertexArray(0));
+    // The state is left as the last surface set it rather than reset to the defaults, since
+    // the shadow knows about it and the next surface list will most likely set it again.
+    if (ValidateGlState && !glState.Validate()) {
+        ALOGW("RenderSurfaceList: GL state does not match the shadow");
+    }
 
     return counters;
 }
@@ -68,7 +68,11 @@ struct ovrDrawCounters {
           numProgramBinds(0),
           numParameterUpdates(0),
           numTextureBinds(0),
-          numBufferBinds(0) {}
+          numBufferBinds(0),
+          numVertexArrayBinds(0),
+          numStateChanges(0),
+          numRedundantBinds(0),
+          numRedundantStateChanges(0) {}
 
     int numElements;
     int numDrawCalls;
@@ -76,6 +80,10 @@ struct ovrDrawCounters {
     int numParameterUpdates; // MVP, etc
     int numTextureBinds;
     int numBufferBinds;
+    int numVertexArrayBinds;
+    int numStateChanges; // surfaces whose ovrGpuState needed GL calls
+    int numRedundantBinds; // program, texture, buffer and vertex array binds GL already had
+    int numRedundantStateChanges; // surfaces whose ovrGpuState GL already had
 };
 
 struct ovrDrawSurface {
@@ -106,6 +114,7 @@ class ovrSurfaceRender {
 
     // Draws a list of surfaces in order.
     // Any sorting or culling should be performed before calling.
+    // GL state is set through GetGlState() and left as the last surface set it.
     ovrDrawCounters RenderSurfaceList(
         const std::vector<ovrDrawSurface>& surfaceList,
         const OVR::Matrix4f& viewMatrix,
@@ -31,6 +31,7 @@ Authors     :   John Carmack
 
 #include "Misc/Log.h"
 #include "Egl.h"
+#include "GlState.h"
 #include "GlTexture.h"
 
 namespace OVRFW {
@@ -50,12 +51,12 @@ SurfaceTexture::SurfaceTexture(JNIEnv* jni_)
     jni = jni_;
 
     glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_EXTERNAL_OES, GetTextureId());
+    GetGlState().BindTexture(GL_TEXTURE_EXTERNAL_OES, GetTextureId());
     glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameterf(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+    GetGlState().BindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
 
 #if defined(OVR_OS_ANDROID)
     static const char* className = "android/graphics/SurfaceTexture";
@@ -101,6 +102,7 @@ SurfaceTexture::SurfaceTexture(JNIEnv* jni_)
 
 SurfaceTexture::~SurfaceTexture() {
     if (textureId != 0) {
+        GetGlState().TextureDeleted(textureId);
         glDeleteTextures(1, &textureId);
         textureId = 0;
     }
@@ -28,6 +28,8 @@ Language    :   c++
 
 #include "XrApp.h"
 
+#include "Render/GlState.h"
+
 #if defined(ANDROID)
 #include <android/window.h>
 #include <openxr/openxr.h>
@@ -1403,10 +1405,9 @@ void XrApp::AppRenderEye(const OVRFW::ovrApplFrameIn& in, OVRFW::ovrRendererOutp
 // Called once per eye each frame for default renderer
 void XrApp::AppEyeGLStateSetup(const ovrApplFrameIn& in, const ovrFramebuffer* fb, int eye) {
     GL(glEnable(GL_SCISSOR_TEST));
-    GL(glDepthMask(GL_TRUE));
-    GL(glEnable(GL_DEPTH_TEST));
-    GL(glDepthFunc(GL_LEQUAL));
-    GL(glEnable(GL_CULL_FACE));
+    // The default state writes depth and color for the clear, and has depth test and culling
+    // enabled. It goes through the shadow since surface lists leave their last state behind.
+    GetGlState().SetGpuState(ovrGpuState());
     GL(glViewport(0, 0, fb->Width, fb->Height));
     GL(glScissor(0, 0, fb->Width, fb->Height));
     GL(glClearColor(BackgroundColor.x, BackgroundColor.y, BackgroundColor.z, BackgroundColor.w));
@@ -1626,6 +1627,9 @@ void XrApp::MainLoop(MainLoopContext& loopContext) {
         // allow apps to submit a layer before the world view projection layer (uncommon)
         PreProjectionAddLayer(Layers, LayerCount);
 
+        // App code and libraries may have changed GL state directly since the last frame
+        GetGlState().Invalidate();
+
         // Render the world-view layer (projection)
         AppRenderFrame(in, out);
         ProjectionAddLayer(Layers, LayerCount);
@@ -412,8 +412,14 @@ class XrApp {
     // Called when app re-gains focus
     virtual void AppGainedFocus();
     // Called once per frame to allow the application to render eye buffers.
+    // The GL state shadow (see GlState.h) is invalidated once, just before this call, and not
+    // between eyes or surface lists. Overrides that change state with GL directly must call
+    // GetGlState().Invalidate() before the next surface list is rendered.
     virtual void AppRenderFrame(const OVRFW::ovrApplFrameIn& in, OVRFW::ovrRendererOutput& out);
     // Called once per eye each frame for default renderer
+    // Surface lists no longer restore the default state when they finish, so raw GL issued after
+    // RenderSurfaceList inherits the blend, depth, cull, program and bindings the list left and
+    // must set whatever it relies on.
     virtual void
     AppRenderEye(const OVRFW::ovrApplFrameIn& in, OVRFW::ovrRendererOutput& out, int eye);
     // Called once per eye each frame for default renderer
@@ -0,0 +1,548 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   BeamRibbonImageTest.cpp
+Content     :   Renders beams and ribbons through ovrBeamRenderer and ovrRibbon, which expand
+                their quads in the vertex shader, and through the quads the CPU used to build for
+                them, and checks that the images match.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "FrameParams.h"
+#include "Render/BeamRenderer.h"
+#include "Render/GlState.h"
+#include "Render/GlTexture.h"
+#include "Render/PointList.h"
+#include "Render/Ribbon.h"
+#include "Render/SurfaceRender.h"
+
+#include "HostGlContext.h"
+
+using namespace OVRFW;
+using OVR::Matrix4f;
+using OVR::Vector2f;
+using OVR::Vector3f;
+using OVR::Vector4f;
+
+static int s_failures = 0;
+
+static int const IMAGE_SIZE = 512;
+
+// The vertex shader the beams and ribbons used for the quads the CPU built.
+static char const* LegacyVertexSrc = R"glsl(
+	attribute highp vec4 Position;
+	attribute lowp vec4 VertexColor;
+	attribute highp vec2 TexCoord;
+	varying lowp vec4 outColor;
+	varying highp vec2 oTexCoord;
+	void main()
+	{
+		gl_Position = TransformVertex( Position );
+		oTexCoord = TexCoord;
+		outColor = VertexColor;
+	}
+)glsl";
+
+// Copies of the fragment shaders in BeamRenderer.cpp and Ribbon.cpp, which did not change.
+static char const* BeamParametricFragmentSrc = R"glsl(
+	precision highp float;
+	varying lowp vec4 outColor;
+	varying highp vec2 oTexCoord;
+	void main()
+	{
+		float forwardFade = 1.0 - oTexCoord.y * oTexCoord.y;
+		float sideFade = 1.0 - abs((oTexCoord.x - 0.5) * 2.0);
+		float r = sideFade * forwardFade;
+		gl_FragColor = outColor * vec4(r,r,r,r);
+	}
+)glsl";
+
+static char const* RibbonFragmentSrc = R"glsl(
+	uniform sampler2D Texture0;
+	varying lowp vec4 outColor;
+	varying highp vec2 oTexCoord;
+	void main()
+	{
+		gl_FragColor = outColor * texture2D( Texture0, oTexCoord );
+	}
+)glsl";
+
+// The same texture as CreateRibbonTexture in Ribbon.cpp.
+static GlTexture CreateRibbonTexture() {
+    int const size = 64;
+    std::vector<uint32_t> tex(size * size);
+    for (int y = 0; y < size; ++y) {
+        uint32_t const alpha = (y < 16) ? y * 16 : (y > 48) ? (size - y) * 16 : 0xff;
+        for (int x = 0; x < size; ++x) {
+            tex[y * size + x] = (alpha << 24) | 0xffffff;
+        }
+    }
+    return LoadRGBATextureFromMemory(reinterpret_cast<uint8_t*>(tex.data()), size, size, false);
+}
+
+// An RGBA8 color buffer with a depth buffer to render the images into.
+class OffscreenImage {
+   public:
+    OffscreenImage() : Framebuffer(0), Color(0), Depth(0) {
+        glGenRenderbuffers(1, &Color);
+        glBindRenderbuffer(GL_RENDERBUFFER, Color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, IMAGE_SIZE, IMAGE_SIZE);
+        glGenRenderbuffers(1, &Depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, Depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, IMAGE_SIZE, IMAGE_SIZE);
+        glGenFramebuffers(1, &Framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, Framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, Color);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, Depth);
+    }
+
+    ~OffscreenImage() {
+        glDeleteFramebuffers(1, &Framebuffer);
+        glDeleteRenderbuffers(1, &Color);
+        glDeleteRenderbuffers(1, &Depth);
+    }
+
+    bool IsComplete() const {
+        glBindFramebuffer(GL_FRAMEBUFFER, Framebuffer);
+        return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    // Binds and clears the image. The clear goes around the GL state shadow, so it is
+    // invalidated afterwards.
+    void Begin() const {
+        glBindFramebuffer(GL_FRAMEBUFFER, Framebuffer);
+        glViewport(0, 0, IMAGE_SIZE, IMAGE_SIZE);
+        glDisable(GL_SCISSOR_TEST);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthMask(GL_TRUE);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClearDepthf(1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        GetGlState().Invalidate();
+    }
+
+    std::vector<uint8_t> Read() const {
+        std::vector<uint8_t> pixels(IMAGE_SIZE * IMAGE_SIZE * 4);
+        glBindFramebuffer(GL_FRAMEBUFFER, Framebuffer);
+        glReadPixels(0, 0, IMAGE_SIZE, IMAGE_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        return pixels;
+    }
+
+    OffscreenImage(OffscreenImage const&) = delete;
+    OffscreenImage& operator=(OffscreenImage const&) = delete;
+
+   private:
+    GLuint Framebuffer;
+    GLuint Color;
+    GLuint Depth;
+};
+
+struct Camera {
+    Matrix4f View;
+    Matrix4f Projection;
+
+    // Where a world position lands in the image, in pixels.
+    Vector2f Project(Vector3f const& p) const {
+        Vector4f const clip = Projection.Transform(View.Transform(Vector4f(p.x, p.y, p.z, 1.0f)));
+        return Vector2f(
+            (clip.x / clip.w * 0.5f + 0.5f) * IMAGE_SIZE,
+            (clip.y / clip.w * 0.5f + 0.5f) * IMAGE_SIZE);
+    }
+};
+
+static bool IsCovered(std::vector<uint8_t> const& image, int const x, int const y) {
+    uint8_t const* p = &image[(y * IMAGE_SIZE + x) * 4];
+    return (p[0] | p[1] | p[2] | p[3]) != 0;
+}
+
+// Whether anything was drawn within a few pixels of a position.
+static bool IsCoveredNear(std::vector<uint8_t> const& image, Vector2f const& pos) {
+    int const radius = 2;
+    for (int y = int(pos.y) - radius; y <= int(pos.y) + radius; ++y) {
+        for (int x = int(pos.x) - radius; x <= int(pos.x) + radius; ++x) {
+            if (x >= 0 && y >= 0 && x < IMAGE_SIZE && y < IMAGE_SIZE && IsCovered(image, x, y)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// The quads are expanded from the same inputs, but the shader and the CPU round differently, so
+// pixels along the edges of the quads may differ. Anything more than that is a failure.
+static void CheckSameImage(
+    std::vector<uint8_t> const& actual,
+    std::vector<uint8_t> const& expected,
+    char const* what) {
+    int covered = 0;
+    int different = 0;
+    int maxDifference = 0;
+    for (int i = 0; i < IMAGE_SIZE * IMAGE_SIZE; ++i) {
+        uint8_t const* a = &actual[i * 4];
+        uint8_t const* e = &expected[i * 4];
+        if ((a[0] | a[1] | a[2] | a[3] | e[0] | e[1] | e[2] | e[3]) == 0) {
+            continue;
+        }
+        covered++;
+        int difference = 0;
+        for (int c = 0; c < 4; ++c) {
+            difference = std::max(difference, abs(int(a[c]) - int(e[c])));
+        }
+        maxDifference = std::max(maxDifference, difference);
+        if (difference > 2) {
+            different++;
+        }
+    }
+    printf(
+        "%s: %d pixels drawn, %d differ, by at most %d\n",
+        what,
+        covered,
+        different,
+        maxDifference);
+    if (covered == 0) {
+        printf("FAIL %s: nothing was drawn\n", what);
+        s_failures++;
+    } else if (different * 200 > covered) {
+        printf("FAIL %s: more than 0.5%% of the pixels differ\n", what);
+        s_failures++;
+    }
+}
+
+// Draws CPU-built quads the way ovrBeamRenderer and ovrRibbon used to.
+static void DrawLegacyQuads(
+    ovrSurfaceRender& surfaceRender,
+    Camera const& camera,
+    VertexAttribs const& attr,
+    int const numQuads,
+    std::vector<TriangleIndex> const& quadIndices,
+    GlProgram const& program,
+    ovrGpuState const& gpuState,
+    GlTexture* texture) {
+    std::vector<TriangleIndex> indices;
+    for (int q = 0; q < static_cast<int>(attr.position.size()) / 4; ++q) {
+        for (TriangleIndex const index : quadIndices) {
+            indices.push_back(static_cast<TriangleIndex>(q * 4 + index));
+        }
+    }
+
+    ovrSurfaceDef surf;
+    surf.surfaceName = "legacy";
+    surf.geo.Create(attr, indices);
+    surf.geo.indexCount = numQuads * 6;
+    surf.graphicsCommand.Program = program;
+    surf.graphicsCommand.GpuState = gpuState;
+    surf.graphicsCommand.UniformData[0].Data = texture;
+
+    std::vector<ovrDrawSurface> surfaceList;
+    surfaceList.push_back(ovrDrawSurface(Matrix4f::Identity(), &surf));
+    surfaceRender.RenderSurfaceList(surfaceList, camera.View, camera.Projection, 0);
+    surf.geo.Free();
+}
+
+//==============================================================================================
+// Beams
+
+struct BeamParms {
+    float Width;
+    Vector3f Start;
+    Vector3f End;
+    Vector4f Color;
+};
+
+// The quads FrameInternal built before the beams were instanced.
+static VertexAttribs LegacyBeamQuads(std::vector<BeamParms> const& beams, Vector3f const& viewPos) {
+    VertexAttribs attr;
+    for (BeamParms const& beam : beams) {
+        Vector3f const beamVector = beam.End - beam.Start;
+        Vector3f const beamCenter = beam.Start + beamVector * 0.5f;
+        Vector3f const cross =
+            beamVector.Normalized().Cross(beamCenter - viewPos).Normalized() * beam.Width * 0.5f;
+        Vector4f const color = EaseFunctions[ovrEaseFunc::NONE](beam.Color, 0.0f);
+
+        attr.position.push_back(beam.Start + cross);
+        attr.position.push_back(beam.Start - cross);
+        attr.position.push_back(beam.End + cross);
+        attr.position.push_back(beam.End - cross);
+        for (int i = 0; i < 4; ++i) {
+            attr.color.push_back(color);
+        }
+        attr.uv0.push_back(Vector2f(0.0f, 0.0f));
+        attr.uv0.push_back(Vector2f(1.0f, 0.0f));
+        attr.uv0.push_back(Vector2f(0.0f, 1.0f));
+        attr.uv0.push_back(Vector2f(1.0f, 1.0f));
+    }
+    return attr;
+}
+
+// More beams than fit one batch, so the second batch is drawn too. The beams are parametric; the
+// textured ones only differ in the fragment shader, which did not change.
+static void TestBeams(ovrSurfaceRender& surfaceRender, Camera const& camera) {
+    int const numBeams = ovrBeamRenderer::BEAMS_PER_BATCH + 44;
+    std::mt19937 random(41);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> positive(0.2f, 1.0f);
+    std::vector<BeamParms> beams(numBeams);
+    for (BeamParms& beam : beams) {
+        beam.Width = positive(random) * 0.08f;
+        beam.Start = Vector3f(unit(random), unit(random), unit(random));
+        beam.End = Vector3f(unit(random), unit(random), unit(random));
+        beam.Color =
+            Vector4f(positive(random), positive(random), positive(random), positive(random));
+    }
+
+    ovrApplFrameIn frame;
+    ovrBeamRenderer beamRenderer;
+    beamRenderer.Init(numBeams, false);
+    for (BeamParms const& beam : beams) {
+        if (!beamRenderer.AddBeam(frame, beam.Width, beam.Start, beam.End, beam.Color).IsValid()) {
+            printf("FAIL could not add a beam\n");
+            s_failures++;
+            return;
+        }
+    }
+    beamRenderer.Frame(frame, camera.View);
+
+    OffscreenImage instanced;
+    instanced.Begin();
+    std::vector<ovrDrawSurface> surfaceList;
+    beamRenderer.Render(surfaceList);
+    if (surfaceList.size() != 2) {
+        printf("FAIL %d beams were drawn in %zu batches\n", numBeams, surfaceList.size());
+        s_failures++;
+    }
+    surfaceRender.RenderSurfaceList(surfaceList, camera.View, camera.Projection, 0);
+
+    ovrGpuState gpuState;
+    gpuState.depthEnable = gpuState.depthMaskEnable = false;
+    gpuState.blendEnable = ovrGpuState::BLEND_ENABLE;
+    gpuState.blendSrc = ovrGpuState::kGL_SRC_ALPHA;
+    gpuState.blendDst = ovrGpuState::kGL_ONE;
+    gpuState.cullEnable = false;
+    GlProgram program = GlProgram::Build(LegacyVertexSrc, BeamParametricFragmentSrc, nullptr, 0);
+
+    OffscreenImage legacy;
+    legacy.Begin();
+    VertexAttribs const attr = LegacyBeamQuads(beams, camera.View.Inverted().GetTranslation());
+    DrawLegacyQuads(
+        surfaceRender, camera, attr, numBeams, {0, 1, 3, 0, 3, 2}, program, gpuState, nullptr);
+
+    CheckSameImage(instanced.Read(), legacy.Read(), "beams");
+    GlProgram::Free(program);
+    beamRenderer.Shutdown();
+}
+
+//==============================================================================================
+// Ribbons
+
+// The quads ovrRibbon::Update built before the ribbon was instanced. Returns the number of quads
+// it drew, which leaves out the segment ending at the newest point.
+static int LegacyRibbonQuads(
+    ovrPointList const& pointList,
+    Vector3f const& eyeFwd,
+    float const halfWidth,
+    Vector4f const& color,
+    bool const invertAlpha,
+    VertexAttribs& attr) {
+    int const curPoints = pointList.GetCurPoints();
+    attr.position.resize((curPoints - 1) * 4);
+    attr.color.resize((curPoints - 1) * 4);
+    attr.uv0.resize((curPoints - 1) * 4);
+
+    auto getEdgeDir = [&eyeFwd](Vector3f const& cur, Vector3f const& next) {
+        Vector3f const dir = next - cur;
+        return (dir - (eyeFwd * dir.Dot(eyeFwd))).Normalized().Cross(eyeFwd);
+    };
+    auto calcAlpha = [curPoints, invertAlpha](int const curEdge) {
+        if (invertAlpha) {
+            return 1.0f - std::clamp<float>((float)(curEdge >> 1) / (float)(curPoints), 0.0f, 1.0f);
+        }
+        return std::clamp<float>((float)curEdge / (float)(curPoints >> 1), 0.0f, 1.0f);
+    };
+    auto setEdge = [&](int const vertex, Vector3f const& point, Vector3f const& offset,
+                       float const alpha, float const u) {
+        Vector4f const edgeColor(color.x, color.y, color.z, alpha);
+        attr.position[vertex + 0] = point + offset;
+        attr.color[vertex + 0] = edgeColor;
+        attr.uv0[vertex + 0] = Vector2f(u, 0.0f);
+        attr.position[vertex + 1] = point - offset;
+        attr.color[vertex + 1] = edgeColor;
+        attr.uv0[vertex + 1] = Vector2f(u, 1.0f);
+    };
+
+    int numQuads = 0;
+    int curEdge = 1;
+    int curIdx = pointList.GetFirst();
+    int nextIdx = pointList.GetNext(curIdx);
+    Vector3f edgeDir = getEdgeDir(pointList.Get(curIdx), pointList.Get(nextIdx));
+    setEdge(0, pointList.Get(curIdx), edgeDir * halfWidth, calcAlpha(curEdge), 0.0f);
+    for (;;) {
+        Vector3f const& nextPoint = pointList.Get(nextIdx);
+        edgeDir = getEdgeDir(pointList.Get(curIdx), nextPoint);
+        curEdge++;
+        float const alpha = calcAlpha(curEdge);
+        setEdge(numQuads * 4 + 2, nextPoint, edgeDir * halfWidth * alpha, alpha, 1.0f);
+
+        curIdx = nextIdx;
+        nextIdx = pointList.GetNext(nextIdx);
+        if (nextIdx < 0) {
+            break;
+        }
+        numQuads++;
+        setEdge(numQuads * 4 + 0, nextPoint, edgeDir * halfWidth * alpha, alpha, 0.0f);
+    }
+    return numQuads;
+}
+
+// A ribbon across three batches. The points of each batch wind around a small circle of their
+// own, so the first quad of each later batch, which starts at the point the batches share, and the
+// newest segment are long jumps across empty parts of the image.
+static void TestRibbon(
+    ovrSurfaceRender& surfaceRender,
+    Camera const& camera,
+    ovrPointList& pointList,
+    bool const invertAlpha,
+    char const* what) {
+    int const quadsPerBatch = ovrRibbon::POINTS_PER_BATCH - 1;
+    Vector3f const centers[] = {
+        Vector3f(-0.6f, 0.5f, 0.0f), Vector3f(0.6f, 0.5f, 0.0f), Vector3f(-0.6f, -0.5f, 0.0f)};
+    int const numPoints = pointList.GetMaxPoints();
+    for (int i = 0; i < numPoints - 1; ++i) {
+        int const circle = std::min(std::max(i - 1, 0) / quadsPerBatch, 2);
+        float const angle = i * 0.37f;
+        float const radius = 0.1f + 0.15f * float(i % quadsPerBatch) / quadsPerBatch;
+        pointList.AddToTail(centers[circle] + Vector3f(cosf(angle), sinf(angle), 0.0f) * radius);
+    }
+    pointList.AddToTail(Vector3f(0.6f, -0.5f, 0.0f));
+
+    float const halfWidth = 0.02f;
+    Vector4f const color(1.0f, 0.5f, 0.25f, 1.0f);
+    ovrRibbon ribbon(pointList, halfWidth, color);
+    ribbon.Update(pointList, camera.View, invertAlpha);
+
+    OffscreenImage instanced;
+    instanced.Begin();
+    std::vector<ovrDrawSurface> surfaceList;
+    ribbon.GenerateSurfaceList(surfaceList);
+    if (surfaceList.size() != 3) {
+        printf(
+            "FAIL %s: %d points were drawn in %zu batches\n",
+            what,
+            numPoints,
+            surfaceList.size());
+        s_failures++;
+    }
+    surfaceRender.RenderSurfaceList(surfaceList, camera.View, camera.Projection, 0);
+    std::vector<uint8_t> const instancedImage = instanced.Read();
+
+    ovrGpuState gpuState;
+    gpuState.depthEnable = true;
+    gpuState.depthMaskEnable = false;
+    gpuState.blendEnable = ovrGpuState::BLEND_ENABLE;
+    gpuState.blendSrc = ovrGpuState::kGL_SRC_ALPHA;
+    gpuState.blendDst = ovrGpuState::kGL_ONE_MINUS_SRC_ALPHA;
+    gpuState.blendSrcAlpha = ovrGpuState::kGL_SRC_ALPHA;
+    gpuState.blendDstAlpha = ovrGpuState::kGL_ONE_MINUS_SRC_ALPHA;
+    gpuState.cullEnable = true;
+    ovrProgramParm const parms[] = {
+        {.Name = "Texture0", .Type = ovrProgramParmType::TEXTURE_SAMPLED},
+    };
+    GlProgram program = GlProgram::Build(LegacyVertexSrc, RibbonFragmentSrc, parms, 1);
+    GlTexture texture = CreateRibbonTexture();
+
+    OffscreenImage legacy;
+    legacy.Begin();
+    VertexAttribs attr;
+    Vector3f const eyeFwd =
+        Vector3f(-camera.View.M[2][0], -camera.View.M[2][1], -camera.View.M[2][2]).Normalized();
+    int const numQuads = LegacyRibbonQuads(pointList, eyeFwd, halfWidth, color, invertAlpha, attr);
+    DrawLegacyQuads(
+        surfaceRender, camera, attr, numQuads, {0, 1, 2, 2, 1, 3}, program, gpuState, &texture);
+    std::vector<uint8_t> const legacyImage = legacy.Read();
+
+    CheckSameImage(instancedImage, legacyImage, what);
+
+    // The jumps between the circles are drawn, and the newest segment is not.
+    std::vector<Vector3f> points;
+    for (int i = pointList.GetFirst(); i >= 0; i = pointList.GetNext(i)) {
+        points.push_back(pointList.Get(i));
+    }
+    for (int quad = quadsPerBatch; quad < numQuads; quad += quadsPerBatch) {
+        Vector2f const middle = camera.Project((points[quad] + points[quad + 1]) * 0.5f);
+        if (!IsCoveredNear(instancedImage, middle) || !IsCoveredNear(legacyImage, middle)) {
+            printf("FAIL %s: the first quad of the batch at quad %d is missing\n", what, quad);
+            s_failures++;
+        }
+    }
+    Vector2f const newest = camera.Project((points[numPoints - 2] + points[numPoints - 1]) * 0.5f);
+    if (IsCoveredNear(instancedImage, newest) || IsCoveredNear(legacyImage, newest)) {
+        printf("FAIL %s: the segment ending at the newest point is drawn\n", what);
+        s_failures++;
+    }
+
+    GlProgram::Free(program);
+    DeleteTexture(texture);
+}
+
+int main() {
+    HostGlContext gl;
+    if (!gl.IsCurrent()) {
+        printf("FAIL could not create a GL context\n");
+        return 1;
+    }
+    {
+        OffscreenImage image;
+        if (!image.IsComplete()) {
+            printf("FAIL the offscreen framebuffer is not complete\n");
+            return 1;
+        }
+    }
+
+    ovrSurfaceRender surfaceRender;
+    surfaceRender.Init();
+    ValidateGlState = true;
+
+    Camera camera;
+    camera.View = Matrix4f::LookAtRH(
+        Vector3f(0.0f, 0.0f, 3.0f), Vector3f(0.0f, 0.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f));
+    camera.Projection = Matrix4f::PerspectiveRH(OVR::DegreeToRad(60.0f), 1.0f, 0.1f, 100.0f);
+
+    TestBeams(surfaceRender, camera);
+    // a ribbon that fades in from its tail, and one that fades out
+    int const numPoints = 3 * (ovrRibbon::POINTS_PER_BATCH - 1) + 1;
+    ovrPointList_Vector fadeIn(numPoints);
+    TestRibbon(surfaceRender, camera, fadeIn, false, "ribbon fading in");
+    ovrPointList_Vector fadeOut(numPoints);
+    TestRibbon(surfaceRender, camera, fadeOut, true, "ribbon fading out");
+
+    surfaceRender.Shutdown();
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
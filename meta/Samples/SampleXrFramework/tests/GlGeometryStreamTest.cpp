@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   GlGeometryStreamTest.cpp
+Content     :   Counts the GL calls GlGeometry makes to stream vertex updates: once the ring is
+                big enough, updates must not reallocate buffer storage, and a geometry and its
+                copies must take turns through the same regions.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "Render/Egl.h"
+#include "Render/GlGeometry.h"
+#include "Render/GlProgram.h"
+#include "Render/SurfaceRender.h"
+
+#include "HostGlContext.h"
+
+using namespace OVRFW;
+using OVR::Matrix4f;
+using OVR::Vector3f;
+using OVR::Vector4f;
+
+// The test links with --wrap for these, so every call the framework makes comes through here.
+static int s_bufferDataCalls = 0;
+static std::vector<GLintptr> s_mappedOffsets;
+
+extern "C" {
+void __real_glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+void* __real_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+
+void __wrap_glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    s_bufferDataCalls++;
+    __real_glBufferData(target, size, data, usage);
+}
+
+void*
+__wrap_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+    s_mappedOffsets.push_back(offset);
+    return __real_glMapBufferRange(target, offset, length, access);
+}
+}
+
+static int s_failures = 0;
+
+static void Check(bool const condition, char const* what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        s_failures++;
+    }
+}
+
+static char const* VertexSrc = R"glsl(
+	attribute highp vec4 Position;
+	attribute lowp vec4 VertexColor;
+	varying lowp vec4 outColor;
+	void main()
+	{
+		gl_Position = TransformVertex( Position );
+		outColor = VertexColor;
+	}
+)glsl";
+
+static char const* FragmentSrc = R"glsl(
+	varying lowp vec4 outColor;
+	void main()
+	{
+		gl_FragColor = outColor;
+	}
+)glsl";
+
+static VertexAttribs MakeQuads(int const numQuads, float const z) {
+    VertexAttribs attr;
+    for (int q = 0; q < numQuads; ++q) {
+        float const x = -1.0f + 2.0f * q / numQuads;
+        attr.position.push_back(Vector3f(x, -1.0f, z));
+        attr.position.push_back(Vector3f(x + 0.1f, -1.0f, z));
+        attr.position.push_back(Vector3f(x, 1.0f, z));
+        attr.position.push_back(Vector3f(x + 0.1f, 1.0f, z));
+        for (int i = 0; i < 4; ++i) {
+            attr.color.push_back(Vector4f(1.0f, 0.5f, 0.25f, 1.0f));
+        }
+    }
+    return attr;
+}
+
+static std::vector<TriangleIndex> QuadIndices(int const numQuads) {
+    std::vector<TriangleIndex> indices;
+    for (int q = 0; q < numQuads; ++q) {
+        for (int const i : {0, 1, 3, 0, 3, 2}) {
+            indices.push_back(static_cast<TriangleIndex>(q * 4 + i));
+        }
+    }
+    return indices;
+}
+
+// Draws a frame of each surface, so that the regions are read by the GPU before they are
+// written again.
+static void DrawFrame(ovrSurfaceRender& surfaceRender, std::vector<ovrSurfaceDef const*> surfaces) {
+    std::vector<ovrDrawSurface> surfaceList;
+    for (ovrSurfaceDef const* surface : surfaces) {
+        surfaceList.push_back(ovrDrawSurface(Matrix4f::Identity(), surface));
+    }
+    surfaceRender.RenderSurfaceList(surfaceList, Matrix4f::Identity(), Matrix4f::Identity(), 0);
+}
+
+// Each map must write the region after the one before it, whichever copy was updated.
+static void CheckRegionsInTurn(std::vector<GLintptr> const& offsets, char const* what) {
+    if (offsets.size() < 2) {
+        printf("FAIL %s: only %zu updates were mapped\n", what, offsets.size());
+        s_failures++;
+        return;
+    }
+    GLintptr const regionSize = offsets[1] - offsets[0];
+    if (regionSize <= 0) {
+        printf("FAIL %s: the second update wrote the region of the first\n", what);
+        s_failures++;
+        return;
+    }
+    GLintptr const ringSize = regionSize * GlGeometry::DYNAMIC_REGIONS;
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] != (offsets[i - 1] + regionSize) % ringSize) {
+            printf(
+                "FAIL %s: update %zu wrote offset %ld after %ld\n",
+                what,
+                i,
+                long(offsets[i]),
+                long(offsets[i - 1]));
+            s_failures++;
+            return;
+        }
+    }
+}
+
+static void TestSteadyState(ovrSurfaceRender& surfaceRender, GlProgram const& program) {
+    int const numQuads = 64;
+    ovrSurfaceDef surf;
+    surf.geo.Create(MakeQuads(numQuads, 0.0f), QuadIndices(numQuads));
+    surf.graphicsCommand.Program = program;
+
+    // the first update sizes the ring
+    s_bufferDataCalls = 0;
+    surf.geo.Update(MakeQuads(numQuads, 0.1f));
+    Check(s_bufferDataCalls == 1, "the first update allocates the ring");
+    DrawFrame(surfaceRender, {&surf});
+
+    s_bufferDataCalls = 0;
+    s_mappedOffsets.clear();
+    for (int frame = 0; frame < 30; ++frame) {
+        surf.geo.Update(MakeQuads(numQuads, frame * 0.01f));
+        DrawFrame(surfaceRender, {&surf});
+    }
+    Check(s_bufferDataCalls == 0, "updates of the same size don't call glBufferData");
+    CheckRegionsInTurn(s_mappedOffsets, "same size");
+
+    // fewer vertices fit the regions as they are
+    s_bufferDataCalls = 0;
+    for (int frame = 0; frame < 10; ++frame) {
+        surf.geo.Update(MakeQuads(numQuads / 2, 0.0f));
+        DrawFrame(surfaceRender, {&surf});
+    }
+    Check(s_bufferDataCalls == 0, "smaller updates don't call glBufferData");
+
+    // more do not, once
+    s_bufferDataCalls = 0;
+    surf.geo.Update(MakeQuads(numQuads * 2, 0.0f));
+    Check(s_bufferDataCalls == 1, "a larger update grows the ring once");
+    s_bufferDataCalls = 0;
+    for (int frame = 0; frame < 10; ++frame) {
+        surf.geo.Update(MakeQuads(numQuads * 2, 0.0f));
+        DrawFrame(surfaceRender, {&surf});
+    }
+    Check(s_bufferDataCalls == 0, "updates after growing don't call glBufferData");
+
+    surf.geo.Free();
+}
+
+// Surfaces copy their geometry, so the copies share the buffer and must share the ring too: an
+// update through one copy may not write the region the other's last update is drawn from.
+static void TestCopies(ovrSurfaceRender& surfaceRender, GlProgram const& program) {
+    int const numQuads = 16;
+    ovrSurfaceDef first;
+    first.geo.Create(MakeQuads(numQuads, 0.0f), QuadIndices(numQuads));
+    first.graphicsCommand.Program = program;
+    ovrSurfaceDef second = first;
+
+    s_bufferDataCalls = 0;
+    s_mappedOffsets.clear();
+    for (int frame = 0; frame < 30; ++frame) {
+        ovrSurfaceDef& updated = (frame % 3 == 0) ? second : first;
+        updated.geo.Update(MakeQuads(numQuads, frame * 0.01f));
+        DrawFrame(surfaceRender, {&first, &second});
+    }
+    Check(s_bufferDataCalls == 1, "copies allocate the ring once between them");
+    CheckRegionsInTurn(s_mappedOffsets, "copies");
+
+    // A buffer created after the ring's buffer is freed may get the same name, and must start
+    // without a ring.
+    first.geo.Free();
+    ovrSurfaceDef reused;
+    reused.geo.Create(MakeQuads(numQuads, 0.0f), QuadIndices(numQuads));
+    s_bufferDataCalls = 0;
+    reused.geo.Update(MakeQuads(numQuads, 0.0f));
+    Check(s_bufferDataCalls == 1, "a new buffer starts a new ring");
+    reused.geo.Free();
+}
+
+static void TestFont(ovrSurfaceRender& surfaceRender, GlProgram const& program) {
+    int const numQuads = 32;
+    std::vector<fontVertex_t> vertices(numQuads * 4);
+    OVR::Bounds3f bounds;
+    ovrSurfaceDef surf;
+    surf.geo = FontGeometryCreate(vertices.data(), numQuads * 4, bounds);
+    surf.graphicsCommand.Program = program;
+
+    s_bufferDataCalls = 0;
+    s_mappedOffsets.clear();
+    FontGeometryUpdate(surf.geo, vertices.data(), numQuads * 4, numQuads * 6);
+    Check(s_bufferDataCalls == 1, "the first font update allocates the ring");
+    s_bufferDataCalls = 0;
+    for (int frame = 0; frame < 30; ++frame) {
+        FontGeometryUpdate(surf.geo, vertices.data(), numQuads * 4, numQuads * 6);
+        DrawFrame(surfaceRender, {&surf});
+    }
+    Check(s_bufferDataCalls == 0, "font updates don't call glBufferData");
+    CheckRegionsInTurn(s_mappedOffsets, "font");
+    surf.geo.Free();
+}
+
+int main() {
+    HostGlContext gl;
+    if (!gl.IsCurrent()) {
+        printf("FAIL could not create a GL context\n");
+        return 1;
+    }
+
+    ovrSurfaceRender surfaceRender;
+    surfaceRender.Init();
+    GlProgram program = GlProgram::Build(VertexSrc, FragmentSrc, nullptr, 0);
+
+    TestSteadyState(surfaceRender, program);
+    TestCopies(surfaceRender, program);
+    TestFont(surfaceRender, program);
+
+    GlProgram::Free(program);
+    surfaceRender.Shutdown();
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   GlStateShadowTest.cpp
+Content     :   Frames as XrApp renders them, with surface lists binding through the GL state
+                shadow and app code binding with GL directly in between, checked by reading the
+                state back from GL.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "Render/Egl.h"
+#include "Render/GlGeometry.h"
+#include "Render/GlProgram.h"
+#include "Render/GlState.h"
+#include "Render/GlTexture.h"
+#include "Render/SurfaceRender.h"
+
+#include "HostGlContext.h"
+
+using namespace OVRFW;
+using OVR::Matrix4f;
+
+static int s_failures = 0;
+
+static void Check(bool const condition, char const* what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        s_failures++;
+    }
+}
+
+static char const* VertexSrc = R"glsl(
+	attribute highp vec4 Position;
+	attribute highp vec2 TexCoord;
+	varying highp vec2 oTexCoord;
+	void main()
+	{
+		gl_Position = TransformVertex( Position );
+		oTexCoord = TexCoord;
+	}
+)glsl";
+
+static char const* TexturedFragmentSrc = R"glsl(
+	uniform sampler2D Texture0;
+	varying highp vec2 oTexCoord;
+	void main()
+	{
+		gl_FragColor = texture2D( Texture0, oTexCoord );
+	}
+)glsl";
+
+static char const* SolidFragmentSrc = R"glsl(
+	varying highp vec2 oTexCoord;
+	void main()
+	{
+		gl_FragColor = vec4( oTexCoord, 0.0, 1.0 );
+	}
+)glsl";
+
+static GlTexture CreateSolidTexture(uint32_t const color) {
+    return LoadRGBATextureFromMemory(reinterpret_cast<uint8_t const*>(&color), 1, 1, false);
+}
+
+// Surfaces that change program, texture, blending, depth and culling from one to the next.
+struct ShadowScene {
+    GlProgram Textured;
+    GlProgram Solid;
+    GlTexture Red;
+    GlTexture Green;
+    ovrSurfaceDef Surfaces[3];
+
+    ShadowScene() {
+        ovrProgramParm const parms[] = {
+            {.Name = "Texture0", .Type = ovrProgramParmType::TEXTURE_SAMPLED},
+        };
+        Textured = GlProgram::Build(VertexSrc, TexturedFragmentSrc, parms, 1);
+        Solid = GlProgram::Build(VertexSrc, SolidFragmentSrc, nullptr, 0);
+        Red = CreateSolidTexture(0xff0000ff);
+        Green = CreateSolidTexture(0xff00ff00);
+
+        for (ovrSurfaceDef& surf : Surfaces) {
+            surf.geo = BuildTesselatedQuad(1, 1, false);
+        }
+        Surfaces[0].graphicsCommand.Program = Textured;
+        Surfaces[0].graphicsCommand.UniformData[0].Data = &Red;
+        Surfaces[1].graphicsCommand.Program = Solid;
+        Surfaces[1].graphicsCommand.GpuState.depthEnable = false;
+        Surfaces[1].graphicsCommand.GpuState.cullEnable = false;
+        Surfaces[2].graphicsCommand.Program = Textured;
+        Surfaces[2].graphicsCommand.UniformData[0].Data = &Green;
+        ovrGpuState& blended = Surfaces[2].graphicsCommand.GpuState;
+        blended.blendEnable = ovrGpuState::BLEND_ENABLE;
+        blended.blendSrc = ovrGpuState::kGL_SRC_ALPHA;
+        blended.blendDst = ovrGpuState::kGL_ONE_MINUS_SRC_ALPHA;
+        blended.depthMaskEnable = false;
+    }
+
+    ~ShadowScene() {
+        for (ovrSurfaceDef& surf : Surfaces) {
+            surf.geo.Free();
+        }
+        GlProgram::Free(Textured);
+        GlProgram::Free(Solid);
+        DeleteTexture(Red);
+        DeleteTexture(Green);
+    }
+
+    void Render(ovrSurfaceRender& surfaceRender) {
+        std::vector<ovrDrawSurface> surfaceList;
+        for (ovrSurfaceDef const& surf : Surfaces) {
+            surfaceList.push_back(ovrDrawSurface(Matrix4f::Identity(), &surf));
+        }
+        surfaceRender.RenderSurfaceList(surfaceList, Matrix4f::Identity(), Matrix4f::Identity(), 0);
+    }
+};
+
+// What XrApp::AppEyeGLStateSetup does before each eye's surface list.
+static void EyeSetup() {
+    GetGlState().SetGpuState(ovrGpuState());
+    GL(glViewport(0, 0, 16, 16));
+    GL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+}
+
+// GL calls an app's AppRenderEye might make after the surface list, as a library drawing its own
+// overlay would.
+static void DirectDraw(GlTexture const& texture) {
+    GL(glUseProgram(0));
+    GL(glActiveTexture(GL_TEXTURE1));
+    GL(glBindTexture(GL_TEXTURE_2D, texture));
+    GL(glDisable(GL_BLEND));
+    GL(glEnable(GL_DEPTH_TEST));
+    GL(glDepthMask(GL_TRUE));
+}
+
+// Raw GL after a surface list starts from the state the list's last surface left.
+static void TestStateAfterList(ovrSurfaceRender& surfaceRender, ShadowScene& scene) {
+    GetGlState().Invalidate();
+    EyeSetup();
+    scene.Render(surfaceRender);
+    Check(GetGlState().Validate(), "the shadow matches GL after a list");
+
+    GLint program = 0;
+    GL(glGetIntegerv(GL_CURRENT_PROGRAM, &program));
+    GLboolean depthMask = GL_TRUE;
+    GL(glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask));
+    Check(program == GLint(scene.Textured.Program), "the last surface's program stays bound");
+    Check(glIsEnabled(GL_BLEND), "the last surface's blending stays enabled");
+    Check(depthMask == GL_FALSE, "the last surface's depth mask stays off");
+}
+
+// Direct GL calls leave the shadow stale until it is invalidated.
+static void TestDirectBinds(ovrSurfaceRender& surfaceRender, ShadowScene& scene) {
+    GetGlState().Invalidate();
+    EyeSetup();
+    scene.Render(surfaceRender);
+    DirectDraw(scene.Red);
+    // Validate logs each state it finds stale
+    Check(!GetGlState().Validate(), "direct binds leave the shadow stale");
+
+    GetGlState().Invalidate();
+    Check(GetGlState().Validate(), "an invalidated shadow matches GL");
+    scene.Render(surfaceRender);
+    Check(GetGlState().Validate(), "a list after the invalidation sets all it needs");
+}
+
+// Frames as XrApp renders them: one invalidation, then both eyes with shadowed binds from the
+// surface lists and the eye setup, and direct binds followed by an invalidation in between.
+static void TestMixedFrames(ovrSurfaceRender& surfaceRender, ShadowScene& scene) {
+    for (int frame = 0; frame < 4; ++frame) {
+        GetGlState().Invalidate();
+        for (int eye = 0; eye < 2; ++eye) {
+            EyeSetup();
+            scene.Render(surfaceRender);
+            Check(GetGlState().Validate(), "the shadow matches GL after an eye's list");
+
+            // shadowed binds outside a surface list, as the virtual keyboard makes
+            GetGlState().BindTexture(0, GL_TEXTURE_2D, scene.Green);
+            GetGlState().BindTexture(0, GL_TEXTURE_2D, 0);
+            GetGlState().UseProgram(scene.Solid.Program);
+            Check(GetGlState().Validate(), "the shadow matches GL after shadowed binds");
+
+            DirectDraw(eye == 0 ? scene.Red : scene.Green);
+            GetGlState().Invalidate();
+            Check(GetGlState().Validate(), "the shadow matches GL after direct binds");
+        }
+        scene.Render(surfaceRender);
+        Check(GetGlState().Validate(), "the shadow matches GL at the end of the frame");
+    }
+}
+
+int main() {
+    HostGlContext gl;
+    if (!gl.IsCurrent()) {
+        printf("FAIL could not create a GL context\n");
+        return 1;
+    }
+
+    ovrSurfaceRender surfaceRender;
+    surfaceRender.Init();
+    {
+        ShadowScene scene;
+        TestStateAfterList(surfaceRender, scene);
+        TestDirectBinds(surfaceRender, scene);
+        TestMixedFrames(surfaceRender, scene);
+    }
+    surfaceRender.Shutdown();
+
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
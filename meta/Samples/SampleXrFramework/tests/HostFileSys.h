@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   HostFileSys.h
+Content     :   ovrFileSys over plain host paths, for the host-side tests.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "OVR_FileSys.h"
+
+namespace OVRFW {
+
+// URIs are host paths, except that "apk:///assets/" maps to assetsPath. Without allowMapping it
+// behaves like a file inside the apk, which can only be read, not mapped.
+class HostFileSys : public ovrFileSys {
+   public:
+    explicit HostFileSys(bool const allowMapping, std::string const& assetsPath = std::string())
+        : AllowMapping(allowMapping), AssetsPath(assetsPath) {}
+
+    virtual ovrStream* OpenStream(char const* /*uri*/, ovrStreamMode const /*mode*/) {
+        return nullptr;
+    }
+
+    virtual void CloseStream(ovrStream*& stream) {
+        stream = nullptr;
+    }
+
+    virtual bool ReadFile(char const* uri, std::vector<uint8_t>& outBuffer) {
+        std::ifstream file(GetPath(uri), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        outBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    virtual bool FileExists(char const* uri) {
+        return std::ifstream(GetPath(uri)).good();
+    }
+
+    virtual bool GetLocalPathForURI(char const* uri, std::string& outputPath) {
+        if (!AllowMapping) {
+            return false;
+        }
+        outputPath = GetPath(uri);
+        return true;
+    }
+
+   private:
+    std::string GetPath(char const* uri) const {
+        std::string const assetsScheme = "apk:///assets/";
+        if (strncmp(uri, assetsScheme.c_str(), assetsScheme.size()) == 0) {
+            return AssetsPath + "/" + (uri + assetsScheme.size());
+        }
+        return uri;
+    }
+
+    bool AllowMapping;
+    std::string AssetsPath;
+};
+
+} // namespace OVRFW
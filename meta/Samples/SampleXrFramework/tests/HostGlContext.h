@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   HostGlContext.h
+Content     :   Offscreen OpenGL ES 3 context for the host-side tests.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <string.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace OVRFW {
+
+// Creates an OpenGL ES 3 context with a small pbuffer and makes it current. Without a display
+// server this uses Mesa's surfaceless platform, so the tests run on llvmpipe in a plain shell.
+// Tests render into their own framebuffers; the pbuffer only exists to make the context current.
+class HostGlContext {
+   public:
+    HostGlContext() : Display(EGL_NO_DISPLAY), Surface(EGL_NO_SURFACE), Context(EGL_NO_CONTEXT) {
+        char const* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (clientExtensions != nullptr &&
+            strstr(clientExtensions, "EGL_MESA_platform_surfaceless") != nullptr) {
+            auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (getPlatformDisplay != nullptr) {
+                Display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, nullptr, nullptr);
+            }
+        }
+        if (Display == EGL_NO_DISPLAY) {
+            Display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+        if (!eglInitialize(Display, nullptr, nullptr)) {
+            Display = EGL_NO_DISPLAY;
+            return;
+        }
+
+        EGLint const configAttribs[] = {
+            EGL_SURFACE_TYPE,
+            EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE,
+            EGL_OPENGL_ES3_BIT,
+            EGL_RED_SIZE,
+            8,
+            EGL_GREEN_SIZE,
+            8,
+            EGL_BLUE_SIZE,
+            8,
+            EGL_ALPHA_SIZE,
+            8,
+            EGL_DEPTH_SIZE,
+            24,
+            EGL_NONE};
+        EGLConfig config = nullptr;
+        EGLint numConfigs = 0;
+        if (!eglChooseConfig(Display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+            return;
+        }
+        eglBindAPI(EGL_OPENGL_ES_API);
+
+        EGLint const contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+        Context = eglCreateContext(Display, config, EGL_NO_CONTEXT, contextAttribs);
+        EGLint const surfaceAttribs[] = {EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE};
+        Surface = eglCreatePbufferSurface(Display, config, surfaceAttribs);
+        if (Context != EGL_NO_CONTEXT && Surface != EGL_NO_SURFACE) {
+            eglMakeCurrent(Display, Surface, Surface, Context);
+        }
+    }
+
+    ~HostGlContext() {
+        if (Display == EGL_NO_DISPLAY) {
+            return;
+        }
+        eglMakeCurrent(Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (Surface != EGL_NO_SURFACE) {
+            eglDestroySurface(Display, Surface);
+        }
+        if (Context != EGL_NO_CONTEXT) {
+            eglDestroyContext(Display, Context);
+        }
+        eglTerminate(Display);
+    }
+
+    HostGlContext(HostGlContext const&) = delete;
+    HostGlContext& operator=(HostGlContext const&) = delete;
+
+    bool IsCurrent() const {
+        return Context != EGL_NO_CONTEXT && eglGetCurrentContext() == Context;
+    }
+
+   private:
+    EGLDisplay Display;
+    EGLSurface Surface;
+    EGLContext Context;
+};
+
+} // namespace OVRFW
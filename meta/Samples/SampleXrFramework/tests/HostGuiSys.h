@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   HostGuiSys.h
+Content     :   OvrGuiSys on a host GL context, for the host-side GUI tests.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "GUI/GuiSys.h"
+#include "GUI/VRMenu.h"
+#include "GUI/VRMenuMgr.h"
+#include "GUI/VRMenuObject.h"
+#include "Render/Egl.h"
+
+#include "HostFileSys.h"
+#include "HostGlContext.h"
+
+namespace OVRFW {
+
+// A GuiSys without a font or sounds, and a texture to put on buttons. Menus are opened without
+// placement flags, so they stay at the pose they are given.
+class HostGuiSys {
+   public:
+    HostGuiSys() : FileSys(false), GuiSys(nullptr), Texture(0), FrameIndex(0) {
+        if (!Gl.IsCurrent()) {
+            return;
+        }
+        glGenTextures(1, &Texture);
+        glBindTexture(GL_TEXTURE_2D, Texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, 4, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        GuiSys = OvrGuiSys::Create(nullptr);
+        // the font fails to load, which GuiSys tolerates
+        GuiSys->Init(&FileSys, SoundEffectPlayer, "efigs.fnt", nullptr);
+    }
+
+    ~HostGuiSys() {
+        if (GuiSys != nullptr) {
+            OvrGuiSys::Destroy(GuiSys);
+        }
+        if (Texture != 0) {
+            glDeleteTextures(1, &Texture);
+        }
+    }
+
+    HostGuiSys(HostGuiSys const&) = delete;
+    HostGuiSys& operator=(HostGuiSys const&) = delete;
+
+    bool IsValid() const {
+        return GuiSys != nullptr;
+    }
+
+    OvrGuiSys& Get() {
+        return *GuiSys;
+    }
+
+    // Parameters for a textured button, placed exactly at localPose.
+    VRMenuObjectParms* ButtonParms(
+        VRMenuId_t const id,
+        OVR::Posef const& localPose,
+        OVR::Vector3f const& localScale = OVR::Vector3f(1.0f),
+        VRMenuId_t const parentId = VRMenuId_t()) const {
+        VRMenuSurfaceParms surfaceParms(
+            "button",
+            Texture,
+            64,
+            64,
+            SURFACE_TEXTURE_DIFFUSE,
+            0,
+            0,
+            0,
+            SURFACE_TEXTURE_MAX,
+            0,
+            0,
+            0,
+            SURFACE_TEXTURE_MAX);
+        VRMenuObjectParms* parms = new VRMenuObjectParms(
+            VRMENU_BUTTON,
+            std::vector<VRMenuComponent*>(),
+            surfaceParms,
+            "",
+            localPose,
+            localScale,
+            VRMenuFontParms(),
+            id,
+            VRMenuObjectFlags_t(),
+            VRMenuObjectInitFlags_t(VRMENUOBJECT_INIT_FORCE_POSITION));
+        parms->ParentId = parentId;
+        return parms;
+    }
+
+    // Creates a button with the given id and name as the last child of parentHandle.
+    menuHandle_t AddButton(
+        menuHandle_t const parentHandle,
+        VRMenuId_t const id,
+        char const* name,
+        OVR::Posef const& localPose = OVR::Posef()) {
+        OvrVRMenuMgr& menuMgr = GuiSys->GetVRMenuMgr();
+        VRMenuObjectParms* parms = ButtonParms(id, localPose);
+        parms->Name = name;
+        menuHandle_t const handle = menuMgr.CreateObject(*parms);
+        delete parms;
+        menuMgr.ToObject(parentHandle)->AddChild(menuMgr, handle);
+        return handle;
+    }
+
+    // Creates, adds and opens a menu with the given items, then frees the item parameters.
+    VRMenu* OpenMenu(
+        char const* name,
+        OVR::Posef const& menuPose,
+        std::vector<VRMenuObjectParms const*>& itemParms) {
+        VRMenu* menu = VRMenu::Create(name);
+        menu->InitWithItems(*GuiSys, 1.0f, VRMenuFlags_t(), itemParms);
+        for (VRMenuObjectParms const* parms : itemParms) {
+            delete parms;
+        }
+        itemParms.clear();
+        menu->SetMenuPose(menuPose);
+        GuiSys->AddMenu(menu);
+        GuiSys->OpenMenu(name);
+        return menu;
+    }
+
+    void Frame() {
+        ovrApplFrameIn vrFrame;
+        vrFrame.FrameIndex = ++FrameIndex;
+        GuiSys->Frame(vrFrame, OVR::Matrix4f());
+    }
+
+    VRMenuObject* ObjectForId(VRMenu const* menu, VRMenuId_t const id) const {
+        return menu->ObjectForId(*GuiSys, id);
+    }
+
+   private:
+    HostGlContext Gl;
+    HostFileSys FileSys;
+    OvrGuiSys::ovrDummySoundEffectPlayer SoundEffectPlayer;
+    OvrGuiSys* GuiSys;
+    GLuint Texture;
+    long long FrameIndex;
+};
+
+} // namespace OVRFW
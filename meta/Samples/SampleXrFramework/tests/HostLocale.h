@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   HostLocale.h
+Content     :   ovrLocale without strings, for the host-side tests.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <string.h>
+#include <string>
+
+#include "Locale/OVR_Locale.h"
+
+namespace OVRFW {
+
+// ovrLocale::Create needs a JNI environment. Menu parsing only needs a locale to look up
+// "@string/" keys, which this leaves as they are.
+class HostLocale : public ovrLocale {
+   public:
+    virtual char const* GetName() const override {
+        return "host";
+    }
+    virtual char const* GetLanguageCode() const override {
+        return "en";
+    }
+    virtual bool IsSystemDefaultLocale() const override {
+        return true;
+    }
+    virtual bool LoadStringsFromAndroidFormatXMLFile(ovrFileSys&, char const*) override {
+        return false;
+    }
+    virtual bool AddStringsFromAndroidFormatXMLBuffer(char const*, char const*, size_t const)
+        override {
+        return false;
+    }
+    virtual bool LoadStringsFromBinaryTable(ovrFileSys&, char const*) override {
+        return false;
+    }
+    virtual bool GetLocalizedString(char const*, char const* defaultStr, std::string& out)
+        const override {
+        out = defaultStr;
+        return false;
+    }
+    virtual char const* FindLocalizedString(std::string_view const) const override {
+        return nullptr;
+    }
+    virtual void ReplaceLocalizedText(char const* inText, char* out, size_t const outSize)
+        const override {
+        if (outSize > 0) {
+            strncpy(out, inText, outSize - 1);
+            out[outSize - 1] = '\0';
+        }
+    }
+};
+
+} // namespace OVRFW
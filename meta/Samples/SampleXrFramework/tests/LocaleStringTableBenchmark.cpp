@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   LocaleStringTableBenchmark.cpp
+Content     :   Times loading and looking up strings from strings.xml against the compiled
+                string table.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Builds the locale implementation into the benchmark, so it can be created without a JNI
+// context.
+#include "Locale/OVR_Locale.cpp"
+
+#include "HostFileSys.h"
+
+using namespace OVRFW;
+
+template <typename Function>
+static double MillisecondsPerRun(int const runs, Function&& function) {
+    function(); // warm up caches
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        function();
+    }
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printf("usage: %s <strings.xml> <table.bin> [runs]\n", argv[0]);
+        return 1;
+    }
+    char const* const xmlPath = argv[1];
+    char const* const tablePath = argv[2];
+    int const runs = argc > 3 ? atoi(argv[3]) : 20;
+
+    HostFileSys readFileSys(false);
+    HostFileSys mapFileSys(true);
+    std::vector<uint8_t> xml;
+    if (!readFileSys.ReadFile(xmlPath, xml)) {
+        printf("could not read '%s'\n", xmlPath);
+        return 1;
+    }
+
+    // Startup: what the locale costs before the first string can be looked up.
+    double const xmlLoad = MillisecondsPerRun(runs, [&] {
+        std::vector<uint8_t> buffer;
+        readFileSys.ReadFile(xmlPath, buffer);
+        ovrLocaleInternal locale("xml", "en");
+        locale.AddStringsFromAndroidFormatXMLBuffer(
+            xmlPath, reinterpret_cast<char const*>(buffer.data()), buffer.size());
+    });
+    double const tableRead = MillisecondsPerRun(runs, [&] {
+        ovrLocaleInternal locale("table", "en");
+        locale.LoadStringsFromBinaryTable(readFileSys, tablePath);
+    });
+    double const tableMap = MillisecondsPerRun(runs, [&] {
+        ovrLocaleInternal locale("table", "en");
+        locale.LoadStringsFromBinaryTable(mapFileSys, tablePath);
+    });
+
+    ovrLocaleInternal fromXml("xml", "en");
+    fromXml.AddStringsFromAndroidFormatXMLBuffer(
+        xmlPath, reinterpret_cast<char const*>(xml.data()), xml.size());
+    ovrLocaleInternal fromTable("table", "en");
+    if (!fromTable.LoadStringsFromBinaryTable(mapFileSys, tablePath)) {
+        printf("could not load '%s'\n", tablePath);
+        return 1;
+    }
+
+    std::vector<std::string> keys;
+    tinyxml2::XMLDocument doc;
+    doc.Parse(reinterpret_cast<char const*>(xml.data()), xml.size());
+    for (tinyxml2::XMLElement const* element = doc.RootElement()->FirstChildElement("string");
+         element != nullptr;
+         element = element->NextSiblingElement("string")) {
+        keys.push_back(std::string(ovrLocale::LOCALIZED_KEY_PREFIX) + element->Attribute("name"));
+    }
+
+    // Lookups: every key once per run, through the allocating and the non-allocating calls.
+    size_t sink = 0;
+    double const xmlLookup = MillisecondsPerRun(runs, [&] {
+        for (std::string const& key : keys) {
+            std::string value;
+            fromXml.GetLocalizedString(key.c_str(), "", value);
+            sink += value.size();
+        }
+    });
+    double const tableLookup = MillisecondsPerRun(runs, [&] {
+        for (std::string const& key : keys) {
+            sink += strlen(fromTable.FindLocalizedString(key));
+        }
+    });
+
+    printf(
+        "%zu strings: load xml %.2f ms, read table %.3f ms, map table %.3f ms\n",
+        keys.size(),
+        xmlLoad,
+        tableRead,
+        tableMap);
+    printf(
+        "lookup: GetLocalizedString from xml %.1f ns, "
+        "FindLocalizedString from table %.1f ns (%zu)\n",
+        xmlLookup * 1e6 / keys.size(),
+        tableLookup * 1e6 / keys.size(),
+        sink);
+    return 0;
+}
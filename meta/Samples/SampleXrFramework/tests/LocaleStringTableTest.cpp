@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   LocaleStringTableTest.cpp
+Content     :   Checks that a compiled string table returns exactly the strings ovrLocale gets
+                from parsing the strings.xml it was compiled from.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+// Builds the locale implementation into the test, so it can be created without a JNI context.
+#include "Locale/OVR_Locale.cpp"
+
+#include "HostFileSys.h"
+
+using namespace OVRFW;
+
+static int s_failures = 0;
+
+static std::vector<std::string> ReadKeys(std::vector<uint8_t> const& xml) {
+    std::vector<std::string> keys;
+    tinyxml2::XMLDocument doc;
+    if (doc.Parse(reinterpret_cast<char const*>(xml.data()), xml.size()) !=
+        tinyxml2::XML_NO_ERROR) {
+        return keys;
+    }
+    for (tinyxml2::XMLElement const* element = doc.RootElement()->FirstChildElement("string");
+         element != nullptr;
+         element = element->NextSiblingElement("string")) {
+        keys.push_back(std::string(ovrLocale::LOCALIZED_KEY_PREFIX) + element->Attribute("name"));
+    }
+    return keys;
+}
+
+static void CheckSameStrings(
+    ovrLocale const& expected,
+    ovrLocale const& actual,
+    std::vector<std::string> const& keys,
+    char const* what) {
+    for (std::string const& key : keys) {
+        char const* const expectedValue = expected.FindLocalizedString(key);
+        char const* const actualValue = actual.FindLocalizedString(key);
+        if (expectedValue == nullptr || actualValue == nullptr ||
+            strcmp(expectedValue, actualValue) != 0) {
+            printf(
+                "FAIL %s: '%s' is '%s', expected '%s'\n",
+                what,
+                key.c_str(),
+                actualValue != nullptr ? actualValue : "(missing)",
+                expectedValue != nullptr ? expectedValue : "(missing)");
+            s_failures++;
+            return;
+        }
+    }
+    if (actual.FindLocalizedString("@string/not_a_key") != nullptr ||
+        actual.FindLocalizedString("@string/") != nullptr) {
+        printf("FAIL %s: found a key that is not in the table\n", what);
+        s_failures++;
+    }
+}
+
+// Every prefix of the table must be rejected, and so must a corrupted header field.
+static void CheckRejectsDamagedTables(std::vector<uint8_t> const& table) {
+    ovrLocaleStringTable damaged;
+    for (size_t size = 0; size < table.size(); size += (size < 256 ? 1 : 97)) {
+        if (damaged.LoadFromBuffer("truncated", table.data(), size)) {
+            printf("FAIL accepted a table truncated to %zu of %zu bytes\n", size, table.size());
+            s_failures++;
+            return;
+        }
+    }
+    size_t const headerWords = offsetof(ovrLocaleStringTable::ovrLocaleStringTableHeader, Pad) / 4;
+    for (size_t word = 0; word < headerWords; word++) {
+        std::vector<uint8_t> corrupted = table;
+        corrupted[word * 4 + 3] ^= 0x80;
+        if (damaged.LoadFromBuffer("corrupted", corrupted.data(), corrupted.size())) {
+            printf("FAIL accepted a table with header word %zu corrupted\n", word);
+            s_failures++;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        printf("usage: %s <strings.xml> <table.bin> <assets dir>\n", argv[0]);
+        return 1;
+    }
+    char const* const xmlPath = argv[1];
+    char const* const tablePath = argv[2];
+
+    HostFileSys fileSys(false);
+    std::vector<uint8_t> xml;
+    std::vector<uint8_t> table;
+    if (!fileSys.ReadFile(xmlPath, xml) || !fileSys.ReadFile(tablePath, table)) {
+        printf("FAIL could not read '%s' or '%s'\n", xmlPath, tablePath);
+        return 1;
+    }
+    std::vector<std::string> const keys = ReadKeys(xml);
+    if (keys.empty()) {
+        printf("FAIL no strings in '%s'\n", xmlPath);
+        return 1;
+    }
+
+    ovrLocaleInternal fromXml("xml", "en");
+    if (!fromXml.AddStringsFromAndroidFormatXMLBuffer(
+            xmlPath, reinterpret_cast<char const*>(xml.data()), xml.size())) {
+        printf("FAIL could not parse '%s'\n", xmlPath);
+        return 1;
+    }
+
+    // The table is mapped when the file system gives a path, and read into memory otherwise.
+    for (bool const allowMapping : {true, false}) {
+        HostFileSys tableFileSys(allowMapping);
+        ovrLocaleInternal fromTable("table", "en");
+        if (!fromTable.LoadStringsFromBinaryTable(tableFileSys, tablePath)) {
+            printf("FAIL could not load '%s'\n", tablePath);
+            s_failures++;
+            continue;
+        }
+        CheckSameStrings(fromXml, fromTable, keys, allowMapping ? "mapped table" : "read table");
+    }
+
+    // The tables ovrLocale::Create loads from the apk's assets/strings/.
+    HostFileSys assetsFileSys(true, argv[3]);
+    ovrLocaleInternal fromAssets("assets", "en");
+    LoadCompiledStringTables(fromAssets, assetsFileSys, "en");
+    CheckSameStrings(fromXml, fromAssets, keys, "assets/strings/default.bin");
+
+    CheckRejectsDamagedTables(table);
+
+    if (s_failures != 0) {
+        printf("%d failures\n", s_failures);
+        return 1;
+    }
+    printf("%zu strings from '%s' match\n", keys.size(), xmlPath);
+    return 0;
+}
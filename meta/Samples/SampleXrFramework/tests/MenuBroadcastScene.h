@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuBroadcastScene.h
+Content     :   Menus full of components that record the frame updates they get, and the
+                recursive broadcast that VRMenuEventHandler used before it flattened menus,
+                shared by the broadcast tests and benchmarks.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "GUI/VRMenuComponent.h"
+
+#include "HostGuiSys.h"
+
+namespace OVRFW {
+
+class RecordingComponent;
+
+// A frame update a component got, and the root of the tree its object was in.
+struct RecordedUpdate {
+    menuHandle_t Root;
+    RecordingComponent const* Component;
+};
+
+// Appends to Log on every frame update it gets. OnFirstUpdate runs on the first one.
+class RecordingComponent : public VRMenuComponent {
+   public:
+    RecordingComponent(
+        std::vector<RecordedUpdate>& log,
+        bool const wantsUpdates,
+        bool const consumes)
+        : VRMenuComponent(
+              wantsUpdates ? VRMenuEventFlags_t(VRMENU_EVENT_FRAME_UPDATE)
+                           : VRMenuEventFlags_t(VRMENU_EVENT_FOCUS_GAINED)),
+          Log(log),
+          Consumes(consumes),
+          Updates(0) {}
+
+    // stops frame updates after the current one, as animation components do when they finish
+    void StopUpdates() {
+        RemoveEventFlags(VRMENU_EVENT_FRAME_UPDATE);
+    }
+
+    bool ConsumesUpdates() const {
+        return Consumes;
+    }
+
+    std::function<void(OvrGuiSys&, VRMenuObject*)> OnFirstUpdate;
+
+   private:
+    virtual eMsgStatus OnEvent_Impl(
+        OvrGuiSys& guiSys,
+        ovrApplFrameIn const& /*vrFrame*/,
+        VRMenuObject* self,
+        VRMenuEvent const& event) override {
+        if (event.EventType != VRMENU_EVENT_FRAME_UPDATE) {
+            return MSG_STATUS_ALIVE;
+        }
+        OvrVRMenuMgr const& menuMgr = guiSys.GetVRMenuMgr();
+        VRMenuObject const* root = self;
+        for (VRMenuObject const* parent = self; parent != nullptr;
+             parent = menuMgr.ToObject(parent->GetParentHandle())) {
+            root = parent;
+        }
+        Log.push_back({root->GetHandle(), this});
+        if (Updates++ == 0 && OnFirstUpdate) {
+            OnFirstUpdate(guiSys, self);
+        }
+        return Consumes ? MSG_STATUS_CONSUMED : MSG_STATUS_ALIVE;
+    }
+
+    std::vector<RecordedUpdate>& Log;
+    bool Consumes;
+    int Updates;
+};
+
+// Adds a recording component to an object.
+inline RecordingComponent* AddRecorder(
+    OvrGuiSys& guiSys,
+    menuHandle_t const handle,
+    std::vector<RecordedUpdate>& log,
+    bool const wantsUpdates = true,
+    bool const consumes = false) {
+    RecordingComponent* component = new RecordingComponent(log, wantsUpdates, consumes);
+    guiSys.GetVRMenuMgr().ToObject(handle)->AddComponent(component);
+    return component;
+}
+
+// Opens a menu of numObjects buttons in a tree fanOut wide, filled breadth-first. Object i has
+// i % 3 recording components, and every fourth of those only wants focus events.
+inline VRMenu* OpenRecordingMenu(
+    HostGuiSys& gui,
+    char const* name,
+    int const numObjects,
+    int const fanOut,
+    std::vector<RecordedUpdate>& log) {
+    std::vector<VRMenuObjectParms const*> itemParms;
+    VRMenu* menu = gui.OpenMenu(name, OVR::Posef(), itemParms);
+    std::vector<menuHandle_t> handles;
+    int numComponents = 0;
+    for (int i = 0; i < numObjects; ++i) {
+        menuHandle_t const parent = i < fanOut ? menu->GetRootHandle() : handles[i / fanOut - 1];
+        std::string const objectName = std::string(name) + "_" + std::to_string(i);
+        handles.push_back(gui.AddButton(parent, VRMenuId_t(i + 1), objectName.c_str()));
+        for (int c = 0; c < i % 3; ++c) {
+            AddRecorder(gui.Get(), handles.back(), log, numComponents++ % 4 != 3);
+        }
+    }
+    return menu;
+}
+
+// The components a frame update broadcast from obj reaches, as VRMenuEventHandler reached them
+// when it recursed: an object's components in order, then its children's subtrees, until one
+// consumes the event. Nothing is dispatched. Returns true if the event was consumed.
+inline bool ExpectedBroadcast(
+    OvrVRMenuMgr const& menuMgr,
+    VRMenuObject const* obj,
+    std::vector<RecordingComponent const*>& out) {
+    for (VRMenuComponent const* component : obj->GetComponentList()) {
+        if (!component->HandlesEvent(VRMenuEventFlags_t(VRMENU_EVENT_FRAME_UPDATE))) {
+            continue;
+        }
+        RecordingComponent const* recorder = dynamic_cast<RecordingComponent const*>(component);
+        if (recorder != nullptr) {
+            out.push_back(recorder);
+            if (recorder->ConsumesUpdates()) {
+                return true;
+            }
+        }
+    }
+    for (int i = 0; i < obj->NumChildren(); ++i) {
+        VRMenuObject const* child = menuMgr.ToObject(obj->GetChildHandleForIndex(i));
+        if (child != nullptr && ExpectedBroadcast(menuMgr, child, out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// VRMenuEventHandler::BroadcastEvent as it was before broadcasts were flattened.
+inline bool RecursiveBroadcast(
+    OvrGuiSys& guiSys,
+    ovrApplFrameIn const& vrFrame,
+    VRMenuEvent const& event,
+    VRMenuObject* receiver) {
+    for (VRMenuComponent* component : receiver->GetComponentList()) {
+        if (component->HandlesEvent(VRMenuEventFlags_t(event.EventType)) &&
+            component->OnEvent(guiSys, vrFrame, receiver, event) == MSG_STATUS_CONSUMED) {
+            return true;
+        }
+    }
+    int const numChildren = receiver->NumChildren();
+    for (int i = 0; i < numChildren; ++i) {
+        VRMenuObject* child = guiSys.GetVRMenuMgr().ToObject(receiver->GetChildHandleForIndex(i));
+        if (child != nullptr && RecursiveBroadcast(guiSys, vrFrame, event, child)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace OVRFW
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuBroadcastTest.cpp
+Content     :   Checks that frame update broadcasts through the flattened component lists reach
+                the same components in the same order as the recursive walk did, as menus,
+                components and their interest in updates change between and during frames.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "MenuBroadcastScene.h"
+
+using namespace OVRFW;
+
+static int s_failures = 0;
+
+static void Check(bool const condition, char const* what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        s_failures++;
+    }
+}
+
+static void CheckOrder(
+    std::vector<RecordingComponent const*> const& actual,
+    std::vector<RecordingComponent const*> const& expected,
+    char const* what) {
+    if (actual == expected) {
+        return;
+    }
+    size_t i = 0;
+    while (i < actual.size() && i < expected.size() && actual[i] == expected[i]) {
+        ++i;
+    }
+    printf(
+        "FAIL %s: %zu updates instead of %zu, first difference at %zu\n",
+        what,
+        actual.size(),
+        expected.size(),
+        i);
+    s_failures++;
+}
+
+// The components a menu's broadcast reached, in order.
+static std::vector<RecordingComponent const*> Reached(
+    std::vector<RecordedUpdate> const& log,
+    VRMenu const* menu) {
+    std::vector<RecordingComponent const*> reached;
+    for (RecordedUpdate const& update : log) {
+        if (update.Root == menu->GetRootHandle()) {
+            reached.push_back(update.Component);
+        }
+    }
+    return reached;
+}
+
+// Runs a frame, and checks each menu's updates against walking the menu as it was before.
+static void CheckFrame(
+    HostGuiSys& gui,
+    std::vector<VRMenu*> const& menus,
+    std::vector<RecordedUpdate>& log,
+    char const* what) {
+    OvrVRMenuMgr const& menuMgr = gui.Get().GetVRMenuMgr();
+    std::vector<std::vector<RecordingComponent const*>> expected(menus.size());
+    for (size_t m = 0; m < menus.size(); ++m) {
+        ExpectedBroadcast(menuMgr, menuMgr.ToObject(menus[m]->GetRootHandle()), expected[m]);
+    }
+    log.clear();
+    gui.Frame();
+    for (size_t m = 0; m < menus.size(); ++m) {
+        std::string const name = std::string(what) + ", menu " + std::to_string(m);
+        CheckOrder(Reached(log, menus[m]), expected[m], name.c_str());
+    }
+}
+
+static void TestManyMenus(HostGuiSys& gui) {
+    OvrGuiSys& guiSys = gui.Get();
+    OvrVRMenuMgr& menuMgr = guiSys.GetVRMenuMgr();
+    std::vector<RecordedUpdate> log;
+    std::vector<VRMenu*> menus;
+    for (int m = 0; m < 8; ++m) {
+        std::string const name = "menu" + std::to_string(m);
+        menus.push_back(OpenRecordingMenu(gui, name.c_str(), 120, 4, log));
+    }
+    // a component deep in one menu consumes updates, so the later ones in it get none
+    AddRecorder(guiSys, menus[5]->HandleForId(menuMgr, VRMenuId_t(40)), log, true, true);
+
+    CheckFrame(gui, menus, log, "first frame");
+    Check(Reached(log, menus[0]).size() > 50, "the components get updates");
+    CheckFrame(gui, menus, log, "second frame");
+
+    // some components lose interest, without changing the hierarchy
+    for (size_t i = 0; i < log.size(); i += 5) {
+        const_cast<RecordingComponent*>(log[i].Component)->StopUpdates();
+    }
+    CheckFrame(gui, menus, log, "after components stopped updates");
+
+    // an object is freed, a subtree moves to another menu, and objects and components are added
+    menuMgr.FreeObject(menus[0]->HandleForId(menuMgr, VRMenuId_t(3)));
+    menuHandle_t const moved = menus[1]->HandleForId(menuMgr, VRMenuId_t(2));
+    VRMenuObject* movedObj = menuMgr.ToObject(moved);
+    menuMgr.ToObject(movedObj->GetParentHandle())->RemoveChild(menuMgr, moved);
+    menuMgr.ToObject(menus[2]->HandleForId(menuMgr, VRMenuId_t(1)))->AddChild(menuMgr, moved);
+    menuHandle_t const added =
+        gui.AddButton(menus[3]->HandleForId(menuMgr, VRMenuId_t(7)), VRMenuId_t(500), "new");
+    AddRecorder(guiSys, added, log);
+    AddRecorder(guiSys, menus[4]->GetRootHandle(), log);
+    CheckFrame(gui, menus, log, "after the hierarchy changed");
+    std::vector<RecordingComponent const*> movedExpected;
+    ExpectedBroadcast(menuMgr, movedObj, movedExpected);
+    Check(!movedExpected.empty(), "the moved subtree has components");
+    CheckFrame(gui, menus, log, "the frame after");
+
+    for (VRMenu* menu : menus) {
+        guiSys.DestroyMenu(menu);
+    }
+}
+
+// A component that changes the hierarchy while handling an update must not make the broadcast
+// skip or repeat components. The recursion read an object's children after its components
+// handled the event, so children added to the handler's own object get the update, and objects
+// the walk had already passed do not.
+static void TestChangesMidBroadcast(HostGuiSys& gui) {
+    OvrGuiSys& guiSys = gui.Get();
+    std::vector<RecordedUpdate> log;
+    std::vector<VRMenuObjectParms const*> itemParms;
+    VRMenu* menu = gui.OpenMenu("changes", OVR::Posef(), itemParms);
+    menuHandle_t const a = gui.AddButton(menu->GetRootHandle(), VRMenuId_t(1), "a");
+    menuHandle_t const b = gui.AddButton(menu->GetRootHandle(), VRMenuId_t(2), "b");
+    RecordingComponent* a1 = AddRecorder(guiSys, a, log);
+    RecordingComponent* a2 = AddRecorder(guiSys, a, log);
+    RecordingComponent* b1 = AddRecorder(guiSys, b, log);
+    RecordingComponent* c1 = nullptr;
+    RecordingComponent* d1 = nullptr;
+    // a1 adds a child to its own object, which is reached after a2
+    a1->OnFirstUpdate = [&](OvrGuiSys& sys, VRMenuObject* self) {
+        c1 = AddRecorder(sys, gui.AddButton(self->GetHandle(), VRMenuId_t(3), "c"), log);
+    };
+    // b1 adds a child to a, which the broadcast has passed
+    b1->OnFirstUpdate = [&](OvrGuiSys& sys, VRMenuObject* /*self*/) {
+        d1 = AddRecorder(sys, gui.AddButton(a, VRMenuId_t(4), "d"), log);
+    };
+
+    log.clear();
+    gui.Frame();
+    Check(c1 != nullptr && d1 != nullptr, "the handlers added their children");
+    CheckOrder(Reached(log, menu), {a1, a2, c1, b1}, "changes during the frame");
+    CheckFrame(gui, {menu}, log, "the frame after the changes");
+    CheckOrder(Reached(log, menu), {a1, a2, c1, d1, b1}, "the added components in tree order");
+
+    guiSys.DestroyMenu(menu);
+}
+
+int main() {
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("FAIL could not create a GL context\n");
+        return 1;
+    }
+
+    TestManyMenus(gui);
+    TestChangesMidBroadcast(gui);
+
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuFrameBenchmark.cpp
+Content     :   Times a GuiSys frame with many menus of components open, with and without the
+                components wanting frame updates, and the frame update broadcasts of such a frame
+                through the recursive walk they replaced.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "MenuBroadcastScene.h"
+
+using namespace OVRFW;
+
+template <typename Function>
+static double MicrosecondsPerRun(int const runs, Function&& function) {
+    function(); // warm up caches
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        function();
+    }
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / runs;
+}
+
+int main(int argc, char** argv) {
+    int const numMenus = argc > 1 ? atoi(argv[1]) : 30;
+    int const objectsPerMenu = argc > 2 ? atoi(argv[2]) : 300;
+    int const frames = argc > 3 ? atoi(argv[3]) : 200;
+    if (numMenus <= 0 || objectsPerMenu <= 0 || frames <= 0) {
+        printf("usage: %s [menus] [objects per menu] [frames]\n", argv[0]);
+        return 1;
+    }
+
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("could not create a GL context\n");
+        return 1;
+    }
+    OvrGuiSys& guiSys = gui.Get();
+    std::vector<RecordedUpdate> log;
+    std::vector<VRMenu*> menus;
+    for (int m = 0; m < numMenus; ++m) {
+        std::string const name = "menu" + std::to_string(m);
+        menus.push_back(OpenRecordingMenu(gui, name.c_str(), objectsPerMenu, 8, log));
+    }
+    gui.Frame();
+    log.clear();
+    gui.Frame();
+    size_t const updatesPerFrame = log.size();
+
+    double const frame = MicrosecondsPerRun(frames, [&] {
+        log.clear();
+        gui.Frame();
+    });
+    ovrApplFrameIn vrFrame;
+    VRMenuEvent const event(
+        VRMENU_EVENT_FRAME_UPDATE,
+        EVENT_DISPATCH_BROADCAST,
+        menuHandle_t(),
+        OVR::Vector3f(0.0f),
+        HitTestResult(),
+        "");
+    double const recursive = MicrosecondsPerRun(frames, [&] {
+        log.clear();
+        for (VRMenu* menu : menus) {
+            VRMenuObject* root = guiSys.GetVRMenuMgr().ToObject(menu->GetRootHandle());
+            RecursiveBroadcast(guiSys, vrFrame, event, root);
+        }
+    });
+    // the frame without delivering updates, so the broadcasts' share of it shows
+    std::vector<RecordedUpdate> const updated = log;
+    for (RecordedUpdate const& update : updated) {
+        const_cast<RecordingComponent*>(update.Component)->StopUpdates();
+    }
+    double const idle = MicrosecondsPerRun(frames, [&] {
+        log.clear();
+        gui.Frame();
+    });
+
+    printf(
+        "%d menus of %d objects, %zu frame updates a frame\n",
+        numMenus,
+        objectsPerMenu,
+        updatesPerFrame);
+    printf("%-36s %9.1f us\n", "GuiSys frame", frame);
+    printf("%-36s %9.1f us\n", "  without frame updates", idle);
+    printf("%-36s %9.1f us\n", "frame updates by the recursive walk", recursive);
+
+    for (VRMenu* menu : menus) {
+        guiSys.DestroyMenu(menu);
+    }
+    return 0;
+}
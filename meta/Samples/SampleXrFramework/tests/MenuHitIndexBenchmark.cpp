@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuHitIndexBenchmark.cpp
+Content     :   Times GUI ray hit tests over menus with thousands of buttons, through the menu
+                hit index and by hit testing each menu's object tree.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <vector>
+
+#include "MenuHitScene.h"
+
+using namespace OVRFW;
+using OVR::Posef;
+using OVR::Quatf;
+using OVR::Vector3f;
+
+template <typename Function>
+static double MillisecondsPerRun(int const runs, Function&& function) {
+    function(); // warm up caches
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        function();
+    }
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+int main(int argc, char** argv) {
+    int const columns = argc > 1 ? atoi(argv[1]) : 50;
+    int const rows = argc > 2 ? atoi(argv[2]) : 40;
+    int const runs = argc > 3 ? atoi(argv[3]) : 3;
+
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("could not create a GL context\n");
+        return 1;
+    }
+    OvrGuiSys& guiSys = gui.Get();
+
+    // one flat menu, so that every button is hit testable although only the first
+    // MAX_SUBMITTED objects are rendered
+    std::vector<VRMenu*> menus;
+    menus.push_back(OpenButtonGrid(
+        gui, "buttons", Posef(Quatf(), Vector3f(0.0f, 0.0f, -2.0f)), columns, rows, 1, false));
+    gui.Frame();
+    int const numObjects = CountObjects(guiSys, menus);
+
+    std::vector<Vector3f> starts;
+    std::vector<Vector3f> dirs;
+    MakeRays(guiSys, menus, Vector3f(0.0f), 1, starts, dirs);
+    // two controllers and the gaze cursor test a handful of rays per frame
+    size_t const raysPerFrame = 3;
+    size_t const frames = starts.size() / raysPerFrame;
+
+    double const reference = MillisecondsPerRun(runs, [&] {
+        for (size_t i = 0; i < starts.size(); ++i) {
+            ReferenceHitTest(guiSys, menus, starts[i], dirs[i]);
+        }
+    });
+    double const indexed = MillisecondsPerRun(runs, [&] {
+        for (size_t i = 0; i < starts.size(); ++i) {
+            guiSys.TestRayIntersection(starts[i], dirs[i]);
+        }
+    });
+
+    // a few buttons animate every frame, so the first query of each frame refits the index
+    std::vector<VRMenuObject*> animated;
+    for (int i = 0; i < 16; ++i) {
+        animated.push_back(gui.ObjectForId(menus[0], VRMenuId_t(2 + i * 37)));
+    }
+    int frame = 0;
+    double const refitFrame = MillisecondsPerRun(runs * 10, [&] {
+        frame++;
+        for (VRMenuObject* obj : animated) {
+            if (obj != nullptr) {
+                Posef pose = obj->GetLocalPose();
+                pose.Translation.z = (frame & 1) * 0.01f;
+                obj->SetLocalPose(pose);
+            }
+        }
+        for (size_t i = 0; i < raysPerFrame; ++i) {
+            size_t const ray = (frame * raysPerFrame + i) % starts.size();
+            guiSys.TestRayIntersection(starts[ray], dirs[ray]);
+        }
+    });
+
+    printf("%d objects, %zu rays\n", numObjects, starts.size());
+    printf(
+        "per-menu hit test: %8.4f ms per frame of %zu rays\n",
+        reference / frames,
+        raysPerFrame);
+    printf(
+        "hit index:         %8.4f ms per frame of %zu rays\n", indexed / frames, raysPerFrame);
+    printf("hit index, %zu objects moving: %8.4f ms per frame\n", animated.size(), refitFrame);
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuHitIndexTest.cpp
+Content     :   Checks that OvrGuiSys::TestRayIntersection, which goes through the menu hit
+                index, returns the same results as hit testing each menu's object tree, before
+                and after objects and menus move.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "MenuHitScene.h"
+
+using namespace OVRFW;
+using OVR::Posef;
+using OVR::Quatf;
+using OVR::Vector3f;
+
+static int s_failures = 0;
+
+// the ids of menu i start at (i + 1) * MENU_ID_RANGE
+static int const MENU_ID_RANGE = 1000;
+
+// Tests every ray through GuiSys and against the reference, and checks that they agree.
+static void CheckRays(
+    HostGuiSys& gui,
+    std::vector<VRMenu*> const& menus,
+    unsigned int const seed,
+    char const* what) {
+    OvrGuiSys& guiSys = gui.Get();
+    std::vector<Vector3f> starts;
+    std::vector<Vector3f> dirs;
+    MakeRays(guiSys, menus, Vector3f(0.0f, 0.1f, 0.3f), seed, starts, dirs);
+
+    int hits = 0;
+    std::vector<int> menuHits(menus.size(), 0);
+    int mismatches = 0;
+    for (size_t i = 0; i < starts.size(); ++i) {
+        HitTestResult const expected = ReferenceHitTest(guiSys, menus, starts[i], dirs[i]);
+        HitTestResult const actual = guiSys.TestRayIntersection(starts[i], dirs[i]);
+        if (actual.HitHandle != expected.HitHandle || actual.t != expected.t ||
+            actual.uv != expected.uv) {
+            if (mismatches++ == 0) {
+                printf(
+                    "FAIL %s: ray %zu hit %llu at t=%f, expected %llu at t=%f\n",
+                    what,
+                    i,
+                    static_cast<unsigned long long>(actual.HitHandle.Get()),
+                    actual.t,
+                    static_cast<unsigned long long>(expected.HitHandle.Get()),
+                    expected.t);
+            }
+        }
+        if (expected.HitHandle.IsValid()) {
+            hits++;
+            VRMenuObject const* obj = guiSys.GetVRMenuMgr().ToObject(expected.HitHandle);
+            menuHits[obj->GetId().Get() / MENU_ID_RANGE - 1]++;
+        }
+    }
+    if (mismatches != 0) {
+        printf("FAIL %s: %d of %zu rays differ\n", what, mismatches, starts.size());
+        s_failures++;
+    }
+    // the rays must exercise both hits and misses, in every menu, to mean anything
+    if (hits < static_cast<int>(starts.size()) / 4 || hits == static_cast<int>(starts.size())) {
+        printf("FAIL %s: %d of %zu rays hit\n", what, hits, starts.size());
+        s_failures++;
+    }
+    for (size_t m = 0; m < menus.size(); ++m) {
+        if (menuHits[m] == 0) {
+            printf("FAIL %s: no ray hit menu '%s'\n", what, menus[m]->GetName());
+            s_failures++;
+        }
+    }
+}
+
+int main() {
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("FAIL could not create a GL context\n");
+        return 1;
+    }
+
+    // Nested buttons are only hit testable once they have been submitted for rendering, so the
+    // menus stay below VRMenuMgr's MAX_SUBMITTED objects.
+    std::vector<VRMenu*> menus;
+    menus.push_back(OpenButtonGrid(
+        gui, "near", Posef(Quatf(), Vector3f(0.0f, 0.0f, -1.0f)), 6, 5, MENU_ID_RANGE, true));
+    menus.push_back(OpenButtonGrid(
+        gui,
+        "far",
+        Posef(Quatf(Vector3f(0.0f, 1.0f, 0.0f), 0.3f), Vector3f(0.2f, 0.1f, -1.6f)),
+        8,
+        6,
+        2 * MENU_ID_RANGE,
+        true));
+    // in front of part of "near", at the same depth as its buttons in places
+    menus.push_back(OpenButtonGrid(
+        gui,
+        "overlap",
+        Posef(Quatf(), Vector3f(0.3f, 0.2f, -1.0f)),
+        3,
+        3,
+        3 * MENU_ID_RANGE,
+        true));
+    for (int i = 0; i < 3; ++i) {
+        gui.Frame();
+    }
+    CheckRays(gui, menus, 1, "initial");
+
+    // move some buttons, which refits the index instead of rebuilding it
+    HitSceneRandom random(2);
+    for (int id = MENU_ID_RANGE; id < MENU_ID_RANGE + 6 * 5 * 2; id += 3) {
+        VRMenuObject* obj = gui.ObjectForId(menus[0], VRMenuId_t(id));
+        if (obj != nullptr) {
+            Posef pose = obj->GetLocalPose();
+            pose.Translation += Vector3f(random.Next(), random.Next(), random.Next()) * 0.15f;
+            obj->SetLocalPose(pose);
+        }
+    }
+    gui.Frame();
+    CheckRays(gui, menus, 3, "after moving buttons");
+
+    // scaling a parent moves its whole subtree
+    VRMenuObject* parent = gui.ObjectForId(menus[1], VRMenuId_t(2 * MENU_ID_RANGE + 10));
+    if (parent != nullptr) {
+        parent->SetLocalScale(Vector3f(2.5f));
+    }
+    gui.Frame();
+    CheckRays(gui, menus, 4, "after scaling a button");
+
+    // move without a frame in between, as input handling can
+    VRMenuObject* button = gui.ObjectForId(menus[2], VRMenuId_t(3 * MENU_ID_RANGE + 1));
+    if (button != nullptr) {
+        button->SetLocalPose(Posef(Quatf(), Vector3f(-0.3f, -0.2f, 0.05f)));
+    }
+    CheckRays(gui, menus, 5, "without a frame after moving");
+
+    // moving a menu moves everything in it
+    menus[0]->SetMenuPose(
+        Posef(Quatf(Vector3f(1.0f, 0.0f, 0.0f), -0.2f), Vector3f(0.05f, 0.0f, -1.1f)));
+    gui.Frame();
+    CheckRays(gui, menus, 6, "after moving a menu");
+
+    // adding objects changes the flattened hierarchy, so the index is rebuilt
+    std::vector<VRMenuObjectParms const*> parms;
+    for (int i = 0; i < 20; ++i) {
+        parms.push_back(gui.ButtonParms(
+            VRMenuId_t(3 * MENU_ID_RANGE + 500 + i), Posef(Quatf(), Vector3f(i * 0.05f - 0.5f, 0.4f, 0.02f))));
+    }
+    menus[2]->AddItems(gui.Get(), parms, menus[2]->GetRootHandle(), false);
+    for (VRMenuObjectParms const* p : parms) {
+        delete p;
+    }
+    gui.Frame();
+    CheckRays(gui, menus, 7, "after adding buttons");
+
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
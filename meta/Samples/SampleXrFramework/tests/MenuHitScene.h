@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuHitScene.h
+Content     :   Menus of buttons and the per-menu hit test that the menu hit index replaced,
+                shared by the hit index test and benchmark.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "HostGuiSys.h"
+
+namespace OVRFW {
+
+// Opens a menu with a backdrop and a grid of columns x rows buttons in front of it. Every other
+// button has a second one at the same depth that overlaps it, so that rays see ties. If nested,
+// each button also has a smaller button in front of it as its child. Ids start at firstId.
+//
+// VRMenuMgr only submits the first MAX_SUBMITTED objects each frame and objects that were never
+// submitted have empty cull bounds, so children of those can not be hit. Without nesting the
+// backdrop's bounds keep every button hit testable however many there are.
+inline VRMenu* OpenButtonGrid(
+    HostGuiSys& gui,
+    char const* name,
+    OVR::Posef const& menuPose,
+    int const columns,
+    int const rows,
+    int const firstId,
+    bool const nested) {
+    float const buttonSize = 64.0f * VRMenuObject::DEFAULT_TEXEL_SCALE;
+    std::vector<VRMenuObjectParms const*> parms;
+    int id = firstId;
+    parms.push_back(gui.ButtonParms(
+        VRMenuId_t(id++),
+        OVR::Posef(OVR::Quatf(), OVR::Vector3f(-0.06f, -0.06f, -0.05f)),
+        OVR::Vector3f(columns * 0.12f / buttonSize, rows * 0.12f / buttonSize, 1.0f)));
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            OVR::Vector3f const pos((x - columns * 0.5f) * 0.12f, (y - rows * 0.5f) * 0.12f, 0.0f);
+            VRMenuId_t const buttonId(id++);
+            parms.push_back(gui.ButtonParms(buttonId, OVR::Posef(OVR::Quatf(), pos)));
+            if (nested) {
+                parms.push_back(gui.ButtonParms(
+                    VRMenuId_t(id++),
+                    OVR::Posef(OVR::Quatf(), OVR::Vector3f(0.02f, 0.0f, 0.01f)),
+                    OVR::Vector3f(0.5f),
+                    buttonId));
+            }
+            if (((x + y) & 1) == 0) {
+                parms.push_back(gui.ButtonParms(
+                    VRMenuId_t(id++),
+                    OVR::Posef(OVR::Quatf(), pos + OVR::Vector3f(0.05f, 0.03f, 0.0f))));
+            }
+        }
+    }
+    return gui.OpenMenu(name, menuPose, parms);
+}
+
+// Hit tests each menu's object tree in turn, the way OvrGuiSys::TestRayIntersection did before
+// the menu hit index. menus must be in the order they were opened.
+inline HitTestResult ReferenceHitTest(
+    OvrGuiSys& guiSys,
+    std::vector<VRMenu*> const& menus,
+    OVR::Vector3f const& start,
+    OVR::Vector3f const& dir) {
+    HitTestResult result;
+    for (int i = static_cast<int>(menus.size()) - 1; i >= 0; --i) {
+        VRMenuObject* root = guiSys.GetVRMenuMgr().ToObject(menus[i]->GetRootHandle());
+        if (root == nullptr) {
+            continue;
+        }
+        HitTestResult r;
+        menuHandle_t const hitHandle = root->HitTest(
+            guiSys, menus[i]->GetMenuPose(), start, dir, ContentFlags_t(CONTENT_SOLID), r);
+        if (hitHandle.IsValid() && r.t < result.t) {
+            result = r;
+            result.RayStart = start;
+            result.RayDir = dir;
+        }
+    }
+    return result;
+}
+
+// Number of objects in the menus, including their roots.
+inline int CountObjects(OvrGuiSys& guiSys, std::vector<VRMenu*> const& menus) {
+    int count = 0;
+    for (VRMenu const* menu : menus) {
+        std::vector<menuHandle_t> pending(1, menu->GetRootHandle());
+        while (!pending.empty()) {
+            VRMenuObject const* obj = guiSys.GetVRMenuMgr().ToObject(pending.back());
+            pending.pop_back();
+            if (obj != nullptr) {
+                count++;
+                for (int i = 0; i < obj->NumChildren(); ++i) {
+                    pending.push_back(obj->GetChildHandleForIndex(i));
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Small deterministic generator so that runs are repeatable.
+class HitSceneRandom {
+   public:
+    explicit HitSceneRandom(unsigned int const seed) : State(seed) {}
+
+    // uniform in [-1, 1]
+    float Next() {
+        State = State * 1664525u + 1013904223u;
+        return static_cast<float>(State >> 8) / static_cast<float>(1 << 23) - 1.0f;
+    }
+
+   private:
+    unsigned int State;
+};
+
+// Rays from eye toward every object in the menus, jittered so that some of them graze edges or
+// miss, plus rays in random directions.
+inline void MakeRays(
+    OvrGuiSys& guiSys,
+    std::vector<VRMenu*> const& menus,
+    OVR::Vector3f const& eye,
+    unsigned int const seed,
+    std::vector<OVR::Vector3f>& starts,
+    std::vector<OVR::Vector3f>& dirs) {
+    HitSceneRandom random(seed);
+    starts.clear();
+    dirs.clear();
+    OvrVRMenuMgr& menuMgr = guiSys.GetVRMenuMgr();
+    for (VRMenu const* menu : menus) {
+        std::vector<menuHandle_t> pending(1, menu->GetRootHandle());
+        while (!pending.empty()) {
+            VRMenuObject const* obj = menuMgr.ToObject(pending.back());
+            pending.pop_back();
+            if (obj == nullptr) {
+                continue;
+            }
+            for (int i = 0; i < obj->NumChildren(); ++i) {
+                pending.push_back(obj->GetChildHandleForIndex(i));
+            }
+            OVR::Posef pose;
+            OVR::Vector3f scale;
+            OVR::Vector4f color;
+            obj->GetWorldTransform(menuMgr, menu->GetMenuPose(), pose, scale, color);
+            for (int i = 0; i < 3; ++i) {
+                OVR::Vector3f const target = pose.Translation +
+                    OVR::Vector3f(random.Next(), random.Next(), random.Next()) * 0.08f;
+                starts.push_back(eye);
+                dirs.push_back((target - eye).Normalized());
+            }
+        }
+    }
+    size_t const numAimed = dirs.size();
+    for (size_t i = 0; i < numAimed / 4; ++i) {
+        starts.push_back(eye);
+        dirs.push_back(OVR::Vector3f(random.Next(), random.Next(), -1.0f).Normalized());
+    }
+}
+
+} // namespace OVRFW
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuObjectIndexBenchmark.cpp
+Content     :   Times finding objects of a 10k-object menu by id and by name, through the menu
+                manager's index and by walking the menu as VRMenu did before.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "HostGuiSys.h"
+
+using namespace OVRFW;
+
+template <typename Function>
+static double NanosecondsPerOp(int const runs, int const ops, Function&& function) {
+    function(); // warm up caches
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        function();
+    }
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / runs / ops;
+}
+
+// Keeps the results alive, so the compiler can't drop the lookups.
+static uint64_t s_sink = 0;
+
+int main(int argc, char** argv) {
+    int const numObjects = argc > 1 ? atoi(argv[1]) : 10000;
+    int const runs = argc > 2 ? atoi(argv[2]) : 3;
+    int const fanOut = 16;
+    if (numObjects <= 0 || runs <= 0) {
+        printf("usage: %s [objects] [runs]\n", argv[0]);
+        return 1;
+    }
+
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("could not create a GL context\n");
+        return 1;
+    }
+    OvrVRMenuMgr const& menuMgr = gui.Get().GetVRMenuMgr();
+    std::vector<VRMenuObjectParms const*> itemParms;
+    VRMenu* menu = gui.OpenMenu("objects", OVR::Posef(), itemParms);
+
+    // a tree fanOut wide, filled breadth-first, as nested panels and lists are
+    std::vector<menuHandle_t> handles;
+    std::vector<std::string> names;
+    for (int i = 0; i < numObjects; ++i) {
+        menuHandle_t const parent = i < fanOut ? menu->GetRootHandle() : handles[i / fanOut - 1];
+        names.push_back("object_" + std::to_string(i));
+        handles.push_back(gui.AddButton(parent, VRMenuId_t(i + 1), names.back().c_str()));
+    }
+
+    // every object once, in an order unrelated to the tree
+    std::vector<int> order(numObjects);
+    for (int i = 0; i < numObjects; ++i) {
+        order[i] = static_cast<int>((i * 7919LL) % numObjects);
+    }
+    VRMenuObject const* root = menuMgr.ToObject(menu->GetRootHandle());
+    auto report = [](char const* name, double ns) { printf("%-28s %10.1f ns\n", name, ns); };
+
+    printf("%d objects\n", numObjects);
+    report("HandleForId", NanosecondsPerOp(runs, numObjects, [&] {
+               for (int const i : order) {
+                   s_sink += menu->HandleForId(menuMgr, VRMenuId_t(i + 1)).Get();
+               }
+           }));
+    report("  walk", NanosecondsPerOp(runs, numObjects, [&] {
+               for (int const i : order) {
+                   s_sink += root->ChildHandleForId(menuMgr, VRMenuId_t(i + 1)).Get();
+               }
+           }));
+    report("HandleForName", NanosecondsPerOp(runs, numObjects, [&] {
+               for (int const i : order) {
+                   s_sink += menu->HandleForName(menuMgr, names[i].c_str()).Get();
+               }
+           }));
+    report("  walk", NanosecondsPerOp(runs, numObjects, [&] {
+               for (int const i : order) {
+                   s_sink += root->ChildHandleForName(menuMgr, names[i].c_str()).Get();
+               }
+           }));
+
+    gui.Get().DestroyMenu(menu);
+    return s_sink == 12345 ? 2 : 0;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuObjectIndexTest.cpp
+Content     :   Checks the menu manager's id and name index against walking the menu, after
+                objects are freed, reparented, and when several descendants match.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "HostGuiSys.h"
+
+using namespace OVRFW;
+
+static int s_failures = 0;
+
+static void Check(bool const condition, char const* what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        s_failures++;
+    }
+}
+
+static VRMenu* OpenEmptyMenu(HostGuiSys& gui, char const* name) {
+    std::vector<VRMenuObjectParms const*> itemParms;
+    return gui.OpenMenu(name, OVR::Posef(), itemParms);
+}
+
+// The index must find what the depth-first walk finds, for every id and name in the menu.
+static void CheckAgainstWalk(
+    OvrVRMenuMgr const& menuMgr,
+    VRMenu const* menu,
+    std::vector<long long> const& ids,
+    std::vector<std::string> const& names,
+    char const* what) {
+    menuHandle_t const rootHandle = menu->GetRootHandle();
+    VRMenuObject const* root = menuMgr.ToObject(rootHandle);
+    int mismatches = 0;
+    for (long long const id : ids) {
+        if (menuMgr.FindDescendantById(rootHandle, VRMenuId_t(id)) !=
+            root->ChildHandleForId(menuMgr, VRMenuId_t(id))) {
+            mismatches++;
+        }
+    }
+    for (std::string const& name : names) {
+        if (menuMgr.FindDescendantByName(rootHandle, name.c_str()) !=
+            root->ChildHandleForName(menuMgr, name.c_str())) {
+            mismatches++;
+        }
+    }
+    if (mismatches > 0) {
+        printf("FAIL %s: %d lookups differ from the walk\n", what, mismatches);
+        s_failures += mismatches;
+    }
+}
+
+// A freed object must not be found through its id, its name or its old handle, even once its
+// slot holds a new object with the same id and name.
+static void TestStaleHandles(HostGuiSys& gui) {
+    OvrVRMenuMgr& menuMgr = gui.Get().GetVRMenuMgr();
+    VRMenu* menu = OpenEmptyMenu(gui, "stale");
+    menuHandle_t const rootHandle = menu->GetRootHandle();
+    menuHandle_t const parent = gui.AddButton(rootHandle, VRMenuId_t(100), "parent");
+    menuHandle_t const child = gui.AddButton(parent, VRMenuId_t(101), "child");
+    menuHandle_t const other = gui.AddButton(rootHandle, VRMenuId_t(102), "other");
+    Check(menu->HandleForId(menuMgr, VRMenuId_t(101)) == child, "a child is found by id");
+    Check(menu->HandleForName(menuMgr, "CHILD") == child, "names are case-insensitive");
+
+    // freeing the parent frees the child with it
+    menuMgr.FreeObject(parent);
+    // IsValid only checks that a handle is well formed, ToObject checks that it is live
+    Check(
+        menuMgr.ToObject(parent) == nullptr && menuMgr.ToObject(child) == nullptr,
+        "freed handles have no object");
+    Check(!menu->HandleForId(menuMgr, VRMenuId_t(100)).IsValid(), "a freed id is not found");
+    Check(!menu->HandleForId(menuMgr, VRMenuId_t(101)).IsValid(), "a freed child's id is gone");
+    Check(!menu->HandleForName(menuMgr, "child").IsValid(), "a freed name is not found");
+    Check(menu->HandleForId(menuMgr, VRMenuId_t(102)) == other, "the others are still found");
+    Check(
+        !menuMgr.FindDescendantById(child, VRMenuId_t(101)).IsValid(),
+        "a freed root finds nothing");
+
+    // the freed slots are reused, under new handles
+    menuHandle_t const reused = gui.AddButton(rootHandle, VRMenuId_t(101), "child");
+    Check(reused != child, "a reused slot gets a new handle");
+    Check(menuMgr.ToObject(child) == nullptr, "the old handle stays stale");
+    Check(menu->HandleForId(menuMgr, VRMenuId_t(101)) == reused, "the new object is found");
+    Check(menu->HandleForName(menuMgr, "child") == reused, "the new object is found by name");
+    CheckAgainstWalk(menuMgr, menu, {100, 101, 102}, {"parent", "child", "other"}, "stale");
+
+    gui.Get().DestroyMenu(menu);
+}
+
+// Moving an object to another menu must move its subtree's lookups with it.
+static void TestReparent(HostGuiSys& gui) {
+    OvrVRMenuMgr& menuMgr = gui.Get().GetVRMenuMgr();
+    VRMenu* from = OpenEmptyMenu(gui, "from");
+    VRMenu* to = OpenEmptyMenu(gui, "to");
+    menuHandle_t const moved = gui.AddButton(from->GetRootHandle(), VRMenuId_t(200), "moved");
+    menuHandle_t const child = gui.AddButton(moved, VRMenuId_t(201), "moved_child");
+    menuHandle_t const target = gui.AddButton(to->GetRootHandle(), VRMenuId_t(300), "target");
+    Check(from->HandleForId(menuMgr, VRMenuId_t(201)) == child, "found before the move");
+    Check(!to->HandleForId(menuMgr, VRMenuId_t(201)).IsValid(), "not found in the other menu");
+
+    menuMgr.ToObject(from->GetRootHandle())->RemoveChild(menuMgr, moved);
+    menuMgr.ToObject(target)->AddChild(menuMgr, moved);
+    Check(!from->HandleForId(menuMgr, VRMenuId_t(200)).IsValid(), "gone from the old menu");
+    Check(!from->HandleForName(menuMgr, "moved_child").IsValid(), "its child is gone too");
+    Check(to->HandleForId(menuMgr, VRMenuId_t(200)) == moved, "found in the new menu");
+    Check(to->HandleForId(menuMgr, VRMenuId_t(201)) == child, "its child is found by id");
+    Check(to->HandleForName(menuMgr, "moved_child") == child, "its child is found by name");
+    Check(
+        menuMgr.FindDescendantById(target, VRMenuId_t(201)) == child,
+        "found below the new parent");
+    CheckAgainstWalk(menuMgr, from, {200, 201, 300}, {"moved", "moved_child"}, "old menu");
+    CheckAgainstWalk(menuMgr, to, {200, 201, 300}, {"moved", "moved_child"}, "new menu");
+
+    // a detached object belongs to no menu
+    menuMgr.ToObject(target)->RemoveChild(menuMgr, moved);
+    Check(!to->HandleForId(menuMgr, VRMenuId_t(201)).IsValid(), "a detached object is gone");
+    menuMgr.FreeObject(moved);
+
+    gui.Get().DestroyMenu(from);
+    gui.Get().DestroyMenu(to);
+}
+
+// Ids and names need not be unique. When several descendants match, the lookup must still
+// return the first in depth-first order, as the walk did, not the first the index holds. The
+// index is unordered, so the duplicates are created both in tree order and in reverse.
+static void TestDuplicates(HostGuiSys& gui, bool const treeOrder) {
+    OvrVRMenuMgr& menuMgr = gui.Get().GetVRMenuMgr();
+    VRMenu* menu = OpenEmptyMenu(gui, "duplicates");
+    VRMenu* elsewhere = OpenEmptyMenu(gui, "elsewhere");
+    menuHandle_t const rootHandle = menu->GetRootHandle();
+    menuHandle_t const first = gui.AddButton(rootHandle, VRMenuId_t(400), "first");
+    menuHandle_t const second = gui.AddButton(rootHandle, VRMenuId_t(401), "second");
+    menuHandle_t early;
+    menuHandle_t late;
+    if (treeOrder) {
+        early = gui.AddButton(first, VRMenuId_t(500), "same");
+        late = gui.AddButton(second, VRMenuId_t(500), "Same");
+    } else {
+        late = gui.AddButton(second, VRMenuId_t(500), "Same");
+        early = gui.AddButton(first, VRMenuId_t(500), "same");
+    }
+    // the same id in another menu must not count as a duplicate
+    menuHandle_t const foreign = gui.AddButton(elsewhere->GetRootHandle(), VRMenuId_t(401), "x");
+
+    Check(menu->HandleForId(menuMgr, VRMenuId_t(500)) == early, "the first duplicate id wins");
+    Check(menu->HandleForName(menuMgr, "SAME") == early, "the first duplicate name wins");
+    Check(
+        menuMgr.FindDescendantById(second, VRMenuId_t(500)) == late,
+        "a duplicate is found below its own branch");
+    Check(menu->HandleForId(menuMgr, VRMenuId_t(401)) == second, "ids repeat across menus");
+    Check(elsewhere->HandleForId(menuMgr, VRMenuId_t(401)) == foreign, "in either menu");
+    CheckAgainstWalk(menuMgr, menu, {400, 401, 500}, {"first", "second", "same"}, "duplicates");
+
+    // once one duplicate is freed, the other is found through the index alone
+    menuMgr.FreeObject(early);
+    Check(menu->HandleForId(menuMgr, VRMenuId_t(500)) == late, "the remaining duplicate wins");
+    Check(menu->HandleForName(menuMgr, "same") == late, "by name too");
+
+    gui.Get().DestroyMenu(menu);
+    gui.Get().DestroyMenu(elsewhere);
+}
+
+int main() {
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("FAIL could not create a GL context\n");
+        return 1;
+    }
+
+    TestStaleHandles(gui);
+    TestReparent(gui);
+    TestDuplicates(gui, true);
+    TestDuplicates(gui, false);
+
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
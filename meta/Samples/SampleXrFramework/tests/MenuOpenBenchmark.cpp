@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuOpenBenchmark.cpp
+Content     :   Times opening a large menu through VRMenu::InitFromReflectionData, from the
+                reflection text and from the data CompileReflectionData makes of it.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GUI/ReflectionBinary.h"
+
+#include "HostGuiSys.h"
+#include "HostLocale.h"
+#include "MenuReflectionScene.h"
+
+using namespace OVRFW;
+using OVR::Posef;
+using OVR::Quatf;
+using OVR::Vector3f;
+
+static bool WriteFile(std::string const& path, void const* data, size_t const size) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(static_cast<char const*>(data), size);
+    return file.good();
+}
+
+// Opens the menu in fileName the way an app does, and renders a frame of it. Returns the time
+// it took, or a negative time if the menu failed to load.
+static double OpenMenuMilliseconds(
+    HostGuiSys& gui,
+    ovrFileSys& fileSys,
+    ovrReflection& refl,
+    ovrLocale const& locale,
+    std::string const& fileName) {
+    OvrGuiSys& guiSys = gui.Get();
+    char const* fileNames[] = {fileName.c_str(), nullptr};
+    auto const start = std::chrono::steady_clock::now();
+    VRMenu* menu = VRMenu::Create("generated");
+    if (!menu->InitFromReflectionData(
+            guiSys, fileSys, refl, locale, fileNames, 1.0f, VRMenuFlags_t())) {
+        // the menu is leaked, the benchmark stops here
+        return -1.0;
+    }
+    menu->SetMenuPose(Posef(Quatf(), Vector3f(0.0f, 0.0f, -2.0f)));
+    guiSys.AddMenu(menu);
+    guiSys.OpenMenu("generated");
+    gui.Frame();
+    auto const end = std::chrono::steady_clock::now();
+    guiSys.DestroyMenu(menu);
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename Function>
+static double BestOf(int const runs, Function&& open) {
+    double best = 0.0;
+    for (int run = 0; run < runs; ++run) {
+        double const ms = open();
+        if (ms < 0.0) {
+            return ms;
+        }
+        best = run == 0 || ms < best ? ms : best;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int const numObjects = argc > 1 ? atoi(argv[1]) : 5000;
+    int const runs = argc > 2 ? atoi(argv[2]) : 3;
+    if (numObjects <= 0 || runs <= 0) {
+        printf("usage: %s [objects] [runs]\n", argv[0]);
+        return 1;
+    }
+
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("could not create a GL context\n");
+        return 1;
+    }
+    // paths are host paths, so the menu's files are written to a temporary directory
+    std::filesystem::path const dir =
+        std::filesystem::temp_directory_path() / "MenuOpenBenchmark";
+    std::filesystem::create_directories(dir);
+    std::string const textName = (dir / "menu.txt").string();
+    std::string const binaryName = textName + ".bin";
+    std::filesystem::remove(binaryName);
+
+    HostFileSys fileSys(false);
+    HostLocale locale;
+    ovrReflection* refl = ovrReflection::Create();
+    std::string const text = MakeMenuReflectionText(numObjects);
+    if (!WriteFile(textName, text.data(), text.size())) {
+        printf("could not write %s\n", textName.c_str());
+        return 1;
+    }
+
+    double const textMs = BestOf(runs, [&] {
+        return OpenMenuMilliseconds(gui, fileSys, *refl, locale, textName);
+    });
+
+    // HostFileSys can't open streams for CompileReflectionData to write to, so this writes
+    // what it would have written
+    std::vector<uint8_t> source(text.begin(), text.end());
+    source.push_back('\0');
+    std::vector<uint8_t> compiled;
+    ovrParseResult const result =
+        VRMenuObject::CompileItemParms(*refl, locale, textName.c_str(), source, compiled);
+    if (!result || !WriteFile(binaryName, compiled.data(), compiled.size())) {
+        printf("could not compile %s\n", textName.c_str());
+        return 1;
+    }
+    {
+        // InitFromReflectionData silently falls back to the text if the data is stale
+        ovrReflectionBinaryReader reader(*refl, locale);
+        if (!reader.Load(fileSys, binaryName.c_str(), source)) {
+            printf("the compiled data does not load\n");
+            return 1;
+        }
+    }
+    double const binaryMs = BestOf(runs, [&] {
+        return OpenMenuMilliseconds(gui, fileSys, *refl, locale, textName);
+    });
+
+    std::filesystem::remove_all(dir);
+    ovrReflection::Destroy(refl);
+    if (textMs < 0.0 || binaryMs < 0.0) {
+        printf("the menu failed to load\n");
+        return 1;
+    }
+
+    printf(
+        "%d objects, %zu bytes of text, %zu bytes compiled\n",
+        numObjects,
+        text.size(),
+        compiled.size());
+    printf("%-28s %9.2f ms\n", "open from text", textMs);
+    printf("%-28s %9.2f ms\n", "open from compiled data", binaryMs);
+    return 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MenuReflectionScene.h
+Content     :   A generated menu reflection file, and the linear reflection lookups that the
+                hash tables replaced, shared by the reflection tests and benchmarks.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "GUI/Reflection.h"
+#include "GUI/VRMenuComponent.h"
+#include "GUI/VRMenuObject.h"
+#include "OVR_Std.h"
+
+namespace OVRFW {
+
+// The id of object i of a generated menu.
+inline long long MenuObjectId(int const i) {
+    return 1000 + i;
+}
+
+// Writes a menu reflection file of numObjects buttons, with the members, enums, bit flags,
+// vectors and components of a typical menu. Every object after the first is the child of the
+// object before it by id, and of the first by name. Object i is at (i, 2i, 3i). Only the first
+// objects are labelled, since GuiSys's font buffer holds about 2000 glyphs a frame.
+inline std::string MakeMenuReflectionText(int const numObjects) {
+    std::string text = "itemParms\n{\n";
+    char buffer[2048];
+    for (int i = 0; i < numObjects; ++i) {
+        std::string const label = i < 64 ? "Button " + std::to_string(i) : std::string();
+        snprintf(
+            buffer,
+            sizeof(buffer),
+            "\tVRMenuObjectParms\n"
+            "\t{\n"
+            "\t\tType = %s;\n"
+            "\t\tFlags = VRMENUOBJECT_DONT_HIT_TEXT|VRMENUOBJECT_BOUND_ALL;\n"
+            "\t\tInitFlags = VRMENUOBJECT_INIT_FORCE_POSITION;\n"
+            "\t\tComponents\n"
+            "\t\t{\n"
+            "\t\t\tOvrDefaultComponent\n"
+            "\t\t\t{\n"
+            "\t\t\t\tName = \"highlight_%d\";\n"
+            "\t\t\t\tEventFlags = VRMENU_EVENT_FOCUS_GAINED|VRMENU_EVENT_FOCUS_LOST;\n"
+            "\t\t\t\tHilightOffset = ( 0.0, 0.0, 0.05 );\n"
+            "\t\t\t\tHilightScale = 1.05;\n"
+            "\t\t\t}\n"
+            "\t\t}\n"
+            "\t\tSurfaceParms\n"
+            "\t\t{\n"
+            "\t\t\tVRMenuSurfaceParms\n"
+            "\t\t\t{\n"
+            "\t\t\t\tSurfaceName = \"surface_%d\";\n"
+            "\t\t\t\tImageNames\n"
+            "\t\t\t\t{\n"
+            "\t\t\t\t\tstring[0] = \"apk:///assets/button_%d.png\";\n"
+            "\t\t\t\t}\n"
+            "\t\t\t\tTextureTypes\n"
+            "\t\t\t\t{\n"
+            "\t\t\t\t\teSurfaceTextureType[0] = SURFACE_TEXTURE_DIFFUSE;\n"
+            "\t\t\t\t}\n"
+            "\t\t\t\tContents = CONTENT_SOLID;\n"
+            "\t\t\t\tColor = ( 1.0, 0.5, 0.25, 1.0 );\n"
+            "\t\t\t}\n"
+            "\t\t}\n"
+            "\t\tText = \"%s\";\n"
+            "\t\tLocalPose\n"
+            "\t\t{\n"
+            "\t\t\tPosition = ( %d.0, %d.0, %d.0 );\n"
+            "\t\t\tOrientation = ( 0.0, 0.0, 0.0, 1.0 );\n"
+            "\t\t}\n"
+            "\t\tLocalScale = ( 1.0, 1.0, 1.0 );\n"
+            "\t\tColor = ( 1.0, 1.0, 1.0, 1.0 );\n"
+            "\t\tTextColor = ( 0.0, 0.0, 0.0, 1.0 );\n"
+            "\t\tId = %lld;\n"
+            "\t\tParentId = %lld;\n"
+            "\t\tName = \"object_%d\";\n"
+            "\t\tParentName = \"%s\";\n"
+            "\t}\n",
+            (i & 1) ? "VRMENU_BUTTON" : "VRMENU_STATIC",
+            i,
+            i,
+            i,
+            label.c_str(),
+            i,
+            i * 2,
+            i * 3,
+            MenuObjectId(i),
+            i > 0 ? MenuObjectId(i - 1) : MenuObjectId(0) - 1,
+            i,
+            i > 0 ? "object_0" : "");
+        text += buffer;
+    }
+    text += "}\n";
+    return text;
+}
+
+// Parses a menu reflection file the way VRMenu::InitFromReflectionData does.
+inline ovrParseResult ParseMenuReflectionText(
+    ovrReflection& refl,
+    ovrLocale const& locale,
+    std::string const& text,
+    std::vector<VRMenuObjectParms const*>& itemParms) {
+    std::vector<uint8_t> buffer(text.begin(), text.end());
+    buffer.push_back('\0');
+    return VRMenuObject::ParseItemParms(refl, locale, "generated", buffer, itemParms);
+}
+
+// Deletes parsed item parms along with the components that a menu would otherwise take over.
+inline void FreeItemParms(std::vector<VRMenuObjectParms const*>& itemParms) {
+    for (VRMenuObjectParms const* parms : itemParms) {
+        for (VRMenuComponent* component : parms->Components) {
+            delete component;
+        }
+        delete parms;
+    }
+    itemParms.clear();
+}
+
+// The lookups as ovrReflection made them before it hashed them: the first match in the
+// earliest list wins.
+inline ovrTypeInfo const* LinearFindTypeInfo(
+    std::vector<ovrTypeInfo const*> const& lists,
+    char const* typeName) {
+    for (ovrTypeInfo const* list : lists) {
+        for (int i = 0; list[i].TypeName != nullptr; ++i) {
+            if (OVR::OVR_strcmp(list[i].TypeName, typeName) == 0) {
+                return &list[i];
+            }
+        }
+    }
+    return nullptr;
+}
+
+inline ovrMemberInfo const* LinearFindMemberInfo(
+    ovrMemberInfo const* memberInfos,
+    char const* memberName) {
+    for (int i = 0; memberInfos[i].MemberName != nullptr; ++i) {
+        if (OVR::OVR_strcmp(memberInfos[i].MemberName, memberName) == 0) {
+            return &memberInfos[i];
+        }
+    }
+    return nullptr;
+}
+
+inline ovrEnumInfo const* LinearFindEnumInfo(ovrEnumInfo const* enumInfos, char const* name) {
+    for (int i = 0; enumInfos[i].Name != nullptr; ++i) {
+        if (OVR::OVR_strcmp(enumInfos[i].Name, name) == 0) {
+            return &enumInfos[i];
+        }
+    }
+    return nullptr;
+}
+
+} // namespace OVRFW
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MetaDataScan.h
+Content     :   Media trees and a reference scan for the OvrMetaData directory scan tests.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Builds the metadata manager into the test, since the framework library only builds for
+// Android and Windows.
+#include "GUI/MetaDataManager.cpp"
+
+// The framework's logging is not built for the host. Info messages are dropped, since the scan
+// logs every file it adds.
+extern "C" void LogWithFilenameTag(const int priority, const char* filename, const char* fmt, ...) {
+    if (priority < SAMPLES_LOG_WARN) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "[%s] ", filename);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+}
+
+namespace OVRFW {
+
+// Only used by the merge functions, which the tests do not call.
+bool ovr_ReadFileFromApplicationPackage(const char* /*nameInZip*/, int& length, void*& buffer) {
+    length = 0;
+    buffer = nullptr;
+    return false;
+}
+
+bool HasPermission(const char* fileOrDirName, const permissionFlags_t /*flags*/) {
+    return FileExists(fileOrDirName);
+}
+
+struct MetaDataTree {
+    std::string Root;
+    std::vector<std::string> SearchPaths; // each with a trailing slash
+    OvrMetaDataFileExtensions Extensions;
+};
+
+inline void TouchFile(std::string const& path) {
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    std::ofstream(path, std::ios::binary) << path;
+}
+
+// Creates Media/ under two search paths, like internal storage and an sd card, with categories
+// holding albums. Each directory has videos, photos with upper case extensions, text files the
+// extensions leave out and a hidden file. Files are spread over both search paths and some are in
+// both, so listings have to be merged and each file found in the first path that has it.
+inline MetaDataTree CreateMetaDataTree(
+    std::string const& root,
+    int const categories,
+    int const albums,
+    int const filesPerDirectory) {
+    std::filesystem::remove_all(root);
+
+    MetaDataTree tree;
+    tree.Root = root;
+    tree.SearchPaths = {root + "/internal/", root + "/sdcard/"};
+    tree.Extensions.GoodExtensions = {".mp4", ".jpg"};
+    tree.Extensions.BadExtensions = {".part.mp4"};
+
+    std::vector<std::string> directories = {"Media/"};
+    for (int c = 0; c < categories; ++c) {
+        std::string const category = "Media/Category" + std::to_string(c) + "/";
+        directories.push_back(category);
+        for (int a = 0; a < albums; ++a) {
+            directories.push_back(category + "Album" + std::to_string(a) + "/");
+        }
+    }
+
+    for (size_t d = 0; d < directories.size(); ++d) {
+        for (int f = 0; f < filesPerDirectory; ++f) {
+            std::string name;
+            switch (f % 4) {
+                case 0:
+                    name = "clip" + std::to_string(f) + ".mp4";
+                    break;
+                case 1:
+                    name = "Photo" + std::to_string(f) + ".JPG";
+                    break;
+                case 2:
+                    name = "notes" + std::to_string(f) + ".txt";
+                    break;
+                default:
+                    name = "download" + std::to_string(f) + ".part.mp4";
+                    break;
+            }
+            int const searchPath = static_cast<int>((d + f) % 2);
+            TouchFile(tree.SearchPaths[searchPath] + directories[d] + name);
+            if (f % 7 == 0) {
+                TouchFile(tree.SearchPaths[1 - searchPath] + directories[d] + name);
+            }
+        }
+        TouchFile(tree.SearchPaths[d % 2] + directories[d] + ".hidden.mp4");
+    }
+    return tree;
+}
+
+// Moves every directory's time an hour back, so the scan index can reuse them.
+inline void AgeDirectories(std::string const& root) {
+    auto const past = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (entry.is_directory()) {
+            std::filesystem::last_write_time(entry.path(), past);
+        }
+    }
+}
+
+// Each category's tag followed by the id, url and tag of each of its data, in order.
+inline std::vector<std::string> Snapshot(OvrMetaData const& metaData) {
+    std::vector<std::string> snapshot;
+    for (OvrMetaData::Category const& category : metaData.GetCategories()) {
+        snapshot.push_back("[" + category.CategoryTag + "]");
+        for (int const index : category.DatumIndicies) {
+            OvrMetaDatum const& datum = metaData.GetMetaDatum(index);
+            snapshot.push_back(
+                std::to_string(datum.Id) + " " + datum.Url + " " +
+                (datum.Tags.empty() ? std::string() : datum.Tags[0]));
+        }
+    }
+    return snapshot;
+}
+
+class TestMetaData : public OvrMetaData {
+   public:
+    virtual ~TestMetaData() {
+        for (OvrMetaDatum* datum : GetMetaData()) {
+            delete datum;
+        }
+    }
+
+    // What InitFromDirectory did before directories were listed on worker threads: list each
+    // directory, then look up each wanted file, depth first on the calling thread. Returns the
+    // same Snapshot that scan produced.
+    std::vector<std::string> ScanSerially(
+        const char* relativePath,
+        const std::vector<std::string>& searchPaths,
+        const OvrMetaDataFileExtensions& fileExtensions) const {
+        std::vector<std::string> snapshot;
+        std::unordered_map<std::string, int> urlToIndex;
+        ScanSerially(relativePath, searchPaths, fileExtensions, urlToIndex, snapshot);
+        return snapshot;
+    }
+
+   protected:
+    struct TestMetaDatum : public OvrMetaDatum {};
+
+    virtual OvrMetaDatum* CreateMetaDatum(const char* /*fileName*/) const {
+        return new TestMetaDatum;
+    }
+    virtual void ExtractExtendedData(
+        const OVR::JsonReader& /*jsonDatum*/,
+        OvrMetaDatum& /*outDatum*/) const {}
+    virtual void ExtendedDataToJson(
+        const OvrMetaDatum& /*datum*/,
+        std::shared_ptr<OVR::JSON> /*outDatumObject*/) const {}
+    virtual void SwapExtendedData(OvrMetaDatum* /*left*/, OvrMetaDatum* /*right*/) const {}
+
+   private:
+    void ScanSerially(
+        const char* relativePath,
+        const std::vector<std::string>& searchPaths,
+        const OvrMetaDataFileExtensions& fileExtensions,
+        std::unordered_map<std::string, int>& urlToIndex,
+        std::vector<std::string>& snapshot) const {
+        std::unordered_map<std::string, std::string> uniqueFileList =
+            RelativeDirectoryFileList(searchPaths, relativePath);
+        std::vector<std::string> fileList;
+        for (auto iter = uniqueFileList.begin(); iter != uniqueFileList.end(); ++iter) {
+            fileList.push_back(iter->second);
+        }
+        SortStringArray(fileList);
+
+        const std::string categoryTag = ExtractFileBase(relativePath);
+        const size_t categoryStart = snapshot.size();
+        snapshot.push_back("[" + categoryTag + "]");
+        std::vector<std::string> subDirs;
+        for (const std::string& s : fileList) {
+            if (MatchesExtension(s.c_str(), "/")) {
+                subDirs.push_back(s);
+                continue;
+            }
+            if (!ShouldAddFile(s.c_str(), fileExtensions)) {
+                continue;
+            }
+            std::string url;
+            if (GetFullPath(searchPaths, s.c_str(), url)) {
+                std::string lowerCaseUrl = url;
+                const auto& loc = std::use_facet<std::ctype<char>>(std::locale());
+                loc.tolower(&lowerCaseUrl[0], &lowerCaseUrl[0] + lowerCaseUrl.length());
+                if (urlToIndex.find(lowerCaseUrl) == urlToIndex.end()) {
+                    const int dataIndex = static_cast<int>(urlToIndex.size());
+                    urlToIndex[lowerCaseUrl] = dataIndex;
+                    snapshot.push_back(std::to_string(dataIndex) + " " + url + " " + categoryTag);
+                }
+            }
+        }
+        if (snapshot.size() == categoryStart + 1) {
+            snapshot.pop_back(); // empty categories are not added
+        }
+
+        for (const std::string& subDir : subDirs) {
+            ScanSerially(subDir.c_str(), searchPaths, fileExtensions, urlToIndex, snapshot);
+        }
+    }
+};
+
+} // namespace OVRFW
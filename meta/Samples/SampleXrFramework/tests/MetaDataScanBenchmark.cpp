@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MetaDataScanBenchmark.cpp
+Content     :   Times OvrMetaData::InitFromDirectory on a cold start without a scan index and
+                on a warm start with one, against the serial scan it replaced.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MetaDataScan.h"
+
+using namespace OVRFW;
+
+template <typename Function>
+static double MillisecondsPerRun(int const runs, Function&& function) {
+    function(); // warm up caches
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        function();
+    }
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+int main(int argc, char** argv) {
+    std::string const workDir = argc > 1
+        ? std::string(argv[1])
+        : (std::filesystem::temp_directory_path() / "MetaDataScanBenchmark").string();
+    int const categories = argc > 2 ? atoi(argv[2]) : 20;
+    int const albums = argc > 3 ? atoi(argv[3]) : 10;
+    int const filesPerDirectory = argc > 4 ? atoi(argv[4]) : 40;
+    int const runs = argc > 5 ? atoi(argv[5]) : 10;
+
+    std::string const root = workDir + "/tree";
+    std::string const indexPath = workDir + "/scan_index.json";
+    MetaDataTree const tree = CreateMetaDataTree(root, categories, albums, filesPerDirectory);
+    // the index does not reuse directories that changed in the last few seconds
+    AgeDirectories(root);
+
+    size_t data = 0;
+    double const serial = MillisecondsPerRun(runs, [&] {
+        TestMetaData metaData;
+        data = metaData.ScanSerially("Media/", tree.SearchPaths, tree.Extensions).size();
+    });
+
+    // Cold: the first scan after installing, or after the search paths or extensions changed.
+    // This includes writing the index. The file system cache is warm for every run, so on a
+    // device the time saved by listing in parallel is larger than here.
+    double const cold = MillisecondsPerRun(runs, [&] {
+        std::filesystem::remove(indexPath);
+        TestMetaData metaData;
+        metaData.SetScanIndexFile(indexPath.c_str());
+        metaData.InitFromDirectory("Media/", tree.SearchPaths, tree.Extensions);
+    });
+    double const coldWithoutIndex = MillisecondsPerRun(runs, [&] {
+        TestMetaData metaData;
+        metaData.InitFromDirectory("Media/", tree.SearchPaths, tree.Extensions);
+    });
+
+    // Warm: a later start with the index from the last one. Nothing changed, or one album got a
+    // new file.
+    double const warm = MillisecondsPerRun(runs, [&] {
+        TestMetaData metaData;
+        metaData.SetScanIndexFile(indexPath.c_str());
+        metaData.InitFromDirectory("Media/", tree.SearchPaths, tree.Extensions);
+    });
+    int added = 0;
+    double const warmChanged = MillisecondsPerRun(runs, [&] {
+        TouchFile(tree.SearchPaths[1] + "Media/Category0/Album0/added" + std::to_string(added++) +
+                  ".mp4");
+        TestMetaData metaData;
+        metaData.SetScanIndexFile(indexPath.c_str());
+        metaData.InitFromDirectory("Media/", tree.SearchPaths, tree.Extensions);
+    });
+
+    std::error_code error;
+    printf(
+        "%d directories, %zu categories and data, index %ju bytes, %u hardware threads\n",
+        1 + categories * (1 + albums),
+        data,
+        static_cast<uintmax_t>(std::filesystem::file_size(indexPath, error)),
+        std::thread::hardware_concurrency());
+    printf("serial scan (before):        %8.2f ms\n", serial);
+    printf("cold, parallel scan:         %8.2f ms\n", coldWithoutIndex);
+    printf("cold, writing the index:     %8.2f ms\n", cold);
+    printf("warm, unchanged:             %8.2f ms\n", warm);
+    printf("warm, one directory changed: %8.2f ms\n", warmChanged);
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   MetaDataScanTest.cpp
+Content     :   Checks that OvrMetaData::InitFromDirectory finds the same data as the serial scan
+                it replaced, with and without a scan index, as the tree changes.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "MetaDataScan.h"
+
+using namespace OVRFW;
+
+static int s_failures = 0;
+
+// Scans the tree with the scan index and checks the result against the serial scan.
+static void CheckScan(MetaDataTree const& tree, std::string const& indexPath, char const* what) {
+    TestMetaData expected;
+    std::vector<std::string> const expectedSnapshot =
+        expected.ScanSerially("Media/", tree.SearchPaths, tree.Extensions);
+
+    TestMetaData actual;
+    actual.SetScanIndexFile(indexPath.c_str());
+    actual.InitFromDirectory("Media/", tree.SearchPaths, tree.Extensions);
+    std::vector<std::string> const actualSnapshot = Snapshot(actual);
+
+    if (actualSnapshot != expectedSnapshot) {
+        printf("FAIL %s: scan differs from the serial scan\n", what);
+        size_t const count = std::max(actualSnapshot.size(), expectedSnapshot.size());
+        for (size_t i = 0; i < count; ++i) {
+            char const* const a = i < actualSnapshot.size() ? actualSnapshot[i].c_str() : "";
+            char const* const e = i < expectedSnapshot.size() ? expectedSnapshot[i].c_str() : "";
+            if (strcmp(a, e) != 0) {
+                printf("  %zu: '%s', expected '%s'\n", i, a, e);
+                break;
+            }
+        }
+        s_failures++;
+    }
+    if (expectedSnapshot.size() < 2) {
+        printf("FAIL %s: the tree has no data\n", what);
+        s_failures++;
+    }
+}
+
+static std::filesystem::file_time_type IndexTime(std::string const& indexPath) {
+    return std::filesystem::last_write_time(indexPath);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("usage: %s <work directory>\n", argv[0]);
+        return 1;
+    }
+    std::string const root = std::string(argv[1]) + "/tree";
+    std::string const indexPath = std::string(argv[1]) + "/scan_index.json";
+    std::filesystem::remove(indexPath);
+
+    MetaDataTree tree = CreateMetaDataTree(root, 4, 3, 12);
+    AgeDirectories(root);
+    std::string const& internal = tree.SearchPaths[0];
+    std::string const& sdcard = tree.SearchPaths[1];
+
+    CheckScan(tree, indexPath, "scan without an index");
+    if (!std::filesystem::exists(indexPath)) {
+        printf("FAIL the scan index was not written\n");
+        s_failures++;
+        return 1;
+    }
+
+    // nothing changed, so every directory comes from the index and it is not written again
+    auto const indexTime = IndexTime(indexPath);
+    CheckScan(tree, indexPath, "scan of an unchanged tree");
+    if (IndexTime(indexPath) != indexTime) {
+        printf("FAIL the scan index was written although nothing changed\n");
+        s_failures++;
+    }
+
+    TouchFile(sdcard + "Media/Category1/Album2/added.mp4");
+    CheckScan(tree, indexPath, "scan after adding a file");
+    // the same file in the first search path takes over its url
+    TouchFile(internal + "Media/Category1/Album2/added.mp4");
+    CheckScan(tree, indexPath, "scan after adding a file to the first search path");
+    std::filesystem::remove(internal + "Media/Category2/clip0.mp4");
+    CheckScan(tree, indexPath, "scan after removing a file");
+    std::string const newAlbum = sdcard + "Media/Category3/New Album/";
+    TouchFile(newAlbum + "clip.mp4");
+    auto const newAlbumTime = std::filesystem::last_write_time(newAlbum);
+    CheckScan(tree, indexPath, "scan after adding a directory");
+
+    // a directory changed again within the file system's time granularity keeps its time, so a
+    // directory that changed just before it was listed must be listed again
+    TouchFile(newAlbum + "clip2.mp4");
+    std::filesystem::last_write_time(newAlbum, newAlbumTime);
+    CheckScan(tree, indexPath, "scan after a change that kept the directory's time");
+
+    std::filesystem::remove_all(internal + "Media/Category0");
+    std::filesystem::remove_all(sdcard + "Media/Category0");
+    CheckScan(tree, indexPath, "scan after removing a directory");
+
+    // once the tree has settled its directories are reused again
+    AgeDirectories(root);
+    CheckScan(tree, indexPath, "scan after the tree settled");
+    auto const settledTime = IndexTime(indexPath);
+    CheckScan(tree, indexPath, "scan of the settled tree");
+    if (IndexTime(indexPath) != settledTime) {
+        printf("FAIL the scan index was written although nothing changed since the last scan\n");
+        s_failures++;
+    }
+
+    // an index built for other extensions is ignored
+    tree.Extensions.GoodExtensions.push_back(".txt");
+    CheckScan(tree, indexPath, "scan with other extensions");
+
+    if (s_failures != 0) {
+        printf("%d failures\n", s_failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   OvrMathBenchmark.cpp
+Content     :   Times the float Matrix4 and Quat operations that OVR_Math.h specializes for
+                NEON. Built once as the target selects and once with OVR_MATH_NO_SIMD, so the two
+                can be compared on a device. Inverted and Rotate are also timed the way they were
+                computed before, through the cofactors and through two quaternion products.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "OVR_Math.h"
+
+using namespace OVR;
+
+#if defined(OVR_MATH_NEON)
+static const char* const Variant = "NEON";
+#else
+static const char* const Variant = "generic";
+#endif
+
+template <typename Function>
+static double NanosecondsPerOp(int const runs, int const ops, Function&& function) {
+    function(); // warm up caches
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        function();
+    }
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / runs / ops;
+}
+
+// Keeps the results alive, so the compiler can't drop the work.
+static float s_sink = 0.0f;
+
+int main(int argc, char** argv) {
+    int const count = argc > 1 ? atoi(argv[1]) : 100000;
+    int const runs = argc > 2 ? atoi(argv[2]) : 10;
+    if (count <= 0 || runs <= 0) {
+        printf("usage: %s [operations] [runs]\n", argv[0]);
+        return 1;
+    }
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<Matrix4f> matrices(count);
+    std::vector<Quatf> quats(count);
+    std::vector<Vector3f> vectors(count);
+    std::vector<Posef> poses(count);
+    for (int i = 0; i < count; ++i) {
+        for (int r = 0; r < 4; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                matrices[i].M[r][c] = unit(random) + (r == c ? 3.0f : 0.0f);
+            }
+        }
+        quats[i] = Quatf(unit(random), unit(random), unit(random), unit(random)).Normalized();
+        vectors[i] = Vector3f(unit(random), unit(random), unit(random)) * 10.0f;
+        poses[i] = Posef(quats[i], vectors[i]);
+    }
+
+    printf("OVR_Math %s, %d operations\n", Variant, count);
+    auto report = [](const char* name, double ns) { printf("%-28s %7.2f ns\n", name, ns); };
+
+    report("Matrix4f::operator*", NanosecondsPerOp(runs, count, [&] {
+               Matrix4f m;
+               for (int i = 1; i < count; ++i) {
+                   m = matrices[i - 1] * matrices[i];
+                   s_sink += m.M[3][3];
+               }
+           }));
+    report("Matrix4f::Transform(4)", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 0; i < count; ++i) {
+                   const Vector3f& v = vectors[i];
+                   s_sink += matrices[i].Transform(Vector4f(v.x, v.y, v.z, 1.0f)).w;
+               }
+           }));
+    report("Matrix4f::Transform(3)", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 0; i < count; ++i) {
+                   s_sink += matrices[i].Transform(vectors[i]).z;
+               }
+           }));
+    report("Matrix4f::Inverted", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 0; i < count; ++i) {
+                   s_sink += matrices[i].Inverted().M[3][3];
+               }
+           }));
+    report("  through the cofactors", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 0; i < count; ++i) {
+                   const Matrix4f& m = matrices[i];
+                   s_sink += (m.Adjugated() * (1.0f / m.Determinant())).M[3][3];
+               }
+           }));
+    report("Quatf::operator*", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 1; i < count; ++i) {
+                   s_sink += (quats[i - 1] * quats[i]).w;
+               }
+           }));
+    report("Quatf::Rotate", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 0; i < count; ++i) {
+                   s_sink += quats[i].Rotate(vectors[i]).z;
+               }
+           }));
+    report("  through two products", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 0; i < count; ++i) {
+                   const Quatf& q = quats[i];
+                   const Vector3f& v = vectors[i];
+                   s_sink += ((q * Quatf(v.x, v.y, v.z, 0.0f)) * q.Inverted()).z;
+               }
+           }));
+    report("Posef::operator*", NanosecondsPerOp(runs, count, [&] {
+               for (int i = 1; i < count; ++i) {
+                   s_sink += (poses[i - 1] * poses[i]).Translation.z;
+               }
+           }));
+
+    return s_sink == 12345.0f ? 2 : 0;
+}
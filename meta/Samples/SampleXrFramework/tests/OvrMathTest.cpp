@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   OvrMathTest.cpp
+Content     :   Checks the float Matrix4 and Quat operations that OVR_Math.h specializes for
+                NEON, and the generic Rotate and Inverted. The same checks are built for the
+                host, with OVR_MATH_NO_SIMD, and with the NEON specializations on top of
+                neon/arm_neon.h. Operations the specializations cover must match the generic
+                arithmetic bit for bit; every operation must stay within a per operation ULP
+                bound of a double precision reference computed the long way.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <random>
+
+#include "OVR_Math.h"
+
+using namespace OVR;
+
+#if defined(OVR_MATH_NEON)
+static const char* const Variant = "NEON";
+#else
+static const char* const Variant = "generic";
+#endif
+
+static int s_failures = 0;
+
+static const int Iterations = 100000;
+
+static std::mt19937 s_random(1234);
+
+static float Random(float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(s_random);
+}
+
+static Matrix4f RandomMatrix() {
+    Matrix4f m;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            m.M[i][j] = Random(-1.0f, 1.0f);
+        }
+    }
+    return m;
+}
+
+// Diagonally dominant, so it is well conditioned and the inverse error measures the arithmetic.
+static Matrix4f RandomInvertibleMatrix() {
+    Matrix4f m = RandomMatrix();
+    for (int i = 0; i < 4; i++) {
+        m.M[i][i] += (m.M[i][i] < 0.0f ? -3.0f : 3.0f);
+    }
+    return m;
+}
+
+static Quatf RandomQuat() {
+    Quatf q(Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f));
+    q.Normalize();
+    return q;
+}
+
+static Vector3f RandomVector3() {
+    return Vector3f(Random(-10.0f, 10.0f), Random(-10.0f, 10.0f), Random(-10.0f, 10.0f));
+}
+
+static Matrix4d ToDouble(const Matrix4f& m) {
+    Matrix4d d;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            d.M[i][j] = m.M[i][j];
+        }
+    }
+    return d;
+}
+
+static bool SameBits(const float* a, const float* b, int count) {
+    return memcmp(a, b, count * sizeof(float)) == 0;
+}
+
+// The largest error of a result in units in the last place of scale, the magnitude of the terms
+// the result was summed from. Sums that cancel to near zero can't be more accurate than the
+// terms they cancel, so an error relative to the result itself would overstate it.
+static double Ulps(const float* result, const double* reference, int count, double scale) {
+    double error = 0.0;
+    for (int i = 0; i < count; i++) {
+        error = fmax(error, fabs((double)result[i] - reference[i]));
+    }
+    int exponent = 0;
+    frexp(scale, &exponent);
+    return error / ldexp(1.0, exponent - 24);
+}
+
+static double MaxAbs(const double* values, int count) {
+    double largest = 0.0;
+    for (int i = 0; i < count; i++) {
+        largest = fmax(largest, fabs(values[i]));
+    }
+    return largest;
+}
+
+static Matrix4d Abs(const Matrix4d& m) {
+    Matrix4d a;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            a.M[i][j] = fabs(m.M[i][j]);
+        }
+    }
+    return a;
+}
+
+struct OpResult {
+    const char* name;
+    double maxUlps = 0.0;
+    int mismatches = 0; // results that differ from the generic arithmetic
+};
+
+static void Report(const OpResult& op, double bound, bool bitExact) {
+    const bool ulpsOk = op.maxUlps <= bound;
+    const bool exactOk = !bitExact || op.mismatches == 0;
+    printf(
+        "%-22s max %.2f ulps (bound %.1f)%s\n",
+        op.name,
+        op.maxUlps,
+        bound,
+        bitExact ? (op.mismatches == 0 ? ", bit exact" : "") : "");
+    if (!ulpsOk) {
+        printf("FAIL %s: %.2f ulps is over the bound of %.1f\n", op.name, op.maxUlps, bound);
+        s_failures++;
+    }
+    if (!exactOk) {
+        printf("FAIL %s: %d results differ from the generic arithmetic\n", op.name, op.mismatches);
+        s_failures++;
+    }
+}
+
+// The generic templates' arithmetic, written out so that builds with the specializations have
+// something to compare against bit for bit.
+static Matrix4f GenericMultiply(const Matrix4f& a, const Matrix4f& b) {
+    Matrix4f d;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            d.M[i][j] = a.M[i][0] * b.M[0][j] + a.M[i][1] * b.M[1][j] + a.M[i][2] * b.M[2][j] +
+                a.M[i][3] * b.M[3][j];
+        }
+    }
+    return d;
+}
+
+static Vector4f GenericTransform(const Matrix4f& m, const Vector4f& v) {
+    float r[4];
+    for (int i = 0; i < 4; i++) {
+        r[i] = m.M[i][0] * v.x + m.M[i][1] * v.y + m.M[i][2] * v.z + m.M[i][3] * v.w;
+    }
+    return Vector4f(r[0], r[1], r[2], r[3]);
+}
+
+static Vector3f GenericTransform(const Matrix4f& m, const Vector3f& v) {
+    const float w = m.M[3][0] * v.x + m.M[3][1] * v.y + m.M[3][2] * v.z + m.M[3][3];
+    const float rcpW = 1.0f / w;
+    return Vector3f(
+        (m.M[0][0] * v.x + m.M[0][1] * v.y + m.M[0][2] * v.z + m.M[0][3]) * rcpW,
+        (m.M[1][0] * v.x + m.M[1][1] * v.y + m.M[1][2] * v.z + m.M[1][3]) * rcpW,
+        (m.M[2][0] * v.x + m.M[2][1] * v.y + m.M[2][2] * v.z + m.M[2][3]) * rcpW);
+}
+
+static Quatf GenericMultiply(const Quatf& a, const Quatf& b) {
+    return Quatf(
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+static void TestMatrixMultiply() {
+    OpResult op{"Matrix4f::operator*"};
+    for (int i = 0; i < Iterations; i++) {
+        const Matrix4f a = RandomMatrix();
+        const Matrix4f b = RandomMatrix();
+        const Matrix4f r = a * b;
+        const Matrix4f g = GenericMultiply(a, b);
+        op.mismatches += SameBits(&r.M[0][0], &g.M[0][0], 16) ? 0 : 1;
+        const Matrix4d d = ToDouble(a) * ToDouble(b);
+        const Matrix4d terms = Abs(ToDouble(a)) * Abs(ToDouble(b));
+        op.maxUlps =
+            fmax(op.maxUlps, Ulps(&r.M[0][0], &d.M[0][0], 16, MaxAbs(&terms.M[0][0], 16)));
+    }
+    Report(op, 3.0, true);
+}
+
+static void TestTransform() {
+    OpResult op4{"Matrix4f::Transform(4)"};
+    OpResult op3{"Matrix4f::Transform(3)"};
+    for (int i = 0; i < Iterations; i++) {
+        const Matrix4f m = RandomMatrix();
+        const Vector4f v(Random(-10.0f, 10.0f), Random(-10.0f, 10.0f), Random(-10.0f, 10.0f), 1.0f);
+        const Vector4f r = m.Transform(v);
+        const Vector4f g = GenericTransform(m, v);
+        op4.mismatches += SameBits(&r.x, &g.x, 4) ? 0 : 1;
+        const Vector4d d = ToDouble(m).Transform(Vector4d(v.x, v.y, v.z, v.w));
+        const Vector4d terms =
+            Abs(ToDouble(m)).Transform(Vector4d(fabs(v.x), fabs(v.y), fabs(v.z), 1.0));
+        op4.maxUlps = fmax(op4.maxUlps, Ulps(&r.x, &d.x, 4, MaxAbs(&terms.x, 4)));
+
+        // A projective matrix whose w stays well away from zero.
+        Matrix4f p = m;
+        p.M[3][0] *= 0.01f;
+        p.M[3][1] *= 0.01f;
+        p.M[3][2] *= 0.01f;
+        p.M[3][3] = 2.0f;
+        const Vector3f v3(v.x, v.y, v.z);
+        const Vector3f r3 = p.Transform(v3);
+        const Vector3f g3 = GenericTransform(p, v3);
+        op3.mismatches += SameBits(&r3.x, &g3.x, 3) ? 0 : 1;
+        const Vector3d d3 = ToDouble(p).Transform(Vector3d(v3.x, v3.y, v3.z));
+        const Vector4d terms3 =
+            Abs(ToDouble(p)).Transform(Vector4d(fabs(v3.x), fabs(v3.y), fabs(v3.z), 1.0));
+        const double w = p.M[3][0] * (double)v3.x + p.M[3][1] * (double)v3.y +
+            p.M[3][2] * (double)v3.z + p.M[3][3];
+        op3.maxUlps =
+            fmax(op3.maxUlps, Ulps(&r3.x, &d3.x, 3, MaxAbs(&terms3.x, 3) / fabs(w)));
+    }
+    Report(op4, 3.0, true);
+    Report(op3, 5.0, true);
+}
+
+static void TestQuatMultiply() {
+    OpResult op{"Quatf::operator*"};
+    for (int i = 0; i < Iterations; i++) {
+        const Quatf a = RandomQuat();
+        const Quatf b = RandomQuat();
+        const Quatf r = a * b;
+        const Quatf g = GenericMultiply(a, b);
+        op.mismatches += SameBits(&r.x, &g.x, 4) ? 0 : 1;
+        const Quatd d = Quatd(a.x, a.y, a.z, a.w) * Quatd(b.x, b.y, b.z, b.w);
+        op.maxUlps = fmax(op.maxUlps, Ulps(&r.x, &d.x, 4, 1.0)); // unit quaternions
+    }
+    Report(op, 2.0, true);
+}
+
+// Rotate is checked against the two quaternion products it expands.
+static Vector3d ReferenceRotate(const Quatf& q, const Vector3f& v) {
+    const Quatd qd(q.x, q.y, q.z, q.w);
+    return ((qd * Quatd(v.x, v.y, v.z, 0.0)) * Quatd(-qd.x, -qd.y, -qd.z, qd.w)).Imag();
+}
+
+static void TestRotate() {
+    OpResult op{"Quatf::Rotate"};
+    OpResult inverse{"Quatf::InverseRotate"};
+    OpResult pose{"Posef::operator*"};
+    for (int i = 0; i < Iterations; i++) {
+        const Quatf q = RandomQuat();
+        const Vector3f v = RandomVector3();
+        const Vector3f r = q.Rotate(v);
+        const Vector3d d = ReferenceRotate(q, v);
+        op.maxUlps = fmax(op.maxUlps, Ulps(&r.x, &d.x, 3, v.Length()));
+
+        const Vector3f ri = q.InverseRotate(v);
+        const Vector3d di = ReferenceRotate(q.Inverted(), v);
+        inverse.maxUlps = fmax(inverse.maxUlps, Ulps(&ri.x, &di.x, 3, v.Length()));
+
+        const Posef a(q, RandomVector3());
+        const Posef b(RandomQuat(), RandomVector3());
+        const Posef c = a * b;
+        const Vector3d rotated = ReferenceRotate(a.Rotation, b.Translation);
+        const double t[3] = {
+            rotated.x + a.Translation.x, rotated.y + a.Translation.y, rotated.z + a.Translation.z};
+        const double scale = b.Translation.Length() +
+            fmax(fabs(a.Translation.x), fmax(fabs(a.Translation.y), fabs(a.Translation.z)));
+        pose.maxUlps = fmax(pose.maxUlps, Ulps(&c.Translation.x, t, 3, scale));
+    }
+    Report(op, 6.0, false);
+    Report(inverse, 6.0, false);
+    Report(pose, 5.0, false);
+}
+
+static void TestInverted() {
+    OpResult op{"Matrix4f::Inverted"};
+    OpResult identity{"Matrix4f * Inverted"};
+    for (int i = 0; i < Iterations; i++) {
+        const Matrix4f m = RandomInvertibleMatrix();
+        const Matrix4f r = m.Inverted();
+        // The reference goes through the cofactor expansion, in double.
+        const Matrix4d md = ToDouble(m);
+        const Matrix4d d = md.Adjugated() * (1.0 / md.Determinant());
+        op.maxUlps =
+            fmax(op.maxUlps, Ulps(&r.M[0][0], &d.M[0][0], 16, MaxAbs(&d.M[0][0], 16)));
+        const Matrix4f p = m * r;
+        const Matrix4d one;
+        const Matrix4d terms = Abs(md) * Abs(ToDouble(r));
+        identity.maxUlps = fmax(
+            identity.maxUlps, Ulps(&p.M[0][0], &one.M[0][0], 16, MaxAbs(&terms.M[0][0], 16)));
+    }
+    Report(op, 7.0, false);
+    Report(identity, 9.0, false);
+}
+
+int main() {
+    printf("OVR_Math %s\n", Variant);
+    TestMatrixMultiply();
+    TestTransform();
+    TestQuatMultiply();
+    TestRotate();
+    TestInverted();
+
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   ReflectionLookupTest.cpp
+Content     :   Checks ovrReflection's hashed type, member and enum lookups against the linear
+                search they replaced, including which of two duplicate names wins, and parses a
+                generated menu through them.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "GUI/ReflectionData.h"
+
+#include "HostLocale.h"
+#include "MenuReflectionScene.h"
+
+using namespace OVRFW;
+using OVR::Vector3f;
+
+static int s_failures = 0;
+
+static void Check(bool const condition, char const* what) {
+    if (!condition) {
+        printf("FAIL %s\n", what);
+        s_failures++;
+    }
+}
+
+// A second list, registered after the framework's, that repeats one of its type names and
+// repeats a member name and an enum name within itself. The first of each must win.
+static ovrEnumInfo const HostEnums[] = {
+    {"HOST_FIRST", 1},
+    {"HOST_SECOND", 2},
+    {"HOST_FIRST", 3},
+    {nullptr, 0}};
+
+static ovrMemberInfo const HostMembers[] = {
+    {"Value", "int", nullptr, ovrTypeOperator::NONE, 0, 0},
+    {"Other", "int", nullptr, ovrTypeOperator::NONE, 4, 0},
+    {"Value", "float", nullptr, ovrTypeOperator::NONE, 8, 0},
+    {nullptr, nullptr, nullptr, ovrTypeOperator::NONE, 0, 0}};
+
+static ovrTypeInfo const HostTypes[] = {
+    {"VRMenuObjectParms",
+     nullptr,
+     0,
+     nullptr,
+     nullptr,
+     nullptr,
+     nullptr,
+     nullptr,
+     ovrArrayType::NONE,
+     false,
+     nullptr},
+    {"HostType",
+     nullptr,
+     12,
+     HostEnums,
+     nullptr,
+     nullptr,
+     nullptr,
+     nullptr,
+     ovrArrayType::NONE,
+     false,
+     HostMembers},
+    {nullptr,
+     nullptr,
+     0,
+     nullptr,
+     nullptr,
+     nullptr,
+     nullptr,
+     nullptr,
+     ovrArrayType::NONE,
+     false,
+     nullptr}};
+
+// Every name in every registered list must resolve to what the linear search finds.
+static void CheckLookups(
+    ovrReflection& refl,
+    std::vector<ovrTypeInfo const*> const& lists,
+    char const* what) {
+    int mismatches = 0;
+    int lookups = 0;
+    for (ovrTypeInfo const* list : lists) {
+        for (int i = 0; list[i].TypeName != nullptr; ++i) {
+            ovrTypeInfo const& ti = list[i];
+            lookups++;
+            if (refl.FindTypeInfo(ti.TypeName) != LinearFindTypeInfo(lists, ti.TypeName)) {
+                printf("FAIL %s: type %s\n", what, ti.TypeName);
+                mismatches++;
+            }
+            if (ti.MemberInfo != nullptr) {
+                for (int j = 0; ti.MemberInfo[j].MemberName != nullptr; ++j) {
+                    char const* name = ti.MemberInfo[j].MemberName;
+                    lookups++;
+                    if (refl.FindMemberReflectionInfo(ti.MemberInfo, name) !=
+                        LinearFindMemberInfo(ti.MemberInfo, name)) {
+                        printf("FAIL %s: member %s::%s\n", what, ti.TypeName, name);
+                        mismatches++;
+                    }
+                }
+                Check(
+                    refl.FindMemberReflectionInfo(ti.MemberInfo, "NoSuchMember") == nullptr,
+                    "an unknown member is not found");
+            }
+            if (ti.EnumInfos != nullptr) {
+                for (int j = 0; ti.EnumInfos[j].Name != nullptr; ++j) {
+                    char const* name = ti.EnumInfos[j].Name;
+                    lookups++;
+                    if (refl.FindEnumInfo(ti.EnumInfos, name) !=
+                        LinearFindEnumInfo(ti.EnumInfos, name)) {
+                        printf("FAIL %s: enum %s::%s\n", what, ti.TypeName, name);
+                        mismatches++;
+                    }
+                }
+                Check(
+                    refl.FindEnumInfo(ti.EnumInfos, "NO_SUCH_ENUM") == nullptr,
+                    "an unknown enum is not found");
+            }
+        }
+    }
+    printf("%s: %d lookups, %d mismatches\n", what, lookups, mismatches);
+    s_failures += mismatches;
+}
+
+static void TestLookups() {
+    ovrReflection* refl = ovrReflection::Create();
+    std::vector<ovrTypeInfo const*> lists = {TypeInfoList};
+    CheckLookups(*refl, lists, "framework types");
+
+    // members found through the parent type, as components' Name and EventFlags are
+    ovrTypeInfo const* component = refl->FindTypeInfo("OvrDefaultComponent");
+    ovrTypeInfo const* parent = refl->FindTypeInfo("VRMenuComponent");
+    Check(component != nullptr && parent != nullptr, "the component types are registered");
+    if (component != nullptr && parent != nullptr) {
+        Check(
+            refl->FindMemberReflectionInfoRecursive(component, "Name") ==
+                LinearFindMemberInfo(parent->MemberInfo, "Name"),
+            "a parent's member is found through the child");
+        Check(
+            refl->FindMemberReflectionInfoRecursive(component, "NoSuchMember") == nullptr,
+            "an unknown member is not found through the parents");
+    }
+
+    refl->AddTypeInfoList(HostTypes);
+    lists.push_back(HostTypes);
+    CheckLookups(*refl, lists, "with a second list");
+    Check(
+        refl->FindTypeInfo("VRMenuObjectParms") != &HostTypes[0],
+        "the earlier list wins a duplicate type");
+    Check(refl->FindTypeInfo("HostType") == &HostTypes[1], "the second list's types are found");
+    Check(
+        refl->FindMemberReflectionInfo(HostMembers, "Value") == &HostMembers[0],
+        "the first of two duplicate members wins");
+    Check(
+        refl->FindEnumInfo(HostEnums, "HOST_FIRST") == &HostEnums[0],
+        "the first of two duplicate enums wins");
+
+    ovrReflection::Destroy(refl);
+}
+
+static void TestParse() {
+    ovrReflection* refl = ovrReflection::Create();
+    HostLocale locale;
+    int const numObjects = 50;
+    std::vector<VRMenuObjectParms const*> itemParms;
+    ovrParseResult const result =
+        ParseMenuReflectionText(*refl, locale, MakeMenuReflectionText(numObjects), itemParms);
+    if (!result) {
+        printf("FAIL parsing the generated menu: %s\n", result.GetErrorText());
+        s_failures++;
+    }
+    Check(static_cast<int>(itemParms.size()) == numObjects, "every object is parsed");
+
+    int wrong = 0;
+    for (int i = 0; i < static_cast<int>(itemParms.size()); ++i) {
+        VRMenuObjectParms const& parms = *itemParms[i];
+        bool const ok = parms.Id.Get() == MenuObjectId(i) &&
+            parms.Name == "object_" + std::to_string(i) &&
+            parms.Type == ((i & 1) ? VRMENU_BUTTON : VRMENU_STATIC) &&
+            parms.Flags.GetValue() ==
+                (VRMenuObjectFlags_t(VRMENUOBJECT_DONT_HIT_TEXT) | VRMENUOBJECT_BOUND_ALL)
+                    .GetValue() &&
+            parms.LocalPose.Translation.Compare(Vector3f(i, i * 2, i * 3)) &&
+            parms.Components.size() == 1 &&
+            OVR::OVR_strcmp(parms.Components[0]->GetName(),
+                            ("highlight_" + std::to_string(i)).c_str()) == 0 &&
+            parms.SurfaceParms.size() == 1 &&
+            parms.SurfaceParms[0].ImageNames[0] ==
+                "apk:///assets/button_" + std::to_string(i) + ".png";
+        if (!ok) {
+            if (wrong == 0) {
+                printf("FAIL object %d was not parsed as written\n", i);
+            }
+            wrong++;
+        }
+    }
+    s_failures += wrong;
+
+    FreeItemParms(itemParms);
+    ovrReflection::Destroy(refl);
+}
+
+int main() {
+    TestLookups();
+    TestParse();
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
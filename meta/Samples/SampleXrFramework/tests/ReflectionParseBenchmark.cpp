@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   ReflectionParseBenchmark.cpp
+Content     :   Times parsing a generated menu reflection file of thousands of objects, and the
+                reflection lookups it makes, hashed and through the linear search they replaced.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <vector>
+
+#include "GUI/ReflectionData.h"
+
+#include "HostLocale.h"
+#include "MenuReflectionScene.h"
+
+using namespace OVRFW;
+
+static double Milliseconds(
+    std::chrono::steady_clock::time_point const start,
+    std::chrono::steady_clock::time_point const end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Keeps the results alive, so the compiler can't drop the lookups.
+static uintptr_t s_sink = 0;
+
+int main(int argc, char** argv) {
+    int const numObjects = argc > 1 ? atoi(argv[1]) : 5000;
+    int const runs = argc > 2 ? atoi(argv[2]) : 5;
+    if (numObjects <= 0 || runs <= 0) {
+        printf("usage: %s [objects] [runs]\n", argv[0]);
+        return 1;
+    }
+
+    ovrReflection* refl = ovrReflection::Create();
+    HostLocale locale;
+    std::string const text = MakeMenuReflectionText(numObjects);
+
+    double best = 0.0;
+    for (int run = 0; run < runs; ++run) {
+        std::vector<VRMenuObjectParms const*> itemParms;
+        auto const start = std::chrono::steady_clock::now();
+        ovrParseResult const result = ParseMenuReflectionText(*refl, locale, text, itemParms);
+        auto const end = std::chrono::steady_clock::now();
+        if (!result) {
+            printf("parse failed: %s\n", result.GetErrorText());
+            return 1;
+        }
+        FreeItemParms(itemParms);
+        double const ms = Milliseconds(start, end);
+        best = run == 0 || ms < best ? ms : best;
+    }
+    printf("%d objects, %zu bytes\n", numObjects, text.size());
+    printf("%-28s %9.2f ms  %6.2f us/object\n", "parse", best, best * 1000.0 / numObjects);
+
+    // every member and enum name the parser looks up, in the order of the type list
+    std::vector<ovrTypeInfo const*> const lists = {TypeInfoList};
+    std::vector<std::pair<ovrMemberInfo const*, char const*>> members;
+    std::vector<std::pair<ovrEnumInfo const*, char const*>> enums;
+    std::vector<char const*> types;
+    for (int i = 0; TypeInfoList[i].TypeName != nullptr; ++i) {
+        ovrTypeInfo const& ti = TypeInfoList[i];
+        types.push_back(ti.TypeName);
+        for (int j = 0; ti.MemberInfo != nullptr && ti.MemberInfo[j].MemberName != nullptr; ++j) {
+            members.emplace_back(ti.MemberInfo, ti.MemberInfo[j].MemberName);
+        }
+        for (int j = 0; ti.EnumInfos != nullptr && ti.EnumInfos[j].Name != nullptr; ++j) {
+            enums.emplace_back(ti.EnumInfos, ti.EnumInfos[j].Name);
+        }
+    }
+    int const lookupRuns = 2000;
+    auto report = [&](char const* name, size_t count, auto&& lookup) {
+        auto const start = std::chrono::steady_clock::now();
+        for (int run = 0; run < lookupRuns; ++run) {
+            lookup();
+        }
+        auto const end = std::chrono::steady_clock::now();
+        double const ns = Milliseconds(start, end) * 1e6 / lookupRuns / count;
+        printf("%-28s %9.2f ns\n", name, ns);
+    };
+    printf("%zu types, %zu members, %zu enums\n", types.size(), members.size(), enums.size());
+    report("FindTypeInfo", types.size(), [&] {
+        for (char const* name : types) {
+            s_sink += reinterpret_cast<uintptr_t>(refl->FindTypeInfo(name));
+        }
+    });
+    report("  linear", types.size(), [&] {
+        for (char const* name : types) {
+            s_sink += reinterpret_cast<uintptr_t>(LinearFindTypeInfo(lists, name));
+        }
+    });
+    report("FindMemberReflectionInfo", members.size(), [&] {
+        for (auto const& m : members) {
+            s_sink +=
+                reinterpret_cast<uintptr_t>(refl->FindMemberReflectionInfo(m.first, m.second));
+        }
+    });
+    report("  linear", members.size(), [&] {
+        for (auto const& m : members) {
+            s_sink += reinterpret_cast<uintptr_t>(LinearFindMemberInfo(m.first, m.second));
+        }
+    });
+    report("FindEnumInfo", enums.size(), [&] {
+        for (auto const& e : enums) {
+            s_sink += reinterpret_cast<uintptr_t>(refl->FindEnumInfo(e.first, e.second));
+        }
+    });
+    report("  linear", enums.size(), [&] {
+        for (auto const& e : enums) {
+            s_sink += reinterpret_cast<uintptr_t>(LinearFindEnumInfo(e.first, e.second));
+        }
+    });
+
+    ovrReflection::Destroy(refl);
+    return s_sink == 12345 ? 2 : 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   RetainedSubmissionTest.cpp
+Content     :   Checks that VRMenuMgr reuses the submissions of unchanged objects, and that the
+                surfaces it then draws are the ones a full re-evaluation draws.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "MenuHitScene.h"
+
+using namespace OVRFW;
+using OVR::Matrix4f;
+using OVR::Posef;
+using OVR::Quatf;
+using OVR::Vector3f;
+using OVR::Vector4f;
+
+static int s_failures = 0;
+
+// What a drawn surface depends on: where it is drawn, with which program and texture, in which
+// color. The color is read through the uniform pointer, as the renderer reads it.
+struct DrawnSurface {
+    Matrix4f ModelMatrix;
+    ovrSurfaceDef const* Surface;
+    unsigned int Program;
+    unsigned int Texture;
+    Vector4f Color;
+
+    bool operator==(DrawnSurface const& other) const {
+        return ModelMatrix == other.ModelMatrix && Surface == other.Surface &&
+            Program == other.Program && Texture == other.Texture && Color == other.Color;
+    }
+};
+
+static std::vector<DrawnSurface> Snapshot(HostGuiSys& gui) {
+    std::vector<ovrDrawSurface> surfaceList;
+    gui.Get().AppendSurfaceList(Matrix4f(), &surfaceList);
+    std::vector<DrawnSurface> snapshot;
+    for (ovrDrawSurface const& ds : surfaceList) {
+        ovrGraphicsCommand const& gc = ds.surface->graphicsCommand;
+        DrawnSurface drawn;
+        drawn.ModelMatrix = ds.modelMatrix;
+        drawn.Surface = ds.surface;
+        drawn.Program = gc.Program.Program;
+        drawn.Texture = gc.Textures[0].texture;
+        drawn.Color = *static_cast<Vector4f const*>(gc.UniformData[0].Data);
+        snapshot.push_back(drawn);
+    }
+    return snapshot;
+}
+
+static void CheckSame(
+    std::vector<DrawnSurface> const& actual,
+    std::vector<DrawnSurface> const& expected,
+    char const* what) {
+    if (actual.size() != expected.size()) {
+        printf("FAIL %s: %zu surfaces drawn, expected %zu\n", what, actual.size(), expected.size());
+        s_failures++;
+        return;
+    }
+    for (size_t i = 0; i < actual.size(); ++i) {
+        if (!(actual[i] == expected[i])) {
+            printf("FAIL %s: surface %zu differs\n", what, i);
+            s_failures++;
+            return;
+        }
+    }
+}
+
+static void CheckStats(
+    HostGuiSys& gui,
+    int const expectedEvaluated,
+    bool const expectReused,
+    char const* what) {
+    int evaluated = 0;
+    int reused = 0;
+    gui.Get().GetVRMenuMgr().GetSubmitStats(evaluated, reused);
+    if ((expectedEvaluated >= 0 && evaluated != expectedEvaluated) ||
+        (expectedEvaluated < 0 && evaluated == 0) || (reused != 0) != expectReused) {
+        printf("FAIL %s: %d objects evaluated, %d reused\n", what, evaluated, reused);
+        s_failures++;
+    }
+}
+
+// Moves the menu away for a frame and back, which makes the next frame re-evaluate every object
+// in it, and returns what that frame draws.
+static std::vector<DrawnSurface>
+FullyEvaluated(HostGuiSys& gui, VRMenu* menu, int const numObjects) {
+    Posef const pose = menu->GetMenuPose();
+    menu->SetMenuPose(Posef(pose.Rotation, pose.Translation + Vector3f(0.0f, 0.0f, -1.0f)));
+    gui.Frame();
+    menu->SetMenuPose(pose);
+    gui.Frame();
+    CheckStats(gui, numObjects, false, "full re-evaluation");
+    return Snapshot(gui);
+}
+
+int main() {
+    HostGuiSys gui;
+    if (!gui.IsValid()) {
+        printf("FAIL could not create a GL context\n");
+        return 1;
+    }
+
+    // a single menu below VRMenuMgr's MAX_SUBMITTED objects, so every object is submitted
+    std::vector<VRMenu*> menus;
+    menus.push_back(
+        OpenButtonGrid(gui, "grid", Posef(Quatf(), Vector3f(0.0f, 0.0f, -1.5f)), 6, 5, 1000, true));
+    int const numObjects = CountObjects(gui.Get(), menus);
+    for (int i = 0; i < 3; ++i) {
+        gui.Frame();
+    }
+
+    // nothing changed, so everything is copied from the frame before
+    std::vector<DrawnSurface> const staticFrame = Snapshot(gui);
+    CheckStats(gui, 0, true, "static frame");
+    if (staticFrame.empty()) {
+        printf("FAIL nothing was drawn\n");
+        s_failures++;
+    }
+    CheckSame(FullyEvaluated(gui, menus[0], numObjects), staticFrame, "static frame");
+
+    // reading a surface does not make its object re-evaluate
+    VRMenuObject* button = gui.ObjectForId(menus[0], VRMenuId_t(1001));
+    VRMenuObject const* constButton = button;
+    Vector4f const surfaceColor = button->GetSurfaceConst(0).GetColor();
+    gui.Frame();
+    CheckStats(gui, 0, true, "after reading a surface");
+    if (constButton->GetSurface(0).GetColor() != surfaceColor) {
+        printf("FAIL reading a surface changed its color\n");
+        s_failures++;
+    }
+
+    // writing through the non-const accessor re-evaluates only that object and the menu root
+    // above it; its child and siblings are reused
+    button->GetSurface(0).SetColor(Vector4f(1.0f, 0.0f, 0.0f, 1.0f));
+    gui.Frame();
+    CheckStats(gui, 2, true, "after writing a surface");
+    std::vector<DrawnSurface> const afterSurface = Snapshot(gui);
+    CheckSame(afterSurface, FullyEvaluated(gui, menus[0], numObjects), "after writing a surface");
+
+    // an object's color is inherited, so its subtree is re-evaluated and the rest is reused
+    VRMenuObject* parent = gui.ObjectForId(menus[0], VRMenuId_t(1009));
+    parent->SetColor(Vector4f(0.0f, 1.0f, 0.0f, 0.5f));
+    if (parent->NumChildren() == 0) {
+        printf("FAIL button 1009 has no children\n");
+        s_failures++;
+    }
+    gui.Frame();
+    CheckStats(gui, -1, true, "after setting a color");
+    std::vector<DrawnSurface> const afterColor = Snapshot(gui);
+    CheckSame(afterColor, FullyEvaluated(gui, menus[0], numObjects), "after setting a color");
+
+    // and the frame after that is static again, and draws what a second full re-evaluation does
+    // (the surface color must not be modulated again)
+    gui.Frame();
+    CheckStats(gui, 0, true, "static after changes");
+    CheckSame(Snapshot(gui), afterColor, "static after changes");
+    CheckSame(FullyEvaluated(gui, menus[0], numObjects), afterColor, "re-evaluated again");
+
+    if (s_failures == 0) {
+        printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
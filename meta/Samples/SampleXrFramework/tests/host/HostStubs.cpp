@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   HostStubs.cpp
+Content     :   Host stand-ins for the pieces of the framework's dependencies that only
+                exist for Android and Windows.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#include "Render/Egl.h"
+#include "Misc/Log.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <ktx.h>
+
+// Log.c prints everything to stdout; the GUI logs several lines per object and frame, which
+// would bury the test output, so only warnings and errors are printed.
+extern "C" void VLogWithFilenameTag(
+    const int priority,
+    const char* filename,
+    const char* fmt,
+    va_list args) {
+    if (priority < SAMPLES_LOG_WARN) {
+        return;
+    }
+    fprintf(stderr, "[%s] ", filename);
+    vfprintf(stderr, fmt, args);
+    fprintf(stderr, "\n");
+}
+
+extern "C" void
+LogWithFilenameTag(const int priority, const char* filename, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    VLogWithFilenameTag(priority, filename, fmt, args);
+    va_end(args);
+}
+
+// Egl.c only builds for Android and Windows.
+extern "C" bool GLCheckErrorsWithTitle(const char* logTitle) {
+    bool hadError = false;
+    for (GLenum err = glGetError(); err != GL_NO_ERROR; err = glGetError()) {
+        hadError = true;
+        ALOGW("%s GL Error: #0x%04x", (logTitle != nullptr) ? logTitle : "<untitled>", (int)err);
+    }
+    return hadError;
+}
+
+// libktx is only shipped prebuilt for Android. The tests do not load KTX textures, so loading one
+// fails the same way an unsupported file would.
+KTX_error_code ktxTexture_CreateFromMemory(
+    const ktx_uint8_t* /*bytes*/,
+    ktx_size_t /*size*/,
+    ktxTextureCreateFlags /*createFlags*/,
+    ktxTexture** /*newTex*/) {
+    return KTX_UNSUPPORTED_FEATURE;
+}
+
+KTX_error_code ktxTexture2_TranscodeBasis(
+    ktxTexture2* /*This*/,
+    ktx_transcode_fmt_e /*fmt*/,
+    ktx_transcode_flags /*transcodeFlags*/) {
+    return KTX_UNSUPPORTED_FEATURE;
+}
+
+KTX_error_code ktxTexture_GLUpload(
+    ktxTexture* /*This*/,
+    GLuint* /*pTexture*/,
+    GLenum* /*pTarget*/,
+    GLenum* /*pGlerror*/) {
+    return KTX_UNSUPPORTED_FEATURE;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   xlog.h
+Content     :   Stand-in for folly's XLOG, which OVR_LogUtils.h uses on Linux, so the host-side
+                tests do not need folly.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+
+#define XLOG_LEVEL_DBG 0
+#define XLOG_LEVEL_INFO 0
+#define XLOG_LEVEL_WARN 1
+#define XLOG_LEVEL_ERR 1
+#define XLOG_LEVEL_FATAL 2
+
+// Only warnings and errors are printed, and FATAL aborts like folly's does.
+#define XLOG(level, message)                                          \
+    do {                                                              \
+        if (XLOG_LEVEL_##level > 0) {                                 \
+            fprintf(stderr, "%s\n", std::string(message).c_str());    \
+        }                                                             \
+        if (XLOG_LEVEL_##level > 1) {                                 \
+            abort();                                                  \
+        }                                                             \
+    } while (0)
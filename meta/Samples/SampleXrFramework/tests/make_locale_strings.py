@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# Licensed under the Oculus SDK License Agreement (the "License");
+# you may not use the Oculus SDK except in compliance with the License,
+# which is provided at the time of installation or download, or which
+# otherwise accompanies this software in either electronic or hard copy form.
+#
+# You may obtain a copy of the License at
+# https://developer.oculus.com/licenses/oculussdk/
+#
+# Unless required by applicable law or agreed to in writing, the Oculus SDK
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Writes an Android format strings.xml with <count> strings for the locale string table tests and
+# benchmark. The values mix non-ASCII text with every escape, entity and markup case the XML
+# loader handles, and the last key repeats the first one.
+#
+# Usage: make_locale_strings.py <strings.xml> <count>
+
+import random
+import sys
+
+WORDS = ["menu", "Weiter", "zurück", "日本語", "ça va", "naïve", "Ünïcödé", "ok", "😀 smile",
+         "%1$s", "a", "b"]
+
+
+def main():
+    if len(sys.argv) != 3:
+        print("usage: make_locale_strings.py <strings.xml> <count>")
+        return 1
+    count = int(sys.argv[2])
+    rng = random.Random(7)
+    out = ['<?xml version="1.0" encoding="utf-8"?>',
+           '<resources xmlns:xliff="urn:oasis:names:tc:xliff:document:1.2">']
+    for i in range(count):
+        value = " ".join(rng.choice(WORDS) for _ in range(rng.randint(1, 8)))
+        kind = i % 7
+        if kind == 0:
+            value += r" \n next"
+        elif kind == 1:
+            value += r" 100%% \'q\' \"d\""
+        elif kind == 2:
+            value += ' <xliff:g id="x">%1$d</xliff:g> items'
+        elif kind == 3:
+            value += " &amp; &lt;tag&gt;"
+        elif kind == 4:
+            value += r" bad\q"
+        elif kind == 5:
+            value += " <![CDATA[<raw> & text]]>"
+        out.append('    <string name="key_%d_%s">%s</string>' % (i, "x" * (i % 5), value))
+    out.append('    <string name="key_0_">duplicate</string>')
+    out.append("    <!-- comment -->")
+    out.append("</resources>")
+    with open(sys.argv[1], "w", encoding="utf-8") as f:
+        f.write("\n".join(out) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename    :   arm_neon.h
+Content     :   Scalar stand-ins for the NEON intrinsics OVR_Math.h uses, with the lane order
+                the ARM documentation gives them, so that its NEON specializations can be
+                compiled and checked on a host without an ARM toolchain. Each lane is one IEEE
+                float operation, as on the device.
+Created     :   October 19, 2026
+Authors     :
+
+************************************************************************************/
+
+#pragma once
+
+struct float32x2_t {
+    float v[2];
+};
+
+struct float32x4_t {
+    float v[4];
+};
+
+struct float32x4x4_t {
+    float32x4_t val[4];
+};
+
+inline float32x4_t vld1q_f32(const float* p) {
+    return {{p[0], p[1], p[2], p[3]}};
+}
+
+inline void vst1q_f32(float* p, float32x4_t a) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = a.v[i];
+    }
+}
+
+// De-interleaves 16 floats: lane j of val[i] is p[4 * j + i].
+inline float32x4x4_t vld4q_f32(const float* p) {
+    float32x4x4_t r;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            r.val[i].v[j] = p[4 * j + i];
+        }
+    }
+    return r;
+}
+
+inline float32x2_t vget_low_f32(float32x4_t a) {
+    return {{a.v[0], a.v[1]}};
+}
+
+inline float32x2_t vget_high_f32(float32x4_t a) {
+    return {{a.v[2], a.v[3]}};
+}
+
+inline float32x4_t vcombine_f32(float32x2_t low, float32x2_t high) {
+    return {{low.v[0], low.v[1], high.v[0], high.v[1]}};
+}
+
+// Reverses the lanes within each 64-bit half.
+inline float32x4_t vrev64q_f32(float32x4_t a) {
+    return {{a.v[1], a.v[0], a.v[3], a.v[2]}};
+}
+
+inline float32x4_t vaddq_f32(float32x4_t a, float32x4_t b) {
+    return {{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}};
+}
+
+inline float32x4_t vmulq_f32(float32x4_t a, float32x4_t b) {
+    return {{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}};
+}
+
+inline float32x4_t vmulq_n_f32(float32x4_t a, float b) {
+    return {{a.v[0] * b, a.v[1] * b, a.v[2] * b, a.v[3] * b}};
+}
+
+inline float32x4_t vmulq_lane_f32(float32x4_t a, float32x2_t b, int lane) {
+    return vmulq_n_f32(a, b.v[lane]);
+}
@@ -68,6 +68,12 @@ SpatialAnchorFileHandler::SpatialAnchorFileHandler() {
     assert(dataDir.back() == '/' || dataDir.back() == '\\');
 }
 
+SpatialAnchorFileHandler::SpatialAnchorFileHandler(const std::string& dataPath) {
+    dataDir = dataPath;
+    ALOGV("Using data path %s", dataDir.c_str());
+    assert(dataDir.back() == '/' || dataDir.back() == '\\');
+}
+
 bool SpatialAnchorFileHandler::LoadShareUserList(std::vector<XrSpaceUserIdFB>& userIdList) {
     ALOGV("LoadShareUserList");
 
@@ -102,33 +108,53 @@ bool SpatialAnchorFileHandler::LoadInboundSpatialAnchorList(
     std::vector<XrUuidEXT>& spatialAnchorList) {
     ALOGV("LoadInboundSpatialAnchorList");
 
+    if (!inboundStore.IsOpen() &&
+        !inboundStore.Open(dataDir + kInboundSpatialAnchorStoreFilename)) {
+        ALOGE("LoadInboundSpatialAnchorList: Failed to open the inbound anchor store");
+        return false;
+    }
+
     std::string filePath = dataDir + kInboundSpatialAnchorListFilename;
 
     ::FILE* file = ::fopen(filePath.c_str(), "r");
-    if (!file) {
-        ALOGE("LoadInboundSpatialAnchorList: Failed to open file: %s", filePath.c_str());
-        return false;
-    }
-    if (::feof(file)) {
-        ALOGE("LoadInboundSpatialAnchorList: File is empty");
-        return false;
-    }
-    const int uuidCstrLength = XR_UUID_SIZE_EXT * 2 + 1;
-    char line[uuidCstrLength];
-    while (!::feof(file)) {
-        ::fscanf(file, "%32s\n", line);
-        if (::ferror(file)) {
-            ALOGE("LoadInboundSpatialAnchorList: Failed to read from file: %s", filePath.c_str());
-            fclose(file);
-            return false;
+    if (file) {
+        std::vector<XrUuidEXT> listed;
+        const int uuidCstrLength = XR_UUID_SIZE_EXT * 2 + 1;
+        char line[uuidCstrLength];
+        while (::fscanf(file, "%32s\n", line) == 1) {
+            XrUuidEXT uuid;
+            if (!hexStringToUuid(line, uuid)) {
+                ALOGE("LoadInboundSpatialAnchorList: Failed to parse UUID string: %s", line);
+                continue;
+            }
+            listed.push_back(uuid);
         }
-        XrUuidEXT uuid;
-        if (!hexStringToUuid(line, uuid)) {
-            ALOGE("LoadInboundSpatialAnchorList: Failed to parse UUID string: %s", line);
+        const bool readError = ::ferror(file) != 0;
+        fclose(file);
+
+        // The text list is authoritative, so anchors taken off it are removed from the store.
+        // A list that could not be read to the end can only add anchors.
+        if (readError) {
+            ALOGE("LoadInboundSpatialAnchorList: Failed to read from file: %s", filePath.c_str());
+            for (const XrUuidEXT& uuid : listed) {
+                inboundStore.Add(uuid);
+            }
+        } else {
+            inboundStore.Assign(listed);
         }
-        spatialAnchorList.emplace_back(uuid);
+        inboundStore.Sync();
+    } else {
+        ALOGW(
+            "LoadInboundSpatialAnchorList: Failed to open file: %s, using the stored anchors",
+            filePath.c_str());
     }
-    fclose(file);
+
+    if (inboundStore.GetCount() == 0) {
+        ALOGE("LoadInboundSpatialAnchorList: No inbound Spatial Anchors");
+        return false;
+    }
+    const std::vector<XrUuidEXT>& uuids = inboundStore.GetUuids();
+    spatialAnchorList.insert(spatialAnchorList.end(), uuids.begin(), uuids.end());
     return true;
 }
 
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "SpatialAnchorExternalDataHandler.h"
+#include "SpatialAnchorUuidStore.h"
 #include <string>
 #include <vector>
 #include <openxr/openxr.h>
@@ -26,9 +27,14 @@
 class SpatialAnchorFileHandler : public SpatialAnchorExternalDataHandler {
    public:
     SpatialAnchorFileHandler();
+    // Reads and writes the files in dataPath, which must end with a slash.
+    explicit SpatialAnchorFileHandler(const std::string& dataPath);
 
     // LoadShareUserList loads the list of FBIDs of users with whom to share Spatial Anchors.
     bool LoadShareUserList(std::vector<XrSpaceUserIdFB>& userIdList) override;
+    // The binary store is updated to hold the inbound UUIDs in the text list, writing only what
+    // changed, and every UUID in the store is returned. Without a text list the UUIDs stored in
+    // earlier sessions are returned.
     bool LoadInboundSpatialAnchorList(std::vector<XrUuidEXT>& spatialAnchorList) override;
     bool WriteSharedSpatialAnchorList(
         const std::vector<XrUuidEXT>& spatialAnchorList,
@@ -39,6 +45,9 @@ class SpatialAnchorFileHandler : public SpatialAnchorExternalDataHandler {
     const char* kShareUserListFilename = "shareUserList.txt";
     const char* kInboundSpatialAnchorListFilename = "inboundSpatialAnchorList.txt";
     const char* kSharedSpatialAnchorListFilename = "sharedSpatialAnchorList.txt";
+    const char* kInboundSpatialAnchorStoreFilename = "inboundSpatialAnchors.store";
+
+    SpatialAnchorUuidStore inboundStore;
 
 // Replace this value with the path you want the named files above to be.
 // Make sure to include the trailing slash (backslash for Windows).
@@ -29,6 +29,8 @@ Copyright : Copyright (c) Meta Platforms, Inc. and its affiliates. All rights re
 
 #include "SpatialAnchorUtilities.h"
 
+#include <cstring>
+
 std::string bin2hex(const uint8_t* src, uint32_t size) {
     std::string res;
     res.reserve(size * 2);
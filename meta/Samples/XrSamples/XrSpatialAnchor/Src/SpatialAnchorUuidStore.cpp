@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename  : SpatialAnchorUuidStore.cpp
+Content   : Binary append-only store for the UUIDs of Spatial Anchors.
+Created   :
+Authors   :
+
+Copyright : Copyright (c) Meta Platforms, Inc. and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include <filesystem>
+#include <system_error>
+
+#include "SpatialAnchorUuidStore.h"
+
+#if defined(WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(ANDROID)
+#include <android/log.h>
+#endif
+
+#if defined(ANDROID)
+#define OVR_LOG_TAG "SpatialAnchorUuidStore"
+
+#define ALOGE(...) __android_log_print(ANDROID_LOG_ERROR, OVR_LOG_TAG, __VA_ARGS__)
+#define ALOGW(...) __android_log_print(ANDROID_LOG_WARN, OVR_LOG_TAG, __VA_ARGS__)
+#else
+#define ALOGE(...)       \
+    printf("ERROR: ");   \
+    printf(__VA_ARGS__); \
+    printf("\n")
+#define ALOGW(...)       \
+    printf("WARN: ");    \
+    printf(__VA_ARGS__); \
+    printf("\n")
+#endif
+
+namespace {
+
+const uint32_t kStoreMagic = 0x5341564f; // "OVAS"
+const uint32_t kStoreVersion = 1;
+
+const uint32_t kRecordAdd = 1;
+const uint32_t kRecordRemove = 2;
+
+// Small logs are not worth compacting even when most of their records are superseded.
+const size_t kMinCompactRecords = 1024;
+
+struct StoreHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t reserved[2];
+};
+
+struct StoreRecord {
+    uint32_t op;
+    uint32_t check;
+    uint8_t uuid[XR_UUID_SIZE_EXT];
+};
+
+static_assert(sizeof(StoreHeader) == 16, "unexpected store header size");
+static_assert(sizeof(StoreRecord) == 24, "unexpected store record size");
+
+uint32_t RecordCheck(uint32_t op, const uint8_t* uuid) {
+    // FNV-1a over the op and the UUID, so torn or corrupt records are detected
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < 4; i++) {
+        h = (h ^ ((op >> (i * 8)) & 0xff)) * 16777619u;
+    }
+    for (int i = 0; i < XR_UUID_SIZE_EXT; i++) {
+        h = (h ^ uuid[i]) * 16777619u;
+    }
+    return h;
+}
+
+StoreRecord MakeRecord(uint32_t op, const XrUuidEXT& uuid) {
+    StoreRecord record;
+    record.op = op;
+    memcpy(record.uuid, uuid.data, XR_UUID_SIZE_EXT);
+    record.check = RecordCheck(op, record.uuid);
+    return record;
+}
+
+bool SyncFile(::FILE* file) {
+    if (::fflush(file) != 0) {
+        return false;
+    }
+#if defined(WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Writes a complete log holding uuids next to filePath, then renames it over filePath.
+bool WriteLog(const std::string& filePath, const std::vector<XrUuidEXT>& uuids) {
+    const std::string tempPath = filePath + ".tmp";
+    ::FILE* file = ::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        ALOGE("Failed to create file: %s", tempPath.c_str());
+        return false;
+    }
+
+    std::vector<StoreRecord> records;
+    records.reserve(uuids.size());
+    for (const XrUuidEXT& uuid : uuids) {
+        records.push_back(MakeRecord(kRecordAdd, uuid));
+    }
+    const StoreHeader header = {kStoreMagic, kStoreVersion, {0, 0}};
+    bool ok = ::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && !records.empty()) {
+        ok = ::fwrite(records.data(), sizeof(StoreRecord), records.size(), file) == records.size();
+    }
+    ok = SyncFile(file) && ok;
+    ok = (::fclose(file) == 0) && ok;
+    if (!ok) {
+        ALOGE("Failed to write data to file: %s", tempPath.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, filePath, ec);
+    if (ec) {
+        ALOGE("Failed to replace %s: %s", filePath.c_str(), ec.message().c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SpatialAnchorUuidStore::~SpatialAnchorUuidStore() {
+    Close();
+}
+
+bool SpatialAnchorUuidStore::Open(const std::string& path) {
+    Close();
+    filePath = path;
+
+    std::vector<uint8_t> data;
+    if (::FILE* in = ::fopen(filePath.c_str(), "rb")) {
+        uint8_t buffer[64 * 1024];
+        size_t count;
+        while ((count = ::fread(buffer, 1, sizeof(buffer), in)) > 0) {
+            data.insert(data.end(), buffer, buffer + count);
+        }
+        const bool readError = ::ferror(in) != 0;
+        ::fclose(in);
+        if (readError) {
+            ALOGE("Failed to read from file: %s", filePath.c_str());
+            return false;
+        }
+    }
+
+    if (data.size() < sizeof(StoreHeader)) {
+        // a new store, or one whose creation was interrupted
+        if (!WriteLog(filePath, uuids)) {
+            return false;
+        }
+    } else {
+        StoreHeader header;
+        memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != kStoreMagic || header.version != kStoreVersion) {
+            ALOGE("%s is not a version %u anchor store", filePath.c_str(), kStoreVersion);
+            return false;
+        }
+
+        size_t offset = sizeof(StoreHeader);
+        for (; offset + sizeof(StoreRecord) <= data.size(); offset += sizeof(StoreRecord)) {
+            StoreRecord record;
+            memcpy(&record, data.data() + offset, sizeof(record));
+            if (record.check != RecordCheck(record.op, record.uuid)) {
+                break;
+            }
+            XrUuidEXT uuid;
+            memcpy(uuid.data, record.uuid, XR_UUID_SIZE_EXT);
+            if (record.op == kRecordAdd) {
+                InsertLive(uuid);
+            } else if (record.op == kRecordRemove) {
+                EraseLive(uuid);
+            } else {
+                break;
+            }
+            recordCount++;
+        }
+
+        if (offset != data.size()) {
+            ALOGW(
+                "%s: dropping %zu bytes after the last complete record",
+                filePath.c_str(),
+                data.size() - offset);
+            std::error_code ec;
+            std::filesystem::resize_file(filePath, offset, ec);
+            if (ec) {
+                ALOGE("Failed to truncate %s: %s", filePath.c_str(), ec.message().c_str());
+                uuids.clear();
+                index.clear();
+                recordCount = 0;
+                return false;
+            }
+        }
+    }
+
+    file = ::fopen(filePath.c_str(), "ab");
+    if (!file) {
+        ALOGE("Failed to open file: %s", filePath.c_str());
+        uuids.clear();
+        index.clear();
+        recordCount = 0;
+        return false;
+    }
+    CompactIfNeeded();
+    return true;
+}
+
+void SpatialAnchorUuidStore::Close() {
+    if (file) {
+        ::fclose(file);
+        file = nullptr;
+    }
+    uuids.clear();
+    index.clear();
+    recordCount = 0;
+}
+
+bool SpatialAnchorUuidStore::Add(const XrUuidEXT& uuid) {
+    if (!file || Contains(uuid) || !AppendRecord(kRecordAdd, uuid)) {
+        return false;
+    }
+    InsertLive(uuid);
+    return true;
+}
+
+bool SpatialAnchorUuidStore::Remove(const XrUuidEXT& uuid) {
+    if (!file || !Contains(uuid) || !AppendRecord(kRecordRemove, uuid)) {
+        return false;
+    }
+    EraseLive(uuid);
+    CompactIfNeeded();
+    return true;
+}
+
+bool SpatialAnchorUuidStore::Contains(const XrUuidEXT& uuid) const {
+    return index.find(uuid) != index.end();
+}
+
+bool SpatialAnchorUuidStore::Sync() {
+    return file && SyncFile(file);
+}
+
+bool SpatialAnchorUuidStore::Assign(const std::vector<XrUuidEXT>& newUuids) {
+    if (!file) {
+        return false;
+    }
+
+    const std::unordered_set<XrUuidEXT, UuidHash, UuidEqual> wanted(
+        newUuids.begin(), newUuids.end());
+    std::vector<XrUuidEXT> removed;
+    for (const XrUuidEXT& uuid : uuids) {
+        if (wanted.find(uuid) == wanted.end()) {
+            removed.push_back(uuid);
+        }
+    }
+
+    bool ok = true;
+    for (const XrUuidEXT& uuid : removed) {
+        ok = ok && WriteRecord(kRecordRemove, uuid);
+        EraseLive(uuid);
+    }
+    for (const XrUuidEXT& uuid : newUuids) {
+        if (!Contains(uuid)) {
+            ok = ok && WriteRecord(kRecordAdd, uuid);
+            InsertLive(uuid);
+        }
+    }
+    if (!ok || ::fflush(file) != 0) {
+        ALOGE("Failed to write data to file: %s", filePath.c_str());
+        const std::string path = filePath;
+        Open(path);
+        return false;
+    }
+    CompactIfNeeded();
+    return true;
+}
+
+bool SpatialAnchorUuidStore::Compact() {
+    if (!file) {
+        return false;
+    }
+    ::fclose(file);
+    file = nullptr;
+
+    const bool written = WriteLog(filePath, uuids);
+    if (written) {
+        recordCount = uuids.size();
+    }
+    // on failure the old log is still in place and still matches the index
+    file = ::fopen(filePath.c_str(), "ab");
+    if (!file) {
+        ALOGE("Failed to open file: %s", filePath.c_str());
+        uuids.clear();
+        index.clear();
+        recordCount = 0;
+        return false;
+    }
+    return written;
+}
+
+bool SpatialAnchorUuidStore::WriteRecord(uint32_t op, const XrUuidEXT& uuid) {
+    const StoreRecord record = MakeRecord(op, uuid);
+    if (::fwrite(&record, sizeof(record), 1, file) != 1) {
+        return false;
+    }
+    recordCount++;
+    return true;
+}
+
+bool SpatialAnchorUuidStore::AppendRecord(uint32_t op, const XrUuidEXT& uuid) {
+    if (!WriteRecord(op, uuid) || ::fflush(file) != 0) {
+        ALOGE("Failed to write data to file: %s", filePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void SpatialAnchorUuidStore::InsertLive(const XrUuidEXT& uuid) {
+    if (index.emplace(uuid, uuids.size()).second) {
+        uuids.push_back(uuid);
+    }
+}
+
+void SpatialAnchorUuidStore::EraseLive(const XrUuidEXT& uuid) {
+    auto it = index.find(uuid);
+    if (it == index.end()) {
+        return;
+    }
+    // move the last UUID into the hole so removal does not shift the rest
+    const size_t position = it->second;
+    index.erase(it);
+    if (position != uuids.size() - 1) {
+        uuids[position] = uuids.back();
+        index[uuids[position]] = position;
+    }
+    uuids.pop_back();
+}
+
+void SpatialAnchorUuidStore::CompactIfNeeded() {
+    const size_t superseded = recordCount - uuids.size();
+    if (superseded >= kMinCompactRecords && superseded > uuids.size()) {
+        Compact();
+    }
+}
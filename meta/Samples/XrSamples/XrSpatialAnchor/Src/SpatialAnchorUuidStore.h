@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <openxr/openxr.h>
+
+// SpatialAnchorUuidStore persists a set of UUIDs in a binary append-only log.
+//
+// The file is a 16 byte header followed by fixed 24 byte records, each adding or removing one
+// UUID and carrying a checksum. Adding or removing a UUID appends a single record, so the cost
+// does not depend on how many UUIDs are stored. Open replays the log into a hash index and stops
+// at the first incomplete or corrupt record, which is what an interrupted append leaves behind,
+// and cuts the file back to the last good record.
+//
+// Once the log holds more superseded records than live ones it is compacted: the live set is
+// written to a temporary file which then replaces the log with a rename, so a crash leaves
+// either the old or the new log in place.
+class SpatialAnchorUuidStore {
+   public:
+    SpatialAnchorUuidStore() = default;
+    ~SpatialAnchorUuidStore();
+
+    SpatialAnchorUuidStore(const SpatialAnchorUuidStore&) = delete;
+    SpatialAnchorUuidStore& operator=(const SpatialAnchorUuidStore&) = delete;
+
+    // Opens the store at filePath, creating it if it does not exist.
+    bool Open(const std::string& filePath);
+    void Close();
+    bool IsOpen() const {
+        return file != nullptr;
+    }
+
+    // Add and Remove return false if the UUID was already present or absent, or on write errors.
+    // Records reach the operating system before they return, call Sync to also have them reach
+    // storage.
+    bool Add(const XrUuidEXT& uuid);
+    bool Remove(const XrUuidEXT& uuid);
+    bool Contains(const XrUuidEXT& uuid) const;
+    bool Sync();
+
+    // Makes the live set hold exactly newUuids, appending records only for the UUIDs added or
+    // removed and flushing them once. On a write error the store is reopened, so that it matches
+    // what reached the file, and false is returned.
+    bool Assign(const std::vector<XrUuidEXT>& newUuids);
+
+    // Rewrites the log with only the live UUIDs.
+    bool Compact();
+
+    // The live UUIDs, in no particular order.
+    const std::vector<XrUuidEXT>& GetUuids() const {
+        return uuids;
+    }
+    size_t GetCount() const {
+        return uuids.size();
+    }
+
+   private:
+    struct UuidHash {
+        size_t operator()(const XrUuidEXT& uuid) const {
+            // UUIDs are random, so any eight of their bytes make a good hash
+            uint64_t h;
+            memcpy(&h, uuid.data, sizeof(h));
+            return static_cast<size_t>(h);
+        }
+    };
+    struct UuidEqual {
+        bool operator()(const XrUuidEXT& a, const XrUuidEXT& b) const {
+            return memcmp(a.data, b.data, XR_UUID_SIZE_EXT) == 0;
+        }
+    };
+
+    bool WriteRecord(uint32_t op, const XrUuidEXT& uuid);
+    bool AppendRecord(uint32_t op, const XrUuidEXT& uuid);
+    void InsertLive(const XrUuidEXT& uuid);
+    void EraseLive(const XrUuidEXT& uuid);
+    void CompactIfNeeded();
+
+    std::string filePath;
+    ::FILE* file = nullptr;
+    std::vector<XrUuidEXT> uuids;
+    std::unordered_map<XrUuidEXT, size_t, UuidHash, UuidEqual> index; // position in uuids
+    size_t recordCount = 0;
+};
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename  : SpatialAnchorUuidStoreBenchmark.cpp
+Content   : Times the inbound Spatial Anchor store and text list with 100k UUIDs.
+Created   :
+Authors   :
+
+Copyright : Copyright (c) Meta Platforms, Inc. and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SpatialAnchorFileHandler.h"
+#include "SpatialAnchorUtilities.h"
+#include "SpatialAnchorUuidStore.h"
+
+template <typename Function>
+static double MillisecondsPerRun(int const runs, Function&& function) {
+    function(); // warm up caches
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i) {
+        function();
+    }
+    auto const end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+}
+
+static std::vector<XrUuidEXT> RandomUuids(size_t count, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<XrUuidEXT> uuids(count);
+    for (XrUuidEXT& uuid : uuids) {
+        const uint64_t a = rng();
+        const uint64_t b = rng();
+        memcpy(uuid.data, &a, sizeof(a));
+        memcpy(uuid.data + sizeof(a), &b, sizeof(b));
+    }
+    return uuids;
+}
+
+static void WriteTextList(const std::string& path, const std::vector<XrUuidEXT>& uuids) {
+    ::FILE* file = ::fopen(path.c_str(), "w");
+    for (const XrUuidEXT& uuid : uuids) {
+        ::fprintf(file, "%s\n", uuidToHexString(uuid).c_str());
+    }
+    ::fclose(file);
+}
+
+int main(int argc, char** argv) {
+    const std::string dir = argc > 1
+        ? std::string(argv[1])
+        : (std::filesystem::temp_directory_path() / "SpatialAnchorUuidStoreBenchmark").string();
+    const size_t count = argc > 2 ? strtoul(argv[2], nullptr, 10) : 100000;
+    const int runs = argc > 3 ? atoi(argv[3]) : 5;
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir + "/handler");
+    const std::string storePath = dir + "/bench.store";
+    const std::vector<XrUuidEXT> ids = RandomUuids(count, 1);
+    // the same list with 1% of the UUIDs replaced
+    std::vector<XrUuidEXT> changed = ids;
+    const std::vector<XrUuidEXT> replacements = RandomUuids(count / 100, 2);
+    for (size_t i = 0; i < replacements.size(); i++) {
+        changed[i * 100] = replacements[i];
+    }
+
+    // Writing: one record per Add, flushed each time, against a single Assign.
+    const double addEach = MillisecondsPerRun(runs, [&] {
+        std::filesystem::remove(storePath);
+        SpatialAnchorUuidStore store;
+        store.Open(storePath);
+        for (const XrUuidEXT& uuid : ids) {
+            store.Add(uuid);
+        }
+    });
+    const double assignAll = MillisecondsPerRun(runs, [&] {
+        std::filesystem::remove(storePath);
+        SpatialAnchorUuidStore store;
+        store.Open(storePath);
+        store.Assign(ids);
+    });
+
+    // Reading: opening a log of every UUID, and syncing it with a list.
+    const double open = MillisecondsPerRun(runs, [&] {
+        SpatialAnchorUuidStore store;
+        store.Open(storePath);
+    });
+    SpatialAnchorUuidStore store;
+    store.Open(storePath);
+    const double assignSame = MillisecondsPerRun(runs, [&] { store.Assign(ids); });
+    const double assignChanged = MillisecondsPerRun(runs, [&] {
+        store.Assign(changed);
+        store.Assign(ids);
+    }) / 2;
+    size_t found = 0;
+    const double contains = MillisecondsPerRun(runs, [&] {
+        for (const XrUuidEXT& uuid : changed) {
+            found += store.Contains(uuid) ? 1 : 0;
+        }
+    });
+    store.Close();
+
+    // The whole load: parsing the text list is what it cost before the store existed.
+    const std::string textList = dir + "/handler/inboundSpatialAnchorList.txt";
+    WriteTextList(textList, ids);
+    const double parseText = MillisecondsPerRun(runs, [&] {
+        std::vector<XrUuidEXT> uuids;
+        ::FILE* file = ::fopen(textList.c_str(), "r");
+        char line[XR_UUID_SIZE_EXT * 2 + 1];
+        while (::fscanf(file, "%32s\n", line) == 1) {
+            XrUuidEXT uuid;
+            if (hexStringToUuid(line, uuid)) {
+                uuids.push_back(uuid);
+            }
+        }
+        ::fclose(file);
+    });
+    const double loadSame = MillisecondsPerRun(runs, [&] {
+        SpatialAnchorFileHandler handler(dir + "/handler/");
+        std::vector<XrUuidEXT> uuids;
+        handler.LoadInboundSpatialAnchorList(uuids);
+    });
+
+    printf("%zu UUIDs, store %ju bytes\n", count, (uintmax_t)std::filesystem::file_size(storePath));
+    printf("Add each, flushed:             %8.2f ms\n", addEach);
+    printf("Assign to an empty store:      %8.2f ms\n", assignAll);
+    printf("Open:                          %8.2f ms\n", open);
+    printf("Assign unchanged:              %8.2f ms\n", assignSame);
+    printf("Assign with 1%% replaced:       %8.2f ms\n", assignChanged);
+    printf("Contains:                      %8.1f ns each (%zu)\n", contains * 1e6 / count, found);
+    printf("parse the text list:           %8.2f ms\n", parseText);
+    printf("LoadInboundSpatialAnchorList:  %8.2f ms\n", loadSame);
+    return 0;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/************************************************************************************
+
+Filename  : SpatialAnchorUuidStoreTest.cpp
+Content   : Checks the inbound Spatial Anchor store, and that the inbound text list is
+            authoritative for it.
+Created   :
+Authors   :
+
+Copyright : Copyright (c) Meta Platforms, Inc. and its affiliates. All rights reserved.
+
+*************************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SpatialAnchorFileHandler.h"
+#include "SpatialAnchorUtilities.h"
+#include "SpatialAnchorUuidStore.h"
+
+static int s_failures = 0;
+
+#define CHECK(expr)                                                   \
+    do {                                                              \
+        if (!(expr)) {                                                \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #expr);    \
+            s_failures++;                                             \
+        }                                                             \
+    } while (0)
+
+static std::vector<XrUuidEXT> RandomUuids(size_t count, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<XrUuidEXT> uuids(count);
+    for (XrUuidEXT& uuid : uuids) {
+        const uint64_t a = rng();
+        const uint64_t b = rng();
+        memcpy(uuid.data, &a, sizeof(a));
+        memcpy(uuid.data + sizeof(a), &b, sizeof(b));
+    }
+    return uuids;
+}
+
+static std::vector<std::string> Sorted(const std::vector<XrUuidEXT>& uuids) {
+    std::vector<std::string> strings;
+    for (const XrUuidEXT& uuid : uuids) {
+        strings.push_back(uuidToHexString(uuid));
+    }
+    std::sort(strings.begin(), strings.end());
+    return strings;
+}
+
+static bool SameSet(const std::vector<XrUuidEXT>& a, const std::vector<XrUuidEXT>& b) {
+    return Sorted(a) == Sorted(b);
+}
+
+static uintmax_t FileSize(const std::string& path) {
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : size;
+}
+
+static uintmax_t LogSize(size_t records) {
+    return 16 + 24 * records;
+}
+
+static void WriteTextList(const std::string& path, const std::vector<XrUuidEXT>& uuids) {
+    ::FILE* file = ::fopen(path.c_str(), "w");
+    for (const XrUuidEXT& uuid : uuids) {
+        ::fprintf(file, "%s\n", uuidToHexString(uuid).c_str());
+    }
+    ::fclose(file);
+}
+
+static void TestAddRemove(const std::string& dir) {
+    const std::string path = dir + "/add_remove.store";
+    const std::vector<XrUuidEXT> ids = RandomUuids(4, 1);
+    {
+        SpatialAnchorUuidStore store;
+        CHECK(store.Open(path));
+        CHECK(store.GetCount() == 0);
+        CHECK(FileSize(path) == LogSize(0));
+        CHECK(store.Add(ids[0]));
+        CHECK(store.Add(ids[1]));
+        CHECK(store.Add(ids[2]));
+        CHECK(!store.Add(ids[1]));
+        CHECK(store.Remove(ids[1]));
+        CHECK(!store.Remove(ids[1]));
+        CHECK(!store.Remove(ids[3]));
+        CHECK(store.Contains(ids[0]) && !store.Contains(ids[1]) && store.Contains(ids[2]));
+        CHECK(store.Sync());
+        CHECK(FileSize(path) == LogSize(4));
+    }
+    SpatialAnchorUuidStore store;
+    CHECK(store.Open(path));
+    CHECK(SameSet(store.GetUuids(), {ids[0], ids[2]}));
+}
+
+static void TestDamagedLog(const std::string& dir) {
+    const std::string path = dir + "/damaged.store";
+    const std::vector<XrUuidEXT> ids = RandomUuids(3, 2);
+    {
+        SpatialAnchorUuidStore store;
+        CHECK(store.Open(path));
+        for (const XrUuidEXT& uuid : ids) {
+            CHECK(store.Add(uuid));
+        }
+    }
+
+    // an interrupted append leaves part of a record, which is cut off
+    {
+        ::FILE* file = ::fopen(path.c_str(), "ab");
+        ::fwrite("torn", 1, 4, file);
+        ::fclose(file);
+        SpatialAnchorUuidStore store;
+        CHECK(store.Open(path));
+        CHECK(SameSet(store.GetUuids(), ids));
+        CHECK(FileSize(path) == LogSize(3));
+    }
+
+    // replay stops at a corrupt record
+    {
+        ::FILE* file = ::fopen(path.c_str(), "r+b");
+        ::fseek(file, static_cast<long>(LogSize(2) + 10), SEEK_SET);
+        ::fputc(0xa5, file);
+        ::fclose(file);
+        SpatialAnchorUuidStore store;
+        CHECK(store.Open(path));
+        CHECK(SameSet(store.GetUuids(), {ids[0], ids[1]}));
+        CHECK(FileSize(path) == LogSize(2));
+    }
+
+    // a file that is not a store is left alone
+    const std::string other = dir + "/not_a_store.txt";
+    {
+        ::FILE* file = ::fopen(other.c_str(), "wb");
+        ::fputs("this is not an anchor store", file);
+        ::fclose(file);
+    }
+    SpatialAnchorUuidStore store;
+    CHECK(!store.Open(other));
+    CHECK(FileSize(other) == strlen("this is not an anchor store"));
+}
+
+static void TestCompaction(const std::string& dir) {
+    const std::string path = dir + "/compaction.store";
+    const std::vector<XrUuidEXT> ids = RandomUuids(3000, 3);
+    SpatialAnchorUuidStore store;
+    CHECK(store.Open(path));
+    for (const XrUuidEXT& uuid : ids) {
+        CHECK(store.Add(uuid));
+    }
+    // compacts once superseded records pass 1024 and outnumber the live ones
+    for (size_t i = 0; i < 2000; i++) {
+        CHECK(store.Remove(ids[i]));
+    }
+    CHECK(store.GetCount() == 1000);
+    CHECK(FileSize(path) < LogSize(5000));
+
+    SpatialAnchorUuidStore reopened;
+    CHECK(reopened.Open(path));
+    CHECK(SameSet(reopened.GetUuids(), std::vector<XrUuidEXT>(ids.begin() + 2000, ids.end())));
+}
+
+static void TestAssign(const std::string& dir) {
+    const std::string path = dir + "/assign.store";
+    const std::vector<XrUuidEXT> ids = RandomUuids(200, 4);
+    const std::vector<XrUuidEXT> first(ids.begin(), ids.begin() + 100);
+    std::vector<XrUuidEXT> second(ids.begin() + 50, ids.begin() + 150);
+    second.push_back(ids[60]); // listed twice
+
+    SpatialAnchorUuidStore store;
+    CHECK(store.Open(path));
+    CHECK(store.Assign(first));
+    CHECK(SameSet(store.GetUuids(), first));
+    CHECK(FileSize(path) == LogSize(100));
+
+    // only the 50 removed and 50 added UUIDs are written
+    CHECK(store.Assign(second));
+    CHECK(SameSet(store.GetUuids(), std::vector<XrUuidEXT>(ids.begin() + 50, ids.begin() + 150)));
+    CHECK(FileSize(path) == LogSize(200));
+
+    // nothing changed, nothing is written
+    CHECK(store.Assign(second));
+    CHECK(FileSize(path) == LogSize(200));
+
+    CHECK(store.Assign({}));
+    CHECK(store.GetCount() == 0);
+    CHECK(store.Assign(first));
+
+    SpatialAnchorUuidStore reopened;
+    CHECK(reopened.Open(path));
+    CHECK(SameSet(reopened.GetUuids(), first));
+}
+
+static void TestFileHandler(const std::string& dir) {
+    const std::string dataDir = dir + "/handler/";
+    std::filesystem::create_directories(dataDir);
+    const std::string textList = dataDir + "inboundSpatialAnchorList.txt";
+    const std::vector<XrUuidEXT> ids = RandomUuids(4, 5);
+
+    std::vector<XrUuidEXT> loaded;
+    {
+        SpatialAnchorFileHandler handler(dataDir);
+        CHECK(!handler.LoadInboundSpatialAnchorList(loaded));
+        CHECK(loaded.empty());
+
+        WriteTextList(textList, {ids[0], ids[1], ids[2]});
+        CHECK(handler.LoadInboundSpatialAnchorList(loaded));
+        CHECK(SameSet(loaded, {ids[0], ids[1], ids[2]}));
+
+        // anchors taken off the list are dropped, within a session
+        WriteTextList(textList, {ids[1], ids[2], ids[3]});
+        loaded.clear();
+        CHECK(handler.LoadInboundSpatialAnchorList(loaded));
+        CHECK(SameSet(loaded, {ids[1], ids[2], ids[3]}));
+    }
+
+    // and in the next session
+    WriteTextList(textList, {ids[3]});
+    {
+        SpatialAnchorFileHandler handler(dataDir);
+        loaded.clear();
+        CHECK(handler.LoadInboundSpatialAnchorList(loaded));
+        CHECK(SameSet(loaded, {ids[3]}));
+    }
+
+    // without a text list the stored anchors are loaded
+    std::filesystem::remove(textList);
+    {
+        SpatialAnchorFileHandler handler(dataDir);
+        loaded.clear();
+        CHECK(handler.LoadInboundSpatialAnchorList(loaded));
+        CHECK(SameSet(loaded, {ids[3]}));
+    }
+
+    // lines that are not UUIDs are skipped
+    {
+        ::FILE* file = ::fopen(textList.c_str(), "w");
+        ::fprintf(
+            file,
+            "%s\nnot-a-uuid\n%s\n",
+            uuidToHexString(ids[0]).c_str(),
+            uuidToHexString(ids[1]).c_str());
+        ::fclose(file);
+        SpatialAnchorFileHandler handler(dataDir);
+        loaded.clear();
+        CHECK(handler.LoadInboundSpatialAnchorList(loaded));
+        CHECK(SameSet(loaded, {ids[0], ids[1]}));
+    }
+
+    // an empty list empties the store
+    WriteTextList(textList, {});
+    {
+        SpatialAnchorFileHandler handler(dataDir);
+        loaded.clear();
+        CHECK(!handler.LoadInboundSpatialAnchorList(loaded));
+        CHECK(loaded.empty());
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("usage: %s <work directory>\n", argv[0]);
+        return 1;
+    }
+    const std::string dir = argv[1];
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    TestAddRemove(dir);
+    TestDamagedLog(dir);
+    TestCompaction(dir);
+    TestAssign(dir);
+    TestFileHandler(dir);
+
+    if (s_failures != 0) {
+        printf("%d failures\n", s_failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -34,6 +34,7 @@ Copyright   :   Copyright (c) Meta Platforms, Inc. and affiliates. Confidential
 #include <Model/ModelFileLoading.h>
 #include <Model/ModelDef.h>
 #include <Render/Egl.h>
+#include <Render/GlState.h>
 #include <OVR_Math.h>
 
 namespace {
@@ -136,7 +137,7 @@ bool ParseImageUri(
 OVRFW::GlTexture CreateGlTexture(uint32_t pixelWidth, uint32_t pixelHeight) {
     GLuint texId;
     glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
+    OVRFW::GetGlState().BindTexture(GL_TEXTURE_2D, texId);
     glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, pixelWidth, pixelHeight);
     std::vector<uint8_t> blankBytes((size_t)pixelWidth * pixelHeight * 4);
     glTexSubImage2D(
@@ -149,11 +150,12 @@ OVRFW::GlTexture CreateGlTexture(uint32_t pixelWidth, uint32_t pixelHeight) {
         GL_RGBA,
         GL_UNSIGNED_BYTE,
         blankBytes.data());
+    OVRFW::GetGlState().BindTexture(GL_TEXTURE_2D, 0);
     return OVRFW::GlTexture(texId, GL_TEXTURE_2D, pixelWidth, pixelHeight);
 }
 
 void UpdateGlTexture(OVRFW::GlTexture texture, const uint8_t* textureData) {
-    glBindTexture(GL_TEXTURE_2D, texture.texture);
+    OVRFW::GetGlState().BindTexture(GL_TEXTURE_2D, texture.texture);
     glTexSubImage2D(
         GL_TEXTURE_2D,
         0,
@@ -164,6 +166,7 @@ void UpdateGlTexture(OVRFW::GlTexture texture, const uint8_t* textureData) {
         GL_RGBA,
         GL_UNSIGNED_BYTE,
         textureData);
+    OVRFW::GetGlState().BindTexture(GL_TEXTURE_2D, 0);
 }
 
 const OVRFW::ModelNode* FindCollisionNode(const OVRFW::ModelFile& model) {
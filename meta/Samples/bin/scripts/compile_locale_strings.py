@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+# All rights reserved.
+#
+# Licensed under the Oculus SDK License Agreement (the "License");
+# you may not use the Oculus SDK except in compliance with the License,
+# which is provided at the time of installation or download, or which
+# otherwise accompanies this software in either electronic or hard copy form.
+#
+# You may obtain a copy of the License at
+# https://developer.oculus.com/licenses/oculussdk/
+#
+# Unless required by applicable law or agreed to in writing, the Oculus SDK
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Compiles Android format strings.xml files into the binary string table read by
+# ovrLocaleStringTable (SampleXrFramework/Src/Locale/OVR_LocaleStringTable.h), so the locale
+# does not have to parse XML at startup.
+#
+# Usage: compile_locale_strings.py <output.bin> <strings.xml> [<strings.xml> ...]
+#
+# Strings are decoded exactly like ovrLocale::AddStringsFromAndroidFormatXMLBuffer. When a key
+# appears more than once, the first definition wins.
+
+import struct
+import sys
+from xml.dom import minidom
+
+MAGIC = 0x534C564F  # "OVLS"
+VERSION = 1
+HEADER_FORMAT = "<8I"
+ENTRY_FORMAT = "<4I"
+
+
+def table_hash(seed, data):
+    h = seed if seed != 0 else 0x01000193
+    for b in data:
+        h = ((h * 0x01000193) ^ b) & 0xFFFFFFFF
+    return h
+
+
+def node_value(node, out):
+    # Matches GetValueFromNode: leaf nodes contribute their value, which for an empty element
+    # is its name, and whitespace-only text is dropped by the XML parser.
+    if node.nodeType in (node.TEXT_NODE, node.CDATA_SECTION_NODE):
+        if node.nodeType == node.CDATA_SECTION_NODE or node.data.strip():
+            out.append(node.data)
+    elif node.nodeType == node.COMMENT_NODE:
+        out.append(node.data)
+    elif node.nodeType == node.ELEMENT_NODE:
+        children = [c for c in node.childNodes if not is_ignored(c)]
+        if children:
+            for child in children:
+                node_value(child, out)
+        else:
+            out.append(node.tagName)
+
+
+def is_ignored(node):
+    return node.nodeType == node.TEXT_NODE and not node.data.strip()
+
+
+def decode_escapes(value, name):
+    out = []
+    i = 0
+    while i < len(value):
+        c = value[i]
+        i += 1
+        if c == "\\":
+            if i >= len(value):
+                break
+            n = value[i]
+            i += 1
+            if n == "n":
+                c = "\n"
+            elif n == "\r":
+                c = "\r"
+            else:
+                if n not in "<>\"'&":
+                    print("%s: unknown escape sequence '\\%s'" % (name, n), file=sys.stderr)
+                    out.append(c)
+                c = n
+        elif c == "%":
+            # the localization pipeline doubles % format specifiers
+            if i < len(value) and value[i] == "%":
+                i += 1
+        out.append(c)
+    return "".join(out)
+
+
+def read_strings(path, strings):
+    doc = minidom.parse(path)
+    root = doc.documentElement
+    if root.tagName.lower() != "resources":
+        raise ValueError(
+            "%s: expected root value of 'resources', found '%s'" % (path, root.tagName))
+    for element in root.childNodes:
+        if element.nodeType != element.ELEMENT_NODE:
+            continue
+        if element.tagName.lower() != "string":
+            print(
+                "%s: expected element 'string', found '%s'" % (path, element.tagName),
+                file=sys.stderr)
+            continue
+        key = element.getAttribute("name")
+        value = []
+        for child in element.childNodes:
+            if not is_ignored(child):
+                node_value(child, value)
+        if key not in strings:
+            strings[key] = decode_escapes("".join(value), path)
+
+
+def build_table(strings):
+    keys = [k.encode("utf-8") for k in strings]
+    values = [v.encode("utf-8") for v in strings.values()]
+    count = len(keys)
+
+    # Minimal perfect hash by hash and displace: buckets with collisions get a seed that moves all
+    # of their keys to free slots, then single-key buckets are placed directly.
+    seeds = [0] * count
+    slots = [None] * count
+    buckets = [[] for _ in range(count)]
+    for i, key in enumerate(keys):
+        buckets[table_hash(0, key) % count].append(i)
+    order = sorted(range(count), key=lambda b: len(buckets[b]), reverse=True)
+
+    pos = 0
+    while pos < count and len(buckets[order[pos]]) > 1:
+        bucket = buckets[order[pos]]
+        seed = 1
+        while True:
+            taken = set()
+            for i in bucket:
+                slot = table_hash(seed, keys[i]) % count
+                if slots[slot] is not None or slot in taken:
+                    break
+                taken.add(slot)
+            else:
+                break
+            seed += 1
+        for i in bucket:
+            slots[table_hash(seed, keys[i]) % count] = i
+        seeds[order[pos]] = seed
+        pos += 1
+
+    free = [s for s in range(count) if slots[s] is None]
+    while pos < count and len(buckets[order[pos]]) == 1:
+        slot = free.pop()
+        slots[slot] = buckets[order[pos]][0]
+        seeds[order[pos]] = -slot - 1
+        pos += 1
+
+    # Intern the null-terminated strings.
+    blob = bytearray()
+    interned = {}
+
+    def intern(s):
+        if s not in interned:
+            interned[s] = len(blob)
+            blob.extend(s + b"\0")
+        return interned[s]
+
+    entries = bytearray()
+    for slot in range(count):
+        i = slots[slot]
+        entries += struct.pack(
+            ENTRY_FORMAT, intern(keys[i]), len(keys[i]), intern(values[i]), len(values[i]))
+
+    seeds_offset = struct.calcsize(HEADER_FORMAT)
+    entries_offset = seeds_offset + 4 * count
+    blob_offset = entries_offset + len(entries)
+    header = struct.pack(
+        HEADER_FORMAT,
+        MAGIC,
+        VERSION,
+        count,
+        seeds_offset,
+        entries_offset,
+        blob_offset,
+        len(blob),
+        0)
+    return header + struct.pack("<%di" % count, *seeds) + bytes(entries) + bytes(blob)
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(
+            "usage: %s <output.bin> <strings.xml> [<strings.xml> ...]" % argv[0], file=sys.stderr)
+        return 1
+    strings = {}
+    for path in argv[2:]:
+        read_strings(path, strings)
+    with open(argv[1], "wb") as f:
+        f.write(build_table(strings))
+    print("Wrote %d strings to '%s'" % (len(strings), argv[1]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,89 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Camera2 Tutorial: lock-free single-producer/single-consumer frame handoff.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Three frame slots shared between one producer thread (the camera callback) and one consumer
+// thread (the render loop). At any time the producer owns the back slot, the consumer owns the
+// front slot and the middle slot holds the most recently published frame. Publishing and
+// acquiring each swap one slot index with an atomic exchange, so neither side ever waits on the
+// other and no pixels are copied. If the producer publishes faster than the consumer acquires,
+// only the newest frame is kept.
+class FrameTripleBuffer {
+public:
+    static constexpr int kSlotCount = 3;
+
+    struct Frame {
+        uint8_t *pixels = nullptr;  // owned by the consumer until the next AcquireLatest
+        size_t size = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        bool isBgra = false;
+        uint64_t sequence = 0;  // increments with every published frame
+    };
+
+    // Producer: returns the back slot, with room for size bytes, to write the next frame into.
+    uint8_t *BeginWrite(size_t size) {
+        Slot &slot = m_slots[m_back];
+        if (slot.storage.size() < size) {
+            slot.storage.resize(size);
+        }
+        slot.frame.pixels = slot.storage.data();
+        slot.frame.size = size;
+        return slot.frame.pixels;
+    }
+
+    // Producer: publishes the back slot written since BeginWrite and takes over the previous
+    // middle slot as the new back slot.
+    void EndWrite(uint32_t width, uint32_t height, bool isBgra) {
+        Slot &slot = m_slots[m_back];
+        slot.frame.width = width;
+        slot.frame.height = height;
+        slot.frame.isBgra = isBgra;
+        slot.frame.sequence = ++m_published;
+        const uint32_t previous = m_middle.exchange(m_back | kFreshBit, std::memory_order_acq_rel);
+        m_back = previous & kIndexMask;
+    }
+
+    // Consumer: if a frame was published since the last call, makes it the front slot and
+    // returns true. frame always describes the front slot, which stays valid and unchanged until
+    // the next call.
+    bool AcquireLatest(Frame &frame) {
+        bool fresh = false;
+        if (m_middle.load(std::memory_order_relaxed) & kFreshBit) {
+            const uint32_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & kIndexMask;
+            fresh = true;
+        }
+        frame = m_slots[m_front].frame;
+        return fresh;
+    }
+
+    // Number of frames published so far; safe to read from any thread.
+    uint64_t GetPublishedCount() const {
+        return m_published.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t kIndexMask = 0x3;
+    static constexpr uint32_t kFreshBit = 0x4;
+
+    struct Slot {
+        Frame frame;
+        std::vector<uint8_t> storage;
+    };
+
+    Slot m_slots[kSlotCount];
+    uint32_t m_back = 0;                  // producer only
+    uint32_t m_front = 1;                 // consumer only
+    std::atomic<uint32_t> m_middle = {2}; // slot index | kFreshBit when not yet acquired
+    std::atomic<uint64_t> m_published = {0};
+};
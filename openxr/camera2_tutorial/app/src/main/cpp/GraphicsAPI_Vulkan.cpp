@@ -69,7 +69,8 @@ VkDescriptorType ToVkDescrtiptorType(const GraphicsAPI::DescriptorInfo &descInfo
     switch (descInfo.type) {
     default:
     case GraphicsAPI::DescriptorInfo::Type::BUFFER: {
-        vkType = descInfo.readWrite ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        // Uniform buffers are dynamic so that draws which only differ by their uniform buffer offset can share a descriptor set.
+        vkType = descInfo.readWrite ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         break;
     }
     case GraphicsAPI::DescriptorInfo::Type::IMAGE: {
@@ -160,6 +161,11 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan() {
             queueFamilyIndex = static_cast<uint32_t>(i);
             queueIndex = 0;
         }
+        // A family that can only transfer maps to a copy engine that runs alongside the graphics queue.
+        VkQueueFlags queueFlags = queueFamilyProperties[i].queueFlags;
+        if (BitwiseCheck(queueFlags, VkQueueFlags(VK_QUEUE_TRANSFER_BIT)) && !BitwiseCheck(queueFlags, VkQueueFlags(VK_QUEUE_GRAPHICS_BIT)) && !BitwiseCheck(queueFlags, VkQueueFlags(VK_QUEUE_COMPUTE_BIT)) && transferQueueFamilyIndex == 0xFFFFFFFF) {
+            transferQueueFamilyIndex = static_cast<uint32_t>(i);
+        }
     }
 
     uint32_t deviceExtensionCount = 0;
@@ -195,45 +201,12 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan() {
     deviceCI.pEnabledFeatures = &features;
     VULKAN_CHECK(vkCreateDevice(physicalDevice, &deviceCI, nullptr, &device), "Failed to create Device.");
 
-    VkCommandPoolCreateInfo cmdPoolCI;
-    cmdPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    cmdPoolCI.pNext = nullptr;
-    cmdPoolCI.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    cmdPoolCI.queueFamilyIndex = queueFamilyIndex;
-    VULKAN_CHECK(vkCreateCommandPool(device, &cmdPoolCI, nullptr, &cmdPool), "Failed to create CommandPool.");
-
-    VkCommandBufferAllocateInfo allocateInfo;
-    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.pNext = nullptr;
-    allocateInfo.commandPool = cmdPool;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocateInfo.commandBufferCount = 1;
-    VULKAN_CHECK(vkAllocateCommandBuffers(device, &allocateInfo, &cmdBuffer), "Failed to allocate CommandBuffers.");
-
     vkGetDeviceQueue(device, queueFamilyIndex, queueIndex, &queue);
+    if (transferQueueFamilyIndex != 0xFFFFFFFF) {
+        vkGetDeviceQueue(device, transferQueueFamilyIndex, 0, &transferQueue);
+    }
 
-    VkFenceCreateInfo fenceCI{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
-    fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCI.pNext = nullptr;
-    fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-    VULKAN_CHECK(vkCreateFence(device, &fenceCI, nullptr, &fence), "Failed to create Fence.")
-
-    uint32_t maxSets = 1024;
-    std::vector<VkDescriptorPoolSize> poolSizes{
-        {VK_DESCRIPTOR_TYPE_SAMPLER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 16 * maxSets}};
-
-    VkDescriptorPoolCreateInfo descPoolCI;
-    descPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    descPoolCI.pNext = nullptr;
-    descPoolCI.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-    descPoolCI.maxSets = maxSets;
-    descPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    descPoolCI.pPoolSizes = poolSizes.data();
-    VULKAN_CHECK(vkCreateDescriptorPool(device, &descPoolCI, nullptr, &descriptorPool), "Failed to create DescriptorPool");
+    CreateFrameResources(XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT);
 }
 
 GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId systemId) {
@@ -324,6 +297,11 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId syste
             queueFamilyIndex = static_cast<uint32_t>(i);
             queueIndex = 0;
         }
+        // A family that can only transfer maps to a copy engine that runs alongside the graphics queue.
+        VkQueueFlags queueFlags = queueFamilyProperties[i].queueFlags;
+        if (BitwiseCheck(queueFlags, VkQueueFlags(VK_QUEUE_TRANSFER_BIT)) && !BitwiseCheck(queueFlags, VkQueueFlags(VK_QUEUE_GRAPHICS_BIT)) && !BitwiseCheck(queueFlags, VkQueueFlags(VK_QUEUE_COMPUTE_BIT)) && transferQueueFamilyIndex == 0xFFFFFFFF) {
+            transferQueueFamilyIndex = static_cast<uint32_t>(i);
+        }
     }
 
     uint32_t deviceExtensionCount = 0;
@@ -359,54 +337,29 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId syste
     deviceCI.pEnabledFeatures = &features;
     VULKAN_CHECK(vkCreateDevice(physicalDevice, &deviceCI, nullptr, &device), "Failed to create Device.");
 
-    VkCommandPoolCreateInfo cmdPoolCI;
-    cmdPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    cmdPoolCI.pNext = nullptr;
-    cmdPoolCI.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    cmdPoolCI.queueFamilyIndex = queueFamilyIndex;
-    VULKAN_CHECK(vkCreateCommandPool(device, &cmdPoolCI, nullptr, &cmdPool), "Failed to create CommandPool.");
-
-    VkCommandBufferAllocateInfo allocateInfo;
-    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.pNext = nullptr;
-    allocateInfo.commandPool = cmdPool;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocateInfo.commandBufferCount = 1;
-    VULKAN_CHECK(vkAllocateCommandBuffers(device, &allocateInfo, &cmdBuffer), "Failed to allocate CommandBuffers.");
-
     vkGetDeviceQueue(device, queueFamilyIndex, queueIndex, &queue);
+    if (transferQueueFamilyIndex != 0xFFFFFFFF) {
+        vkGetDeviceQueue(device, transferQueueFamilyIndex, 0, &transferQueue);
+    }
 
-    VkFenceCreateInfo fenceCI{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
-    fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCI.pNext = nullptr;
-    fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-    VULKAN_CHECK(vkCreateFence(device, &fenceCI, nullptr, &fence), "Failed to create Fence.")
-
-    uint32_t maxSets = 1024;
-    std::vector<VkDescriptorPoolSize> poolSizes{
-        {VK_DESCRIPTOR_TYPE_SAMPLER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 16 * maxSets}};
-
-    VkDescriptorPoolCreateInfo descPoolCI;
-    descPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    descPoolCI.pNext = nullptr;
-    descPoolCI.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-    descPoolCI.maxSets = maxSets;
-    descPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    descPoolCI.pPoolSizes = poolSizes.data();
-    VULKAN_CHECK(vkCreateDescriptorPool(device, &descPoolCI, nullptr, &descriptorPool), "Failed to create DescriptorPool");
+    CreateFrameResources(XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT);
 }
 
 GraphicsAPI_Vulkan::~GraphicsAPI_Vulkan() {
-    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    WaitForAllFrames();
 
-    vkDestroyFence(device, fence, nullptr);
+    for (const auto &framebuffer : framebufferCache) {
+        vkDestroyFramebuffer(device, framebuffer.second, nullptr);
+    }
+    framebufferCache.clear();
 
-    vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
-    vkDestroyCommandPool(device, cmdPool, nullptr);
+    DestroyStagingRing(stagingRing);
+    for (StagingRing &ring : retiredStagingRings) {
+        DestroyStagingRing(ring);
+    }
+    retiredStagingRings.clear();
+
+    DestroyFrameResources();
 
     vkDestroyDevice(device, nullptr);
     vkDestroyInstance(instance, nullptr);
@@ -476,12 +429,9 @@ void *GraphicsAPI_Vulkan::CreateDesktopSwapchain(const SwapchainCreateInfo &swap
 
     surfaces[swapchain] = surface;
 
-    VkSemaphoreCreateInfo semaphoreCI;
-    semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    semaphoreCI.pNext = nullptr;
-    semaphoreCI.flags = 0;
-    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &acquireSemaphore), "Failed to create Acquire Semaphore");
-    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &submitSemaphore), "Failed to create Submit Semaphore");
+    for (FrameResources &frame : frames) {
+        CreateFrameSemaphores(frame);
+    }
 
     return (void *)swapchain;
 }
@@ -507,6 +457,9 @@ void *GraphicsAPI_Vulkan::GetDesktopSwapchainImage(void *swapchain, uint32_t ind
 }
 
 void GraphicsAPI_Vulkan::AcquireDesktopSwapchanImage(void *swapchain, uint32_t &index) {
+    // The acquire semaphore belongs to the frame slot that the next BeginRendering() records into, so claim that slot now.
+    BeginFrameSlot();
+    VkSemaphore acquireSemaphore = frames[frameIndex].acquireSemaphore;
     VULKAN_CHECK(vkAcquireNextImageKHR(device, (VkSwapchainKHR)swapchain, UINT64_MAX, acquireSemaphore, VK_NULL_HANDLE, &index), "Failed to acquire next Image from Swapchain.");
 
     currentDesktopSwapchainImage = (VkImage)GetDesktopSwapchainImage(swapchain, index);
@@ -525,7 +478,7 @@ void GraphicsAPI_Vulkan::PresentDesktopSwapchainImage(void *swapchain, uint32_t
     pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
     pi.pNext = nullptr;
     pi.waitSemaphoreCount = 1;
-    pi.pWaitSemaphores = &submitSemaphore;
+    pi.pWaitSemaphores = &frames[frameIndex].submitSemaphore;
     pi.swapchainCount = 1;
     pi.pSwapchains = &vkSwapchain;
     pi.pImageIndices = &index;
@@ -625,6 +578,8 @@ void *GraphicsAPI_Vulkan::CreateImageView(const ImageViewCreateInfo &imageViewCI
 
 void GraphicsAPI_Vulkan::DestroyImageView(void *&imageView) {
     VkImageView vkImageView = (VkImageView)imageView;
+    DestroyCachedFramebuffers(VK_NULL_HANDLE, vkImageView);
+    ClearDescriptorSetCaches();
     vkDestroyImageView(device, vkImageView, nullptr);
     imageViewResources.erase(vkImageView);
     imageView = nullptr;
@@ -661,6 +616,7 @@ void *GraphicsAPI_Vulkan::CreateSampler(const SamplerCreateInfo &samplerCI) {
 
 void GraphicsAPI_Vulkan::DestroySampler(void *&sampler) {
     vkDestroySampler(device, (VkSampler)sampler, nullptr);
+    ClearDescriptorSetCaches();
     sampler = nullptr;
 }
 
@@ -705,6 +661,8 @@ void GraphicsAPI_Vulkan::DestroyBuffer(void *&buffer) {
     vkFreeMemory(device, memory, nullptr);
     vkDestroyBuffer(device, vkBuffer, nullptr);
     bufferResources.erase(vkBuffer);
+    bufferLastUse.erase(vkBuffer);
+    ClearDescriptorSetCaches();
     buffer = nullptr;
 }
 
@@ -1016,7 +974,15 @@ void *GraphicsAPI_Vulkan::CreatePipeline(const PipelineCreateInfo &pipelineCI) {
     GPCI.basePipelineIndex = -1;
 
     VULKAN_CHECK(vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &GPCI, nullptr, &pipeline), "Failed to create Graphics Pipeline.");
-    pipelineResources[pipeline] = {pipelineLayout, descSetLayout, renderPass, pipelineCI};
+
+    std::vector<uint32_t> dynamicBindings;
+    for (const DescriptorInfo &descInfo : pipelineCI.layout) {
+        if (ToVkDescrtiptorType(descInfo) == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+            dynamicBindings.push_back(descInfo.bindingIndex);
+        }
+    }
+    std::sort(dynamicBindings.begin(), dynamicBindings.end());
+    pipelineResources[pipeline] = {pipelineLayout, descSetLayout, renderPass, pipelineCI, dynamicBindings};
 
     return (void *)pipeline;
 }
@@ -1026,29 +992,17 @@ void GraphicsAPI_Vulkan::DestroyPipeline(void *&pipeline) {
     VkPipelineLayout pipelineLayout = std::get<0>(pipelineResources[vkPipeline]);
     VkDescriptorSetLayout descSetLayout = std::get<1>(pipelineResources[vkPipeline]);
     VkRenderPass renderPass = std::get<2>(pipelineResources[vkPipeline]);
+    DestroyCachedFramebuffers(renderPass, VK_NULL_HANDLE);
     vkDestroyRenderPass(device, renderPass, nullptr);
     vkDestroyDescriptorSetLayout(device, descSetLayout, nullptr);
     vkDestroyPipeline(device, vkPipeline, nullptr);
     pipelineResources.erase(vkPipeline);
+    ClearDescriptorSetCaches();
     pipeline = nullptr;
 }
 
 void GraphicsAPI_Vulkan::BeginRendering() {
-    VULKAN_CHECK(vkWaitForFences(device, 1, &fence, true, UINT64_MAX), "Failed to wait for Fence");
-    VULKAN_CHECK(vkResetFences(device, 1, &fence), "Failed to reset Fence.")
-
-    // VULKAN_CHECK(vkResetDescriptorPool(device, descriptorPool, VkDescriptorPoolResetFlags(0)), "Failed to rest DescriptorPool")
-    for (const auto &descSet : cmdBufferDescriptorSets[cmdBuffer]) {
-        VULKAN_CHECK(vkFreeDescriptorSets(device, descriptorPool, 1, &descSet), "Failed to free DescriptorSet.");
-    }
-    cmdBufferDescriptorSets.erase(cmdBuffer);
-
-    for (const VkFramebuffer &framebuffer : cmdBufferFramebuffers[cmdBuffer]) {
-        vkDestroyFramebuffer(device, framebuffer, nullptr);
-    }
-    cmdBufferFramebuffers.erase(cmdBuffer);
-
-    VULKAN_CHECK(vkResetCommandBuffer(cmdBuffer, VkCommandBufferResetFlagBits(0)), "Failed to reset CommandBuffer.");
+    BeginFrameSlot();
 
     VkCommandBufferBeginInfo beginInfo;
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -1102,24 +1056,60 @@ void GraphicsAPI_Vulkan::EndRendering() {
 
     VULKAN_CHECK(vkEndCommandBuffer(cmdBuffer), "Failed to end CommandBuffer.");
 
-    VkPipelineStageFlags waitDstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    FrameResources &frame = frames[frameIndex];
+    VkSemaphore submitSemaphore = frame.submitSemaphore;
+    VkSemaphore waitSemaphores[2];
+    VkPipelineStageFlags waitDstStageMasks[2];
+    uint32_t waitSemaphoreCount = 0;
+    if (frame.acquireSemaphore) {
+        waitSemaphores[waitSemaphoreCount] = frame.acquireSemaphore;
+        waitDstStageMasks[waitSemaphoreCount++] = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+
+    if (frame.transferRecording) {
+        // All uploads of the frame are copied in one transfer submit, which the graphics submit waits for before acquiring the images.
+        VULKAN_CHECK(vkEndCommandBuffer(frame.transferCmdBuffer), "Failed to end Transfer CommandBuffer.");
+
+        VkSubmitInfo transferSubmitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+        transferSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        transferSubmitInfo.pNext = nullptr;
+        transferSubmitInfo.waitSemaphoreCount = 0;
+        transferSubmitInfo.pWaitSemaphores = nullptr;
+        transferSubmitInfo.pWaitDstStageMask = nullptr;
+        transferSubmitInfo.commandBufferCount = 1;
+        transferSubmitInfo.pCommandBuffers = &frame.transferCmdBuffer;
+        transferSubmitInfo.signalSemaphoreCount = 1;
+        transferSubmitInfo.pSignalSemaphores = &frame.transferSemaphore;
+        VULKAN_CHECK(vkQueueSubmit(transferQueue, 1, &transferSubmitInfo, VK_NULL_HANDLE), "Failed to submit to Transfer Queue.");
+        frame.transferRecording = false;
+
+        waitSemaphores[waitSemaphoreCount] = frame.transferSemaphore;
+        waitDstStageMasks[waitSemaphoreCount++] = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
 
     VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.pNext = nullptr;
-    submitInfo.waitSemaphoreCount = acquireSemaphore ? 1 : 0;
-    submitInfo.pWaitSemaphores = acquireSemaphore ? &acquireSemaphore : nullptr;
-    submitInfo.pWaitDstStageMask = acquireSemaphore ? &waitDstStageMask : nullptr;
+    submitInfo.waitSemaphoreCount = waitSemaphoreCount;
+    submitInfo.pWaitSemaphores = waitSemaphoreCount ? waitSemaphores : nullptr;
+    submitInfo.pWaitDstStageMask = waitSemaphoreCount ? waitDstStageMasks : nullptr;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &cmdBuffer;
     submitInfo.signalSemaphoreCount = submitSemaphore ? 1 : 0;
     submitInfo.pSignalSemaphores = submitSemaphore ? &submitSemaphore : nullptr;
 
-    VULKAN_CHECK(vkQueueSubmit(queue, 1, &submitInfo, fence), "Failed to submit to Queue.");
+    VULKAN_CHECK(vkQueueSubmit(queue, 1, &submitInfo, frame.fence), "Failed to submit to Queue.");
+    frameSlotReady = false;
 }
 
 void GraphicsAPI_Vulkan::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
     VkBuffer vkBuffer = (VkBuffer)buffer;
+    // Don't overwrite data that a frame still in flight may be reading.
+    auto lastUse = bufferLastUse.find(vkBuffer);
+    if (lastUse != bufferLastUse.end()) {
+        WaitForFrameSerial(lastUse->second);
+    }
+
     VkDeviceMemory memory = bufferResources[vkBuffer].first;
     void *mappedData = nullptr;
     VULKAN_CHECK(vkMapMemory(device, memory, offset, size, 0, &mappedData), "Can not map Buffer.");
@@ -1149,12 +1139,16 @@ void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b,
 
     VkImage vkImage = (VkImage)(imageViewCI.image);
 
+    // Swapchain images arrive as color attachments, but images created by CreateImage() start out undefined.
+    auto imageState = imageStates.find(vkImage);
+    VkImageLayout oldLayout = imageState != imageStates.end() ? imageState->second : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
     VkImageMemoryBarrier imageBarrier;
     imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     imageBarrier.pNext = nullptr;
     imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
     imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    imageBarrier.oldLayout = oldLayout;
     imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -1173,6 +1167,7 @@ void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b,
     imageBarrier.image = vkImage;
     imageBarrier.subresourceRange = range;
     vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VkDependencyFlagBits(0), 0, nullptr, 0, nullptr, 1, &imageBarrier);
+    imageStates[vkImage] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 }
 
 void GraphicsAPI_Vulkan::ClearDepth(void *imageView, float d) {
@@ -1225,76 +1220,14 @@ void GraphicsAPI_Vulkan::UploadRgbaToImage(void *imageView, uint32_t width, uint
     const ImageViewCreateInfo &imageViewCI = imageViewResources[(VkImageView)imageView];
     VkImage vkImage = (VkImage)(imageViewCI.image);
 
-    VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
-
-    VkBufferCreateInfo bufferCI{};
-    bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferCI.pNext = nullptr;
-    bufferCI.flags = 0;
-    bufferCI.size = size;
-    bufferCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    VULKAN_CHECK(vkCreateBuffer(device, &bufferCI, nullptr, &stagingBuffer), "Failed to create staging buffer.");
-
-    VkMemoryRequirements memoryRequirements{};
-    vkGetBufferMemoryRequirements(device, stagingBuffer, &memoryRequirements);
-
-    VkPhysicalDeviceMemoryProperties memoryProperties{};
-    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
-
-    uint32_t memoryTypeIndex = 0;
-    if (!MemoryTypeFromProperties(memoryProperties, memoryRequirements.memoryTypeBits,
-                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                  &memoryTypeIndex)) {
-        std::cout << "ERROR: VULKAN: Failed to find staging memory type." << std::endl;
-        vkDestroyBuffer(device, stagingBuffer, nullptr);
+    StagingAllocation staging = AllocateStaging(size);
+    if (!staging.buffer) {
         return;
     }
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.pNext = nullptr;
-    allocInfo.allocationSize = memoryRequirements.size;
-    allocInfo.memoryTypeIndex = memoryTypeIndex;
-    VULKAN_CHECK(vkAllocateMemory(device, &allocInfo, nullptr, &stagingMemory), "Failed to allocate staging memory.");
-    VULKAN_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingMemory, 0), "Failed to bind staging memory.");
-
-    void *mappedData = nullptr;
-    VULKAN_CHECK(vkMapMemory(device, stagingMemory, 0, size, 0, &mappedData), "Failed to map staging memory.");
-    if (mappedData) {
-        memcpy(mappedData, data, size);
-    }
-    vkUnmapMemory(device, stagingMemory);
-
-    BeginRendering();
-
-    VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    auto imageStateIt = imageStates.find(vkImage);
-    if (imageStateIt != imageStates.end()) {
-        oldLayout = imageStateIt->second;
-    }
-
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.pNext = nullptr;
-    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = vkImage;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VkDependencyFlagBits(0),
-                         0, nullptr, 0, nullptr, 1, &barrier);
+    memcpy(staging.mappedData, data, size);
 
     VkBufferImageCopy region{};
-    region.bufferOffset = 0;
+    region.bufferOffset = staging.offset;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
     region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -1304,22 +1237,7 @@ void GraphicsAPI_Vulkan::UploadRgbaToImage(void *imageView, uint32_t width, uint
     region.imageOffset = {0, 0, 0};
     region.imageExtent = {width, height, 1};
 
-    vkCmdCopyBufferToImage(cmdBuffer, stagingBuffer, vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VkDependencyFlagBits(0),
-                         0, nullptr, 0, nullptr, 1, &barrier);
-    imageStates[vkImage] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-    EndRendering();
-
-    VULKAN_CHECK(vkWaitForFences(device, 1, &fence, true, UINT64_MAX), "Failed to wait for Fence after upload.");
-
-    vkDestroyBuffer(device, stagingBuffer, nullptr);
-    vkFreeMemory(device, stagingMemory, nullptr);
+    RecordRgbaUpload(vkImage, staging.buffer, region, false);
 }
 
 void GraphicsAPI_Vulkan::UploadRgbaToImageCentered(void *imageView,
@@ -1346,125 +1264,120 @@ void GraphicsAPI_Vulkan::UploadRgbaToImageCentered(void *imageView,
     size_t copyRowBytes = static_cast<size_t>(copyWidth) * 4;
     size_t stagingSize = static_cast<size_t>(copyWidth) * copyHeight * 4;
 
-    // Create staging buffer
-    VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
-
-    VkBufferCreateInfo bufferCI{};
-    bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferCI.pNext = nullptr;
-    bufferCI.flags = 0;
-    bufferCI.size = stagingSize;
-    bufferCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    VULKAN_CHECK(vkCreateBuffer(device, &bufferCI, nullptr, &stagingBuffer), "Failed to create staging buffer.");
-
-    VkMemoryRequirements memoryRequirements{};
-    vkGetBufferMemoryRequirements(device, stagingBuffer, &memoryRequirements);
-
-    VkPhysicalDeviceMemoryProperties memoryProperties{};
-    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
-
-    uint32_t memoryTypeIndex = 0;
-    if (!MemoryTypeFromProperties(memoryProperties, memoryRequirements.memoryTypeBits,
-                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                  &memoryTypeIndex)) {
-        std::cout << "ERROR: VULKAN: Failed to find staging memory type." << std::endl;
-        vkDestroyBuffer(device, stagingBuffer, nullptr);
+    // Copy source data to the staging ring (handle potential source stride mismatch)
+    StagingAllocation staging = AllocateStaging(stagingSize);
+    if (!staging.buffer) {
         return;
     }
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.pNext = nullptr;
-    allocInfo.allocationSize = memoryRequirements.size;
-    allocInfo.memoryTypeIndex = memoryTypeIndex;
-    VULKAN_CHECK(vkAllocateMemory(device, &allocInfo, nullptr, &stagingMemory), "Failed to allocate staging memory.");
-    VULKAN_CHECK(vkBindBufferMemory(device, stagingBuffer, stagingMemory, 0), "Failed to bind staging memory.");
-
-    // Copy source data to staging buffer (handle potential source stride mismatch)
-    void *mappedData = nullptr;
-    VULKAN_CHECK(vkMapMemory(device, stagingMemory, 0, stagingSize, 0, &mappedData), "Failed to map staging memory.");
-    if (mappedData) {
-        if (copyWidth == srcWidth) {
-            // Source width matches copy width - straight copy
-            memcpy(mappedData, srcData, stagingSize);
-        } else {
-            // Need to copy row by row (when source is wider than destination)
-            uint8_t *dst = static_cast<uint8_t *>(mappedData);
-            for (uint32_t y = 0; y < copyHeight; ++y) {
-                memcpy(dst + y * copyRowBytes, srcData + y * srcRowBytes, copyRowBytes);
-            }
+    uint8_t *dst = staging.mappedData;
+    if (copyWidth == srcWidth) {
+        // Source width matches copy width - straight copy
+        memcpy(dst, srcData, stagingSize);
+    } else {
+        // Need to copy row by row (when source is wider than destination)
+        for (uint32_t y = 0; y < copyHeight; ++y) {
+            memcpy(dst + y * copyRowBytes, srcData + y * srcRowBytes, copyRowBytes);
         }
     }
-    vkUnmapMemory(device, stagingMemory);
 
-    BeginRendering();
+    // Copy camera frame to centered region
+    VkBufferImageCopy region{};
+    region.bufferOffset = staging.offset;
+    region.bufferRowLength = copyWidth;  // Tightly packed in staging buffer
+    region.bufferImageHeight = copyHeight;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {offsetX, offsetY, 0};
+    region.imageExtent = {copyWidth, copyHeight, 1};
 
-    VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    auto imageStateIt = imageStates.find(vkImage);
-    if (imageStateIt != imageStates.end()) {
-        oldLayout = imageStateIt->second;
-    }
+    // Clear entire image to black first when the frame doesn't cover it (letterboxing/pillarboxing)
+    bool clear = copyWidth != dstWidth || copyHeight != dstHeight;
+    RecordRgbaUpload(vkImage, staging.buffer, region, clear);
+}
 
-    // Transition to transfer destination
+void GraphicsAPI_Vulkan::RecordRgbaUpload(VkImage image, VkBuffer stagingBuffer, const VkBufferImageCopy &region, bool clear) {
     VkImageMemoryBarrier barrier{};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     barrier.pNext = nullptr;
-    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = vkImage;
+    barrier.image = image;
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     barrier.subresourceRange.baseMipLevel = 0;
     barrier.subresourceRange.levelCount = 1;
     barrier.subresourceRange.baseArrayLayer = 0;
     barrier.subresourceRange.layerCount = 1;
-    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VkDependencyFlagBits(0),
-                         0, nullptr, 0, nullptr, 1, &barrier);
-
-    // Clear entire image to black (for letterboxing/pillarboxing)
-    VkClearColorValue clearColor = {{0.0f, 0.0f, 0.0f, 1.0f}};
-    VkImageSubresourceRange clearRange{};
-    clearRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    clearRange.baseMipLevel = 0;
-    clearRange.levelCount = 1;
-    clearRange.baseArrayLayer = 0;
-    clearRange.layerCount = 1;
-    vkCmdClearColorImage(cmdBuffer, vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &clearRange);
 
-    // Copy camera frame to centered region
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = copyWidth;  // Tightly packed in staging buffer
-    region.bufferImageHeight = copyHeight;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {offsetX, offsetY, 0};
-    region.imageExtent = {copyWidth, copyHeight, 1};
+    if (transferQueue && !clear) {
+        // The copy overwrites the whole image, so its previous contents don't have to be handed over to the transfer queue family.
+        FrameResources &frame = frames[frameIndex];
+        if (!frame.transferRecording) {
+            VkCommandBufferBeginInfo beginInfo;
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext = nullptr;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo = nullptr;
+            VULKAN_CHECK(vkBeginCommandBuffer(frame.transferCmdBuffer, &beginInfo), "Failed to begin Transfer CommandBuffer.");
+            frame.transferRecording = true;
+        }
 
-    vkCmdCopyBufferToImage(cmdBuffer, stagingBuffer, vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        barrier.srcAccessMask = VkAccessFlagBits(0);
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        vkCmdPipelineBarrier(frame.transferCmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VkDependencyFlagBits(0),
+                             0, nullptr, 0, nullptr, 1, &barrier);
 
-    // Transition back to color attachment
-    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VkDependencyFlagBits(0),
-                         0, nullptr, 0, nullptr, 1, &barrier);
-    imageStates[vkImage] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        vkCmdCopyBufferToImage(frame.transferCmdBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
-    EndRendering();
+        // Release the image to the graphics queue family, which acquires it with the same barrier once the transfer submit has signalled.
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VkAccessFlagBits(0);
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        barrier.srcQueueFamilyIndex = transferQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex = queueFamilyIndex;
+        vkCmdPipelineBarrier(frame.transferCmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, VkDependencyFlagBits(0),
+                             0, nullptr, 0, nullptr, 1, &barrier);
 
-    VULKAN_CHECK(vkWaitForFences(device, 1, &fence, true, UINT64_MAX), "Failed to wait for Fence after upload.");
+        barrier.srcAccessMask = VkAccessFlagBits(0);
+        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VkDependencyFlagBits(0),
+                             0, nullptr, 0, nullptr, 1, &barrier);
+    } else {
+        VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        auto imageStateIt = imageStates.find(image);
+        if (imageStateIt != imageStates.end()) {
+            oldLayout = imageStateIt->second;
+        }
 
-    vkDestroyBuffer(device, stagingBuffer, nullptr);
-    vkFreeMemory(device, stagingMemory, nullptr);
+        // Transition to transfer destination
+        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, VkDependencyFlagBits(0),
+                             0, nullptr, 0, nullptr, 1, &barrier);
+
+        // Clearing needs the graphics queue, which is why letterboxed uploads don't use the transfer queue.
+        if (clear) {
+            VkClearColorValue clearColor = {{0.0f, 0.0f, 0.0f, 1.0f}};
+            vkCmdClearColorImage(cmdBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &barrier.subresourceRange);
+        }
+
+        vkCmdCopyBufferToImage(cmdBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        // Transition back to color attachment
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VkDependencyFlagBits(0),
+                             0, nullptr, 0, nullptr, 1, &barrier);
+    }
+    imageStates[image] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 }
 
 void GraphicsAPI_Vulkan::SetRenderAttachments(void **colorViews, size_t colorViewCount, void *depthStencilView, uint32_t width, uint32_t height, void *pipeline) {
@@ -1474,27 +1387,37 @@ void GraphicsAPI_Vulkan::SetRenderAttachments(void **colorViews, size_t colorVie
 
     VkRenderPass renderPass = std::get<2>(pipelineResources[(VkPipeline)pipeline]);
 
-    std::vector<VkImageView> vkImageViews;
+    FramebufferKey key;
+    key.renderPass = renderPass;
+    if (colorViewCount + (depthStencilView ? 1 : 0) > maxFramebufferAttachments) {
+        std::cout << "ERROR: VULKAN: Too many attachments for a framebuffer: " << colorViewCount << " color views." << std::endl;
+        DEBUG_BREAK;
+        return;
+    }
     for (size_t i = 0; i < colorViewCount; i++) {
-        vkImageViews.push_back((VkImageView)colorViews[i]);
+        key.attachments[key.attachmentCount++] = (VkImageView)colorViews[i];
     }
     if (depthStencilView) {
-        vkImageViews.push_back((VkImageView)depthStencilView);
-    }
-
-    VkFramebuffer framebuffer{};
-    VkFramebufferCreateInfo framebufferCI;
-    framebufferCI.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    framebufferCI.pNext = nullptr;
-    framebufferCI.flags = 0;
-    framebufferCI.renderPass = renderPass;
-    framebufferCI.attachmentCount = static_cast<uint32_t>(vkImageViews.size());
-    framebufferCI.pAttachments = vkImageViews.data();
-    framebufferCI.width = width;
-    framebufferCI.height = height;
-    framebufferCI.layers = 1;
-    VULKAN_CHECK(vkCreateFramebuffer(device, &framebufferCI, nullptr, &framebuffer), "Failed to create Framebuffer");
-    cmdBufferFramebuffers[cmdBuffer].push_back(framebuffer);
+        key.attachments[key.attachmentCount++] = (VkImageView)depthStencilView;
+    }
+    key.width = width;
+    key.height = height;
+
+    // Framebuffers live as long as their render pass and attachments, so each OpenXR swapchain image re-uses the framebuffer created the first time it was rendered to.
+    VkFramebuffer &framebuffer = framebufferCache[key];
+    if (framebuffer == VK_NULL_HANDLE) {
+        VkFramebufferCreateInfo framebufferCI;
+        framebufferCI.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferCI.pNext = nullptr;
+        framebufferCI.flags = 0;
+        framebufferCI.renderPass = renderPass;
+        framebufferCI.attachmentCount = key.attachmentCount;
+        framebufferCI.pAttachments = key.attachments.data();
+        framebufferCI.width = width;
+        framebufferCI.height = height;
+        framebufferCI.layers = 1;
+        VULKAN_CHECK(vkCreateFramebuffer(device, &framebufferCI, nullptr, &framebuffer), "Failed to create Framebuffer");
+    }
 
     VkRenderPassBeginInfo renderPassBegin;
     renderPassBegin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -1502,8 +1425,8 @@ void GraphicsAPI_Vulkan::SetRenderAttachments(void **colorViews, size_t colorVie
     renderPassBegin.renderPass = renderPass;
     renderPassBegin.framebuffer = framebuffer;
     renderPassBegin.renderArea.offset = {0, 0};
-    renderPassBegin.renderArea.extent.width = framebufferCI.width;
-    renderPassBegin.renderArea.extent.height = framebufferCI.height;
+    renderPassBegin.renderArea.extent.width = width;
+    renderPassBegin.renderArea.extent.height = height;
     renderPassBegin.clearValueCount = 0;
     renderPassBegin.pClearValues = nullptr;
     vkCmdBeginRenderPass(cmdBuffer, &renderPassBegin, VK_SUBPASS_CONTENTS_INLINE);
@@ -1547,15 +1470,21 @@ void GraphicsAPI_Vulkan::SetDescriptor(const DescriptorInfo &descriptorInfo) {
     writeDescSet.pImageInfo = nullptr;
     writeDescSet.pBufferInfo = nullptr;
     writeDescSet.pTexelBufferView = nullptr;
-    writeDescSets.push_back({writeDescSet, {}, {}});
+    writeDescSets.push_back({writeDescSet, {}, {}, 0});
 
     if (descriptorInfo.type == DescriptorInfo::Type::BUFFER) {
         VkDescriptorBufferInfo &descBufferInfo = std::get<1>(writeDescSets.back());
         VkBuffer buffer = (VkBuffer)descriptorInfo.resource;
         const BufferCreateInfo &bufferCI = bufferResources[buffer].second;
+        bufferLastUse[buffer] = frames[frameIndex].serial;
         descBufferInfo.buffer = buffer;
         descBufferInfo.offset = descriptorInfo.bufferOffset;
         descBufferInfo.range = descriptorInfo.bufferSize;
+        if (writeDescSet.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+            // The offset is applied when binding, so it's not part of the descriptor set.
+            std::get<3>(writeDescSets.back()) = static_cast<uint32_t>(descriptorInfo.bufferOffset);
+            descBufferInfo.offset = 0;
+        }
     } else if (descriptorInfo.type == DescriptorInfo::Type::IMAGE) {
         VkDescriptorImageInfo &descImageInfo = std::get<2>(writeDescSets.back());
         VkImageView imageView = (VkImageView)descriptorInfo.resource;
@@ -1575,41 +1504,78 @@ void GraphicsAPI_Vulkan::SetDescriptor(const DescriptorInfo &descriptorInfo) {
     }
 }
 
-void GraphicsAPI_Vulkan::UpdateDescriptors() {
-    VkPipelineLayout pipelineLayout = std::get<0>(pipelineResources[(VkPipeline)setPipeline]);
-    VkDescriptorSetLayout descSetLayout = std::get<1>(pipelineResources[(VkPipeline)setPipeline]);
-    PipelineCreateInfo pipelinCI = std::get<3>(pipelineResources[(VkPipeline)setPipeline]);
-
-    VkDescriptorSet descSet{};
-    VkDescriptorSetAllocateInfo descSetAI;
-    descSetAI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    descSetAI.pNext = nullptr;
-    descSetAI.descriptorPool = descriptorPool;
-    descSetAI.descriptorSetCount = 1;
-    descSetAI.pSetLayouts = &descSetLayout;
-    VULKAN_CHECK(vkAllocateDescriptorSets(device, &descSetAI, &descSet), "Failed to allocate DescriptorSet.");
-
-    std::vector<VkWriteDescriptorSet> vkWriteDescSets;
-    for (auto &writeDescSet : writeDescSets) {
-        VkWriteDescriptorSet &vkWriteDescSet = std::get<0>(writeDescSet);
-        VkDescriptorBufferInfo &vkDescBufferInfo = std::get<1>(writeDescSet);
-        VkDescriptorImageInfo &vkDescImageInfo = std::get<2>(writeDescSet);
-
-        vkWriteDescSet.dstSet = descSet;
+void GraphicsAPI_Vulkan::BuildDescriptorSetKey(VkDescriptorSetLayout descSetLayout, const std::vector<uint32_t> &dynamicBindings, std::vector<PendingDescriptorWrite> &writes, std::vector<uint64_t> &key, std::vector<uint32_t> &dynamicOffsets) {
+    std::sort(writes.begin(), writes.end(), [](const auto &a, const auto &b) { return std::get<0>(a).dstBinding < std::get<0>(b).dstBinding; });
+
+    key.clear();
+    key.push_back((uint64_t)descSetLayout);
+    for (const PendingDescriptorWrite &writeDescSet : writes) {
+        const VkWriteDescriptorSet &vkWriteDescSet = std::get<0>(writeDescSet);
+        const VkDescriptorBufferInfo &vkDescBufferInfo = std::get<1>(writeDescSet);
+        const VkDescriptorImageInfo &vkDescImageInfo = std::get<2>(writeDescSet);
+        key.push_back(((uint64_t)vkWriteDescSet.dstBinding << 32) | (uint64_t)vkWriteDescSet.descriptorType);
         if (vkDescBufferInfo.buffer) {
-            vkWriteDescSet.pBufferInfo = &vkDescBufferInfo;
-        } else if (vkDescImageInfo.imageView || vkDescImageInfo.sampler) {
-            vkWriteDescSet.pImageInfo = &vkDescImageInfo;
+            key.push_back((uint64_t)vkDescBufferInfo.buffer);
+            key.push_back((uint64_t)vkDescBufferInfo.offset);
+            key.push_back((uint64_t)vkDescBufferInfo.range);
         } else {
-            continue;
+            key.push_back((uint64_t)vkDescImageInfo.imageView);
+            key.push_back((uint64_t)vkDescImageInfo.sampler);
+            key.push_back((uint64_t)vkDescImageInfo.imageLayout);
+        }
+    }
+
+    // vkCmdBindDescriptorSets takes one offset for every dynamic descriptor in the set layout, in binding order, including any this draw didn't write.
+    dynamicOffsets.clear();
+    size_t w = 0;
+    for (uint32_t binding : dynamicBindings) {
+        while (w < writes.size() && std::get<0>(writes[w]).dstBinding < binding) {
+            w++;
+        }
+        const bool written = w < writes.size() && std::get<0>(writes[w]).dstBinding == binding && std::get<0>(writes[w]).descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        dynamicOffsets.push_back(written ? std::get<3>(writes[w]) : 0);
+    }
+}
+
+void GraphicsAPI_Vulkan::UpdateDescriptors() {
+    const auto &resources = pipelineResources[(VkPipeline)setPipeline];
+    VkPipelineLayout pipelineLayout = std::get<0>(resources);
+    VkDescriptorSetLayout descSetLayout = std::get<1>(resources);
+    BuildDescriptorSetKey(descSetLayout, std::get<4>(resources), writeDescSets, descSetKey, dynamicOffsets);
+
+    // Draws that bind the same resources share one descriptor set for the rest of the frame.
+    FrameResources &frame = frames[frameIndex];
+    VkDescriptorSet &descSet = frame.descriptorSetCache[descSetKey];
+    if (descSet == VK_NULL_HANDLE) {
+        VkDescriptorSetAllocateInfo descSetAI;
+        descSetAI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        descSetAI.pNext = nullptr;
+        descSetAI.descriptorPool = frame.descriptorPool;
+        descSetAI.descriptorSetCount = 1;
+        descSetAI.pSetLayouts = &descSetLayout;
+        VULKAN_CHECK(vkAllocateDescriptorSets(device, &descSetAI, &descSet), "Failed to allocate DescriptorSet.");
+
+        std::vector<VkWriteDescriptorSet> vkWriteDescSets;
+        for (auto &writeDescSet : writeDescSets) {
+            VkWriteDescriptorSet &vkWriteDescSet = std::get<0>(writeDescSet);
+            VkDescriptorBufferInfo &vkDescBufferInfo = std::get<1>(writeDescSet);
+            VkDescriptorImageInfo &vkDescImageInfo = std::get<2>(writeDescSet);
+
+            vkWriteDescSet.dstSet = descSet;
+            if (vkDescBufferInfo.buffer) {
+                vkWriteDescSet.pBufferInfo = &vkDescBufferInfo;
+            } else if (vkDescImageInfo.imageView || vkDescImageInfo.sampler) {
+                vkWriteDescSet.pImageInfo = &vkDescImageInfo;
+            } else {
+                continue;
+            }
+            vkWriteDescSets.push_back(vkWriteDescSet);
         }
-        vkWriteDescSets.push_back(vkWriteDescSet);
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(vkWriteDescSets.size()), vkWriteDescSets.data(), 0, nullptr);
     }
-    vkUpdateDescriptorSets(device, static_cast<uint32_t>(vkWriteDescSets.size()), vkWriteDescSets.data(), 0, nullptr);
     writeDescSets.clear();
 
-    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descSet, 0, nullptr);
-    cmdBufferDescriptorSets[cmdBuffer].push_back({descSet});
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descSet, static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 }
 
 void GraphicsAPI_Vulkan::SetVertexBuffers(void **vertexBuffers, size_t count) {
@@ -1618,6 +1584,7 @@ void GraphicsAPI_Vulkan::SetVertexBuffers(void **vertexBuffers, size_t count) {
     for (size_t i = 0; i < count; i++) {
         vkBuffers.push_back((VkBuffer)vertexBuffers[i]);
         offsets.push_back(0);
+        bufferLastUse[vkBuffers.back()] = frames[frameIndex].serial;
     }
 
     vkCmdBindVertexBuffers(cmdBuffer, 0, static_cast<uint32_t>(vkBuffers.size()), vkBuffers.data(), offsets.data());
@@ -1626,6 +1593,7 @@ void GraphicsAPI_Vulkan::SetVertexBuffers(void **vertexBuffers, size_t count) {
 void GraphicsAPI_Vulkan::SetIndexBuffer(void *indexBuffer) {
     const BufferCreateInfo &bufferCI = bufferResources[(VkBuffer)indexBuffer].second;
     VkIndexType type = bufferCI.stride == 4 ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+    bufferLastUse[(VkBuffer)indexBuffer] = frames[frameIndex].serial;
     vkCmdBindIndexBuffer(cmdBuffer, (VkBuffer)indexBuffer, 0, type);
 }
 
@@ -1637,6 +1605,357 @@ void GraphicsAPI_Vulkan::Draw(uint32_t vertexCount, uint32_t instanceCount, uint
     vkCmdDraw(cmdBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
+void GraphicsAPI_Vulkan::SetFramesInFlight(uint32_t count) {
+    WaitForAllFrames();
+    DestroyFrameResources();
+    CreateFrameResources(count);
+}
+
+void GraphicsAPI_Vulkan::CreateFrameResources(uint32_t count) {
+    uint32_t maxSets = 1024;
+    std::vector<VkDescriptorPoolSize> poolSizes{
+        {VK_DESCRIPTOR_TYPE_SAMPLER, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 16 * maxSets}};
+
+    frames.resize(count > 0 ? count : 1);
+    for (FrameResources &frame : frames) {
+        // Everything recorded into a frame slot is released at once when the slot is re-used, so the pools are reset as a whole.
+        VkCommandPoolCreateInfo cmdPoolCI;
+        cmdPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        cmdPoolCI.pNext = nullptr;
+        cmdPoolCI.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        cmdPoolCI.queueFamilyIndex = queueFamilyIndex;
+        VULKAN_CHECK(vkCreateCommandPool(device, &cmdPoolCI, nullptr, &frame.cmdPool), "Failed to create CommandPool.");
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = frame.cmdPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = 1;
+        VULKAN_CHECK(vkAllocateCommandBuffers(device, &allocateInfo, &frame.cmdBuffer), "Failed to allocate CommandBuffers.");
+
+        VkFenceCreateInfo fenceCI{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCI.pNext = nullptr;
+        fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        VULKAN_CHECK(vkCreateFence(device, &fenceCI, nullptr, &frame.fence), "Failed to create Fence.")
+
+        VkDescriptorPoolCreateInfo descPoolCI;
+        descPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        descPoolCI.pNext = nullptr;
+        descPoolCI.flags = 0;
+        descPoolCI.maxSets = maxSets;
+        descPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        descPoolCI.pPoolSizes = poolSizes.data();
+        VULKAN_CHECK(vkCreateDescriptorPool(device, &descPoolCI, nullptr, &frame.descriptorPool), "Failed to create DescriptorPool");
+
+        if (transferQueue) {
+            cmdPoolCI.queueFamilyIndex = transferQueueFamilyIndex;
+            VULKAN_CHECK(vkCreateCommandPool(device, &cmdPoolCI, nullptr, &frame.transferCmdPool), "Failed to create Transfer CommandPool.");
+
+            allocateInfo.commandPool = frame.transferCmdPool;
+            VULKAN_CHECK(vkAllocateCommandBuffers(device, &allocateInfo, &frame.transferCmdBuffer), "Failed to allocate Transfer CommandBuffers.");
+
+            VkSemaphoreCreateInfo semaphoreCI;
+            semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            semaphoreCI.pNext = nullptr;
+            semaphoreCI.flags = 0;
+            VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &frame.transferSemaphore), "Failed to create Transfer Semaphore");
+        }
+        frame.transferRecording = false;
+
+        if (!surfaces.empty()) {
+            CreateFrameSemaphores(frame);
+        }
+        frame.serial = 0;
+    }
+
+    frameIndex = static_cast<uint32_t>(frames.size()) - 1;
+    frameSlotReady = false;
+    cmdBuffer = VK_NULL_HANDLE;
+}
+
+void GraphicsAPI_Vulkan::CreateFrameSemaphores(FrameResources &frame) {
+    if (frame.acquireSemaphore) {
+        return;
+    }
+    VkSemaphoreCreateInfo semaphoreCI;
+    semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCI.pNext = nullptr;
+    semaphoreCI.flags = 0;
+    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &frame.acquireSemaphore), "Failed to create Acquire Semaphore");
+    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &frame.submitSemaphore), "Failed to create Submit Semaphore");
+}
+
+void GraphicsAPI_Vulkan::DestroyFrameResources() {
+    for (FrameResources &frame : frames) {
+        vkDestroyDescriptorPool(device, frame.descriptorPool, nullptr);
+        vkDestroyFence(device, frame.fence, nullptr);
+        vkFreeCommandBuffers(device, frame.cmdPool, 1, &frame.cmdBuffer);
+        vkDestroyCommandPool(device, frame.cmdPool, nullptr);
+        if (frame.acquireSemaphore) {
+            vkDestroySemaphore(device, frame.acquireSemaphore, nullptr);
+            vkDestroySemaphore(device, frame.submitSemaphore, nullptr);
+        }
+        if (frame.transferCmdPool) {
+            vkDestroySemaphore(device, frame.transferSemaphore, nullptr);
+            vkFreeCommandBuffers(device, frame.transferCmdPool, 1, &frame.transferCmdBuffer);
+            vkDestroyCommandPool(device, frame.transferCmdPool, nullptr);
+        }
+    }
+    frames.clear();
+    cmdBuffer = VK_NULL_HANDLE;
+}
+
+void GraphicsAPI_Vulkan::BeginFrameSlot() {
+    if (frameSlotReady) {
+        return;
+    }
+
+    // Only the oldest frame in flight has to finish before its slot is recorded into again; the others keep running on the GPU.
+    frameIndex = (frameIndex + 1) % static_cast<uint32_t>(frames.size());
+    FrameResources &frame = frames[frameIndex];
+    VULKAN_CHECK(vkWaitForFences(device, 1, &frame.fence, true, UINT64_MAX), "Failed to wait for Fence");
+    VULKAN_CHECK(vkResetFences(device, 1, &frame.fence), "Failed to reset Fence.")
+    completedFrameSerial = std::max(completedFrameSerial, frame.serial);
+
+    VULKAN_CHECK(vkResetDescriptorPool(device, frame.descriptorPool, VkDescriptorPoolResetFlags(0)), "Failed to reset DescriptorPool.");
+    frame.descriptorSetCache.clear();
+    VULKAN_CHECK(vkResetCommandPool(device, frame.cmdPool, VkCommandPoolResetFlags(0)), "Failed to reset CommandPool.");
+    if (frame.transferCmdPool) {
+        // The graphics submit waited for the transfer submit, so the fence covers both.
+        VULKAN_CHECK(vkResetCommandPool(device, frame.transferCmdPool, VkCommandPoolResetFlags(0)), "Failed to reset Transfer CommandPool.");
+    }
+
+    // Staging rings replaced by a larger one are kept until the last frame copying from them has finished.
+    for (auto it = retiredStagingRings.begin(); it != retiredStagingRings.end();) {
+        if (it->retiredSerial <= completedFrameSerial) {
+            DestroyStagingRing(*it);
+            it = retiredStagingRings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    frame.serial = ++frameSerial;
+    cmdBuffer = frame.cmdBuffer;
+    frameSlotReady = true;
+}
+
+void GraphicsAPI_Vulkan::WaitForFrameSerial(uint64_t serial) {
+    if (serial <= completedFrameSerial) {
+        return;
+    }
+    for (uint32_t i = 0; i < static_cast<uint32_t>(frames.size()); i++) {
+        FrameResources &frame = frames[i];
+        if (frame.serial != serial) {
+            continue;
+        }
+        if (frameSlotReady && i == frameIndex) {
+            // Still being recorded, so nothing has been submitted yet.
+            return;
+        }
+        VULKAN_CHECK(vkWaitForFences(device, 1, &frame.fence, true, UINT64_MAX), "Failed to wait for Fence");
+        // The queue executes frames in submission order, so every earlier frame has completed too.
+        completedFrameSerial = serial;
+        return;
+    }
+}
+
+void GraphicsAPI_Vulkan::WaitForAllFrames() {
+    VULKAN_CHECK(vkQueueWaitIdle(queue), "Failed to wait for Queue.");
+    completedFrameSerial = frameSlotReady ? frameSerial - 1 : frameSerial;
+}
+
+void GraphicsAPI_Vulkan::ClearDescriptorSetCaches() {
+    // The sets stay allocated until their pool is reset, but a new resource might re-use the destroyed one's handle.
+    for (FrameResources &frame : frames) {
+        frame.descriptorSetCache.clear();
+    }
+}
+
+void GraphicsAPI_Vulkan::DestroyCachedFramebuffers(VkRenderPass renderPass, VkImageView imageView) {
+    bool waited = false;
+    for (auto it = framebufferCache.begin(); it != framebufferCache.end();) {
+        const FramebufferKey &key = it->first;
+        const auto attachmentsEnd = key.attachments.begin() + key.attachmentCount;
+        if (key.renderPass != renderPass && std::find(key.attachments.begin(), attachmentsEnd, imageView) == attachmentsEnd) {
+            ++it;
+            continue;
+        }
+        if (!waited) {
+            WaitForAllFrames();
+            waited = true;
+        }
+        vkDestroyFramebuffer(device, it->second, nullptr);
+        it = framebufferCache.erase(it);
+    }
+}
+
+GraphicsAPI_Vulkan::StagingAllocation GraphicsAPI_Vulkan::AllocateStaging(VkDeviceSize size) {
+    const uint64_t serial = frames[frameIndex].serial;
+    if (stagingAlignment == 0) {
+        VkPhysicalDeviceProperties physicalDeviceProperties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+        stagingAlignment = std::max<VkDeviceSize>(physicalDeviceProperties.limits.optimalBufferCopyOffsetAlignment, 4);
+    }
+    size = Align<VkDeviceSize>(size, stagingAlignment);
+
+    // Gives the upload a buffer of its own, which is destroyed once the frame being recorded has finished.
+    auto allocateOneOff = [&]() -> StagingAllocation {
+        StagingRing oneOff;
+        if (!CreateStagingBuffer(size, oneOff)) {
+            return {};
+        }
+        oneOff.retiredSerial = serial;
+        StagingAllocation allocation = {oneOff.buffer, 0, oneOff.mappedData};
+        retiredStagingRings.push_back(std::move(oneOff));
+        return allocation;
+    };
+
+    // Room for every frame in flight plus the one being recorded, so streaming uploads of this size never have to wait.
+    const VkDeviceSize streamingRingSize = size * (frames.size() + 1);
+    if (streamingRingSize > maxStagingRingSize) {
+        return allocateOneOff();
+    }
+    if (!stagingRing.buffer || size > stagingRing.size / (frames.size() + 1)) {
+        if (!ReplaceStagingRing(std::max(streamingRingSize, stagingRing.size))) {
+            return {};
+        }
+    }
+
+    // Frees the oldest region, waiting for its frame if needed. Regions of the frame being recorded can't be freed yet.
+    auto freeOldestRegion = [&]() -> bool {
+        const StagingRegion &oldest = stagingRing.regions.front();
+        if (oldest.serial == serial) {
+            return false;
+        }
+        WaitForFrameSerial(oldest.serial);
+        stagingRing.regions.pop_front();
+        return true;
+    };
+
+    bool fits = true;
+    VkDeviceSize offset = stagingRing.head;
+    if (offset + size > stagingRing.size) {
+        // Not enough room before the end of the ring, so start again from the beginning once the regions up to the end are free.
+        while (fits && !stagingRing.regions.empty() && stagingRing.regions.front().begin >= offset) {
+            fits = freeOldestRegion();
+        }
+        offset = 0;
+    }
+    while (fits && !stagingRing.regions.empty() && stagingRing.regions.front().begin < offset + size && stagingRing.regions.front().end > offset) {
+        fits = freeOldestRegion();
+    }
+    if (!fits) {
+        // The frame being recorded already fills the ring, so double it up to maxStagingRingSize. Once the ring is at its
+        // limit, the frame's further uploads each get a one-off buffer instead.
+        const VkDeviceSize grownSize = std::min(stagingRing.size * 2, maxStagingRingSize);
+        if (grownSize <= stagingRing.size) {
+            return allocateOneOff();
+        }
+        if (!ReplaceStagingRing(grownSize)) {
+            return {};
+        }
+        offset = 0;
+    }
+
+    stagingRing.regions.push_back({offset, offset + size, serial});
+    stagingRing.head = offset + size;
+    return {stagingRing.buffer, offset, stagingRing.mappedData + offset};
+}
+
+bool GraphicsAPI_Vulkan::ReplaceStagingRing(VkDeviceSize ringSize) {
+    if (stagingRing.buffer) {
+        stagingRing.retiredSerial = frameSerial;
+        retiredStagingRings.push_back(std::move(stagingRing));
+    }
+    stagingRing = StagingRing();
+    return CreateStagingBuffer(ringSize, stagingRing);
+}
+
+bool GraphicsAPI_Vulkan::CreateStagingBuffer(VkDeviceSize size, StagingRing &ring) {
+    // Both queue families copy from the buffer, so it is shared rather than handed over between them.
+    uint32_t queueFamilyIndices[2] = {queueFamilyIndex, transferQueueFamilyIndex};
+    VkBufferCreateInfo bufferCI{};
+    bufferCI.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferCI.pNext = nullptr;
+    bufferCI.flags = 0;
+    bufferCI.size = size;
+    bufferCI.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferCI.sharingMode = transferQueue ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+    bufferCI.queueFamilyIndexCount = transferQueue ? 2 : 0;
+    bufferCI.pQueueFamilyIndices = transferQueue ? queueFamilyIndices : nullptr;
+    VkResult result = vkCreateBuffer(device, &bufferCI, nullptr, &ring.buffer);
+    if (result != VK_SUCCESS) {
+        std::cout << "ERROR: VULKAN: Failed to create staging buffer of " << size << " bytes: 0x" << std::hex << result << std::dec << std::endl;
+        DEBUG_BREAK;
+        ring = StagingRing();
+        return false;
+    }
+
+    VkMemoryRequirements memoryRequirements{};
+    vkGetBufferMemoryRequirements(device, ring.buffer, &memoryRequirements);
+
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.pNext = nullptr;
+    allocInfo.allocationSize = memoryRequirements.size;
+    if (!MemoryTypeFromProperties(memoryProperties, memoryRequirements.memoryTypeBits,
+                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                  &allocInfo.memoryTypeIndex)) {
+        std::cout << "ERROR: VULKAN: Failed to find a host visible and coherent memory type for the staging buffer." << std::endl;
+        DEBUG_BREAK;
+        vkDestroyBuffer(device, ring.buffer, nullptr);
+        ring = StagingRing();
+        return false;
+    }
+    result = vkAllocateMemory(device, &allocInfo, nullptr, &ring.memory);
+    if (result != VK_SUCCESS) {
+        std::cout << "ERROR: VULKAN: Failed to allocate staging memory of " << allocInfo.allocationSize << " bytes: 0x" << std::hex << result << std::dec << std::endl;
+        DEBUG_BREAK;
+        vkDestroyBuffer(device, ring.buffer, nullptr);
+        ring = StagingRing();
+        return false;
+    }
+
+    // The buffer stays mapped for its whole lifetime.
+    void *mappedData = nullptr;
+    result = vkBindBufferMemory(device, ring.buffer, ring.memory, 0);
+    if (result == VK_SUCCESS) {
+        result = vkMapMemory(device, ring.memory, 0, VK_WHOLE_SIZE, 0, &mappedData);
+    }
+    if (result != VK_SUCCESS) {
+        std::cout << "ERROR: VULKAN: Failed to bind or map staging memory: 0x" << std::hex << result << std::dec << std::endl;
+        DEBUG_BREAK;
+        vkDestroyBuffer(device, ring.buffer, nullptr);
+        vkFreeMemory(device, ring.memory, nullptr);
+        ring = StagingRing();
+        return false;
+    }
+
+    ring.size = size;
+    ring.mappedData = static_cast<uint8_t *>(mappedData);
+    return true;
+}
+
+void GraphicsAPI_Vulkan::DestroyStagingRing(StagingRing &ring) {
+    if (ring.buffer) {
+        vkUnmapMemory(device, ring.memory);
+        vkDestroyBuffer(device, ring.buffer, nullptr);
+        vkFreeMemory(device, ring.memory, nullptr);
+    }
+    ring = StagingRing();
+}
+
 void GraphicsAPI_Vulkan::LoadPFN_XrFunctions(XrInstance m_xrInstance) {
     OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetVulkanGraphicsRequirementsKHR", (PFN_xrVoidFunction *)&xrGetVulkanGraphicsRequirementsKHR), "Failed to get InstanceProcAddr for xrGetVulkanGraphicsRequirementsKHR.");
     OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetVulkanInstanceExtensionsKHR", (PFN_xrVoidFunction *)&xrGetVulkanInstanceExtensionsKHR), "Failed to get InstanceProcAddr for xrGetVulkanInstanceExtensionsKHR.");
@@ -6,7 +6,16 @@
 
 #pragma once
 #include <GraphicsAPI.h>
+
+#include <array>
 #include <cstdint>
+#include <deque>
+#include <map>
+
+// Number of frames the CPU may record ahead of the GPU.
+#if !defined(XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT)
+#define XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT 2
+#endif
 
 class GraphicsAPI_Vulkan : public GraphicsAPI {
 public:
@@ -62,6 +71,8 @@ public:
     virtual void ClearColor(void* imageView, float r, float g, float b, float a) override;
     virtual void ClearDepth(void* imageView, float d) override;
 
+    // Uploads are recorded into the current frame, so they must be called between BeginRendering() and EndRendering().
+    // The pixels are copied into a persistently mapped staging ring; a dedicated transfer queue performs the copy when the device has one.
     void UploadRgbaToImage(void* imageView, uint32_t width, uint32_t height, const uint8_t* data, size_t size);
 
     // Upload RGBA data centered within a destination image (for dimension mismatch handling and future zoom)
@@ -86,6 +97,17 @@ public:
     virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) override;
     virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
 
+    // Waits for the GPU to go idle and recreates the per-frame resources. Must not be called between BeginRendering() and EndRendering().
+    void SetFramesInFlight(uint32_t count);
+    uint32_t GetFramesInFlight() const { return static_cast<uint32_t>(frames.size()); }
+
+    // A descriptor recorded by SetDescriptor() and written by UpdateDescriptors(). The uint32_t is the offset of a dynamic uniform buffer, which is bound rather than written.
+    using PendingDescriptorWrite = std::tuple<VkWriteDescriptorSet, VkDescriptorBufferInfo, VkDescriptorImageInfo, uint32_t>;
+
+    // Sorts writes by binding and builds the key of their descriptor set in the per-frame cache from the set layout and the bound resources.
+    // Dynamic uniform buffer offsets are left out of the key. dynamicOffsets gets one for each of dynamicBindings, the layout's dynamic uniform buffer bindings in ascending order; those without a write get 0.
+    static void BuildDescriptorSetKey(VkDescriptorSetLayout descSetLayout, const std::vector<uint32_t>& dynamicBindings, std::vector<PendingDescriptorWrite>& writes, std::vector<uint64_t>& key, std::vector<uint32_t>& dynamicOffsets);
+
 private:
     void LoadPFN_XrFunctions(XrInstance m_xrInstance);
     std::vector<std::string> GetInstanceExtensionsForOpenXR(XrInstance m_xrInstance, XrSystemId systemId);
@@ -94,6 +116,101 @@ private:
     virtual const std::vector<int64_t> GetSupportedColorSwapchainFormats() override;
     virtual const std::vector<int64_t> GetSupportedDepthSwapchainFormats() override;
 
+    // Identifies a framebuffer by its render pass, attachments and size; it has a fixed size so looking one up never allocates.
+    static constexpr uint32_t maxFramebufferAttachments = 9;  // Up to 8 color attachments and a depth attachment.
+    struct FramebufferKey {
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        std::array<VkImageView, maxFramebufferAttachments> attachments{};  // Unused attachments stay VK_NULL_HANDLE.
+        uint32_t attachmentCount = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        bool operator==(const FramebufferKey& other) const {
+            return renderPass == other.renderPass && attachments == other.attachments && attachmentCount == other.attachmentCount && width == other.width && height == other.height;
+        }
+    };
+    struct FramebufferKeyHash {
+        size_t operator()(const FramebufferKey& key) const {
+            uint64_t hash = 14695981039346656037ull;
+            hash = (hash ^ (uint64_t)key.renderPass) * 1099511628211ull;
+            for (uint32_t i = 0; i < key.attachmentCount; i++) {
+                hash = (hash ^ (uint64_t)key.attachments[i]) * 1099511628211ull;
+            }
+            hash = (hash ^ (((uint64_t)key.width << 32) | key.height)) * 1099511628211ull;
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct DescriptorSetKeyHash {
+        size_t operator()(const std::vector<uint64_t>& key) const {
+            uint64_t hash = 14695981039346656037ull;
+            for (uint64_t value : key) {
+                hash = (hash ^ value) * 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    // Everything a frame needs until the GPU has finished executing it.
+    struct FrameResources {
+        VkCommandPool cmdPool = VK_NULL_HANDLE;
+        VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        VkSemaphore acquireSemaphore = VK_NULL_HANDLE;  // Only with a desktop swapchain.
+        VkSemaphore submitSemaphore = VK_NULL_HANDLE;   // Only with a desktop swapchain.
+        uint64_t serial = 0;                            // Frame last recorded into this slot.
+        VkCommandPool transferCmdPool = VK_NULL_HANDLE;      // Only with a dedicated transfer queue.
+        VkCommandBuffer transferCmdBuffer = VK_NULL_HANDLE;  // Only with a dedicated transfer queue.
+        VkSemaphore transferSemaphore = VK_NULL_HANDLE;      // Signalled by the transfer submit and waited on by the graphics submit.
+        bool transferRecording = false;                      // transferCmdBuffer holds uploads that EndRendering() has yet to submit.
+        // Descriptor sets allocated from descriptorPool this frame, keyed by their layout and bound resources.
+        std::unordered_map<std::vector<uint64_t>, VkDescriptorSet, DescriptorSetKeyHash> descriptorSetCache;
+    };
+
+    // A region of the staging ring stays reserved until the frame that copies from it has finished on the GPU.
+    struct StagingRegion {
+        VkDeviceSize begin;
+        VkDeviceSize end;
+        uint64_t serial;
+    };
+    struct StagingRing {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint8_t* mappedData = nullptr;
+        VkDeviceSize size = 0;
+        VkDeviceSize head = 0;
+        uint64_t retiredSerial = 0;  // Last frame that copies from the ring once it has been replaced.
+        std::deque<StagingRegion> regions;
+    };
+    // Bytes handed out by AllocateStaging(). buffer is VK_NULL_HANDLE if the allocation failed.
+    struct StagingAllocation {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        uint8_t* mappedData = nullptr;  // Points at offset.
+    };
+    // The ring doesn't grow past this. Uploads that don't fit get a staging buffer of their own instead.
+    static constexpr VkDeviceSize maxStagingRingSize = 64 * 1024 * 1024;
+
+    void CreateFrameResources(uint32_t count);
+    void CreateFrameSemaphores(FrameResources& frame);
+    void DestroyFrameResources();
+    void BeginFrameSlot();
+    void WaitForFrameSerial(uint64_t serial);
+    void WaitForAllFrames();
+    void ClearDescriptorSetCaches();
+    // Destroys the cached framebuffers that use renderPass or imageView.
+    void DestroyCachedFramebuffers(VkRenderPass renderPass, VkImageView imageView);
+    // Returns size bytes of staging memory that can be written until the current frame has finished.
+    StagingAllocation AllocateStaging(VkDeviceSize size);
+    // Replaces the ring with an empty one of ringSize bytes. On failure the ring is left empty.
+    bool ReplaceStagingRing(VkDeviceSize ringSize);
+    // Creates, allocates and maps the buffer of an empty ring. On failure nothing is left allocated.
+    bool CreateStagingBuffer(VkDeviceSize size, StagingRing& ring);
+    void DestroyStagingRing(StagingRing& ring);
+    // Copies region of stagingBuffer into image and leaves it in VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL.
+    void RecordRgbaUpload(VkImage image, VkBuffer stagingBuffer, const VkBufferImageCopy& region, bool clear);
+
 private:
     VkInstance instance{};
     VkPhysicalDevice physicalDevice{};
@@ -101,11 +218,15 @@ private:
     uint32_t queueFamilyIndex = 0xFFFFFFFF;
     uint32_t queueIndex = 0xFFFFFFFF;
     VkQueue queue{};
-    VkFence fence{};
+    uint32_t transferQueueFamilyIndex = 0xFFFFFFFF;  // A family without graphics or compute, if the device has one.
+    VkQueue transferQueue{};
 
-    VkCommandPool cmdPool{};
-    VkCommandBuffer cmdBuffer{};
-    VkDescriptorPool descriptorPool;
+    std::vector<FrameResources> frames;
+    uint32_t frameIndex = 0;
+    bool frameSlotReady = false;          // frames[frameIndex] has been waited for and may be recorded into.
+    uint64_t frameSerial = 0;             // Last frame started.
+    uint64_t completedFrameSerial = 0;    // Every frame up to this one has finished on the GPU.
+    VkCommandBuffer cmdBuffer{};          // Command buffer of frames[frameIndex].
 
     std::vector<const char*> activeInstanceLayers{};
     std::vector<const char*> activeInstanceExtensions{};
@@ -123,23 +244,28 @@ private:
     VkImage currentDesktopSwapchainImage = VK_NULL_HANDLE;
 
     std::unordered_map<VkSwapchainKHR, VkSurfaceKHR> surfaces;
-    VkSemaphore acquireSemaphore{};
-    VkSemaphore submitSemaphore{};
 
     std::unordered_map<VkImage, VkImageLayout> imageStates;
     std::unordered_map<VkImage, std::pair<VkDeviceMemory, ImageCreateInfo>> imageResources;
     std::unordered_map<VkImageView, ImageViewCreateInfo> imageViewResources;
 
     std::unordered_map<VkBuffer, std::pair<VkDeviceMemory, BufferCreateInfo>> bufferResources;
+    std::unordered_map<VkBuffer, uint64_t> bufferLastUse;  // Serial of the last frame that bound the buffer.
+
+    StagingRing stagingRing;
+    VkDeviceSize stagingAlignment = 0;  // optimalBufferCopyOffsetAlignment, queried on first use.
+    std::vector<StagingRing> retiredStagingRings;  // Replaced rings and one-off staging buffers that frames in flight still read.
 
     std::unordered_map<VkShaderModule, ShaderCreateInfo> shaderResources;
-    std::unordered_map<VkPipeline, std::tuple<VkPipelineLayout, VkDescriptorSetLayout, VkRenderPass, PipelineCreateInfo>> pipelineResources;
+    // The last element holds the bindings of the pipeline's dynamic uniform buffers, in ascending order.
+    std::unordered_map<VkPipeline, std::tuple<VkPipelineLayout, VkDescriptorSetLayout, VkRenderPass, PipelineCreateInfo, std::vector<uint32_t>>> pipelineResources;
 
-    std::unordered_map<VkCommandBuffer, std::vector<VkFramebuffer>> cmdBufferFramebuffers;
+    std::unordered_map<FramebufferKey, VkFramebuffer, FramebufferKeyHash> framebufferCache;
     bool inRenderPass = false;
 
     VkPipeline setPipeline = VK_NULL_HANDLE;
-    std::unordered_map<VkCommandBuffer, std::vector<VkDescriptorSet>> cmdBufferDescriptorSets;
-    std::vector<std::tuple<VkWriteDescriptorSet, VkDescriptorBufferInfo, VkDescriptorImageInfo>> writeDescSets;
+    std::vector<PendingDescriptorWrite> writeDescSets;
+    std::vector<uint64_t> descSetKey;
+    std::vector<uint32_t> dynamicOffsets;
 
 };
@@ -0,0 +1,233 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Camera2 Tutorial: YUV_420_888 to RGBA/BGRA conversion with resampling.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Define XR_TUT_YUV_NO_SIMD to build only the scalar path, which the tests compare against.
+#if defined(XR_TUT_YUV_NO_SIMD)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define XR_TUT_YUV_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define XR_TUT_YUV_SSE2 1
+#endif
+
+// One YUV_420_888 image as reported by AImage. The chroma planes may be planar (pixelStride 1)
+// or semi-planar NV12/NV21 (pixelStride 2, U and V pointing into the same interleaved rows).
+struct YuvImage {
+    const uint8_t *planes[3] = {nullptr, nullptr, nullptr};
+    int planeLength[3] = {0, 0, 0};
+    int rowStride[3] = {0, 0, 0};
+    int pixelStride[3] = {0, 0, 0};
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+// Converts YUV_420_888 images to 8-bit RGBA or BGRA at an arbitrary output size using
+// nearest-neighbour resampling. The source column and row of every output pixel are computed once
+// per image geometry rather than per pixel, and the colour conversion runs 8 pixels at a time
+// with NEON or SSE2 when available. The scalar fallback uses the same fixed-point math, so every
+// path produces identical output.
+class YuvConverter {
+public:
+    // Converts image into outPixels, which must hold outputWidth * outputHeight * 4 bytes.
+    // Pixels whose source samples lie outside the planes are written as black (luma) or with
+    // neutral chroma, instead of being left untouched.
+    void Convert(const YuvImage &image, uint32_t outputWidth, uint32_t outputHeight, bool bgra, uint8_t *outPixels) {
+        if (outputWidth == 0 || outputHeight == 0 || image.width == 0 || image.height == 0) {
+            return;
+        }
+        UpdateTables(image, outputWidth, outputHeight);
+
+        // Some devices report U and V as the same pointer for interleaved chroma; V then follows U.
+        const uint8_t *vPlane = image.planes[2];
+        int vLength = image.planeLength[2];
+        if (image.planes[1] == image.planes[2]) {
+            vPlane = image.planes[1] + 1;
+            vLength = image.planeLength[1] - 1;
+        }
+
+        for (uint32_t y = 0; y < outputHeight; ++y) {
+            const size_t srcY = m_srcRow[y];
+            const size_t yRowOffset = srcY * static_cast<size_t>(image.rowStride[0]);
+            const size_t uRowOffset = (srcY / 2) * static_cast<size_t>(image.rowStride[1]);
+            const size_t vRowOffset = (srcY / 2) * static_cast<size_t>(image.rowStride[2]);
+
+            // The tables are non-decreasing, so each row is valid up to some column and only the
+            // row limits need to be found; the gathers below are then free of bounds checks.
+            const uint32_t yCount = ValidCount(m_lumaOffsets, yRowOffset, image.planeLength[0], image.rowStride[0]);
+            const uint32_t uCount = ValidCount(m_uOffsets, uRowOffset, image.planeLength[1], image.rowStride[1]);
+            const uint32_t vCount = ValidCount(m_vOffsets, vRowOffset, vLength, image.rowStride[2]);
+
+            const uint8_t *yRow = image.planes[0] + yRowOffset;
+            const uint8_t *uRow = image.planes[1] + uRowOffset;
+            const uint8_t *vRow = vPlane + vRowOffset;
+            uint8_t *lumaRow = m_lumaRow.data();
+            uint8_t *uRowOut = m_uRow.data();
+            uint8_t *vRowOut = m_vRow.data();
+            if (m_lumaIdentity && yCount == outputWidth) {
+                lumaRow = const_cast<uint8_t *>(yRow);
+            } else {
+                Gather(yRow, m_lumaOffsets.data(), yCount, outputWidth, 0, lumaRow);
+            }
+            Gather(uRow, m_uOffsets.data(), uCount, outputWidth, 128, uRowOut);
+            Gather(vRow, m_vOffsets.data(), vCount, outputWidth, 128, vRowOut);
+
+            ConvertRow(lumaRow, uRowOut, vRowOut, outputWidth, bgra, outPixels + static_cast<size_t>(y) * outputWidth * 4);
+        }
+    }
+
+private:
+    // Fixed-point BT.601 full-range coefficients in Q7. All intermediate values fit in int16.
+    static constexpr int kVToR = 179;  // 1.402
+    static constexpr int kUToG = 44;   // 0.344136
+    static constexpr int kVToG = 91;   // 0.714136
+    static constexpr int kUToB = 227;  // 1.772
+
+    static uint8_t ClampByte(int value) {
+        return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    void UpdateTables(const YuvImage &image, uint32_t outputWidth, uint32_t outputHeight) {
+        if (m_srcWidth == image.width && m_srcHeight == image.height && m_outputWidth == outputWidth &&
+            m_outputHeight == outputHeight && m_lumaStride == image.pixelStride[0] &&
+            m_uStride == image.pixelStride[1] && m_vStride == image.pixelStride[2]) {
+            return;
+        }
+        m_srcWidth = image.width;
+        m_srcHeight = image.height;
+        m_outputWidth = outputWidth;
+        m_outputHeight = outputHeight;
+        m_lumaStride = image.pixelStride[0];
+        m_uStride = image.pixelStride[1];
+        m_vStride = image.pixelStride[2];
+
+        m_lumaOffsets.resize(outputWidth);
+        m_uOffsets.resize(outputWidth);
+        m_vOffsets.resize(outputWidth);
+        m_lumaIdentity = (outputWidth == image.width && m_lumaStride == 1);
+        for (uint32_t x = 0; x < outputWidth; ++x) {
+            const uint32_t srcX = static_cast<uint32_t>(static_cast<uint64_t>(x) * image.width / outputWidth);
+            m_lumaOffsets[x] = srcX * static_cast<uint32_t>(m_lumaStride);
+            m_uOffsets[x] = (srcX / 2) * static_cast<uint32_t>(m_uStride);
+            m_vOffsets[x] = (srcX / 2) * static_cast<uint32_t>(m_vStride);
+        }
+        m_srcRow.resize(outputHeight);
+        for (uint32_t y = 0; y < outputHeight; ++y) {
+            m_srcRow[y] = static_cast<uint32_t>(static_cast<uint64_t>(y) * image.height / outputHeight);
+        }
+        m_lumaRow.resize(outputWidth);
+        m_uRow.resize(outputWidth);
+        m_vRow.resize(outputWidth);
+    }
+
+    // Number of leading columns whose sample lies inside both the row and the plane.
+    static uint32_t ValidCount(const std::vector<uint32_t> &offsets, size_t rowOffset, int planeLength, int rowStride) {
+        if (rowOffset >= static_cast<size_t>(planeLength)) {
+            return 0;
+        }
+        const size_t limit = std::min(static_cast<size_t>(planeLength) - rowOffset, static_cast<size_t>(rowStride));
+        uint32_t count = static_cast<uint32_t>(offsets.size());
+        while (count > 0 && offsets[count - 1] >= limit) {
+            count--;
+        }
+        return count;
+    }
+
+    static void Gather(const uint8_t *src, const uint32_t *offsets, uint32_t count, uint32_t width, uint8_t fill, uint8_t *dst) {
+        uint32_t x = 0;
+        for (; x + 4 <= count; x += 4) {
+            dst[x + 0] = src[offsets[x + 0]];
+            dst[x + 1] = src[offsets[x + 1]];
+            dst[x + 2] = src[offsets[x + 2]];
+            dst[x + 3] = src[offsets[x + 3]];
+        }
+        for (; x < count; ++x) {
+            dst[x] = src[offsets[x]];
+        }
+        for (; x < width; ++x) {
+            dst[x] = fill;
+        }
+    }
+
+    static void ConvertRow(const uint8_t *luma, const uint8_t *u, const uint8_t *v, uint32_t width, bool bgra, uint8_t *out) {
+        uint32_t x = 0;
+#if defined(XR_TUT_YUV_NEON)
+        const int16x8_t bias = vdupq_n_s16(128);
+        const uint8x8_t alpha = vdup_n_u8(255);
+        for (; x + 8 <= width; x += 8) {
+            const int16x8_t yv = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(luma + x)));
+            const int16x8_t uv = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + x))), bias);
+            const int16x8_t vv = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + x))), bias);
+            const int16x8_t r = vaddq_s16(yv, vrshrq_n_s16(vmulq_n_s16(vv, kVToR), 7));
+            const int16x8_t g = vsubq_s16(yv, vrshrq_n_s16(vaddq_s16(vmulq_n_s16(uv, kUToG), vmulq_n_s16(vv, kVToG)), 7));
+            const int16x8_t b = vaddq_s16(yv, vrshrq_n_s16(vmulq_n_s16(uv, kUToB), 7));
+            uint8x8x4_t pixels;
+            pixels.val[0] = vqmovun_s16(bgra ? b : r);
+            pixels.val[1] = vqmovun_s16(g);
+            pixels.val[2] = vqmovun_s16(bgra ? r : b);
+            pixels.val[3] = alpha;
+            vst4_u8(out + x * 4, pixels);
+        }
+#elif defined(XR_TUT_YUV_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128i round = _mm_set1_epi16(64);
+        const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+        for (; x + 8 <= width; x += 8) {
+            const __m128i yv = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(luma + x)), zero);
+            const __m128i uv = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x)), zero), bias);
+            const __m128i vv = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + x)), zero), bias);
+            const __m128i rd = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(vv, _mm_set1_epi16(kVToR)), round), 7);
+            const __m128i gd = _mm_srai_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(uv, _mm_set1_epi16(kUToG)), _mm_mullo_epi16(vv, _mm_set1_epi16(kVToG))), round), 7);
+            const __m128i bd = _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(uv, _mm_set1_epi16(kUToB)), round), 7);
+            const __m128i r = _mm_packus_epi16(_mm_add_epi16(yv, rd), zero);
+            const __m128i g = _mm_packus_epi16(_mm_sub_epi16(yv, gd), zero);
+            const __m128i b = _mm_packus_epi16(_mm_add_epi16(yv, bd), zero);
+            const __m128i c0g = _mm_unpacklo_epi8(bgra ? b : r, g);
+            const __m128i c2a = _mm_unpacklo_epi8(bgra ? r : b, alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x * 4), _mm_unpacklo_epi16(c0g, c2a));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x * 4 + 16), _mm_unpackhi_epi16(c0g, c2a));
+        }
+#endif
+        // Scalar tail (or the whole row without SIMD), matching the vector rounding exactly.
+        const int c0 = bgra ? 2 : 0;
+        const int c2 = bgra ? 0 : 2;
+        for (; x < width; ++x) {
+            const int yl = luma[x];
+            const int uc = static_cast<int>(u[x]) - 128;
+            const int vc = static_cast<int>(v[x]) - 128;
+            uint8_t *pixel = out + x * 4;
+            pixel[c0] = ClampByte(yl + ((vc * kVToR + 64) >> 7));
+            pixel[1] = ClampByte(yl - ((uc * kUToG + vc * kVToG + 64) >> 7));
+            pixel[c2] = ClampByte(yl + ((uc * kUToB + 64) >> 7));
+            pixel[3] = 255;
+        }
+    }
+
+    uint32_t m_srcWidth = 0;
+    uint32_t m_srcHeight = 0;
+    uint32_t m_outputWidth = 0;
+    uint32_t m_outputHeight = 0;
+    int m_lumaStride = 0;
+    int m_uStride = 0;
+    int m_vStride = 0;
+    bool m_lumaIdentity = false;
+
+    std::vector<uint32_t> m_lumaOffsets;  // byte offset of each output column's luma sample
+    std::vector<uint32_t> m_uOffsets;     // byte offset of each output column's U sample
+    std::vector<uint32_t> m_vOffsets;     // byte offset of each output column's V sample
+    std::vector<uint32_t> m_srcRow;       // source row of each output row
+    std::vector<uint8_t> m_lumaRow;       // resampled luma, U and V samples of the current row
+    std::vector<uint8_t> m_uRow;
+    std::vector<uint8_t> m_vRow;
+};
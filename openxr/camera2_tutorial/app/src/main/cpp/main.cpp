@@ -5,8 +5,10 @@
 // OpenXR Camera2 Tutorial (standalone scaffold)
 
 #include <DebugOutput.h>
+#include <FrameTripleBuffer.h>
 #include <GraphicsAPI_Vulkan.h>
 #include <OpenXRDebugUtils.h>
+#include <YuvConverter.h>
 
 #include <atomic>
 #include <algorithm>
@@ -15,7 +17,6 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
-#include <mutex>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,22 +29,12 @@
 
 static std::atomic<bool> g_cameraPermissionGranted{false};
 
-static uint8_t ClampToByte(int value) {
-    if (value < 0) {
-        return 0;
-    }
-    if (value > 255) {
-        return 255;
-    }
-    return static_cast<uint8_t>(value);
-}
-
 static bool IsBgraFormat(int64_t format) {
     return format == VK_FORMAT_B8G8R8A8_UNORM || format == VK_FORMAT_B8G8R8A8_SRGB;
 }
 
-static void SwizzleRgbaToBgra(std::vector<uint8_t> &rgba) {
-    for (size_t i = 0; i + 3 < rgba.size(); i += 4) {
+static void SwizzleRgbaToBgra(uint8_t *rgba, size_t size) {
+    for (size_t i = 0; i + 3 < size; i += 4) {
         std::swap(rgba[i + 0], rgba[i + 2]);
     }
 }
@@ -145,7 +136,6 @@ public:
             return fail("Camera2: Failed to start repeating request.");
         }
 
-        m_latestRgba.resize(static_cast<size_t>(m_outputWidth) * m_outputHeight * 4);
         m_running = true;
         m_frameCount = 0;
         m_lastLogTime = std::chrono::steady_clock::now();
@@ -207,20 +197,19 @@ public:
         return m_running;
     }
 
-    bool GetLatestFrame(std::vector<uint8_t> &outRgba, uint32_t &width, uint32_t &height) {
-        if (!m_running || !m_hasFrame) {
-            return false;
-        }
+    // Requests that frames be converted straight to BGRA so the swapchain upload needs no swizzle.
+    void SetOutputBgra(bool bgra) {
+        m_outputBgra = bgra;
+    }
 
-        std::lock_guard<std::mutex> lock(m_frameMutex);
-        if (!m_hasFrame) {
+    // Makes the newest published frame the caller's frame without copying it. Returns true if
+    // it is newer than the previous call's; frame stays valid and is owned by the render thread
+    // until the next call, so the caller may keep re-using it.
+    bool AcquireLatestFrame(FrameTripleBuffer::Frame &frame) {
+        if (!m_running) {
             return false;
         }
-        outRgba = m_latestRgba;
-        width = m_outputWidth;
-        height = m_outputHeight;
-        m_hasFrame = false;
-        return true;
+        return m_frames.AcquireLatest(frame);
     }
 
 private:
@@ -369,7 +358,7 @@ private:
             AImage_delete(image);
             return;
         }
-        if (pixelStride[0] == 0 || pixelStride[1] == 0 || pixelStride[2] == 0) {
+        if (pixelStride[0] <= 0 || pixelStride[1] <= 0 || pixelStride[2] <= 0) {
             AImage_delete(image);
             return;
         }
@@ -381,21 +370,13 @@ private:
             return;
         }
 
-        std::lock_guard<std::mutex> lock(self->m_frameMutex);
-        if (self->m_latestRgba.size() != static_cast<size_t>(outputWidth) * outputHeight * 4) {
-            self->m_latestRgba.resize(static_cast<size_t>(outputWidth) * outputHeight * 4);
-        }
-
         const bool interleavedUV = (planeData[1] == planeData[2]);
-        if (interleavedUV) {
-            self->m_uvIsVU = false;
-        }
 
         if (!self->m_loggedFormat) {
             XR_TUT_LOG("Camera2: Y plane rowStride=" << rowStride[0] << " pixelStride=" << pixelStride[0] << " len=" << planeLength[0]);
             XR_TUT_LOG("Camera2: U plane rowStride=" << rowStride[1] << " pixelStride=" << pixelStride[1] << " len=" << planeLength[1]);
             XR_TUT_LOG("Camera2: V plane rowStride=" << rowStride[2] << " pixelStride=" << pixelStride[2] << " len=" << planeLength[2]);
-            XR_TUT_LOG("Camera2: interleavedUV=" << (interleavedUV ? "true" : "false") << " uvIsVU=" << (self->m_uvIsVU ? "true" : "false"));
+            XR_TUT_LOG("Camera2: interleavedUV=" << (interleavedUV ? "true" : "false"));
             // Log first few Y values to verify we're getting real data
             XR_TUT_LOG("Camera2: First 8 Y values: "
                 << (int)planeData[0][0] << " " << (int)planeData[0][1] << " "
@@ -412,74 +393,22 @@ private:
             self->m_loggedFormat = true;
         }
 
-        for (uint32_t y = 0; y < outputHeight; ++y) {
-            uint32_t srcY = static_cast<uint32_t>(y * srcHeight / outputHeight);
-            const uint8_t *yRow = planeData[0] + srcY * rowStride[0];
-            const uint8_t *uRow = planeData[1] + (srcY / 2) * rowStride[1];
-            const uint8_t *vRow = planeData[2] + (srcY / 2) * rowStride[2];
-
-            for (uint32_t x = 0; x < outputWidth; ++x) {
-                uint32_t srcX = static_cast<uint32_t>(x * srcWidth / outputWidth);
-                int yIndex = static_cast<int>(srcX * pixelStride[0]);
-                int uIndex = static_cast<int>((srcX / 2) * pixelStride[1]);
-                int vIndex = static_cast<int>((srcX / 2) * pixelStride[2]);
-
-                size_t yOffset = static_cast<size_t>(srcY) * static_cast<size_t>(rowStride[0]);
-                size_t uOffset = static_cast<size_t>(srcY / 2) * static_cast<size_t>(rowStride[1]);
-                size_t vOffset = static_cast<size_t>(srcY / 2) * static_cast<size_t>(rowStride[2]);
-
-                if (yIndex < 0 || uIndex < 0 || vIndex < 0) {
-                    continue;
-                }
-                if (yIndex >= rowStride[0] || uIndex >= rowStride[1] || vIndex >= rowStride[2]) {
-                    continue;
-                }
-                if (yOffset + static_cast<size_t>(yIndex) >= static_cast<size_t>(planeLength[0])) {
-                    continue;
-                }
-
-                uint8_t yValue = yRow[yIndex];
-                uint8_t uValue = 128;
-                uint8_t vValue = 128;
-
-                if (interleavedUV) {
-                    size_t uvOffset = static_cast<size_t>(srcY / 2) * static_cast<size_t>(rowStride[1]);
-                    size_t uvIndex = static_cast<size_t>(uIndex);
-                    if (uvOffset + uvIndex + 1 < static_cast<size_t>(planeLength[1])) {
-                        if (self->m_uvIsVU) {
-                            vValue = uRow[uvIndex];
-                            uValue = uRow[uvIndex + 1];
-                        } else {
-                            uValue = uRow[uvIndex];
-                            vValue = uRow[uvIndex + 1];
-                        }
-                    }
-                } else {
-                    if (uOffset + static_cast<size_t>(uIndex) < static_cast<size_t>(planeLength[1])) {
-                        uValue = uRow[uIndex];
-                    }
-                    if (vOffset + static_cast<size_t>(vIndex) < static_cast<size_t>(planeLength[2])) {
-                        vValue = vRow[vIndex];
-                    }
-                }
-
-                int yLum = static_cast<int>(yValue);
-                int u = static_cast<int>(uValue) - 128;
-                int v = static_cast<int>(vValue) - 128;
-
-                int r = static_cast<int>(yLum + 1.402f * v);
-                int g = static_cast<int>(yLum - 0.344136f * u - 0.714136f * v);
-                int b = static_cast<int>(yLum + 1.772f * u);
-
-                size_t outIndex = (static_cast<size_t>(y) * outputWidth + x) * 4;
-                self->m_latestRgba[outIndex + 0] = ClampToByte(r);
-                self->m_latestRgba[outIndex + 1] = ClampToByte(g);
-                self->m_latestRgba[outIndex + 2] = ClampToByte(b);
-                self->m_latestRgba[outIndex + 3] = 255;
-            }
+        // Convert straight into the back slot of the triple buffer and publish it; the render
+        // thread never waits for the conversion and never copies the frame.
+        const size_t frameSize = static_cast<size_t>(outputWidth) * outputHeight * 4;
+        uint8_t *pixels = self->m_frames.BeginWrite(frameSize);
+        YuvImage yuv;
+        yuv.width = static_cast<uint32_t>(srcWidth);
+        yuv.height = static_cast<uint32_t>(srcHeight);
+        for (int i = 0; i < 3; ++i) {
+            yuv.planes[i] = planeData[i];
+            yuv.planeLength[i] = planeLength[i];
+            yuv.rowStride[i] = rowStride[i];
+            yuv.pixelStride[i] = pixelStride[i];
         }
+        const bool outputBgra = self->m_outputBgra.load();
+        self->m_converter.Convert(yuv, outputWidth, outputHeight, outputBgra, pixels);
 
-        self->m_hasFrame = true;
         self->m_frameCount++;
         auto now = std::chrono::steady_clock::now();
         auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - self->m_lastLogTime).count();
@@ -490,18 +419,19 @@ private:
             size_t centerY = outputHeight / 2;
             size_t centerX = outputWidth / 2;
             size_t centerIdx = (centerY * outputWidth + centerX) * 4;
-            if (centerIdx + 3 < self->m_latestRgba.size()) {
+            if (centerIdx + 3 < frameSize) {
                 XR_TUT_LOG("Camera2: FPS=" << fps << " Center RGBA=("
-                    << (int)self->m_latestRgba[centerIdx] << ","
-                    << (int)self->m_latestRgba[centerIdx+1] << ","
-                    << (int)self->m_latestRgba[centerIdx+2] << ","
-                    << (int)self->m_latestRgba[centerIdx+3] << ")");
+                    << (int)pixels[centerIdx] << ","
+                    << (int)pixels[centerIdx+1] << ","
+                    << (int)pixels[centerIdx+2] << ","
+                    << (int)pixels[centerIdx+3] << ")");
             } else {
                 XR_TUT_LOG("Camera2: FPS=" << fps);
             }
             self->m_frameCount = 0;
             self->m_lastLogTime = now;
         }
+        self->m_frames.EndWrite(outputWidth, outputHeight, outputBgra);
         AImage_delete(image);
     }
 
@@ -556,13 +486,12 @@ private:
     uint32_t m_outputWidth = 0;
     uint32_t m_outputHeight = 0;
 
-    std::mutex m_frameMutex;
-    std::vector<uint8_t> m_latestRgba;
-    bool m_hasFrame = false;
+    FrameTripleBuffer m_frames;
+    YuvConverter m_converter;  // only touched by the image callback
+    std::atomic<bool> m_outputBgra = false;
     std::atomic<bool> m_running = false;
     uint64_t m_frameCount = 0;
     std::chrono::steady_clock::time_point m_lastLogTime{};
-    bool m_uvIsVU = false;
     bool m_loggedFormat = false;
 };
 
@@ -807,6 +736,7 @@ private:
 
         OPENXR_CHECK(xrCreateSwapchain(m_session, &swapchainCI, &m_quadSwapchain.swapchain), "Failed to create Quad Swapchain.");
         m_quadSwapchain.swapchainFormat = colorFormat;
+        m_camera.SetOutputBgra(IsBgraFormat(colorFormat));
         m_quadSwapchain.width = swapchainCI.width;
         m_quadSwapchain.height = swapchainCI.height;
         XR_TUT_LOG("Quad Swapchain created: " << m_quadSwapchain.width << "x" << m_quadSwapchain.height << " format=" << colorFormat);
@@ -918,35 +848,32 @@ private:
         waitInfo.timeout = XR_INFINITE_DURATION;
         OPENXR_CHECK(xrWaitSwapchainImage(m_quadSwapchain.swapchain, &waitInfo), "Failed to wait for Quad Swapchain Image.");
 
-        // Get latest camera frame
-        std::vector<uint8_t> frame;
-        uint32_t frameWidth = 0;
-        uint32_t frameHeight = 0;
-        if (m_camera.GetLatestFrame(frame, frameWidth, frameHeight)) {
-            m_cachedFrame = std::move(frame);
-            m_cachedWidth = frameWidth;
-            m_cachedHeight = frameHeight;
+        // Get latest camera frame. The previous frame stays valid until a newer one arrives.
+        if (m_camera.AcquireLatestFrame(m_cachedFrame) && m_cachedFrame.pixels) {
             m_hasCachedFrame = true;
-            if (IsBgraFormat(m_quadSwapchain.swapchainFormat)) {
-                SwizzleRgbaToBgra(m_cachedFrame);
-                m_cachedIsBgra = true;
-            } else {
-                m_cachedIsBgra = false;
+            // The camera normally converts to the swapchain's channel order already; only a frame
+            // converted before SetOutputBgra took effect needs swizzling here.
+            const bool wantBgra = IsBgraFormat(m_quadSwapchain.swapchainFormat);
+            if (m_cachedFrame.isBgra != wantBgra) {
+                SwizzleRgbaToBgra(m_cachedFrame.pixels, m_cachedFrame.size);
+                m_cachedFrame.isBgra = wantBgra;
             }
         }
 
         // Render camera frame to quad swapchain
         if (m_hasCachedFrame) {
             auto *graphicsApiVulkan = static_cast<GraphicsAPI_Vulkan *>(m_graphicsAPI.get());
+            m_graphicsAPI->BeginRendering();
             graphicsApiVulkan->UploadRgbaToImageCentered(
                 m_quadSwapchain.imageViews[imageIndex],
                 m_quadSwapchain.width, m_quadSwapchain.height,
-                m_cachedFrame.data(),
-                m_cachedWidth, m_cachedHeight);
+                m_cachedFrame.pixels,
+                m_cachedFrame.width, m_cachedFrame.height);
+            m_graphicsAPI->EndRendering();
             m_uploadCount++;
             if (m_uploadCount <= 3 || m_uploadCount % 100 == 0) {
                 XR_TUT_LOG("Vulkan: Upload #" << m_uploadCount
-                    << " src=" << m_cachedWidth << "x" << m_cachedHeight
+                    << " src=" << m_cachedFrame.width << "x" << m_cachedFrame.height
                     << " dst=" << m_quadSwapchain.width << "x" << m_quadSwapchain.height
                     << " format=" << m_quadSwapchain.swapchainFormat);
             }
@@ -1160,11 +1087,8 @@ private:
     uint32_t m_renderHeight = 0;
 
     Camera2Capture m_camera;
-    std::vector<uint8_t> m_cachedFrame;
-    uint32_t m_cachedWidth = 0;
-    uint32_t m_cachedHeight = 0;
+    FrameTripleBuffer::Frame m_cachedFrame;  // front slot of the camera's triple buffer
     bool m_hasCachedFrame = false;
-    bool m_cachedIsBgra = false;
     uint64_t m_uploadCount = 0;
     uint64_t m_clearCount = 0;
 };
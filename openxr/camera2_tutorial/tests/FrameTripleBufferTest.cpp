@@ -0,0 +1,101 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Camera2 Tutorial: stress test for the FrameTripleBuffer producer/consumer handoff.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "FrameTripleBuffer.h"
+
+// Every byte of frame n holds the low byte of n, and its first 8 bytes hold n itself, so a frame
+// the producer overwrote while the consumer held it shows up as a mismatch.
+static bool FrameIsIntact(const FrameTripleBuffer::Frame &frame) {
+    uint64_t stored = 0;
+    std::memcpy(&stored, frame.pixels, sizeof(stored));
+    if (stored != frame.sequence || frame.width * frame.height * 4 != frame.size) {
+        return false;
+    }
+    const uint8_t expected = static_cast<uint8_t>(frame.sequence);
+    for (size_t i = sizeof(stored); i < frame.size; ++i) {
+        if (frame.pixels[i] != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const uint64_t frameCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    FrameTripleBuffer buffer;
+    std::atomic<bool> producerDone = {false};
+
+    std::thread producer([&] {
+        for (uint64_t n = 1; n <= frameCount; ++n) {
+            // sizes change from frame to frame, as they do when the quad is resized
+            const uint32_t width = 4 + static_cast<uint32_t>(n % 13);
+            const uint32_t height = 4 + static_cast<uint32_t>(n % 7);
+            const size_t size = static_cast<size_t>(width) * height * 4;
+            uint8_t *pixels = buffer.BeginWrite(size);
+            std::memset(pixels, static_cast<uint8_t>(n), size);
+            std::memcpy(pixels, &n, sizeof(n));
+            buffer.EndWrite(width, height, (n & 1) != 0);
+            if (n % 16 == 0) {
+                // lets the threads interleave finely even on a single core
+                std::this_thread::yield();
+            }
+        }
+        producerDone = true;
+    });
+
+    uint64_t lastSequence = 0;
+    uint64_t acquired = 0;
+    int failures = 0;
+    FrameTripleBuffer::Frame frame;
+    while (true) {
+        const bool done = producerDone.load();
+        if (buffer.AcquireLatest(frame)) {
+            acquired++;
+            if (frame.sequence <= lastSequence) {
+                std::printf("FAIL frame %llu acquired after frame %llu\n", static_cast<unsigned long long>(frame.sequence), static_cast<unsigned long long>(lastSequence));
+                failures++;
+            }
+            lastSequence = frame.sequence;
+            if (frame.isBgra != ((frame.sequence & 1) != 0) || !FrameIsIntact(frame)) {
+                std::printf("FAIL frame %llu is torn\n", static_cast<unsigned long long>(frame.sequence));
+                failures++;
+            }
+            // hold the frame while the producer keeps publishing; it must not change under us
+            std::this_thread::yield();
+            if (!FrameIsIntact(frame)) {
+                std::printf("FAIL frame %llu changed while the consumer held it\n", static_cast<unsigned long long>(frame.sequence));
+                failures++;
+            }
+        } else if (done) {
+            break;
+        }
+        if (failures > 10) {
+            break;
+        }
+    }
+    producer.join();
+
+    if (failures == 0 && lastSequence != frameCount) {
+        std::printf("FAIL last frame acquired was %llu, not %llu\n", static_cast<unsigned long long>(lastSequence), static_cast<unsigned long long>(frameCount));
+        failures++;
+    }
+    if (buffer.GetPublishedCount() != frameCount) {
+        std::printf("FAIL published count is %llu, not %llu\n", static_cast<unsigned long long>(buffer.GetPublishedCount()), static_cast<unsigned long long>(frameCount));
+        failures++;
+    }
+    std::printf("%llu frames published, %llu acquired\n", static_cast<unsigned long long>(frameCount), static_cast<unsigned long long>(acquired));
+    if (failures != 0) {
+        return 1;
+    }
+    std::printf("all passed\n");
+    return 0;
+}
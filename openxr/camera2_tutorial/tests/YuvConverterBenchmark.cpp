@@ -0,0 +1,43 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Camera2 Tutorial: times YuvConverter against the per-pixel reference conversion on a
+// 1280x1280 camera frame resampled to the default quad size.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "YuvConverter.h"
+#include "YuvReference.h"
+
+template <typename Convert>
+static double MillisecondsPerFrame(int frames, Convert &&convert) {
+    convert();  // warm up caches and tables
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        convert();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 30;
+    const uint32_t outputWidth = 1680;
+    const uint32_t outputHeight = 1760;
+    std::vector<uint8_t> pixels(static_cast<size_t>(outputWidth) * outputHeight * 4);
+
+    const TestYuvImage::Layout layouts[] = {TestYuvImage::Planar, TestYuvImage::NV12};
+    for (const TestYuvImage::Layout layout : layouts) {
+        const TestYuvImage test(1280, 1280, layout, 7);
+        YuvConverter converter;
+        const double reference = MillisecondsPerFrame(frames, [&] { ConvertYuvReference(test.image, outputWidth, outputHeight, false, pixels.data()); });
+        const double converted = MillisecondsPerFrame(frames, [&] { converter.Convert(test.image, outputWidth, outputHeight, false, pixels.data()); });
+        std::printf("%s 1280x1280 -> %ux%u: per-pixel %.2f ms, YuvConverter %.2f ms (%.1fx)\n", layout == TestYuvImage::Planar ? "planar" : "NV12", outputWidth, outputHeight, reference, converted,
+                    reference / converted);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Camera2 Tutorial: checks YuvConverter against the per-pixel reference conversion.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "YuvConverter.h"
+#include "YuvReference.h"
+
+static int s_failures = 0;
+
+static const char *LayoutName(TestYuvImage::Layout layout) {
+    switch (layout) {
+        case TestYuvImage::Planar: return "planar";
+        case TestYuvImage::NV12: return "NV12";
+        case TestYuvImage::NV21: return "NV21";
+        case TestYuvImage::Aliased: return "aliased";
+    }
+    return "?";
+}
+
+// The converter must match the reference bit for bit, whichever path it was built with.
+static void CheckMatchesReference(YuvConverter &converter, const YuvImage &image, uint32_t outputWidth, uint32_t outputHeight, bool bgra, const char *what) {
+    const size_t size = static_cast<size_t>(outputWidth) * outputHeight * 4;
+    std::vector<uint8_t> expected(size);
+    std::vector<uint8_t> actual(size, 0xCD);
+    ConvertYuvReference(image, outputWidth, outputHeight, bgra, expected.data());
+    converter.Convert(image, outputWidth, outputHeight, bgra, actual.data());
+    const auto mismatch = std::mismatch(expected.begin(), expected.end(), actual.begin());
+    if (mismatch.first != expected.end()) {
+        const size_t index = static_cast<size_t>(mismatch.first - expected.begin());
+        std::printf("FAIL %s %ux%u -> %ux%u %s: byte %zu of pixel (%zu, %zu) is %d, expected %d\n", what, image.width, image.height, outputWidth, outputHeight, bgra ? "BGRA" : "RGBA", index % 4,
+                    (index / 4) % outputWidth, (index / 4) / outputWidth, *mismatch.second, *mismatch.first);
+        s_failures++;
+    }
+}
+
+// The fixed-point math must stay within 1 LSB of the floating point BT.601 conversion.
+static void CheckAgainstFloat() {
+    int maxError = 0;
+    for (int y = 0; y < 256; y += 3) {
+        for (int u = 0; u < 256; u += 5) {
+            for (int v = 0; v < 256; v += 7) {
+                uint8_t luma[1] = {static_cast<uint8_t>(y)};
+                uint8_t chroma[2] = {static_cast<uint8_t>(u), static_cast<uint8_t>(v)};
+                YuvImage image;
+                image.width = 1;
+                image.height = 1;
+                image.planes[0] = luma;
+                image.planeLength[0] = 1;
+                image.rowStride[0] = 1;
+                image.pixelStride[0] = 1;
+                image.planes[1] = chroma;
+                image.planes[2] = chroma + 1;
+                image.planeLength[1] = image.planeLength[2] = 1;
+                image.rowStride[1] = image.rowStride[2] = 1;
+                image.pixelStride[1] = image.pixelStride[2] = 1;
+                uint8_t pixel[4];
+                YuvConverter converter;
+                converter.Convert(image, 1, 1, false, pixel);
+
+                const float uc = static_cast<float>(u - 128);
+                const float vc = static_cast<float>(v - 128);
+                const float expected[3] = {y + 1.402f * vc, y - 0.344136f * uc - 0.714136f * vc, y + 1.772f * uc};
+                for (int c = 0; c < 3; ++c) {
+                    const int rounded = static_cast<int>(std::lround(std::clamp(expected[c], 0.0f, 255.0f)));
+                    maxError = std::max(maxError, std::abs(pixel[c] - rounded));
+                }
+            }
+        }
+    }
+    if (maxError > 1) {
+        std::printf("FAIL fixed-point conversion is off by up to %d from BT.601\n", maxError);
+        s_failures++;
+    }
+}
+
+int main() {
+#if defined(XR_TUT_YUV_NEON)
+    std::printf("YuvConverter: NEON path\n");
+#elif defined(XR_TUT_YUV_SSE2)
+    std::printf("YuvConverter: SSE2 path\n");
+#else
+    std::printf("YuvConverter: scalar path\n");
+#endif
+
+    struct Size {
+        uint32_t width;
+        uint32_t height;
+    };
+    // odd sizes exercise the SIMD tails and the rounding of the chroma coordinates
+    const Size sources[] = {{64, 48}, {61, 37}, {640, 480}, {1280, 720}};
+    const Size outputs[] = {{64, 48}, {61, 37}, {7, 5}, {200, 300}, {1680, 1760}};
+    const TestYuvImage::Layout layouts[] = {TestYuvImage::Planar, TestYuvImage::NV12, TestYuvImage::NV21, TestYuvImage::Aliased};
+
+    uint32_t seed = 1;
+    for (const TestYuvImage::Layout layout : layouts) {
+        // one converter per layout, so the tables are reused and rebuilt as the sizes change
+        YuvConverter converter;
+        for (const Size &source : sources) {
+            const TestYuvImage test(source.width, source.height, layout, seed++);
+            for (const Size &output : outputs) {
+                CheckMatchesReference(converter, test.image, output.width, output.height, false, LayoutName(layout));
+                CheckMatchesReference(converter, test.image, output.width, output.height, true, LayoutName(layout));
+            }
+        }
+    }
+
+    // planes shorter than the image must give black luma and neutral chroma where they end
+    {
+        TestYuvImage test(128, 96, TestYuvImage::NV12, seed++);
+        test.image.planeLength[0] /= 3;
+        test.image.planeLength[1] /= 2;
+        test.image.planeLength[2] /= 2;
+        YuvConverter converter;
+        CheckMatchesReference(converter, test.image, 128, 96, false, "truncated");
+        CheckMatchesReference(converter, test.image, 333, 77, true, "truncated");
+    }
+
+    CheckAgainstFloat();
+
+    if (s_failures != 0) {
+        std::printf("%d failure(s)\n", s_failures);
+        return 1;
+    }
+    std::printf("all passed\n");
+    return 0;
+}
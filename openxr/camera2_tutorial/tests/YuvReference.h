@@ -0,0 +1,122 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Camera2 Tutorial: straightforward per-pixel YUV_420_888 conversion used as the reference
+// for the YuvConverter tests and benchmark.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "YuvConverter.h"
+
+// Fills a synthetic YUV_420_888 image of the given chroma layout with pseudo-random samples.
+struct TestYuvImage {
+    enum Layout { Planar, NV12, NV21, Aliased };
+
+    TestYuvImage(uint32_t width, uint32_t height, Layout layout, uint32_t seed) {
+        const uint32_t chromaWidth = (width + 1) / 2;
+        const uint32_t chromaHeight = (height + 1) / 2;
+        // padded rows, as camera HALs usually report
+        const int lumaStride = static_cast<int>(width + 16);
+        const int planarStride = static_cast<int>(chromaWidth + 8);
+        const int interleavedStride = static_cast<int>(chromaWidth * 2 + 16);
+
+        luma.resize(static_cast<size_t>(lumaStride) * height);
+        if (layout == Planar) {
+            chroma.resize(static_cast<size_t>(planarStride) * chromaHeight * 2);
+        } else {
+            chroma.resize(static_cast<size_t>(interleavedStride) * chromaHeight);
+        }
+        uint32_t state = seed * 2654435761u + 1;
+        for (uint8_t &c : luma) {
+            state = state * 1664525u + 1013904223u;
+            c = static_cast<uint8_t>(state >> 24);
+        }
+        for (uint8_t &c : chroma) {
+            state = state * 1664525u + 1013904223u;
+            c = static_cast<uint8_t>(state >> 24);
+        }
+
+        image.width = width;
+        image.height = height;
+        image.planes[0] = luma.data();
+        image.planeLength[0] = static_cast<int>(luma.size());
+        image.rowStride[0] = lumaStride;
+        image.pixelStride[0] = 1;
+        const int chromaLength = static_cast<int>(chroma.size());
+        switch (layout) {
+            case Planar: {
+                const int planeSize = planarStride * static_cast<int>(chromaHeight);
+                SetChroma(1, chroma.data(), planeSize, planarStride, 1);
+                SetChroma(2, chroma.data() + planeSize, planeSize, planarStride, 1);
+                break;
+            }
+            case NV12:
+                SetChroma(1, chroma.data(), chromaLength - 1, interleavedStride, 2);
+                SetChroma(2, chroma.data() + 1, chromaLength - 1, interleavedStride, 2);
+                break;
+            case NV21:
+                SetChroma(2, chroma.data(), chromaLength - 1, interleavedStride, 2);
+                SetChroma(1, chroma.data() + 1, chromaLength - 1, interleavedStride, 2);
+                break;
+            case Aliased:
+                // some devices report both chroma planes with the same pointer
+                SetChroma(1, chroma.data(), chromaLength, interleavedStride, 2);
+                SetChroma(2, chroma.data(), chromaLength, interleavedStride, 2);
+                break;
+        }
+    }
+
+    void SetChroma(int plane, const uint8_t *data, int length, int rowStride, int pixelStride) {
+        image.planes[plane] = data;
+        image.planeLength[plane] = length;
+        image.rowStride[plane] = rowStride;
+        image.pixelStride[plane] = pixelStride;
+    }
+
+    std::vector<uint8_t> luma;
+    std::vector<uint8_t> chroma;
+    YuvImage image;
+};
+
+// The conversion loop Camera2Capture used before the table-driven converter, with the converter's
+// fixed-point math and out-of-range handling: every output pixel computes its source coordinates
+// and checks its bounds on its own.
+inline void ConvertYuvReference(const YuvImage &image, uint32_t outputWidth, uint32_t outputHeight, bool bgra, uint8_t *outPixels) {
+    const uint8_t *vPlane = image.planes[2];
+    int vLength = image.planeLength[2];
+    if (image.planes[1] == image.planes[2]) {
+        vPlane = image.planes[1] + 1;
+        vLength = image.planeLength[1] - 1;
+    }
+    auto sample = [](const uint8_t *plane, int length, int rowStride, size_t row, size_t offset, uint8_t fill) {
+        if (offset >= static_cast<size_t>(rowStride)) {
+            return fill;
+        }
+        const size_t index = row * static_cast<size_t>(rowStride) + offset;
+        return index < static_cast<size_t>(length) ? plane[index] : fill;
+    };
+    auto clampByte = [](int value) {
+        return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    };
+
+    for (uint32_t y = 0; y < outputHeight; ++y) {
+        const size_t srcY = static_cast<size_t>(static_cast<uint64_t>(y) * image.height / outputHeight);
+        for (uint32_t x = 0; x < outputWidth; ++x) {
+            const size_t srcX = static_cast<size_t>(static_cast<uint64_t>(x) * image.width / outputWidth);
+            const int yl = sample(image.planes[0], image.planeLength[0], image.rowStride[0], srcY, srcX * image.pixelStride[0], 0);
+            const int uc = sample(image.planes[1], image.planeLength[1], image.rowStride[1], srcY / 2, (srcX / 2) * image.pixelStride[1], 128) - 128;
+            const int vc = sample(vPlane, vLength, image.rowStride[2], srcY / 2, (srcX / 2) * image.pixelStride[2], 128) - 128;
+            uint8_t *pixel = outPixels + (static_cast<size_t>(y) * outputWidth + x) * 4;
+            pixel[bgra ? 2 : 0] = clampByte(yl + ((vc * 179 + 64) >> 7));
+            pixel[1] = clampByte(yl - ((uc * 44 + vc * 91 + 64) >> 7));
+            pixel[bgra ? 0 : 2] = clampByte(yl + ((uc * 227 + 64) >> 7));
+            pixel[3] = 255;
+        }
+    }
+}
@@ -4,10 +4,12 @@
 
 #pragma once
 
+// Also the layout of one instance in the cube instance buffers: orientation, position and scale, tightly packed.
 struct Cube {
     XrPosef Pose;
     XrVector3f Scale;
 };
+static_assert(sizeof(Cube) == 40, "Unexpected Cube size");
 
 // Wraps a graphics API so the main openxr program can be graphics API-independent.
 struct IGraphicsPlugin {
@@ -30,10 +32,26 @@ struct IGraphicsPlugin {
     virtual std::vector<XrSwapchainImageBaseHeader*> AllocateSwapchainImageStructs(
         uint32_t capacity, const XrSwapchainCreateInfo& swapchainCreateInfo) = 0;
 
-    // Render to a swapchain image for a projection view.
+    // Write the cubes of the frame about to be rendered into an instance buffer. Called once per frame, before RenderView
+    // is called for each of its views. Plugins that keep this default draw the cubes passed to RenderView one at a time.
+    virtual void UpdateCubeInstances(const std::vector<Cube>& /*cubes*/) {}
+
+    // Render to a swapchain image for a projection view. Plugins that implement UpdateCubeInstances draw the cubes last
+    // passed to it with a single instanced draw instead.
     virtual void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* swapchainImage,
                             int64_t swapchainFormat, const std::vector<Cube>& cubes) = 0;
 
+    // Whether RenderMultiView is implemented. Queried after InitializeDevice, as it can depend on device features.
+    virtual bool SupportsMultiView() const { return false; }
+
+    // Render all views of a frame in a single pass into one image of an array swapchain, with layerViews[i] going to array
+    // slice i. The swapchain was created with one array layer per view.
+    virtual void RenderMultiView(const std::vector<XrCompositionLayerProjectionView>& /*layerViews*/,
+                                 const XrSwapchainImageBaseHeader* /*swapchainImage*/, int64_t /*swapchainFormat*/,
+                                 const std::vector<Cube>& /*cubes*/) {
+        THROW("Multiview rendering is not supported by this graphics plugin");
+    }
+
     // Get recommended number of sub-data element samples in view (recommendedSwapchainSampleCount)
     // if supported by the graphics plugin. A supported value otherwise.
     virtual uint32_t GetSupportedSwapchainSampleCount(const XrViewConfigurationView& view) {
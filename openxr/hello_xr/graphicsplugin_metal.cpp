@@ -266,15 +266,11 @@ struct MetalGraphicsPlugin : public IGraphicsPlugin {
                 NS::TransferPtr(m_device->newBuffer(matricesBufferLength, MTL::ResourceStorageModeManaged));
         }
 
-        auto matricesBufferData = (simd::float4x4*)swapchainContext.m_cubeMatricesBuffer->contents();
-        for (auto i = 0; i < cubes.size(); ++i) {
-            auto& cube = cubes[i];
-            // Compute and update the model transform.
-            XrMatrix4x4f model;
-            XrMatrix4x4f_CreateTranslationRotationScale(&model, &cube.Pose.position, &cube.Pose.orientation, &cube.Scale);
-            XrMatrix4x4f mvp;
-            XrMatrix4x4f_Multiply(&mvp, &vp, &model);
-            memcpy(&matricesBufferData[i], &mvp, sizeof(simd::float4x4));
+        // Compute every cube's model-view-projection transform straight into the buffer.
+        if (!cubes.empty()) {
+            auto matricesBufferData = (XrMatrix4x4f*)swapchainContext.m_cubeMatricesBuffer->contents();
+            XrMatrix4x4f_CreateModelViewProjectionArray(matricesBufferData, &vp, &cubes[0].Pose, sizeof(Cube), &cubes[0].Scale,
+                                                        sizeof(Cube), cubes.size());
         }
         swapchainContext.m_cubeMatricesBuffer->didModifyRange(NS::Range::Make(0, swapchainContext.m_cubeMatricesBuffer->length()));
 
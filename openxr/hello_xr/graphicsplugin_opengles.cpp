@@ -20,13 +20,20 @@ static const char* VertexShaderGlsl = R"_(#version 320 es
 
     in vec3 VertexPos;
     in vec3 VertexColor;
+    in vec4 InstanceOrientation;
+    in vec3 InstancePosition;
+    in vec3 InstanceScale;
 
     out vec3 PSVertexColor;
 
-    uniform mat4 ModelViewProjection;
+    uniform mat4 ViewProjection;
 
     void main() {
-       gl_Position = ModelViewProjection * vec4(VertexPos, 1.0);
+       // Scale, rotate by the instance's orientation quaternion, then translate.
+       vec3 pos = VertexPos * InstanceScale;
+       vec3 t = 2.0 * cross(InstanceOrientation.xyz, pos);
+       pos += InstanceOrientation.w * t + cross(InstanceOrientation.xyz, t);
+       gl_Position = ViewProjection * vec4(pos + InstancePosition, 1.0);
        PSVertexColor = VertexColor;
     }
     )_";
@@ -67,6 +74,9 @@ struct OpenGLESGraphicsPlugin : public IGraphicsPlugin {
         if (m_cubeIndexBuffer != 0) {
             glDeleteBuffers(1, &m_cubeIndexBuffer);
         }
+        if (m_cubeInstanceBuffer != 0) {
+            glDeleteBuffers(1, &m_cubeInstanceBuffer);
+        }
 
         for (auto& colorToDepth : m_colorToDepthMap) {
             if (colorToDepth.second != 0) {
@@ -159,10 +169,13 @@ struct OpenGLESGraphicsPlugin : public IGraphicsPlugin {
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
 
-        m_modelViewProjectionUniformLocation = glGetUniformLocation(m_program, "ModelViewProjection");
+        m_viewProjectionUniformLocation = glGetUniformLocation(m_program, "ViewProjection");
 
         m_vertexAttribCoords = glGetAttribLocation(m_program, "VertexPos");
         m_vertexAttribColor = glGetAttribLocation(m_program, "VertexColor");
+        m_instanceAttribOrientation = glGetAttribLocation(m_program, "InstanceOrientation");
+        m_instanceAttribPosition = glGetAttribLocation(m_program, "InstancePosition");
+        m_instanceAttribScale = glGetAttribLocation(m_program, "InstanceScale");
 
         glGenBuffers(1, &m_cubeVertexBuffer);
         glBindBuffer(GL_ARRAY_BUFFER, m_cubeVertexBuffer);
@@ -181,6 +194,23 @@ struct OpenGLESGraphicsPlugin : public IGraphicsPlugin {
         glVertexAttribPointer(m_vertexAttribCoords, 3, GL_FLOAT, GL_FALSE, sizeof(Geometry::Vertex), nullptr);
         glVertexAttribPointer(m_vertexAttribColor, 3, GL_FLOAT, GL_FALSE, sizeof(Geometry::Vertex),
                               reinterpret_cast<const void*>(sizeof(XrVector3f)));
+
+        // Each cube is one instance; the buffer is filled by UpdateCubeInstances.
+        glGenBuffers(1, &m_cubeInstanceBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, m_cubeInstanceBuffer);
+        glEnableVertexAttribArray(m_instanceAttribOrientation);
+        glEnableVertexAttribArray(m_instanceAttribPosition);
+        glEnableVertexAttribArray(m_instanceAttribScale);
+        glVertexAttribPointer(m_instanceAttribOrientation, 4, GL_FLOAT, GL_FALSE, sizeof(Cube),
+                              reinterpret_cast<const void*>(offsetof(Cube, Pose) + offsetof(XrPosef, orientation)));
+        glVertexAttribPointer(m_instanceAttribPosition, 3, GL_FLOAT, GL_FALSE, sizeof(Cube),
+                              reinterpret_cast<const void*>(offsetof(Cube, Pose) + offsetof(XrPosef, position)));
+        glVertexAttribPointer(m_instanceAttribScale, 3, GL_FLOAT, GL_FALSE, sizeof(Cube),
+                              reinterpret_cast<const void*>(offsetof(Cube, Scale)));
+        glVertexAttribDivisor(m_instanceAttribOrientation, 1);
+        glVertexAttribDivisor(m_instanceAttribPosition, 1);
+        glVertexAttribDivisor(m_instanceAttribScale, 1);
+        glBindVertexArray(0);
     }
 
     void CheckShader(GLuint shader) {
@@ -273,8 +303,23 @@ struct OpenGLESGraphicsPlugin : public IGraphicsPlugin {
         return depthTexture;
     }
 
+    void UpdateCubeInstances(const std::vector<Cube>& cubes) override {
+        m_cubeInstanceCount = static_cast<GLsizei>(cubes.size());
+        if (cubes.empty()) {
+            return;
+        }
+
+        // Re-specifying the whole store lets the driver hand out fresh memory instead of waiting for the views of the
+        // previous frame to finish reading the old contents.
+        glBindBuffer(GL_ARRAY_BUFFER, m_cubeInstanceBuffer);
+        m_cubeInstanceCapacity = std::max(m_cubeInstanceCapacity, cubes.size());
+        glBufferData(GL_ARRAY_BUFFER, m_cubeInstanceCapacity * sizeof(Cube), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, cubes.size() * sizeof(Cube), cubes.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
     void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* swapchainImage,
-                    int64_t swapchainFormat, const std::vector<Cube>& cubes) override {
+                    int64_t swapchainFormat, const std::vector<Cube>& /*cubes*/) override {
         CHECK(layerView.subImage.imageArrayIndex == 0);  // Texture arrays not supported.
         UNUSED_PARM(swapchainFormat);                    // Not used in this function for now.
 
@@ -315,20 +360,15 @@ struct OpenGLESGraphicsPlugin : public IGraphicsPlugin {
         XrMatrix4x4f vp;
         XrMatrix4x4f_Multiply(&vp, &proj, &view);
 
-        // Set cube primitive data.
+        glUniformMatrix4fv(m_viewProjectionUniformLocation, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&vp));
+
+        // Set cube primitive and instance data.
         glBindVertexArray(m_vao);
 
-        // Render each cube
-        for (const Cube& cube : cubes) {
-            // Compute the model-view-projection transform and set it..
-            XrMatrix4x4f model;
-            XrMatrix4x4f_CreateTranslationRotationScale(&model, &cube.Pose.position, &cube.Pose.orientation, &cube.Scale);
-            XrMatrix4x4f mvp;
-            XrMatrix4x4f_Multiply(&mvp, &vp, &model);
-            glUniformMatrix4fv(m_modelViewProjectionUniformLocation, 1, GL_FALSE, reinterpret_cast<const GLfloat*>(&mvp));
-
-            // Draw the cube.
-            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(ArraySize(Geometry::c_cubeIndices)), GL_UNSIGNED_SHORT, nullptr);
+        // Draw all cubes at once; the vertex shader applies each instance's pose and scale.
+        if (m_cubeInstanceCount > 0) {
+            glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(ArraySize(Geometry::c_cubeIndices)), GL_UNSIGNED_SHORT,
+                                    nullptr, m_cubeInstanceCount);
         }
 
         glBindVertexArray(0);
@@ -348,12 +388,18 @@ struct OpenGLESGraphicsPlugin : public IGraphicsPlugin {
     std::list<std::vector<XrSwapchainImageOpenGLESKHR>> m_swapchainImageBuffers;
     GLuint m_swapchainFramebuffer{0};
     GLuint m_program{0};
-    GLint m_modelViewProjectionUniformLocation{0};
+    GLint m_viewProjectionUniformLocation{0};
     GLint m_vertexAttribCoords{0};
     GLint m_vertexAttribColor{0};
+    GLint m_instanceAttribOrientation{0};
+    GLint m_instanceAttribPosition{0};
+    GLint m_instanceAttribScale{0};
     GLuint m_vao{0};
     GLuint m_cubeVertexBuffer{0};
     GLuint m_cubeIndexBuffer{0};
+    GLuint m_cubeInstanceBuffer{0};
+    size_t m_cubeInstanceCapacity{0};
+    GLsizei m_cubeInstanceCount{0};
     GLint m_contextApiMajorVersion{0};
 
     // Map color buffer to associated depth buffer. This map is populated on demand.
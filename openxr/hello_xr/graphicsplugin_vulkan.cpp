@@ -6,11 +6,14 @@
 #include "common.h"
 #include "geometry.h"
 #include "graphicsplugin.h"
+#include "memory_ranges.h"
 #include "options.h"
 
 #ifdef XR_USE_GRAPHICS_API_VULKAN
 #include <common/vulkan_debug_object_namer.hpp>
 #include <common/xr_linear.h>
+#include <chrono>
+#include <fstream>
 
 #ifdef USE_ONLINE_VULKAN_SHADERC
 #include <shaderc/shaderc.hpp>
@@ -107,11 +110,14 @@ constexpr char VertexShaderGlsl[] =
 
     layout (std140, push_constant) uniform buf
     {
-        mat4 mvp;
+        mat4 viewProj;
     } ubuf;
 
     layout (location = 0) in vec3 Position;
     layout (location = 1) in vec3 Color;
+    layout (location = 2) in vec4 InstanceOrientation;
+    layout (location = 3) in vec3 InstancePosition;
+    layout (location = 4) in vec3 InstanceScale;
 
     layout (location = 0) out vec4 oColor;
     out gl_PerVertex
@@ -121,8 +127,49 @@ constexpr char VertexShaderGlsl[] =
 
     void main()
     {
-        oColor.rgba  = Color.rgba;
-        gl_Position = ubuf.mvp * Position;
+        oColor.rgb  = Color.rgb;
+        oColor.a  = 1.0;
+        // Scale, rotate by the instance's orientation quaternion, then translate.
+        vec3 pos = Position * InstanceScale;
+        vec3 t = 2.0 * cross(InstanceOrientation.xyz, pos);
+        pos += InstanceOrientation.w * t + cross(InstanceOrientation.xyz, t);
+        gl_Position = ubuf.viewProj * vec4(pos + InstancePosition, 1);
+    }
+)_";
+
+// Same as VertexShaderGlsl, but renders every view in one pass, picking the view's matrix by gl_ViewIndex.
+constexpr char MultiViewVertexShaderGlsl[] =
+    R"_(
+    #version 430
+    #extension GL_ARB_separate_shader_objects : enable
+    #extension GL_EXT_multiview : enable
+
+    layout (std140, push_constant) uniform buf
+    {
+        mat4 viewProj[2];
+    } ubuf;
+
+    layout (location = 0) in vec3 Position;
+    layout (location = 1) in vec3 Color;
+    layout (location = 2) in vec4 InstanceOrientation;
+    layout (location = 3) in vec3 InstancePosition;
+    layout (location = 4) in vec3 InstanceScale;
+
+    layout (location = 0) out vec4 oColor;
+    out gl_PerVertex
+    {
+        vec4 gl_Position;
+    };
+
+    void main()
+    {
+        oColor.rgb  = Color.rgb;
+        oColor.a  = 1.0;
+        // Scale, rotate by the instance's orientation quaternion, then translate.
+        vec3 pos = Position * InstanceScale;
+        vec3 t = 2.0 * cross(InstanceOrientation.xyz, pos);
+        pos += InstanceOrientation.w * t + cross(InstanceOrientation.xyz, t);
+        gl_Position = ubuf.viewProj[gl_ViewIndex] * vec4(pos + InstancePosition, 1);
     }
 )_";
 
@@ -142,35 +189,237 @@ constexpr char FragmentShaderGlsl[] =
 )_";
 #endif  // USE_ONLINE_VULKAN_SHADERC
 
+// A range of device memory handed out by MemoryAllocator. Host-visible memory stays mapped for as long as it is allocated,
+// so mapped points at offset and resources write through it instead of calling vkMapMemory themselves.
+struct MemoryAllocation {
+    VkDeviceMemory memory{VK_NULL_HANDLE};
+    VkDeviceSize offset{0};
+    VkDeviceSize size{0};
+    void* mapped{nullptr};
+    uint32_t pool{0};
+    bool dedicated{false};
+};
+
+struct MemoryStats {
+    uint32_t blockCount{0};
+    uint32_t dedicatedCount{0};
+    uint32_t allocationCount{0};
+    VkDeviceSize usedBytes{0};
+    VkDeviceSize freeBytes{0};
+    VkDeviceSize largestFreeRange{0};
+
+    // 0 when all free memory is one contiguous range, approaching 1 as it splits into many small ones.
+    float Fragmentation() const { return freeBytes == 0 ? 0.0f : 1.0f - (float)largestFreeRange / (float)freeBytes; }
+};
+
+// Sub-allocates resources from large VkDeviceMemory blocks, so the number of vkAllocateMemory calls grows with the
+// amount of memory in use rather than with the number of resources. Each memory type has its own pool of blocks, and so
+// does each kind of resource when bufferImageGranularity is above 1, which keeps linear (buffer) and optimal (image)
+// resources from sharing a granularity page without having to pad every allocation. Large images get memory of their own.
 struct MemoryAllocator {
+    MemoryAllocator() = default;
+
+    ~MemoryAllocator() {
+        if (m_vkDevice != nullptr) {
+            for (auto& pool : m_pools) {
+                for (auto& block : pool.blocks) {
+                    vkFreeMemory(m_vkDevice, block.memory, nullptr);
+                }
+            }
+            for (const auto& dedicated : m_dedicated) {
+                vkFreeMemory(m_vkDevice, dedicated.first, nullptr);
+            }
+        }
+        m_pools.clear();
+        m_dedicated.clear();
+        m_vkDevice = nullptr;
+    }
+
+    MemoryAllocator(const MemoryAllocator&) = delete;
+    MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+    MemoryAllocator(MemoryAllocator&&) = delete;
+    MemoryAllocator& operator=(MemoryAllocator&&) = delete;
+
     void Init(VkPhysicalDevice physicalDevice, VkDevice device) {
         m_vkDevice = device;
         vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memProps);
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(physicalDevice, &props);
+        m_bufferImageGranularity = props.limits.bufferImageGranularity;
+        m_pools.resize(m_memProps.memoryTypeCount * (m_bufferImageGranularity > 1 ? 2 : 1));
     }
 
     static const VkFlags defaultFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 
-    void Allocate(VkMemoryRequirements const& memReqs, VkDeviceMemory* mem, VkFlags flags = defaultFlags,
-                  const void* pNext = nullptr) const {
-        // Search memtypes to find first index with those properties
-        for (uint32_t i = 0; i < m_memProps.memoryTypeCount; ++i) {
-            if ((memReqs.memoryTypeBits & (1 << i)) != 0u) {
-                // Type is available, does it match user properties?
-                if ((m_memProps.memoryTypes[i].propertyFlags & flags) == flags) {
-                    VkMemoryAllocateInfo memAlloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, pNext};
-                    memAlloc.allocationSize = memReqs.size;
-                    memAlloc.memoryTypeIndex = i;
-                    CHECK_VKCMD(vkAllocateMemory(m_vkDevice, &memAlloc, nullptr, mem));
-                    return;
-                }
+    // Allocates memory with all of the required flags, from the memory type that has the most of the preferred flags and the
+    // fewest others. linear is true for buffers and linearly tiled images, false for optimally tiled images.
+    void Allocate(VkMemoryRequirements const& memReqs, bool linear, MemoryAllocation* allocation, VkFlags flags = defaultFlags,
+                  VkFlags preferredFlags = 0) {
+        const uint32_t memoryType = FindMemoryType(memReqs.memoryTypeBits, flags, preferredFlags);
+        const VkDeviceSize blockSize = BlockSize(memoryType);
+
+        *allocation = {};
+        allocation->size = memReqs.size;
+        allocation->pool = memoryType * (m_bufferImageGranularity > 1 ? 2 : 1) + (linear || m_bufferImageGranularity <= 1 ? 0 : 1);
+
+        if (memReqs.size > blockSize / 2 || (!linear && memReqs.size >= blockSize / DedicatedImageFraction)) {
+            allocation->dedicated = true;
+            allocation->memory = AllocateDeviceMemory(memoryType, memReqs.size, &allocation->mapped);
+            m_dedicated[allocation->memory] = memReqs.size;
+            return;
+        }
+
+        Pool& pool = m_pools[allocation->pool];
+        for (auto& block : pool.blocks) {
+            if (SubAllocate(block, memReqs, allocation)) {
+                return;
             }
         }
-        THROW("Memory format not supported");
+
+        pool.blocks.emplace_back();
+        Block& block = pool.blocks.back();
+        block.memory = AllocateDeviceMemory(memoryType, blockSize, &block.mapped);
+        block.size = blockSize;
+        block.freeRanges = FreeRanges(blockSize);
+        CHECK(SubAllocate(block, memReqs, allocation));
+    }
+
+    void Free(MemoryAllocation* allocation) {
+        if (allocation->memory == VK_NULL_HANDLE) {
+            return;
+        }
+        if (allocation->dedicated) {
+            vkFreeMemory(m_vkDevice, allocation->memory, nullptr);
+            m_dedicated.erase(allocation->memory);
+            *allocation = {};
+            return;
+        }
+
+        Pool& pool = m_pools[allocation->pool];
+        auto blockIt = std::find_if(pool.blocks.begin(), pool.blocks.end(),
+                                    [&](const Block& block) { return block.memory == allocation->memory; });
+        CHECK(blockIt != pool.blocks.end());
+        Block& block = *blockIt;
+
+        block.freeRanges.Free(allocation->offset, allocation->size);
+        block.allocationCount--;
+
+        // Keep one empty block per pool around, so a resource that is recreated doesn't free and reallocate a whole block.
+        if (block.allocationCount == 0 &&
+            std::count_if(pool.blocks.begin(), pool.blocks.end(), [](const Block& b) { return b.allocationCount == 0; }) > 1) {
+            vkFreeMemory(m_vkDevice, block.memory, nullptr);
+            pool.blocks.erase(blockIt);
+        }
+        *allocation = {};
+    }
+
+    MemoryStats GetStats() const {
+        MemoryStats stats;
+        for (const auto& pool : m_pools) {
+            for (const auto& block : pool.blocks) {
+                stats.blockCount++;
+                stats.allocationCount += block.allocationCount;
+                const VkDeviceSize freeBytes = block.freeRanges.FreeBytes();
+                stats.largestFreeRange = std::max(stats.largestFreeRange, (VkDeviceSize)block.freeRanges.LargestFreeRange());
+                stats.freeBytes += freeBytes;
+                stats.usedBytes += block.size - freeBytes;
+            }
+        }
+        for (const auto& dedicated : m_dedicated) {
+            stats.dedicatedCount++;
+            stats.allocationCount++;
+            stats.usedBytes += dedicated.second;
+        }
+        return stats;
+    }
+
+    void LogStats() const {
+        const MemoryStats stats = GetStats();
+        Log::Write(Log::Level::Verbose,
+                   Fmt("Device memory: %u allocations in %u blocks + %u dedicated, %llu KiB used, %llu KiB free, %.0f%% fragmented",
+                       stats.allocationCount, stats.blockCount, stats.dedicatedCount, (unsigned long long)(stats.usedBytes / 1024),
+                       (unsigned long long)(stats.freeBytes / 1024), stats.Fragmentation() * 100.0f));
     }
 
    private:
+    static constexpr VkDeviceSize MaxBlockSize = 64 * 1024 * 1024;
+    // Images at least this fraction of a block get their own memory.
+    static constexpr VkDeviceSize DedicatedImageFraction = 8;
+
+    struct Block {
+        VkDeviceMemory memory{VK_NULL_HANDLE};
+        VkDeviceSize size{0};
+        void* mapped{nullptr};
+        FreeRanges freeRanges;
+        uint32_t allocationCount{0};
+    };
+
+    struct Pool {
+        std::list<Block> blocks;
+    };
+
+    uint32_t FindMemoryType(uint32_t memoryTypeBits, VkFlags flags, VkFlags preferredFlags) const {
+        uint32_t bestType = UINT32_MAX;
+        int bestScore = 0;
+        for (uint32_t i = 0; i < m_memProps.memoryTypeCount; ++i) {
+            const VkFlags typeFlags = m_memProps.memoryTypes[i].propertyFlags;
+            if ((memoryTypeBits & (1 << i)) == 0u || (typeFlags & flags) != flags) {
+                continue;
+            }
+            // Each preferred flag outweighs any number of flags that weren't asked for.
+            int score = 0;
+            for (uint32_t bit = 1; bit != 0; bit <<= 1) {
+                score += (typeFlags & preferredFlags & bit) != 0 ? 32 : 0;
+                score -= (typeFlags & ~(flags | preferredFlags) & bit) != 0 ? 1 : 0;
+            }
+            if (bestType == UINT32_MAX || score > bestScore) {
+                bestType = i;
+                bestScore = score;
+            }
+        }
+        if (bestType == UINT32_MAX) {
+            THROW("Memory format not supported");
+        }
+        return bestType;
+    }
+
+    // Blocks take at most an eighth of their heap, so small heaps aren't used up by a single block.
+    VkDeviceSize BlockSize(uint32_t memoryType) const {
+        const VkDeviceSize heapSize = m_memProps.memoryHeaps[m_memProps.memoryTypes[memoryType].heapIndex].size;
+        return std::min(MaxBlockSize, heapSize / 8);
+    }
+
+    VkDeviceMemory AllocateDeviceMemory(uint32_t memoryType, VkDeviceSize size, void** mapped) const {
+        VkMemoryAllocateInfo memAlloc{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+        memAlloc.allocationSize = size;
+        memAlloc.memoryTypeIndex = memoryType;
+        VkDeviceMemory memory{VK_NULL_HANDLE};
+        CHECK_VKCMD(vkAllocateMemory(m_vkDevice, &memAlloc, nullptr, &memory));
+
+        *mapped = nullptr;
+        if ((m_memProps.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0u) {
+            CHECK_VKCMD(vkMapMemory(m_vkDevice, memory, 0, VK_WHOLE_SIZE, 0, mapped));
+        }
+        return memory;
+    }
+
+    static bool SubAllocate(Block& block, VkMemoryRequirements const& memReqs, MemoryAllocation* allocation) {
+        uint64_t offset = 0;
+        if (!block.freeRanges.Allocate(memReqs.size, memReqs.alignment, &offset)) {
+            return false;
+        }
+        allocation->memory = block.memory;
+        allocation->offset = offset;
+        allocation->mapped = block.mapped != nullptr ? static_cast<uint8_t*>(block.mapped) + offset : nullptr;
+        block.allocationCount++;
+        return true;
+    }
+
     VkDevice m_vkDevice{VK_NULL_HANDLE};
     VkPhysicalDeviceMemoryProperties m_memProps{};
+    VkDeviceSize m_bufferImageGranularity{1};
+    std::vector<Pool> m_pools;
+    std::map<VkDeviceMemory, VkDeviceSize> m_dedicated;
 };
 
 // CmdBuffer - manage VkCommandBuffer state
@@ -403,9 +652,9 @@ struct ShaderProgram {
 // VertexBuffer base class
 struct VertexBufferBase {
     VkBuffer idxBuf{VK_NULL_HANDLE};
-    VkDeviceMemory idxMem{VK_NULL_HANDLE};
+    MemoryAllocation idxMem{};
     VkBuffer vtxBuf{VK_NULL_HANDLE};
-    VkDeviceMemory vtxMem{VK_NULL_HANDLE};
+    MemoryAllocation vtxMem{};
     VkVertexInputBindingDescription bindDesc{};
     std::vector<VkVertexInputAttributeDescription> attrDesc{};
     struct {
@@ -420,20 +669,14 @@ struct VertexBufferBase {
             if (idxBuf != VK_NULL_HANDLE) {
                 vkDestroyBuffer(m_vkDevice, idxBuf, nullptr);
             }
-            if (idxMem != VK_NULL_HANDLE) {
-                vkFreeMemory(m_vkDevice, idxMem, nullptr);
-            }
+            m_memAllocator->Free(&idxMem);
             if (vtxBuf != VK_NULL_HANDLE) {
                 vkDestroyBuffer(m_vkDevice, vtxBuf, nullptr);
             }
-            if (vtxMem != VK_NULL_HANDLE) {
-                vkFreeMemory(m_vkDevice, vtxMem, nullptr);
-            }
+            m_memAllocator->Free(&vtxMem);
         }
         idxBuf = VK_NULL_HANDLE;
-        idxMem = VK_NULL_HANDLE;
         vtxBuf = VK_NULL_HANDLE;
-        vtxMem = VK_NULL_HANDLE;
         bindDesc = {};
         attrDesc.clear();
         count = {0, 0};
@@ -444,7 +687,7 @@ struct VertexBufferBase {
     VertexBufferBase& operator=(const VertexBufferBase&) = delete;
     VertexBufferBase(VertexBufferBase&&) = delete;
     VertexBufferBase& operator=(VertexBufferBase&&) = delete;
-    void Init(VkDevice device, const MemoryAllocator* memAllocator, const std::vector<VkVertexInputAttributeDescription>& attr) {
+    void Init(VkDevice device, MemoryAllocator* memAllocator, const std::vector<VkVertexInputAttributeDescription>& attr) {
         m_vkDevice = device;
         m_memAllocator = memAllocator;
         attrDesc = attr;
@@ -452,14 +695,15 @@ struct VertexBufferBase {
 
    protected:
     VkDevice m_vkDevice{VK_NULL_HANDLE};
-    void AllocateBufferMemory(VkBuffer buf, VkDeviceMemory* mem) const {
+    void AllocateBufferMemory(VkBuffer buf, MemoryAllocation* mem) const {
         VkMemoryRequirements memReq = {};
         vkGetBufferMemoryRequirements(m_vkDevice, buf, &memReq);
-        m_memAllocator->Allocate(memReq, mem);
+        // Written once from the CPU, then read by every draw, so prefer memory that is also device-local.
+        m_memAllocator->Allocate(memReq, true, mem, MemoryAllocator::defaultFlags, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
     }
 
    private:
-    const MemoryAllocator* m_memAllocator{nullptr};
+    MemoryAllocator* m_memAllocator{nullptr};
 };
 
 // VertexBuffer template to wrap the indices and vertices
@@ -471,13 +715,13 @@ struct VertexBuffer : public VertexBufferBase {
         bufInfo.size = sizeof(uint16_t) * idxCount;
         CHECK_VKCMD(vkCreateBuffer(m_vkDevice, &bufInfo, nullptr, &idxBuf));
         AllocateBufferMemory(idxBuf, &idxMem);
-        CHECK_VKCMD(vkBindBufferMemory(m_vkDevice, idxBuf, idxMem, 0));
+        CHECK_VKCMD(vkBindBufferMemory(m_vkDevice, idxBuf, idxMem.memory, idxMem.offset));
 
         bufInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
         bufInfo.size = sizeof(T) * vtxCount;
         CHECK_VKCMD(vkCreateBuffer(m_vkDevice, &bufInfo, nullptr, &vtxBuf));
         AllocateBufferMemory(vtxBuf, &vtxMem);
-        CHECK_VKCMD(vkBindBufferMemory(m_vkDevice, vtxBuf, vtxMem, 0));
+        CHECK_VKCMD(vkBindBufferMemory(m_vkDevice, vtxBuf, vtxMem.memory, vtxMem.offset));
 
         bindDesc.binding = 0;
         bindDesc.stride = sizeof(T);
@@ -489,21 +733,116 @@ struct VertexBuffer : public VertexBufferBase {
     }
 
     void UpdateIndices(const uint16_t* data, uint32_t elements, uint32_t offset = 0) {
-        uint16_t* map = nullptr;
-        CHECK_VKCMD(vkMapMemory(m_vkDevice, idxMem, sizeof(map[0]) * offset, sizeof(map[0]) * elements, 0, (void**)&map));
+        uint16_t* map = static_cast<uint16_t*>(idxMem.mapped) + offset;
         for (size_t i = 0; i < elements; ++i) {
             map[i] = data[i];
         }
-        vkUnmapMemory(m_vkDevice, idxMem);
     }
 
     void UpdateVertices(const T* data, uint32_t elements, uint32_t offset = 0) {
-        T* map = nullptr;
-        CHECK_VKCMD(vkMapMemory(m_vkDevice, vtxMem, sizeof(map[0]) * offset, sizeof(map[0]) * elements, 0, (void**)&map));
+        T* map = static_cast<T*>(vtxMem.mapped) + offset;
         for (size_t i = 0; i < elements; ++i) {
             map[i] = data[i];
         }
-        vkUnmapMemory(m_vkDevice, vtxMem);
+    }
+};
+
+// Per-instance vertex data that is rewritten every frame. Each frame writes the next of its buffers, so it never touches
+// the one the previous frame's views may still be reading. Two are enough because each swapchain's previous command buffer is
+// waited on before it is recorded again, so by the time a frame is written, the views that read its buffer have completed.
+struct InstanceBufferBase {
+    static constexpr uint32_t FrameCount = 2;
+
+    VkVertexInputBindingDescription bindDesc{};
+    std::vector<VkVertexInputAttributeDescription> attrDesc{};
+    uint32_t count{0};
+
+    InstanceBufferBase() = default;
+
+    ~InstanceBufferBase() {
+        if (m_vkDevice != nullptr) {
+            for (Frame& frame : m_frames) {
+                if (frame.buf != VK_NULL_HANDLE) {
+                    vkDestroyBuffer(m_vkDevice, frame.buf, nullptr);
+                }
+                m_memAllocator->Free(&frame.mem);
+            }
+        }
+        m_frames = {};
+        bindDesc = {};
+        attrDesc.clear();
+        count = 0;
+        m_vkDevice = nullptr;
+    }
+
+    InstanceBufferBase(const InstanceBufferBase&) = delete;
+    InstanceBufferBase& operator=(const InstanceBufferBase&) = delete;
+    InstanceBufferBase(InstanceBufferBase&&) = delete;
+    InstanceBufferBase& operator=(InstanceBufferBase&&) = delete;
+    void Init(VkDevice device, MemoryAllocator* memAllocator, uint32_t binding, uint32_t stride,
+              const std::vector<VkVertexInputAttributeDescription>& attr) {
+        m_vkDevice = device;
+        m_memAllocator = memAllocator;
+        bindDesc.binding = binding;
+        bindDesc.stride = stride;
+        bindDesc.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        attrDesc = attr;
+    }
+
+    // Buffer holding the instances of the current frame.
+    VkBuffer Buffer() const { return m_frames[m_frameIndex].buf; }
+
+   protected:
+    VkDevice m_vkDevice{VK_NULL_HANDLE};
+
+    // Moves on to the next frame's buffer, growing it if it can't hold elements instances, and returns its mapping.
+    void* MapNextFrame(uint32_t elements) {
+        m_frameIndex = (m_frameIndex + 1) % FrameCount;
+        Frame& frame = m_frames[m_frameIndex];
+        if (frame.capacity < elements) {
+            if (frame.buf != VK_NULL_HANDLE) {
+                vkDestroyBuffer(m_vkDevice, frame.buf, nullptr);
+                m_memAllocator->Free(&frame.mem);
+            }
+            // Leave some headroom so a slowly growing count doesn't reallocate every frame.
+            frame.capacity = std::max(elements, frame.capacity + frame.capacity / 2);
+
+            VkBufferCreateInfo bufInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+            bufInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+            bufInfo.size = (VkDeviceSize)bindDesc.stride * frame.capacity;
+            CHECK_VKCMD(vkCreateBuffer(m_vkDevice, &bufInfo, nullptr, &frame.buf));
+            VkMemoryRequirements memReq = {};
+            vkGetBufferMemoryRequirements(m_vkDevice, frame.buf, &memReq);
+            m_memAllocator->Allocate(memReq, true, &frame.mem, MemoryAllocator::defaultFlags, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            CHECK_VKCMD(vkBindBufferMemory(m_vkDevice, frame.buf, frame.mem.memory, frame.mem.offset));
+        }
+
+        count = elements;
+        return frame.mem.mapped;
+    }
+
+   private:
+    struct Frame {
+        VkBuffer buf{VK_NULL_HANDLE};
+        MemoryAllocation mem{};
+        uint32_t capacity{0};
+    };
+
+    MemoryAllocator* m_memAllocator{nullptr};
+    std::array<Frame, FrameCount> m_frames{};
+    uint32_t m_frameIndex{0};
+};
+
+// InstanceBuffer template to write typed instances
+template <typename T>
+struct InstanceBuffer : public InstanceBufferBase {
+    void Update(const T* data, uint32_t elements) {
+        if (elements == 0) {
+            count = 0;
+            return;
+        }
+        T* map = static_cast<T*>(MapNextFrame(elements));
+        memcpy(map, data, sizeof(T) * elements);
     }
 };
 
@@ -515,7 +854,8 @@ struct RenderPass {
 
     RenderPass() = default;
 
-    bool Create(const VulkanDebugObjectNamer& namer, VkDevice device, VkFormat aColorFmt, VkFormat aDepthFmt) {
+    bool Create(const VulkanDebugObjectNamer& namer, VkDevice device, VkFormat aColorFmt, VkFormat aDepthFmt,
+                uint32_t viewCount = 1) {
         m_vkDevice = device;
         colorFmt = aColorFmt;
         depthFmt = aDepthFmt;
@@ -534,6 +874,17 @@ struct RenderPass {
         rpInfo.subpassCount = 1;
         rpInfo.pSubpasses = &subpass;
 
+        // With several views, the subpass renders to all array layers at once, view i to layer i
+        const uint32_t viewMask = (1u << viewCount) - 1;
+        VkRenderPassMultiviewCreateInfoKHR multiviewInfo{VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO_KHR};
+        multiviewInfo.subpassCount = 1;
+        multiviewInfo.pViewMasks = &viewMask;
+        multiviewInfo.correlationMaskCount = 1;
+        multiviewInfo.pCorrelationMasks = &viewMask;
+        if (viewCount > 1) {
+            rpInfo.pNext = &multiviewInfo;
+        }
+
         if (colorFmt != VK_FORMAT_UNDEFINED) {
             colorRef.attachment = rpInfo.attachmentCount++;
 
@@ -647,7 +998,7 @@ struct RenderTarget {
         return *this;
     }
     void Create(const VulkanDebugObjectNamer& namer, VkDevice device, VkImage aColorImage, VkImage aDepthImage, VkExtent2D size,
-                RenderPass& renderPass) {
+                uint32_t layerCount, RenderPass& renderPass) {
         m_vkDevice = device;
 
         colorImage = aColorImage;
@@ -660,7 +1011,7 @@ struct RenderTarget {
         if (colorImage != VK_NULL_HANDLE) {
             VkImageViewCreateInfo colorViewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
             colorViewInfo.image = colorImage;
-            colorViewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            colorViewInfo.viewType = layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
             colorViewInfo.format = renderPass.colorFmt;
             colorViewInfo.components.r = VK_COMPONENT_SWIZZLE_R;
             colorViewInfo.components.g = VK_COMPONENT_SWIZZLE_G;
@@ -670,7 +1021,7 @@ struct RenderTarget {
             colorViewInfo.subresourceRange.baseMipLevel = 0;
             colorViewInfo.subresourceRange.levelCount = 1;
             colorViewInfo.subresourceRange.baseArrayLayer = 0;
-            colorViewInfo.subresourceRange.layerCount = 1;
+            colorViewInfo.subresourceRange.layerCount = layerCount;
             CHECK_VKCMD(vkCreateImageView(m_vkDevice, &colorViewInfo, nullptr, &colorView));
             CHECK_VKCMD(namer.SetName(VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)colorView, "hello_xr color image view"));
             attachments[attachmentCount++] = colorView;
@@ -680,7 +1031,7 @@ struct RenderTarget {
         if (depthImage != VK_NULL_HANDLE) {
             VkImageViewCreateInfo depthViewInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
             depthViewInfo.image = depthImage;
-            depthViewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            depthViewInfo.viewType = layerCount > 1 ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
             depthViewInfo.format = renderPass.depthFmt;
             depthViewInfo.components.r = VK_COMPONENT_SWIZZLE_R;
             depthViewInfo.components.g = VK_COMPONENT_SWIZZLE_G;
@@ -690,7 +1041,7 @@ struct RenderTarget {
             depthViewInfo.subresourceRange.baseMipLevel = 0;
             depthViewInfo.subresourceRange.levelCount = 1;
             depthViewInfo.subresourceRange.baseArrayLayer = 0;
-            depthViewInfo.subresourceRange.layerCount = 1;
+            depthViewInfo.subresourceRange.layerCount = layerCount;
             CHECK_VKCMD(vkCreateImageView(m_vkDevice, &depthViewInfo, nullptr, &depthView));
             CHECK_VKCMD(namer.SetName(VK_OBJECT_TYPE_IMAGE_VIEW, (uint64_t)depthView, "hello_xr depth image view"));
             attachments[attachmentCount++] = depthView;
@@ -702,7 +1053,7 @@ struct RenderTarget {
         fbInfo.pAttachments = attachments.data();
         fbInfo.width = size.width;
         fbInfo.height = size.height;
-        fbInfo.layers = 1;
+        fbInfo.layers = 1;  // Multiview render passes address the array layers through the view mask instead
         CHECK_VKCMD(vkCreateFramebuffer(m_vkDevice, &fbInfo, nullptr, &fb));
         CHECK_VKCMD(namer.SetName(VK_OBJECT_TYPE_FRAMEBUFFER, (uint64_t)fb, "hello_xr framebuffer"));
     }
@@ -714,6 +1065,9 @@ struct RenderTarget {
     VkDevice m_vkDevice{VK_NULL_HANDLE};
 };
 
+// Number of view-projection matrices in the push constants, one per view of the multiview vertex shader.
+constexpr uint32_t MaxViewCount = 2;
+
 // Simple vertex MVP xform & color fragment shader layout
 struct PipelineLayout {
     VkPipelineLayout layout{VK_NULL_HANDLE};
@@ -733,11 +1087,11 @@ struct PipelineLayout {
     void Create(VkDevice device) {
         m_vkDevice = device;
 
-        // MVP matrix is a push_constant
+        // View-projection matrices are a push_constant
         VkPushConstantRange pcr = {};
         pcr.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         pcr.offset = 0;
-        pcr.size = 4 * 4 * sizeof(float);
+        pcr.size = MaxViewCount * 4 * 4 * sizeof(float);
 
         VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
         pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
@@ -754,6 +1108,112 @@ struct PipelineLayout {
     VkDevice m_vkDevice{VK_NULL_HANDLE};
 };
 
+// Pipeline cache that is loaded from and saved to a file so pipelines compiled in one run are reused by the next
+struct PipelineCache {
+    VkPipelineCache cache{VK_NULL_HANDLE};
+
+    PipelineCache() = default;
+
+    ~PipelineCache() {
+        if (m_vkDevice != nullptr) {
+            Save();
+            if (cache != VK_NULL_HANDLE) {
+                vkDestroyPipelineCache(m_vkDevice, cache, nullptr);
+            }
+        }
+        cache = VK_NULL_HANDLE;
+        m_vkDevice = nullptr;
+    }
+
+    void Create(VkPhysicalDevice physDevice, VkDevice device, const std::string& fileName) {
+        m_vkDevice = device;
+        m_fileName = fileName;
+
+        std::vector<char> data;
+        if (!m_fileName.empty()) {
+            std::ifstream file(m_fileName, std::ios::binary | std::ios::ate);
+            if (file.is_open()) {
+                data.resize((size_t)file.tellg());
+                file.seekg(0);
+                file.read(data.data(), data.size());
+            }
+        }
+
+        // Data written by another driver or GPU would be ignored or rejected by the driver, so only pass it on if the header
+        // matches.
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(physDevice, &props);
+        VkPipelineCacheHeaderVersionOne header{};
+        if (data.size() >= sizeof(header)) {
+            memcpy(&header, data.data(), sizeof(header));
+        }
+        if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || header.vendorID != props.vendorID ||
+            header.deviceID != props.deviceID || memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+            data.clear();
+        }
+
+        VkPipelineCacheCreateInfo cacheInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        cacheInfo.initialDataSize = data.size();
+        cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+        CHECK_VKCMD(vkCreatePipelineCache(m_vkDevice, &cacheInfo, nullptr, &cache));
+        m_savedSize = data.size();
+
+        if (!m_fileName.empty()) {
+            Log::Write(Log::Level::Info, Fmt("Pipeline cache %s: loaded %zu bytes", m_fileName.c_str(), data.size()));
+        }
+    }
+
+    // Writes the cache back to its file, skipping the write when nothing was added since the last load or save.
+    void Save() {
+        if (m_fileName.empty() || cache == VK_NULL_HANDLE) {
+            return;
+        }
+
+        size_t dataSize = 0;
+        CHECK_VKCMD(vkGetPipelineCacheData(m_vkDevice, cache, &dataSize, nullptr));
+        if (dataSize == m_savedSize) {
+            return;
+        }
+        std::vector<char> data(dataSize);
+        CHECK_VKCMD(vkGetPipelineCacheData(m_vkDevice, cache, &dataSize, data.data()));
+
+        // Write a temporary file and rename it over the old one, so a crash or a full disk never leaves a torn cache behind.
+        const std::string tempFileName = m_fileName + ".tmp";
+        std::ofstream file(tempFileName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            Log::Write(Log::Level::Warning, Fmt("Could not write pipeline cache %s", tempFileName.c_str()));
+            return;
+        }
+        file.write(data.data(), dataSize);
+        file.close();
+        if (file.fail()) {
+            Log::Write(Log::Level::Warning, Fmt("Could not write pipeline cache %s", tempFileName.c_str()));
+            std::remove(tempFileName.c_str());
+            return;
+        }
+#if defined(_WIN32)
+        // rename() doesn't replace an existing file on Windows.
+        std::remove(m_fileName.c_str());
+#endif
+        if (std::rename(tempFileName.c_str(), m_fileName.c_str()) != 0) {
+            Log::Write(Log::Level::Warning, Fmt("Could not replace pipeline cache %s", m_fileName.c_str()));
+            std::remove(tempFileName.c_str());
+            return;
+        }
+        m_savedSize = dataSize;
+    }
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+    PipelineCache(PipelineCache&&) = delete;
+    PipelineCache& operator=(PipelineCache&&) = delete;
+
+   private:
+    VkDevice m_vkDevice{VK_NULL_HANDLE};
+    std::string m_fileName;
+    size_t m_savedSize{0};
+};
+
 // Pipeline wrapper for rendering pipeline state
 struct Pipeline {
     VkPipeline pipe{VK_NULL_HANDLE};
@@ -765,18 +1225,22 @@ struct Pipeline {
     void Dynamic(VkDynamicState state) { dynamicStateEnables.emplace_back(state); }
 
     void Create(VkDevice device, VkExtent2D size, const PipelineLayout& layout, const RenderPass& rp, const ShaderProgram& sp,
-                const VertexBufferBase& vb) {
+                const VertexBufferBase& vb, const InstanceBufferBase& ib, const PipelineCache& cache) {
         m_vkDevice = device;
 
         VkPipelineDynamicStateCreateInfo dynamicState{VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO};
         dynamicState.dynamicStateCount = (uint32_t)dynamicStateEnables.size();
         dynamicState.pDynamicStates = dynamicStateEnables.data();
 
+        std::array<VkVertexInputBindingDescription, 2> bindDesc{vb.bindDesc, ib.bindDesc};
+        std::vector<VkVertexInputAttributeDescription> attrDesc(vb.attrDesc);
+        attrDesc.insert(attrDesc.end(), ib.attrDesc.begin(), ib.attrDesc.end());
+
         VkPipelineVertexInputStateCreateInfo vi{VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
-        vi.vertexBindingDescriptionCount = 1;
-        vi.pVertexBindingDescriptions = &vb.bindDesc;
-        vi.vertexAttributeDescriptionCount = (uint32_t)vb.attrDesc.size();
-        vi.pVertexAttributeDescriptions = vb.attrDesc.data();
+        vi.vertexBindingDescriptionCount = (uint32_t)bindDesc.size();
+        vi.pVertexBindingDescriptions = bindDesc.data();
+        vi.vertexAttributeDescriptionCount = (uint32_t)attrDesc.size();
+        vi.pVertexAttributeDescriptions = attrDesc.data();
 
         VkPipelineInputAssemblyStateCreateInfo ia{VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
         ia.primitiveRestartEnable = VK_FALSE;
@@ -863,7 +1327,7 @@ struct Pipeline {
         pipeInfo.layout = layout.layout;
         pipeInfo.renderPass = rp.pass;
         pipeInfo.subpass = 0;
-        CHECK_VKCMD(vkCreateGraphicsPipelines(m_vkDevice, VK_NULL_HANDLE, 1, &pipeInfo, nullptr, &pipe));
+        CHECK_VKCMD(vkCreateGraphicsPipelines(m_vkDevice, cache.cache, 1, &pipeInfo, nullptr, &pipe));
     }
 
     void Release() {
@@ -883,7 +1347,7 @@ struct Pipeline {
 };
 
 struct DepthBuffer {
-    VkDeviceMemory depthMemory{VK_NULL_HANDLE};
+    MemoryAllocation depthMemory{};
     VkImage depthImage{VK_NULL_HANDLE};
 
     DepthBuffer() = default;
@@ -893,12 +1357,10 @@ struct DepthBuffer {
             if (depthImage != VK_NULL_HANDLE) {
                 vkDestroyImage(m_vkDevice, depthImage, nullptr);
             }
-            if (depthMemory != VK_NULL_HANDLE) {
-                vkFreeMemory(m_vkDevice, depthMemory, nullptr);
-            }
+            m_memAllocator->Free(&depthMemory);
         }
         depthImage = VK_NULL_HANDLE;
-        depthMemory = VK_NULL_HANDLE;
+        m_memAllocator = nullptr;
         m_vkDevice = nullptr;
     }
 
@@ -907,6 +1369,7 @@ struct DepthBuffer {
 
         swap(depthImage, other.depthImage);
         swap(depthMemory, other.depthMemory);
+        swap(m_memAllocator, other.m_memAllocator);
         swap(m_vkDevice, other.m_vkDevice);
     }
     DepthBuffer& operator=(DepthBuffer&& other) noexcept {
@@ -919,6 +1382,7 @@ struct DepthBuffer {
 
         swap(depthImage, other.depthImage);
         swap(depthMemory, other.depthMemory);
+        swap(m_memAllocator, other.m_memAllocator);
         swap(m_vkDevice, other.m_vkDevice);
         return *this;
     }
@@ -926,6 +1390,7 @@ struct DepthBuffer {
     void Create(const VulkanDebugObjectNamer& namer, VkDevice device, MemoryAllocator* memAllocator, VkFormat depthFormat,
                 const XrSwapchainCreateInfo& swapchainCreateInfo) {
         m_vkDevice = device;
+        m_memAllocator = memAllocator;
 
         VkExtent2D size = {swapchainCreateInfo.width, swapchainCreateInfo.height};
 
@@ -936,7 +1401,7 @@ struct DepthBuffer {
         imageInfo.extent.height = size.height;
         imageInfo.extent.depth = 1;
         imageInfo.mipLevels = 1;
-        imageInfo.arrayLayers = 1;
+        imageInfo.arrayLayers = swapchainCreateInfo.arraySize;
         imageInfo.format = depthFormat;
         imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
         imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -948,9 +1413,12 @@ struct DepthBuffer {
 
         VkMemoryRequirements memRequirements{};
         vkGetImageMemoryRequirements(device, depthImage, &memRequirements);
-        memAllocator->Allocate(memRequirements, &depthMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-        CHECK_VKCMD(namer.SetName(VK_OBJECT_TYPE_DEVICE_MEMORY, (uint64_t)depthMemory, "hello_xr fallback depth image memory"));
-        CHECK_VKCMD(vkBindImageMemory(device, depthImage, depthMemory, 0));
+        memAllocator->Allocate(memRequirements, false, &depthMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (depthMemory.dedicated) {
+            CHECK_VKCMD(
+                namer.SetName(VK_OBJECT_TYPE_DEVICE_MEMORY, (uint64_t)depthMemory.memory, "hello_xr fallback depth image memory"));
+        }
+        CHECK_VKCMD(vkBindImageMemory(device, depthImage, depthMemory.memory, depthMemory.offset));
     }
 
     void TransitionLayout(CmdBuffer* cmdBuffer, VkImageLayout newLayout) {
@@ -964,7 +1432,7 @@ struct DepthBuffer {
         depthBarrier.oldLayout = m_vkLayout;
         depthBarrier.newLayout = newLayout;
         depthBarrier.image = depthImage;
-        depthBarrier.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1};
+        depthBarrier.subresourceRange = {VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, VK_REMAINING_ARRAY_LAYERS};
         vkCmdPipelineBarrier(cmdBuffer->buf, VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT, 0, 0, nullptr,
                              0, nullptr, 1, &depthBarrier);
 
@@ -976,6 +1444,7 @@ struct DepthBuffer {
 
    private:
     VkDevice m_vkDevice{VK_NULL_HANDLE};
+    MemoryAllocator* m_memAllocator{nullptr};
     VkImageLayout m_vkLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 };
 
@@ -986,6 +1455,7 @@ struct SwapchainImageContext {
     std::vector<XrSwapchainImageVulkan2KHR> swapchainImages;
     std::vector<RenderTarget> renderTarget;
     VkExtent2D size{};
+    uint32_t layerCount{1};  // One per view when rendering with multiview
     DepthBuffer depthBuffer{};
     RenderPass rp{};
     Pipeline pipe{};
@@ -997,18 +1467,20 @@ struct SwapchainImageContext {
     std::vector<XrSwapchainImageBaseHeader*> Create(const VulkanDebugObjectNamer& namer, VkDevice device, uint32_t queueFamilyIndex,
                                                     MemoryAllocator* memAllocator, uint32_t capacity,
                                                     const XrSwapchainCreateInfo& swapchainCreateInfo, const PipelineLayout& layout,
-                                                    const ShaderProgram& sp, const VertexBuffer<Geometry::Vertex>& vb) {
+                                                    const ShaderProgram& sp, const VertexBuffer<Geometry::Vertex>& vb,
+                                                    const InstanceBufferBase& ib, const PipelineCache& cache) {
         m_vkDevice = device;
         m_namer = namer;
 
         size = {swapchainCreateInfo.width, swapchainCreateInfo.height};
+        layerCount = swapchainCreateInfo.arraySize;
         VkFormat colorFormat = (VkFormat)swapchainCreateInfo.format;
         VkFormat depthFormat = VK_FORMAT_D32_SFLOAT;
         // XXX handle swapchainCreateInfo.sampleCount
 
         depthBuffer.Create(namer, m_vkDevice, memAllocator, depthFormat, swapchainCreateInfo);
-        rp.Create(namer, m_vkDevice, colorFormat, depthFormat);
-        pipe.Create(m_vkDevice, size, layout, rp, sp, vb);
+        rp.Create(namer, m_vkDevice, colorFormat, depthFormat, layerCount);
+        pipe.Create(m_vkDevice, size, layout, rp, sp, vb, ib, cache);
 
         swapchainImages.resize(capacity);
         renderTarget.resize(capacity);
@@ -1032,7 +1504,8 @@ struct SwapchainImageContext {
 
     void BindRenderTarget(uint32_t index, VkRenderPassBeginInfo* renderPassBeginInfo) {
         if (renderTarget[index].fb == VK_NULL_HANDLE) {
-            renderTarget[index].Create(m_namer, m_vkDevice, swapchainImages[index].image, depthBuffer.depthImage, size, rp);
+            renderTarget[index].Create(m_namer, m_vkDevice, swapchainImages[index].image, depthBuffer.depthImage, size, layerCount,
+                                       rp);
         }
         renderPassBeginInfo->renderPass = rp.pass;
         renderPassBeginInfo->framebuffer = renderTarget[index].fb;
@@ -1286,7 +1759,7 @@ void Swapchain::Present(VkQueue queue, VkSemaphore drawComplete) {
 
 struct VulkanGraphicsPlugin : public IGraphicsPlugin {
     VulkanGraphicsPlugin(const std::shared_ptr<Options>& options, std::shared_ptr<IPlatformPlugin> /*unused*/)
-        : m_clearColor(options->GetBackgroundClearColor()) {
+        : m_clearColor(options->GetBackgroundClearColor()), m_pipelineCacheFile(options->PipelineCacheFile) {
         m_graphicsBinding.type = GetGraphicsBindingType();
     };
 
@@ -1369,6 +1842,11 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
             if (isExtSupported(VK_EXT_DEBUG_UTILS_EXTENSION_NAME)) {
                 extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
             }
+            // Required by VK_KHR_multiview on a Vulkan 1.0 instance
+            if (isExtSupported(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)) {
+                extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+                m_physicalDeviceProperties2Supported = true;
+            }
             // TODO add back VK_EXT_debug_report code for compatibility with older systems? (Android)
         }
 #if defined(USE_MIRROR_WINDOW)
@@ -1452,7 +1930,26 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
         deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 #endif
 
+        // Multiview lets a single render pass draw both eyes into the layers of one array swapchain.
+        uint32_t extensionCount = 0;
+        CHECK_VKCMD(vkEnumerateDeviceExtensionProperties(m_vkPhysicalDevice, nullptr, &extensionCount, nullptr));
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        CHECK_VKCMD(vkEnumerateDeviceExtensionProperties(m_vkPhysicalDevice, nullptr, &extensionCount, availableExtensions.data()));
+        for (const auto& extension : availableExtensions) {
+            if (m_physicalDeviceProperties2Supported && strcmp(extension.extensionName, VK_KHR_MULTIVIEW_EXTENSION_NAME) == 0) {
+                m_multiviewSupported = true;
+            }
+        }
+
+        VkPhysicalDeviceMultiviewFeaturesKHR multiviewFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_FEATURES_KHR};
+        multiviewFeatures.multiview = VK_TRUE;
+        if (m_multiviewSupported) {
+            deviceExtensions.push_back(VK_KHR_MULTIVIEW_EXTENSION_NAME);
+        }
+        Log::Write(Log::Level::Info, Fmt("Multiview rendering %s", m_multiviewSupported ? "enabled" : "not supported"));
+
         VkDeviceCreateInfo deviceInfo{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+        deviceInfo.pNext = m_multiviewSupported ? &multiviewFeatures : nullptr;
         deviceInfo.queueCreateInfoCount = 1;
         deviceInfo.pQueueCreateInfos = &queueInfo;
         deviceInfo.enabledLayerCount = 0;
@@ -1523,6 +2020,22 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
         m_shaderProgram.LoadVertexShader(vertexSPIRV);
         m_shaderProgram.LoadFragmentShader(fragmentSPIRV);
 
+        if (m_multiviewSupported) {
+#ifdef USE_ONLINE_VULKAN_SHADERC
+            auto multiviewVertexSPIRV =
+                CompileGlslShader("multiview vertex", shaderc_glsl_default_vertex_shader, MultiViewVertexShaderGlsl);
+#else
+            std::vector<uint32_t> multiviewVertexSPIRV = SPV_PREFIX
+#include "vert_multiview.spv"
+                SPV_SUFFIX;
+#endif
+            if (multiviewVertexSPIRV.empty()) THROW("Failed to compile multiview vertex shader");
+
+            m_multiviewShaderProgram.Init(m_vkDevice);
+            m_multiviewShaderProgram.LoadVertexShader(multiviewVertexSPIRV);
+            m_multiviewShaderProgram.LoadFragmentShader(fragmentSPIRV);
+        }
+
         // Semaphore to block on draw complete
         VkSemaphoreCreateInfo semInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
         CHECK_VKCMD(vkCreateSemaphore(m_vkDevice, &semInfo, nullptr, &m_vkDrawDone));
@@ -1531,6 +2044,7 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
         if (!m_cmdBuffer.Init(m_namer, m_vkDevice, m_queueFamilyIndex)) THROW("Failed to create command buffer");
 
         m_pipelineLayout.Create(m_vkDevice);
+        m_pipelineCache.Create(m_vkPhysicalDevice, m_vkDevice, m_pipelineCacheFile);
 
         static_assert(sizeof(Geometry::Vertex) == 24, "Unexpected Vertex size");
         m_drawBuffer.Init(m_vkDevice, &m_memAllocator,
@@ -1542,6 +2056,12 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
         m_drawBuffer.UpdateIndices(Geometry::c_cubeIndices, numCubeIdicies, 0);
         m_drawBuffer.UpdateVertices(Geometry::c_cubeVertices, numCubeVerticies, 0);
 
+        // One instance per cube, laid out as Cube: orientation, position, scale.
+        m_cubeInstances.Init(m_vkDevice, &m_memAllocator, 1, sizeof(Cube),
+                             {{2, 1, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Cube, Pose) + offsetof(XrPosef, orientation)},
+                              {3, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Cube, Pose) + offsetof(XrPosef, position)},
+                              {4, 1, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Cube, Scale)}});
+
 #if defined(USE_MIRROR_WINDOW)
         m_swapchain.Create(m_vkInstance, m_vkPhysicalDevice, m_vkDevice, m_graphicsBinding.queueFamilyIndex);
 
@@ -1581,9 +2101,19 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
         m_swapchainImageContexts.emplace_back(GetSwapchainImageType());
         SwapchainImageContext& swapchainImageContext = m_swapchainImageContexts.back();
 
+        // Array swapchains hold one layer per view and are rendered with multiview.
+        const ShaderProgram& shaderProgram = swapchainCreateInfo.arraySize > 1 ? m_multiviewShaderProgram : m_shaderProgram;
+
+        auto startTime = std::chrono::steady_clock::now();
         std::vector<XrSwapchainImageBaseHeader*> bases =
             swapchainImageContext.Create(m_namer, m_vkDevice, m_queueFamilyIndex, &m_memAllocator, capacity, swapchainCreateInfo,
-                                         m_pipelineLayout, m_shaderProgram, m_drawBuffer);
+                                         m_pipelineLayout, shaderProgram, m_drawBuffer, m_cubeInstances, m_pipelineCache);
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+        Log::Write(Log::Level::Info, Fmt("Swapchain image context created in %.2f ms", elapsed.count()));
+        m_memAllocator.LogStats();
+
+        // Save right away so the pipelines compiled for this swapchain survive even if the app is killed rather than closed.
+        m_pipelineCache.Save();
 
         // Map every swapchainImage base pointer to this context
         for (auto& base : bases) {
@@ -1593,15 +2123,51 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
         return bases;
     }
 
+    void UpdateCubeInstances(const std::vector<Cube>& cubes) override {
+        m_cubeInstances.Update(cubes.data(), (uint32_t)cubes.size());
+    }
+
     void RenderView(const XrCompositionLayerProjectionView& layerView, const XrSwapchainImageBaseHeader* swapchainImage,
-                    int64_t /*swapchainFormat*/, const std::vector<Cube>& cubes) override {
-        CHECK(layerView.subImage.imageArrayIndex == 0);  // Texture arrays not supported.
+                    int64_t /*swapchainFormat*/, const std::vector<Cube>& /*cubes*/) override {
+        CHECK(layerView.subImage.imageArrayIndex == 0);  // Array swapchains go through RenderMultiView.
 
+        RenderViews(&layerView, 1, swapchainImage);
+    }
+
+    bool SupportsMultiView() const override { return m_multiviewSupported; }
+
+    void RenderMultiView(const std::vector<XrCompositionLayerProjectionView>& layerViews,
+                         const XrSwapchainImageBaseHeader* swapchainImage, int64_t /*swapchainFormat*/,
+                         const std::vector<Cube>& /*cubes*/) override {
+        CHECK(m_multiviewSupported);
+        CHECK(layerViews.size() <= MaxViewCount);
+        for (uint32_t i = 0; i < (uint32_t)layerViews.size(); ++i) {
+            CHECK(layerViews[i].subImage.imageArrayIndex == i);  // The view mask renders view i to layer i.
+        }
+
+        RenderViews(layerViews.data(), (uint32_t)layerViews.size(), swapchainImage);
+
+        // One line to check a validation run of the multiview path by, without reading the whole log.
+        if (++m_multiviewFrameCount == ValidationSummaryFrames) {
+            Log::Write(Log::Level::Info, Fmt("Multiview validation summary: %u Vulkan errors in the first %u frames",
+                                             m_vulkanErrorCount, ValidationSummaryFrames));
+        }
+    }
+
+    uint32_t GetSupportedSwapchainSampleCount(const XrViewConfigurationView&) override { return VK_SAMPLE_COUNT_1_BIT; }
+
+    void UpdateOptions(const std::shared_ptr<Options>& options) override { m_clearColor = options->GetBackgroundClearColor(); }
+
+   private:
+    // Records and submits one command buffer drawing viewCount views of swapchainImage. With more than one view the swapchain
+    // context's render pass is a multiview one, so a single pass of draws fills every layer.
+    void RenderViews(const XrCompositionLayerProjectionView* layerViews, uint32_t viewCount,
+                     const XrSwapchainImageBaseHeader* swapchainImage) {
         auto swapchainContext = m_swapchainImageContextMap[swapchainImage];
         uint32_t imageIndex = swapchainContext->ImageIndex(swapchainImage);
 
-        // Note: this needs to be modified to avoid blocking on the CmdBuffer fence between multiple views of the same frame, if
-        // Texture arrays are supported.
+        // Note: without multiview, each view of the frame has its own swapchain and command buffer, so this only waits for
+        // the same view of an earlier frame.
         CmdBuffer& cmdBuffer = swapchainContext->cmdBuffer;
         cmdBuffer.Wait();
         cmdBuffer.Reset();
@@ -1628,34 +2194,31 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
 
         vkCmdBindPipeline(cmdBuffer.buf, VK_PIPELINE_BIND_POINT_GRAPHICS, swapchainContext->pipe.pipe);
 
-        // Bind index and vertex buffers
-        vkCmdBindIndexBuffer(cmdBuffer.buf, m_drawBuffer.idxBuf, 0, VK_INDEX_TYPE_UINT16);
-        VkDeviceSize offset = 0;
-        vkCmdBindVertexBuffers(cmdBuffer.buf, 0, 1, &m_drawBuffer.vtxBuf, &offset);
-
-        // Compute the view-projection transform.
+        // Compute the view-projection transform of each view.
         // Note all matrixes (including OpenXR's) are column-major, right-handed.
-        const auto& pose = layerView.pose;
-        XrMatrix4x4f proj;
-        XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_VULKAN, layerView.fov, 0.05f, 100.0f);
-        XrMatrix4x4f toView;
-        XrMatrix4x4f_CreateFromRigidTransform(&toView, &pose);
-        XrMatrix4x4f view;
-        XrMatrix4x4f_InvertRigidBody(&view, &toView);
-        XrMatrix4x4f vp;
-        XrMatrix4x4f_Multiply(&vp, &proj, &view);
-
-        // Render each cube
-        for (const Cube& cube : cubes) {
-            // Compute the model-view-projection transform and push it.
-            XrMatrix4x4f model;
-            XrMatrix4x4f_CreateTranslationRotationScale(&model, &cube.Pose.position, &cube.Pose.orientation, &cube.Scale);
-            XrMatrix4x4f mvp;
-            XrMatrix4x4f_Multiply(&mvp, &vp, &model);
-            vkCmdPushConstants(cmdBuffer.buf, m_pipelineLayout.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(mvp.m), &mvp.m[0]);
-
-            // Draw the cube.
-            vkCmdDrawIndexed(cmdBuffer.buf, m_drawBuffer.count.idx, 1, 0, 0, 0);
+        std::array<XrMatrix4x4f, MaxViewCount> vp;
+        for (uint32_t i = 0; i < viewCount; ++i) {
+            const auto& pose = layerViews[i].pose;
+            XrMatrix4x4f proj;
+            XrMatrix4x4f_CreateProjectionFov(&proj, GRAPHICS_VULKAN, layerViews[i].fov, 0.05f, 100.0f);
+            XrMatrix4x4f toView;
+            XrMatrix4x4f_CreateFromRigidTransform(&toView, &pose);
+            XrMatrix4x4f view;
+            XrMatrix4x4f_InvertRigidBody(&view, &toView);
+            XrMatrix4x4f_Multiply(&vp[i], &proj, &view);
+        }
+        vkCmdPushConstants(cmdBuffer.buf, m_pipelineLayout.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, viewCount * sizeof(vp[0].m),
+                           &vp[0].m[0]);
+
+        // Draw all cubes at once; the vertex shader applies each instance's pose and scale.
+        if (m_cubeInstances.count > 0) {
+            // Bind index, vertex and instance buffers
+            vkCmdBindIndexBuffer(cmdBuffer.buf, m_drawBuffer.idxBuf, 0, VK_INDEX_TYPE_UINT16);
+            std::array<VkBuffer, 2> vertexBuffers{m_drawBuffer.vtxBuf, m_cubeInstances.Buffer()};
+            std::array<VkDeviceSize, 2> offsets{0, 0};
+            vkCmdBindVertexBuffers(cmdBuffer.buf, 0, (uint32_t)vertexBuffers.size(), vertexBuffers.data(), offsets.data());
+
+            vkCmdDrawIndexed(cmdBuffer.buf, m_drawBuffer.count.idx, m_cubeInstances.count, 0, 0, 0);
         }
 
         vkCmdEndRenderPass(cmdBuffer.buf);
@@ -1673,12 +2236,10 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
 #endif
     }
 
-    uint32_t GetSupportedSwapchainSampleCount(const XrViewConfigurationView&) override { return VK_SAMPLE_COUNT_1_BIT; }
-
-    void UpdateOptions(const std::shared_ptr<Options>& options) override { m_clearColor = options->GetBackgroundClearColor(); }
-
    protected:
     XrGraphicsBindingVulkan2KHR m_graphicsBinding{XR_TYPE_GRAPHICS_BINDING_VULKAN2_KHR};
+    // Declared ahead of everything that allocates from it, so it is destroyed last.
+    MemoryAllocator m_memAllocator{};
     std::list<SwapchainImageContext> m_swapchainImageContexts;
     std::map<const XrSwapchainImageBaseHeader*, SwapchainImageContext*> m_swapchainImageContextMap;
 
@@ -1690,12 +2251,20 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
     VkQueue m_vkQueue{VK_NULL_HANDLE};
     VkSemaphore m_vkDrawDone{VK_NULL_HANDLE};
 
-    MemoryAllocator m_memAllocator{};
     ShaderProgram m_shaderProgram{};
+    ShaderProgram m_multiviewShaderProgram{};
+    bool m_physicalDeviceProperties2Supported{false};
+    bool m_multiviewSupported{false};
+    static constexpr uint32_t ValidationSummaryFrames = 300;
+    uint32_t m_multiviewFrameCount{0};
+    uint32_t m_vulkanErrorCount{0};  // Messages of error severity from the debug utils messenger
     CmdBuffer m_cmdBuffer{};
     PipelineLayout m_pipelineLayout{};
+    PipelineCache m_pipelineCache{};
     VertexBuffer<Geometry::Vertex> m_drawBuffer{};
+    InstanceBuffer<Cube> m_cubeInstances{};
     std::array<float, 4> m_clearColor;
+    std::string m_pipelineCacheFile;
 
 #if defined(USE_MIRROR_WINDOW)
     Swapchain m_swapchain{};
@@ -1773,6 +2342,7 @@ struct VulkanGraphicsPlugin : public IGraphicsPlugin {
         if ((messageSeverity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) != 0u) {
             flagNames += "ERROR:";
             level = Log::Level::Error;
+            ++m_vulkanErrorCount;
         }
         if ((messageTypes & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT) != 0u) {
             flagNames += "PERF:";
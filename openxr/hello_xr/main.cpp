@@ -28,6 +28,7 @@ void ShowHelp() {
     Log::Write(Log::Level::Info, "adb shell setprop debug.xr.formFactor Hmd|Handheld");
     Log::Write(Log::Level::Info, "adb shell setprop debug.xr.viewConfiguration Stereo|Mono");
     Log::Write(Log::Level::Info, "adb shell setprop debug.xr.blendMode Opaque|Additive|AlphaBlend");
+    Log::Write(Log::Level::Info, "adb shell setprop debug.xr.stressCubes <Count>");
 }
 
 bool UpdateOptionsFromSystemProperties(Options& options) {
@@ -54,6 +55,10 @@ bool UpdateOptionsFromSystemProperties(Options& options) {
         options.EnvironmentBlendMode = value;
     }
 
+    if (__system_property_get("debug.xr.stressCubes", value) != 0) {
+        options.StressCubeCount = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    }
+
     try {
         options.ParseStrings();
     } catch (std::invalid_argument& ia) {
@@ -68,7 +73,8 @@ void ShowHelp() {
     // TODO: Improve/update when things are more settled.
     Log::Write(Log::Level::Info,
                "HelloXr --graphics|-g <Graphics API> [--formfactor|-ff <Form factor>] [--viewconfig|-vc <View config>] "
-               "[--blendmode|-bm <Blend mode>] [--space|-s <Space>] [--verbose|-v]");
+               "[--blendmode|-bm <Blend mode>] [--space|-s <Space>] [--pipelinecache|-pc <File>] "
+               "[--stresscubes|-sc <Count>] [--verbose|-v]");
     Log::Write(Log::Level::Info, "Graphics APIs:            D3D11, D3D12, OpenGLES, OpenGL, Vulkan2, Vulkan, Metal");
     Log::Write(Log::Level::Info, "Form factors:             Hmd, Handheld");
     Log::Write(Log::Level::Info, "View configurations:      Mono, Stereo");
@@ -99,6 +105,10 @@ bool UpdateOptionsFromCommandLine(Options& options, int argc, char* argv[]) {
             options.EnvironmentBlendMode = getNextArg();
         } else if (EqualsIgnoreCase(arg, "--space") || EqualsIgnoreCase(arg, "-s")) {
             options.AppSpace = getNextArg();
+        } else if (EqualsIgnoreCase(arg, "--pipelinecache") || EqualsIgnoreCase(arg, "-pc")) {
+            options.PipelineCacheFile = getNextArg();
+        } else if (EqualsIgnoreCase(arg, "--stresscubes") || EqualsIgnoreCase(arg, "-sc")) {
+            options.StressCubeCount = static_cast<uint32_t>(std::stoul(getNextArg()));
         } else if (EqualsIgnoreCase(arg, "--verbose") || EqualsIgnoreCase(arg, "-v")) {
             Log::SetLevel(Log::Level::Verbose);
         } else if (EqualsIgnoreCase(arg, "--help") || EqualsIgnoreCase(arg, "-h")) {
@@ -207,6 +217,9 @@ void android_main(struct android_app* app) {
         if (!UpdateOptionsFromSystemProperties(*options)) {
             return;
         }
+        if (app->activity->internalDataPath != nullptr) {
+            options->PipelineCacheFile = std::string(app->activity->internalDataPath) + "/pipeline_cache.bin";
+        }
 
         std::shared_ptr<PlatformData> data = std::make_shared<PlatformData>();
         data->applicationVM = app->activity->vm;
@@ -0,0 +1,84 @@
+// Copyright (c) 2017-2025 The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// The free ranges of one memory block, which MemoryAllocator sub-allocates from. Knows nothing about Vulkan, so the
+// range bookkeeping can be tested on its own.
+struct FreeRanges {
+    struct Range {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    FreeRanges() = default;
+    explicit FreeRanges(uint64_t blockSize) : m_ranges{{0, blockSize}} {}
+
+    // First fit: takes size bytes at the given alignment from the first free range that can hold them, and splits off
+    // what is left on either side. Returns false when no range is large enough.
+    bool Allocate(uint64_t size, uint64_t alignment, uint64_t* offset) {
+        for (auto it = m_ranges.begin(); it != m_ranges.end(); ++it) {
+            const uint64_t aligned = (it->offset + alignment - 1) / alignment * alignment;
+            if (aligned + size > it->offset + it->size) {
+                continue;
+            }
+
+            const Range before{it->offset, aligned - it->offset};
+            const Range after{aligned + size, it->offset + it->size - (aligned + size)};
+            it = m_ranges.erase(it);
+            if (after.size > 0) {
+                it = m_ranges.insert(it, after);
+            }
+            if (before.size > 0) {
+                m_ranges.insert(it, before);
+            }
+            *offset = aligned;
+            return true;
+        }
+        return false;
+    }
+
+    // Puts a range back in offset order and merges it with its neighbours.
+    void Free(uint64_t offset, uint64_t size) {
+        const Range freed{offset, size};
+        auto next = std::lower_bound(m_ranges.begin(), m_ranges.end(), freed,
+                                     [](const Range& a, const Range& b) { return a.offset < b.offset; });
+        auto it = m_ranges.insert(next, freed);
+        if (std::next(it) != m_ranges.end() && it->offset + it->size == std::next(it)->offset) {
+            it->size += std::next(it)->size;
+            m_ranges.erase(std::next(it));
+        }
+        if (it != m_ranges.begin() && std::prev(it)->offset + std::prev(it)->size == it->offset) {
+            std::prev(it)->size += it->size;
+            m_ranges.erase(it);
+        }
+    }
+
+    uint64_t FreeBytes() const {
+        uint64_t freeBytes = 0;
+        for (const auto& range : m_ranges) {
+            freeBytes += range.size;
+        }
+        return freeBytes;
+    }
+
+    uint64_t LargestFreeRange() const {
+        uint64_t largest = 0;
+        for (const auto& range : m_ranges) {
+            largest = std::max(largest, range.size);
+        }
+        return largest;
+    }
+
+    // Sorted by offset, never adjacent.
+    const std::vector<Range>& Ranges() const { return m_ranges; }
+
+   private:
+    std::vector<Range> m_ranges;
+};
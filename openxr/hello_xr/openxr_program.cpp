@@ -88,6 +88,25 @@ inline XrReferenceSpaceCreateInfo GetXrReferenceSpaceCreateInfo(const std::strin
     return referenceSpaceCreateInfo;
 }
 
+// Lays out count 5cm cubes in a grid in front of the app space origin, each turned a little further than the last.
+std::vector<Cube> CreateStressCubes(uint32_t count) {
+    uint32_t side = 1;
+    while (side * side * side < count) {
+        ++side;
+    }
+    const float spacing = 0.15f;
+    const float halfExtent = spacing * (side - 1) / 2;
+
+    std::vector<Cube> cubes;
+    cubes.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const XrVector3f position{(i % side) * spacing - halfExtent, ((i / side) % side) * spacing - halfExtent,
+                                  -1.5f - (i / (side * side)) * spacing};
+        cubes.push_back(Cube{Math::Pose::RotateCCWAboutYAxis(i * 0.1f, position), {0.05f, 0.05f, 0.05f}});
+    }
+    return cubes;
+}
+
 struct OpenXrProgram : IOpenXrProgram {
     OpenXrProgram(const std::shared_ptr<Options>& options, const std::shared_ptr<IPlatformPlugin>& platformPlugin,
                   const std::shared_ptr<IGraphicsPlugin>& graphicsPlugin)
@@ -95,7 +114,8 @@ struct OpenXrProgram : IOpenXrProgram {
           m_platformPlugin(platformPlugin),
           m_graphicsPlugin(graphicsPlugin),
           m_acceptableBlendModes{XR_ENVIRONMENT_BLEND_MODE_OPAQUE, XR_ENVIRONMENT_BLEND_MODE_ADDITIVE,
-                                 XR_ENVIRONMENT_BLEND_MODE_ALPHA_BLEND} {}
+                                 XR_ENVIRONMENT_BLEND_MODE_ALPHA_BLEND},
+          m_stressCubes(CreateStressCubes(options->StressCubeCount)) {}
 
     ~OpenXrProgram() override {
         if (m_input.actionSet != XR_NULL_HANDLE) {
@@ -637,16 +657,35 @@ struct OpenXrProgram : IOpenXrProgram {
                 Log::Write(Log::Level::Verbose, Fmt("Swapchain Formats: %s", swapchainFormatsString.c_str()));
             }
 
-            // Create a swapchain for each view.
-            for (uint32_t i = 0; i < viewCount; i++) {
+            // Views can share one array swapchain, and be rendered in a single pass, if the plugin supports it and they all
+            // have the same recommended size.
+            const XrViewConfigurationView& firstView = m_configViews[0];
+            m_multiView = viewCount > 1 && m_graphicsPlugin->SupportsMultiView() &&
+                          std::all_of(m_configViews.begin(), m_configViews.end(), [&](const XrViewConfigurationView& view) {
+                              return view.recommendedImageRectWidth == firstView.recommendedImageRectWidth &&
+                                     view.recommendedImageRectHeight == firstView.recommendedImageRectHeight &&
+                                     view.recommendedSwapchainSampleCount == firstView.recommendedSwapchainSampleCount;
+                          });
+
+            // Create a swapchain for each view, or a single one with an array slice per view.
+            const uint32_t swapchainCount = m_multiView ? 1 : viewCount;
+            for (uint32_t i = 0; i < swapchainCount; i++) {
                 const XrViewConfigurationView& vp = m_configViews[i];
-                Log::Write(Log::Level::Info,
-                           Fmt("Creating swapchain for view %d with dimensions Width=%d Height=%d SampleCount=%d", i,
-                               vp.recommendedImageRectWidth, vp.recommendedImageRectHeight, vp.recommendedSwapchainSampleCount));
+                if (m_multiView) {
+                    Log::Write(Log::Level::Info,
+                               Fmt("Creating swapchain for %d views with dimensions Width=%d Height=%d SampleCount=%d", viewCount,
+                                   vp.recommendedImageRectWidth, vp.recommendedImageRectHeight,
+                                   vp.recommendedSwapchainSampleCount));
+                } else {
+                    Log::Write(Log::Level::Info,
+                               Fmt("Creating swapchain for view %d with dimensions Width=%d Height=%d SampleCount=%d", i,
+                                   vp.recommendedImageRectWidth, vp.recommendedImageRectHeight,
+                                   vp.recommendedSwapchainSampleCount));
+                }
 
                 // Create the swapchain.
                 XrSwapchainCreateInfo swapchainCreateInfo{XR_TYPE_SWAPCHAIN_CREATE_INFO};
-                swapchainCreateInfo.arraySize = 1;
+                swapchainCreateInfo.arraySize = m_multiView ? viewCount : 1;
                 swapchainCreateInfo.format = m_colorSwapchainFormat;
                 swapchainCreateInfo.width = vp.recommendedImageRectWidth;
                 swapchainCreateInfo.height = vp.recommendedImageRectHeight;
@@ -911,7 +950,7 @@ struct OpenXrProgram : IOpenXrProgram {
 
         CHECK(viewCountOutput == viewCapacityInput);
         CHECK(viewCountOutput == m_configViews.size());
-        CHECK(viewCountOutput == m_swapchains.size());
+        CHECK(m_swapchains.size() == (m_multiView ? 1 : viewCountOutput));
 
         projectionLayerViews.resize(viewCountOutput);
 
@@ -955,32 +994,68 @@ struct OpenXrProgram : IOpenXrProgram {
             }
         }
 
-        // Render view to the appropriate part of the swapchain image.
-        for (uint32_t i = 0; i < viewCountOutput; i++) {
-            // Each view has a separate swapchain which is acquired, rendered to, and released.
-            const Swapchain viewSwapchain = m_swapchains[i];
+        cubes.insert(cubes.end(), m_stressCubes.begin(), m_stressCubes.end());
+
+        // Write the cubes once for all views; plugins with an instanced path then draw them with one call per view.
+        m_graphicsPlugin->UpdateCubeInstances(cubes);
+
+        if (m_multiView) {
+            // All views are rendered in one pass to the array slices of a single swapchain image.
+            const Swapchain swapchain = m_swapchains[0];
 
             XrSwapchainImageAcquireInfo acquireInfo{XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO};
 
             uint32_t swapchainImageIndex;
-            CHECK_XRCMD(xrAcquireSwapchainImage(viewSwapchain.handle, &acquireInfo, &swapchainImageIndex));
+            CHECK_XRCMD(xrAcquireSwapchainImage(swapchain.handle, &acquireInfo, &swapchainImageIndex));
 
             XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
             waitInfo.timeout = XR_INFINITE_DURATION;
-            CHECK_XRCMD(xrWaitSwapchainImage(viewSwapchain.handle, &waitInfo));
-
-            projectionLayerViews[i] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
-            projectionLayerViews[i].pose = m_views[i].pose;
-            projectionLayerViews[i].fov = m_views[i].fov;
-            projectionLayerViews[i].subImage.swapchain = viewSwapchain.handle;
-            projectionLayerViews[i].subImage.imageRect.offset = {0, 0};
-            projectionLayerViews[i].subImage.imageRect.extent = {viewSwapchain.width, viewSwapchain.height};
+            CHECK_XRCMD(xrWaitSwapchainImage(swapchain.handle, &waitInfo));
+
+            for (uint32_t i = 0; i < viewCountOutput; i++) {
+                projectionLayerViews[i] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
+                projectionLayerViews[i].pose = m_views[i].pose;
+                projectionLayerViews[i].fov = m_views[i].fov;
+                projectionLayerViews[i].subImage.swapchain = swapchain.handle;
+                projectionLayerViews[i].subImage.imageRect.offset = {0, 0};
+                projectionLayerViews[i].subImage.imageRect.extent = {swapchain.width, swapchain.height};
+                projectionLayerViews[i].subImage.imageArrayIndex = i;
+            }
 
-            const XrSwapchainImageBaseHeader* const swapchainImage = m_swapchainImages[viewSwapchain.handle][swapchainImageIndex];
-            m_graphicsPlugin->RenderView(projectionLayerViews[i], swapchainImage, m_colorSwapchainFormat, cubes);
+            const XrSwapchainImageBaseHeader* const swapchainImage = m_swapchainImages[swapchain.handle][swapchainImageIndex];
+            m_graphicsPlugin->RenderMultiView(projectionLayerViews, swapchainImage, m_colorSwapchainFormat, cubes);
 
             XrSwapchainImageReleaseInfo releaseInfo{XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
-            CHECK_XRCMD(xrReleaseSwapchainImage(viewSwapchain.handle, &releaseInfo));
+            CHECK_XRCMD(xrReleaseSwapchainImage(swapchain.handle, &releaseInfo));
+        } else {
+            // Render view to the appropriate part of the swapchain image.
+            for (uint32_t i = 0; i < viewCountOutput; i++) {
+                // Each view has a separate swapchain which is acquired, rendered to, and released.
+                const Swapchain viewSwapchain = m_swapchains[i];
+
+                XrSwapchainImageAcquireInfo acquireInfo{XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO};
+
+                uint32_t swapchainImageIndex;
+                CHECK_XRCMD(xrAcquireSwapchainImage(viewSwapchain.handle, &acquireInfo, &swapchainImageIndex));
+
+                XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
+                waitInfo.timeout = XR_INFINITE_DURATION;
+                CHECK_XRCMD(xrWaitSwapchainImage(viewSwapchain.handle, &waitInfo));
+
+                projectionLayerViews[i] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
+                projectionLayerViews[i].pose = m_views[i].pose;
+                projectionLayerViews[i].fov = m_views[i].fov;
+                projectionLayerViews[i].subImage.swapchain = viewSwapchain.handle;
+                projectionLayerViews[i].subImage.imageRect.offset = {0, 0};
+                projectionLayerViews[i].subImage.imageRect.extent = {viewSwapchain.width, viewSwapchain.height};
+
+                const XrSwapchainImageBaseHeader* const swapchainImage =
+                    m_swapchainImages[viewSwapchain.handle][swapchainImageIndex];
+                m_graphicsPlugin->RenderView(projectionLayerViews[i], swapchainImage, m_colorSwapchainFormat, cubes);
+
+                XrSwapchainImageReleaseInfo releaseInfo{XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO};
+                CHECK_XRCMD(xrReleaseSwapchainImage(viewSwapchain.handle, &releaseInfo));
+            }
         }
 
         layer.space = m_appSpace;
@@ -1004,6 +1079,7 @@ struct OpenXrProgram : IOpenXrProgram {
 
     std::vector<XrViewConfigurationView> m_configViews;
     std::vector<Swapchain> m_swapchains;
+    bool m_multiView{false};  // A single swapchain with an array slice per view
     std::map<XrSwapchain, std::vector<XrSwapchainImageBaseHeader*>> m_swapchainImages;
     std::vector<XrView> m_views;
     int64_t m_colorSwapchainFormat{-1};
@@ -1018,6 +1094,9 @@ struct OpenXrProgram : IOpenXrProgram {
     InputState m_input;
 
     const std::set<XrEnvironmentBlendMode> m_acceptableBlendModes;
+
+    // Extra cubes added to every frame, see Options::StressCubeCount.
+    const std::vector<Cube> m_stressCubes;
 };
 }  // namespace
 
@@ -63,6 +63,12 @@ struct Options {
 
     std::string AppSpace{"Local"};
 
+    // File the Vulkan plugins keep their pipeline cache in between runs. Empty keeps the cache in memory only.
+    std::string PipelineCacheFile;
+
+    // Number of extra cubes to draw in a grid in front of the user, to stress-test cube rendering.
+    uint32_t StressCubeCount{0};
+
     struct {
         XrFormFactor FormFactor{XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY};
 
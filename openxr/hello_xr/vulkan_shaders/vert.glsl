@@ -9,11 +9,14 @@
 
 layout (std140, push_constant) uniform buf
 {
-    mat4 mvp;
+    mat4 viewProj;
 } ubuf;
 
 layout (location = 0) in vec3 Position;
 layout (location = 1) in vec3 Color;
+layout (location = 2) in vec4 InstanceOrientation;
+layout (location = 3) in vec3 InstancePosition;
+layout (location = 4) in vec3 InstanceScale;
 
 layout (location = 0) out vec4 oColor;
 out gl_PerVertex
@@ -25,5 +28,9 @@ void main()
 {
     oColor.rgb  = Color.rgb;
     oColor.a  = 1.0;
-    gl_Position = ubuf.mvp * vec4(Position, 1);
+    // Scale, rotate by the instance's orientation quaternion, then translate.
+    vec3 pos = Position * InstanceScale;
+    vec3 t = 2.0 * cross(InstanceOrientation.xyz, pos);
+    pos += InstanceOrientation.w * t + cross(InstanceOrientation.xyz, t);
+    gl_Position = ubuf.viewProj * vec4(pos + InstancePosition, 1);
 }
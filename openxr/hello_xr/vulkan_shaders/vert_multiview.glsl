@@ -0,0 +1,37 @@
+// Copyright (c) 2017-2025 The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+#version 400
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_EXT_multiview : enable
+
+#pragma vertex
+
+layout (std140, push_constant) uniform buf
+{
+    mat4 viewProj[2];
+} ubuf;
+
+layout (location = 0) in vec3 Position;
+layout (location = 1) in vec3 Color;
+layout (location = 2) in vec4 InstanceOrientation;
+layout (location = 3) in vec3 InstancePosition;
+layout (location = 4) in vec3 InstanceScale;
+
+layout (location = 0) out vec4 oColor;
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    oColor.rgb  = Color.rgb;
+    oColor.a  = 1.0;
+    // Scale, rotate by the instance's orientation quaternion, then translate.
+    vec3 pos = Position * InstanceScale;
+    vec3 t = 2.0 * cross(InstanceOrientation.xyz, pos);
+    pos += InstanceOrientation.w * t + cross(InstanceOrientation.xyz, t);
+    gl_Position = ubuf.viewProj[gl_ViewIndex] * vec4(pos + InstancePosition, 1);
+}
@@ -427,6 +427,12 @@ private:
         } else if (m_apiType == VULKAN) {
 #if defined(XR_USE_GRAPHICS_API_VULKAN)
             m_graphicsAPI = std::make_unique<GraphicsAPI_Vulkan>(m_xrInstance, m_systemID);
+            // Pipelines compiled by an earlier run are loaded from disk instead of being compiled from SPIR-V again.
+#if defined(__ANDROID__)
+            static_cast<GraphicsAPI_Vulkan *>(m_graphicsAPI.get())->LoadPipelineCache(std::string(androidApp->activity->internalDataPath) + "/pipeline_cache.bin");
+#else
+            static_cast<GraphicsAPI_Vulkan *>(m_graphicsAPI.get())->LoadPipelineCache("pipeline_cache.bin");
+#endif
 #endif
         } else {
             XR_TUT_LOG_ERROR("ERROR: Unknown Graphics API.");
@@ -499,8 +505,6 @@ private:
 
         m_indexBuffer = m_graphicsAPI->CreateBuffer({GraphicsAPI::BufferCreateInfo::Type::INDEX, sizeof(uint32_t), sizeof(cubeIndices), &cubeIndices});
 
-        size_t numberOfCuboids = m_maxBlockCount + 2 + 2;
-        m_uniformBuffer_Camera = m_graphicsAPI->CreateBuffer({GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(CameraConstants) * numberOfCuboids, nullptr});
         m_uniformBuffer_Normals = m_graphicsAPI->CreateBuffer({GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(normals), &normals});
 
         if (m_apiType == OPENGL) {
@@ -590,7 +594,6 @@ private:
         m_graphicsAPI->DestroyPipeline(m_pipeline);
         m_graphicsAPI->DestroyShader(m_fragmentShader);
         m_graphicsAPI->DestroyShader(m_vertexShader);
-        m_graphicsAPI->DestroyBuffer(m_uniformBuffer_Camera);
         m_graphicsAPI->DestroyBuffer(m_uniformBuffer_Normals);
         m_graphicsAPI->DestroyBuffer(m_indexBuffer);
         m_graphicsAPI->DestroyBuffer(m_vertexBuffer);
@@ -936,18 +939,17 @@ private:
         }
     }
 
-    size_t renderCuboidIndex = 0;
     void RenderCuboid(XrPosef pose, XrVector3f scale, XrVector3f color) {
         XrMatrix4x4f_CreateTranslationRotationScale(&cameraConstants.model, &pose.position, &pose.orientation, &scale);
 
         XrMatrix4x4f_Multiply(&cameraConstants.modelViewProj, &cameraConstants.viewProj, &cameraConstants.model);
         cameraConstants.color = {color.x, color.y, color.z, 1.0};
-        size_t offsetCameraUB = sizeof(CameraConstants) * renderCuboidIndex;
 
         m_graphicsAPI->SetPipeline(m_pipeline);
 
-        m_graphicsAPI->SetBufferData(m_uniformBuffer_Camera, offsetCameraUB, sizeof(CameraConstants), &cameraConstants);
-        m_graphicsAPI->SetDescriptor({0, m_uniformBuffer_Camera, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false, offsetCameraUB, sizeof(CameraConstants)});
+        // Each cuboid gets its own copy of the camera constants in the per-frame transient buffer.
+        GraphicsAPI::TransientAllocation cameraUB = m_graphicsAPI->AllocateTransientData(&cameraConstants, sizeof(CameraConstants));
+        m_graphicsAPI->SetDescriptor({0, cameraUB.buffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false, cameraUB.offset, sizeof(CameraConstants)});
         m_graphicsAPI->SetDescriptor({1, m_uniformBuffer_Normals, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false, 0, sizeof(normals)});
 
         m_graphicsAPI->UpdateDescriptors();
@@ -955,8 +957,6 @@ private:
         m_graphicsAPI->SetVertexBuffers(&m_vertexBuffer, 1);
         m_graphicsAPI->SetIndexBuffer(m_indexBuffer);
         m_graphicsAPI->DrawIndexed(36);
-
-        renderCuboidIndex++;
     }
 
     void RenderFrame() {
@@ -1086,7 +1086,6 @@ private:
             XrMatrix4x4f_InvertRigidBody(&view, &toView);
             XrMatrix4x4f_Multiply(&cameraConstants.viewProj, &proj, &view);
 
-            renderCuboidIndex = 0;
             // Draw a floor. Scale it by 2 in the X and Z, and 0.1 in the Y,
             RenderCuboid({{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, -m_viewHeightM, 0.0f}}, {2.0f, 0.1f, 2.0f}, {0.4f, 0.5f, 0.5f});
             // Draw a "table".
@@ -1252,8 +1251,6 @@ private:
     // Vertex and index buffers: geometry for our cuboids.
     void *m_vertexBuffer = nullptr;
     void *m_indexBuffer = nullptr;
-    // Camera values constant buffer for the shaders.
-    void *m_uniformBuffer_Camera = nullptr;
     // The normals are stored in a uniform buffer to simplify our vertex geometry.
     void *m_uniformBuffer_Normals = nullptr;
 
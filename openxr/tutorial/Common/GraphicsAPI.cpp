@@ -77,3 +77,36 @@ int64_t GraphicsAPI::SelectDepthSwapchainFormat(const std::vector<int64_t> &form
 
     return *swapchainFormatIt;
 }
+
+GraphicsAPI::TransientAllocation GraphicsAPI::AllocateTransientData(const void *data, size_t size) {
+    // Sub-allocates one uniform buffer with SetBufferData() and wraps around to its start when it's full. Nothing here is
+    // persistently mapped; what keeps in-flight data intact depends on the backend's SetBufferData():
+    // - D3D11 maps with D3D11_MAP_WRITE_DISCARD, so the driver renames the buffer and draws already recorded keep their copy.
+    // - D3D12 maps its upload heap buffer and writes straight into the memory the GPU reads. That is only safe because
+    //   EndRendering() waits for the GPU, so a single BeginRendering()/EndRendering() pair must not allocate more than the
+    //   ring's size (256 KB, or the largest single allocation) or it will overwrite data its own earlier draws still read.
+    const size_t alignment = 256;  // Constant buffer offsets must be multiples of 256 bytes in D3D11 and D3D12.
+    const size_t alignedSize = Align<size_t>(size, alignment);
+    if (alignedSize > transientFallbackSize) {
+        DestroyTransientFallbackBuffer();
+        transientFallbackSize = std::max<size_t>(alignedSize, 256 * 1024);
+        transientFallbackBuffer = CreateBuffer({BufferCreateInfo::Type::UNIFORM, 0, transientFallbackSize, nullptr});
+    }
+    if (transientFallbackOffset + alignedSize > transientFallbackSize) {
+        transientFallbackOffset = 0;
+    }
+
+    const size_t offset = transientFallbackOffset;
+    SetBufferData(transientFallbackBuffer, offset, size, const_cast<void *>(data));
+    transientFallbackOffset += alignedSize;
+    return {transientFallbackBuffer, offset};
+}
+
+void GraphicsAPI::DestroyTransientFallbackBuffer() {
+    if (transientFallbackBuffer) {
+        DestroyBuffer(transientFallbackBuffer);
+    }
+    transientFallbackBuffer = nullptr;
+    transientFallbackSize = 0;
+    transientFallbackOffset = 0;
+}
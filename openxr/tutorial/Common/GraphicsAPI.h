@@ -467,6 +467,11 @@ public:
         Extent2D extent;
     };
 
+    struct TransientAllocation {
+        void* buffer;
+        size_t offset;
+    };
+
 public:
     virtual ~GraphicsAPI() = default;
 
@@ -509,6 +514,9 @@ public:
     virtual void EndRendering() = 0;
 
     virtual void SetBufferData(void* buffer, size_t offset, size_t size, void* data) = 0;
+    // Copies uniform data into memory that stays valid until the GPU has finished the current BeginRendering()/EndRendering() pair.
+    // Bind the result with DescriptorInfo::resource = buffer and DescriptorInfo::bufferOffset = offset.
+    virtual TransientAllocation AllocateTransientData(const void* data, size_t size);
 
     virtual void ClearColor(void* imageView, float r, float g, float b, float a) = 0;
     virtual void ClearDepth(void* imageView, float d) = 0;
@@ -529,4 +537,11 @@ protected:
     virtual const std::vector<int64_t> GetSupportedColorSwapchainFormats() = 0;
     virtual const std::vector<int64_t> GetSupportedDepthSwapchainFormats() = 0;
     bool debugAPI = false;
+
+    // Used by the generic AllocateTransientData() of backends without their own per-frame memory (D3D11 and D3D12).
+    // Vulkan and OpenGL override AllocateTransientData() with per-frame blocks, persistently mapped where the API allows.
+    void DestroyTransientFallbackBuffer();
+    void* transientFallbackBuffer = nullptr;
+    size_t transientFallbackSize = 0;
+    size_t transientFallbackOffset = 0;
 };
@@ -222,6 +222,7 @@ GraphicsAPI_D3D11::GraphicsAPI_D3D11(XrInstance m_xrInstance, XrSystemId systemI
 }
 
 GraphicsAPI_D3D11::~GraphicsAPI_D3D11() {
+    DestroyTransientFallbackBuffer();
     D3D11_SAFE_RELEASE(immediateContext);
     D3D11_SAFE_RELEASE(device);
     D3D11_SAFE_RELEASE(factory);
@@ -291,6 +291,7 @@ GraphicsAPI_D3D12::GraphicsAPI_D3D12(XrInstance m_xrInstance, XrSystemId systemI
 }
 
 GraphicsAPI_D3D12 ::~GraphicsAPI_D3D12() {
+    DestroyTransientFallbackBuffer();
     D3D12_SAFE_RELEASE(SAMPLER_DescriptorHeap);
     D3D12_SAFE_RELEASE(CBV_SRV_UAV_DescriptorHeap);
     D3D12_SAFE_RELEASE(queue);
@@ -415,6 +415,16 @@ GraphicsAPI_OpenGL::GraphicsAPI_OpenGL(XrInstance m_xrInstance, XrSystemId syste
 }
 
 GraphicsAPI_OpenGL::~GraphicsAPI_OpenGL() {
+    PFNGLDELETESYNCPROC glDeleteSync = (PFNGLDELETESYNCPROC)GetExtension("glDeleteSync");  // 3.2+
+    for (TransientFrame &frame : transientFrames) {
+        for (TransientBlock &block : frame.blocks) {
+            DestroyTransientBlock(block);
+        }
+        if (frame.fence) {
+            glDeleteSync(frame.fence);
+        }
+    }
+
     ksGpuWindow_Destroy(&window);
 }
 
@@ -717,6 +727,30 @@ void GraphicsAPI_OpenGL::DestroyPipeline(void *&pipeline) {
 }
 
 void GraphicsAPI_OpenGL::BeginRendering() {
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)GetExtension("glClientWaitSync");  // 3.2+
+    PFNGLDELETESYNCPROC glDeleteSync = (PFNGLDELETESYNCPROC)GetExtension("glDeleteSync");  // 3.2+
+
+    // Reuse the oldest transient frame once the GPU has finished reading from it.
+    transientFrameIndex = (transientFrameIndex + 1) % transientFrameCount;
+    TransientFrame &transientFrame = transientFrames[transientFrameIndex];
+    if (transientFrame.fence) {
+        glClientWaitSync(transientFrame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+        glDeleteSync(transientFrame.fence);
+        transientFrame.fence = nullptr;
+    }
+    // If the last use of this frame overflowed its first block, replace the chain with a single block of the combined size.
+    if (transientFrame.blocks.size() > 1) {
+        size_t totalSize = 0;
+        for (TransientBlock &block : transientFrame.blocks) {
+            totalSize += block.size;
+            DestroyTransientBlock(block);
+        }
+        transientFrame.blocks.clear();
+        transientFrame.blocks.push_back(CreateTransientBlock(totalSize));
+    }
+    transientFrame.blockIndex = 0;
+    transientFrame.offset = 0;
+
     glGenVertexArrays(1, &vertexArray);
     glBindVertexArray(vertexArray);
 
@@ -725,6 +759,9 @@ void GraphicsAPI_OpenGL::BeginRendering() {
 }
 
 void GraphicsAPI_OpenGL::EndRendering() {
+    PFNGLFENCESYNCPROC glFenceSync = (PFNGLFENCESYNCPROC)GetExtension("glFenceSync");  // 3.2+
+    transientFrames[transientFrameIndex].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glDeleteFramebuffers(1, &setFramebuffer);
     setFramebuffer = 0;
@@ -757,6 +794,68 @@ void GraphicsAPI_OpenGL::SetBufferData(void *buffer, size_t offset, size_t size,
     }
 }
 
+GraphicsAPI_OpenGL::TransientAllocation GraphicsAPI_OpenGL::AllocateTransientData(const void *data, size_t size) {
+    if (transientAlignment == 0) {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        transientAlignment = std::max<size_t>((size_t)alignment, 16);
+        transientPersistentMapping = (GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage);
+    }
+
+    TransientFrame &frame = transientFrames[transientFrameIndex];
+    size_t offset = Align<size_t>(frame.offset, transientAlignment);
+    while (frame.blockIndex < frame.blocks.size() && offset + size > frame.blocks[frame.blockIndex].size) {
+        frame.blockIndex++;
+        offset = 0;
+    }
+    if (frame.blockIndex == frame.blocks.size()) {
+        size_t blockSize = frame.blocks.empty() ? transientBlockSize : frame.blocks.back().size * 2;
+        frame.blocks.push_back(CreateTransientBlock(std::max(blockSize, size)));
+        offset = 0;
+    }
+
+    TransientBlock &block = frame.blocks[frame.blockIndex];
+    if (block.mappedData) {
+        memcpy(block.mappedData + offset, data, size);
+    } else {
+        glBindBuffer(GL_UNIFORM_BUFFER, block.buffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    frame.offset = offset + size;
+    return {(void *)(uint64_t)block.buffer, offset};
+}
+
+GraphicsAPI_OpenGL::TransientBlock GraphicsAPI_OpenGL::CreateTransientBlock(size_t size) {
+    PFNGLBUFFERSTORAGEPROC glBufferStorage = (PFNGLBUFFERSTORAGEPROC)GetExtension("glBufferStorage");  // 4.4+
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)GetExtension("glMapBufferRange");  // 3.0+
+
+    TransientBlock block;
+    block.size = size;
+    glGenBuffers(1, &block.buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, block.buffer);
+    if (transientPersistentMapping) {
+        // Written by the CPU while the GPU reads earlier ranges; the per-frame fences keep the ranges apart.
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, (GLsizeiptr)size, nullptr, flags);
+        block.mappedData = (uint8_t *)glMapBufferRange(GL_UNIFORM_BUFFER, 0, (GLsizeiptr)size, flags);
+    } else {
+        glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)size, nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return block;
+}
+
+void GraphicsAPI_OpenGL::DestroyTransientBlock(TransientBlock &block) {
+    if (block.mappedData) {
+        glBindBuffer(GL_UNIFORM_BUFFER, block.buffer);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &block.buffer);
+    block = {};
+}
+
 void GraphicsAPI_OpenGL::ClearColor(void *imageView, float r, float g, float b, float a) {
     glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)(uint64_t)imageView);
     glClearColor(r, g, b, a);
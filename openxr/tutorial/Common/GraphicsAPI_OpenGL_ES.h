@@ -53,6 +53,7 @@ public:
     virtual void EndRendering() override;
 
     virtual void SetBufferData(void* buffer, size_t offset, size_t size, void* data) override;
+    virtual TransientAllocation AllocateTransientData(const void* data, size_t size) override;
 
     virtual void ClearColor(void* imageView, float r, float g, float b, float a) override;
     virtual void ClearDepth(void* imageView, float d) override;
@@ -73,6 +74,20 @@ private:
     virtual const std::vector<int64_t> GetSupportedColorSwapchainFormats() override;
     virtual const std::vector<int64_t> GetSupportedDepthSwapchainFormats() override;
 
+    struct TransientBlock {
+        GLuint buffer = 0;
+        uint8_t* mappedData = nullptr;  // nullptr when persistent mapping is unavailable
+        size_t size = 0;
+    };
+    struct TransientFrame {
+        std::vector<TransientBlock> blocks;
+        size_t blockIndex = 0;
+        size_t offset = 0;
+        GLsync fence = nullptr;
+    };
+    TransientBlock CreateTransientBlock(size_t size);
+    void DestroyTransientBlock(TransientBlock& block);
+
 private:
     ksGpuWindow window{};
 
@@ -90,5 +105,12 @@ private:
     GLuint setPipeline = 0;
     GLuint vertexArray = 0;
     GLuint setIndexBuffer = 0;
+
+    static constexpr size_t transientFrameCount = 3;
+    static constexpr size_t transientBlockSize = 64 * 1024;
+    TransientFrame transientFrames[transientFrameCount];
+    size_t transientFrameIndex = 0;
+    size_t transientAlignment = 0;  // queried on first use
+    bool transientPersistentMapping = false;
 };
 #endif
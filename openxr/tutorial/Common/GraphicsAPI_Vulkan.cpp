@@ -9,6 +9,8 @@
 #endif
 #include <GraphicsAPI_Vulkan.h>
 
+#include <cstdio>
+
 #if defined(XR_USE_GRAPHICS_API_VULKAN)
 
 #define VULKAN_CHECK(x, y)                                                                         \
@@ -74,7 +76,8 @@ VkDescriptorType ToVkDescrtiptorType(const GraphicsAPI::DescriptorInfo &descInfo
     switch (descInfo.type) {
     default:
     case GraphicsAPI::DescriptorInfo::Type::BUFFER: {
-        vkType = descInfo.readWrite ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        // Uniform buffers are dynamic so that draws which only differ by their uniform buffer offset can share a descriptor set.
+        vkType = descInfo.readWrite ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         break;
     }
     case GraphicsAPI::DescriptorInfo::Type::IMAGE: {
@@ -206,45 +209,10 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan() {
     deviceCI.pEnabledFeatures = &features;
     VULKAN_CHECK(vkCreateDevice(physicalDevice, &deviceCI, nullptr, &device), "Failed to create Device.");
 
-    VkCommandPoolCreateInfo cmdPoolCI;
-    cmdPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    cmdPoolCI.pNext = nullptr;
-    cmdPoolCI.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    cmdPoolCI.queueFamilyIndex = queueFamilyIndex;
-    VULKAN_CHECK(vkCreateCommandPool(device, &cmdPoolCI, nullptr, &cmdPool), "Failed to create CommandPool.");
-
-    VkCommandBufferAllocateInfo allocateInfo;
-    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.pNext = nullptr;
-    allocateInfo.commandPool = cmdPool;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocateInfo.commandBufferCount = 1;
-    VULKAN_CHECK(vkAllocateCommandBuffers(device, &allocateInfo, &cmdBuffer), "Failed to allocate CommandBuffers.");
-
     vkGetDeviceQueue(device, queueFamilyIndex, queueIndex, &queue);
 
-    VkFenceCreateInfo fenceCI{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
-    fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCI.pNext = nullptr;
-    fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-    VULKAN_CHECK(vkCreateFence(device, &fenceCI, nullptr, &fence), "Failed to create Fence.")
-
-    uint32_t maxSets = 1024;
-    std::vector<VkDescriptorPoolSize> poolSizes{
-        {VK_DESCRIPTOR_TYPE_SAMPLER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 16 * maxSets}};
-
-    VkDescriptorPoolCreateInfo descPoolCI;
-    descPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    descPoolCI.pNext = nullptr;
-    descPoolCI.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-    descPoolCI.maxSets = maxSets;
-    descPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    descPoolCI.pPoolSizes = poolSizes.data();
-    VULKAN_CHECK(vkCreateDescriptorPool(device, &descPoolCI, nullptr, &descriptorPool), "Failed to create DescriptorPool");
+    CreatePipelineCache({});
+    CreateFrameResources(XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT);
 }
 
 GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId systemId) {
@@ -379,54 +347,24 @@ GraphicsAPI_Vulkan::GraphicsAPI_Vulkan(XrInstance m_xrInstance, XrSystemId syste
     deviceCI.pEnabledFeatures = &features;
     VULKAN_CHECK(vkCreateDevice(physicalDevice, &deviceCI, nullptr, &device), "Failed to create Device.");
 
-    VkCommandPoolCreateInfo cmdPoolCI;
-    cmdPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    cmdPoolCI.pNext = nullptr;
-    cmdPoolCI.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    cmdPoolCI.queueFamilyIndex = queueFamilyIndex;
-    VULKAN_CHECK(vkCreateCommandPool(device, &cmdPoolCI, nullptr, &cmdPool), "Failed to create CommandPool.");
-
-    VkCommandBufferAllocateInfo allocateInfo;
-    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocateInfo.pNext = nullptr;
-    allocateInfo.commandPool = cmdPool;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocateInfo.commandBufferCount = 1;
-    VULKAN_CHECK(vkAllocateCommandBuffers(device, &allocateInfo, &cmdBuffer), "Failed to allocate CommandBuffers.");
-
     vkGetDeviceQueue(device, queueFamilyIndex, queueIndex, &queue);
 
-    VkFenceCreateInfo fenceCI{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
-    fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCI.pNext = nullptr;
-    fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-    VULKAN_CHECK(vkCreateFence(device, &fenceCI, nullptr, &fence), "Failed to create Fence.")
-
-    uint32_t maxSets = 1024;
-    std::vector<VkDescriptorPoolSize> poolSizes{
-        {VK_DESCRIPTOR_TYPE_SAMPLER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 16 * maxSets},
-        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 16 * maxSets}};
-
-    VkDescriptorPoolCreateInfo descPoolCI;
-    descPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    descPoolCI.pNext = nullptr;
-    descPoolCI.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-    descPoolCI.maxSets = maxSets;
-    descPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-    descPoolCI.pPoolSizes = poolSizes.data();
-    VULKAN_CHECK(vkCreateDescriptorPool(device, &descPoolCI, nullptr, &descriptorPool), "Failed to create DescriptorPool");
+    CreatePipelineCache({});
+    CreateFrameResources(XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT);
 }
 
 GraphicsAPI_Vulkan::~GraphicsAPI_Vulkan() {
-    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    WaitForAllFrames();
+
+    for (const auto &framebuffer : framebufferCache) {
+        vkDestroyFramebuffer(device, framebuffer.second, nullptr);
+    }
+    framebufferCache.clear();
 
-    vkDestroyFence(device, fence, nullptr);
+    DestroyFrameResources();
 
-    vkFreeCommandBuffers(device, cmdPool, 1, &cmdBuffer);
-    vkDestroyCommandPool(device, cmdPool, nullptr);
+    SavePipelineCache();
+    vkDestroyPipelineCache(device, pipelineCache, nullptr);
 
     vkDestroyDevice(device, nullptr);
     vkDestroyInstance(instance, nullptr);
@@ -506,12 +444,9 @@ void *GraphicsAPI_Vulkan::CreateDesktopSwapchain(const SwapchainCreateInfo &swap
 
     surfaces[swapchain] = surface;
 
-    VkSemaphoreCreateInfo semaphoreCI;
-    semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    semaphoreCI.pNext = nullptr;
-    semaphoreCI.flags = 0;
-    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &acquireSemaphore), "Failed to create Acquire Semaphore");
-    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &submitSemaphore), "Failed to create Submit Semaphore");
+    for (FrameResources &frame : frames) {
+        CreateFrameSemaphores(frame);
+    }
 
     return (void *)swapchain;
 }
@@ -537,6 +472,9 @@ void *GraphicsAPI_Vulkan::GetDesktopSwapchainImage(void *swapchain, uint32_t ind
 }
 
 void GraphicsAPI_Vulkan::AcquireDesktopSwapchanImage(void *swapchain, uint32_t &index) {
+    // The acquire semaphore belongs to the frame slot that the next BeginRendering() records into, so claim that slot now.
+    BeginFrameSlot();
+    VkSemaphore acquireSemaphore = frames[frameIndex].acquireSemaphore;
     VULKAN_CHECK(vkAcquireNextImageKHR(device, (VkSwapchainKHR)swapchain, UINT64_MAX, acquireSemaphore, VK_NULL_HANDLE, &index), "Failed to acquire next Image from Swapchain.");
 
     currentDesktopSwapchainImage = (VkImage)GetDesktopSwapchainImage(swapchain, index);
@@ -555,7 +493,7 @@ void GraphicsAPI_Vulkan::PresentDesktopSwapchainImage(void *swapchain, uint32_t
     pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
     pi.pNext = nullptr;
     pi.waitSemaphoreCount = 1;
-    pi.pWaitSemaphores = &submitSemaphore;
+    pi.pWaitSemaphores = &frames[frameIndex].submitSemaphore;
     pi.swapchainCount = 1;
     pi.pSwapchains = &vkSwapchain;
     pi.pImageIndices = &index;
@@ -655,6 +593,8 @@ void *GraphicsAPI_Vulkan::CreateImageView(const ImageViewCreateInfo &imageViewCI
 
 void GraphicsAPI_Vulkan::DestroyImageView(void *&imageView) {
     VkImageView vkImageView = (VkImageView)imageView;
+    DestroyCachedFramebuffers(VK_NULL_HANDLE, vkImageView);
+    ClearDescriptorSetCaches();
     vkDestroyImageView(device, vkImageView, nullptr);
     imageViewResources.erase(vkImageView);
     imageView = nullptr;
@@ -691,6 +631,7 @@ void *GraphicsAPI_Vulkan::CreateSampler(const SamplerCreateInfo &samplerCI) {
 
 void GraphicsAPI_Vulkan::DestroySampler(void *&sampler) {
     vkDestroySampler(device, (VkSampler)sampler, nullptr);
+    ClearDescriptorSetCaches();
     sampler = nullptr;
 }
 
@@ -723,6 +664,11 @@ void *GraphicsAPI_Vulkan::CreateBuffer(const BufferCreateInfo &bufferCI) {
     VULKAN_CHECK(vkAllocateMemory(device, &allocateInfo, nullptr, &memory), "Failed to allocate Memory.");
     VULKAN_CHECK(vkBindBufferMemory(device, buffer, memory, 0), "Failed to bind Memory to Buffer.");
 
+    // Keep the memory mapped for the lifetime of the buffer, so SetBufferData() is a plain memcpy().
+    void *mappedData = nullptr;
+    VULKAN_CHECK(vkMapMemory(device, memory, 0, VK_WHOLE_SIZE, 0, &mappedData), "Can not map Buffer.");
+    bufferMappedData[buffer] = mappedData;
+
     bufferResources[buffer] = {memory, bufferCI};
     SetBufferData((void *)buffer, 0, bufferCI.size, bufferCI.data);
 
@@ -732,9 +678,13 @@ void *GraphicsAPI_Vulkan::CreateBuffer(const BufferCreateInfo &bufferCI) {
 void GraphicsAPI_Vulkan::DestroyBuffer(void *&buffer) {
     VkBuffer vkBuffer = (VkBuffer)buffer;
     VkDeviceMemory memory = bufferResources[vkBuffer].first;
+    vkUnmapMemory(device, memory);
     vkFreeMemory(device, memory, nullptr);
     vkDestroyBuffer(device, vkBuffer, nullptr);
     bufferResources.erase(vkBuffer);
+    bufferMappedData.erase(vkBuffer);
+    bufferLastUse.erase(vkBuffer);
+    ClearDescriptorSetCaches();
     buffer = nullptr;
 }
 
@@ -1058,8 +1008,16 @@ void *GraphicsAPI_Vulkan::CreatePipeline(const PipelineCreateInfo &pipelineCI) {
     GPCI.basePipelineHandle = VK_NULL_HANDLE;
     GPCI.basePipelineIndex = -1;
 
-    VULKAN_CHECK(vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &GPCI, nullptr, &pipeline), "Failed to create Graphics Pipeline.");
-    pipelineResources[pipeline] = {pipelineLayout, descSetLayout, renderPass, pipelineCI};
+    VULKAN_CHECK(vkCreateGraphicsPipelines(device, pipelineCache, 1, &GPCI, nullptr, &pipeline), "Failed to create Graphics Pipeline.");
+
+    std::vector<uint32_t> dynamicBindings;
+    for (const DescriptorInfo &descInfo : pipelineCI.layout) {
+        if (ToVkDescrtiptorType(descInfo) == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+            dynamicBindings.push_back(descInfo.bindingIndex);
+        }
+    }
+    std::sort(dynamicBindings.begin(), dynamicBindings.end());
+    pipelineResources[pipeline] = {pipelineLayout, descSetLayout, renderPass, pipelineCI, dynamicBindings};
 
     return (void *)pipeline;
 }
@@ -1069,29 +1027,17 @@ void GraphicsAPI_Vulkan::DestroyPipeline(void *&pipeline) {
     VkPipelineLayout pipelineLayout = std::get<0>(pipelineResources[vkPipeline]);
     VkDescriptorSetLayout descSetLayout = std::get<1>(pipelineResources[vkPipeline]);
     VkRenderPass renderPass = std::get<2>(pipelineResources[vkPipeline]);
+    DestroyCachedFramebuffers(renderPass, VK_NULL_HANDLE);
     vkDestroyRenderPass(device, renderPass, nullptr);
     vkDestroyDescriptorSetLayout(device, descSetLayout, nullptr);
     vkDestroyPipeline(device, vkPipeline, nullptr);
     pipelineResources.erase(vkPipeline);
+    ClearDescriptorSetCaches();
     pipeline = nullptr;
 }
 
 void GraphicsAPI_Vulkan::BeginRendering() {
-    VULKAN_CHECK(vkWaitForFences(device, 1, &fence, true, UINT64_MAX), "Failed to wait for Fence");
-    VULKAN_CHECK(vkResetFences(device, 1, &fence), "Failed to reset Fence.")
-
-    // VULKAN_CHECK(vkResetDescriptorPool(device, descriptorPool, VkDescriptorPoolResetFlags(0)), "Failed to rest DescriptorPool")
-    for (const auto &descSet : cmdBufferDescriptorSets[cmdBuffer]) {
-        VULKAN_CHECK(vkFreeDescriptorSets(device, descriptorPool, 1, &descSet), "Failed to free DescriptorSet.");
-    }
-    cmdBufferDescriptorSets.erase(cmdBuffer);
-
-    for (const VkFramebuffer &framebuffer : cmdBufferFramebuffers[cmdBuffer]) {
-        vkDestroyFramebuffer(device, framebuffer, nullptr);
-    }
-    cmdBufferFramebuffers.erase(cmdBuffer);
-
-    VULKAN_CHECK(vkResetCommandBuffer(cmdBuffer, VkCommandBufferResetFlagBits(0)), "Failed to reset CommandBuffer.");
+    BeginFrameSlot();
 
     VkCommandBufferBeginInfo beginInfo;
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -1145,6 +1091,9 @@ void GraphicsAPI_Vulkan::EndRendering() {
 
     VULKAN_CHECK(vkEndCommandBuffer(cmdBuffer), "Failed to end CommandBuffer.");
 
+    FrameResources &frame = frames[frameIndex];
+    VkSemaphore acquireSemaphore = frame.acquireSemaphore;
+    VkSemaphore submitSemaphore = frame.submitSemaphore;
     VkPipelineStageFlags waitDstStageMask = VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
     VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
@@ -1158,22 +1107,47 @@ void GraphicsAPI_Vulkan::EndRendering() {
     submitInfo.signalSemaphoreCount = submitSemaphore ? 1 : 0;
     submitInfo.pSignalSemaphores = submitSemaphore ? &submitSemaphore : nullptr;
 
-    VULKAN_CHECK(vkQueueSubmit(queue, 1, &submitInfo, fence), "Failed to submit to Queue.");
+    VULKAN_CHECK(vkQueueSubmit(queue, 1, &submitInfo, frame.fence), "Failed to submit to Queue.");
+    frameSlotReady = false;
 }
 
 void GraphicsAPI_Vulkan::SetBufferData(void *buffer, size_t offset, size_t size, void *data) {
     VkBuffer vkBuffer = (VkBuffer)buffer;
-    VkDeviceMemory memory = bufferResources[vkBuffer].first;
-    void *mappedData = nullptr;
-    VULKAN_CHECK(vkMapMemory(device, memory, offset, size, 0, &mappedData), "Can not map Buffer.");
+    // Don't overwrite data that a frame still in flight may be reading.
+    auto lastUse = bufferLastUse.find(vkBuffer);
+    if (lastUse != bufferLastUse.end()) {
+        WaitForFrameSerial(lastUse->second);
+    }
+
+    uint8_t *mappedData = (uint8_t *)bufferMappedData[vkBuffer];
     if (mappedData && data) {
-        memcpy(mappedData, data, size);
+        memcpy(mappedData + offset, data, size);
         // Because the VkDeviceMemory use a heap with properties (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
         // We don't need to use vkFlushMappedMemoryRanges() or vkInvalidateMappedMemoryRanges()
     }
-    vkUnmapMemory(device, memory);
 };
 
+GraphicsAPI::TransientAllocation GraphicsAPI_Vulkan::AllocateTransientData(const void *data, size_t size) {
+    FrameResources &frame = frames[frameIndex];
+    size_t offset = Align<size_t>(frame.transientOffset, transientAlignment);
+    while (frame.transientBlockIndex < frame.transientBlocks.size() && offset + size > frame.transientBlocks[frame.transientBlockIndex].size) {
+        frame.transientBlockIndex++;
+        offset = 0;
+    }
+    if (frame.transientBlockIndex == frame.transientBlocks.size()) {
+        // Grow by chaining another block for the rest of this frame; BeginFrameSlot() merges the chain once the frame has completed.
+        size_t blockSize = frame.transientBlocks.empty() ? transientBlockSize : frame.transientBlocks.back().size * 2;
+        frame.transientBlocks.push_back(CreateTransientBlock(std::max(blockSize, size)));
+    }
+
+    TransientBlock &block = frame.transientBlocks[frame.transientBlockIndex];
+    if (data) {
+        memcpy(block.mappedData + offset, data, size);
+    }
+    frame.transientOffset = offset + size;
+    return {(void *)block.buffer, offset};
+}
+
 void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b, float a) {
     const ImageViewCreateInfo &imageViewCI = imageViewResources[(VkImageView)imageView];
 
@@ -1192,12 +1166,16 @@ void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b,
 
     VkImage vkImage = (VkImage)(imageViewCI.image);
 
+    // Swapchain images arrive as color attachments, but images created by CreateImage() start out undefined.
+    auto imageState = imageStates.find(vkImage);
+    VkImageLayout oldLayout = imageState != imageStates.end() ? imageState->second : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
     VkImageMemoryBarrier imageBarrier;
     imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     imageBarrier.pNext = nullptr;
     imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
     imageBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    imageBarrier.oldLayout = oldLayout;
     imageBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -1216,6 +1194,7 @@ void GraphicsAPI_Vulkan::ClearColor(void *imageView, float r, float g, float b,
     imageBarrier.image = vkImage;
     imageBarrier.subresourceRange = range;
     vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VkDependencyFlagBits(0), 0, nullptr, 0, nullptr, 1, &imageBarrier);
+    imageStates[vkImage] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 }
 
 void GraphicsAPI_Vulkan::ClearDepth(void *imageView, float d) {
@@ -1267,27 +1246,37 @@ void GraphicsAPI_Vulkan::SetRenderAttachments(void **colorViews, size_t colorVie
 
     VkRenderPass renderPass = std::get<2>(pipelineResources[(VkPipeline)pipeline]);
 
-    std::vector<VkImageView> vkImageViews;
+    FramebufferKey key;
+    key.renderPass = renderPass;
+    if (colorViewCount + (depthStencilView ? 1 : 0) > maxFramebufferAttachments) {
+        std::cout << "ERROR: VULKAN: Too many attachments for a framebuffer: " << colorViewCount << " color views." << std::endl;
+        DEBUG_BREAK;
+        return;
+    }
     for (size_t i = 0; i < colorViewCount; i++) {
-        vkImageViews.push_back((VkImageView)colorViews[i]);
+        key.attachments[key.attachmentCount++] = (VkImageView)colorViews[i];
     }
     if (depthStencilView) {
-        vkImageViews.push_back((VkImageView)depthStencilView);
-    }
-
-    VkFramebuffer framebuffer{};
-    VkFramebufferCreateInfo framebufferCI;
-    framebufferCI.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-    framebufferCI.pNext = nullptr;
-    framebufferCI.flags = 0;
-    framebufferCI.renderPass = renderPass;
-    framebufferCI.attachmentCount = static_cast<uint32_t>(vkImageViews.size());
-    framebufferCI.pAttachments = vkImageViews.data();
-    framebufferCI.width = width;
-    framebufferCI.height = height;
-    framebufferCI.layers = 1;
-    VULKAN_CHECK(vkCreateFramebuffer(device, &framebufferCI, nullptr, &framebuffer), "Failed to create Framebuffer");
-    cmdBufferFramebuffers[cmdBuffer].push_back(framebuffer);
+        key.attachments[key.attachmentCount++] = (VkImageView)depthStencilView;
+    }
+    key.width = width;
+    key.height = height;
+
+    // Framebuffers live as long as their render pass and attachments, so each OpenXR swapchain image re-uses the framebuffer created the first time it was rendered to.
+    VkFramebuffer &framebuffer = framebufferCache[key];
+    if (framebuffer == VK_NULL_HANDLE) {
+        VkFramebufferCreateInfo framebufferCI;
+        framebufferCI.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferCI.pNext = nullptr;
+        framebufferCI.flags = 0;
+        framebufferCI.renderPass = renderPass;
+        framebufferCI.attachmentCount = key.attachmentCount;
+        framebufferCI.pAttachments = key.attachments.data();
+        framebufferCI.width = width;
+        framebufferCI.height = height;
+        framebufferCI.layers = 1;
+        VULKAN_CHECK(vkCreateFramebuffer(device, &framebufferCI, nullptr, &framebuffer), "Failed to create Framebuffer");
+    }
 
     VkRenderPassBeginInfo renderPassBegin;
     renderPassBegin.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -1295,8 +1284,8 @@ void GraphicsAPI_Vulkan::SetRenderAttachments(void **colorViews, size_t colorVie
     renderPassBegin.renderPass = renderPass;
     renderPassBegin.framebuffer = framebuffer;
     renderPassBegin.renderArea.offset = {0, 0};
-    renderPassBegin.renderArea.extent.width = framebufferCI.width;
-    renderPassBegin.renderArea.extent.height = framebufferCI.height;
+    renderPassBegin.renderArea.extent.width = width;
+    renderPassBegin.renderArea.extent.height = height;
     renderPassBegin.clearValueCount = 0;
     renderPassBegin.pClearValues = nullptr;
     vkCmdBeginRenderPass(cmdBuffer, &renderPassBegin, VK_SUBPASS_CONTENTS_INLINE);
@@ -1340,15 +1329,21 @@ void GraphicsAPI_Vulkan::SetDescriptor(const DescriptorInfo &descriptorInfo) {
     writeDescSet.pImageInfo = nullptr;
     writeDescSet.pBufferInfo = nullptr;
     writeDescSet.pTexelBufferView = nullptr;
-    writeDescSets.push_back({writeDescSet, {}, {}});
+    writeDescSets.push_back({writeDescSet, {}, {}, 0});
 
     if (descriptorInfo.type == DescriptorInfo::Type::BUFFER) {
         VkDescriptorBufferInfo &descBufferInfo = std::get<1>(writeDescSets.back());
         VkBuffer buffer = (VkBuffer)descriptorInfo.resource;
         const BufferCreateInfo &bufferCI = bufferResources[buffer].second;
+        bufferLastUse[buffer] = frames[frameIndex].serial;
         descBufferInfo.buffer = buffer;
         descBufferInfo.offset = descriptorInfo.bufferOffset;
         descBufferInfo.range = descriptorInfo.bufferSize;
+        if (writeDescSet.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+            // The offset is applied when binding, so it's not part of the descriptor set.
+            std::get<3>(writeDescSets.back()) = static_cast<uint32_t>(descriptorInfo.bufferOffset);
+            descBufferInfo.offset = 0;
+        }
     } else if (descriptorInfo.type == DescriptorInfo::Type::IMAGE) {
         VkDescriptorImageInfo &descImageInfo = std::get<2>(writeDescSets.back());
         VkImageView imageView = (VkImageView)descriptorInfo.resource;
@@ -1368,41 +1363,78 @@ void GraphicsAPI_Vulkan::SetDescriptor(const DescriptorInfo &descriptorInfo) {
     }
 }
 
-void GraphicsAPI_Vulkan::UpdateDescriptors() {
-    VkPipelineLayout pipelineLayout = std::get<0>(pipelineResources[(VkPipeline)setPipeline]);
-    VkDescriptorSetLayout descSetLayout = std::get<1>(pipelineResources[(VkPipeline)setPipeline]);
-    PipelineCreateInfo pipelinCI = std::get<3>(pipelineResources[(VkPipeline)setPipeline]);
-
-    VkDescriptorSet descSet{};
-    VkDescriptorSetAllocateInfo descSetAI;
-    descSetAI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    descSetAI.pNext = nullptr;
-    descSetAI.descriptorPool = descriptorPool;
-    descSetAI.descriptorSetCount = 1;
-    descSetAI.pSetLayouts = &descSetLayout;
-    VULKAN_CHECK(vkAllocateDescriptorSets(device, &descSetAI, &descSet), "Failed to allocate DescriptorSet.");
-
-    std::vector<VkWriteDescriptorSet> vkWriteDescSets;
-    for (auto &writeDescSet : writeDescSets) {
-        VkWriteDescriptorSet &vkWriteDescSet = std::get<0>(writeDescSet);
-        VkDescriptorBufferInfo &vkDescBufferInfo = std::get<1>(writeDescSet);
-        VkDescriptorImageInfo &vkDescImageInfo = std::get<2>(writeDescSet);
-
-        vkWriteDescSet.dstSet = descSet;
+void GraphicsAPI_Vulkan::BuildDescriptorSetKey(VkDescriptorSetLayout descSetLayout, const std::vector<uint32_t> &dynamicBindings, std::vector<PendingDescriptorWrite> &writes, std::vector<uint64_t> &key, std::vector<uint32_t> &dynamicOffsets) {
+    std::sort(writes.begin(), writes.end(), [](const auto &a, const auto &b) { return std::get<0>(a).dstBinding < std::get<0>(b).dstBinding; });
+
+    key.clear();
+    key.push_back((uint64_t)descSetLayout);
+    for (const PendingDescriptorWrite &writeDescSet : writes) {
+        const VkWriteDescriptorSet &vkWriteDescSet = std::get<0>(writeDescSet);
+        const VkDescriptorBufferInfo &vkDescBufferInfo = std::get<1>(writeDescSet);
+        const VkDescriptorImageInfo &vkDescImageInfo = std::get<2>(writeDescSet);
+        key.push_back(((uint64_t)vkWriteDescSet.dstBinding << 32) | (uint64_t)vkWriteDescSet.descriptorType);
         if (vkDescBufferInfo.buffer) {
-            vkWriteDescSet.pBufferInfo = &vkDescBufferInfo;
-        } else if (vkDescImageInfo.imageView || vkDescImageInfo.sampler) {
-            vkWriteDescSet.pImageInfo = &vkDescImageInfo;
+            key.push_back((uint64_t)vkDescBufferInfo.buffer);
+            key.push_back((uint64_t)vkDescBufferInfo.offset);
+            key.push_back((uint64_t)vkDescBufferInfo.range);
         } else {
-            continue;
+            key.push_back((uint64_t)vkDescImageInfo.imageView);
+            key.push_back((uint64_t)vkDescImageInfo.sampler);
+            key.push_back((uint64_t)vkDescImageInfo.imageLayout);
+        }
+    }
+
+    // vkCmdBindDescriptorSets takes one offset for every dynamic descriptor in the set layout, in binding order, including any this draw didn't write.
+    dynamicOffsets.clear();
+    size_t w = 0;
+    for (uint32_t binding : dynamicBindings) {
+        while (w < writes.size() && std::get<0>(writes[w]).dstBinding < binding) {
+            w++;
+        }
+        const bool written = w < writes.size() && std::get<0>(writes[w]).dstBinding == binding && std::get<0>(writes[w]).descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        dynamicOffsets.push_back(written ? std::get<3>(writes[w]) : 0);
+    }
+}
+
+void GraphicsAPI_Vulkan::UpdateDescriptors() {
+    const auto &resources = pipelineResources[(VkPipeline)setPipeline];
+    VkPipelineLayout pipelineLayout = std::get<0>(resources);
+    VkDescriptorSetLayout descSetLayout = std::get<1>(resources);
+    BuildDescriptorSetKey(descSetLayout, std::get<4>(resources), writeDescSets, descSetKey, dynamicOffsets);
+
+    // Draws that bind the same resources share one descriptor set for the rest of the frame.
+    FrameResources &frame = frames[frameIndex];
+    VkDescriptorSet &descSet = frame.descriptorSetCache[descSetKey];
+    if (descSet == VK_NULL_HANDLE) {
+        VkDescriptorSetAllocateInfo descSetAI;
+        descSetAI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        descSetAI.pNext = nullptr;
+        descSetAI.descriptorPool = frame.descriptorPool;
+        descSetAI.descriptorSetCount = 1;
+        descSetAI.pSetLayouts = &descSetLayout;
+        VULKAN_CHECK(vkAllocateDescriptorSets(device, &descSetAI, &descSet), "Failed to allocate DescriptorSet.");
+
+        std::vector<VkWriteDescriptorSet> vkWriteDescSets;
+        for (auto &writeDescSet : writeDescSets) {
+            VkWriteDescriptorSet &vkWriteDescSet = std::get<0>(writeDescSet);
+            VkDescriptorBufferInfo &vkDescBufferInfo = std::get<1>(writeDescSet);
+            VkDescriptorImageInfo &vkDescImageInfo = std::get<2>(writeDescSet);
+
+            vkWriteDescSet.dstSet = descSet;
+            if (vkDescBufferInfo.buffer) {
+                vkWriteDescSet.pBufferInfo = &vkDescBufferInfo;
+            } else if (vkDescImageInfo.imageView || vkDescImageInfo.sampler) {
+                vkWriteDescSet.pImageInfo = &vkDescImageInfo;
+            } else {
+                continue;
+            }
+            vkWriteDescSets.push_back(vkWriteDescSet);
         }
-        vkWriteDescSets.push_back(vkWriteDescSet);
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(vkWriteDescSets.size()), vkWriteDescSets.data(), 0, nullptr);
     }
-    vkUpdateDescriptorSets(device, static_cast<uint32_t>(vkWriteDescSets.size()), vkWriteDescSets.data(), 0, nullptr);
     writeDescSets.clear();
 
-    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descSet, 0, nullptr);
-    cmdBufferDescriptorSets[cmdBuffer].push_back({descSet});
+    vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descSet, static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 }
 
 void GraphicsAPI_Vulkan::SetVertexBuffers(void **vertexBuffers, size_t count) {
@@ -1411,6 +1443,7 @@ void GraphicsAPI_Vulkan::SetVertexBuffers(void **vertexBuffers, size_t count) {
     for (size_t i = 0; i < count; i++) {
         vkBuffers.push_back((VkBuffer)vertexBuffers[i]);
         offsets.push_back(0);
+        bufferLastUse[vkBuffers.back()] = frames[frameIndex].serial;
     }
 
     vkCmdBindVertexBuffers(cmdBuffer, 0, static_cast<uint32_t>(vkBuffers.size()), vkBuffers.data(), offsets.data());
@@ -1419,6 +1452,7 @@ void GraphicsAPI_Vulkan::SetVertexBuffers(void **vertexBuffers, size_t count) {
 void GraphicsAPI_Vulkan::SetIndexBuffer(void *indexBuffer) {
     const BufferCreateInfo &bufferCI = bufferResources[(VkBuffer)indexBuffer].second;
     VkIndexType type = bufferCI.stride == 4 ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+    bufferLastUse[(VkBuffer)indexBuffer] = frames[frameIndex].serial;
     vkCmdBindIndexBuffer(cmdBuffer, (VkBuffer)indexBuffer, 0, type);
 }
 
@@ -1430,6 +1464,284 @@ void GraphicsAPI_Vulkan::Draw(uint32_t vertexCount, uint32_t instanceCount, uint
     vkCmdDraw(cmdBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
+void GraphicsAPI_Vulkan::SetFramesInFlight(uint32_t count) {
+    WaitForAllFrames();
+    DestroyFrameResources();
+    CreateFrameResources(count);
+}
+
+void GraphicsAPI_Vulkan::CreateFrameResources(uint32_t count) {
+    uint32_t maxSets = 1024;
+    std::vector<VkDescriptorPoolSize> poolSizes{
+        {VK_DESCRIPTOR_TYPE_SAMPLER, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 16 * maxSets},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 16 * maxSets}};
+
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    transientAlignment = std::max<size_t>(static_cast<size_t>(physicalDeviceProperties.limits.minUniformBufferOffsetAlignment), 16);
+
+    frames.resize(count > 0 ? count : 1);
+    for (FrameResources &frame : frames) {
+        // Everything recorded into a frame slot is released at once when the slot is re-used, so the pools are reset as a whole.
+        VkCommandPoolCreateInfo cmdPoolCI;
+        cmdPoolCI.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        cmdPoolCI.pNext = nullptr;
+        cmdPoolCI.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        cmdPoolCI.queueFamilyIndex = queueFamilyIndex;
+        VULKAN_CHECK(vkCreateCommandPool(device, &cmdPoolCI, nullptr, &frame.cmdPool), "Failed to create CommandPool.");
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = frame.cmdPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = 1;
+        VULKAN_CHECK(vkAllocateCommandBuffers(device, &allocateInfo, &frame.cmdBuffer), "Failed to allocate CommandBuffers.");
+
+        VkFenceCreateInfo fenceCI{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        fenceCI.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCI.pNext = nullptr;
+        fenceCI.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        VULKAN_CHECK(vkCreateFence(device, &fenceCI, nullptr, &frame.fence), "Failed to create Fence.")
+
+        VkDescriptorPoolCreateInfo descPoolCI;
+        descPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        descPoolCI.pNext = nullptr;
+        descPoolCI.flags = 0;
+        descPoolCI.maxSets = maxSets;
+        descPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        descPoolCI.pPoolSizes = poolSizes.data();
+        VULKAN_CHECK(vkCreateDescriptorPool(device, &descPoolCI, nullptr, &frame.descriptorPool), "Failed to create DescriptorPool");
+
+        if (!surfaces.empty()) {
+            CreateFrameSemaphores(frame);
+        }
+        frame.serial = 0;
+    }
+
+    frameIndex = static_cast<uint32_t>(frames.size()) - 1;
+    frameSlotReady = false;
+    cmdBuffer = VK_NULL_HANDLE;
+}
+
+void GraphicsAPI_Vulkan::CreateFrameSemaphores(FrameResources &frame) {
+    if (frame.acquireSemaphore) {
+        return;
+    }
+    VkSemaphoreCreateInfo semaphoreCI;
+    semaphoreCI.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCI.pNext = nullptr;
+    semaphoreCI.flags = 0;
+    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &frame.acquireSemaphore), "Failed to create Acquire Semaphore");
+    VULKAN_CHECK(vkCreateSemaphore(device, &semaphoreCI, nullptr, &frame.submitSemaphore), "Failed to create Submit Semaphore");
+}
+
+void GraphicsAPI_Vulkan::DestroyFrameResources() {
+    for (FrameResources &frame : frames) {
+        for (TransientBlock &block : frame.transientBlocks) {
+            DestroyTransientBlock(block);
+        }
+        vkDestroyDescriptorPool(device, frame.descriptorPool, nullptr);
+        vkDestroyFence(device, frame.fence, nullptr);
+        vkFreeCommandBuffers(device, frame.cmdPool, 1, &frame.cmdBuffer);
+        vkDestroyCommandPool(device, frame.cmdPool, nullptr);
+        if (frame.acquireSemaphore) {
+            vkDestroySemaphore(device, frame.acquireSemaphore, nullptr);
+            vkDestroySemaphore(device, frame.submitSemaphore, nullptr);
+        }
+    }
+    frames.clear();
+    cmdBuffer = VK_NULL_HANDLE;
+}
+
+void GraphicsAPI_Vulkan::BeginFrameSlot() {
+    if (frameSlotReady) {
+        return;
+    }
+
+    // Only the oldest frame in flight has to finish before its slot is recorded into again; the others keep running on the GPU.
+    frameIndex = (frameIndex + 1) % static_cast<uint32_t>(frames.size());
+    FrameResources &frame = frames[frameIndex];
+    VULKAN_CHECK(vkWaitForFences(device, 1, &frame.fence, true, UINT64_MAX), "Failed to wait for Fence");
+    VULKAN_CHECK(vkResetFences(device, 1, &frame.fence), "Failed to reset Fence.")
+    completedFrameSerial = std::max(completedFrameSerial, frame.serial);
+
+    VULKAN_CHECK(vkResetDescriptorPool(device, frame.descriptorPool, VkDescriptorPoolResetFlags(0)), "Failed to reset DescriptorPool.");
+    frame.descriptorSetCache.clear();
+
+    if (frame.transientBlocks.size() > 1) {
+        // The previous frame in this slot outgrew its transient memory. Replace the chain with one block large enough for all of it.
+        size_t blockSize = 0;
+        for (TransientBlock &block : frame.transientBlocks) {
+            blockSize += block.size;
+            DestroyTransientBlock(block);
+        }
+        frame.transientBlocks.clear();
+        frame.transientBlocks.push_back(CreateTransientBlock(blockSize));
+    }
+    frame.transientBlockIndex = 0;
+    frame.transientOffset = 0;
+    VULKAN_CHECK(vkResetCommandPool(device, frame.cmdPool, VkCommandPoolResetFlags(0)), "Failed to reset CommandPool.");
+
+    frame.serial = ++frameSerial;
+    cmdBuffer = frame.cmdBuffer;
+    frameSlotReady = true;
+}
+
+void GraphicsAPI_Vulkan::WaitForFrameSerial(uint64_t serial) {
+    if (serial <= completedFrameSerial) {
+        return;
+    }
+    for (uint32_t i = 0; i < static_cast<uint32_t>(frames.size()); i++) {
+        FrameResources &frame = frames[i];
+        if (frame.serial != serial) {
+            continue;
+        }
+        if (frameSlotReady && i == frameIndex) {
+            // Still being recorded, so nothing has been submitted yet.
+            return;
+        }
+        VULKAN_CHECK(vkWaitForFences(device, 1, &frame.fence, true, UINT64_MAX), "Failed to wait for Fence");
+        // The queue executes frames in submission order, so every earlier frame has completed too.
+        completedFrameSerial = serial;
+        return;
+    }
+}
+
+void GraphicsAPI_Vulkan::WaitForAllFrames() {
+    VULKAN_CHECK(vkQueueWaitIdle(queue), "Failed to wait for Queue.");
+    completedFrameSerial = frameSlotReady ? frameSerial - 1 : frameSerial;
+}
+
+GraphicsAPI_Vulkan::TransientBlock GraphicsAPI_Vulkan::CreateTransientBlock(size_t size) {
+    TransientBlock block;
+    block.size = Align<size_t>(size, transientAlignment);
+    block.buffer = (VkBuffer)CreateBuffer({BufferCreateInfo::Type::UNIFORM, 0, block.size, nullptr});
+    block.mappedData = (uint8_t *)bufferMappedData[block.buffer];
+    return block;
+}
+
+void GraphicsAPI_Vulkan::DestroyTransientBlock(TransientBlock &block) {
+    void *buffer = (void *)block.buffer;
+    DestroyBuffer(buffer);
+    block = {};
+}
+
+void GraphicsAPI_Vulkan::CreatePipelineCache(const std::vector<char> &initialData) {
+    VkPipelineCacheCreateInfo pipelineCacheCI;
+    pipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCI.pNext = nullptr;
+    pipelineCacheCI.flags = 0;
+    pipelineCacheCI.initialDataSize = initialData.size();
+    pipelineCacheCI.pInitialData = initialData.empty() ? nullptr : initialData.data();
+    VULKAN_CHECK(vkCreatePipelineCache(device, &pipelineCacheCI, nullptr, &pipelineCache), "Failed to create PipelineCache.");
+}
+
+void GraphicsAPI_Vulkan::LoadPipelineCache(const std::string &path) {
+    pipelineCachePath = path;
+
+    std::ifstream stream(path, std::fstream::in | std::fstream::binary | std::fstream::ate);
+    if (!stream.is_open()) {
+        std::cout << "Vulkan: No PipelineCache at " << path << ", pipelines will be compiled from SPIR-V." << std::endl;
+        return;
+    }
+    std::vector<char> data(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0, std::fstream::beg);
+    stream.read(data.data(), static_cast<std::streamsize>(data.size()));
+    stream.close();
+
+    // Data from another driver or device would be ignored at best, so check the header before handing it to Vulkan.
+    VkPhysicalDeviceProperties physicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &physicalDeviceProperties);
+    VkPipelineCacheHeaderVersionOne header{};
+    if (data.size() < sizeof(header)) {
+        std::cout << "Vulkan: Ignoring PipelineCache at " << path << ", the file is truncated." << std::endl;
+        return;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.headerSize < sizeof(header) || header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE || header.vendorID != physicalDeviceProperties.vendorID || header.deviceID != physicalDeviceProperties.deviceID || memcmp(header.pipelineCacheUUID, physicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        std::cout << "Vulkan: Ignoring PipelineCache at " << path << ", it was written by a different driver or device." << std::endl;
+        return;
+    }
+
+    // Keep anything already compiled by merging the current cache into the loaded one.
+    VkPipelineCache currentPipelineCache = pipelineCache;
+    CreatePipelineCache(data);
+    VULKAN_CHECK(vkMergePipelineCaches(device, pipelineCache, 1, &currentPipelineCache), "Failed to merge PipelineCaches.");
+    vkDestroyPipelineCache(device, currentPipelineCache, nullptr);
+    pipelineCacheSavedSize = data.size();
+    std::cout << "Vulkan: Loaded PipelineCache of " << data.size() << " bytes from " << path << "." << std::endl;
+}
+
+void GraphicsAPI_Vulkan::SavePipelineCache() {
+    if (pipelineCachePath.empty()) {
+        return;
+    }
+
+    // Caches only grow, so an unchanged size means there is nothing new to write.
+    size_t dataSize = 0;
+    VULKAN_CHECK(vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr), "Failed to get PipelineCache data size.");
+    if (dataSize == pipelineCacheSavedSize) {
+        return;
+    }
+    std::vector<char> data(dataSize);
+    VULKAN_CHECK(vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data()), "Failed to get PipelineCache data.");
+
+    // Write a temporary file and rename it over the old one, so a crash or a full disk never leaves a torn cache behind.
+    const std::string tempPath = pipelineCachePath + ".tmp";
+    std::ofstream stream(tempPath, std::fstream::out | std::fstream::binary | std::fstream::trunc);
+    if (!stream.is_open()) {
+        std::cout << "Vulkan: Could not write PipelineCache to " << tempPath << "." << std::endl;
+        return;
+    }
+    stream.write(data.data(), static_cast<std::streamsize>(dataSize));
+    stream.close();
+    if (stream.fail()) {
+        std::cout << "Vulkan: Could not write PipelineCache to " << tempPath << "." << std::endl;
+        std::remove(tempPath.c_str());
+        return;
+    }
+#if defined(_WIN32)
+    // rename() doesn't replace an existing file on Windows.
+    std::remove(pipelineCachePath.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), pipelineCachePath.c_str()) != 0) {
+        std::cout << "Vulkan: Could not replace PipelineCache at " << pipelineCachePath << "." << std::endl;
+        std::remove(tempPath.c_str());
+        return;
+    }
+    pipelineCacheSavedSize = dataSize;
+}
+
+void GraphicsAPI_Vulkan::ClearDescriptorSetCaches() {
+    // The sets stay allocated until their pool is reset, but a new resource might re-use the destroyed one's handle.
+    for (FrameResources &frame : frames) {
+        frame.descriptorSetCache.clear();
+    }
+}
+
+void GraphicsAPI_Vulkan::DestroyCachedFramebuffers(VkRenderPass renderPass, VkImageView imageView) {
+    bool waited = false;
+    for (auto it = framebufferCache.begin(); it != framebufferCache.end();) {
+        const FramebufferKey &key = it->first;
+        const auto attachmentsEnd = key.attachments.begin() + key.attachmentCount;
+        if (key.renderPass != renderPass && std::find(key.attachments.begin(), attachmentsEnd, imageView) == attachmentsEnd) {
+            ++it;
+            continue;
+        }
+        if (!waited) {
+            WaitForAllFrames();
+            waited = true;
+        }
+        vkDestroyFramebuffer(device, it->second, nullptr);
+        it = framebufferCache.erase(it);
+    }
+}
+
 void GraphicsAPI_Vulkan::LoadPFN_XrFunctions(XrInstance m_xrInstance) {
     OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetVulkanGraphicsRequirementsKHR", (PFN_xrVoidFunction *)&xrGetVulkanGraphicsRequirementsKHR), "Failed to get InstanceProcAddr for xrGetVulkanGraphicsRequirementsKHR.");
     OPENXR_CHECK(xrGetInstanceProcAddr(m_xrInstance, "xrGetVulkanInstanceExtensionsKHR", (PFN_xrVoidFunction *)&xrGetVulkanInstanceExtensionsKHR), "Failed to get InstanceProcAddr for xrGetVulkanInstanceExtensionsKHR.");
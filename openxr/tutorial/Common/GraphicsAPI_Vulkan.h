@@ -7,6 +7,14 @@
 #pragma once
 #include <GraphicsAPI.h>
 
+#include <array>
+#include <map>
+
+// Number of frames the CPU may record ahead of the GPU.
+#if !defined(XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT)
+#define XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT 2
+#endif
+
 #if defined(XR_USE_GRAPHICS_API_VULKAN)
 class GraphicsAPI_Vulkan : public GraphicsAPI {
 public:
@@ -58,6 +66,7 @@ public:
     virtual void EndRendering() override;
 
     virtual void SetBufferData(void* buffer, size_t offset, size_t size, void* data) override;
+    virtual TransientAllocation AllocateTransientData(const void* data, size_t size) override;
 
     virtual void ClearColor(void* imageView, float r, float g, float b, float a) override;
     virtual void ClearDepth(void* imageView, float d) override;
@@ -74,6 +83,22 @@ public:
     virtual void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0) override;
     virtual void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
 
+    // Waits for the GPU to go idle and recreates the per-frame resources. Must not be called between BeginRendering() and EndRendering().
+    void SetFramesInFlight(uint32_t count);
+    uint32_t GetFramesInFlight() const { return static_cast<uint32_t>(frames.size()); }
+
+    // Seeds the pipeline cache from a file written by an earlier run, if that run used the same driver and device. Call it before creating pipelines.
+    // The cache is written back to path when the device is destroyed. Call SavePipelineCache() after creating a batch of pipelines to write it sooner.
+    void LoadPipelineCache(const std::string& path);
+    void SavePipelineCache();
+
+    // A descriptor recorded by SetDescriptor() and written by UpdateDescriptors(). The uint32_t is the offset of a dynamic uniform buffer, which is bound rather than written.
+    using PendingDescriptorWrite = std::tuple<VkWriteDescriptorSet, VkDescriptorBufferInfo, VkDescriptorImageInfo, uint32_t>;
+
+    // Sorts writes by binding and builds the key of their descriptor set in the per-frame cache from the set layout and the bound resources.
+    // Dynamic uniform buffer offsets are left out of the key. dynamicOffsets gets one for each of dynamicBindings, the layout's dynamic uniform buffer bindings in ascending order; those without a write get 0.
+    static void BuildDescriptorSetKey(VkDescriptorSetLayout descSetLayout, const std::vector<uint32_t>& dynamicBindings, std::vector<PendingDescriptorWrite>& writes, std::vector<uint64_t>& key, std::vector<uint32_t>& dynamicOffsets);
+
 private:
     void LoadPFN_XrFunctions(XrInstance m_xrInstance);
     std::vector<std::string> GetInstanceExtensionsForOpenXR(XrInstance m_xrInstance, XrSystemId systemId);
@@ -82,6 +107,78 @@ private:
     virtual const std::vector<int64_t> GetSupportedColorSwapchainFormats() override;
     virtual const std::vector<int64_t> GetSupportedDepthSwapchainFormats() override;
 
+    // Identifies a framebuffer by its render pass, attachments and size; it has a fixed size so looking one up never allocates.
+    static constexpr uint32_t maxFramebufferAttachments = 9;  // Up to 8 color attachments and a depth attachment.
+    struct FramebufferKey {
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        std::array<VkImageView, maxFramebufferAttachments> attachments{};  // Unused attachments stay VK_NULL_HANDLE.
+        uint32_t attachmentCount = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+
+        bool operator==(const FramebufferKey& other) const {
+            return renderPass == other.renderPass && attachments == other.attachments && attachmentCount == other.attachmentCount && width == other.width && height == other.height;
+        }
+    };
+    struct FramebufferKeyHash {
+        size_t operator()(const FramebufferKey& key) const {
+            uint64_t hash = 14695981039346656037ull;
+            hash = (hash ^ (uint64_t)key.renderPass) * 1099511628211ull;
+            for (uint32_t i = 0; i < key.attachmentCount; i++) {
+                hash = (hash ^ (uint64_t)key.attachments[i]) * 1099511628211ull;
+            }
+            hash = (hash ^ (((uint64_t)key.width << 32) | key.height)) * 1099511628211ull;
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct DescriptorSetKeyHash {
+        size_t operator()(const std::vector<uint64_t>& key) const {
+            uint64_t hash = 14695981039346656037ull;
+            for (uint64_t value : key) {
+                hash = (hash ^ value) * 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    // A persistently mapped uniform buffer that transient allocations are linearly sub-allocated from.
+    struct TransientBlock {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        uint8_t* mappedData = nullptr;
+        size_t size = 0;
+    };
+
+    // Everything a frame needs until the GPU has finished executing it.
+    struct FrameResources {
+        VkCommandPool cmdPool = VK_NULL_HANDLE;
+        VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+        VkFence fence = VK_NULL_HANDLE;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        VkSemaphore acquireSemaphore = VK_NULL_HANDLE;  // Only with a desktop swapchain.
+        VkSemaphore submitSemaphore = VK_NULL_HANDLE;   // Only with a desktop swapchain.
+        uint64_t serial = 0;                            // Frame last recorded into this slot.
+        // Descriptor sets allocated from descriptorPool this frame, keyed by their layout and bound resources.
+        std::unordered_map<std::vector<uint64_t>, VkDescriptorSet, DescriptorSetKeyHash> descriptorSetCache;
+        // AllocateTransientData() bumps transientOffset through transientBlocks[transientBlockIndex].
+        std::vector<TransientBlock> transientBlocks;
+        size_t transientBlockIndex = 0;
+        size_t transientOffset = 0;
+    };
+
+    void CreateFrameResources(uint32_t count);
+    void CreateFrameSemaphores(FrameResources& frame);
+    void DestroyFrameResources();
+    void BeginFrameSlot();
+    void WaitForFrameSerial(uint64_t serial);
+    void WaitForAllFrames();
+    void ClearDescriptorSetCaches();
+    void CreatePipelineCache(const std::vector<char>& initialData);
+    TransientBlock CreateTransientBlock(size_t size);
+    void DestroyTransientBlock(TransientBlock& block);
+    // Destroys the cached framebuffers that use renderPass or imageView.
+    void DestroyCachedFramebuffers(VkRenderPass renderPass, VkImageView imageView);
+
 private:
     VkInstance instance{};
     VkPhysicalDevice physicalDevice{};
@@ -89,11 +186,18 @@ private:
     uint32_t queueFamilyIndex = 0xFFFFFFFF;
     uint32_t queueIndex = 0xFFFFFFFF;
     VkQueue queue{};
-    VkFence fence{};
 
-    VkCommandPool cmdPool{};
-    VkCommandBuffer cmdBuffer{};
-    VkDescriptorPool descriptorPool;
+    // Shared by every pipeline creation.
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    std::string pipelineCachePath;
+    size_t pipelineCacheSavedSize = 0;  // Size of the cache data last written to pipelineCachePath.
+
+    std::vector<FrameResources> frames;
+    uint32_t frameIndex = 0;
+    bool frameSlotReady = false;          // frames[frameIndex] has been waited for and may be recorded into.
+    uint64_t frameSerial = 0;             // Last frame started.
+    uint64_t completedFrameSerial = 0;    // Every frame up to this one has finished on the GPU.
+    VkCommandBuffer cmdBuffer{};          // Command buffer of frames[frameIndex].
 
     std::vector<const char*> activeInstanceLayers{};
     std::vector<const char*> activeInstanceExtensions{};
@@ -111,24 +215,29 @@ private:
     VkImage currentDesktopSwapchainImage = VK_NULL_HANDLE;
 
     std::unordered_map<VkSwapchainKHR, VkSurfaceKHR> surfaces;
-    VkSemaphore acquireSemaphore{};
-    VkSemaphore submitSemaphore{};
 
     std::unordered_map<VkImage, VkImageLayout> imageStates;
     std::unordered_map<VkImage, std::pair<VkDeviceMemory, ImageCreateInfo>> imageResources;
     std::unordered_map<VkImageView, ImageViewCreateInfo> imageViewResources;
 
     std::unordered_map<VkBuffer, std::pair<VkDeviceMemory, BufferCreateInfo>> bufferResources;
+    std::unordered_map<VkBuffer, void*> bufferMappedData;  // Every buffer stays mapped until it's destroyed.
+    std::unordered_map<VkBuffer, uint64_t> bufferLastUse;  // Serial of the last frame that bound the buffer.
+
+    static constexpr size_t transientBlockSize = 64 * 1024;  // Initial size of each frame's transient memory.
+    size_t transientAlignment = 256;
 
     std::unordered_map<VkShaderModule, ShaderCreateInfo> shaderResources;
-    std::unordered_map<VkPipeline, std::tuple<VkPipelineLayout, VkDescriptorSetLayout, VkRenderPass, PipelineCreateInfo>> pipelineResources;
+    // The last element holds the bindings of the pipeline's dynamic uniform buffers, in ascending order.
+    std::unordered_map<VkPipeline, std::tuple<VkPipelineLayout, VkDescriptorSetLayout, VkRenderPass, PipelineCreateInfo, std::vector<uint32_t>>> pipelineResources;
 
-    std::unordered_map<VkCommandBuffer, std::vector<VkFramebuffer>> cmdBufferFramebuffers;
+    std::unordered_map<FramebufferKey, VkFramebuffer, FramebufferKeyHash> framebufferCache;
     bool inRenderPass = false;
 
     VkPipeline setPipeline = VK_NULL_HANDLE;
-    std::unordered_map<VkCommandBuffer, std::vector<VkDescriptorSet>> cmdBufferDescriptorSets;
-    std::vector<std::tuple<VkWriteDescriptorSet, VkDescriptorBufferInfo, VkDescriptorImageInfo>> writeDescSets;
+    std::vector<PendingDescriptorWrite> writeDescSets;
+    std::vector<uint64_t> descSetKey;
+    std::vector<uint32_t> dynamicOffsets;
 
 };
 #endif
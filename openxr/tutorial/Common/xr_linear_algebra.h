@@ -23,6 +23,7 @@
 // Changes made for: OpenXR Tutorial for Khronos Group.
 // - Removed GraphicsAPI_Type due to naming conflict.
 // - Updated relevant functions to use the GraphicsAPI_Type from the OpenXR Tutorial.
+// - Added SSE/NEON matrix products and rigid body inverses, and batch model/MVP matrix creation.
 
 #ifndef XR_LINEAR_H_
 #define XR_LINEAR_H_
@@ -100,6 +101,12 @@ inline static void XrMatrix4x4f_GetRotation(XrQuaternionf* result, const XrMatri
 inline static void XrMatrix4x4f_GetScale(XrVector3f* result, const XrMatrix4x4f* src);
 
 inline static void XrMatrix4x4f_Multiply(XrMatrix4x4f* result, const XrMatrix4x4f* a, const XrMatrix4x4f* b);
+inline static void XrMatrix4x4f_MultiplyArray(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, size_t count);
+inline static void XrMatrix4x4f_CreateTranslationRotationScaleArray(XrMatrix4x4f* results, const XrPosef* poses, size_t poseStride,
+                                                                    const XrVector3f* scales, size_t scaleStride, size_t count);
+inline static void XrMatrix4x4f_CreateModelViewProjectionArray(XrMatrix4x4f* results, const XrMatrix4x4f* viewProjection,
+                                                               const XrPosef* poses, size_t poseStride, const XrVector3f* scales,
+                                                               size_t scaleStride, size_t count);
 inline static void XrMatrix4x4f_Transpose(XrMatrix4x4f* result, const XrMatrix4x4f* src);
 inline static void XrMatrix4x4f_Invert(XrMatrix4x4f* result, const XrMatrix4x4f* src);
 inline static void XrMatrix4x4f_InvertRigidBody(XrMatrix4x4f* result, const XrMatrix4x4f* src);
@@ -117,6 +124,20 @@ inline static bool XrMatrix4x4f_CullBounds(const XrMatrix4x4f* mvp, const XrVect
 #include <assert.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+// Matrix products and rigid body inverses use SSE or NEON when the target has them. Define XR_LINEAR_NO_SIMD to always
+// use the scalar code, e.g. to compare against it. Both paths add the products in the same order, so they give the same
+// results unless the compiler contracts the scalar code into fused multiply-adds.
+#if !defined(XR_LINEAR_NO_SIMD)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define XR_LINEAR_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define XR_LINEAR_NEON
+#include <arm_neon.h>
+#endif
+#endif
 
 #define MATH_PI 3.14159265358979323846f
 
@@ -246,6 +267,34 @@ inline static void XrQuaternionf_Multiply(XrQuaternionf* result, const XrQuatern
 
 // Use left-multiplication to accumulate transformations.
 inline static void XrMatrix4x4f_Multiply(XrMatrix4x4f* result, const XrMatrix4x4f* a, const XrMatrix4x4f* b) {
+#if defined(XR_LINEAR_SSE)
+    const __m128 a0 = _mm_loadu_ps(&a->m[0]);
+    const __m128 a1 = _mm_loadu_ps(&a->m[4]);
+    const __m128 a2 = _mm_loadu_ps(&a->m[8]);
+    const __m128 a3 = _mm_loadu_ps(&a->m[12]);
+    for (int c = 0; c < 16; c += 4) {
+        // Column c of the result is the columns of a weighted by column c of b.
+        __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b->m[c + 0]));
+        r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b->m[c + 1])));
+        r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b->m[c + 2])));
+        r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b->m[c + 3])));
+        _mm_storeu_ps(&result->m[c], r);
+    }
+#elif defined(XR_LINEAR_NEON)
+    const float32x4_t a0 = vld1q_f32(&a->m[0]);
+    const float32x4_t a1 = vld1q_f32(&a->m[4]);
+    const float32x4_t a2 = vld1q_f32(&a->m[8]);
+    const float32x4_t a3 = vld1q_f32(&a->m[12]);
+    for (int c = 0; c < 16; c += 4) {
+        // Column c of the result is the columns of a weighted by column c of b.
+        const float32x4_t bc = vld1q_f32(&b->m[c]);
+        float32x4_t r = vmulq_lane_f32(a0, vget_low_f32(bc), 0);
+        r = vaddq_f32(r, vmulq_lane_f32(a1, vget_low_f32(bc), 1));
+        r = vaddq_f32(r, vmulq_lane_f32(a2, vget_high_f32(bc), 0));
+        r = vaddq_f32(r, vmulq_lane_f32(a3, vget_high_f32(bc), 1));
+        vst1q_f32(&result->m[c], r);
+    }
+#else
     result->m[0] = a->m[0] * b->m[0] + a->m[4] * b->m[1] + a->m[8] * b->m[2] + a->m[12] * b->m[3];
     result->m[1] = a->m[1] * b->m[0] + a->m[5] * b->m[1] + a->m[9] * b->m[2] + a->m[13] * b->m[3];
     result->m[2] = a->m[2] * b->m[0] + a->m[6] * b->m[1] + a->m[10] * b->m[2] + a->m[14] * b->m[3];
@@ -265,6 +314,7 @@ inline static void XrMatrix4x4f_Multiply(XrMatrix4x4f* result, const XrMatrix4x4
     result->m[13] = a->m[1] * b->m[12] + a->m[5] * b->m[13] + a->m[9] * b->m[14] + a->m[13] * b->m[15];
     result->m[14] = a->m[2] * b->m[12] + a->m[6] * b->m[13] + a->m[10] * b->m[14] + a->m[14] * b->m[15];
     result->m[15] = a->m[3] * b->m[12] + a->m[7] * b->m[13] + a->m[11] * b->m[14] + a->m[15] * b->m[15];
+#endif
 }
 
 // Creates the transpose of the given matrix.
@@ -326,6 +376,37 @@ inline static void XrMatrix4x4f_Invert(XrMatrix4x4f* result, const XrMatrix4x4f*
 
 // Calculates the inverse of a rigid body transform.
 inline static void XrMatrix4x4f_InvertRigidBody(XrMatrix4x4f* result, const XrMatrix4x4f* src) {
+#if defined(XR_LINEAR_SSE)
+    // Transpose the rotation, then rotate the negated translation by it.
+    __m128 r0 = _mm_loadu_ps(&src->m[0]);
+    __m128 r1 = _mm_loadu_ps(&src->m[4]);
+    __m128 r2 = _mm_loadu_ps(&src->m[8]);
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    __m128 t = _mm_mul_ps(r0, _mm_set1_ps(src->m[12]));
+    t = _mm_add_ps(t, _mm_mul_ps(r1, _mm_set1_ps(src->m[13])));
+    t = _mm_add_ps(t, _mm_mul_ps(r2, _mm_set1_ps(src->m[14])));
+    _mm_storeu_ps(&result->m[0], r0);
+    _mm_storeu_ps(&result->m[4], r1);
+    _mm_storeu_ps(&result->m[8], r2);
+    _mm_storeu_ps(&result->m[12], _mm_sub_ps(_mm_setzero_ps(), t));
+    result->m[15] = 1.0f;
+#elif defined(XR_LINEAR_NEON)
+    // Transpose the rotation, then rotate the negated translation by it.
+    const float32x4x4_t cols = vld4q_f32(src->m);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t r0 = vsetq_lane_f32(0.0f, cols.val[0], 3);
+    const float32x4_t r1 = vsetq_lane_f32(0.0f, cols.val[1], 3);
+    const float32x4_t r2 = vsetq_lane_f32(0.0f, cols.val[2], 3);
+    float32x4_t t = vmulq_n_f32(r0, src->m[12]);
+    t = vaddq_f32(t, vmulq_n_f32(r1, src->m[13]));
+    t = vaddq_f32(t, vmulq_n_f32(r2, src->m[14]));
+    vst1q_f32(&result->m[0], r0);
+    vst1q_f32(&result->m[4], r1);
+    vst1q_f32(&result->m[8], r2);
+    vst1q_f32(&result->m[12], vsubq_f32(zero, t));
+    result->m[15] = 1.0f;
+#else
     result->m[0] = src->m[0];
     result->m[1] = src->m[4];
     result->m[2] = src->m[8];
@@ -342,6 +423,7 @@ inline static void XrMatrix4x4f_InvertRigidBody(XrMatrix4x4f* result, const XrMa
     result->m[13] = -(src->m[4] * src->m[12] + src->m[5] * src->m[13] + src->m[6] * src->m[14]);
     result->m[14] = -(src->m[8] * src->m[12] + src->m[9] * src->m[13] + src->m[10] * src->m[14]);
     result->m[15] = 1.0f;
+#endif
 }
 
 // Creates an identity matrix.
@@ -461,20 +543,94 @@ inline static void XrMatrix4x4f_CreateFromQuaternion(XrMatrix4x4f* result, const
 }
 
 // Creates a combined translation(rotation(scale(object))) matrix.
+// Equal to translation * rotation * scale, without building and multiplying the three matrices.
 inline static void XrMatrix4x4f_CreateTranslationRotationScale(XrMatrix4x4f* result, const XrVector3f* translation,
                                                                const XrQuaternionf* rotation, const XrVector3f* scale) {
-    XrMatrix4x4f scaleMatrix;
-    XrMatrix4x4f_CreateScale(&scaleMatrix, scale->x, scale->y, scale->z);
-
-    XrMatrix4x4f rotationMatrix;
-    XrMatrix4x4f_CreateFromQuaternion(&rotationMatrix, rotation);
+    XrMatrix4x4f_CreateFromQuaternion(result, rotation);
+
+    result->m[0] *= scale->x;
+    result->m[1] *= scale->x;
+    result->m[2] *= scale->x;
+
+    result->m[4] *= scale->y;
+    result->m[5] *= scale->y;
+    result->m[6] *= scale->y;
+
+    result->m[8] *= scale->z;
+    result->m[9] *= scale->z;
+    result->m[10] *= scale->z;
+
+    result->m[12] = translation->x;
+    result->m[13] = translation->y;
+    result->m[14] = translation->z;
+}
+
+// Multiplies a by each of count matrices in b, e.g. a view-projection by model matrices. Loads a only once.
+inline static void XrMatrix4x4f_MultiplyArray(XrMatrix4x4f* results, const XrMatrix4x4f* a, const XrMatrix4x4f* b, size_t count) {
+#if defined(XR_LINEAR_SSE)
+    const __m128 a0 = _mm_loadu_ps(&a->m[0]);
+    const __m128 a1 = _mm_loadu_ps(&a->m[4]);
+    const __m128 a2 = _mm_loadu_ps(&a->m[8]);
+    const __m128 a3 = _mm_loadu_ps(&a->m[12]);
+    for (size_t i = 0; i < count; i++) {
+        for (int c = 0; c < 16; c += 4) {
+            __m128 r = _mm_mul_ps(a0, _mm_set1_ps(b[i].m[c + 0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(b[i].m[c + 1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(b[i].m[c + 2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(b[i].m[c + 3])));
+            _mm_storeu_ps(&results[i].m[c], r);
+        }
+    }
+#elif defined(XR_LINEAR_NEON)
+    const float32x4_t a0 = vld1q_f32(&a->m[0]);
+    const float32x4_t a1 = vld1q_f32(&a->m[4]);
+    const float32x4_t a2 = vld1q_f32(&a->m[8]);
+    const float32x4_t a3 = vld1q_f32(&a->m[12]);
+    for (size_t i = 0; i < count; i++) {
+        for (int c = 0; c < 16; c += 4) {
+            const float32x4_t bc = vld1q_f32(&b[i].m[c]);
+            float32x4_t r = vmulq_lane_f32(a0, vget_low_f32(bc), 0);
+            r = vaddq_f32(r, vmulq_lane_f32(a1, vget_low_f32(bc), 1));
+            r = vaddq_f32(r, vmulq_lane_f32(a2, vget_high_f32(bc), 0));
+            r = vaddq_f32(r, vmulq_lane_f32(a3, vget_high_f32(bc), 1));
+            vst1q_f32(&results[i].m[c], r);
+        }
+    }
+#else
+    for (size_t i = 0; i < count; i++) {
+        XrMatrix4x4f_Multiply(&results[i], a, &b[i]);
+    }
+#endif
+}
 
-    XrMatrix4x4f translationMatrix;
-    XrMatrix4x4f_CreateTranslation(&translationMatrix, translation->x, translation->y, translation->z);
+// Creates count model matrices from poses and scales, e.g. for an instance buffer. poseStride and scaleStride are the distances
+// in bytes between consecutive poses and scales, so they can be read straight out of an array of structs. scales may be NULL
+// for unit scale.
+inline static void XrMatrix4x4f_CreateTranslationRotationScaleArray(XrMatrix4x4f* results, const XrPosef* poses, size_t poseStride,
+                                                                    const XrVector3f* scales, size_t scaleStride, size_t count) {
+    const XrVector3f unitScale = {1.0f, 1.0f, 1.0f};
+    for (size_t i = 0; i < count; i++) {
+        const XrPosef* pose = (const XrPosef*)((const char*)poses + i * poseStride);
+        const XrVector3f* scale = scales ? (const XrVector3f*)((const char*)scales + i * scaleStride) : &unitScale;
+        XrMatrix4x4f_CreateTranslationRotationScale(&results[i], &pose->position, &pose->orientation, scale);
+    }
+}
 
-    XrMatrix4x4f combinedMatrix;
-    XrMatrix4x4f_Multiply(&combinedMatrix, &rotationMatrix, &scaleMatrix);
-    XrMatrix4x4f_Multiply(result, &translationMatrix, &combinedMatrix);
+// Creates count model-view-projection matrices, viewProjection * translation * rotation * scale, from poses and scales.
+// The strides and scales are as for XrMatrix4x4f_CreateTranslationRotationScaleArray.
+inline static void XrMatrix4x4f_CreateModelViewProjectionArray(XrMatrix4x4f* results, const XrMatrix4x4f* viewProjection,
+                                                               const XrPosef* poses, size_t poseStride, const XrVector3f* scales,
+                                                               size_t scaleStride, size_t count) {
+    // Multiply each model matrix while it is still in registers; staging them in a buffer for XrMatrix4x4f_MultiplyArray
+    // measured slower.
+    const XrVector3f unitScale = {1.0f, 1.0f, 1.0f};
+    for (size_t i = 0; i < count; i++) {
+        const XrPosef* pose = (const XrPosef*)((const char*)poses + i * poseStride);
+        const XrVector3f* scale = scales ? (const XrVector3f*)((const char*)scales + i * scaleStride) : &unitScale;
+        XrMatrix4x4f model;
+        XrMatrix4x4f_CreateTranslationRotationScale(&model, &pose->position, &pose->orientation, scale);
+        XrMatrix4x4f_Multiply(&results[i], viewProjection, &model);
+    }
 }
 
 // Creates a projection matrix based on the specified dimensions.
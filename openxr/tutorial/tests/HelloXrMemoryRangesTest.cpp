@@ -0,0 +1,139 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: checks the free range bookkeeping that hello_xr's Vulkan
+// MemoryAllocator sub-allocates its memory blocks with: aligned first-fit allocation, and merging
+// freed ranges with their neighbours.
+
+#include <cstdint>
+#include <cstdio>
+
+#include <memory_ranges.h>
+
+static int s_failures = 0;
+
+static void Check(bool condition, const char *what) {
+    if (!condition) {
+        std::printf("FAIL %s\n", what);
+        s_failures++;
+    }
+}
+
+// The ranges must stay sorted by offset, non-empty and never adjacent, or they would not merge.
+static void CheckRanges(const FreeRanges &ranges, const char *what) {
+    const auto &list = ranges.Ranges();
+    for (size_t i = 0; i < list.size(); i++) {
+        if (list[i].size == 0 || (i > 0 && list[i - 1].offset + list[i - 1].size >= list[i].offset)) {
+            std::printf("FAIL %s: range %zu at %llu of %llu bytes\n", what, i, (unsigned long long)list[i].offset, (unsigned long long)list[i].size);
+            s_failures++;
+            return;
+        }
+    }
+}
+
+static uint64_t Allocate(FreeRanges &ranges, uint64_t size, uint64_t alignment, const char *what) {
+    uint64_t offset = UINT64_MAX;
+    if (!ranges.Allocate(size, alignment, &offset)) {
+        std::printf("FAIL %s: no room for %llu bytes\n", what, (unsigned long long)size);
+        s_failures++;
+        return UINT64_MAX;
+    }
+    CheckRanges(ranges, what);
+    return offset;
+}
+
+static void Free(FreeRanges &ranges, uint64_t offset, uint64_t size, const char *what) {
+    ranges.Free(offset, size);
+    CheckRanges(ranges, what);
+}
+
+static void TestAlignment() {
+    FreeRanges ranges(4096);
+    const uint64_t a = Allocate(ranges, 100, 1, "unaligned");
+    Check(a == 0, "the first allocation starts the block");
+
+    const uint64_t b = Allocate(ranges, 256, 256, "aligned");
+    Check(b == 256, "an aligned allocation skips to the next multiple of its alignment");
+    Check(ranges.Ranges().size() == 2 && ranges.Ranges()[0].offset == 100 && ranges.Ranges()[0].size == 156,
+          "the padding before an aligned allocation stays free");
+
+    // The padding is reused by a smaller allocation that fits it.
+    const uint64_t c = Allocate(ranges, 64, 16, "into the padding");
+    Check(c == 112, "first fit takes the padding at its alignment");
+    Check(ranges.FreeBytes() == 4096 - 100 - 256 - 64, "free bytes after three allocations");
+
+    Free(ranges, c, 64, "free from the padding");
+    Free(ranges, b, 256, "free the aligned allocation");
+    Free(ranges, a, 100, "free the first allocation");
+    Check(ranges.Ranges().size() == 1 && ranges.FreeBytes() == 4096, "the block is whole again");
+
+    // An alignment that leaves no room fails rather than overrunning the block.
+    FreeRanges tight(1024);
+    Allocate(tight, 1, 1, "one byte");
+    uint64_t offset = 0;
+    Check(!tight.Allocate(1024 - 512, 1024, &offset), "an alignment past the end of the block fails");
+    Check(tight.Allocate(512, 512, &offset) && offset == 512, "an alignment that fits succeeds");
+}
+
+static void TestMerging() {
+    FreeRanges ranges(1024);
+    const uint64_t a = Allocate(ranges, 256, 1, "a");
+    const uint64_t b = Allocate(ranges, 256, 1, "b");
+    const uint64_t c = Allocate(ranges, 256, 1, "c");
+    const uint64_t d = Allocate(ranges, 256, 1, "d");
+    uint64_t offset = 0;
+    Check(!ranges.Allocate(1, 1, &offset), "a full block has no room");
+
+    Free(ranges, a, 256, "free a");
+    Free(ranges, c, 256, "free c");
+    Check(ranges.Ranges().size() == 2, "ranges that aren't adjacent stay apart");
+    Check(!ranges.Allocate(512, 1, &offset), "two separate halves don't hold a whole half");
+
+    // b lies between a and c, so it merges on both sides.
+    Free(ranges, b, 256, "free b");
+    Check(ranges.Ranges().size() == 1 && ranges.Ranges()[0].offset == 0 && ranges.Ranges()[0].size == 768, "freeing b merges with a before and c after");
+    Check(ranges.LargestFreeRange() == 768, "the merged range is the largest");
+
+    // d is the last allocation, at the end of the block.
+    Free(ranges, d, 256, "free d");
+    Check(ranges.Ranges().size() == 1 && ranges.Ranges()[0].size == 1024, "freeing the last allocation makes the block whole");
+
+    // Merging only after, and only before.
+    FreeRanges after(1024);
+    const uint64_t e = Allocate(after, 512, 1, "e");
+    Free(after, e, 512, "free e");
+    Check(after.Ranges().size() == 1 && after.Ranges()[0].size == 1024, "a range merges with the free range after it");
+
+    FreeRanges before(1024);
+    const uint64_t f = Allocate(before, 512, 1, "f");
+    const uint64_t g = Allocate(before, 512, 1, "g");
+    Free(before, f, 512, "free f");
+    Free(before, g, 512, "free g");
+    Check(before.Ranges().size() == 1 && before.Ranges()[0].size == 1024, "a range merges with the free range before it");
+}
+
+static void TestFirstFit() {
+    FreeRanges ranges(4096);
+    uint64_t offsets[8];
+    for (uint64_t &offset : offsets) {
+        offset = Allocate(ranges, 512, 1, "fill");
+    }
+    Free(ranges, offsets[1], 512, "free 1");
+    Free(ranges, offsets[5], 512, "free 5");
+    Free(ranges, offsets[6], 512, "free 6");
+    Check(Allocate(ranges, 256, 1, "first fit") == offsets[1], "the first range that fits is used");
+    Check(Allocate(ranges, 768, 1, "larger") == offsets[5], "a larger allocation skips ranges that are too small");
+    Check(ranges.FreeBytes() == 512, "free bytes after refilling");
+}
+
+int main() {
+    TestAlignment();
+    TestMerging();
+    TestFirstFit();
+
+    if (s_failures == 0) {
+        std::printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
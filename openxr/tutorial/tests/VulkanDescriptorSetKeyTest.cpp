@@ -0,0 +1,124 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: checks the key that GraphicsAPI_Vulkan caches descriptor
+// sets under, and the dynamic offsets it binds them with. The writes are built the way
+// SetDescriptor() builds them, with made-up handles, so no device is needed.
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+#include "VulkanTestDevice.h"
+
+using PendingDescriptorWrite = GraphicsAPI_Vulkan::PendingDescriptorWrite;
+
+static int s_failures = 0;
+
+template <typename Handle>
+static Handle FakeHandle(uint64_t value) {
+    return (Handle)(uintptr_t)value;
+}
+
+static PendingDescriptorWrite Write(uint32_t binding, VkDescriptorType type) {
+    VkWriteDescriptorSet writeDescSet{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+    writeDescSet.dstBinding = binding;
+    writeDescSet.descriptorCount = 1;
+    writeDescSet.descriptorType = type;
+    return {writeDescSet, {}, {}, 0};
+}
+
+// A uniform buffer, which SetDescriptor() binds dynamically: the offset is bound, not written.
+static PendingDescriptorWrite UniformWrite(uint32_t binding, uint64_t buffer, uint32_t offset, VkDeviceSize range) {
+    PendingDescriptorWrite write = Write(binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+    std::get<1>(write) = {FakeHandle<VkBuffer>(buffer), 0, range};
+    std::get<3>(write) = offset;
+    return write;
+}
+
+static PendingDescriptorWrite StorageWrite(uint32_t binding, uint64_t buffer, VkDeviceSize offset, VkDeviceSize range) {
+    PendingDescriptorWrite write = Write(binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    std::get<1>(write) = {FakeHandle<VkBuffer>(buffer), offset, range};
+    return write;
+}
+
+static PendingDescriptorWrite ImageWrite(uint32_t binding, uint64_t imageView, VkImageLayout layout) {
+    PendingDescriptorWrite write = Write(binding, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+    std::get<2>(write) = {VK_NULL_HANDLE, FakeHandle<VkImageView>(imageView), layout};
+    return write;
+}
+
+static PendingDescriptorWrite SamplerWrite(uint32_t binding, uint64_t sampler) {
+    PendingDescriptorWrite write = Write(binding, VK_DESCRIPTOR_TYPE_SAMPLER);
+    std::get<2>(write) = {FakeHandle<VkSampler>(sampler), VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED};
+    return write;
+}
+
+struct Built {
+    std::vector<uint64_t> key;
+    std::vector<uint32_t> dynamicOffsets;
+    std::vector<uint32_t> bindings;  // Of the writes, after they were sorted.
+};
+
+static Built Build(uint64_t layout, const std::vector<uint32_t> &dynamicBindings, std::vector<PendingDescriptorWrite> writes) {
+    Built built;
+    GraphicsAPI_Vulkan::BuildDescriptorSetKey(FakeHandle<VkDescriptorSetLayout>(layout), dynamicBindings, writes, built.key, built.dynamicOffsets);
+    for (const PendingDescriptorWrite &write : writes) {
+        built.bindings.push_back(std::get<0>(write).dstBinding);
+    }
+    return built;
+}
+
+static void Check(bool condition, const char *what) {
+    if (!condition) {
+        std::printf("FAIL %s\n", what);
+        s_failures++;
+    }
+}
+
+int main() {
+    // The Chapter 4 layout: three uniform buffers, of which the draws only write the first two.
+    const std::vector<uint32_t> cubeBindings = {0, 1, 2};
+    const uint64_t layout = 0x100;
+    const uint64_t transient = 0x200;
+    const uint64_t normals = 0x300;
+
+    const Built first = Build(layout, cubeBindings, {UniformWrite(0, transient, 0, 256), UniformWrite(1, normals, 0, 96)});
+    const Built second = Build(layout, cubeBindings, {UniformWrite(0, transient, 256, 256), UniformWrite(1, normals, 0, 96)});
+    Check(first.key == second.key, "draws that differ only by a uniform offset share a key");
+    Check(first.dynamicOffsets == std::vector<uint32_t>({0, 0, 0}), "offsets of the first draw");
+    Check(second.dynamicOffsets == std::vector<uint32_t>({256, 0, 0}), "offsets of the second draw");
+
+    const Built reordered = Build(layout, cubeBindings, {UniformWrite(1, normals, 64, 96), UniformWrite(0, transient, 512, 256)});
+    Check(reordered.bindings == std::vector<uint32_t>({0, 1}), "writes are sorted by binding");
+    Check(reordered.key == first.key, "the order of SetDescriptor() calls doesn't change the key");
+    Check(reordered.dynamicOffsets == std::vector<uint32_t>({512, 64, 0}), "offsets are in binding order");
+
+    const Built gap = Build(layout, cubeBindings, {UniformWrite(2, normals, 128, 96), UniformWrite(0, transient, 768, 256)});
+    Check(gap.dynamicOffsets == std::vector<uint32_t>({768, 0, 128}), "a dynamic binding without a write gets offset 0");
+    Check(gap.key != first.key, "writing other bindings changes the key");
+
+    Check(Build(layout, cubeBindings, {UniformWrite(0, transient + 1, 0, 256), UniformWrite(1, normals, 0, 96)}).key != first.key, "another buffer changes the key");
+    Check(Build(layout, cubeBindings, {UniformWrite(0, transient, 0, 128), UniformWrite(1, normals, 0, 96)}).key != first.key, "another range changes the key");
+    Check(Build(layout + 1, cubeBindings, {UniformWrite(0, transient, 0, 256), UniformWrite(1, normals, 0, 96)}).key != first.key, "another set layout changes the key");
+
+    // Storage buffers aren't dynamic, so their offset is part of the descriptor set.
+    const std::vector<uint32_t> noDynamic;
+    const Built storageA = Build(layout, noDynamic, {StorageWrite(0, transient, 0, 256)});
+    const Built storageB = Build(layout, noDynamic, {StorageWrite(0, transient, 256, 256)});
+    Check(storageA.key != storageB.key, "a storage buffer offset changes the key");
+    Check(storageA.dynamicOffsets.empty(), "storage buffers have no dynamic offset");
+
+    const Built textured = Build(layout, {0}, {SamplerWrite(2, 0x400), ImageWrite(1, 0x500, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL), UniformWrite(0, transient, 1024, 256)});
+    Check(textured.bindings == std::vector<uint32_t>({0, 1, 2}), "mixed writes are sorted by binding");
+    Check(textured.dynamicOffsets == std::vector<uint32_t>({1024}), "only uniform buffers get dynamic offsets");
+    Check(Build(layout, {0}, {SamplerWrite(2, 0x400), ImageWrite(1, 0x500, VK_IMAGE_LAYOUT_GENERAL), UniformWrite(0, transient, 0, 256)}).key != textured.key, "another image layout changes the key");
+    Check(Build(layout, {0}, {SamplerWrite(2, 0x401), ImageWrite(1, 0x500, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL), UniformWrite(0, transient, 0, 256)}).key != textured.key, "another sampler changes the key");
+    Check(Build(layout, {0}, {SamplerWrite(2, 0x400), ImageWrite(1, 0x500, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL), UniformWrite(0, transient, 0, 256)}).key == textured.key, "a textured draw only differing by its uniform offset shares the key");
+
+    if (s_failures == 0) {
+        std::printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: records frames of many cuboid draws the way the chapters do,
+// each with its own camera constants in transient memory bound at a dynamic offset, and times the
+// CPU side of recording them. Uses the Chapter 4 shaders.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "VulkanTestDevice.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct CameraConstants {
+    float viewProj[16];
+    float modelViewProj[16];
+    float model[16];
+    float color[4];
+    float pad[12];
+};
+
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 30;
+    const int draws = argc > 2 ? std::atoi(argv[2]) : 10000;
+    if (frames <= 0 || draws <= 0) {
+        std::printf("usage: %s [frames] [draws]\n", argv[0]);
+        return 1;
+    }
+
+    GraphicsAPI_Vulkan graphics;
+    const uint32_t size = 256;
+    VulkanColorTarget target = CreateColorTarget(graphics, size, size);
+
+    const float cubeVertices[] = {
+        -0.5f, -0.5f, 0.0f, 1.0f, 0.5f, -0.5f, 0.0f, 1.0f, 0.5f, 0.5f, 0.0f, 1.0f,
+        -0.5f, -0.5f, 0.0f, 1.0f, 0.5f, 0.5f, 0.0f, 1.0f, -0.5f, 0.5f, 0.0f, 1.0f};
+    const uint32_t cubeIndices[] = {0, 1, 2, 3, 4, 5};
+    const float normals[6 * 4] = {1.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f};
+    void *vertexBuffer = graphics.CreateBuffer({GraphicsAPI::BufferCreateInfo::Type::VERTEX, sizeof(float) * 4, sizeof(cubeVertices), (void *)cubeVertices});
+    void *indexBuffer = graphics.CreateBuffer({GraphicsAPI::BufferCreateInfo::Type::INDEX, sizeof(uint32_t), sizeof(cubeIndices), (void *)cubeIndices});
+    void *normalsBuffer = graphics.CreateBuffer({GraphicsAPI::BufferCreateInfo::Type::UNIFORM, 0, sizeof(normals), (void *)normals});
+
+    std::vector<char> vertexSource = ReadBinaryFile(XR_TUTORIAL_SHADER_DIR "VertexShader.spv");
+    std::vector<char> fragmentSource = ReadBinaryFile(XR_TUTORIAL_SHADER_DIR "PixelShader.spv");
+    void *vertexShader = graphics.CreateShader({GraphicsAPI::ShaderCreateInfo::Type::VERTEX, vertexSource.data(), vertexSource.size()});
+    void *fragmentShader = graphics.CreateShader({GraphicsAPI::ShaderCreateInfo::Type::FRAGMENT, fragmentSource.data(), fragmentSource.size()});
+
+    // The Chapter 4 pipeline, without the depth attachment.
+    GraphicsAPI::PipelineCreateInfo pipelineCI;
+    pipelineCI.shaders = {vertexShader, fragmentShader};
+    pipelineCI.vertexInputState.attributes = {{0, 0, GraphicsAPI::VertexType::VEC4, 0, "TEXCOORD"}};
+    pipelineCI.vertexInputState.bindings = {{0, 0, 4 * sizeof(float)}};
+    pipelineCI.inputAssemblyState = {GraphicsAPI::PrimitiveTopology::TRIANGLE_LIST, false};
+    pipelineCI.rasterisationState = {false, false, GraphicsAPI::PolygonMode::FILL, GraphicsAPI::CullMode::NONE, GraphicsAPI::FrontFace::COUNTER_CLOCKWISE, false, 0.0f, 0.0f, 0.0f, 1.0f};
+    pipelineCI.multisampleState = {1, false, 1.0f, 0xFFFFFFFF, false, false};
+    pipelineCI.depthStencilState = {false, false, GraphicsAPI::CompareOp::LESS_OR_EQUAL, false, false, {}, {}, 0.0f, 1.0f};
+    pipelineCI.colorBlendState = {false, GraphicsAPI::LogicOp::NO_OP, {{true, GraphicsAPI::BlendFactor::SRC_ALPHA, GraphicsAPI::BlendFactor::ONE_MINUS_SRC_ALPHA, GraphicsAPI::BlendOp::ADD, GraphicsAPI::BlendFactor::ONE, GraphicsAPI::BlendFactor::ZERO, GraphicsAPI::BlendOp::ADD, (GraphicsAPI::ColorComponentBit)15}}, {0.0f, 0.0f, 0.0f, 0.0f}};
+    pipelineCI.colorFormats = {VK_FORMAT_R8G8B8A8_UNORM};
+    pipelineCI.depthFormat = 0;
+    pipelineCI.layout = {{0, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX},
+                         {1, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX},
+                         {2, nullptr, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::FRAGMENT}};
+    void *pipeline = graphics.CreatePipeline(pipelineCI);
+
+    CameraConstants constants{};
+    for (int i = 0; i < 4; i++) {
+        constants.viewProj[i * 5] = constants.modelViewProj[i * 5] = constants.model[i * 5] = 1.0f;
+    }
+
+    double recording = 0.0;
+    const Clock::time_point start = Clock::now();
+    for (int frame = -1; frame < frames; frame++) {
+        if (frame == 0) {
+            recording = 0.0;  // The first frame creates the framebuffer and warms the caches.
+        }
+        const Clock::time_point begin = Clock::now();
+        graphics.BeginRendering();
+        graphics.ClearColor(target.view, 0.1f, 0.1f, 0.1f, 1.0f);
+        graphics.SetRenderAttachments(&target.view, 1, nullptr, size, size, pipeline);
+        GraphicsAPI::Viewport viewport = {0.0f, 0.0f, (float)size, (float)size, 0.0f, 1.0f};
+        GraphicsAPI::Rect2D scissor = {{0, 0}, {size, size}};
+        graphics.SetViewports(&viewport, 1);
+        graphics.SetScissors(&scissor, 1);
+        for (int i = 0; i < draws; i++) {
+            // A small quad on a grid, so the GPU has little to do.
+            const float x = ((i % 100) - 49.5f) * 0.02f;
+            const float y = ((i / 100 % 100) - 49.5f) * 0.02f;
+            constants.modelViewProj[0] = constants.modelViewProj[5] = 0.01f;
+            constants.modelViewProj[12] = x;
+            constants.modelViewProj[13] = y;
+            constants.color[0] = (i & 255) / 255.0f;
+
+            graphics.SetPipeline(pipeline);
+            GraphicsAPI::TransientAllocation cameraUB = graphics.AllocateTransientData(&constants, sizeof(constants));
+            graphics.SetDescriptor({0, cameraUB.buffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false, cameraUB.offset, sizeof(constants)});
+            graphics.SetDescriptor({1, normalsBuffer, GraphicsAPI::DescriptorInfo::Type::BUFFER, GraphicsAPI::DescriptorInfo::Stage::VERTEX, false, 0, sizeof(normals)});
+            graphics.UpdateDescriptors();
+            graphics.SetVertexBuffers(&vertexBuffer, 1);
+            graphics.SetIndexBuffer(indexBuffer);
+            graphics.DrawIndexed(6);
+        }
+        graphics.EndRendering();
+        recording += MillisecondsSince(begin);
+    }
+    graphics.SetFramesInFlight(graphics.GetFramesInFlight());  // Waits for the GPU.
+    const double total = MillisecondsSince(start) / (frames + 1);
+
+    std::printf("%d draws: recording %.3f ms per frame (%.3f us per draw), %.3f ms per frame with the GPU\n", draws, recording / frames, recording * 1000.0 / frames / draws, total);
+
+    graphics.DestroyPipeline(pipeline);
+    graphics.DestroyShader(fragmentShader);
+    graphics.DestroyShader(vertexShader);
+    graphics.DestroyBuffer(normalsBuffer);
+    graphics.DestroyBuffer(indexBuffer);
+    graphics.DestroyBuffer(vertexBuffer);
+    DestroyColorTarget(graphics, target);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: times frames that each keep the CPU busy for a fixed time and
+// give the GPU a fixed number of full-target clears, with one to three frames in flight. With one
+// frame in flight BeginRendering() waits for the previous frame, so a frame costs the CPU time plus
+// the GPU time; with more, the two overlap and a frame costs about the larger of them.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "VulkanTestDevice.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct FrameTimes {
+    double frame = 0.0;  // Wall time per frame.
+    double wait = 0.0;   // Time per frame spent in BeginRendering(), waiting for an earlier frame.
+};
+
+static FrameTimes TimeFrames(GraphicsAPI_Vulkan &graphics, const VulkanColorTarget &target, uint32_t framesInFlight, int frames, double cpuMilliseconds, int clears) {
+    graphics.SetFramesInFlight(framesInFlight);
+    FrameTimes times;
+    Clock::time_point start;
+    for (int frame = -static_cast<int>(framesInFlight); frame < frames; frame++) {
+        if (frame == 0) {
+            // The first frames only fill the pipeline.
+            times = FrameTimes();
+            start = Clock::now();
+        }
+        const Clock::time_point begin = Clock::now();
+        graphics.BeginRendering();
+        times.wait += MillisecondsSince(begin);
+        for (int i = 0; i < clears; i++) {
+            graphics.ClearColor(target.view, (i & 1) ? 1.0f : 0.0f, 0.5f, 0.25f, 1.0f);
+        }
+        graphics.EndRendering();
+
+        // Stands in for the application's simulation and recording of the next frame.
+        const Clock::time_point work = Clock::now();
+        while (MillisecondsSince(work) < cpuMilliseconds) {
+        }
+    }
+    graphics.SetFramesInFlight(framesInFlight);  // Waits for the GPU to finish the timed frames.
+    times.frame = MillisecondsSince(start) / frames;
+    times.wait /= frames;
+    return times;
+}
+
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 60;
+    const double cpuMilliseconds = argc > 2 ? std::atof(argv[2]) : 4.0;
+    const int clears = argc > 3 ? std::atoi(argv[3]) : 16;
+    const uint32_t size = argc > 4 ? static_cast<uint32_t>(std::atoi(argv[4])) : 2048;
+    if (frames <= 0 || cpuMilliseconds < 0.0 || clears <= 0 || size == 0) {
+        std::printf("usage: %s [frames] [cpu ms per frame] [clears per frame] [target size]\n", argv[0]);
+        return 1;
+    }
+
+    GraphicsAPI_Vulkan graphics;
+    VulkanColorTarget target = CreateColorTarget(graphics, size, size);
+
+    const FrameTimes gpuOnly = TimeFrames(graphics, target, 1, frames, 0.0, clears);
+    std::printf("GPU alone: %.3f ms per frame (%d clears of %ux%u)\n", gpuOnly.frame, clears, size, size);
+    std::printf("CPU alone: %.3f ms per frame\n", cpuMilliseconds);
+    for (uint32_t framesInFlight = 1; framesInFlight <= 3; framesInFlight++) {
+        const FrameTimes times = TimeFrames(graphics, target, framesInFlight, frames, cpuMilliseconds, clears);
+        // 1 when the frame costs max(CPU, GPU), 0 when it costs CPU + GPU.
+        const double hidden = cpuMilliseconds + gpuOnly.frame - times.frame;
+        const double shorter = std::min(cpuMilliseconds, gpuOnly.frame);
+        const double overlap = shorter > 0.0 ? hidden / shorter : 0.0;
+        std::printf("%u frames in flight: %.3f ms per frame, %.3f ms waiting in BeginRendering, overlap %.2f\n", framesInFlight, times.frame, times.wait, overlap);
+    }
+
+    graphics.SetFramesInFlight(1);
+    DestroyColorTarget(graphics, target);
+    return 0;
+}
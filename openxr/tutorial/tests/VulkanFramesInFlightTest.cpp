@@ -0,0 +1,95 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: records frames through GraphicsAPI_Vulkan with one to three
+// frames in flight, and checks the per-frame transient allocations. The build runs it on lavapipe
+// when that driver is installed; ctest fails it on any validation layer error.
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "VulkanTestDevice.h"
+
+static int s_failures = 0;
+
+struct Allocation {
+    void *buffer;
+    size_t offset;
+    size_t size;
+};
+
+// Allocates count blocks of size bytes in the current frame, and checks that they are aligned and
+// that none overlap. Returns the number of distinct buffers they came from.
+static size_t AllocateTransients(GraphicsAPI_Vulkan &graphics, size_t count, size_t size, const char *what) {
+    std::vector<Allocation> allocations;
+    std::vector<void *> buffers;
+    std::vector<unsigned char> data(size, 0x5a);
+    for (size_t i = 0; i < count; i++) {
+        GraphicsAPI::TransientAllocation allocation = graphics.AllocateTransientData(data.data(), size);
+        if (allocation.buffer == nullptr || allocation.offset % 16 != 0) {
+            std::printf("FAIL %s: allocation %zu is at %p + %zu\n", what, i, allocation.buffer, allocation.offset);
+            s_failures++;
+            return 0;
+        }
+        for (const Allocation &other : allocations) {
+            if (other.buffer == allocation.buffer && allocation.offset < other.offset + other.size && other.offset < allocation.offset + size) {
+                std::printf("FAIL %s: allocation %zu overlaps an earlier one\n", what, i);
+                s_failures++;
+                return 0;
+            }
+        }
+        allocations.push_back({allocation.buffer, allocation.offset, size});
+        if (std::find(buffers.begin(), buffers.end(), allocation.buffer) == buffers.end()) {
+            buffers.push_back(allocation.buffer);
+        }
+    }
+    return buffers.size();
+}
+
+static void RunFrames(GraphicsAPI_Vulkan &graphics, const VulkanColorTarget &target, uint32_t framesInFlight) {
+    graphics.SetFramesInFlight(framesInFlight);
+    const uint32_t expected = framesInFlight > 0 ? framesInFlight : 1;
+    if (graphics.GetFramesInFlight() != expected) {
+        std::printf("FAIL SetFramesInFlight(%u): %u frames in flight\n", framesInFlight, graphics.GetFramesInFlight());
+        s_failures++;
+    }
+
+    // More than the first 64 KiB block, so the first frame in each slot chains blocks, and the
+    // frame after it in the same slot finds them merged into one.
+    const size_t count = 80;
+    const size_t size = 1024;
+    for (uint32_t frame = 0; frame < 4 * expected; frame++) {
+        graphics.BeginRendering();
+        graphics.ClearColor(target.view, frame * 0.1f, 0.2f, 0.3f, 1.0f);
+        const size_t buffers = AllocateTransients(graphics, count, size, "transient data");
+        if (frame >= expected && buffers != 1) {
+            std::printf("FAIL %u frames in flight, frame %u: transient data came from %zu buffers\n", expected, frame, buffers);
+            s_failures++;
+        }
+        graphics.EndRendering();
+    }
+}
+
+int main() {
+    GraphicsAPI_Vulkan graphics;
+    VulkanColorTarget target = CreateColorTarget(graphics, 64, 64);
+
+    if (graphics.GetFramesInFlight() != XR_TUTORIAL_VULKAN_FRAMES_IN_FLIGHT) {
+        std::printf("FAIL %u frames in flight by default\n", graphics.GetFramesInFlight());
+        s_failures++;
+    }
+    for (uint32_t framesInFlight : {1u, 2u, 3u, 0u, 2u}) {
+        RunFrames(graphics, target, framesInFlight);
+    }
+
+    // Waits for every frame, so the target is no longer in use.
+    graphics.SetFramesInFlight(1);
+    DestroyColorTarget(graphics, target);
+
+    if (s_failures == 0) {
+        std::printf("PASS\n");
+    }
+    return s_failures == 0 ? 0 : 1;
+}
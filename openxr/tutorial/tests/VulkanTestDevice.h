@@ -0,0 +1,28 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: helpers shared by the host-side GraphicsAPI_Vulkan tests and
+// benchmarks. They use the desktop constructor, which needs no OpenXR runtime and enables
+// VK_LAYER_KHRONOS_validation, so any validation error is printed to stdout.
+
+#pragma once
+
+#include <GraphicsAPI_Vulkan.h>
+
+struct VulkanColorTarget {
+    void *image = nullptr;
+    void *view = nullptr;
+};
+
+inline VulkanColorTarget CreateColorTarget(GraphicsAPI_Vulkan &graphics, uint32_t width, uint32_t height) {
+    VulkanColorTarget target;
+    target.image = graphics.CreateImage({2, width, height, 1, 1, 1, 1, VK_FORMAT_R8G8B8A8_UNORM, false, true, false, false});
+    target.view = graphics.CreateImageView({target.image, GraphicsAPI::ImageViewCreateInfo::Type::RTV, GraphicsAPI::ImageViewCreateInfo::View::TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, GraphicsAPI::ImageViewCreateInfo::Aspect::COLOR_BIT, 0, 1, 0, 1});
+    return target;
+}
+
+inline void DestroyColorTarget(GraphicsAPI_Vulkan &graphics, VulkanColorTarget &target) {
+    graphics.DestroyImageView(target.view);
+    graphics.DestroyImage(target.image);
+}
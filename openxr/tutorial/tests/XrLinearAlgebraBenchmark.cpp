@@ -0,0 +1,66 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: times the batch model-view-projection helper against the
+// per-object CreateTranslationRotationScale and Multiply calls it replaces.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "XrLinearAlgebraTest.h"
+
+template <typename Compute>
+static double MillisecondsPerFrame(int frames, Compute &&compute) {
+    compute();  // warm up caches
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        compute();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+int main(int argc, char **argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 100;
+    const size_t count = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 100000;
+    if (frames <= 0 || count == 0) {
+        std::printf("usage: %s [frames] [matrices]\n", argv[0]);
+        return 1;
+    }
+
+    struct Cube {
+        XrPosef Pose;
+        XrVector3f Scale;
+    };
+    std::mt19937 random(39);
+    std::vector<Cube> cubes(count);
+    for (Cube &cube : cubes) {
+        cube.Pose = RandomPose(random);
+        cube.Scale = RandomScale(random);
+    }
+    const XrMatrix4x4f viewProjection = RandomMatrix(random, 2.0f);
+    std::vector<XrMatrix4x4f> results(count);
+
+    const double perObject = MillisecondsPerFrame(frames, [&] {
+        for (size_t i = 0; i < count; i++) {
+            XrMatrix4x4f model;
+            XrMatrix4x4f_CreateTranslationRotationScale(&model, &cubes[i].Pose.position, &cubes[i].Pose.orientation, &cubes[i].Scale);
+            XrMatrix4x4f_Multiply(&results[i], &viewProjection, &model);
+        }
+    });
+    const double batched = MillisecondsPerFrame(frames, [&] {
+        XrMatrix4x4f_CreateModelViewProjectionArray(results.data(), &viewProjection, &cubes[0].Pose, sizeof(Cube), &cubes[0].Scale, sizeof(Cube), count);
+    });
+    const double reference = MillisecondsPerFrame(frames, [&] {
+        for (size_t i = 0; i < count; i++) {
+            XrMatrix4x4f model;
+            ReferenceCreateTranslationRotationScale(&model, &cubes[i].Pose.position, &cubes[i].Pose.orientation, &cubes[i].Scale);
+            ReferenceMultiply(&results[i], &viewProjection, &model);
+        }
+    });
+    std::printf("%zu model-view-projection matrices: T*R*S from three matrices %.3f ms, per object %.3f ms, batched %.3f ms (%.1fx)\n", count, reference, perObject, batched, reference / batched);
+    return 0;
+}
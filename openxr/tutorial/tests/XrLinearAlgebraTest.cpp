@@ -0,0 +1,193 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: checks the SIMD and batch matrix helpers in
+// xr_linear_algebra.h against the scalar code they replace. The build runs this for every copy of
+// the header, with and without SIMD.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "XrLinearAlgebraTest.h"
+
+static int s_failures = 0;
+
+// The helpers must match the reference exactly: == also treats 0.0f and -0.0f as equal, which is
+// the only way the SIMD paths may differ.
+static bool CheckEqual(const XrMatrix4x4f &actual, const XrMatrix4x4f &expected, const char *what, size_t index) {
+    for (int i = 0; i < 16; i++) {
+        if (!(actual.m[i] == expected.m[i])) {
+            std::printf("FAIL %s [%zu]: m[%d] is %.9g, expected %.9g\n", what, index, i, actual.m[i], expected.m[i]);
+            s_failures++;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void CheckMultiply(std::mt19937 &random, size_t count) {
+    std::vector<XrMatrix4x4f> a(count);
+    std::vector<XrMatrix4x4f> b(count);
+    for (size_t i = 0; i < count; i++) {
+        a[i] = RandomMatrix(random, 10.0f);
+        b[i] = RandomMatrix(random, 10.0f);
+    }
+    for (size_t i = 0; i < count; i++) {
+        XrMatrix4x4f expected;
+        ReferenceMultiply(&expected, &a[i], &b[i]);
+        XrMatrix4x4f actual;
+        XrMatrix4x4f_Multiply(&actual, &a[i], &b[i]);
+        if (!CheckEqual(actual, expected, "Multiply", i)) {
+            return;
+        }
+    }
+
+    // The batch version multiplies one matrix by each of the others.
+    std::vector<XrMatrix4x4f> results(count);
+    XrMatrix4x4f_MultiplyArray(results.data(), &a[0], b.data(), count);
+    for (size_t i = 0; i < count; i++) {
+        XrMatrix4x4f expected;
+        ReferenceMultiply(&expected, &a[0], &b[i]);
+        if (!CheckEqual(results[i], expected, "MultiplyArray", i)) {
+            return;
+        }
+    }
+}
+
+static void CheckInvertRigidBody(std::mt19937 &random, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const XrPosef pose = RandomPose(random);
+        const XrVector3f one = {1.0f, 1.0f, 1.0f};
+        XrMatrix4x4f rigid;
+        XrMatrix4x4f_CreateTranslationRotationScale(&rigid, &pose.position, &pose.orientation, &one);
+
+        XrMatrix4x4f expected;
+        ReferenceInvertRigidBody(&expected, &rigid);
+        XrMatrix4x4f actual;
+        XrMatrix4x4f_InvertRigidBody(&actual, &rigid);
+        if (!CheckEqual(actual, expected, "InvertRigidBody", i)) {
+            return;
+        }
+
+        // And it really is the inverse, up to rounding.
+        XrMatrix4x4f identity;
+        ReferenceMultiply(&identity, &actual, &rigid);
+        for (int j = 0; j < 16; j++) {
+            const float want = (j % 5 == 0) ? 1.0f : 0.0f;
+            if (std::fabs(identity.m[j] - want) > 1e-4f) {
+                std::printf("FAIL InvertRigidBody [%zu]: inverse * matrix has m[%d] = %.9g\n", i, j, identity.m[j]);
+                s_failures++;
+                return;
+            }
+        }
+    }
+}
+
+static void CheckTranslationRotationScale(std::mt19937 &random, size_t count) {
+    struct Object {
+        XrPosef pose;
+        XrVector3f scale;
+        float padding;  // the stride must be honoured, not assumed to be sizeof(XrPosef)
+    };
+    std::vector<Object> objects(count);
+    for (Object &object : objects) {
+        object.pose = RandomPose(random);
+        object.scale = RandomScale(random);
+    }
+    // Some poses straight from a runtime: identity, and axis-aligned rotations with zero terms.
+    if (count >= 3) {
+        objects[0].pose = {{0.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 0.0f}};
+        objects[1].pose = {{0.0f, 0.70710677f, 0.0f, 0.70710677f}, {0.0f, 1.5f, -2.0f}};
+        objects[2].pose = {{1.0f, 0.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}};
+        objects[2].scale = {1.0f, 1.0f, 1.0f};
+    }
+
+    std::vector<XrMatrix4x4f> expected(count);
+    for (size_t i = 0; i < count; i++) {
+        ReferenceCreateTranslationRotationScale(&expected[i], &objects[i].pose.position, &objects[i].pose.orientation, &objects[i].scale);
+        XrMatrix4x4f actual;
+        XrMatrix4x4f_CreateTranslationRotationScale(&actual, &objects[i].pose.position, &objects[i].pose.orientation, &objects[i].scale);
+        if (!CheckEqual(actual, expected[i], "CreateTranslationRotationScale", i)) {
+            return;
+        }
+    }
+
+    std::vector<XrMatrix4x4f> results(count);
+    if (count > 0) {
+        XrMatrix4x4f_CreateTranslationRotationScaleArray(results.data(), &objects[0].pose, sizeof(Object), &objects[0].scale, sizeof(Object), count);
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!CheckEqual(results[i], expected[i], "CreateTranslationRotationScaleArray", i)) {
+            return;
+        }
+    }
+
+    // Without scales every object gets a scale of one.
+    std::vector<XrPosef> poses(count);
+    for (size_t i = 0; i < count; i++) {
+        poses[i] = objects[i].pose;
+    }
+    XrMatrix4x4f_CreateTranslationRotationScaleArray(results.data(), poses.data(), sizeof(XrPosef), nullptr, 0, count);
+    const XrVector3f one = {1.0f, 1.0f, 1.0f};
+    for (size_t i = 0; i < count; i++) {
+        XrMatrix4x4f unscaled;
+        ReferenceCreateTranslationRotationScale(&unscaled, &poses[i].position, &poses[i].orientation, &one);
+        if (!CheckEqual(results[i], unscaled, "CreateTranslationRotationScaleArray without scales", i)) {
+            return;
+        }
+    }
+}
+
+// The batch model-view-projection helper works in chunks, so check counts around the chunk size.
+static void CheckModelViewProjection(std::mt19937 &random, size_t count) {
+    struct Cube {
+        XrPosef Pose;
+        XrVector3f Scale;
+    };
+    std::vector<Cube> cubes(count);
+    for (Cube &cube : cubes) {
+        cube.Pose = RandomPose(random);
+        cube.Scale = RandomScale(random);
+    }
+    const XrMatrix4x4f viewProjection = RandomMatrix(random, 2.0f);
+
+    // One more than asked for, to catch writes past the end.
+    std::vector<XrMatrix4x4f> results(count + 1);
+    XrMatrix4x4f sentinel;
+    for (float &f : sentinel.m) {
+        f = 12345.0f;
+    }
+    results[count] = sentinel;
+    XrMatrix4x4f_CreateModelViewProjectionArray(results.data(), &viewProjection, count > 0 ? &cubes[0].Pose : nullptr, sizeof(Cube), count > 0 ? &cubes[0].Scale : nullptr, sizeof(Cube),
+                                                count);
+    for (size_t i = 0; i < count; i++) {
+        XrMatrix4x4f model;
+        ReferenceCreateTranslationRotationScale(&model, &cubes[i].Pose.position, &cubes[i].Pose.orientation, &cubes[i].Scale);
+        XrMatrix4x4f expected;
+        ReferenceMultiply(&expected, &viewProjection, &model);
+        if (!CheckEqual(results[i], expected, "CreateModelViewProjectionArray", i)) {
+            return;
+        }
+    }
+    CheckEqual(results[count], sentinel, "CreateModelViewProjectionArray past the end", count);
+}
+
+int main() {
+    std::mt19937 random(39);
+    CheckMultiply(random, 100000);
+    CheckInvertRigidBody(random, 100000);
+    CheckTranslationRotationScale(random, 100000);
+    const size_t counts[] = {0, 1, 63, 64, 65, 1000, 100000};
+    for (const size_t count : counts) {
+        CheckModelViewProjection(random, count);
+    }
+
+    if (s_failures != 0) {
+        std::printf("%d failures\n", s_failures);
+        return 1;
+    }
+    std::printf("all xr_linear_algebra checks passed\n");
+    return 0;
+}
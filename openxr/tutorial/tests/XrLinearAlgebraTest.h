@@ -0,0 +1,92 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: includes the copy of the xr_linear_algebra.h header picked by
+// the build, and the scalar reference code the tests and benchmark compare it against.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include <openxr/openxr.h>
+
+#if defined(XR_LINEAR_TEST_TUTORIAL_API_TYPE)
+// The tutorial and Camera2 copies take GraphicsAPI_Type from the tutorial's GraphicsAPI.h.
+enum GraphicsAPI_Type : uint8_t {
+    UNKNOWN,
+    D3D11,
+    D3D12,
+    OPENGL,
+    OPENGL_ES,
+    VULKAN
+};
+#endif
+
+#include XR_LINEAR_TEST_HEADER
+
+// The scalar matrix product. The SIMD paths add the products in the same order, so they match it
+// exactly as long as the compiler doesn't contract it into fused multiply-adds.
+inline void ReferenceMultiply(XrMatrix4x4f *result, const XrMatrix4x4f *a, const XrMatrix4x4f *b) {
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            result->m[4 * c + r] = a->m[r] * b->m[4 * c] + a->m[4 + r] * b->m[4 * c + 1] + a->m[8 + r] * b->m[4 * c + 2] + a->m[12 + r] * b->m[4 * c + 3];
+        }
+    }
+}
+
+// The scalar rigid body inverse: the transposed rotation and the negated, rotated translation.
+inline void ReferenceInvertRigidBody(XrMatrix4x4f *result, const XrMatrix4x4f *src) {
+    for (int c = 0; c < 3; c++) {
+        for (int r = 0; r < 3; r++) {
+            result->m[4 * c + r] = src->m[4 * r + c];
+        }
+        result->m[4 * c + 3] = 0.0f;
+    }
+    for (int r = 0; r < 3; r++) {
+        result->m[12 + r] = -(src->m[4 * r] * src->m[12] + src->m[4 * r + 1] * src->m[13] + src->m[4 * r + 2] * src->m[14]);
+    }
+    result->m[15] = 1.0f;
+}
+
+// translation * rotation * scale built from the three matrices, as the header did before it
+// wrote the combined matrix directly.
+inline void ReferenceCreateTranslationRotationScale(XrMatrix4x4f *result, const XrVector3f *translation, const XrQuaternionf *rotation, const XrVector3f *scale) {
+    XrMatrix4x4f scaleMatrix;
+    XrMatrix4x4f_CreateScale(&scaleMatrix, scale->x, scale->y, scale->z);
+    XrMatrix4x4f rotationMatrix;
+    XrMatrix4x4f_CreateFromQuaternion(&rotationMatrix, rotation);
+    XrMatrix4x4f translationMatrix;
+    XrMatrix4x4f_CreateTranslation(&translationMatrix, translation->x, translation->y, translation->z);
+    XrMatrix4x4f combinedMatrix;
+    ReferenceMultiply(&combinedMatrix, &rotationMatrix, &scaleMatrix);
+    ReferenceMultiply(result, &translationMatrix, &combinedMatrix);
+}
+
+inline XrMatrix4x4f RandomMatrix(std::mt19937 &random, float range) {
+    std::uniform_real_distribution<float> value(-range, range);
+    XrMatrix4x4f m;
+    for (float &f : m.m) {
+        f = value(random);
+    }
+    return m;
+}
+
+inline XrPosef RandomPose(std::mt19937 &random) {
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    XrPosef pose;
+    XrQuaternionf &q = pose.orientation;
+    q = {gaussian(random), gaussian(random), gaussian(random), gaussian(random)};
+    const float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    q = {q.x / length, q.y / length, q.z / length, q.w / length};
+    pose.position = {position(random), position(random), position(random)};
+    return pose;
+}
+
+inline XrVector3f RandomScale(std::mt19937 &random) {
+    std::uniform_real_distribution<float> scale(0.01f, 5.0f);
+    return {scale(random), scale(random), scale(random)};
+}
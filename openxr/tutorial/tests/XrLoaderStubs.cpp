@@ -0,0 +1,21 @@
+// Copyright 2025, The Khronos Group Inc.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// OpenXR Tutorial for Khronos Group: the OpenXR loader entry points that GraphicsAPI_Vulkan refers
+// to. The tests only use its desktop constructor, which never calls them, so they are stubbed
+// rather than linking a loader that would look for a runtime.
+
+#include <openxr/openxr.h>
+
+#include <cstdio>
+
+XRAPI_ATTR XrResult XRAPI_CALL xrResultToString(XrInstance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE]) {
+    std::snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "XrResult %d", static_cast<int>(value));
+    return XR_SUCCESS;
+}
+
+XRAPI_ATTR XrResult XRAPI_CALL xrGetInstanceProcAddr(XrInstance, const char *, PFN_xrVoidFunction *function) {
+    *function = nullptr;
+    return XR_ERROR_FUNCTION_UNSUPPORTED;
+}